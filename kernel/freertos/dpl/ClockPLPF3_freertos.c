@@ -33,6 +33,7 @@
  *  ======== ClockPLPF3_freertos.c ========
  */
 
+#include <stddef.h>
 #include <stdlib.h>
 
 #include <ti/drivers/dpl/ClockP.h>
@@ -96,8 +97,12 @@ typedef struct ClockP_Obj
     volatile bool active;          ///< Clock is active
     volatile ClockP_Fxn fxn;       ///< Callback function
     volatile uintptr_t arg;        ///< Argument passed to callback function
+    List_Elem activeElem;          ///< Element in ClockP_activeList while active
 } ClockP_Obj;
 
+/* Get the Clock object from its ClockP_activeList element */
+#define ClockP_activeObj(elem) ((ClockP_Obj *)((uint8_t *)(elem) - offsetof(ClockP_Obj, activeElem)))
+
 /* Shared variables */
 /* ClockP and Power policy share interrupt CPUIRQ16, and therefore Hwi object. */
 extern HwiP_Struct clockHwi;
@@ -113,6 +118,8 @@ static uint32_t upperSystemTicks64 = 0;
  * that it is used on a CC23XX/CC27XX device
  */
 static List_List ClockP_list;
+/* Active clocks, sorted by timeout relative to ClockP_ticks */
+static List_List ClockP_activeList;
 static volatile uint32_t ClockP_ticks;
 static uint32_t ClockP_nextScheduledTick;
 static bool ClockP_inWorkFunc;
@@ -129,6 +136,7 @@ static void ClockP_hwiCallback(uintptr_t arg0);
 static void sleepTicks(uint32_t ticks);
 static void sleepClkFxn(uintptr_t arg0);
 static void ClockP_scheduleNextTick(uint32_t absTick);
+static void ClockP_insertActive(ClockP_Obj *obj);
 
 /* Callback function to increment 64-bit counter on 32-bit counter overflow */
 static void systemTicks64Callback(uintptr_t arg);
@@ -180,6 +188,7 @@ void ClockP_startup(void)
 
         /* Initialize ClockP variables */
         List_clearList(&ClockP_list);
+        List_clearList(&ClockP_activeList);
         ClockP_ticks                     = nowTick;
         ClockP_nextScheduledTick         = (uint32_t)(nowTick + ClockP_PERIOD_MAX);
         ClockP_inWorkFunc                = false;
@@ -248,78 +257,113 @@ void ClockP_scheduleNextTick(uint32_t absTick)
     ClockP_nextScheduledTick = absTick;
 }
 
+/*
+ *  ======== ClockP_insertActive ========
+ *  Insert a Clock object in ClockP_activeList after all clocks timing out
+ *  at or before it. The list is searched from the tail, where clocks with
+ *  long timeouts and restarted periodic clocks usually end up.
+ *  Must be called with global interrupts disabled!
+ */
+static void ClockP_insertActive(ClockP_Obj *obj)
+{
+    uint32_t delta = obj->currTimeout - ClockP_ticks;
+    List_Elem *elem;
+
+    for (elem = List_tail(&ClockP_activeList); elem != NULL; elem = List_prev(elem))
+    {
+        if ((ClockP_activeObj(elem)->currTimeout - ClockP_ticks) <= delta)
+        {
+            break;
+        }
+    }
+
+    if (elem == NULL)
+    {
+        List_putHead(&ClockP_activeList, &obj->activeElem);
+    }
+    else if (List_next(elem) == NULL)
+    {
+        List_put(&ClockP_activeList, &obj->activeElem);
+    }
+    else
+    {
+        List_insert(&ClockP_activeList, &obj->activeElem, List_next(elem));
+    }
+}
+
 /*
  *  ======== ClockP_walkQueueDynamic ========
  *  Walk the Clock Queue for TickMode_DYNAMIC, optionally servicing a
  *  specific tick
  *
+ *  Active clocks are sorted by timeout, so only the clocks timing out at
+ *  thisTick are visited, and the next timeout is the one at the head.
+ *
  *  Returns the number of ticks from thisTick to the next timeout.
  *  If no future timeouts exists, ~0 is returned.
  */
 uint32_t ClockP_walkQueueDynamic(bool service, uint32_t thisTick)
 {
     uint32_t distance = ~0;
-    List_List *list   = &ClockP_list;
     List_Elem *elem;
     ClockP_Obj *obj;
-    uint32_t delta;
     uint32_t period;
     uintptr_t arg;
+    ClockP_Fxn fxn;
+    uintptr_t key;
 
-    /* Traverse clock queue */
-    for (elem = List_head(list); elem != NULL; elem = List_next(elem))
+    /* Optionally service the clocks timing out at this tick */
+    while (service == true)
     {
+        key  = HwiP_disable();
+        elem = List_head(&ClockP_activeList);
 
-        obj = (ClockP_Obj *)elem;
-
-        /* If the object is active ... */
-        if (obj->active == true)
+        /* Done if the soonest timeout is after this tick */
+        if ((elem == NULL) ||
+            ((ClockP_activeObj(elem)->currTimeout - ClockP_ticks) > (thisTick - ClockP_ticks)))
         {
+            HwiP_restore(key);
+            break;
+        }
 
-            /* Optionally service if tick matches timeout */
-            if (service == true)
-            {
-
-                /* If this object is timing out update its state */
-                if (obj->currTimeout == thisTick)
-                {
-                    /* Read volatile members to prevent undefined order of
-                     * volatile accesses warnings.
-                     */
-                    period = obj->period;
-                    arg    = obj->arg;
-
-                    if (period == 0)
-                    {
-                        /* Oneshot: Mark object idle */
-                        obj->active = false;
-                    }
-                    else
-                    {
-                        /* Periodic: Refresh timeout */
-                        obj->currTimeout += (period / CLOCK_FREQUENCY_DIVIDER);
-                    }
-
-                    /* Call handler */
-                    obj->fxn(arg);
-                }
-            }
+        obj = ClockP_activeObj(elem);
 
-            /* If object is still active, update distance to soonest timeout */
-            if (obj->active == true)
-            {
+        /* Read volatile members to prevent undefined order of volatile
+         * accesses warnings.
+         */
+        period = obj->period;
+        arg    = obj->arg;
+        fxn    = obj->fxn;
 
-                delta = obj->currTimeout - thisTick;
+        List_remove(&ClockP_activeList, elem);
 
-                /* If this is the soonest timeout, update distance to soonest */
-                if (delta < distance)
-                {
-                    distance = delta;
-                }
-            }
+        if (period == 0)
+        {
+            /* Oneshot: Mark object idle */
+            obj->active = false;
+        }
+        else
+        {
+            /* Periodic: Refresh timeout */
+            obj->currTimeout += (period / CLOCK_FREQUENCY_DIVIDER);
+            ClockP_insertActive(obj);
         }
+
+        HwiP_restore(key);
+
+        /* Call handler */
+        fxn(arg);
     }
 
+    /* Distance to soonest timeout */
+    key  = HwiP_disable();
+    elem = List_head(&ClockP_activeList);
+    if (elem != NULL)
+    {
+        distance = ClockP_activeObj(elem)->currTimeout - thisTick;
+    }
+    HwiP_restore(key);
+
     return (distance);
 }
 
@@ -497,6 +541,15 @@ ClockP_Handle ClockP_create(ClockP_Fxn clkFxn, uint32_t timeout, ClockP_Params *
 void ClockP_destruct(ClockP_Struct *clk)
 {
     ClockP_Obj *obj = (ClockP_Obj *)clk;
+    uintptr_t key   = HwiP_disable();
+
+    if (obj->active == true)
+    {
+        List_remove(&ClockP_activeList, &obj->activeElem);
+        obj->active = false;
+    }
+
+    HwiP_restore(key);
 
     List_remove(&ClockP_list, &obj->elem);
 }
@@ -545,6 +598,12 @@ void ClockP_start(ClockP_Handle handle)
     uint32_t remainingTicks;
     bool objectServiced = false;
 
+    /* A restarted clock is re-inserted at its new timeout */
+    if (obj->active == true)
+    {
+        List_remove(&ClockP_activeList, &obj->activeElem);
+    }
+
     /* if Clock is NOT currently processing its Q */
     if (ClockP_inWorkFunc == false)
     {
@@ -564,6 +623,7 @@ void ClockP_start(ClockP_Handle handle)
             /* Start new Clock object */
             obj->currTimeout = nowTick + (obj->timeout / CLOCK_FREQUENCY_DIVIDER);
             obj->active      = true;
+            ClockP_insertActive(obj);
 
             /* How many ticks until scheduled tick? */
             remainingTicks = scheduledTick - nowTick;
@@ -583,6 +643,7 @@ void ClockP_start(ClockP_Handle handle)
         /* Start new Clock object */
         obj->currTimeout = nowTick + (obj->timeout / CLOCK_FREQUENCY_DIVIDER);
         obj->active      = true;
+        ClockP_insertActive(obj);
 
         if (ClockP_inWorkFunc == true)
         {
@@ -608,6 +669,11 @@ void ClockP_stop(ClockP_Handle handle)
     uint32_t scheduledDelta;
     uint32_t newScheduledTickDelta;
 
+    if (obj->active == true)
+    {
+        List_remove(&ClockP_activeList, &obj->activeElem);
+    }
+
     obj->active = false;
 
     if (ClockP_inWorkFunc)
@@ -0,0 +1,510 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== fatfsbench.c ========
+ *
+ * Benchmark of FatFs on the simulated flash used by the SPIFFS utilities
+ * (see third_party/spiffs/utils), so both file systems can be compared on
+ * the same flash part.  The FatFs sectors are stored directly in the NVS
+ * region: a write programs the sector if the flash under it is erased and
+ * otherwise reads, erases and rewrites the whole erase sector, as a simple
+ * NVS disk driver without a flash translation layer does.
+ *
+ * Usage:
+ *
+ *     fatfsbench [options] [size]
+ *
+ *     size: size of the simulated NVS region (default 262144).
+ *
+ * Options:
+ *
+ *     -e SIZE            erase sector size (default 4096)
+ *     -t spi|internal    flash timing (default spi)
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ff.h>
+#include <diskio.h>
+
+#include <ti/drivers/NVS.h>
+
+#include "flashsim.h"
+
+#define DEFAULT_SIZE    (256 * 1024)
+#define SECTOR_SIZE     512
+#define IMAGE_ALIGN     (64 * 1024)
+
+#define CREATE_FILES    64      /* files created by the create workload */
+#define CREATE_SIZE     128
+#define APPEND_COUNT    2048    /* records appended by the log workload */
+#define APPEND_SIZE     32
+#define READ_COUNT      2048    /* reads done by the random read workload */
+#define READ_SIZE       32
+#define CHURN_FILES     8       /* files rewritten by the churn workload */
+#define CHURN_COUNT     512
+
+typedef int (*Workload)(void);
+
+static FATFS fatfs;
+static NVS_Handle nvsHandle;
+static unsigned int diskSize;
+static unsigned int eraseSize;
+static unsigned char *eraseBuf;
+static unsigned char data[1024];
+
+/*
+ *  ======== fatfs_getFatTime ========
+ *
+ *  Fixed time stamp (2017-01-01 00:00:00) so images are reproducible.
+ */
+int32_t fatfs_getFatTime(void)
+{
+    return ((int32_t)((2017 - 1980) << 25 | 1 << 21 | 1 << 16));
+}
+
+/*
+ *  ======== nvsDiskInit ========
+ */
+static DSTATUS nvsDiskInit(BYTE drive)
+{
+    return ((nvsHandle == NULL) ? STA_NOINIT : 0);
+}
+
+/*
+ *  ======== nvsDiskStatus ========
+ */
+static DSTATUS nvsDiskStatus(BYTE drive)
+{
+    return ((nvsHandle == NULL) ? STA_NOINIT : 0);
+}
+
+/*
+ *  ======== nvsDiskRead ========
+ */
+static DRESULT nvsDiskRead(BYTE drive, BYTE *buf, DWORD sector, UINT num)
+{
+    if (NVS_read(nvsHandle, sector * SECTOR_SIZE, buf,
+            num * SECTOR_SIZE) != NVS_STATUS_SUCCESS) {
+        return (RES_ERROR);
+    }
+
+    return (RES_OK);
+}
+
+/*
+ *  ======== nvsDiskWrite ========
+ *
+ *  Program the data if the flash under it is erased, otherwise merge it into
+ *  a copy of the erase sector and rewrite that.
+ */
+static DRESULT nvsDiskWrite(BYTE drive, const BYTE *buf, DWORD sector,
+    UINT num)
+{
+    size_t offset = sector * SECTOR_SIZE;
+    size_t end = offset + num * SECTOR_SIZE;
+    size_t base;
+    size_t count;
+    size_t i;
+    int_fast16_t status;
+
+    while (offset < end) {
+        base = offset & ~((size_t)eraseSize - 1);
+        count = ((base + eraseSize < end) ? base + eraseSize : end) - offset;
+
+        if (NVS_read(nvsHandle, base, eraseBuf, eraseSize) !=
+            NVS_STATUS_SUCCESS) {
+            return (RES_ERROR);
+        }
+
+        for (i = offset - base; i < offset - base + count; i++) {
+            if (eraseBuf[i] != 0xFF) {
+                break;
+            }
+        }
+
+        if (i == offset - base + count) {
+            status = NVS_write(nvsHandle, offset, (void *)buf, count, 0);
+        }
+        else {
+            memcpy(eraseBuf + offset - base, buf, count);
+            status = NVS_write(nvsHandle, base, eraseBuf, eraseSize,
+                NVS_WRITE_ERASE);
+        }
+
+        if (status != NVS_STATUS_SUCCESS) {
+            return (RES_ERROR);
+        }
+
+        offset += count;
+        buf += count;
+    }
+
+    return (RES_OK);
+}
+
+/*
+ *  ======== nvsDiskIoctl ========
+ */
+static DRESULT nvsDiskIoctl(BYTE drive, BYTE cmd, void *buf)
+{
+    switch (cmd) {
+        case CTRL_SYNC:
+            return (RES_OK);
+
+        case GET_SECTOR_COUNT:
+            *(DWORD *)buf = diskSize / SECTOR_SIZE;
+            return (RES_OK);
+
+        case GET_BLOCK_SIZE:
+            *(DWORD *)buf = eraseSize / SECTOR_SIZE;
+            return (RES_OK);
+
+        default:
+            return (RES_PARERR);
+    }
+}
+
+/*
+ *  ======== fillData ========
+ */
+static void fillData(unsigned int seed, unsigned int size)
+{
+    unsigned int i;
+
+    for (i = 0; i < size; i++) {
+        data[i] = (unsigned char)(seed * 31 + i);
+    }
+}
+
+/*
+ *  ======== writeFile ========
+ */
+static int writeFile(char *name, unsigned int seed, unsigned int size)
+{
+    FIL file;
+    UINT count;
+    FRESULT result;
+
+    if (f_open(&file, name, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK) {
+        return (-1);
+    }
+
+    fillData(seed, size);
+    result = f_write(&file, data, size, &count);
+
+    if (f_close(&file) != FR_OK || result != FR_OK || count != size) {
+        return (-1);
+    }
+
+    return (0);
+}
+
+/*
+ *  ======== createFiles ========
+ *
+ *  Create small files, as for configuration or calibration data.
+ */
+static int createFiles(void)
+{
+    char name[24];
+    int i;
+
+    for (i = 0; i < CREATE_FILES; i++) {
+        sprintf(name, "0:cfg%d", i);
+        if (writeFile(name, i, CREATE_SIZE) < 0) {
+            return (-1);
+        }
+    }
+
+    return (CREATE_FILES);
+}
+
+/*
+ *  ======== appendLog ========
+ *
+ *  Append records to a log file, syncing each record as a logger that must
+ *  not lose data on reset does.
+ */
+static int appendLog(void)
+{
+    FIL file;
+    UINT count;
+    int i;
+
+    if (f_open(&file, "0:log", FA_OPEN_APPEND | FA_WRITE) != FR_OK) {
+        return (-1);
+    }
+
+    for (i = 0; i < APPEND_COUNT; i++) {
+        fillData(i, APPEND_SIZE);
+        if (f_write(&file, data, APPEND_SIZE, &count) != FR_OK ||
+            count != APPEND_SIZE || f_sync(&file) != FR_OK) {
+            f_close(&file);
+            return (-1);
+        }
+    }
+
+    if (f_close(&file) != FR_OK) {
+        return (-1);
+    }
+
+    return (APPEND_COUNT);
+}
+
+/*
+ *  ======== randomReads ========
+ *
+ *  Read records at random offsets of the files written by the create
+ *  workload and check their contents.
+ */
+static int randomReads(void)
+{
+    unsigned char buf[READ_SIZE];
+    static FIL files[4];
+    char name[24];
+    unsigned int offset;
+    UINT count;
+    int file;
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        sprintf(name, "0:cfg%d", i);
+        if (f_open(&files[i], name, FA_READ) != FR_OK) {
+            return (-1);
+        }
+    }
+
+    srand(1);
+    for (i = 0; i < READ_COUNT; i++) {
+        file = rand() % 4;
+        offset = rand() % (CREATE_SIZE - READ_SIZE + 1);
+        fillData(file, CREATE_SIZE);
+
+        if (f_lseek(&files[file], offset) != FR_OK ||
+            f_read(&files[file], buf, READ_SIZE, &count) != FR_OK ||
+            count != READ_SIZE || memcmp(buf, data + offset, READ_SIZE) != 0) {
+            return (-1);
+        }
+    }
+
+    for (i = 0; i < 4; i++) {
+        f_close(&files[i]);
+    }
+
+    return (READ_COUNT);
+}
+
+/*
+ *  ======== churn ========
+ *
+ *  Keep rewriting files, the workload that makes SPIFFS collect garbage.
+ */
+static int churn(void)
+{
+    unsigned char buf[sizeof(data)];
+    char name[24];
+    FIL file;
+    UINT count;
+    int i;
+
+    for (i = 0; i < CHURN_COUNT; i++) {
+        sprintf(name, "0:churn%d", i % CHURN_FILES);
+        if (writeFile(name, i, sizeof(data)) < 0) {
+            return (-1);
+        }
+    }
+
+    /* Check the last version of every file */
+    for (i = CHURN_COUNT - CHURN_FILES; i < CHURN_COUNT; i++) {
+        sprintf(name, "0:churn%d", i % CHURN_FILES);
+        if (f_open(&file, name, FA_READ) != FR_OK) {
+            return (-1);
+        }
+        if (f_read(&file, buf, sizeof(buf), &count) != FR_OK) {
+            count = 0;
+        }
+        f_close(&file);
+
+        fillData(i, sizeof(data));
+        if (count != sizeof(buf) || memcmp(buf, data, sizeof(buf)) != 0) {
+            return (-1);
+        }
+    }
+
+    return (CHURN_COUNT);
+}
+
+/*
+ *  ======== runWorkload ========
+ */
+static int runWorkload(char *name, Workload workload)
+{
+    const FlashSim_Stats *stats = FlashSim_getStats();
+    int ops;
+
+    FlashSim_resetStats();
+
+    if ((ops = workload()) <= 0) {
+        fprintf(stderr, "ERROR: %s failed\n", name);
+        return (-1);
+    }
+
+    printf("%-8s %6d %7u %7u %7u %6u %9.1f %8.1f\n", name, ops,
+           (unsigned int)stats->reads, (unsigned int)stats->writes,
+           (unsigned int)stats->programs, (unsigned int)stats->erases,
+           stats->timeUs / 1000.0, stats->timeUs / ops);
+
+    if (stats->badBits != 0) {
+        fprintf(stderr, "ERROR: %s programmed %u bits that were not erased\n",
+                name, (unsigned int)stats->badBits);
+        return (-1);
+    }
+
+    return (0);
+}
+
+/*
+ *  ======== main ========
+ */
+int main(int argc, char *argv[])
+{
+    const FlashSim_Timing *timing = &FlashSim_timingSpi25x;
+    unsigned char work[FF_MAX_SS];
+    void *image;
+    const uint32_t *eraseCounts;
+    size_t numSectors;
+    uint32_t minErases;
+    uint32_t maxErases;
+    uint32_t totalErases;
+    FRESULT result;
+    size_t i;
+    int status = 0;
+    int arg;
+
+    diskSize = DEFAULT_SIZE;
+    eraseSize = 4096;
+
+    for (arg = 1; arg + 1 < argc && argv[arg][0] == '-'; arg += 2) {
+        if (strcmp(argv[arg], "-e") == 0) {
+            eraseSize = strtoul(argv[arg + 1], NULL, 0);
+        }
+        else if (strcmp(argv[arg], "-t") != 0 ||
+            (timing = FlashSim_findTiming(argv[arg + 1])) == NULL) {
+            break;
+        }
+    }
+
+    if (argc - arg > 1 || (arg < argc && argv[arg][0] == '-')) {
+        fprintf(stderr, "Usage: %s [-e SIZE] [-t spi|internal] [SIZE]\n",
+                argv[0]);
+        exit(1);
+    }
+
+    if (argc - arg == 1) {
+        diskSize = strtoul(argv[arg], NULL, 0);
+    }
+
+    if (eraseSize < SECTOR_SIZE || eraseSize > IMAGE_ALIGN ||
+        (eraseSize & (eraseSize - 1)) || diskSize == 0 ||
+        diskSize % eraseSize) {
+        fprintf(stderr, "ERROR: [SIZE] must be a multiple of the erase sector"
+                " size, a power of two from %d to %d\n", SECTOR_SIZE,
+                IMAGE_ALIGN);
+        exit(1);
+    }
+
+    /* NVSRAM requires the region to be aligned on an erase sector */
+    if (posix_memalign(&image, IMAGE_ALIGN, diskSize) != 0 ||
+        (eraseBuf = malloc(eraseSize)) == NULL) {
+        fprintf(stderr, "ERROR: out of memory, malloc() returned NULL.\n");
+        exit(1);
+    }
+    memset(image, 0xFF, diskSize);
+
+    FlashSim_init(image, diskSize, eraseSize, timing);
+    NVS_init();
+    if ((nvsHandle = NVS_open(0, NULL)) == NULL) {
+        fprintf(stderr, "ERROR: NVS_open() failed\n");
+        exit(1);
+    }
+
+    disk_register(0, nvsDiskInit, nvsDiskStatus, nvsDiskRead, nvsDiskWrite,
+        nvsDiskIoctl);
+
+    if ((result = f_mkfs("0:", FM_ANY | FM_SFD, 0, work, sizeof(work))) !=
+        FR_OK || (result = f_mount(&fatfs, "0:", 1)) != FR_OK) {
+        fprintf(stderr, "ERROR: could not format the disk: %d\n", result);
+        exit(1);
+    }
+
+    printf("%u byte %s flash, %u byte sectors, FatFs %d byte sectors\n\n",
+           diskSize, timing->name, eraseSize, SECTOR_SIZE);
+    printf("%-8s %6s %7s %7s %7s %6s %9s %8s\n", "workload", "ops", "reads",
+           "writes", "progs", "erases", "time(ms)", "us/op");
+
+    if (runWorkload("create", createFiles) < 0 ||
+        runWorkload("append", appendLog) < 0 ||
+        runWorkload("read", randomReads) < 0 ||
+        runWorkload("churn", churn) < 0) {
+        status = 1;
+    }
+
+    f_mount(NULL, "0:", 0);
+    disk_unregister(0);
+    NVS_close(nvsHandle);
+
+    eraseCounts = FlashSim_getEraseCounts(&numSectors);
+    minErases = maxErases = eraseCounts[0];
+    totalErases = 0;
+    for (i = 0; i < numSectors; i++) {
+        if (eraseCounts[i] < minErases) {
+            minErases = eraseCounts[i];
+        }
+        if (eraseCounts[i] > maxErases) {
+            maxErases = eraseCounts[i];
+        }
+        totalErases += eraseCounts[i];
+    }
+
+    printf("\nerases per sector: min %u, max %u, mean %.1f\n",
+           (unsigned int)minErases, (unsigned int)maxErases,
+           (double)totalErases / numSectors);
+
+    free(eraseBuf);
+    free(image);
+
+    return (status);
+}
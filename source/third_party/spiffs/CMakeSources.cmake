@@ -34,6 +34,7 @@ set(SOURCES_COMMON
     spiffs_check.c
     spiffs_gc.c
     spiffs_hydrogen.c
+    spiffs_lookahead.c
     spiffs_nucleus.c
     SPIFFSNVS.c
 )
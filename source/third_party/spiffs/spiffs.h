@@ -62,6 +62,8 @@ extern "C" {
 
 #define SPIFFS_ERR_SEEK_BOUNDS          -10040
 
+#define SPIFFS_ERR_LOOKAHEAD_TOO_SMALL  -10041
+
 
 #define SPIFFS_ERR_INTERNAL             -10050
 
@@ -270,6 +272,13 @@ typedef struct spiffs_t {
   u32_t stats_gc_runs;
 #endif
 
+#if SPIFFS_LOOKAHEAD
+  // lookahead memory, see SPIFFS_lookahead
+  void *lookahead;
+  // lookahead memory size
+  u32_t lookahead_size;
+#endif
+
 #if SPIFFS_CACHE
   // cache memory
   void *cache;
@@ -782,6 +791,32 @@ s32_t SPIFFS_ix_map_entries_to_bytes(spiffs *fs, u32_t map_page_ix_entries);
 
 #endif // SPIFFS_IX_MAP
 
+#if SPIFFS_LOOKAHEAD
+
+/**
+ * Gives spiffs a lookahead memory area. The area holds a bitmap with the
+ * state of every page, the erase count of every block, a bitmap of object ids
+ * in use and a hash table from object id and span index to object index page.
+ * With it, finding free pages, garbage collection candidates, object index
+ * pages and files by name are memory lookups instead of scans of the object
+ * lookup pages on the medium.
+ * The area is built when mounting, and rebuilt directly if the file system is
+ * already mounted. It is kept up to date on all writes and garbage
+ * collections; do not tamper with it while it is given to spiffs. SPIFFS_check
+ * does not use the area and rebuilds it when finished.
+ * The area must hold the page and erase count bitmaps plus at least one hash
+ * table entry, see SPIFFS_buffer_bytes_for_lookahead. Remaining space goes to
+ * the hash table. If the hash table becomes too small for all object index
+ * pages, spiffs falls back to scanning the medium when a lookup misses.
+ * May be called before or after mount. Give a null area to stop using it.
+ * @param fs      the file system struct
+ * @param buf     the lookahead memory area, aligned to pointer size
+ * @param size    size of the lookahead memory area in bytes
+ */
+s32_t SPIFFS_lookahead(spiffs *fs, void *buf, u32_t size);
+
+#endif // SPIFFS_LOOKAHEAD
+
 
 #if SPIFFS_TEST_VISUALISATION
 /**
@@ -805,6 +840,14 @@ u32_t SPIFFS_buffer_bytes_for_filedescs(spiffs *fs, u32_t num_descs);
  */
 u32_t SPIFFS_buffer_bytes_for_cache(spiffs *fs, u32_t num_pages);
 #endif
+
+#if SPIFFS_LOOKAHEAD
+/**
+ * Returns number of bytes needed for the lookahead area given
+ * amount of object index pages to keep in its hash table.
+ */
+u32_t SPIFFS_buffer_bytes_for_lookahead(spiffs *fs, u32_t num_ix_pages);
+#endif
 #endif
 
 #if SPIFFS_CACHE
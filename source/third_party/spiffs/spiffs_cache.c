@@ -193,6 +193,10 @@ s32_t spiffs_phys_wr(
   spiffs_cache *cache = spiffs_get_cache(fs);
   spiffs_cache_page *cp =  spiffs_cache_page_get(fs, pix);
 
+#if SPIFFS_LOOKAHEAD
+  spiffs_lookahead_write(fs, addr, len, src);
+#endif
+
   if (cp && (op & SPIFFS_OP_COM_MASK) != SPIFFS_OP_C_WRTHRU) {
     // have a cache page
     // copy in data to cache page
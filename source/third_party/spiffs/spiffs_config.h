@@ -311,6 +311,20 @@ extern void SPIFFSNVS_unlock(void *fs);
 #define SPIFFS_IX_MAP                         1
 #endif
 
+// Enable to be able to give spiffs a lookahead memory area.
+// Without it, finding free pages, garbage collection candidates, object index
+// pages and files by name means scanning the object lookup pages of every
+// block on the medium, which costs O(flash) reads once the file system is well
+// populated. With a lookahead area, spiffs keeps a RAM bitmap of page states
+// (free/deleted/used), the erase count of each block, a bitmap of object ids
+// in use and a hash table from object id and span index to object index page.
+// These are built when mounting and kept coherent on every write, so the
+// scans are replaced by memory lookups. The area is optional and given with
+// SPIFFS_lookahead; when not given, spiffs behaves as without this option.
+#ifndef SPIFFS_LOOKAHEAD
+#define SPIFFS_LOOKAHEAD                      1
+#endif
+
 // By default SPIFFS in some cases relies on the property of NOR flash that bits
 // cannot be set from 0 to 1 by writing and that controllers will ignore such
 // bit changes. This results in fewer reads as SPIFFS can in some cases perform
@@ -52,6 +52,14 @@ s32_t spiffs_gc_quick(
     u16_t free_pages_in_block = 0;
 
     int obj_lookup_page = 0;
+#if SPIFFS_LOOKAHEAD
+    if (SPIFFS_LOOKAHEAD_VALID(fs)) {
+      // page states are in memory, no need to read object lookup
+      deleted_pages_in_block = spiffs_lookahead_block_count(fs, cur_block, SPIFFS_LOOKAHEAD_DELETED, 0);
+      free_pages_in_block = spiffs_lookahead_block_count(fs, cur_block, SPIFFS_LOOKAHEAD_FREE, 0);
+      obj_lookup_page = SPIFFS_OBJ_LOOKUP_PAGES(fs);
+    }
+#endif
     // check each object lookup page
     while (res == SPIFFS_OK && obj_lookup_page < (int)SPIFFS_OBJ_LOOKUP_PAGES(fs)) {
       int entry_offset = obj_lookup_page * entries_per_page;
@@ -207,6 +215,14 @@ s32_t spiffs_gc_erase_page_stats(
   u32_t dele = 0;
   u32_t allo = 0;
 
+#if SPIFFS_LOOKAHEAD
+  if (SPIFFS_LOOKAHEAD_VALID(fs)) {
+    // page states are in memory, no need to read object lookup
+    dele = spiffs_lookahead_block_count(fs, bix, SPIFFS_LOOKAHEAD_DELETED, 0);
+    allo = spiffs_lookahead_block_count(fs, bix, SPIFFS_LOOKAHEAD_USED, 0);
+    obj_lookup_page = SPIFFS_OBJ_LOOKUP_PAGES(fs);
+  }
+#endif
   // check each object lookup page
   while (res == SPIFFS_OK && obj_lookup_page < (int)SPIFFS_OBJ_LOOKUP_PAGES(fs)) {
     int entry_offset = obj_lookup_page * entries_per_page;
@@ -267,6 +283,14 @@ s32_t spiffs_gc_find_candidate(
     u16_t used_pages_in_block = 0;
 
     int obj_lookup_page = 0;
+#if SPIFFS_LOOKAHEAD
+    if (SPIFFS_LOOKAHEAD_VALID(fs)) {
+      // page states are in memory, no need to read object lookup
+      deleted_pages_in_block = spiffs_lookahead_block_count(fs, cur_block, SPIFFS_LOOKAHEAD_DELETED, 1);
+      used_pages_in_block = spiffs_lookahead_block_count(fs, cur_block, SPIFFS_LOOKAHEAD_USED, 1);
+      obj_lookup_page = SPIFFS_OBJ_LOOKUP_PAGES(fs);
+    }
+#endif
     // check each object lookup page
     while (res == SPIFFS_OK && obj_lookup_page < (int)SPIFFS_OBJ_LOOKUP_PAGES(fs)) {
       int entry_offset = obj_lookup_page * entries_per_page;
@@ -297,10 +321,17 @@ s32_t spiffs_gc_find_candidate(
     if (res == SPIFFS_OK /*&& deleted_pages_in_block > 0*/) {
       // read erase count
       spiffs_obj_id erase_count;
-      res = _spiffs_rd(fs, SPIFFS_OP_C_READ | SPIFFS_OP_T_OBJ_LU2, 0,
-          SPIFFS_ERASE_COUNT_PADDR(fs, cur_block),
-          sizeof(spiffs_obj_id), (u8_t *)&erase_count);
-      SPIFFS_CHECK_RES(res);
+#if SPIFFS_LOOKAHEAD
+      if (SPIFFS_LOOKAHEAD_VALID(fs)) {
+        erase_count = spiffs_lookahead_erase_count(fs, cur_block);
+      } else
+#endif
+      {
+        res = _spiffs_rd(fs, SPIFFS_OP_C_READ | SPIFFS_OP_T_OBJ_LU2, 0,
+            SPIFFS_ERASE_COUNT_PADDR(fs, cur_block),
+            sizeof(spiffs_obj_id), (u8_t *)&erase_count);
+        SPIFFS_CHECK_RES(res);
+      }
 
       spiffs_obj_id erase_age;
       if (fs->max_erase_count > erase_count) {
@@ -85,11 +85,23 @@ s32_t SPIFFS_mount(spiffs *fs, spiffs_config *config, u8_t *work,
                  SPIFFS_CFG_PHYS_ADDR(fs),
                  fd_space_size, cache_size);
   void *user_data;
+#if SPIFFS_LOOKAHEAD
+  void *lookahead;
+  u32_t lookahead_size;
+#endif
   SPIFFS_LOCK(fs);
   user_data = fs->user_data;
+#if SPIFFS_LOOKAHEAD
+  lookahead = fs->lookahead;
+  lookahead_size = fs->lookahead_size;
+#endif
   memset(fs, 0, sizeof(spiffs));
   _SPIFFS_MEMCPY(&fs->cfg, config, sizeof(spiffs_config));
   fs->user_data = user_data;
+#if SPIFFS_LOOKAHEAD
+  fs->lookahead = lookahead;
+  fs->lookahead_size = lookahead_size;
+#endif
   fs->block_count = SPIFFS_CFG_PHYS_SZ(fs) / SPIFFS_CFG_LOG_BLOCK_SZ(fs);
   fs->work = &work[0];
   fs->lu_work = &work[SPIFFS_CFG_LOG_PAGE_SZ(fs)];
@@ -167,6 +179,9 @@ void SPIFFS_unmount(spiffs *fs) {
       spiffs_fd_return(fs, cur_fd->file_nbr);
     }
   }
+#if SPIFFS_LOOKAHEAD
+  spiffs_lookahead_validate(fs, 0);
+#endif
   fs->mounted = 0;
 
   SPIFFS_UNLOCK(fs);
@@ -1221,6 +1236,12 @@ s32_t SPIFFS_check(spiffs *fs) {
   SPIFFS_API_CHECK_MOUNT(fs);
   SPIFFS_LOCK(fs);
 
+#if SPIFFS_LOOKAHEAD
+  // check repairs the medium behind the lookahead's back, it is rebuilt by
+  // the final scan
+  spiffs_lookahead_validate(fs, 0);
+#endif
+
   res = spiffs_lookup_consistency_check(fs, 0);
 
   res = spiffs_object_index_consistency_check(fs);
@@ -1354,6 +1375,38 @@ s32_t SPIFFS_set_file_callback_func(spiffs *fs, spiffs_file_callback cb_func) {
   return 0;
 }
 
+#if SPIFFS_LOOKAHEAD
+
+s32_t SPIFFS_lookahead(spiffs *fs, void *buf, u32_t size) {
+  SPIFFS_API_DBG("%s "_SPIPRIi "\n", __func__, size);
+  s32_t res = SPIFFS_OK;
+  SPIFFS_LOCK(fs);
+
+  // align lookahead pointer to pointer size byte boundary
+  u8_t ptr_size = sizeof(void*);
+  u8_t addr_lsb = ((u8_t)(intptr_t)buf) & (ptr_size-1);
+  if (buf && addr_lsb) {
+    buf = (u8_t *)buf + (ptr_size-addr_lsb);
+    size = size > (u32_t)(ptr_size-addr_lsb) ? size - (ptr_size-addr_lsb) : 0;
+  }
+  fs->lookahead = buf;
+  fs->lookahead_size = buf ? size : 0;
+
+  if (buf && SPIFFS_CHECK_CFG(fs) && SPIFFS_CHECK_MOUNT(fs)) {
+    // build directly, memory too small is released by the scan
+    res = spiffs_obj_lu_scan(fs);
+    if (res == SPIFFS_OK && fs->lookahead == 0) {
+      res = SPIFFS_ERR_LOOKAHEAD_TOO_SMALL;
+    }
+    SPIFFS_API_CHECK_RES_UNLOCK(fs, res);
+  }
+
+  SPIFFS_UNLOCK(fs);
+  return res;
+}
+
+#endif // SPIFFS_LOOKAHEAD
+
 #if SPIFFS_IX_MAP
 
 s32_t SPIFFS_ix_map(spiffs *fs,  spiffs_file fh, spiffs_ix_map *map,
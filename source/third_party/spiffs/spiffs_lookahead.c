@@ -0,0 +1,525 @@
+/*
+ * spiffs_lookahead.c
+ *
+ * Memory resident mirror of the object lookup pages: page states, block
+ * erase counts, object ids in use and an object index page hash table.
+ * Lets the nucleus and gc find free pages, object index pages and gc
+ * candidates without scanning the medium, see SPIFFS_lookahead.
+ */
+
+#include "spiffs.h"
+#include "spiffs_nucleus.h"
+
+#if SPIFFS_LOOKAHEAD
+
+#define SPIFFS_LOOKAHEAD_ALIGN(x, a) (((x) + (a) - 1) & ~((a) - 1))
+
+// highest object id handed out, same range as spiffs_obj_lu_find_free_obj_id
+static spiffs_obj_id spiffs_lookahead_max_obj_id(spiffs *fs, u32_t block_count) {
+  u32_t max_obj_id = (block_count * SPIFFS_OBJ_LOOKUP_MAX_ENTRIES(fs)) / 2 + 1;
+  if (max_obj_id >= SPIFFS_OBJ_ID_IX_FLAG) {
+    max_obj_id = SPIFFS_OBJ_ID_IX_FLAG - 1;
+  }
+  return (spiffs_obj_id)max_obj_id;
+}
+
+// returns bytes needed for all but the object index hash table
+static u32_t spiffs_lookahead_fixed_size(spiffs *fs, u32_t block_count) {
+  u32_t entries = block_count * SPIFFS_OBJ_LOOKUP_MAX_ENTRIES(fs);
+  return SPIFFS_LOOKAHEAD_ALIGN(sizeof(spiffs_lookahead), sizeof(void *)) +
+      (entries + 15) / 16 * sizeof(u32_t) +
+      SPIFFS_LOOKAHEAD_ALIGN(block_count * sizeof(spiffs_obj_id), sizeof(u32_t)) +
+      (spiffs_lookahead_max_obj_id(fs, block_count) / 32 + 1) * sizeof(u32_t);
+}
+
+// max used hash table entries, always leaving at least one entry unused
+static u32_t spiffs_lookahead_ix_max_used(spiffs_lookahead *la) {
+  return la->ix_entries - 1 - la->ix_entries / 8;
+}
+
+#if SPIFFS_BUFFER_HELP
+u32_t SPIFFS_buffer_bytes_for_lookahead(spiffs *fs, u32_t num_ix_pages) {
+  u32_t block_count = SPIFFS_CFG_PHYS_SZ(fs) / SPIFFS_CFG_LOG_BLOCK_SZ(fs);
+  return spiffs_lookahead_fixed_size(fs, block_count) +
+      (num_ix_pages + num_ix_pages / 7 + 2) * sizeof(spiffs_lookahead_ix);
+}
+#endif
+
+static u32_t spiffs_lookahead_get_state(spiffs_lookahead *la, u32_t e) {
+  return (la->page_states[e / 16] >> ((e % 16) * 2)) & 3;
+}
+
+static void spiffs_lookahead_set_state(spiffs_lookahead *la, u32_t e, u32_t state) {
+  u32_t shift = (e % 16) * 2;
+  la->page_states[e / 16] = (la->page_states[e / 16] & ~(3u << shift)) | (state << shift);
+}
+
+static void spiffs_lookahead_mark_obj_id(spiffs_lookahead *la, spiffs_obj_id obj_id) {
+  obj_id &= ~SPIFFS_OBJ_ID_IX_FLAG;
+  if (obj_id != 0 && obj_id <= la->max_obj_id) {
+    la->obj_ids[obj_id / 32] |= 1u << (obj_id % 32);
+  }
+}
+
+// djb2 hash of name, folded to 16 bits, never 0
+static u16_t spiffs_lookahead_name_hash(const u8_t *name) {
+  u32_t hash = 5381;
+  u8_t c;
+  int i = 0;
+  while ((c = name[i++]) && i < SPIFFS_OBJ_NAME_LEN) {
+    hash = (hash * 33) ^ c;
+  }
+  hash ^= hash >> 16;
+  return (u16_t)hash == 0 ? 1 : (u16_t)hash;
+}
+
+static u32_t spiffs_lookahead_ix_home(spiffs_lookahead *la, spiffs_obj_id obj_id, spiffs_span_ix spix) {
+  u32_t h = (((u32_t)obj_id << 16) | spix) * 2654435761u;
+  return (h ^ (h >> 16)) % la->ix_entries;
+}
+
+// returns hash table entry index for object index, or -1
+static s32_t spiffs_lookahead_ix_get(spiffs_lookahead *la, spiffs_obj_id obj_id, spiffs_span_ix spix) {
+  u32_t i = spiffs_lookahead_ix_home(la, obj_id, spix);
+  while (la->ix[i].obj_id != SPIFFS_OBJ_ID_FREE) {
+    if (la->ix[i].obj_id == obj_id && la->ix[i].span_ix == spix) {
+      return i;
+    }
+    if (++i == la->ix_entries) i = 0;
+  }
+  return -1;
+}
+
+// removes hash table entry, moving back following entries of the probe run
+static void spiffs_lookahead_ix_remove(spiffs_lookahead *la, u32_t i) {
+  u32_t j = i;
+  while (1) {
+    if (++j == la->ix_entries) j = 0;
+    if (la->ix[j].obj_id == SPIFFS_OBJ_ID_FREE) break;
+    u32_t home = spiffs_lookahead_ix_home(la, la->ix[j].obj_id, la->ix[j].span_ix);
+    // leave entries whose home is cyclically within (i, j]
+    if (i <= j ? (i < home && home <= j) : (i < home || home <= j)) continue;
+    la->ix[i] = la->ix[j];
+    i = j;
+  }
+  la->ix[i].obj_id = SPIFFS_OBJ_ID_FREE;
+  la->ix_used--;
+}
+
+// inserts or updates hash table entry, a name hash of 0 keeps any known hash
+static void spiffs_lookahead_ix_put(spiffs_lookahead *la, spiffs_obj_id obj_id, spiffs_span_ix spix,
+    spiffs_page_ix pix, u16_t name_hash) {
+  u32_t i = spiffs_lookahead_ix_home(la, obj_id, spix);
+  while (la->ix[i].obj_id != SPIFFS_OBJ_ID_FREE) {
+    if (la->ix[i].obj_id == obj_id && la->ix[i].span_ix == spix) {
+      la->ix[i].pix = pix;
+      if (name_hash) la->ix[i].name_hash = name_hash;
+      return;
+    }
+    if (++i == la->ix_entries) i = 0;
+  }
+  if (la->ix_used >= spiffs_lookahead_ix_max_used(la)) {
+    // table full, from now on a miss does not mean the index is not there
+    la->ix_complete = 0;
+    return;
+  }
+  la->ix[i].obj_id = obj_id;
+  la->ix[i].span_ix = spix;
+  la->ix[i].pix = pix;
+  la->ix[i].name_hash = name_hash;
+  la->ix_used++;
+}
+
+// Lays out lookahead memory for the mounted geometry and clears it.
+// Memory too small to be used is released.
+s32_t spiffs_lookahead_reset(
+    spiffs *fs) {
+  spiffs_lookahead *la = spiffs_get_lookahead(fs);
+  if (la == 0) return SPIFFS_OK;
+  u32_t fixed = spiffs_lookahead_fixed_size(fs, fs->block_count);
+  if (fs->lookahead_size < fixed + 2 * sizeof(spiffs_lookahead_ix)) {
+    fs->lookahead = 0;
+    fs->lookahead_size = 0;
+    return SPIFFS_ERR_LOOKAHEAD_TOO_SMALL;
+  }
+  u32_t entries = fs->block_count * SPIFFS_OBJ_LOOKUP_MAX_ENTRIES(fs);
+  u8_t *mem = (u8_t *)la + SPIFFS_LOOKAHEAD_ALIGN(sizeof(spiffs_lookahead), sizeof(void *));
+  la->valid = 0;
+  la->ix_complete = 1;
+  la->max_obj_id = spiffs_lookahead_max_obj_id(fs, fs->block_count);
+  la->page_states = (u32_t *)mem;
+  mem += (entries + 15) / 16 * sizeof(u32_t);
+  la->obj_ids = (u32_t *)mem;
+  mem += (la->max_obj_id / 32 + 1) * sizeof(u32_t);
+  la->erase_counts = (spiffs_obj_id *)mem;
+  mem += SPIFFS_LOOKAHEAD_ALIGN(fs->block_count * sizeof(spiffs_obj_id), sizeof(u32_t));
+  la->ix = (spiffs_lookahead_ix *)mem;
+  la->ix_entries = (fs->lookahead_size - fixed) / sizeof(spiffs_lookahead_ix);
+  la->ix_used = 0;
+
+  memset(la->page_states, 0, (entries + 15) / 16 * sizeof(u32_t));
+  memset(la->obj_ids, 0, (la->max_obj_id / 32 + 1) * sizeof(u32_t));
+  memset(la->erase_counts, 0xff, fs->block_count * sizeof(spiffs_obj_id));
+  memset(la->ix, 0xff, la->ix_entries * sizeof(spiffs_lookahead_ix));
+  la->block_count = fs->block_count;
+  return SPIFFS_OK;
+}
+
+// Registers erase count of a block when building lookahead
+void spiffs_lookahead_set_erase_count(
+    spiffs *fs,
+    spiffs_block_ix bix,
+    spiffs_obj_id erase_count) {
+  spiffs_lookahead *la = spiffs_get_lookahead(fs);
+  if (la == 0 || la->block_count == 0) return;
+  la->erase_counts[bix] = erase_count;
+}
+
+// Registers an object lookup entry when building lookahead. Object index
+// pages have their header read to be put in the hash table.
+s32_t spiffs_lookahead_scan_entry(
+    spiffs *fs,
+    spiffs_obj_id obj_id,
+    spiffs_block_ix bix,
+    int ix_entry) {
+  spiffs_lookahead *la = spiffs_get_lookahead(fs);
+  if (la == 0 || la->block_count == 0) return SPIFFS_OK;
+  u32_t e = bix * SPIFFS_OBJ_LOOKUP_MAX_ENTRIES(fs) + ix_entry;
+  if (obj_id == SPIFFS_OBJ_ID_FREE) {
+    spiffs_lookahead_set_state(la, e, SPIFFS_LOOKAHEAD_FREE);
+    return SPIFFS_OK;
+  }
+  if (obj_id == SPIFFS_OBJ_ID_DELETED) {
+    spiffs_lookahead_set_state(la, e, SPIFFS_LOOKAHEAD_DELETED);
+    return SPIFFS_OK;
+  }
+  spiffs_lookahead_set_state(la, e, SPIFFS_LOOKAHEAD_USED);
+  spiffs_lookahead_mark_obj_id(la, obj_id);
+  if ((obj_id & SPIFFS_OBJ_ID_IX_FLAG) == 0) return SPIFFS_OK;
+
+  s32_t res;
+  spiffs_page_object_ix_header objix_hdr;
+  spiffs_page_ix pix = SPIFFS_OBJ_LOOKUP_ENTRY_TO_PIX(fs, bix, ix_entry);
+  res = _spiffs_rd(fs, SPIFFS_OP_T_OBJ_LU2 | SPIFFS_OP_C_READ,
+      0, SPIFFS_PAGE_TO_PADDR(fs, pix), sizeof(spiffs_page_object_ix_header), (u8_t *)&objix_hdr);
+  SPIFFS_CHECK_RES(res);
+  // same conditions as when searching object lookup for id and span
+  if (objix_hdr.p_hdr.obj_id == obj_id &&
+      (objix_hdr.p_hdr.flags & (SPIFFS_PH_FLAG_FINAL | SPIFFS_PH_FLAG_DELET | SPIFFS_PH_FLAG_USED)) == SPIFFS_PH_FLAG_DELET &&
+      !((objix_hdr.p_hdr.flags & SPIFFS_PH_FLAG_IXDELE) == 0 && objix_hdr.p_hdr.span_ix == 0)) {
+    spiffs_lookahead_ix_put(la, obj_id & ~SPIFFS_OBJ_ID_IX_FLAG, objix_hdr.p_hdr.span_ix, pix,
+        objix_hdr.p_hdr.span_ix == 0 ? spiffs_lookahead_name_hash(objix_hdr.name) : 0);
+  }
+  return SPIFFS_OK;
+}
+
+// Sets lookahead valid after being built, or invalid while the medium is
+// modified in ways not tracked, e.g. by consistency checks
+void spiffs_lookahead_validate(
+    spiffs *fs,
+    u8_t valid) {
+  spiffs_lookahead *la = spiffs_get_lookahead(fs);
+  if (la == 0 || la->block_count == 0) return;
+  la->valid = valid;
+}
+
+// Updates page states, object ids and erase counts from a write to the medium
+void spiffs_lookahead_write(
+    spiffs *fs,
+    u32_t addr,
+    u32_t len,
+    const u8_t *src) {
+  spiffs_lookahead *la = spiffs_get_lookahead(fs);
+  if (la == 0 || la->block_count == 0) return;
+  u32_t offs = addr - SPIFFS_CFG_PHYS_ADDR(fs);
+  u32_t bix = offs / SPIFFS_CFG_LOG_BLOCK_SZ(fs);
+  u32_t boffs = offs % SPIFFS_CFG_LOG_BLOCK_SZ(fs);
+  u32_t lu_size = SPIFFS_OBJ_LOOKUP_PAGES(fs) * SPIFFS_CFG_LOG_PAGE_SZ(fs);
+  if (bix >= la->block_count || boffs >= lu_size) {
+    // not an object lookup page
+    return;
+  }
+  // object lookup is written in whole entries
+  u32_t entry = (boffs + sizeof(spiffs_obj_id) - 1) / sizeof(spiffs_obj_id);
+  u32_t entry_end = MIN(boffs + len, lu_size) / sizeof(spiffs_obj_id);
+  const u8_t *p = src + (entry * sizeof(spiffs_obj_id) - boffs);
+  for (; entry < entry_end; entry++, p += sizeof(spiffs_obj_id)) {
+    spiffs_obj_id obj_id;
+    _SPIFFS_MEMCPY(&obj_id, p, sizeof(spiffs_obj_id));
+    if (entry < SPIFFS_OBJ_LOOKUP_MAX_ENTRIES(fs)) {
+      u32_t e = bix * SPIFFS_OBJ_LOOKUP_MAX_ENTRIES(fs) + entry;
+      if (obj_id == SPIFFS_OBJ_ID_DELETED) {
+        spiffs_lookahead_set_state(la, e, SPIFFS_LOOKAHEAD_DELETED);
+      } else if (obj_id != SPIFFS_OBJ_ID_FREE &&
+          spiffs_lookahead_get_state(la, e) == SPIFFS_LOOKAHEAD_FREE) {
+        spiffs_lookahead_set_state(la, e, SPIFFS_LOOKAHEAD_USED);
+        spiffs_lookahead_mark_obj_id(la, obj_id);
+      }
+    } else if ((entry + 1) * sizeof(spiffs_obj_id) == lu_size) {
+      // erase count, last entry of object lookup; bits can only be cleared
+      la->erase_counts[bix] &= obj_id;
+    }
+  }
+}
+
+// Clears page states and object index pages of an erased block
+void spiffs_lookahead_erase(
+    spiffs *fs,
+    spiffs_block_ix bix) {
+  spiffs_lookahead *la = spiffs_get_lookahead(fs);
+  if (la == 0 || la->block_count == 0) return;
+  u32_t e = bix * SPIFFS_OBJ_LOOKUP_MAX_ENTRIES(fs);
+  u32_t e_end = e + SPIFFS_OBJ_LOOKUP_MAX_ENTRIES(fs);
+  for (; e < e_end; e++) {
+    spiffs_lookahead_set_state(la, e, SPIFFS_LOOKAHEAD_FREE);
+  }
+  la->erase_counts[bix] = SPIFFS_OBJ_ID_FREE;
+  u32_t i = 0;
+  while (i < la->ix_entries) {
+    if (la->ix[i].obj_id != SPIFFS_OBJ_ID_FREE && SPIFFS_BLOCK_FOR_PAGE(fs, la->ix[i].pix) == bix) {
+      // removing moves a following entry here, check this entry again
+      spiffs_lookahead_ix_remove(la, i);
+    } else {
+      i++;
+    }
+  }
+}
+
+// Keeps object index hash table up to date on object index events
+void spiffs_lookahead_event(
+    spiffs *fs,
+    spiffs_page_object_ix *objix,
+    int ev,
+    spiffs_obj_id obj_id,
+    spiffs_span_ix spix,
+    spiffs_page_ix new_pix) {
+  spiffs_lookahead *la = spiffs_get_lookahead(fs);
+  if (la == 0 || la->block_count == 0) return;
+  obj_id &= ~SPIFFS_OBJ_ID_IX_FLAG;
+  if (ev == SPIFFS_EV_IX_DEL) {
+    s32_t i = spiffs_lookahead_ix_get(la, obj_id, spix);
+    if (i >= 0) {
+      spiffs_lookahead_ix_remove(la, i);
+    }
+    return;
+  }
+  u16_t name_hash = 0;
+  if (spix == 0 && ev != SPIFFS_EV_IX_MOV && objix) {
+    // moves during gc only give the page header, other events the full page
+    name_hash = spiffs_lookahead_name_hash(((spiffs_page_object_ix_header *)objix)->name);
+  }
+  spiffs_lookahead_ix_put(la, obj_id, spix, new_pix, name_hash);
+}
+
+// Counts object lookup entries of a block in given state, optionally
+// stopping at the first free entry
+u32_t spiffs_lookahead_block_count(
+    spiffs *fs,
+    spiffs_block_ix bix,
+    u8_t state,
+    u8_t stop_at_free) {
+  spiffs_lookahead *la = spiffs_get_lookahead(fs);
+  u32_t count = 0;
+  u32_t e = bix * SPIFFS_OBJ_LOOKUP_MAX_ENTRIES(fs);
+  u32_t e_end = e + SPIFFS_OBJ_LOOKUP_MAX_ENTRIES(fs);
+  for (; e < e_end; e++) {
+    u32_t cur_state = spiffs_lookahead_get_state(la, e);
+    if (stop_at_free && cur_state == SPIFFS_LOOKAHEAD_FREE) break;
+    if (cur_state == state) count++;
+  }
+  return count;
+}
+
+spiffs_obj_id spiffs_lookahead_erase_count(
+    spiffs *fs,
+    spiffs_block_ix bix) {
+  return spiffs_get_lookahead(fs)->erase_counts[bix];
+}
+
+// Finds a free object lookup entry from given position, wrapping like
+// spiffs_obj_lu_find_id
+s32_t spiffs_lookahead_find_free(
+    spiffs *fs,
+    spiffs_block_ix starting_block,
+    int starting_lu_entry,
+    spiffs_block_ix *block_ix,
+    int *lu_entry) {
+  if (!SPIFFS_LOOKAHEAD_VALID(fs)) return SPIFFS_LOOKAHEAD_SCAN;
+  spiffs_lookahead *la = spiffs_get_lookahead(fs);
+  u32_t entries_per_block = SPIFFS_OBJ_LOOKUP_MAX_ENTRIES(fs);
+  u32_t entry_count = fs->block_count * entries_per_block;
+  u32_t left = entry_count;
+  u32_t e;
+  if (starting_lu_entry > (int)entries_per_block - 1) {
+    e = (starting_block + 1) * entries_per_block;
+  } else {
+    e = starting_block * entries_per_block + starting_lu_entry;
+  }
+  if (e >= entry_count) e = 0;
+  while (left > 0) {
+    if ((e % 16) == 0 && left >= 16 && e + 16 <= entry_count) {
+      u32_t w = la->page_states[e / 16];
+      if (((w | (w >> 1)) & 0x55555555) == 0x55555555) {
+        // no free page amongst these sixteen
+        left -= 16;
+        e += 16;
+        if (e == entry_count) e = 0;
+        continue;
+      }
+    }
+    if (spiffs_lookahead_get_state(la, e) == SPIFFS_LOOKAHEAD_FREE) {
+      *block_ix = e / entries_per_block;
+      *lu_entry = e % entries_per_block;
+      return SPIFFS_OK;
+    }
+    left--;
+    if (++e == entry_count) e = 0;
+  }
+  return SPIFFS_ERR_NOT_FOUND;
+}
+
+// Checks that a hash table entry refers to a valid object index page,
+// same conditions as when searching object lookup for id and span
+static s32_t spiffs_lookahead_ix_check(spiffs *fs, spiffs_lookahead_ix *ix, spiffs_page_object_ix_header *objix_hdr,
+    u32_t len) {
+  s32_t res;
+  spiffs_block_ix bix = SPIFFS_BLOCK_FOR_PAGE(fs, ix->pix);
+  int entry = SPIFFS_OBJ_LOOKUP_ENTRY_FOR_PAGE(fs, ix->pix);
+  if (spiffs_lookahead_get_state(spiffs_get_lookahead(fs), bix * SPIFFS_OBJ_LOOKUP_MAX_ENTRIES(fs) + entry) !=
+      SPIFFS_LOOKAHEAD_USED) {
+    return SPIFFS_ERR_NOT_FOUND;
+  }
+  res = _spiffs_rd(fs, SPIFFS_OP_T_OBJ_LU2 | SPIFFS_OP_C_READ,
+      0, SPIFFS_PAGE_TO_PADDR(fs, ix->pix), len, (u8_t *)objix_hdr);
+  SPIFFS_CHECK_RES(res);
+  if (objix_hdr->p_hdr.obj_id == (ix->obj_id | SPIFFS_OBJ_ID_IX_FLAG) &&
+      objix_hdr->p_hdr.span_ix == ix->span_ix &&
+      (objix_hdr->p_hdr.flags & (SPIFFS_PH_FLAG_FINAL | SPIFFS_PH_FLAG_DELET | SPIFFS_PH_FLAG_USED)) == SPIFFS_PH_FLAG_DELET &&
+      !((objix_hdr->p_hdr.flags & SPIFFS_PH_FLAG_IXDELE) == 0 && ix->span_ix == 0)) {
+    return SPIFFS_OK;
+  }
+  return SPIFFS_ERR_NOT_FOUND;
+}
+
+// Finds object index page for object id and span index in hash table.
+// Returns SPIFFS_LOOKAHEAD_SCAN if the medium must be searched instead.
+s32_t spiffs_lookahead_find_ix(
+    spiffs *fs,
+    spiffs_obj_id obj_id,
+    spiffs_span_ix spix,
+    spiffs_page_ix exclusion_pix,
+    spiffs_block_ix *block_ix,
+    int *lu_entry) {
+  if (!SPIFFS_LOOKAHEAD_VALID(fs) ||
+      (obj_id & SPIFFS_OBJ_ID_IX_FLAG) == 0 || exclusion_pix != 0) {
+    return SPIFFS_LOOKAHEAD_SCAN;
+  }
+  s32_t res;
+  spiffs_lookahead *la = spiffs_get_lookahead(fs);
+  spiffs_page_object_ix_header objix_hdr;
+  s32_t i = spiffs_lookahead_ix_get(la, obj_id & ~SPIFFS_OBJ_ID_IX_FLAG, spix);
+  if (i < 0) {
+    return la->ix_complete ? SPIFFS_ERR_NOT_FOUND : SPIFFS_LOOKAHEAD_SCAN;
+  }
+  res = spiffs_lookahead_ix_check(fs, &la->ix[i], &objix_hdr, sizeof(spiffs_page_header));
+  if (res == SPIFFS_ERR_NOT_FOUND) {
+    // stale entry, drop it and let the medium tell
+    spiffs_lookahead_ix_remove(la, i);
+    return SPIFFS_LOOKAHEAD_SCAN;
+  }
+  SPIFFS_CHECK_RES(res);
+  *block_ix = SPIFFS_BLOCK_FOR_PAGE(fs, la->ix[i].pix);
+  *lu_entry = SPIFFS_OBJ_LOOKUP_ENTRY_FOR_PAGE(fs, la->ix[i].pix);
+  return SPIFFS_OK;
+}
+
+// Finds object index header page by name in hash table.
+// Returns SPIFFS_LOOKAHEAD_SCAN if the medium must be searched instead.
+s32_t spiffs_lookahead_find_by_name(
+    spiffs *fs,
+    const u8_t name[SPIFFS_OBJ_NAME_LEN],
+    spiffs_block_ix *block_ix,
+    int *lu_entry) {
+  if (!SPIFFS_LOOKAHEAD_VALID(fs)) return SPIFFS_LOOKAHEAD_SCAN;
+  s32_t res;
+  spiffs_lookahead *la = spiffs_get_lookahead(fs);
+  spiffs_page_object_ix_header objix_hdr;
+  u16_t name_hash = spiffs_lookahead_name_hash(name);
+  u32_t i;
+  for (i = 0; i < la->ix_entries; i++) {
+    spiffs_lookahead_ix *ix = &la->ix[i];
+    if (ix->obj_id == SPIFFS_OBJ_ID_FREE || ix->span_ix != 0 ||
+        (ix->name_hash != 0 && ix->name_hash != name_hash)) {
+      continue;
+    }
+    res = spiffs_lookahead_ix_check(fs, ix, &objix_hdr, sizeof(spiffs_page_object_ix_header));
+    if (res == SPIFFS_ERR_NOT_FOUND) continue;
+    SPIFFS_CHECK_RES(res);
+    ix->name_hash = spiffs_lookahead_name_hash(objix_hdr.name);
+    if (strcmp((const char *)name, (char *)objix_hdr.name) == 0) {
+      *block_ix = SPIFFS_BLOCK_FOR_PAGE(fs, ix->pix);
+      *lu_entry = SPIFFS_OBJ_LOOKUP_ENTRY_FOR_PAGE(fs, ix->pix);
+      return SPIFFS_OK;
+    }
+  }
+  return la->ix_complete ? SPIFFS_ERR_NOT_FOUND : SPIFFS_LOOKAHEAD_SCAN;
+}
+
+static s32_t spiffs_lookahead_obj_ids_v(spiffs *fs, spiffs_obj_id id, spiffs_block_ix bix, int ix_entry,
+    const void *user_const_p, void *user_var_p) {
+  (void)bix;
+  (void)ix_entry;
+  (void)user_const_p;
+  (void)user_var_p;
+  if (id != SPIFFS_OBJ_ID_FREE && id != SPIFFS_OBJ_ID_DELETED) {
+    spiffs_lookahead_mark_obj_id(spiffs_get_lookahead(fs), id);
+  }
+  return SPIFFS_VIS_COUNTINUE;
+}
+
+// Finds a free object id in the object id bitmap. Ids are not released when
+// objects are deleted; when all ids have been handed out, the bitmap is
+// rebuilt from the object lookup once.
+// Returns SPIFFS_LOOKAHEAD_SCAN if the medium must be searched instead.
+s32_t spiffs_lookahead_find_free_obj_id(
+    spiffs *fs,
+    spiffs_obj_id *obj_id,
+    const u8_t *conflicting_name) {
+  if (!SPIFFS_LOOKAHEAD_VALID(fs)) return SPIFFS_LOOKAHEAD_SCAN;
+  s32_t res;
+  spiffs_lookahead *la = spiffs_get_lookahead(fs);
+  if (conflicting_name) {
+    spiffs_block_ix bix;
+    int entry;
+    res = spiffs_lookahead_find_by_name(fs, conflicting_name, &bix, &entry);
+    if (res == SPIFFS_OK) return SPIFFS_ERR_CONFLICTING_NAME;
+    if (res != SPIFFS_ERR_NOT_FOUND) return res;
+  }
+  u32_t words = la->max_obj_id / 32 + 1;
+  int rebuilt = 0;
+  while (1) {
+    u32_t w;
+    // id 0 is never free
+    la->obj_ids[0] |= 1;
+    for (w = 0; w < words; w++) {
+      u32_t used = la->obj_ids[w];
+      if (used == 0xffffffff) continue;
+      u32_t b = 0;
+      while (used & (1u << b)) b++;
+      u32_t id = w * 32 + b;
+      if (id > la->max_obj_id) break;
+      la->obj_ids[w] |= 1u << b;
+      *obj_id = (spiffs_obj_id)id;
+      return SPIFFS_OK;
+    }
+    if (rebuilt) return SPIFFS_ERR_FULL;
+    // all ids handed out since built, find ids actually in use
+    memset(la->obj_ids, 0, words * sizeof(u32_t));
+    res = spiffs_obj_lu_find_entry_visitor(fs, 0, 0, 0, 0, spiffs_lookahead_obj_ids_v, 0, 0, 0, 0);
+    if (res == SPIFFS_VIS_END) res = SPIFFS_OK;
+    SPIFFS_CHECK_RES(res);
+    rebuilt = 1;
+  }
+}
+
+#endif // SPIFFS_LOOKAHEAD
@@ -74,6 +74,9 @@ s32_t spiffs_phys_wr(
     u32_t addr,
     u32_t len,
     u8_t *src) {
+#if SPIFFS_LOOKAHEAD
+  spiffs_lookahead_write(fs, addr, len, src);
+#endif
   return SPIFFS_HAL_WRITE(fs, addr, len, src);
 }
 
@@ -239,6 +242,9 @@ s32_t spiffs_erase_block(
     size -= SPIFFS_CFG_PHYS_ERASE_SZ(fs);
   }
   fs->free_blocks++;
+#if SPIFFS_LOOKAHEAD
+  spiffs_lookahead_erase(fs, bix);
+#endif
 
   // register erase count for this block
   res = _spiffs_wr(fs, SPIFFS_OP_C_WRTHRU | SPIFFS_OP_T_OBJ_LU2, 0,
@@ -338,6 +344,11 @@ static s32_t spiffs_obj_lu_scan_v(
     fs->stats_p_allocated++;
   }
 
+#if SPIFFS_LOOKAHEAD
+  s32_t res = spiffs_lookahead_scan_entry(fs, obj_id, bix, ix_entry);
+  SPIFFS_CHECK_RES(res);
+#endif
+
   return SPIFFS_VIS_COUNTINUE;
 }
 
@@ -354,6 +365,11 @@ s32_t spiffs_obj_lu_scan(
   spiffs_block_ix unerased_bix = (spiffs_block_ix)-1;
 #endif
 
+#if SPIFFS_LOOKAHEAD
+  // lookahead is built while scanning, memory too small is not used
+  (void)spiffs_lookahead_reset(fs);
+#endif
+
   // find out erase count
   // if enabled, check magic
   bix = 0;
@@ -389,6 +405,9 @@ s32_t spiffs_obj_lu_scan(
       erase_count_min = MIN(erase_count_min, erase_count);
       erase_count_max = MAX(erase_count_max, erase_count);
     }
+#if SPIFFS_LOOKAHEAD
+    spiffs_lookahead_set_erase_count(fs, bix, erase_count);
+#endif
     bix++;
   }
 
@@ -440,6 +459,10 @@ s32_t spiffs_obj_lu_scan(
 
   SPIFFS_CHECK_RES(res);
 
+#if SPIFFS_LOOKAHEAD
+  spiffs_lookahead_validate(fs, 1);
+#endif
+
   return res;
 }
 
@@ -463,6 +486,10 @@ s32_t spiffs_obj_lu_find_free(
       return SPIFFS_ERR_FULL;
     }
   }
+#if SPIFFS_LOOKAHEAD
+  res = spiffs_lookahead_find_free(fs, starting_block, starting_lu_entry, block_ix, lu_entry);
+  if (res == SPIFFS_LOOKAHEAD_SCAN)
+#endif
   res = spiffs_obj_lu_find_id(fs, starting_block, starting_lu_entry,
       SPIFFS_OBJ_ID_FREE, block_ix, lu_entry);
   if (res == SPIFFS_OK) {
@@ -534,19 +561,25 @@ s32_t spiffs_obj_lu_find_id_and_span(
   spiffs_block_ix bix;
   int entry;
 
-  res = spiffs_obj_lu_find_entry_visitor(fs,
-      fs->cursor_block_ix,
-      fs->cursor_obj_lu_entry,
-      SPIFFS_VIS_CHECK_ID,
-      obj_id,
-      spiffs_obj_lu_find_id_and_span_v,
-      exclusion_pix ? &exclusion_pix : 0,
-      &spix,
-      &bix,
-      &entry);
-
-  if (res == SPIFFS_VIS_END) {
-    res = SPIFFS_ERR_NOT_FOUND;
+#if SPIFFS_LOOKAHEAD
+  res = spiffs_lookahead_find_ix(fs, obj_id, spix, exclusion_pix, &bix, &entry);
+  if (res == SPIFFS_LOOKAHEAD_SCAN)
+#endif
+  {
+    res = spiffs_obj_lu_find_entry_visitor(fs,
+        fs->cursor_block_ix,
+        fs->cursor_obj_lu_entry,
+        SPIFFS_VIS_CHECK_ID,
+        obj_id,
+        spiffs_obj_lu_find_id_and_span_v,
+        exclusion_pix ? &exclusion_pix : 0,
+        &spix,
+        &bix,
+        &entry);
+
+    if (res == SPIFFS_VIS_END) {
+      res = SPIFFS_ERR_NOT_FOUND;
+    }
   }
 
   SPIFFS_CHECK_RES(res);
@@ -1057,6 +1090,10 @@ void spiffs_cb_object_event(
   spiffs_fd *fds = (spiffs_fd *)fs->fd_space;
   SPIFFS_DBG("       CALLBACK  %s obj_id:"_SPIPRIid" spix:"_SPIPRIsp" npix:"_SPIPRIpg" nsz:"_SPIPRIi"\n", (const char *[]){"UPD", "NEW", "DEL", "MOV", "HUP","???"}[MIN(ev,5)],
       obj_id_raw, spix, new_pix, new_size);
+#if SPIFFS_LOOKAHEAD
+  // update object index hash table
+  spiffs_lookahead_event(fs, objix, ev, obj_id, spix, new_pix);
+#endif
   for (i = 0; i < fs->fd_count; i++) {
     spiffs_fd *cur_fd = &fds[i];
     if ((cur_fd->obj_id & ~SPIFFS_OBJ_ID_IX_FLAG) != obj_id) continue; // fd not related to updated file
@@ -1698,19 +1735,25 @@ s32_t spiffs_object_find_object_index_header_by_name(
   spiffs_block_ix bix;
   int entry;
 
-  res = spiffs_obj_lu_find_entry_visitor(fs,
-      fs->cursor_block_ix,
-      fs->cursor_obj_lu_entry,
-      0,
-      0,
-      spiffs_object_find_object_index_header_by_name_v,
-      name,
-      0,
-      &bix,
-      &entry);
-
-  if (res == SPIFFS_VIS_END) {
-    res = SPIFFS_ERR_NOT_FOUND;
+#if SPIFFS_LOOKAHEAD
+  res = spiffs_lookahead_find_by_name(fs, name, &bix, &entry);
+  if (res == SPIFFS_LOOKAHEAD_SCAN)
+#endif
+  {
+    res = spiffs_obj_lu_find_entry_visitor(fs,
+        fs->cursor_block_ix,
+        fs->cursor_obj_lu_entry,
+        0,
+        0,
+        spiffs_object_find_object_index_header_by_name_v,
+        name,
+        0,
+        &bix,
+        &entry);
+
+    if (res == SPIFFS_VIS_END) {
+      res = SPIFFS_ERR_NOT_FOUND;
+    }
   }
   SPIFFS_CHECK_RES(res);
 
@@ -2144,6 +2187,13 @@ s32_t spiffs_obj_lu_find_free_obj_id(spiffs *fs, spiffs_obj_id *obj_id, const u8
   }
   state.compaction = 0;
   state.conflicting_name = conflicting_name;
+#if SPIFFS_LOOKAHEAD
+  res = spiffs_lookahead_find_free_obj_id(fs, obj_id, conflicting_name);
+  if (res != SPIFFS_LOOKAHEAD_SCAN) {
+    return res;
+  }
+  res = SPIFFS_OK;
+#endif
   while (res == SPIFFS_OK && free_obj_id == SPIFFS_OBJ_ID_FREE) {
     if (state.max_obj_id - state.min_obj_id <= (spiffs_obj_id)SPIFFS_CFG_LOG_PAGE_SZ(fs)*8) {
       // possible to represent in bitmap
@@ -122,6 +122,8 @@
 #define SPIFFS_VIS_COUNTINUE_RELOAD     (SPIFFS_ERR_INTERNAL - 21)
 // visitor result, stop searching
 #define SPIFFS_VIS_END                  (SPIFFS_ERR_INTERNAL - 22)
+// lookahead result, not known from memory, search the medium
+#define SPIFFS_LOOKAHEAD_SCAN           (SPIFFS_ERR_INTERNAL - 23)
 
 // updating an object index contents
 #define SPIFFS_EV_IX_UPD                (0)
@@ -436,6 +438,57 @@ typedef struct {
 
 #endif
 
+#if SPIFFS_LOOKAHEAD
+
+// lookahead page states, two bits per object lookup entry
+#define SPIFFS_LOOKAHEAD_FREE         (0)
+#define SPIFFS_LOOKAHEAD_USED         (1)
+#define SPIFFS_LOOKAHEAD_DELETED      (2)
+
+#define spiffs_get_lookahead(fs) \
+  ((spiffs_lookahead *)((fs)->lookahead))
+
+// checks if lookahead may be used instead of searching the medium
+#define SPIFFS_LOOKAHEAD_VALID(fs) \
+  ((fs)->lookahead != 0 && spiffs_get_lookahead(fs)->valid)
+
+// lookahead object index hash table entry
+typedef struct {
+  // object id without index flag, SPIFFS_OBJ_ID_FREE if entry is unused
+  spiffs_obj_id obj_id;
+  // object index span index
+  spiffs_span_ix span_ix;
+  // object index page
+  spiffs_page_ix pix;
+  // name hash for object index headers, 0 if not known
+  u16_t name_hash;
+} spiffs_lookahead_ix;
+
+// lookahead struct, first in lookahead memory area
+typedef struct {
+  // number of blocks the area is laid out for, 0 if not laid out
+  u32_t block_count;
+  // contents are coherent with the medium
+  u8_t valid;
+  // all valid object index pages are in hash table
+  u8_t ix_complete;
+  // highest object id in object id bitmap
+  spiffs_obj_id max_obj_id;
+  // page states, two bits per object lookup entry
+  u32_t *page_states;
+  // erase count per block
+  spiffs_obj_id *erase_counts;
+  // object ids seen in object lookup since built, one bit per id
+  u32_t *obj_ids;
+  // object index hash table
+  spiffs_lookahead_ix *ix;
+  // number of entries in object index hash table
+  u32_t ix_entries;
+  // number of used entries in object index hash table
+  u32_t ix_used;
+} spiffs_lookahead;
+
+#endif
 
 // spiffs nucleus file descriptor
 typedef struct {
@@ -809,6 +862,80 @@ spiffs_cache_page *spiffs_cache_page_get_by_fd(
 #endif
 #endif
 
+#if SPIFFS_LOOKAHEAD
+s32_t spiffs_lookahead_reset(
+    spiffs *fs);
+
+void spiffs_lookahead_set_erase_count(
+    spiffs *fs,
+    spiffs_block_ix bix,
+    spiffs_obj_id erase_count);
+
+s32_t spiffs_lookahead_scan_entry(
+    spiffs *fs,
+    spiffs_obj_id obj_id,
+    spiffs_block_ix bix,
+    int ix_entry);
+
+void spiffs_lookahead_validate(
+    spiffs *fs,
+    u8_t valid);
+
+void spiffs_lookahead_write(
+    spiffs *fs,
+    u32_t addr,
+    u32_t len,
+    const u8_t *src);
+
+void spiffs_lookahead_erase(
+    spiffs *fs,
+    spiffs_block_ix bix);
+
+void spiffs_lookahead_event(
+    spiffs *fs,
+    spiffs_page_object_ix *objix,
+    int ev,
+    spiffs_obj_id obj_id,
+    spiffs_span_ix spix,
+    spiffs_page_ix new_pix);
+
+u32_t spiffs_lookahead_block_count(
+    spiffs *fs,
+    spiffs_block_ix bix,
+    u8_t state,
+    u8_t stop_at_free);
+
+spiffs_obj_id spiffs_lookahead_erase_count(
+    spiffs *fs,
+    spiffs_block_ix bix);
+
+s32_t spiffs_lookahead_find_free(
+    spiffs *fs,
+    spiffs_block_ix starting_block,
+    int starting_lu_entry,
+    spiffs_block_ix *block_ix,
+    int *lu_entry);
+
+s32_t spiffs_lookahead_find_ix(
+    spiffs *fs,
+    spiffs_obj_id obj_id,
+    spiffs_span_ix spix,
+    spiffs_page_ix exclusion_pix,
+    spiffs_block_ix *block_ix,
+    int *lu_entry);
+
+s32_t spiffs_lookahead_find_by_name(
+    spiffs *fs,
+    const u8_t name[SPIFFS_OBJ_NAME_LEN],
+    spiffs_block_ix *block_ix,
+    int *lu_entry);
+
+s32_t spiffs_lookahead_find_free_obj_id(
+    spiffs *fs,
+    spiffs_obj_id *obj_id,
+    const u8_t *conflicting_name);
+#endif
+
 s32_t spiffs_lookup_consistency_check(
     spiffs *fs,
     u8_t check_all_objects);
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== catspiffs.c ========
+ *
+ * Utility to print the contents of a file of a SPIFFS flash image.
+ *
+ * Usage:
+ *
+ *     catspiffs [options] [filename] [file]
+ *
+ *     filename: name of an existing flash image file.
+ *
+ *     file:     name of the file in the image.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "spiffsutils.h"
+
+/*
+ *  ======== main ========
+ */
+int main(int argc, char *argv[])
+{
+    FsConfig config;
+    unsigned int size;
+    unsigned char *image;
+    int arg;
+    int status;
+
+    initOptions(&config);
+
+    if ((arg = parseOptions(&config, argc, argv)) < 0 || argc - arg < 2) {
+        fprintf(stderr, "Usage: %s [OPTIONS] [FILENAME] [FILE]\n", argv[0]);
+        printOptions();
+        exit(1);
+    }
+
+    if ((image = loadImage(argv[arg], &size)) == NULL) {
+        exit(1);
+    }
+
+    if (mountImage(&config, image, size, 0) != SPIFFS_OK) {
+        exit(1);
+    }
+
+    status = catFile(argv[arg + 1]);
+
+    unmountImage();
+
+    return (status < 0 ? 1 : 0);
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== cptospiffs.c ========
+ *
+ * Utility to copy a file from the local hard drive into an existing SPIFFS
+ * flash image.
+ *
+ * Usage:
+ *
+ *     cptospiffs [options] [filename] [source] [destination]
+ *
+ *     filename:    name of an existing flash image file.
+ *
+ *     source:      local file to copy.
+ *
+ *     destination: name of the file in the image; the base name of [source]
+ *                  is used if it is omitted.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "spiffsutils.h"
+
+/*
+ *  ======== main ========
+ */
+int main(int argc, char *argv[])
+{
+    FsConfig config;
+    unsigned int size;
+    unsigned char *image;
+    char *dst;
+    int arg;
+
+    initOptions(&config);
+
+    if ((arg = parseOptions(&config, argc, argv)) < 0 || argc - arg < 2) {
+        fprintf(stderr, "Usage: %s [OPTIONS] [FILENAME] [SOURCE] "
+                "[DESTINATION]\n", argv[0]);
+        printOptions();
+        exit(1);
+    }
+
+    if ((image = loadImage(argv[arg], &size)) == NULL) {
+        exit(1);
+    }
+
+    if (argc - arg > 2) {
+        dst = argv[arg + 2];
+    }
+    else {
+        dst = strrchr(argv[arg + 1], '/');
+        dst = (dst == NULL) ? argv[arg + 1] : dst + 1;
+    }
+
+    if (mountImage(&config, image, size, 0) != SPIFFS_OK) {
+        exit(1);
+    }
+
+    if (copyToImage(argv[arg + 1], dst) < 0) {
+        exit(1);
+    }
+
+    unmountImage();
+
+    if (saveImage(image, size, argv[arg]) < 0) {
+        exit(1);
+    }
+
+    return 0;
+}
@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== flashsim.c ========
+ *
+ *  NVS driver that forwards to NVSRAM and accounts simulated flash time.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <ti/drivers/NVS.h>
+#include <ti/drivers/nvs/NVSRAM.h>
+
+#include "flashsim.h"
+
+static void countErases(size_t offset, size_t size);
+static void flashSimClose(NVS_Handle handle);
+static int_fast16_t flashSimControl(NVS_Handle handle, uint_fast16_t cmd,
+    uintptr_t arg);
+static int_fast16_t flashSimErase(NVS_Handle handle, size_t offset,
+    size_t size);
+static void flashSimGetAttrs(NVS_Handle handle, NVS_Attrs *attrs);
+static void flashSimInit(void);
+static int_fast16_t flashSimLock(NVS_Handle handle, uint32_t timeout);
+static NVS_Handle flashSimOpen(uint_least8_t index, NVS_Params *params);
+static int_fast16_t flashSimRead(NVS_Handle handle, size_t offset,
+    void *buffer, size_t bufferSize);
+static void flashSimUnlock(NVS_Handle handle);
+static int_fast16_t flashSimWrite(NVS_Handle handle, size_t offset,
+    void *buffer, size_t bufferSize, uint_fast16_t flags);
+
+const FlashSim_Timing FlashSim_timingSpi25x = {
+    .name           = "spi",
+    .readSetupUs    = 7.0,      /* command, address and chip select */
+    .readByteUs     = 1.0,
+    .programSetupUs = 27.0,     /* write enable, command and tPP setup */
+    .programByteUs  = 2.5,      /* bus plus tPP per byte */
+    .eraseUs        = 45000.0,  /* 4 KB sector erase */
+    .pageSize       = 256
+};
+
+const FlashSim_Timing FlashSim_timingInternal = {
+    .name           = "internal",
+    .readSetupUs    = 0.1,
+    .readByteUs     = 0.02,
+    .programSetupUs = 10.0,
+    .programByteUs  = 1.0,
+    .eraseUs        = 10000.0,
+    .pageSize       = 16
+};
+
+static const NVS_FxnTable flashSimFxnTable = {
+    flashSimClose,
+    flashSimControl,
+    flashSimErase,
+    flashSimGetAttrs,
+    flashSimInit,
+    flashSimLock,
+    flashSimOpen,
+    flashSimRead,
+    flashSimUnlock,
+    flashSimWrite
+};
+
+static NVSRAM_Object nvsRamObject;
+static NVSRAM_HWAttrs nvsRamHWAttrs;
+
+NVS_Config NVS_config[1] = {
+    {
+        .fxnTablePtr = &flashSimFxnTable,
+        .object = &nvsRamObject,
+        .hwAttrs = &nvsRamHWAttrs
+    }
+};
+
+const uint8_t NVS_count = 1;
+
+static const FlashSim_Timing *timing = &FlashSim_timingSpi25x;
+static FlashSim_Stats stats;
+static uint32_t *eraseCounts;
+static size_t numSectors;
+
+/*
+ *  ======== FlashSim_findTiming ========
+ *
+ *  Returns the timing whose name is [name], or NULL.
+ */
+const FlashSim_Timing *FlashSim_findTiming(const char *name)
+{
+    if (strcmp(name, FlashSim_timingSpi25x.name) == 0) {
+        return (&FlashSim_timingSpi25x);
+    }
+    if (strcmp(name, FlashSim_timingInternal.name) == 0) {
+        return (&FlashSim_timingInternal);
+    }
+
+    return (NULL);
+}
+
+/*
+ *  ======== FlashSim_getEraseCounts ========
+ */
+const uint32_t *FlashSim_getEraseCounts(size_t *count)
+{
+    *count = numSectors;
+
+    return (eraseCounts);
+}
+
+/*
+ *  ======== FlashSim_getStats ========
+ */
+const FlashSim_Stats *FlashSim_getStats(void)
+{
+    return (&stats);
+}
+
+/*
+ *  ======== FlashSim_init ========
+ *
+ *  Use [image] as the storage of NVS region 0. Must be called before the
+ *  region is opened.
+ */
+void FlashSim_init(unsigned char *image, size_t size, size_t sectorSize,
+    const FlashSim_Timing *flashTiming)
+{
+    nvsRamHWAttrs.regionBase = image;
+    nvsRamHWAttrs.regionSize = size;
+    nvsRamHWAttrs.sectorSize = sectorSize;
+
+    timing = flashTiming;
+
+    free(eraseCounts);
+    numSectors = size / sectorSize;
+    eraseCounts = calloc(numSectors, sizeof(uint32_t));
+
+    FlashSim_resetStats();
+}
+
+/*
+ *  ======== FlashSim_resetStats ========
+ *
+ *  Clear the operation counters. Erase counts per sector are kept.
+ */
+void FlashSim_resetStats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+/*
+ *  ======== countErases ========
+ *
+ *  Account the erase of the sectors in [offset, offset + size), which must
+ *  be sector aligned.
+ */
+static void countErases(size_t offset, size_t size)
+{
+    size_t sector;
+
+    for (sector = offset / nvsRamHWAttrs.sectorSize;
+         sector < (offset + size) / nvsRamHWAttrs.sectorSize; sector++) {
+        eraseCounts[sector]++;
+        stats.erases++;
+        stats.timeUs += timing->eraseUs;
+    }
+}
+
+/*
+ *  ======== flashSimClose ========
+ */
+static void flashSimClose(NVS_Handle handle)
+{
+    NVSRAM_close(handle);
+}
+
+/*
+ *  ======== flashSimControl ========
+ */
+static int_fast16_t flashSimControl(NVS_Handle handle, uint_fast16_t cmd,
+    uintptr_t arg)
+{
+    return (NVSRAM_control(handle, cmd, arg));
+}
+
+/*
+ *  ======== flashSimErase ========
+ */
+static int_fast16_t flashSimErase(NVS_Handle handle, size_t offset,
+    size_t size)
+{
+    int_fast16_t status;
+
+    status = NVSRAM_erase(handle, offset, size);
+
+    if (status == NVS_STATUS_SUCCESS) {
+        countErases(offset, size);
+    }
+
+    return (status);
+}
+
+/*
+ *  ======== flashSimGetAttrs ========
+ */
+static void flashSimGetAttrs(NVS_Handle handle, NVS_Attrs *attrs)
+{
+    NVSRAM_getAttrs(handle, attrs);
+
+    /* Like external flash, the region is only accessible through NVS */
+    attrs->regionBase = NVS_REGION_NOT_ADDRESSABLE;
+}
+
+/*
+ *  ======== flashSimInit ========
+ */
+static void flashSimInit(void)
+{
+    NVSRAM_init();
+}
+
+/*
+ *  ======== flashSimLock ========
+ */
+static int_fast16_t flashSimLock(NVS_Handle handle, uint32_t timeout)
+{
+    return (NVSRAM_lock(handle, timeout));
+}
+
+/*
+ *  ======== flashSimOpen ========
+ */
+static NVS_Handle flashSimOpen(uint_least8_t index, NVS_Params *params)
+{
+    return (NVSRAM_open(index, params));
+}
+
+/*
+ *  ======== flashSimRead ========
+ */
+static int_fast16_t flashSimRead(NVS_Handle handle, size_t offset,
+    void *buffer, size_t bufferSize)
+{
+    int_fast16_t status;
+
+    status = NVSRAM_read(handle, offset, buffer, bufferSize);
+
+    if (status == NVS_STATUS_SUCCESS) {
+        stats.reads++;
+        stats.readBytes += bufferSize;
+        stats.timeUs += timing->readSetupUs + timing->readByteUs * bufferSize;
+    }
+
+    return (status);
+}
+
+/*
+ *  ======== flashSimUnlock ========
+ */
+static void flashSimUnlock(NVS_Handle handle)
+{
+    NVSRAM_unlock(handle);
+}
+
+/*
+ *  ======== flashSimWrite ========
+ *
+ *  NOR flash can only clear bits, so bits the write would have to set are
+ *  counted before NVSRAM copies the data.
+ */
+static int_fast16_t flashSimWrite(NVS_Handle handle, size_t offset,
+    void *buffer, size_t bufferSize, uint_fast16_t flags)
+{
+    const unsigned char *flash;
+    const unsigned char *src;
+    int_fast16_t status;
+    uint32_t programs;
+    size_t sectorSize;
+    size_t i;
+
+    if (offset + bufferSize <= nvsRamHWAttrs.regionSize &&
+        !(flags & NVS_WRITE_ERASE)) {
+        flash = (const unsigned char *)nvsRamHWAttrs.regionBase + offset;
+        src = buffer;
+        for (i = 0; i < bufferSize; i++) {
+            stats.badBits += __builtin_popcount(src[i] & ~flash[i] & 0xFF);
+        }
+    }
+
+    status = NVSRAM_write(handle, offset, buffer, bufferSize, flags);
+
+    if (status == NVS_STATUS_SUCCESS && (flags & NVS_WRITE_ERASE)) {
+        /* NVSRAM erases the sectors the buffer starts in and spans */
+        sectorSize = nvsRamHWAttrs.sectorSize;
+        countErases(offset & ~(sectorSize - 1),
+            (bufferSize + sectorSize - 1) & ~(sectorSize - 1));
+    }
+
+    if (status == NVS_STATUS_SUCCESS && bufferSize > 0) {
+        /* One program per flash page touched */
+        programs = (offset + bufferSize - 1) / timing->pageSize -
+            offset / timing->pageSize + 1;
+
+        stats.writes++;
+        stats.writeBytes += bufferSize;
+        stats.programs += programs;
+        stats.timeUs += timing->programSetupUs * programs +
+            timing->programByteUs * bufferSize;
+    }
+
+    return (status);
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== flashsim.h ========
+ *
+ *  Simulated-latency NOR flash for the host SPIFFS utilities.
+ *
+ *  The flash is a single NVS region whose storage is provided by the NVSRAM
+ *  driver. Every NVS call is forwarded to NVSRAM and charged to a simulated
+ *  clock using the timing of the selected flash part, and the flash
+ *  operations are counted, so file system configurations can be compared on
+ *  the host before they are tried on a device.
+ *
+ */
+
+#ifndef FLASHSIM_H_
+#define FLASHSIM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ti/drivers/NVS.h>
+
+/* Timing of a flash part, in microseconds */
+typedef struct {
+    const char *name;
+    double readSetupUs;     /* per read command */
+    double readByteUs;      /* per byte read */
+    double programSetupUs;  /* per page program */
+    double programByteUs;   /* per byte programmed */
+    double eraseUs;         /* per sector erased */
+    uint32_t pageSize;      /* program page size */
+} FlashSim_Timing;
+
+/* Flash operation counters */
+typedef struct {
+    double   timeUs;        /* simulated time spent in flash operations */
+    uint32_t reads;         /* NVS_read() calls */
+    uint32_t readBytes;
+    uint32_t writes;        /* NVS_write() calls */
+    uint32_t writeBytes;
+    uint32_t programs;      /* page programs needed by the writes */
+    uint32_t erases;        /* sectors erased */
+    uint32_t badBits;       /* bits a write attempted to change from 0 to 1 */
+} FlashSim_Stats;
+
+/* SPI NOR flash (25-series) on an 8 MHz SPI bus */
+extern const FlashSim_Timing FlashSim_timingSpi25x;
+
+/* Memory mapped internal flash */
+extern const FlashSim_Timing FlashSim_timingInternal;
+
+extern const FlashSim_Timing *FlashSim_findTiming(const char *name);
+extern void FlashSim_init(unsigned char *image, size_t size,
+    size_t sectorSize, const FlashSim_Timing *timing);
+extern void FlashSim_resetStats(void);
+extern const FlashSim_Stats *FlashSim_getStats(void);
+extern const uint32_t *FlashSim_getEraseCounts(size_t *numSectors);
+
+#endif /* FLASHSIM_H_ */
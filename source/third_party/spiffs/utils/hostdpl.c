@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== hostdpl.c ========
+ *
+ *  Driver Porting Layer functions used by SPIFFSNVS, NVSRAM and FatFs, for
+ *  the single threaded host utilities.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/dpl/MutexP.h>
+#include <ti/drivers/dpl/SemaphoreP.h>
+
+typedef struct {
+    unsigned int count;
+} HostSemaphore;
+
+/*
+ *  ======== HwiP_disable ========
+ */
+uintptr_t HwiP_disable(void)
+{
+    return (0);
+}
+
+/*
+ *  ======== HwiP_restore ========
+ */
+void HwiP_restore(uintptr_t key)
+{
+}
+
+/*
+ *  ======== MutexP_create ========
+ *
+ *  Without other threads a mutex only has to exist.
+ */
+MutexP_Handle MutexP_create(MutexP_Params *params)
+{
+    return ((MutexP_Handle)malloc(1));
+}
+
+/*
+ *  ======== MutexP_delete ========
+ */
+void MutexP_delete(MutexP_Handle handle)
+{
+    free(handle);
+}
+
+/*
+ *  ======== MutexP_lock ========
+ */
+uintptr_t MutexP_lock(MutexP_Handle handle)
+{
+    return (0);
+}
+
+/*
+ *  ======== MutexP_unlock ========
+ */
+void MutexP_unlock(MutexP_Handle handle, uintptr_t key)
+{
+}
+
+/*
+ *  ======== SemaphoreP_create ========
+ */
+SemaphoreP_Handle SemaphoreP_create(unsigned int count,
+    SemaphoreP_Params *params)
+{
+    HostSemaphore *sem;
+
+    sem = malloc(sizeof(HostSemaphore));
+    if (sem != NULL) {
+        sem->count = count;
+    }
+
+    return ((SemaphoreP_Handle)sem);
+}
+
+/*
+ *  ======== SemaphoreP_createBinary ========
+ */
+SemaphoreP_Handle SemaphoreP_createBinary(unsigned int count)
+{
+    return (SemaphoreP_create(count, NULL));
+}
+
+/*
+ *  ======== SemaphoreP_delete ========
+ */
+void SemaphoreP_delete(SemaphoreP_Handle handle)
+{
+    free(handle);
+}
+
+/*
+ *  ======== SemaphoreP_pend ========
+ *
+ *  Nothing can post the semaphore while a single thread waits for it.
+ */
+SemaphoreP_Status SemaphoreP_pend(SemaphoreP_Handle handle, uint32_t timeout)
+{
+    HostSemaphore *sem = (HostSemaphore *)handle;
+
+    if (sem->count == 0) {
+        return (SemaphoreP_TIMEOUT);
+    }
+    sem->count--;
+
+    return (SemaphoreP_OK);
+}
+
+/*
+ *  ======== SemaphoreP_post ========
+ */
+void SemaphoreP_post(SemaphoreP_Handle handle)
+{
+    ((HostSemaphore *)handle)->count++;
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== lsspiffs.c ========
+ *
+ * Utility to list the files of a SPIFFS flash image and check the
+ * consistency of the file system.
+ *
+ * Usage:
+ *
+ *     lsspiffs [options] [filename]
+ *
+ *     filename: name of an existing flash image file (usually created with
+ *               the 'mkspiffs' utility or read back from a device).
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "spiffsutils.h"
+
+/*
+ *  ======== main ========
+ */
+int main(int argc, char *argv[])
+{
+    FsConfig config;
+    unsigned int size;
+    unsigned char *image;
+    s32_t status;
+    int arg;
+
+    initOptions(&config);
+
+    if ((arg = parseOptions(&config, argc, argv)) < 0 || argc - arg < 1) {
+        fprintf(stderr, "Usage: %s [OPTIONS] [FILENAME]\n", argv[0]);
+        printOptions();
+        exit(1);
+    }
+
+    if ((image = loadImage(argv[arg], &size)) == NULL) {
+        exit(1);
+    }
+
+    if (mountImage(&config, image, size, 0) != SPIFFS_OK) {
+        exit(1);
+    }
+
+    if (listFiles() < 0) {
+        fprintf(stderr, "ERROR: could not list files: %d\n",
+                (int)SPIFFS_errno(&fs));
+        exit(1);
+    }
+
+    /* The check repairs the image in memory only */
+    if ((status = SPIFFS_check(&fs)) != SPIFFS_OK) {
+        printf("File system check failed: %d\n", (int)status);
+    }
+
+    unmountImage();
+
+    return (status == SPIFFS_OK ? 0 : 1);
+}
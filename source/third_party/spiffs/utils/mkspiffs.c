@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== mkspiffs.c ========
+ *
+ * Utility to create a SPIFFS flash image.  The image is saved into a binary
+ * file that is stored onto the local hard drive, and can be programmed into
+ * the NVS region used by SPIFFSNVS on the device.
+ *
+ * Usage:
+ *
+ *     mkspiffs [options] [filename] [size] [files...]
+ *
+ *     filename: name of the binary file to store the flash image.  If the
+ *               file already exists, it will be overwritten.
+ *
+ *     size:     size of the NVS region, a multiple of the erase sector size.
+ *
+ *     files:    local files copied into the image, named by their base name.
+ *
+ * The options (see spiffsutils.c) must match the SPIFFSNVS_config() and
+ * SPIFFS_mount() parameters of the application.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "spiffsutils.h"
+
+/*
+ *  ======== main ========
+ */
+int main(int argc, char *argv[])
+{
+    FsConfig config;
+    unsigned int size;
+    unsigned char *image;
+    char *fileName;
+    char *baseName;
+    int arg;
+
+    initOptions(&config);
+
+    if ((arg = parseOptions(&config, argc, argv)) < 0 || argc - arg < 2) {
+        fprintf(stderr, "Usage: %s [OPTIONS] [FILENAME] [SIZE] [FILES...]\n",
+                argv[0]);
+        fprintf(stderr, "\tCreate SPIFFS image of size [SIZE] containing");
+        fprintf(stderr, " [FILES] and output to binary file [FILENAME]\n");
+        printOptions();
+        exit(1);
+    }
+
+    fileName = argv[arg++];
+
+    if ((size = strtoul(argv[arg++], NULL, 0)) == 0) {
+        fprintf(stderr, "Error: [SIZE] must be greater than zero.\n");
+        exit(1);
+    }
+
+    if ((image = createImage(size)) == NULL) {
+        fprintf(stderr, "ERROR: out of memory, malloc() returned NULL.\n");
+        exit(1);
+    }
+
+    if (mountImage(&config, image, size, 1) != SPIFFS_OK) {
+        exit(1);
+    }
+
+    for (; arg < argc; arg++) {
+        baseName = strrchr(argv[arg], '/');
+        baseName = (baseName == NULL) ? argv[arg] : baseName + 1;
+
+        if (copyToImage(argv[arg], baseName) < 0) {
+            exit(1);
+        }
+    }
+
+    unmountImage();
+
+    if (saveImage(image, size, fileName) < 0) {
+        exit(1);
+    }
+
+    return 0;
+}
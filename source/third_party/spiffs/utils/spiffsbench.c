@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== spiffsbench.c ========
+ *
+ * Benchmark of SPIFFS through SPIFFSNVS on the simulated flash.  Each
+ * workload is run on a freshly formatted image and reports the flash
+ * operations it caused, the simulated flash time per file system operation
+ * and the SPIFFS cache and garbage collection statistics.  The erase count
+ * spread over the sectors is reported at the end.
+ *
+ * Usage:
+ *
+ *     spiffsbench [options] [size]
+ *
+ *     size: size of the simulated NVS region (default 262144).
+ *
+ * Compare cache sizes by running the benchmark with different -c options,
+ * and the lookahead with and without -l.
+ * The garbage collection heuristics are compile time options of SPIFFS and
+ * can be changed with EXTRA_CFLAGS in the makefile.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "spiffs.h"
+
+#include "flashsim.h"
+#include "spiffsutils.h"
+
+#define DEFAULT_SIZE    (256 * 1024)
+
+#define CREATE_FILES    64      /* files created by the create workload */
+#define CREATE_SIZE     128
+#define APPEND_COUNT    2048    /* records appended by the log workload */
+#define APPEND_SIZE     32
+#define READ_COUNT      2048    /* reads done by the random read workload */
+#define READ_SIZE       32
+#define CHURN_FILES     8       /* files rewritten by the churn workload */
+#define CHURN_COUNT     512
+
+typedef int (*Workload)(void);
+
+static int createFiles(void);
+static int appendLog(void);
+static int randomReads(void);
+static int gcChurn(void);
+
+static unsigned char data[1024];
+
+/*
+ *  ======== fillData ========
+ */
+static void fillData(unsigned int seed, unsigned int size)
+{
+    unsigned int i;
+
+    for (i = 0; i < size; i++) {
+        data[i] = (unsigned char)(seed * 31 + i);
+    }
+}
+
+/*
+ *  ======== writeFile ========
+ */
+static int writeFile(char *name, unsigned int seed, unsigned int size)
+{
+    spiffs_file fh;
+    s32_t status;
+
+    fh = SPIFFS_open(&fs, name, SPIFFS_CREAT | SPIFFS_TRUNC | SPIFFS_WRONLY, 0);
+    if (fh < 0) {
+        return (-1);
+    }
+
+    fillData(seed, size);
+    status = SPIFFS_write(&fs, fh, data, size);
+
+    if (SPIFFS_close(&fs, fh) != SPIFFS_OK || status != (s32_t)size) {
+        return (-1);
+    }
+
+    return (0);
+}
+
+/*
+ *  ======== createFiles ========
+ *
+ *  Create small files, as for configuration or calibration data.
+ */
+static int createFiles(void)
+{
+    char name[24];
+    int i;
+
+    for (i = 0; i < CREATE_FILES; i++) {
+        sprintf(name, "cfg%d", i);
+        if (writeFile(name, i, CREATE_SIZE) < 0) {
+            return (-1);
+        }
+    }
+
+    return (CREATE_FILES);
+}
+
+/*
+ *  ======== appendLog ========
+ *
+ *  Append records to a log file, flushing each record as a logger that must
+ *  not lose data on reset does.
+ */
+static int appendLog(void)
+{
+    spiffs_file fh;
+    int i;
+
+    fh = SPIFFS_open(&fs, "log", SPIFFS_CREAT | SPIFFS_APPEND | SPIFFS_WRONLY,
+        0);
+    if (fh < 0) {
+        return (-1);
+    }
+
+    for (i = 0; i < APPEND_COUNT; i++) {
+        fillData(i, APPEND_SIZE);
+        if (SPIFFS_write(&fs, fh, data, APPEND_SIZE) != APPEND_SIZE ||
+            SPIFFS_fflush(&fs, fh) < SPIFFS_OK) {
+            SPIFFS_close(&fs, fh);
+            return (-1);
+        }
+    }
+
+    if (SPIFFS_close(&fs, fh) != SPIFFS_OK) {
+        return (-1);
+    }
+
+    return (APPEND_COUNT);
+}
+
+/*
+ *  ======== randomReads ========
+ *
+ *  Read records at random offsets of the files written by the create
+ *  workload and check their contents.
+ */
+static int randomReads(void)
+{
+    unsigned char buf[READ_SIZE];
+    spiffs_file fh[4];
+    char name[24];
+    unsigned int offset;
+    int file;
+    int i;
+
+    /* The data is written before the counters are reset */
+    for (i = 0; i < 4; i++) {
+        sprintf(name, "cfg%d", i);
+        fh[i] = SPIFFS_open(&fs, name, SPIFFS_RDONLY, 0);
+        if (fh[i] < 0) {
+            return (-1);
+        }
+    }
+
+    srand(1);
+    for (i = 0; i < READ_COUNT; i++) {
+        file = rand() % 4;
+        offset = rand() % (CREATE_SIZE - READ_SIZE + 1);
+        fillData(file, CREATE_SIZE);
+
+        if (SPIFFS_lseek(&fs, fh[file], offset, SPIFFS_SEEK_SET) < 0 ||
+            SPIFFS_read(&fs, fh[file], buf, READ_SIZE) != READ_SIZE ||
+            memcmp(buf, data + offset, READ_SIZE) != 0) {
+            return (-1);
+        }
+    }
+
+    for (i = 0; i < 4; i++) {
+        SPIFFS_close(&fs, fh[i]);
+    }
+
+    return (READ_COUNT);
+}
+
+/*
+ *  ======== gcChurn ========
+ *
+ *  Keep rewriting files until the file system has been cycled several times,
+ *  so the garbage collector has to reclaim blocks with live data.
+ */
+static int gcChurn(void)
+{
+    char name[24];
+    int i;
+
+    for (i = 0; i < CHURN_COUNT; i++) {
+        sprintf(name, "churn%d", i % CHURN_FILES);
+        if (writeFile(name, i, sizeof(data)) < 0) {
+            return (-1);
+        }
+    }
+
+    /* Check the last version of every file */
+    for (i = CHURN_COUNT - CHURN_FILES; i < CHURN_COUNT; i++) {
+        unsigned char buf[sizeof(data)];
+        spiffs_file fh;
+        s32_t count;
+
+        sprintf(name, "churn%d", i % CHURN_FILES);
+        if ((fh = SPIFFS_open(&fs, name, SPIFFS_RDONLY, 0)) < 0) {
+            return (-1);
+        }
+        count = SPIFFS_read(&fs, fh, buf, sizeof(buf));
+        SPIFFS_close(&fs, fh);
+
+        fillData(i, sizeof(data));
+        if (count != sizeof(buf) || memcmp(buf, data, sizeof(buf)) != 0) {
+            return (-1);
+        }
+    }
+
+    return (CHURN_COUNT);
+}
+
+/*
+ *  ======== runWorkload ========
+ */
+static int runWorkload(char *name, Workload workload)
+{
+    const FlashSim_Stats *stats = FlashSim_getStats();
+    int ops;
+
+    FlashSim_resetStats();
+#if SPIFFS_CACHE_STATS
+    fs.cache_hits = 0;
+    fs.cache_misses = 0;
+#endif
+#if SPIFFS_GC_STATS
+    fs.stats_gc_runs = 0;
+#endif
+
+    if ((ops = workload()) <= 0) {
+        fprintf(stderr, "ERROR: %s failed: %d\n", name,
+                (int)SPIFFS_errno(&fs));
+        return (-1);
+    }
+
+    printf("%-8s %6d %7u %7u %7u %6u %9.1f %8.1f", name, ops,
+           (unsigned int)stats->reads, (unsigned int)stats->writes,
+           (unsigned int)stats->programs, (unsigned int)stats->erases,
+           stats->timeUs / 1000.0, stats->timeUs / ops);
+#if SPIFFS_CACHE_STATS
+    printf(" %7u %7u", (unsigned int)fs.cache_hits,
+           (unsigned int)fs.cache_misses);
+#else
+    printf(" %7s %7s", "-", "-");
+#endif
+#if SPIFFS_GC_STATS
+    printf(" %5u", (unsigned int)fs.stats_gc_runs);
+#else
+    printf(" %5s", "-");
+#endif
+    printf("\n");
+
+    if (stats->badBits != 0) {
+        fprintf(stderr, "ERROR: %s programmed %u bits that were not erased\n",
+                name, (unsigned int)stats->badBits);
+        return (-1);
+    }
+
+    return (0);
+}
+
+/*
+ *  ======== main ========
+ */
+int main(int argc, char *argv[])
+{
+    FsConfig config;
+    unsigned int size = DEFAULT_SIZE;
+    unsigned char *image;
+    const uint32_t *eraseCounts;
+    size_t numSectors;
+    uint32_t minErases;
+    uint32_t maxErases;
+    uint32_t totalErases;
+    size_t i;
+    int status = 0;
+    int arg;
+
+    initOptions(&config);
+
+    if ((arg = parseOptions(&config, argc, argv)) < 0 || argc - arg > 1) {
+        fprintf(stderr, "Usage: %s [OPTIONS] [SIZE]\n", argv[0]);
+        printOptions();
+        exit(1);
+    }
+
+    if (argc - arg == 1 && (size = strtoul(argv[arg], NULL, 0)) == 0) {
+        fprintf(stderr, "Error: [SIZE] must be greater than zero.\n");
+        exit(1);
+    }
+
+    if ((image = createImage(size)) == NULL) {
+        fprintf(stderr, "ERROR: out of memory, malloc() returned NULL.\n");
+        exit(1);
+    }
+
+    if (mountImage(&config, image, size, 1) != SPIFFS_OK) {
+        exit(1);
+    }
+
+    printf("%u byte %s flash, %u byte sectors, block %u, page %u, "
+           "%u cache pages, %u lookahead index pages\n\n", size,
+           config.timing->name, config.sectorSize, config.blockSize,
+           config.pageSize, config.cachePages, config.lookaheadIx);
+    printf("%-8s %6s %7s %7s %7s %6s %9s %8s %7s %7s %5s\n", "workload",
+           "ops", "reads", "writes", "progs", "erases", "time(ms)",
+           "us/op", "hits", "misses", "gc");
+
+    if (runWorkload("create", createFiles) < 0 ||
+        runWorkload("append", appendLog) < 0 ||
+        runWorkload("read", randomReads) < 0 ||
+        runWorkload("churn", gcChurn) < 0) {
+        status = 1;
+    }
+
+    if (SPIFFS_check(&fs) != SPIFFS_OK) {
+        fprintf(stderr, "ERROR: file system check failed\n");
+        status = 1;
+    }
+
+    unmountImage();
+
+    eraseCounts = FlashSim_getEraseCounts(&numSectors);
+    minErases = maxErases = eraseCounts[0];
+    totalErases = 0;
+    for (i = 0; i < numSectors; i++) {
+        if (eraseCounts[i] < minErases) {
+            minErases = eraseCounts[i];
+        }
+        if (eraseCounts[i] > maxErases) {
+            maxErases = eraseCounts[i];
+        }
+        totalErases += eraseCounts[i];
+    }
+
+    printf("\nerases per sector: min %u, max %u, mean %.1f\n",
+           (unsigned int)minErases, (unsigned int)maxErases,
+           (double)totalErases / numSectors);
+
+    free(image);
+
+    return (status);
+}
@@ -0,0 +1,435 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== spiffsutils.c ========
+ *
+ *  This file contains APIs that are commonly used by the utilities defined in
+ *  this directory.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include "spiffs.h"
+#include "spiffs_nucleus.h"
+#include "SPIFFSNVS.h"
+
+#include "flashsim.h"
+#include "spiffsutils.h"
+
+#define COPY_BLOCK_SIZE 256
+
+/* NVSRAM requires the region to be aligned on an erase sector */
+#define IMAGE_ALIGN     (64 * 1024)
+
+spiffs fs;
+
+static spiffs_config fsConfig;
+static SPIFFSNVS_Data spiffsnvsData;
+
+static unsigned char *workBuf;
+static unsigned char *fdBuf;
+static unsigned char *cacheBuf;
+static unsigned char *lookaheadBuf;
+
+/*
+ *  ======== initOptions ========
+ *
+ *  Defaults match a 4 KB sector SPI flash, as in the SPIFFSNVS example.
+ */
+void initOptions(FsConfig *config)
+{
+    config->sectorSize = 4096;
+    config->blockSize = 4096;
+    config->pageSize = 256;
+    config->cachePages = 2;
+    config->fileDescs = 4;
+    config->lookaheadIx = 0;
+    config->timing = &FlashSim_timingSpi25x;
+}
+
+/*
+ *  ======== parseOptions ========
+ *
+ *  Parse the options common to all utilities. Returns the index of the first
+ *  argument that is not an option, or -1 if an option is invalid.
+ */
+int parseOptions(FsConfig *config, int argc, char *argv[])
+{
+    unsigned int *value;
+    int i;
+
+    for (i = 1; i < argc && argv[i][0] == '-'; i += 2) {
+        if (i + 1 >= argc || argv[i][1] == '\0' || argv[i][2] != '\0') {
+            return (-1);
+        }
+
+        if (argv[i][1] == 't') {
+            if ((config->timing = FlashSim_findTiming(argv[i + 1])) == NULL) {
+                return (-1);
+            }
+            continue;
+        }
+
+        switch (argv[i][1]) {
+            case 'e':
+                value = &config->sectorSize;
+                break;
+            case 'b':
+                value = &config->blockSize;
+                break;
+            case 'p':
+                value = &config->pageSize;
+                break;
+            case 'c':
+                value = &config->cachePages;
+                break;
+            case 'f':
+                value = &config->fileDescs;
+                break;
+            case 'l':
+                value = &config->lookaheadIx;
+                break;
+            default:
+                return (-1);
+        }
+
+        *value = strtoul(argv[i + 1], NULL, 0);
+    }
+
+    return (i);
+}
+
+/*
+ *  ======== printOptions ========
+ */
+void printOptions(void)
+{
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "\t-e SIZE   erase sector size (default 4096)\n");
+    fprintf(stderr, "\t-b SIZE   logical block size (default 4096)\n");
+    fprintf(stderr, "\t-p SIZE   logical page size (default 256)\n");
+    fprintf(stderr, "\t-c PAGES  read/write cache pages (default 2)\n");
+    fprintf(stderr, "\t-f COUNT  file descriptors (default 4)\n");
+    fprintf(stderr, "\t-l PAGES  lookahead for PAGES object index pages"
+            " (default 0, none)\n");
+    fprintf(stderr, "\t-t spi|internal  flash timing (default spi)\n");
+}
+
+/*
+ *  ======== createImage ========
+ *
+ *  Returns an erased flash image of [size] bytes, or NULL.
+ */
+unsigned char *createImage(unsigned int size)
+{
+    void *data;
+
+    if (posix_memalign(&data, IMAGE_ALIGN, size) != 0) {
+        return (NULL);
+    }
+    memset(data, 0xFF, size);
+
+    return ((unsigned char *)data);
+}
+
+/*
+ *  ======== loadImage ========
+ *
+ *  Read the flash image file [name] into a dynamically allocated block of
+ *  memory. Returns NULL on failure.
+ */
+unsigned char *loadImage(char *name, unsigned int *len)
+{
+    FILE *fp;
+    struct stat statBuf;
+    unsigned char *data;
+
+    if ((fp = fopen(name, "rb")) == NULL) {
+        fprintf(stderr, "ERROR: could not open image \'%s\'\n", name);
+        return (NULL);
+    }
+
+    if (fstat(fileno(fp), &statBuf) < 0 || statBuf.st_size == 0) {
+        fprintf(stderr, "ERROR: could not get the size of %s\n", name);
+        fclose(fp);
+        return (NULL);
+    }
+
+    *len = statBuf.st_size;
+    if ((data = createImage(*len)) == NULL) {
+        fprintf(stderr, "ERROR: out of memory, malloc() returned NULL.\n");
+        fclose(fp);
+        return (NULL);
+    }
+
+    if (fread(data, *len, 1, fp) != 1) {
+        fprintf(stderr, "ERROR: could not read %u bytes from %s\n", *len,
+                name);
+        free(data);
+        fclose(fp);
+        return (NULL);
+    }
+
+    fclose(fp);
+
+    return (data);
+}
+
+/*
+ *  ======== saveImage ========
+ *
+ *  Write the flash image to the file [filename]. Returns 0 on success, -1 on
+ *  failure.
+ */
+int saveImage(unsigned char *data, unsigned int len, char *filename)
+{
+    FILE *fp;
+
+    if ((fp = fopen(filename, "wb")) == NULL) {
+        fprintf(stderr, "ERROR: could not open %s for writing\n", filename);
+        return (-1);
+    }
+
+    if (fwrite(data, len, 1, fp) != 1) {
+        fprintf(stderr, "ERROR: could not write %u bytes to %s\n", len,
+                filename);
+        fclose(fp);
+        return (-1);
+    }
+
+    return (fclose(fp) == 0 ? 0 : -1);
+}
+
+/*
+ *  ======== mountImage ========
+ *
+ *  Mount the file system in [image] through SPIFFSNVS and the simulated
+ *  flash, formatting it first if [format] is set. Returns SPIFFS_OK or a
+ *  negative SPIFFS error code.
+ */
+int mountImage(FsConfig *config, unsigned char *image, unsigned int size,
+    int format)
+{
+    s32_t status;
+
+    if (config->sectorSize == 0 || config->sectorSize > IMAGE_ALIGN ||
+        size % config->sectorSize) {
+        fprintf(stderr, "ERROR: image size %u is not a multiple of the erase"
+                " sector size %u (at most %u)\n", size, config->sectorSize,
+                IMAGE_ALIGN);
+        return (SPIFFS_ERR_INTERNAL);
+    }
+
+    FlashSim_init(image, size, config->sectorSize, config->timing);
+
+    status = SPIFFSNVS_config(&spiffsnvsData, 0, &fs, &fsConfig,
+        config->blockSize, config->pageSize);
+    if (status != SPIFFSNVS_STATUS_SUCCESS) {
+        fprintf(stderr, "ERROR: SPIFFSNVS_config() returned %d\n",
+                (int)status);
+        return (SPIFFS_ERR_INTERNAL);
+    }
+
+    /* Same buffers an application gives SPIFFS_mount() */
+    workBuf = malloc(config->pageSize * 2);
+    fdBuf = malloc(config->fileDescs * sizeof(spiffs_fd));
+    cacheBuf = malloc(sizeof(spiffs_cache) +
+        config->cachePages * (sizeof(spiffs_cache_page) + config->pageSize));
+
+    status = SPIFFS_mount(&fs, &fsConfig, workBuf, fdBuf,
+        config->fileDescs * sizeof(spiffs_fd), cacheBuf,
+        sizeof(spiffs_cache) + config->cachePages *
+        (sizeof(spiffs_cache_page) + config->pageSize), NULL);
+
+    if (format) {
+        /* SPIFFS_format() requires a mount attempt on an unmounted fs */
+        if (status == SPIFFS_OK) {
+            SPIFFS_unmount(&fs);
+        }
+
+        if ((status = SPIFFS_format(&fs)) == SPIFFS_OK) {
+            status = SPIFFS_mount(&fs, &fsConfig, workBuf, fdBuf,
+                config->fileDescs * sizeof(spiffs_fd), cacheBuf,
+                sizeof(spiffs_cache) + config->cachePages *
+                (sizeof(spiffs_cache_page) + config->pageSize), NULL);
+        }
+    }
+
+#if SPIFFS_LOOKAHEAD
+    if (status == SPIFFS_OK && config->lookaheadIx != 0) {
+        u32_t lookaheadSize = SPIFFS_buffer_bytes_for_lookahead(&fs,
+            config->lookaheadIx);
+
+        lookaheadBuf = malloc(lookaheadSize);
+        status = SPIFFS_lookahead(&fs, lookaheadBuf, lookaheadSize);
+    }
+#endif
+
+    if (status != SPIFFS_OK) {
+        fprintf(stderr, "ERROR: could not %s the file system: %d\n",
+                format ? "format" : "mount", (int)status);
+        unmountImage();
+    }
+
+    return (status);
+}
+
+/*
+ *  ======== unmountImage ========
+ */
+void unmountImage(void)
+{
+    if (SPIFFS_mounted(&fs)) {
+        SPIFFS_unmount(&fs);
+    }
+#if SPIFFS_LOOKAHEAD
+    SPIFFS_lookahead(&fs, NULL, 0);
+#endif
+    SPIFFSNVS_close(&spiffsnvsData);
+
+    free(workBuf);
+    free(fdBuf);
+    free(cacheBuf);
+    free(lookaheadBuf);
+    workBuf = fdBuf = cacheBuf = lookaheadBuf = NULL;
+}
+
+/*
+ *  ======== copyToImage ========
+ *
+ *  Copy the local file [src] to the file [dst] of the mounted file system.
+ *  Returns 0 on success, -1 on failure.
+ */
+int copyToImage(char *src, char *dst)
+{
+    unsigned char data[COPY_BLOCK_SIZE];
+    spiffs_file fh;
+    FILE *fp;
+    size_t count;
+    int status = 0;
+
+    if ((fp = fopen(src, "rb")) == NULL) {
+        fprintf(stderr, "ERROR: could not open %s\n", src);
+        return (-1);
+    }
+
+    fh = SPIFFS_open(&fs, dst, SPIFFS_CREAT | SPIFFS_TRUNC | SPIFFS_WRONLY, 0);
+    if (fh < 0) {
+        fprintf(stderr, "ERROR: SPIFFS_open %s returned %d\n", dst, (int)fh);
+        fclose(fp);
+        return (-1);
+    }
+
+    while ((count = fread(data, 1, sizeof(data), fp)) > 0) {
+        if (SPIFFS_write(&fs, fh, data, count) != (s32_t)count) {
+            fprintf(stderr, "ERROR: SPIFFS_write %s returned %d\n", dst,
+                    (int)SPIFFS_errno(&fs));
+            status = -1;
+            break;
+        }
+    }
+
+    if (SPIFFS_close(&fs, fh) != SPIFFS_OK) {
+        status = -1;
+    }
+    fclose(fp);
+
+    return (status);
+}
+
+/*
+ *  ======== catFile ========
+ *
+ *  Write the contents of the file [name] to stdout. Returns 0 on success,
+ *  -1 on failure.
+ */
+int catFile(char *name)
+{
+    unsigned char data[COPY_BLOCK_SIZE];
+    spiffs_file fh;
+    s32_t count;
+
+    if ((fh = SPIFFS_open(&fs, name, SPIFFS_RDONLY, 0)) < 0) {
+        fprintf(stderr, "ERROR: SPIFFS_open %s returned %d\n", name, (int)fh);
+        return (-1);
+    }
+
+    while ((count = SPIFFS_read(&fs, fh, data, sizeof(data))) > 0) {
+        fwrite(data, 1, count, stdout);
+    }
+
+    SPIFFS_close(&fs, fh);
+
+    return ((count < 0 && count != SPIFFS_ERR_END_OF_OBJECT) ? -1 : 0);
+}
+
+/*
+ *  ======== listFiles ========
+ *
+ *  Print the files of the mounted file system and its usage. Returns 0 on
+ *  success, -1 on failure.
+ */
+int listFiles(void)
+{
+    spiffs_DIR dir;
+    struct spiffs_dirent entry;
+    struct spiffs_dirent *pEntry;
+    u32_t total;
+    u32_t used;
+    int numFiles = 0;
+
+    if (SPIFFS_opendir(&fs, "/", &dir) == NULL) {
+        return (-1);
+    }
+
+    while ((pEntry = SPIFFS_readdir(&dir, &entry)) != NULL) {
+        printf("%8u  %-*s  (id %04x)\n", (unsigned int)pEntry->size,
+               SPIFFS_OBJ_NAME_LEN, pEntry->name, pEntry->obj_id);
+        numFiles++;
+    }
+
+    SPIFFS_closedir(&dir);
+
+    if (SPIFFS_info(&fs, &total, &used) != SPIFFS_OK) {
+        return (-1);
+    }
+
+    printf("%d file(s), %u of %u bytes used\n", numFiles, (unsigned int)used,
+           (unsigned int)total);
+
+    return (0);
+}
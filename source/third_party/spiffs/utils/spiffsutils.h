@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== spiffsutils.h ========
+ *
+ *  Functions shared by the host SPIFFS utilities.
+ *
+ */
+
+#ifndef SPIFFSUTILS_H_
+#define SPIFFSUTILS_H_
+
+#include "spiffs.h"
+#include "flashsim.h"
+
+/* File system geometry and RAM buffers, set by the common options */
+typedef struct {
+    unsigned int sectorSize;    /* physical erase sector size */
+    unsigned int blockSize;     /* logical block size */
+    unsigned int pageSize;      /* logical page size */
+    unsigned int cachePages;    /* pages in the read/write cache */
+    unsigned int fileDescs;     /* number of file descriptors */
+    unsigned int lookaheadIx;   /* index pages in the lookahead, 0 for none */
+    const FlashSim_Timing *timing;
+} FsConfig;
+
+extern spiffs fs;
+
+extern void initOptions(FsConfig *config);
+extern int parseOptions(FsConfig *config, int argc, char *argv[]);
+extern void printOptions(void);
+extern unsigned char *createImage(unsigned int size);
+extern unsigned char *loadImage(char *name, unsigned int *len);
+extern int saveImage(unsigned char *data, unsigned int len, char *filename);
+extern int mountImage(FsConfig *config, unsigned char *image,
+    unsigned int size, int format);
+extern void unmountImage(void);
+extern int copyToImage(char *src, char *dst);
+extern int catFile(char *name);
+extern int listFiles(void);
+
+#endif /* SPIFFSUTILS_H_ */
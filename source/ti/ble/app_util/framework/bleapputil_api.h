@@ -798,6 +798,10 @@ BLEAppUtil_entityId_t BLEAppUtil_getSelfEntity(void);
 /**
  * @brief   Register application event handler
  *
+ * @note    The handler eventMask is aggregated per handler type when the
+ *          handler is registered. To enable more events un-register the
+ *          handler, update its eventMask and register it again.
+ *
  * @param   eventHandler - The handler to register
  *
  * @return  SUCCESS, FAILURE
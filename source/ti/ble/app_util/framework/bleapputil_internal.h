@@ -67,6 +67,9 @@ extern "C"
  */
 typedef ICall_Hdr   BLEAppUtil_msgHdt_t;
 
+// Number of event handler types, see @ref BLEAppUtil_eventHandlerType_e
+#define BLEAPPUTIL_NUM_OF_HANDLER_TYPES     (BLEAPPUTIL_GENERIC_TYPE + 1)
+
 /*********************************************************************
  * TYPEDEFS
  */
@@ -94,6 +97,16 @@ typedef struct
     struct BLEAppUtil_EventHandlersList_t   *next;
 } BLEAppUtil_EventHandlersList_t;
 
+// Snapshot of the handlers registered for one handler type, in registration
+// order. A published table is never resized: registration publishes a new
+// table and un-registration only clears the handler entry (sets it to NULL)
+typedef struct BLEAppUtil_HandlersTable_t
+{
+    struct BLEAppUtil_HandlersTable_t   *next;          // retired tables list
+    uint16_t                            numHandlers;    // number of entries
+    BLEAppUtil_EventHandler_t * volatile handlers[];    // the handlers entries
+} BLEAppUtil_HandlersTable_t;
+
 /** @internal data structure for the thread entity */
 typedef struct
 {
@@ -154,6 +167,15 @@ extern ErrorHandler_t errorHandlerCb;
 extern StackInitDone_t appInitDoneHandler;
 extern BLEAppUtil_EventHandlersList_t *BLEAppUtilEventHandlersHead;
 
+// Per type handlers tables and the aggregated event mask of each type
+extern BLEAppUtil_HandlersTable_t * volatile BLEAppUtilHandlersTables[BLEAPPUTIL_NUM_OF_HANDLER_TYPES];
+extern volatile uint32_t BLEAppUtilEventMasks[BLEAPPUTIL_NUM_OF_HANDLER_TYPES];
+
+// Nesting depth of BLEAppUtil_callEventHandler and the tables replaced
+// while a dispatch was in progress
+extern volatile uint8_t BLEAppUtilDispatchDepth;
+extern BLEAppUtil_HandlersTable_t * volatile BLEAppUtilRetiredTables;
+
 extern pthread_mutex_t mutex;
 extern BLEAppUtil_TheardEntity_t BLEAppUtil_theardEntity;
 
@@ -213,6 +235,7 @@ uint8_t BLEAppUtil_isEventEnabled(BLEAppUtil_eventHandlerType_e eventHandlerType
                                   uint32_t event);
 BLEAppUtil_EventHandlersList_t *BLEAppUtil_getEventHandler(BLEAppUtil_EventHandlersList_t *handler,
                                                            BLEAppUtil_eventHandlerType_e eventHandlerType);
+void BLEAppUtil_freeRetiredHandlersTables(void);
 
 /*********************************************************************
  * Convert and validate received events before enqueue
@@ -88,6 +88,13 @@ BLEAppUtil_PeriCentParams_t *BLEAppUtilLocal_PeriCentParams = NULL;
 ErrorHandler_t errorHandlerCb;
 BLEAppUtil_EventHandlersList_t *BLEAppUtilEventHandlersHead = NULL;
 
+// Handlers tables used by the dispatcher, rebuilt from the handlers list
+// on every registration change
+BLEAppUtil_HandlersTable_t * volatile BLEAppUtilHandlersTables[BLEAPPUTIL_NUM_OF_HANDLER_TYPES] = {NULL};
+volatile uint32_t BLEAppUtilEventMasks[BLEAPPUTIL_NUM_OF_HANDLER_TYPES] = {0};
+volatile uint8_t BLEAppUtilDispatchDepth = 0;
+BLEAppUtil_HandlersTable_t * volatile BLEAppUtilRetiredTables = NULL;
+
 // GAP Bond Manager Callbacks
 gapBondCBs_t BLEAppUtil_bondMgrCBs =
 {
@@ -129,6 +136,9 @@ pthread_mutex_t mutex;
 * LOCAL FUNCTIONS
 */
 static bStatus_t BLEAppUtil_createQueue(void);
+static bStatus_t BLEAppUtil_updateHandlersTable(BLEAppUtil_eventHandlerType_e type);
+static void BLEAppUtil_clearHandlerEntry(BLEAppUtil_HandlersTable_t *table,
+                                         BLEAppUtil_EventHandler_t *eventHandler);
 ICall_Errno BLEAppUtil_registerIcall(uint8_t *selfEntity, appCallback_t appCallback);
 void BLEAppUtil_createStackTasks();
 bStatus_t BLEAppUtil_initGap(uint8_t role,
@@ -199,7 +209,7 @@ void BLEAppUtil_init(ErrorHandler_t errorHandler, StackInitDone_t initDoneHandle
     // Construct a mutex that will be used by the following functions:
     // BLEAppUtil_registerEventHandler
     // BLEAppUtil_unRegisterEventHandler
-    // BLEAppUtil_callEventHandler
+    // BLEAppUtil_freeRetiredHandlersTables
     pthread_mutex_init(&mutex, NULL);
 }
 
@@ -215,6 +225,7 @@ void BLEAppUtil_init(ErrorHandler_t errorHandler, StackInitDone_t initDoneHandle
 bStatus_t BLEAppUtil_registerEventHandler(BLEAppUtil_EventHandler_t *eventHandler)
 {
     BLEAppUtil_EventHandlersList_t *newHandler;
+    BLEAppUtil_EventHandlersList_t *iter = NULL;
 
     // Lock the Mutex
     pthread_mutex_lock(&mutex);
@@ -225,6 +236,7 @@ bStatus_t BLEAppUtil_registerEventHandler(BLEAppUtil_EventHandler_t *eventHandle
     // If the allocation failed, return an error
     if(newHandler == NULL)
     {
+        pthread_mutex_unlock(&mutex);
         return FAILURE;
     }
 
@@ -240,7 +252,7 @@ bStatus_t BLEAppUtil_registerEventHandler(BLEAppUtil_EventHandler_t *eventHandle
     else
     {
         // Add item to be the head of the list
-        BLEAppUtil_EventHandlersList_t *iter = BLEAppUtilEventHandlersHead;
+        iter = BLEAppUtilEventHandlersHead;
 
         // Iterate through the list to get to the last item
         while(iter->next != NULL)
@@ -252,6 +264,24 @@ bStatus_t BLEAppUtil_registerEventHandler(BLEAppUtil_EventHandler_t *eventHandle
         iter->next = (struct BLEAppUtil_EventHandlersList_t *)newHandler;
     }
 
+    // Publish a handlers table containing the new handler
+    if(BLEAppUtil_updateHandlersTable(eventHandler->handlerType) != SUCCESS)
+    {
+        // Remove the item from the end of the list
+        if(iter == NULL)
+        {
+            BLEAppUtilEventHandlersHead = NULL;
+        }
+        else
+        {
+            iter->next = NULL;
+        }
+        BLEAppUtil_free(newHandler);
+
+        pthread_mutex_unlock(&mutex);
+        return FAILURE;
+    }
+
     // Unlock the Mutex - item was added to the list
     pthread_mutex_unlock(&mutex);
 
@@ -269,13 +299,15 @@ bStatus_t BLEAppUtil_registerEventHandler(BLEAppUtil_EventHandler_t *eventHandle
  */
 bStatus_t BLEAppUtil_unRegisterEventHandler(BLEAppUtil_EventHandler_t *eventHandler)
 {
-    BLEAppUtil_EventHandlersList_t *curr = BLEAppUtilEventHandlersHead;
+    BLEAppUtil_EventHandlersList_t *curr;
     BLEAppUtil_EventHandlersList_t *prev = NULL;
     bStatus_t status = INVALIDPARAMETER;
 
     // Lock the Mutex
     pthread_mutex_lock(&mutex);
 
+    curr = BLEAppUtilEventHandlersHead;
+
     // Go over the handlers list
     while(curr != NULL)
     {
@@ -297,6 +329,22 @@ bStatus_t BLEAppUtil_unRegisterEventHandler(BLEAppUtil_EventHandler_t *eventHand
             // Free the item
             BLEAppUtil_free(curr);
 
+            // Stop calling the handler right away, also from a table that is
+            // currently dispatched, then publish a table without it. If the
+            // new table can't be allocated the cleared entry is simply skipped
+            if(eventHandler->handlerType < BLEAPPUTIL_NUM_OF_HANDLER_TYPES)
+            {
+                BLEAppUtil_HandlersTable_t *retired;
+
+                BLEAppUtil_clearHandlerEntry(BLEAppUtilHandlersTables[eventHandler->handlerType],
+                                             eventHandler);
+                for(retired = BLEAppUtilRetiredTables; retired != NULL; retired = retired->next)
+                {
+                    BLEAppUtil_clearHandlerEntry(retired, eventHandler);
+                }
+                BLEAppUtil_updateHandlersTable(eventHandler->handlerType);
+            }
+
             // Set the status to SUCCESS
             status = SUCCESS;
             break;
@@ -500,6 +548,152 @@ static bStatus_t BLEAppUtil_createQueue(void)
      return SUCCESS;
 }
 
+/*********************************************************************
+ * @fn      BLEAppUtil_updateHandlersTable
+ *
+ * @brief   Build the handlers table and the aggregated event mask of
+ *          the given type from the handlers list and publish them.
+ *          The replaced table is freed, or retired if a dispatch is in
+ *          progress. Must be called with the mutex locked.
+ *
+ * @param   type - The handler type to update
+ *
+ * @return  SUCCESS, FAILURE
+ */
+static bStatus_t BLEAppUtil_updateHandlersTable(BLEAppUtil_eventHandlerType_e type)
+{
+    BLEAppUtil_EventHandlersList_t *iter;
+    BLEAppUtil_HandlersTable_t *newTable = NULL;
+    BLEAppUtil_HandlersTable_t *oldTable;
+    uint16_t numHandlers = 0;
+    uint32_t eventMask = 0;
+
+    // Handlers of an unknown type are never called
+    if(type >= BLEAPPUTIL_NUM_OF_HANDLER_TYPES)
+    {
+        return SUCCESS;
+    }
+
+    // Count the handlers from the given type
+    for(iter = BLEAppUtilEventHandlersHead; iter != NULL;
+        iter = (BLEAppUtil_EventHandlersList_t *)iter->next)
+    {
+        if(iter->eventHandler->handlerType == type)
+        {
+            numHandlers++;
+        }
+    }
+
+    if(numHandlers > 0)
+    {
+        newTable = (BLEAppUtil_HandlersTable_t *)BLEAppUtil_malloc(sizeof(BLEAppUtil_HandlersTable_t) +
+                                                                   numHandlers * sizeof(BLEAppUtil_EventHandler_t *));
+        if(newTable == NULL)
+        {
+            return FAILURE;
+        }
+
+        // Copy the handlers in registration order and aggregate their masks
+        newTable->next = NULL;
+        newTable->numHandlers = 0;
+        for(iter = BLEAppUtilEventHandlersHead; iter != NULL;
+            iter = (BLEAppUtil_EventHandlersList_t *)iter->next)
+        {
+            if(iter->eventHandler->handlerType == type)
+            {
+                newTable->handlers[newTable->numHandlers++] = iter->eventHandler;
+                eventMask |= iter->eventHandler->eventMask;
+            }
+        }
+
+        // PASSCODE and L2CAP_DATA handlers receive all the events of their type
+        if((type == BLEAPPUTIL_PASSCODE_TYPE) ||
+           (type == BLEAPPUTIL_L2CAP_DATA_TYPE))
+        {
+            eventMask = 0xFFFFFFFF;
+        }
+    }
+
+    // Publish the new table and mask
+    oldTable = BLEAppUtilHandlersTables[type];
+    BLEAppUtilHandlersTables[type] = newTable;
+    BLEAppUtilEventMasks[type] = eventMask;
+
+    if(oldTable != NULL)
+    {
+        // The dispatcher may still be iterating the old table, keep it
+        // until the dispatch is done
+        if(BLEAppUtilDispatchDepth > 0)
+        {
+            oldTable->next = BLEAppUtilRetiredTables;
+            BLEAppUtilRetiredTables = oldTable;
+        }
+        else
+        {
+            BLEAppUtil_free(oldTable);
+        }
+    }
+
+    return SUCCESS;
+}
+
+/*********************************************************************
+ * @fn      BLEAppUtil_clearHandlerEntry
+ *
+ * @brief   Clear the entry of the given handler in a handlers table,
+ *          the dispatcher skips cleared entries.
+ *
+ * @param   table        - The handlers table, may be NULL
+ * @param   eventHandler - The handler to clear
+ *
+ * @return  None
+ */
+static void BLEAppUtil_clearHandlerEntry(BLEAppUtil_HandlersTable_t *table,
+                                         BLEAppUtil_EventHandler_t *eventHandler)
+{
+    uint16_t i;
+
+    if(table != NULL)
+    {
+        for(i = 0; i < table->numHandlers; i++)
+        {
+            if(table->handlers[i] == eventHandler)
+            {
+                table->handlers[i] = NULL;
+                break;
+            }
+        }
+    }
+}
+
+/*********************************************************************
+ * @fn      BLEAppUtil_freeRetiredHandlersTables
+ *
+ * @brief   Free the handlers tables that were replaced while a dispatch
+ *          was in progress. Called by the dispatcher once no dispatch
+ *          is in progress.
+ *
+ * @return  None
+ */
+void BLEAppUtil_freeRetiredHandlersTables(void)
+{
+    BLEAppUtil_HandlersTable_t *retired;
+    BLEAppUtil_HandlersTable_t *next;
+
+    // Detach the retired tables list
+    pthread_mutex_lock(&mutex);
+    retired = BLEAppUtilRetiredTables;
+    BLEAppUtilRetiredTables = NULL;
+    pthread_mutex_unlock(&mutex);
+
+    while(retired != NULL)
+    {
+        next = retired->next;
+        BLEAppUtil_free(retired);
+        retired = next;
+    }
+}
+
 /*********************************************************************
  * @fn      BLEAppUtil_registerIcall
  *
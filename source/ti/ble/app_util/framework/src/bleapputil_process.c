@@ -1156,69 +1156,81 @@ uint8_t BLEAppUtil_isPairStateEventRequired(uint8_t event,
  */
 void BLEAppUtil_callEventHandler(uint32_t event, BLEAppUtil_msgHdr_t *pMsg, BLEAppUtil_eventHandlerType_e type)
 {
-    BLEAppUtil_EventHandlersList_t *handler = NULL;
+    BLEAppUtil_HandlersTable_t *table;
+    BLEAppUtil_EventHandler_t *handler;
+    uint16_t i;
 
-    // Lock the Mutex
-    pthread_mutex_lock(&mutex);
+    if(type >= BLEAPPUTIL_NUM_OF_HANDLER_TYPES)
+    {
+        return;
+    }
 
-    // Get the handler if exist
-    handler = BLEAppUtil_getEventHandler(handler, type);
-    // Iterate over the handlers list
-    while(handler != NULL)
+    // Published tables are never resized or freed while a dispatch is in
+    // progress, so the handlers can be called without locking the mutex.
+    // Handlers may register or un-register handlers from their context
+    BLEAppUtilDispatchDepth++;
+
+    table = BLEAppUtilHandlersTables[type];
+    if(table != NULL)
     {
-        // If the handler is from PASSCODE or L2CAP_DATA types or
-        // (for all other types) the event is part of the event mask,
-        // call the handler
-        if((type == BLEAPPUTIL_PASSCODE_TYPE) ||
-           (type == BLEAPPUTIL_L2CAP_DATA_TYPE) ||
-           (handler->eventHandler->eventMask & event))
+        // Iterate over the handlers table
+        for(i = 0; i < table->numHandlers; i++)
         {
-            handler->eventHandler->pEventHandler(event, pMsg);
+            handler = table->handlers[i];
+
+            // If the handler was not un-registered and it is from PASSCODE or
+            // L2CAP_DATA types or (for all other types) the event is part of
+            // the event mask, call the handler
+            if((handler != NULL) &&
+               ((type == BLEAPPUTIL_PASSCODE_TYPE) ||
+                (type == BLEAPPUTIL_L2CAP_DATA_TYPE) ||
+                (handler->eventMask & event)))
+            {
+                handler->pEventHandler(event, pMsg);
+            }
         }
-
-        // Get the next handler if exist
-        handler = BLEAppUtil_getEventHandler(handler, type);
     }
 
-    // Unlock the Mutex - handlers were called
-    pthread_mutex_unlock(&mutex);
+    BLEAppUtilDispatchDepth--;
+
+    // Free the tables that were replaced during the dispatch
+    if((BLEAppUtilDispatchDepth == 0) && (BLEAppUtilRetiredTables != NULL))
+    {
+        BLEAppUtil_freeRetiredHandlersTables();
+    }
 }
 
 /*********************************************************************
  * @fn      BLEAppUtil_isEventEnabled
  *
- * @brief   Returns the event mask of all registered event handlers from
- *          a specific event handler type.
+ * @brief   Checks the aggregated event mask of all registered event
+ *          handlers from a specific event handler type.
  *
  * @param   eventHandlerType - Handler type to get the event masks for
  * @param   event - The event to verify that is required
  *
- * @return  The bieMask of all relevant event handlers
+ * @return  true if at least one handler requires the event
  */
 uint8_t BLEAppUtil_isEventEnabled(BLEAppUtil_eventHandlerType_e eventHandlerType,
                                   uint32_t event)
 {
-    uint8_t isRequired = false;
-    BLEAppUtil_EventHandlersList_t *handler = NULL;
+    uint32_t eventMask;
 
-    // Get the handler if exist
-    handler = BLEAppUtil_getEventHandler(handler, eventHandlerType);
-    while(handler != NULL)
+    if(eventHandlerType >= BLEAPPUTIL_NUM_OF_HANDLER_TYPES)
     {
-        // Check if it's event mask contains the event
-        if((eventHandlerType == BLEAPPUTIL_PASSCODE_TYPE) ||
-           (eventHandlerType == BLEAPPUTIL_L2CAP_DATA_TYPE) ||
-           (handler->eventHandler->eventMask & event))
-        {
-            isRequired = true;
-            break;
-        }
+        return false;
+    }
+
+    eventMask = BLEAppUtilEventMasks[eventHandlerType];
 
-        // Get the next handler if exist
-        handler = BLEAppUtil_getEventHandler(handler, eventHandlerType);
+    // PASSCODE and L2CAP_DATA events are required if any handler is registered
+    if((eventHandlerType == BLEAPPUTIL_PASSCODE_TYPE) ||
+       (eventHandlerType == BLEAPPUTIL_L2CAP_DATA_TYPE))
+    {
+        return (eventMask != 0);
     }
 
-    return isRequired;
+    return ((eventMask & event) != 0);
 }
 
 /*********************************************************************
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== bleapputilstubs.c ========
+ *
+ * Stack, ICall and BLEAppUtil task functions referenced by
+ * bleapputil_init.c and bleapputil_process.c that bleapputiltest does not
+ * reach. They are defined in a separate file since their prototypes do
+ * not matter here.
+ */
+
+#include <stdlib.h>
+
+#define NOT_USED(name) void name(void) { abort(); }
+
+NOT_USED(BLEAppUtil_CmConnStatusCB)
+NOT_USED(BLEAppUtil_CmReportCB)
+NOT_USED(BLEAppUtil_CmsConnUpdateCB)
+NOT_USED(BLEAppUtil_CsCB)
+NOT_USED(BLEAppUtil_HandoverCNCB)
+NOT_USED(BLEAppUtil_HandoverSNCB)
+NOT_USED(BLEAppUtil_advCB)
+NOT_USED(BLEAppUtil_connEventCB)
+NOT_USED(BLEAppUtil_createBLEAppUtilTask)
+NOT_USED(BLEAppUtil_enqueueMsg)
+NOT_USED(BLEAppUtil_pairStateCB)
+NOT_USED(BLEAppUtil_passcodeCB)
+NOT_USED(BLEAppUtil_processStackMsgCB)
+NOT_USED(BLEAppUtil_scanCB)
+NOT_USED(CMS_RegisterCBs)
+NOT_USED(CM_RegisterCBs)
+NOT_USED(CS_RegisterCB)
+NOT_USED(GAPBondMgr_Register)
+NOT_USED(GAPBondMgr_SetParameter)
+NOT_USED(GAP_DeviceInit)
+NOT_USED(GAP_RegisterForMsgs)
+NOT_USED(GAP_SetParamValue)
+NOT_USED(GAP_TerminateLinkReq)
+NOT_USED(GAP_UpdateLinkParamReq)
+NOT_USED(GAP_UpdateLinkParamReqReply)
+NOT_USED(GATTServApp_AddService)
+NOT_USED(GATT_InitClient)
+NOT_USED(GATT_RegisterForInd)
+NOT_USED(GATT_RegisterForMsgs)
+NOT_USED(GATT_bm_free)
+NOT_USED(GGS_AddService)
+NOT_USED(GGS_SetParameter)
+NOT_USED(GapAdv_create)
+NOT_USED(GapAdv_disable)
+NOT_USED(GapAdv_enable)
+NOT_USED(GapAdv_loadByHandle)
+NOT_USED(GapAdv_setEventMask)
+NOT_USED(GapInit_cancelConnect)
+NOT_USED(GapInit_connect)
+NOT_USED(GapInit_setPhyParam)
+NOT_USED(GapScan_disable)
+NOT_USED(GapScan_enable)
+NOT_USED(GapScan_registerCb)
+NOT_USED(GapScan_setEventMask)
+NOT_USED(GapScan_setParam)
+NOT_USED(GapScan_setPhyParams)
+NOT_USED(Gap_RegisterConnEventCb)
+NOT_USED(HCI_EXT_SetMaxDataLenCmd)
+NOT_USED(HCI_LE_SetPhyCmd)
+NOT_USED(HCI_LE_WriteSuggestedDefaultDataLenCmd)
+NOT_USED(Handover_RegisterCNCBs)
+NOT_USED(Handover_RegisterSNCBs)
+NOT_USED(ICall_createRemoteTasks)
+NOT_USED(ICall_getLocalMsgEntityId)
+NOT_USED(ICall_init)
+NOT_USED(ICall_registerAppCback)
+NOT_USED(icall_directAPI)
+NOT_USED(linkDB_GetInfo)
+NOT_USED(osal_bm_free)
@@ -0,0 +1,531 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== bleapputiltest.c ========
+ *
+ * Check and benchmark of the BLEAppUtil event handler dispatch.
+ *
+ * bleapputil_init.c and bleapputil_process.c are built from the SDK
+ * sources, the stack functions they reference are in bleapputilstubs.c.
+ * The previous dispatcher, which walked the list of all the registered
+ * handlers under the mutex, is kept here as the reference:
+ *
+ *  - random sequences of registrations, un-registrations and events must
+ *    call the same handlers in the same order as the reference, and
+ *    BLEAppUtil_isEventEnabled() must agree with it; some registrations
+ *    fail their allocations and must leave nothing registered
+ *  - handlers that register and un-register handlers from their context
+ *    must not be called once un-registered, handlers registered during a
+ *    dispatch are called from the next event
+ *  - all memory must be freed once every handler is un-registered
+ *
+ * The benchmark prints the time per event of the reference and of
+ * BLEAppUtil for 4 to 64 handlers of a typical application, with 60% scan
+ * reports, 20% connection events, 10% GATT notifications and 10% events
+ * no handler is registered for.
+ *
+ * Usage:
+ *
+ *     bleapputiltest [events]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ti/ble/app_util/framework/bleapputil_api.h"
+#include "ti/ble/app_util/framework/bleapputil_internal.h"
+
+#define NUM_MODEL_HANDLERS 16
+#define NUM_BENCH_HANDLERS 64
+#define MAX_CALLS          64
+
+#define CHECK(cond, ...)                                       \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            if (failures++ < 20)                               \
+            {                                                  \
+                printf("FAIL %s:%d: ", __FILE__, __LINE__);    \
+                printf(__VA_ARGS__);                           \
+                printf("\n");                                  \
+            }                                                  \
+        }                                                      \
+    } while (0)
+
+/* List of the registered handlers, in registration order */
+typedef struct RefNode
+{
+    BLEAppUtil_EventHandler_t *eventHandler;
+    struct RefNode *next;
+} RefNode;
+
+static int failures;
+static uint32_t randomState = 1;
+
+/* Heap */
+static long allocs;
+static long frees;
+static int failAlloc;
+
+/* Handlers called by the last dispatch */
+static int calls[MAX_CALLS];
+static int numCalls;
+static long benchCalls;
+
+static BLEAppUtil_EventHandler_t modelHandlers[NUM_MODEL_HANDLERS];
+static BLEAppUtil_EventHandler_t benchHandlers[NUM_BENCH_HANDLERS];
+static RefNode *refHead;
+
+static uint32_t randomWord(void)
+{
+    randomState = randomState * 1103515245U + 12345U;
+    return (randomState >> 8);
+}
+
+static uint64_t nsSince(const struct timespec *start)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((now.tv_sec - start->tv_sec) * 1000000000ULL + now.tv_nsec - start->tv_nsec);
+}
+
+void *ICall_malloc(uint_least16_t size)
+{
+    if (failAlloc > 0 && --failAlloc == 0)
+    {
+        return (NULL);
+    }
+
+    allocs++;
+    return (malloc(size));
+}
+
+void ICall_free(void *msg)
+{
+    if (msg != NULL)
+    {
+        frees++;
+        free(msg);
+    }
+}
+
+/* Model handlers record their index */
+#define MODEL_HANDLER(n)                                                  \
+    static void modelHandler##n(uint32 event, BLEAppUtil_msgHdr_t *pMsg) \
+    {                                                                     \
+        if (numCalls < MAX_CALLS)                                         \
+        {                                                                 \
+            calls[numCalls++] = n;                                        \
+        }                                                                 \
+    }
+
+MODEL_HANDLER(0)  MODEL_HANDLER(1)  MODEL_HANDLER(2)  MODEL_HANDLER(3)
+MODEL_HANDLER(4)  MODEL_HANDLER(5)  MODEL_HANDLER(6)  MODEL_HANDLER(7)
+MODEL_HANDLER(8)  MODEL_HANDLER(9)  MODEL_HANDLER(10) MODEL_HANDLER(11)
+MODEL_HANDLER(12) MODEL_HANDLER(13) MODEL_HANDLER(14) MODEL_HANDLER(15)
+
+static const EventHandler_t modelHandlerFxns[NUM_MODEL_HANDLERS] = {
+    modelHandler0,  modelHandler1,  modelHandler2,  modelHandler3,
+    modelHandler4,  modelHandler5,  modelHandler6,  modelHandler7,
+    modelHandler8,  modelHandler9,  modelHandler10, modelHandler11,
+    modelHandler12, modelHandler13, modelHandler14, modelHandler15};
+
+static void benchHandler(uint32 event, BLEAppUtil_msgHdr_t *pMsg)
+{
+    benchCalls++;
+}
+
+/* ======== Reference ======== */
+
+static void refRegister(BLEAppUtil_EventHandler_t *eventHandler)
+{
+    RefNode **pNext = &refHead;
+    RefNode *node = malloc(sizeof(RefNode));
+
+    while (*pNext != NULL)
+    {
+        pNext = &(*pNext)->next;
+    }
+
+    node->eventHandler = eventHandler;
+    node->next = NULL;
+    *pNext = node;
+}
+
+static void refUnRegister(BLEAppUtil_EventHandler_t *eventHandler)
+{
+    RefNode **pNext = &refHead;
+    RefNode *node;
+
+    while ((node = *pNext) != NULL)
+    {
+        if (node->eventHandler == eventHandler)
+        {
+            *pNext = node->next;
+            free(node);
+            return;
+        }
+        pNext = &node->next;
+    }
+}
+
+static bool refWants(const BLEAppUtil_EventHandler_t *eventHandler, BLEAppUtil_eventHandlerType_e type, uint32_t event)
+{
+    return (eventHandler->handlerType == type &&
+            (type == BLEAPPUTIL_PASSCODE_TYPE || type == BLEAPPUTIL_L2CAP_DATA_TYPE ||
+             (eventHandler->eventMask & event) != 0));
+}
+
+static bool refIsEventEnabled(BLEAppUtil_eventHandlerType_e type, uint32_t event)
+{
+    RefNode *node;
+
+    for (node = refHead; node != NULL; node = node->next)
+    {
+        if (refWants(node->eventHandler, type, event))
+        {
+            return (true);
+        }
+    }
+
+    return (false);
+}
+
+static void refCallEventHandler(uint32_t event, BLEAppUtil_msgHdr_t *pMsg, BLEAppUtil_eventHandlerType_e type)
+{
+    RefNode *node;
+
+    pthread_mutex_lock(&mutex);
+    for (node = refHead; node != NULL; node = node->next)
+    {
+        if (refWants(node->eventHandler, type, event))
+        {
+            node->eventHandler->pEventHandler(event, pMsg);
+        }
+    }
+    pthread_mutex_unlock(&mutex);
+}
+
+/* ======== Checks ======== */
+
+/* Dispatch an event and compare the handlers called with the reference */
+static void checkDispatch(BLEAppUtil_eventHandlerType_e type, uint32_t event)
+{
+    int expected[NUM_MODEL_HANDLERS];
+    int numExpected = 0;
+    RefNode *node;
+
+    for (node = refHead; node != NULL; node = node->next)
+    {
+        if (refWants(node->eventHandler, type, event))
+        {
+            expected[numExpected++] = node->eventHandler - modelHandlers;
+        }
+    }
+
+    CHECK(BLEAppUtil_isEventEnabled(type, event) == (numExpected > 0),
+          "type %d event 0x%08x enabled %d, expected %d", type, event,
+          BLEAppUtil_isEventEnabled(type, event), numExpected > 0);
+
+    numCalls = 0;
+    BLEAppUtil_callEventHandler(event, NULL, type);
+    CHECK(numCalls == numExpected && memcmp(calls, expected, numCalls * sizeof(int)) == 0,
+          "type %d event 0x%08x called %d handlers, expected %d", type, event, numCalls, numExpected);
+}
+
+static void checkModel(int ops)
+{
+    bool registered[NUM_MODEL_HANDLERS] = {false};
+    BLEAppUtil_EventHandler_t *eventHandler;
+    bStatus_t status;
+    uint32_t r;
+    int fail;
+    int i;
+
+    while (ops-- > 0)
+    {
+        r = randomWord();
+        i = (r >> 4) % NUM_MODEL_HANDLERS;
+        eventHandler = &modelHandlers[i];
+
+        if ((r & 0xF) < 3 && !registered[i])
+        {
+            eventHandler->handlerType = randomWord() % BLEAPPUTIL_NUM_OF_HANDLER_TYPES;
+            eventHandler->pEventHandler = modelHandlerFxns[i];
+            eventHandler->eventMask = randomWord() & randomWord() & randomWord();
+
+            /* Fail the list or the table allocation */
+            fail = (randomWord() % 16 == 0) ? 1 + randomWord() % 2 : 0;
+            failAlloc = fail;
+            status = BLEAppUtil_registerEventHandler(eventHandler);
+            CHECK(status == (fail > 0 ? FAILURE : SUCCESS),
+                  "register returned %d, allocation %d failed", status, fail);
+
+            if (status == SUCCESS)
+            {
+                refRegister(eventHandler);
+                registered[i] = true;
+            }
+        }
+        else if ((r & 0xF) < 6 && registered[i])
+        {
+            status = BLEAppUtil_unRegisterEventHandler(eventHandler);
+            CHECK(status == SUCCESS, "un-register returned %d", status);
+            refUnRegister(eventHandler);
+            registered[i] = false;
+        }
+        else
+        {
+            checkDispatch(randomWord() % BLEAPPUTIL_NUM_OF_HANDLER_TYPES, 1U << (randomWord() % 32));
+        }
+    }
+
+    for (i = 0; i < NUM_MODEL_HANDLERS; i++)
+    {
+        if (registered[i])
+        {
+            BLEAppUtil_unRegisterEventHandler(&modelHandlers[i]);
+            refUnRegister(&modelHandlers[i]);
+        }
+    }
+
+    CHECK(BLEAppUtil_unRegisterEventHandler(&modelHandlers[0]) == INVALIDPARAMETER,
+          "un-register of an unknown handler succeeded");
+}
+
+/* Handler a un-registers b and registers d, c un-registers itself */
+static void reentrantA(uint32 event, BLEAppUtil_msgHdr_t *pMsg)
+{
+    calls[numCalls++] = 'a';
+    BLEAppUtil_unRegisterEventHandler(&modelHandlers[1]);
+    BLEAppUtil_registerEventHandler(&modelHandlers[3]);
+}
+
+static void reentrantB(uint32 event, BLEAppUtil_msgHdr_t *pMsg)
+{
+    calls[numCalls++] = 'b';
+}
+
+static void reentrantC(uint32 event, BLEAppUtil_msgHdr_t *pMsg)
+{
+    calls[numCalls++] = 'c';
+    BLEAppUtil_unRegisterEventHandler(&modelHandlers[2]);
+}
+
+static void reentrantD(uint32 event, BLEAppUtil_msgHdr_t *pMsg)
+{
+    calls[numCalls++] = 'd';
+}
+
+static void checkReentrancy(void)
+{
+    static const EventHandler_t fxns[] = {reentrantA, reentrantB, reentrantC, reentrantD};
+    char order[MAX_CALLS + 1];
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        modelHandlers[i].handlerType = BLEAPPUTIL_GATT_TYPE;
+        modelHandlers[i].pEventHandler = fxns[i];
+        modelHandlers[i].eventMask = BLEAPPUTIL_ATT_HANDLE_VALUE_NOTI;
+    }
+    for (i = 0; i < 3; i++)
+    {
+        BLEAppUtil_registerEventHandler(&modelHandlers[i]);
+    }
+
+    /* a, not b, c; d is called from the next event, then registered twice */
+    numCalls = 0;
+    BLEAppUtil_callEventHandler(BLEAPPUTIL_ATT_HANDLE_VALUE_NOTI, NULL, BLEAPPUTIL_GATT_TYPE);
+    calls[numCalls++] = '|';
+    BLEAppUtil_callEventHandler(BLEAPPUTIL_ATT_HANDLE_VALUE_NOTI, NULL, BLEAPPUTIL_GATT_TYPE);
+    for (i = 0; i < numCalls; i++)
+    {
+        order[i] = calls[i];
+    }
+    order[numCalls] = '\0';
+    CHECK(strcmp(order, "ac|ad") == 0, "handlers called %s, expected ac|ad", order);
+
+    BLEAppUtil_unRegisterEventHandler(&modelHandlers[0]);
+    BLEAppUtil_unRegisterEventHandler(&modelHandlers[3]);
+    BLEAppUtil_unRegisterEventHandler(&modelHandlers[3]);
+    CHECK(!BLEAppUtil_isEventEnabled(BLEAPPUTIL_GATT_TYPE, BLEAPPUTIL_ATT_HANDLE_VALUE_NOTI),
+          "event enabled with no handler registered");
+}
+
+/* ======== Benchmark ======== */
+
+/* Handlers of an application and of its services and profiles */
+static const struct
+{
+    BLEAppUtil_eventHandlerType_e type;
+    uint32_t eventMask;
+} appHandlers[] = {
+    {BLEAPPUTIL_GAP_CONN_TYPE,     BLEAPPUTIL_LINK_ESTABLISHED_EVENT | BLEAPPUTIL_LINK_TERMINATED_EVENT},
+    {BLEAPPUTIL_GAP_ADV_TYPE,      0x3},
+    {BLEAPPUTIL_GAP_SCAN_TYPE,     BLEAPPUTIL_ADV_REPORT},
+    {BLEAPPUTIL_GATT_TYPE,         BLEAPPUTIL_ATT_HANDLE_VALUE_NOTI},
+    {BLEAPPUTIL_PAIR_STATE_TYPE,   0xFF},
+    {BLEAPPUTIL_PASSCODE_TYPE,     0},
+    {BLEAPPUTIL_CONN_NOTI_TYPE,    BLEAPPUTIL_CONN_NOTI_CONN_EVENT_ALL},
+    {BLEAPPUTIL_GAP_CONN_TYPE,     BLEAPPUTIL_LINK_TERMINATED_EVENT},
+    {BLEAPPUTIL_GATT_TYPE,         BLEAPPUTIL_ATT_HANDLE_VALUE_CFM},
+    {BLEAPPUTIL_GATT_TYPE,         BLEAPPUTIL_ATT_FIND_BY_TYPE_VALUE_RSP},
+    {BLEAPPUTIL_GAP_CONN_TYPE,     BLEAPPUTIL_LINK_TERMINATED_EVENT},
+    {BLEAPPUTIL_L2CAP_SIGNAL_TYPE, 0xFF},
+    {BLEAPPUTIL_CS_TYPE,           0xFF},
+    {BLEAPPUTIL_HANDOVER_TYPE,     0xFF},
+    {BLEAPPUTIL_CM_TYPE,           0xFF},
+    {BLEAPPUTIL_GAP_SCAN_TYPE,     0x4},
+};
+
+#define NUM_APP_HANDLERS (int)(sizeof(appHandlers) / sizeof(appHandlers[0]))
+
+/* Event k of the benchmark mix */
+static void benchEvent(long k, BLEAppUtil_eventHandlerType_e *type, uint32_t *event)
+{
+    switch (k % 10)
+    {
+        case 6:
+        case 7:
+            *type = BLEAPPUTIL_CONN_NOTI_TYPE;
+            *event = BLEAPPUTIL_CONN_NOTI_CONN_EVENT_ALL;
+            break;
+
+        case 8:
+            *type = BLEAPPUTIL_GATT_TYPE;
+            *event = BLEAPPUTIL_ATT_HANDLE_VALUE_NOTI;
+            break;
+
+        case 9:
+            *type = BLEAPPUTIL_HCI_DATA_TYPE;
+            *event = 1;
+            break;
+
+        default:
+            *type = BLEAPPUTIL_GAP_SCAN_TYPE;
+            *event = BLEAPPUTIL_ADV_REPORT;
+            break;
+    }
+}
+
+static void bench(int numHandlers, long events)
+{
+    BLEAppUtil_eventHandlerType_e type;
+    struct timespec start;
+    uint64_t refNs;
+    uint64_t ns;
+    long refCalls;
+    uint32_t event;
+    long k;
+    int i;
+
+    for (i = 0; i < numHandlers; i++)
+    {
+        benchHandlers[i].handlerType = appHandlers[i % NUM_APP_HANDLERS].type;
+        benchHandlers[i].pEventHandler = benchHandler;
+        benchHandlers[i].eventMask = appHandlers[i % NUM_APP_HANDLERS].eventMask;
+        BLEAppUtil_registerEventHandler(&benchHandlers[i]);
+        refRegister(&benchHandlers[i]);
+    }
+
+    /* The stack callbacks check the event is enabled before queuing it */
+    benchCalls = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (k = 0; k < events; k++)
+    {
+        benchEvent(k, &type, &event);
+        if (refIsEventEnabled(type, event))
+        {
+            refCallEventHandler(event, NULL, type);
+        }
+    }
+    refNs = nsSince(&start);
+    refCalls = benchCalls;
+
+    benchCalls = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (k = 0; k < events; k++)
+    {
+        benchEvent(k, &type, &event);
+        if (BLEAppUtil_isEventEnabled(type, event))
+        {
+            BLEAppUtil_callEventHandler(event, NULL, type);
+        }
+    }
+    ns = nsSince(&start);
+
+    CHECK(benchCalls == refCalls, "%ld handler calls, expected %ld", benchCalls, refCalls);
+
+    printf("%8d %12.1f %12.1f\n", numHandlers, (double)refNs / events, (double)ns / events);
+
+    for (i = 0; i < numHandlers; i++)
+    {
+        BLEAppUtil_unRegisterEventHandler(&benchHandlers[i]);
+        refUnRegister(&benchHandlers[i]);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    long events = (argc > 1) ? atol(argv[1]) : 5000000;
+    int n;
+
+    pthread_mutex_init(&mutex, NULL);
+
+    checkModel(400000);
+    checkReentrancy();
+    CHECK(allocs == frees, "%ld allocations, %ld frees", allocs, frees);
+
+    printf("ns per event, %ld events\n", events);
+    printf("%8s %12s %12s\n", "handlers", "previous", "BLEAppUtil");
+    for (n = 4; n <= NUM_BENCH_HANDLERS; n *= 2)
+    {
+        bench(n, events);
+    }
+    CHECK(allocs == frees, "%ld allocations, %ld frees", allocs, frees);
+
+    if (failures == 0)
+    {
+        printf("checks passed\n");
+    }
+    else
+    {
+        printf("%d failures\n", failures);
+    }
+
+    return (failures != 0);
+}
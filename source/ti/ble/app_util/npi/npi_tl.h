@@ -139,6 +139,22 @@ uint16 NPITL_readTL(uint8 *buf, uint16 len);
 // -----------------------------------------------------------------------------
 uint16 NPITL_writeTL(uint8 *buf, uint16 len);
 
+// -----------------------------------------------------------------------------
+//! \brief      This routine writes several buffers to the transport layer
+//!             back to back in a single transfer. The buffers are copied, so
+//!             they may be released as soon as this routine returns.
+//!
+//! \param[in]  bufs - Pointers to the buffers to write data from.
+//! \param[in]  lens - Number of bytes to write from each buffer.
+//! \param[in]  num - Number of buffers.
+//!
+//! \return     uint16 - the number of bytes written to transport
+//!
+//! \note       Together the buffers must fit in NPI_MAX_FRAG_SIZE. Buffers
+//!             beyond that size are not written.
+// -----------------------------------------------------------------------------
+uint16 NPITL_writeBatchTL(uint8 *bufs[], uint16 lens[], uint8 num);
+
 // -----------------------------------------------------------------------------
 //! \brief      This routine is used to handle an MRDY edge from the application
 //!             context. Certain operations such as UART_read() cannot be
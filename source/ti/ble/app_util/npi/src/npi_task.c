@@ -210,6 +210,22 @@
 #define NPI_MSG_LEN                             sizeof(uint8_t*)
 #endif
 
+//! \brief Number of queue records kept in a static pool. Records are taken
+//!        from the heap only once the pool is exhausted.
+#ifndef NPITASK_QUEUE_REC_POOL_SIZE
+#define NPITASK_QUEUE_REC_POOL_SIZE             8
+#endif
+
+#if (NPITASK_QUEUE_REC_POOL_SIZE > 32)
+#error "NPI ERROR: NPITASK_QUEUE_REC_POOL_SIZE must not exceed 32."
+#endif
+
+//! \brief Maximum number of queued ASYNC frames sent in a single transport
+//!        layer transfer.
+#ifndef NPITASK_TX_COALESCE_MAX
+#define NPITASK_TX_COALESCE_MAX                 8
+#endif
+
 // ****************************************************************************
 // typedefs
 // ****************************************************************************
@@ -222,6 +238,10 @@ typedef struct NPI_QueueRec_t
     Queue_Elem _elem;
 #endif
     NPIMSG_msg_t *npiMsg;
+
+    // Container of a received frame, used when the record comes from the
+    // pool. The record is then released together with the container.
+    NPIMSG_msg_t rxMsg;
 } NPI_QueueRec;
 
 
@@ -296,6 +316,21 @@ static Clock_Handle syncReqRspWatchDogClkHandle;
 //!
 static uint8_t *lastQueuedTxMsg;
 
+//! \brief Pool of queue records, and a bit mask of the records in use
+//!
+static NPI_QueueRec npiQueueRecPool[NPITASK_QUEUE_REC_POOL_SIZE];
+static uint32_t npiQueueRecPoolUsed = 0;
+
+//! \brief ASYNC TX record that was dequeued but did not fit in the last
+//!        transfer. It is sent ahead of the rest of the ASYNC TX Queue.
+//!
+static NPI_QueueRec *npiTxHeldRec = NULL;
+
+//! \brief Frames of the ASYNC TX transfer being assembled
+//!
+static uint8_t *npiTxBatchBuf[NPITASK_TX_COALESCE_MAX];
+static uint16_t npiTxBatchLen[NPITASK_TX_COALESCE_MAX];
+
 //! \brief NPI thread ICall Semaphore.
 //!
 #define FLE_DEBUG 1
@@ -370,6 +405,22 @@ static void NPITask_MRDYEventCB(int size);
 //!
 static void NPITask_ProcessTXQ(void);
 
+//! \brief Returns true if ASYNC messages are waiting to be sent to the host.
+//!
+static bool NPITask_txPending(void);
+
+//! \brief Take a queue record from the pool, or from the heap if it is empty.
+//!
+static NPI_QueueRec *NPITask_allocQueueRec(bool heapLimited);
+
+//! \brief Release a queue record to the pool or the heap.
+//!
+static void NPITask_freeQueueRec(NPI_QueueRec *recPtr);
+
+//! \brief Release an NPI message container, without its message buffer.
+//!
+static void NPITask_freeMsgContainer(NPIMSG_msg_t *pMsg);
+
 #if defined(NPI_SREQRSP)
 //! \brief SYNC TX Q Processing function.
 //!
@@ -423,6 +474,8 @@ static void NPITask_inititializeTask(void)
 #endif //ICALL_EVENTS
 
     lastQueuedTxMsg = NULL;
+    npiTxHeldRec = NULL;
+    npiQueueRecPoolUsed = 0;
 
 #ifdef FREERTOS
     // create a Tx Queue instance
@@ -588,9 +641,10 @@ static void NPITask_process(void)
             }
 #endif // NPI_SREQRSP
 
-            // ICall Message Event
-            if (ICall_fetchServiceMsg(&stackid, &dest, (void * *) &pMsg)
-                == ICALL_ERRNO_SUCCESS)
+            // ICall Message Events. Several messages can be queued for a
+            // single event, so handle all of them.
+            while (ICall_fetchServiceMsg(&stackid, &dest, (void * *) &pMsg)
+                   == ICALL_ERRNO_SUCCESS)
             {
                 NPITask_processICallMsgEvent( pMsg, stackid, dest );
             }
@@ -634,19 +688,21 @@ static void NPITask_process(void)
                     // No outstanding SYNC REQ/RSP transactions, process
                     // ASYNC messages.
 #endif // NPI_SREQRSP
-                    if ((!Queue_empty(npiTxQueue)) && !NPITL_checkNpiBusy())
+                    if (NPITask_txPending() && !NPITL_checkNpiBusy())
                     {
-                        // Push the pending Async Msg to the host.
+                        // Push the pending Async Msgs to the host.
                         NPITask_ProcessTXQ();
                     }
 #if defined(NPI_SREQRSP)
                 }
 #endif // NPI_SREQRSP
 
-                if (Queue_empty(npiTxQueue))
+                if (!NPITask_txPending() || NPITL_checkNpiBusy())
                 {
 #ifndef ICALL_EVENTS
-                    // Q is empty, it's safe to clear the event flag.
+                    // Q is empty, or the transport is busy and the event is
+                    // posted again once it is done. It's safe to clear the
+                    // event flag.
                     NPITask_events &= ~NPITASK_TX_READY_EVENT;
 #endif //ICALL_EVENTS
                 }
@@ -757,7 +813,7 @@ static void NPITask_process(void)
                 else
                 {
 #endif // NPI_SREQRSP
-                    if (!Queue_empty(npiTxQueue))
+                    if (NPITask_txPending())
                     {
                         // There are pending ASYNC messages waiting to be sent
                         // to the host. Set the appropriate flag and post to
@@ -908,7 +964,7 @@ void NPITask_sendToHost(uint8_t *pMsg)
       return;
     }
 
-    recPtr = ICall_mallocLimited(sizeof(NPI_QueueRec));
+    recPtr = NPITask_allocQueueRec(true);
 
     if(recPtr == NULL)
     {
@@ -947,7 +1003,7 @@ void NPITask_sendToHost(uint8_t *pMsg)
             {
                 // Free NPI Message and NPI buffer in case it allocated.
                 NPITask_freeNpiMsg((uint8_t *)pNPIMsg);
-                ICall_free(recPtr);
+                NPITask_freeQueueRec(recPtr);
                 ICall_leaveCriticalSection(key);
                 return;
             }
@@ -1019,12 +1075,101 @@ static ICall_Errno NPITask_sendBufToStack(ICall_EntityID appEntity,
     errno = ICall_sendServiceMsg(appEntity, stackServiceID,
                                  ICALL_MSG_FORMAT_KEEP, pMsg->pBuf);
 
-    ICall_free(pMsg);
+    NPITask_freeMsgContainer(pMsg);
 
     return (errno);
 }
 
 
+// -----------------------------------------------------------------------------
+//! \brief      Take a queue record from the pool. If all pooled records are
+//!             in use, the record is allocated from the heap.
+//!
+//! \param[in]  heapLimited  true to use ICall_mallocLimited() for the heap
+//!
+//! \return     NPI_QueueRec* - the record, or NULL if out of memory
+// -----------------------------------------------------------------------------
+static NPI_QueueRec *NPITask_allocQueueRec(bool heapLimited)
+{
+    NPI_QueueRec *recPtr = NULL;
+    ICall_CSState key;
+    uint8_t i;
+
+    key = ICall_enterCriticalSection();
+
+    for (i = 0; i < NPITASK_QUEUE_REC_POOL_SIZE; i++)
+    {
+        if ((npiQueueRecPoolUsed & (1UL << i)) == 0)
+        {
+            npiQueueRecPoolUsed |= (1UL << i);
+            recPtr = &npiQueueRecPool[i];
+            break;
+        }
+    }
+
+    ICall_leaveCriticalSection(key);
+
+    if (recPtr == NULL)
+    {
+        if (heapLimited)
+        {
+            recPtr = ICall_mallocLimited(sizeof(NPI_QueueRec));
+        }
+        else
+        {
+            recPtr = ICall_malloc(sizeof(NPI_QueueRec));
+        }
+    }
+
+    return (recPtr);
+}
+
+// -----------------------------------------------------------------------------
+//! \brief      Release a queue record to the pool or to the heap.
+//!
+//! \param[in]  recPtr    Pointer to the queue record.
+//!
+//! \return     void
+// -----------------------------------------------------------------------------
+static void NPITask_freeQueueRec(NPI_QueueRec *recPtr)
+{
+    if ((recPtr >= &npiQueueRecPool[0]) &&
+        (recPtr < &npiQueueRecPool[NPITASK_QUEUE_REC_POOL_SIZE]))
+    {
+        ICall_CSState key;
+
+        key = ICall_enterCriticalSection();
+        npiQueueRecPoolUsed &= ~(1UL << (recPtr - npiQueueRecPool));
+        ICall_leaveCriticalSection(key);
+    }
+    else
+    {
+        ICall_free(recPtr);
+    }
+}
+
+// -----------------------------------------------------------------------------
+//! \brief      Release an NPI message container, but not its message buffer.
+//!             A container held by a pooled queue record releases the record.
+//!
+//! \param[in]  pMsg    Pointer to the NPIMSG_msg_t container.
+//!
+//! \return     void
+// -----------------------------------------------------------------------------
+static void NPITask_freeMsgContainer(NPIMSG_msg_t *pMsg)
+{
+    if (((uint8_t *)pMsg >= (uint8_t *)&npiQueueRecPool[0]) &&
+        ((uint8_t *)pMsg < (uint8_t *)&npiQueueRecPool[NPITASK_QUEUE_REC_POOL_SIZE]))
+    {
+        NPITask_freeQueueRec(&npiQueueRecPool[((uint8_t *)pMsg - (uint8_t *)npiQueueRecPool) /
+                                              sizeof(NPI_QueueRec)]);
+    }
+    else
+    {
+        ICall_free(pMsg);
+    }
+}
+
 // -----------------------------------------------------------------------------
 // "Processor" functions
 
@@ -1069,7 +1214,7 @@ static void NPITask_processStackMsg(uint8_t *pMsg)
     {
         NPI_QueueRec *recPtr;
 
-        recPtr = ICall_mallocLimited(sizeof(NPI_QueueRec));
+        recPtr = NPITask_allocQueueRec(true);
         if(recPtr != NULL)
         {
             ICall_CSState key;
@@ -1101,7 +1246,7 @@ static void NPITask_processStackMsg(uint8_t *pMsg)
 #ifdef FREERTOS
                     if(Queue_enqueue(npiTxQueue, (char*)&recPtr) == FAILURE)
                     {
-                        ICall_free(recPtr);
+                        NPITask_freeQueueRec(recPtr);
                         // Free NPI Message and NPI buffer in case it allocated.
                         NPITask_freeNpiMsg((uint8_t *)pNPIMsg);
                         return;
@@ -1120,7 +1265,7 @@ static void NPITask_processStackMsg(uint8_t *pMsg)
                 default:
                 {
                     /* Fail - unsupported message type */
-                    ICall_free(recPtr);
+                    NPITask_freeQueueRec(recPtr);
                     // Free NPI Message and NPI buffer in case it allocated.
                     NPITask_freeNpiMsg((uint8_t *)pNPIMsg);
                     break;
@@ -1139,8 +1284,9 @@ static void NPITask_processStackMsg(uint8_t *pMsg)
 }
 
 // -----------------------------------------------------------------------------
-//! \brief      Dequeue next message in the ASYNC TX Queue and send to serial
-//!             interface.
+//! \brief      Dequeue the next messages in the ASYNC TX Queue and send them to
+//!             serial interface. Consecutive messages that fit in one
+//!             transport layer fragment are sent in a single transfer.
 //!
 //! \return     void
 // -----------------------------------------------------------------------------
@@ -1148,35 +1294,103 @@ static void NPITask_ProcessTXQ(void)
 {
     ICall_CSState key;
     NPI_QueueRec *recPtr = NULL;
+    uint16_t batchLen = 0;
+    uint8_t numFrames = 0;
+    uint8_t i;
 
     // Processing of any TX Queue should only be done
     // in a critical section since any application
     // task can enqueue items freely
     key = ICall_enterCriticalSection();
 
-    if (!Queue_empty(npiTxQueue))
+    // Start with the message left over from the previous transfer
+    recPtr = npiTxHeldRec;
+    npiTxHeldRec = NULL;
+
+    for (;;)
     {
+        if (recPtr == NULL)
+        {
+            if (Queue_empty(npiTxQueue))
+            {
+                break;
+            }
 #ifdef FREERTOS
-      recPtr = (NPI_QueueRec *)Queue_dequeue(npiTxQueue);
+            recPtr = (NPI_QueueRec *)Queue_dequeue(npiTxQueue);
 #else
-      recPtr = Queue_dequeue(npiTxQueue);
+            recPtr = Queue_dequeue(npiTxQueue);
 #endif
+            if (recPtr == NULL)
+            {
+                break;
+            }
+        }
 
-      if (recPtr != NULL)
-      {
-          lastQueuedTxMsg = recPtr->npiMsg->pBuf;
+        if (recPtr->npiMsg->pBufSize > NPI_MAX_FRAG_SIZE)
+        {
+            if (numFrames > 0)
+            {
+                // Send it on its own after the current transfer
+                npiTxHeldRec = recPtr;
+                break;
+            }
 
-          NPITL_writeTL(recPtr->npiMsg->pBuf, recPtr->npiMsg->pBufSize);
+            // The message is sent in fragments straight from its buffer, which
+            // is free'd once the transmission completes
+            lastQueuedTxMsg = recPtr->npiMsg->pBuf;
 
-          //free the Queue record
-          ICall_free(recPtr->npiMsg);
-          ICall_free(recPtr);
-      }
+            NPITL_writeTL(recPtr->npiMsg->pBuf, recPtr->npiMsg->pBufSize);
+
+            //free the Queue record
+            NPITask_freeMsgContainer(recPtr->npiMsg);
+            NPITask_freeQueueRec(recPtr);
+            break;
+        }
+
+        if ((numFrames == NPITASK_TX_COALESCE_MAX) ||
+            (batchLen + recPtr->npiMsg->pBufSize > NPI_MAX_FRAG_SIZE))
+        {
+            // Transfer is full, keep the message for the next one
+            npiTxHeldRec = recPtr;
+            break;
+        }
+
+        npiTxBatchBuf[numFrames] = recPtr->npiMsg->pBuf;
+        npiTxBatchLen[numFrames] = recPtr->npiMsg->pBufSize;
+        batchLen += recPtr->npiMsg->pBufSize;
+        numFrames++;
+
+        //free the Queue record
+        NPITask_freeMsgContainer(recPtr->npiMsg);
+        NPITask_freeQueueRec(recPtr);
+        recPtr = NULL;
+    }
+
+    if (numFrames > 0)
+    {
+        NPITL_writeBatchTL(npiTxBatchBuf, npiTxBatchLen, numFrames);
+
+        // The messages were copied to the transport layer buffer
+        for (i = 0; i < numFrames; i++)
+        {
+            ICall_freeMsg(npiTxBatchBuf[i]);
+        }
     }
 
     ICall_leaveCriticalSection(key);
 }
 
+// -----------------------------------------------------------------------------
+//! \brief      Check for ASYNC messages waiting to be sent to the host.
+//!
+//! \return     bool - true if the ASYNC TX Queue or the held message is not
+//!             empty
+// -----------------------------------------------------------------------------
+static bool NPITask_txPending(void)
+{
+    return ((npiTxHeldRec != NULL) || !Queue_empty(npiTxQueue));
+}
+
 #if defined(NPI_SREQRSP)
 // -----------------------------------------------------------------------------
 //! \brief      Dequeue next message in the SYNC TX Queue and send to serial
@@ -1220,8 +1434,8 @@ static void NPITask_ProcessSyncTXQ(void)
               syncTransactionInProgress = 0;
           }
 
-          ICall_free(recPtr->npiMsg);
-          ICall_free(recPtr);
+          NPITask_freeMsgContainer(recPtr->npiMsg);
+          NPITask_freeQueueRec(recPtr);
       }
     }
 
@@ -1230,66 +1444,75 @@ static void NPITask_ProcessSyncTXQ(void)
 #endif // NPI_SREQRSP
 
 // -----------------------------------------------------------------------------
-//! \brief      Dequeue next message in the RX Queue and process it.
+//! \brief      Dequeue all messages in the RX Queue and process them.
 //!
 //! \return     void
 // -----------------------------------------------------------------------------
 static void NPITask_processRXQ(void)
 {
     NPI_QueueRec *recPtr = NULL;
+    NPIMSG_msg_t *npiMsg;
 
-    if (!Queue_empty(npiRxQueue))
+    while (!Queue_empty(npiRxQueue))
     {
 #ifdef FREERTOS
       recPtr = (NPI_QueueRec *)Queue_dequeue(npiRxQueue);
 #else
       recPtr = Queue_get(npiRxQueue);
 #endif
-      if (recPtr != NULL)
+      if (recPtr == NULL)
       {
-          if (incomingRXEventAppCBFunc != NULL)
+          break;
+      }
+
+      npiMsg = recPtr->npiMsg;
+
+      //free the Queue record, unless it holds the npiMsg container. It is
+      // then free'd along with the container.
+      if (npiMsg != &recPtr->rxMsg)
+      {
+          NPITask_freeQueueRec(recPtr);
+      }
+
+      // DON'T free the referenced npiMsg container.  This will be free'd in the
+      // stack task.
+      if (incomingRXEventAppCBFunc != NULL)
+      {
+          switch (incomingRXReroute)
           {
-              switch (incomingRXReroute)
+              case ECHO:
               {
-                  case ECHO:
-                  {
-                      // send to stack and a copy to the application
-                      NPITask_sendBufToStack(npiAppEntityID, recPtr->npiMsg);
-                      incomingRXEventAppCBFunc((uint8_t *)recPtr->npiMsg);
-                      break;
-                  }
+                  // send a copy to the application and then to the stack,
+                  // which releases the container
+                  incomingRXEventAppCBFunc((uint8_t *)npiMsg);
+                  NPITask_sendBufToStack(npiAppEntityID, npiMsg);
+                  break;
+              }
 
-                  case INTERCEPT:
-                  {
-                      // send a copy only to the application
-                      // npiMsg need to be free in the callback
+              case INTERCEPT:
+              {
+                  // send a copy only to the application
+                  // npiMsg need to be free in the callback
 #ifdef NPI_RAW
-                      incomingRXEventAppCBFunc((uint8_t *)recPtr->npiMsg->pBuf);
-                      NPITask_freeNpiMsg((uint8_t *)recPtr->npiMsg);
+                  incomingRXEventAppCBFunc((uint8_t *)npiMsg->pBuf);
+                  NPITask_freeNpiMsg((uint8_t *)npiMsg);
 #else
-                      incomingRXEventAppCBFunc((uint8_t *)recPtr->npiMsg);
+                  incomingRXEventAppCBFunc((uint8_t *)npiMsg);
 #endif
-                      break;
-                  }
+                  break;
+              }
 
-                  case NONE:
-                  {
-                      NPITask_sendBufToStack(npiAppEntityID, recPtr->npiMsg);
-                      break;
-                  }
+              case NONE:
+              {
+                  NPITask_sendBufToStack(npiAppEntityID, npiMsg);
+                  break;
               }
           }
-          else
-          {
-              // send to stack and a copy to the application
-              NPITask_sendBufToStack(npiAppEntityID, recPtr->npiMsg);
-          }
-
-          //free the Queue record
-          ICall_free(recPtr);
-
-          // DON'T free the referenced npiMsg container.  This will be free'd in the
-          // stack task.
+      }
+      else
+      {
+          // send to stack and a copy to the application
+          NPITask_sendBufToStack(npiAppEntityID, npiMsg);
       }
     }
 }
@@ -1303,6 +1526,7 @@ static void NPITask_processRXQ(void)
 static void NPITask_processSyncRXQ(void)
 {
     NPI_QueueRec *recPtr = NULL;
+    NPIMSG_msg_t *npiMsg;
 
     if (syncTransactionInProgress == 0)
     {
@@ -1312,6 +1536,14 @@ static void NPITask_processSyncRXQ(void)
 
           if (recPtr != NULL)
           {
+              npiMsg = recPtr->npiMsg;
+
+              //free the Queue record, unless it holds the npiMsg container.
+              // It is then free'd along with the container.
+              if (npiMsg != &recPtr->rxMsg)
+              {
+                  NPITask_freeQueueRec(recPtr);
+              }
 
               // Increment the outstanding Sync REQ/RSP flag.
               syncTransactionInProgress++;
@@ -1325,22 +1557,25 @@ static void NPITask_processSyncRXQ(void)
                   {
                       case ECHO:
                       {
-                          // send to stack and a copy to the application
-                          NPITask_sendBufToStack(npiAppEntityID, recPtr->npiMsg);
-                          incomingRXEventAppCBFunc(recPtr->npiMsg->pBuf);
+                          // send a copy to the application and then to the
+                          // stack, which releases the container
+                          incomingRXEventAppCBFunc(npiMsg->pBuf);
+                          NPITask_sendBufToStack(npiAppEntityID, npiMsg);
                           break;
                       }
 
                       case INTERCEPT:
                       {
-                          // send a copy only to the application
-                          incomingRXEventAppCBFunc(recPtr->npiMsg->pBuf);
+                          // send a copy only to the application, which
+                          // only takes the message buffer
+                          incomingRXEventAppCBFunc(npiMsg->pBuf);
+                          NPITask_freeMsgContainer(npiMsg);
                           break;
                       }
 
                       case NONE:
                       {
-                          NPITask_sendBufToStack(npiAppEntityID, recPtr->npiMsg);
+                          NPITask_sendBufToStack(npiAppEntityID, npiMsg);
                           break;
                       }
                   }
@@ -1348,13 +1583,10 @@ static void NPITask_processSyncRXQ(void)
               else
               {
                   // send to stack and a copy to the application
-                  NPITask_sendBufToStack(npiAppEntityID, recPtr->npiMsg);
+                  NPITask_sendBufToStack(npiAppEntityID, npiMsg);
               }
-
-              //free the Queue record
-              ICall_free(recPtr);
-              // DON'T free the referenced npiMsg container.  This will be free'd in the
-              // stack task.
+              // DON'T free the referenced npiMsg buffer.  This will be free'd
+              // in the stack task.
           }
         }
     }
@@ -1403,86 +1635,99 @@ static void NPITask_transportTxDoneCallBack(int size)
 static void NPITask_incomingFrameCB(uint16_t frameSize, uint8_t *pFrame,
                                     NPIMSG_Type msgType)
 {
+    NPIMSG_msg_t *npiMsgPtr;
+    NPI_QueueRec *recPtr = NPITask_allocQueueRec(false);
 
-    NPI_QueueRec *recPtr = ICall_malloc(sizeof(NPI_QueueRec));
+    if (recPtr == NULL)
+    {
+        ICall_freeMsg(pFrame);
+        return;
+    }
 
-    if (recPtr != NULL)
+    // A pooled record holds the NPIMSG_msg_t container itself, a record from
+    // the heap needs a separate one
+    if ((recPtr >= &npiQueueRecPool[0]) &&
+        (recPtr < &npiQueueRecPool[NPITASK_QUEUE_REC_POOL_SIZE]))
     {
-        // Allocate NPIMSG_msg_t container
-        NPIMSG_msg_t *npiMsgPtr = ICall_malloc(sizeof(NPIMSG_msg_t));
+        npiMsgPtr = &recPtr->rxMsg;
+    }
+    else
+    {
+        npiMsgPtr = ICall_malloc(sizeof(NPIMSG_msg_t));
 
-        if (npiMsgPtr != NULL)
+        if (npiMsgPtr == NULL)
         {
-            npiMsgPtr->pBuf = pFrame;
-            npiMsgPtr->pBufSize = frameSize;
-            recPtr->npiMsg = npiMsgPtr;
+            // Malloc failed - release previous dynamic allocation
+            NPITask_freeQueueRec(recPtr);
+            ICall_freeMsg(pFrame);
+            return;
+        }
+    }
 
-            switch (msgType)
-            {
+    npiMsgPtr->pBuf = pFrame;
+    npiMsgPtr->pBufSize = frameSize;
+    recPtr->npiMsg = npiMsgPtr;
 
-                // Enqueue to appropriate NPI Task Q and post corresponding event.
-                case NPIMSG_Type_ASYNC:
-                {
-                    recPtr->npiMsg->msgType = NPIMSG_Type_ASYNC;
+    switch (msgType)
+    {
+
+        // Enqueue to appropriate NPI Task Q and post corresponding event.
+        case NPIMSG_Type_ASYNC:
+        {
+            recPtr->npiMsg->msgType = NPIMSG_Type_ASYNC;
 #ifdef FREERTOS
-                    if(Queue_enqueue(npiRxQueue, (char*)&recPtr) == FAILURE)
-                    {
-                        ICall_free(npiMsgPtr);
-                        ICall_free(recPtr);
-                        ICall_freeMsg(pFrame);
-                        return;
-                    }
+            if(Queue_enqueue(npiRxQueue, (char*)&recPtr) == FAILURE)
+            {
+                ICall_freeMsg(pFrame);
+                NPITask_freeMsgContainer(npiMsgPtr);
+                if (npiMsgPtr != &recPtr->rxMsg)
+                {
+                    NPITask_freeQueueRec(recPtr);
+                }
+                return;
+            }
 #else
-                    Queue_put(npiRxQueue, &recPtr->_elem);
+            Queue_put(npiRxQueue, &recPtr->_elem);
 #endif
 #ifdef ICALL_EVENTS
-                    EVENT_POST(syncEvent, NPITASK_FRAME_RX_EVENT);
+            EVENT_POST(syncEvent, NPITASK_FRAME_RX_EVENT);
 #else //!ICALL_EVENTS
-                    NPITask_events |= NPITASK_FRAME_RX_EVENT;
-                    Semaphore_post(appSem);
+            NPITask_events |= NPITASK_FRAME_RX_EVENT;
+            Semaphore_post(appSem);
 #endif //ICALL_EVENTS
 
-                    break;
-                }
+            break;
+        }
 
 #if defined(NPI_SREQRSP)
-                case NPIMSG_Type_SYNCREQ:
-                {
-                    recPtr->npiMsg->msgType = NPIMSG_Type_SYNCREQ;
-                    Queue_put(npiSyncRxQueue, &recPtr->_elem);
+        case NPIMSG_Type_SYNCREQ:
+        {
+            recPtr->npiMsg->msgType = NPIMSG_Type_SYNCREQ;
+            Queue_put(npiSyncRxQueue, &recPtr->_elem);
 #ifdef ICALL_EVENTS
-                    EVENT_POST(syncEvent, NPITASK_SYNC_FRAME_RX_EVENT);
+            EVENT_POST(syncEvent, NPITASK_SYNC_FRAME_RX_EVENT);
 #else //!ICALL_EVENTS
-                    NPITask_events |= NPITASK_SYNC_FRAME_RX_EVENT;
-                    Semaphore_post(appSem);
+            NPITask_events |= NPITASK_SYNC_FRAME_RX_EVENT;
+            Semaphore_post(appSem);
 #endif //ICALL_EVENTS
 
-                    break;
-                }
+            break;
+        }
 #endif // NPI_SREQRSP
 
-                default:
-                {
-                    // undefined msgType
-                    ICall_free(npiMsgPtr);
-                    ICall_free(recPtr);
-                    ICall_freeMsg(pFrame);
-
-                    break;
-                }
-            }
-        }
-        else
+        default:
         {
-            // Malloc failed - release previous dynamic allocation
-            ICall_free(recPtr);
+            // undefined msgType
             ICall_freeMsg(pFrame);
+            NPITask_freeMsgContainer(npiMsgPtr);
+            if (npiMsgPtr != &recPtr->rxMsg)
+            {
+                NPITask_freeQueueRec(recPtr);
+            }
+
+            break;
         }
     }
-    else
-    {
-        ICall_freeMsg(pFrame);
-    }
 }
 
 // -----------------------------------------------------------------------------
@@ -1599,6 +1844,6 @@ void NPITask_freeNpiMsg(uint8_t *pMsg)
     }
 
     // Free the pMsg container
-    ICall_free(pMsg);
+    NPITask_freeMsgContainer((NPIMSG_msg_t *)pMsg);
   }
 }
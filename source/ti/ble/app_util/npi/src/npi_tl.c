@@ -468,6 +468,59 @@ uint16 NPITL_writeTL(uint8 *buf, uint16 len)
     return len;
 }
 
+// -----------------------------------------------------------------------------
+//! \brief      This routine writes several buffers to the transport layer
+//!             back to back in a single transfer.
+//!
+//! \param[in]  bufs - Pointers to the buffers to write data from.
+//! \param[in]  lens - Number of bytes to write from each buffer.
+//! \param[in]  num - Number of buffers.
+//!
+//! \return     uint16 - the number of bytes written to transport
+// -----------------------------------------------------------------------------
+uint16 NPITL_writeBatchTL(uint8 *bufs[], uint16 lens[], uint8 num)
+{
+    ICall_CSState key;
+    uint16 len;
+    uint8 i;
+    key = ICall_enterCriticalSection();
+
+    // Writes are atomic at transport layer
+    if ( NPITL_checkNpiBusy() )
+    {
+        ICall_leaveCriticalSection(key);
+        return 0;
+    }
+
+    // A batch is never fragmented, so the buffers can be released on return
+    npiTxBufLen = 0;
+    for ( i = 0; i < num; i++ )
+    {
+        if ( npiTxBufLen + lens[i] > NPI_MAX_FRAG_SIZE )
+        {
+            break;
+        }
+
+        memcpy(&npiTxBuf[npiTxBufLen], bufs[i], lens[i]);
+        npiTxBufLen += lens[i];
+    }
+
+    msgFrag = NULL;
+    msgFragLen = 0;
+    npiTxActive = TRUE;
+    txPktCount++;
+
+    len = transportWrite(npiTxBufLen);
+
+#if (NPI_FLOW_CTRL == 1)
+    SRDY_ENABLE();
+#endif // NPI_FLOW_CTRL = 1
+
+    ICall_leaveCriticalSection(key);
+
+    return len;
+}
+
 // -----------------------------------------------------------------------------
 //! \brief      This routine returns the max size receive buffer.
 //!
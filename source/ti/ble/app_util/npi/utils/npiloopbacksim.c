@@ -0,0 +1,672 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== npiloopbacksim.c ========
+ *
+ * Loopback simulation of the NPI task over UART.
+ *
+ * npi_task.c and npi_tl.c are built from the SDK sources. The UART, the
+ * frame module, the RX ring, ICall and the stack are replaced by models,
+ * and EventP_pend() runs a discrete event simulation of the line:
+ *
+ *  - the host sends frames of a fixed or random length, keeping up to a
+ *    window of frames outstanding
+ *  - the stack echoes each frame back twice in one response
+ *  - the host checks every response and its order
+ *
+ * Time is accounted with a cost model of a 2 Mbaud line, task wakeups,
+ * heap operations and transport transfers. The simulation checks that
+ * every frame is echoed, that nothing is written while a transfer is in
+ * flight, that all memory is returned, that the task itself allocates
+ * nothing per frame and that responses share transfers when the host
+ * keeps several frames outstanding. It then prints wakeups, heap and
+ * message operations and transfers per frame.
+ *
+ * Usage:
+ *
+ *     npiloopbacksim
+ */
+
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ti/ble/stack_util/icall/app/icall.h"
+#include "ti/ble/stack_util/comdef.h"
+#include "ti/ble/app_util/npi/npi_config.h"
+#include "ti/ble/app_util/npi/npi_frame.h"
+#include "ti/ble/app_util/npi/npi_rxbuf.h"
+#include "ti/ble/app_util/npi/npi_tl.h"
+#include "ti/ble/app_util/npi/npi_tl_uart.h"
+#include "ti/drivers/dpl/EventP.h"
+#include "Queue_freertos.h"
+
+extern void NPITask_task(void);
+extern ICall_EntityID npiAppEntityID;
+
+/* Cost model in us */
+#define US_PER_BYTE 5.0 /* 2 Mbaud, 10 bits per byte */
+#define WAKE_US     8.0 /* task switch and event dispatch */
+#define HEAP_US     1.5 /* one heap or message allocation or free */
+#define XFER_US     6.0 /* start of a UART transfer and its completion */
+
+#define SIM_QUEUE_LEN  1024
+#define SIM_QUEUES     4
+#define MAX_FRAME_LEN  250
+#define ICALL_MSG_EVT  0x1000
+
+#define CHECK(cond, ...)                                       \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            if (failures++ < 20)                               \
+            {                                                  \
+                printf("FAIL %s:%d: ", __FILE__, __LINE__);    \
+                printf(__VA_ARGS__);                           \
+                printf("\n");                                  \
+            }                                                  \
+        }                                                      \
+    } while (0)
+
+struct SimQueue
+{
+    void *items[SIM_QUEUE_LEN];
+    unsigned head;
+    unsigned tail;
+};
+
+/* Response of the stack: the payload of a frame, twice */
+typedef struct
+{
+    uint16_t len;
+    uint8_t data[];
+} StackMsg;
+
+static int failures;
+
+/* Simulated time and counters */
+static double now;
+static long wakeups;
+static long heapOps;
+static long msgOps;
+static long xfers;
+static long heapLive;
+static long msgLive;
+static jmp_buf simDone;
+
+/* Workload */
+static int nFrames;
+static int frameLen;
+static int window;
+static int sent;
+static int echoed;
+static int outstanding;
+static double hostArrive;
+static double hostLineFree;
+
+/* Bytes sent by the device and not yet parsed by the host */
+static uint8_t wire[1 << 16];
+static int wireLen;
+
+/* Queues of the NPI task, the stack and the NPI task's ICall mailbox */
+static struct SimQueue simQueues[SIM_QUEUES];
+static int simQueuesUsed;
+static struct SimQueue stackInbox;
+static struct SimQueue npiMailbox;
+static uint32_t pendingEvents;
+
+/* Frame parser state */
+static npiIncomingFrameCBack_t frameCBack;
+static uint8_t rxHdr[2];
+static int rxState;
+static uint8_t *rxFrame;
+static int rxPos;
+static int rxLen;
+
+/* RX ring, as in npi_rxbuf.c */
+static uint8_t ring[NPI_TL_BUF_SIZE];
+static unsigned ringHead;
+static unsigned ringTail;
+
+/* UART */
+static Char *uartRxBuf;
+static Char *uartTxBuf;
+static npiCB_t uartCBack;
+static int txInFlight;
+static double txDoneAt;
+
+static int lenOf(int seq)
+{
+    return (frameLen > 0 ? frameLen : (int)((seq * 7919U) % MAX_FRAME_LEN) + 1);
+}
+
+static void fill(uint8_t *buf, int seq, int len)
+{
+    int i;
+
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = (uint8_t)(seq * 7 + i);
+    }
+}
+
+/* ======== ICall ======== */
+
+static ICall_CSState simEnterCS(void)
+{
+    return (0);
+}
+
+static void simLeaveCS(ICall_CSState key)
+{
+}
+
+ICall_EnterCS ICall_enterCriticalSection = simEnterCS;
+ICall_LeaveCS ICall_leaveCriticalSection = simLeaveCS;
+
+void *ICall_malloc(uint_least16_t size)
+{
+    heapOps++;
+    heapLive++;
+    now += HEAP_US;
+    return (malloc(size));
+}
+
+void *ICall_mallocLimited(uint_least16_t size)
+{
+    return (ICall_malloc(size));
+}
+
+void ICall_free(void *msg)
+{
+    if (msg != NULL)
+    {
+        heapOps++;
+        heapLive--;
+        now += HEAP_US;
+        free(msg);
+    }
+}
+
+void *ICall_allocMsg(size_t size)
+{
+    msgOps++;
+    msgLive++;
+    now += HEAP_US;
+    return (malloc(size));
+}
+
+void *ICall_allocMsgLimited(size_t size)
+{
+    return (ICall_allocMsg(size));
+}
+
+void ICall_freeMsg(void *msg)
+{
+    if (msg != NULL)
+    {
+        msgOps++;
+        msgLive--;
+        now += HEAP_US;
+        free(msg);
+    }
+}
+
+ICall_Errno ICall_enrollService(ICall_ServiceEnum service,
+                                ICall_ServiceFunc fn,
+                                ICall_EntityID *entity,
+                                ICall_SyncHandle *msgSyncHdl)
+{
+    *entity = 5;
+    *msgSyncHdl = NULL;
+    return (ICALL_ERRNO_SUCCESS);
+}
+
+ICall_Errno ICall_sendServiceMsg(ICall_EntityID src,
+                                 ICall_ServiceEnum dest,
+                                 ICall_MSGFormat format,
+                                 void *msg)
+{
+    Queue_enqueue(&stackInbox, (char *)&msg);
+    return (ICALL_ERRNO_SUCCESS);
+}
+
+ICall_Errno ICall_fetchServiceMsg(ICall_ServiceEnum *src,
+                                  ICall_EntityID *dest,
+                                  void **msg)
+{
+    void *m = Queue_dequeue(&npiMailbox);
+
+    if (m == NULL)
+    {
+        return (ICALL_ERRNO_NOMSG);
+    }
+
+    *src = 1;
+    *dest = npiAppEntityID;
+    *msg = m;
+    return (ICALL_ERRNO_SUCCESS);
+}
+
+/* ======== Queues ======== */
+
+QueueHandle_t Queue_create(unsigned len, unsigned size)
+{
+    struct SimQueue *queue = &simQueues[simQueuesUsed++];
+
+    queue->head = 0;
+    queue->tail = 0;
+    return (queue);
+}
+
+int Queue_enqueue(QueueHandle_t queue, char *pItem)
+{
+    if (queue->tail - queue->head == SIM_QUEUE_LEN)
+    {
+        return (FAILURE);
+    }
+
+    queue->items[queue->tail++ % SIM_QUEUE_LEN] = *(void **)pItem;
+    return (SUCCESS);
+}
+
+void *Queue_dequeue(QueueHandle_t queue)
+{
+    if (queue->head == queue->tail)
+    {
+        return (NULL);
+    }
+
+    return (queue->items[queue->head++ % SIM_QUEUE_LEN]);
+}
+
+bool Queue_empty(QueueHandle_t queue)
+{
+    return (queue->head == queue->tail);
+}
+
+/* ======== Stack ======== */
+
+/* Echo every frame received from the NPI task, returns the frame count */
+static int runStack(void)
+{
+    int n = 0;
+    uint8_t *frame;
+    StackMsg *rsp;
+    uint16_t len;
+
+    while ((frame = Queue_dequeue(&stackInbox)) != NULL)
+    {
+        /* Frame buffer: length low, length high, payload */
+        len = frame[0] | frame[1] << 8;
+        rsp = ICall_allocMsg(sizeof(StackMsg) + 2 * len);
+        rsp->len = 2 * len;
+        memcpy(rsp->data, frame + 2, len);
+        memcpy(rsp->data + len, frame + 2, len);
+        ICall_freeMsg(frame);
+        Queue_enqueue(&npiMailbox, (char *)&rsp);
+        n++;
+    }
+
+    if (n > 0)
+    {
+        pendingEvents |= ICALL_MSG_EVT;
+    }
+
+    return (n);
+}
+
+/* ======== Frame module ======== */
+
+void NPIFrame_initialize(npiIncomingFrameCBack_t incomingFrameCB)
+{
+    frameCBack = incomingFrameCB;
+}
+
+NPIMSG_msg_t *NPIFrame_frameMsg(uint8_t *pMsg)
+{
+    StackMsg *rsp = (StackMsg *)pMsg;
+    NPIMSG_msg_t *npiMsg = ICall_mallocLimited(sizeof(NPIMSG_msg_t));
+
+    npiMsg->msgType = NPIMSG_Type_ASYNC;
+    npiMsg->pBuf = ICall_allocMsgLimited(rsp->len + 2);
+    npiMsg->pBufSize = rsp->len + 2;
+    npiMsg->pBuf[0] = rsp->len;
+    npiMsg->pBuf[1] = rsp->len >> 8;
+    memcpy(npiMsg->pBuf + 2, rsp->data, rsp->len);
+    ICall_freeMsg(pMsg);
+    return (npiMsg);
+}
+
+uint8_t *NPIFrame_createNpiPkt(uint8_t *pMsg)
+{
+    return (pMsg);
+}
+
+void NPIFrame_collectFrameData(void)
+{
+    uint8_t ch;
+
+    while (NPIRxBuf_GetRxBufCount() > 0)
+    {
+        NPIRxBuf_ReadFromRxBuf(&ch, 1);
+        if (rxState < 2)
+        {
+            rxHdr[rxState++] = ch;
+            if (rxState == 2)
+            {
+                rxLen = rxHdr[0] | rxHdr[1] << 8;
+                rxFrame = ICall_allocMsg(rxLen + 2);
+                memcpy(rxFrame, rxHdr, 2);
+                rxPos = 0;
+            }
+        }
+        else
+        {
+            rxFrame[2 + rxPos++] = ch;
+        }
+
+        if (rxState == 2 && rxPos == rxLen)
+        {
+            rxState = 0;
+            frameCBack(rxLen + 2, rxFrame, NPIMSG_Type_ASYNC);
+        }
+    }
+}
+
+/* ======== RX ring ======== */
+
+uint16 NPIRxBuf_Read(uint16 len)
+{
+    uint8_t buf[NPI_TL_BUF_SIZE];
+    uint16 n = NPITL_readTL(buf, len);
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        ring[ringTail++ % NPI_TL_BUF_SIZE] = buf[i];
+    }
+
+    return (n);
+}
+
+uint16 NPIRxBuf_GetRxBufCount(void)
+{
+    return (ringTail - ringHead);
+}
+
+uint16 NPIRxBuf_GetRxBufAvail(void)
+{
+    return (NPI_TL_BUF_SIZE - (ringTail - ringHead));
+}
+
+uint16 NPIRxBuf_ReadFromRxBuf(uint8_t *buf, uint16 len)
+{
+    int i;
+
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = ring[ringHead++ % NPI_TL_BUF_SIZE];
+    }
+
+    return (len);
+}
+
+/* ======== UART ======== */
+
+void NPITLUART_initializeTransport(Char *tRxBuf, Char *tTxBuf, npiCB_t npiCBack)
+{
+    uartRxBuf = tRxBuf;
+    uartTxBuf = tTxBuf;
+    uartCBack = npiCBack;
+}
+
+void NPITLUART_readTransport(void)
+{
+}
+
+void NPITLUART_stopTransfer(void)
+{
+}
+
+void NPITLUART_handleMrdyEvent(void)
+{
+}
+
+uint16 NPITLUART_writeTransport(uint16 len)
+{
+    CHECK(txInFlight == 0, "write of %d bytes while %d are in flight", len, txInFlight);
+    CHECK(wireLen + len <= (int)sizeof(wire), "host fell behind");
+
+    memcpy(wire + wireLen, uartTxBuf, len);
+    wireLen += len;
+    txInFlight = len;
+    xfers++;
+    now += XFER_US;
+    txDoneAt = now + len * US_PER_BYTE;
+    return (len);
+}
+
+/* Parse and check the responses the host has received */
+static void hostParse(void)
+{
+    uint8_t expected[2 * MAX_FRAME_LEN];
+    int pos = 0;
+    int len;
+    int l;
+
+    while (wireLen - pos >= 2)
+    {
+        len = wire[pos] | wire[pos + 1] << 8;
+        if (wireLen - pos < 2 + len)
+        {
+            break;
+        }
+
+        l = lenOf(echoed);
+        fill(expected, echoed, l);
+        memcpy(expected + l, expected, l);
+        CHECK(len == 2 * l && memcmp(wire + pos + 2, expected, len) == 0,
+              "bad response to frame %d", echoed);
+
+        echoed++;
+        outstanding--;
+        pos += 2 + len;
+    }
+
+    memmove(wire, wire + pos, wireLen - pos);
+    wireLen -= pos;
+}
+
+/* ======== Events ======== */
+
+void EventP_post(EventP_Handle event, uint32_t eventMask)
+{
+    pendingEvents |= eventMask;
+}
+
+/*
+ *  ======== EventP_pend ========
+ *  Advance the simulation until one of the events is posted. Returns to
+ *  main() once all frames have been echoed and the line is idle.
+ */
+uint32_t EventP_pend(EventP_Handle event, uint32_t eventMask, bool waitForAll, uint32_t timeout)
+{
+    uint32_t events;
+    double next;
+    int len;
+
+    for (;;)
+    {
+        if (runStack() > 0)
+        {
+            continue;
+        }
+
+        if (txInFlight != 0 && txDoneAt <= now)
+        {
+            len = txInFlight;
+            txInFlight = 0;
+            hostParse();
+            uartCBack(0, len);
+            continue;
+        }
+
+        if (hostArrive < 0 && sent < nFrames && outstanding < window)
+        {
+            /* The host starts sending the next frame */
+            hostArrive = (hostLineFree > now ? hostLineFree : now) + (lenOf(sent) + 2) * US_PER_BYTE;
+            hostLineFree = hostArrive;
+        }
+
+        if (hostArrive >= 0 && hostArrive <= now)
+        {
+            len = lenOf(sent);
+            uartRxBuf[0] = len;
+            uartRxBuf[1] = len >> 8;
+            fill((uint8_t *)uartRxBuf + 2, sent, len);
+            sent++;
+            outstanding++;
+            hostArrive = -1;
+            uartCBack(len + 2, 0);
+            continue;
+        }
+
+        if ((pendingEvents & eventMask) != 0)
+        {
+            break;
+        }
+
+        /* Idle until the next event on the line */
+        next = -1;
+        if (txInFlight != 0)
+        {
+            next = txDoneAt;
+        }
+        if (hostArrive >= 0 && (next < 0 || hostArrive < next))
+        {
+            next = hostArrive;
+        }
+        if (next < 0)
+        {
+            longjmp(simDone, 1);
+        }
+        now = next;
+    }
+
+    events = pendingEvents & eventMask;
+    pendingEvents &= ~eventMask;
+    wakeups++;
+    now += WAKE_US;
+    return (events);
+}
+
+/* Run NPITask_task() for n frames of the given length, 0 for random */
+static void run(int n, int len, int win)
+{
+    nFrames = n;
+    frameLen = len;
+    window = win;
+
+    now = 0;
+    wakeups = heapOps = msgOps = xfers = 0;
+    sent = echoed = outstanding = 0;
+    hostArrive = -1;
+    hostLineFree = 0;
+    wireLen = 0;
+    simQueuesUsed = 0;
+    pendingEvents = 0;
+    rxState = 0;
+    txInFlight = 0;
+
+    if (setjmp(simDone) == 0)
+    {
+        NPITask_task();
+    }
+
+    CHECK(echoed == nFrames, "%d of %d frames echoed, length %d, window %d",
+          echoed, nFrames, len, win);
+    CHECK(heapLive == 0, "%ld heap blocks not freed", heapLive);
+    CHECK(msgLive == 0, "%ld messages not freed", msgLive);
+}
+
+int main(int argc, char *argv[])
+{
+    static const int lengths[] = {8, 27, 64, 120};
+    static const int windows[] = {1, 8};
+    int w;
+    int l;
+
+    /* Random lengths, responses up to the size of the TX buffer */
+    for (w = 1; w <= 64; w *= 4)
+    {
+        run(3000, 0, w);
+    }
+
+    printf("%-5s %-4s %6s | %8s %8s %8s %8s | %9s %8s\n", "len", "win", "frames",
+           "wake/fr", "heap/fr", "msg/fr", "xfer/fr", "us/frame", "KB/s");
+
+    for (w = 0; w < 2; w++)
+    {
+        for (l = 0; l < 4; l++)
+        {
+            run(4000, lengths[l], windows[w]);
+
+            /* Only the frame module's container is allocated per frame */
+            CHECK(heapOps <= 2 * nFrames, "%.2f heap operations per frame",
+                  (double)heapOps / nFrames);
+            if (windows[w] > 1)
+            {
+                CHECK(xfers < nFrames, "no transfers shared, length %d", frameLen);
+            }
+
+            printf("%-5d %-4d %6d | %8.2f %8.2f %8.2f %8.2f | %9.1f %8.1f\n",
+                   frameLen, window, nFrames,
+                   (double)wakeups / nFrames, (double)heapOps / nFrames,
+                   (double)msgOps / nFrames, (double)xfers / nFrames,
+                   now / nFrames, 3.0 * nFrames * (frameLen + 2) / now * 1e6 / 1024);
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("checks passed\n");
+    }
+    else
+    {
+        printf("%d failures\n", failures);
+    }
+
+    return (failures != 0);
+}
@@ -279,6 +279,21 @@ bStatus_t gapBondMgr_FindAddr(uint8_t *pDevAddr,
                               GAP_Peer_Addr_Types_t *pIdentityAddrType,
                               uint8_t *pIdentityAddr);
 
+/**
+ * @brief  Resolve a random private resolvable address against the IRKs of all
+ * bonds in one pass. The IRKs are kept in RAM, byte reversed for the
+ * controller, so no NV is read. Addresses resolved within the last
+ * @ref GAP_PARAM_PRIVATE_ADDR_INT are remembered (up to
+ * GAPBOND_RPA_CACHE_SIZE of them) and found without running any IRK.
+ *
+ * @param pRpa peer's random private resolvable address
+ * @param pIdx pointer to byte to put the bond index if resolved
+ *
+ * @return SUCCESS if the address resolved to a bond
+ * @return bleGAPNotFound if the address didn't resolve to any bond
+ */
+bStatus_t gapBondMgr_ResolveRPA(uint8_t *pRpa, uint8_t *pIdx);
+
 /**
  * Get a GAP Bond Manager parameter.
  *
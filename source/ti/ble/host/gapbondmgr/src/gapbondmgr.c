@@ -119,6 +119,13 @@
 // Secure Connections minimum MTU size
 #define SECURECONNECTION_MIN_MTU_SIZE                   65
 
+// Number of recently resolved private addresses remembered, so that
+// advertising reports from the same peer don't run the IRKs of all bonds
+// again. 0 disables the cache.
+#ifndef GAPBOND_RPA_CACHE_SIZE
+#define GAPBOND_RPA_CACHE_SIZE                          8
+#endif
+
 // Central Device should only contain one Central Address Resolution
 // Characteristic
 #define NUM_CENT_ADDR_RES_CHAR                          1
@@ -175,6 +182,23 @@ typedef struct gapBondStateQueueNode
 
 typedef gapBondStateNode_t *gapBondStateNodePtr_t;
 
+// RAM copy of a bond's IRK, byte reversed as the controller expects it
+typedef struct
+{
+  uint8_t irk[KEYLEN];
+  uint8_t valid;              // TRUE if the bond has an IRK to resolve with
+} gapBondIrk_t;
+
+#if ( GAPBOND_RPA_CACHE_SIZE > 0 )
+// Recently resolved private address
+typedef struct
+{
+  uint8_t  addr[B_ADDR_LEN];
+  uint8_t  idx;               // bond index, gapBond_maxBonds if unused
+  uint32_t timestamp;         // system clock (ms) when resolved
+} gapBondRpaCacheItem_t;
+#endif // GAPBOND_RPA_CACHE_SIZE > 0
+
 /*********************************************************************
  * GLOBAL VARIABLES
  */
@@ -292,6 +316,14 @@ static const gapBondCBs_t *pGapBondCB = NULL;
 // Local RAM shadowed bond records
 static gapBondRec_t *bonds = NULL;      //will hold gapBond_maxBonds elements
 
+// Local RAM shadowed bond IRKs
+static gapBondIrk_t *bondIrks = NULL;   //will hold gapBond_maxBonds elements
+
+#if ( GAPBOND_RPA_CACHE_SIZE > 0 )
+// Recently resolved private addresses
+static gapBondRpaCacheItem_t gapBond_rpaCache[GAPBOND_RPA_CACHE_SIZE];
+#endif // GAPBOND_RPA_CACHE_SIZE > 0
+
 static uint8_t autoSyncAcceptList = FALSE;
 
 static uint8_t eraseAllBonds = FALSE;
@@ -342,6 +374,8 @@ static uint8_t gapBondMgrReadBondInfo(uint8_t idx,
 static uint8_t gapBondMgrGetStateFlags(uint8_t idx);
 
 static void gapBondMgrReadBonds(void);
+static void gapBondMgrSetIrk(uint8_t idx, uint8_t *pIRK);
+static void gapBondMgrFlushRpaCache(uint8_t idx);
 static uint8_t gapBondMgrFindEmpty(void);
 static uint8_t gapBondMgrBondTotal(void);
 static bStatus_t gapBondMgrEraseAllBondings(void);
@@ -1234,43 +1268,99 @@ bStatus_t gapBondMgr_FindAddr(uint8_t *pDevAddr,
       }
       return (SUCCESS);
     }
-    // The public address in the bonding table could be an identity address if we
-    // received the identity information during pairing so try to resolve the
-    // address if it is random private resolvable.
-    if ((addrType == PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID) && (GAP_IS_ADDR_RPR(pDevAddr)))
+  }
+
+  // The public address in the bonding table could be an identity address if we
+  // received the identity information during pairing so try to resolve the
+  // address if it is random private resolvable.
+  if ((addrType == PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID) && (GAP_IS_ADDR_RPR(pDevAddr)) &&
+      (gapBondMgr_ResolveRPA(pDevAddr, &idx) == SUCCESS))
+  {
+    // Set output params
+    if(pIdx != NULL)
     {
-      // Read the IRK from NV
-      uint8_t tempIRK[KEYLEN];
-      osal_snv_read(DEV_IRK_NV_ID(idx), KEYLEN, tempIRK);
+      *pIdx = idx;
+    }
 
-      // Reverse it (in place) to pass to controller
-      MAP_LL_ENC_ReverseBytes(tempIRK, KEYLEN);
+    if (pIdentityAddrType != NULL)
+    {
+      *pIdentityAddrType = bonds[idx].addrType;
+    }
 
-      // check if the RPA resolves against the IRK read from the bond
-      if(MAP_LL_PRIV_ResolveRPA(pDevAddr, tempIRK) == TRUE)
-      {
-        // Set output params
-        if(pIdx != NULL)
-        {
-          *pIdx = idx;
-        }
+    if (pIdentityAddr != NULL)
+    {
+      MAP_osal_memcpy(pIdentityAddr, bonds[idx].addr, B_ADDR_LEN);
+    }
 
-        if (pIdentityAddrType != NULL)
-        {
-          *pIdentityAddrType = bonds[idx].addrType;
-        }
+    return (SUCCESS);
+  }
 
-        if (pIdentityAddr != NULL)
-        {
-          MAP_osal_memcpy(pIdentityAddr, bonds[idx].addr, B_ADDR_LEN);
-        }
+  // The address wasn't found in the bonding table if we get here
+  return (bleGAPNotFound);
+}
 
-        return (SUCCESS);
-      }
+/*********************************************************************
+ * @brief   Resolve a private address against the IRKs of all bonds.
+ *
+ * Public function defined in gapbondmgr_internal.h.
+ */
+bStatus_t gapBondMgr_ResolveRPA(uint8_t *pRpa, uint8_t *pIdx)
+{
+  uint8_t idx;
+#if ( GAPBOND_RPA_CACHE_SIZE > 0 )
+  uint32_t now = osal_GetSystemClock();
+  uint32_t timeout = (uint32_t)MAP_GAP_GetParamValue(GAP_PARAM_PRIVATE_ADDR_INT) * 60000;
+  uint32_t oldestAge = 0;
+  uint8_t i, replace = 0;
+
+  // A peer moves on to a new address once its private address interval has
+  // elapsed, so older entries are only taking up space
+  for(i = 0; i < GAPBOND_RPA_CACHE_SIZE; i++)
+  {
+    gapBondRpaCacheItem_t *pItem = &gapBond_rpaCache[i];
+    uint32_t age = now - pItem->timestamp;
+
+    if((pItem->idx < gapBond_maxBonds) && (age >= timeout))
+    {
+      pItem->idx = gapBond_maxBonds;
+    }
+
+    if(pItem->idx >= gapBond_maxBonds)
+    {
+      // Prefer an unused entry for the address if it has to be added
+      age = UINT32_MAX;
+    }
+    else if(MAP_osal_memcmp(pItem->addr, pRpa, B_ADDR_LEN))
+    {
+      *pIdx = pItem->idx;
+      return (SUCCESS);
+    }
+
+    if(age >= oldestAge)
+    {
+      oldestAge = age;
+      replace = i;
+    }
+  }
+#endif // GAPBOND_RPA_CACHE_SIZE > 0
+
+  for(idx = 0; idx < gapBond_maxBonds; idx++)
+  {
+    // check if the RPA resolves against the IRK of the bond
+    if((bondIrks[idx].valid == TRUE) &&
+       (MAP_LL_PRIV_ResolveRPA(pRpa, bondIrks[idx].irk) == TRUE))
+    {
+#if ( GAPBOND_RPA_CACHE_SIZE > 0 )
+      MAP_osal_memcpy(gapBond_rpaCache[replace].addr, pRpa, B_ADDR_LEN);
+      gapBond_rpaCache[replace].idx = idx;
+      gapBond_rpaCache[replace].timestamp = now;
+#endif // GAPBOND_RPA_CACHE_SIZE > 0
+
+      *pIdx = idx;
+      return (SUCCESS);
     }
   }
 
-  // The address wasn't found in the bonding table if we get here
   return (bleGAPNotFound);
 }
 
@@ -2603,9 +2693,13 @@ static uint8_t gapBondMgrSaveBond(uint8_t bondIdx,
 
       // If available, save the connected device's IRK
       snvErrorCode |= osal_snv_write(DEV_IRK_NV_ID(bondIdx), KEYLEN, pIRK);
+      gapBondMgrSetIrk(bondIdx, pIRK);
     }
   }
 
+  // Addresses resolved to a previous bond at this index are stale
+  gapBondMgrFlushRpaCache(bondIdx);
+
   // If available, save the LTK information
   if(pLocalLtk)
   {
@@ -3191,6 +3285,8 @@ static void gapBondMgrReadBonds(void)
 
   for(idx = 0; idx < gapBond_maxBonds; idx++)
   {
+    uint8_t irk[KEYLEN];
+
     // See if the entry exists in NV
     if(osal_snv_read(MAIN_RECORD_NV_ID(idx), sizeof(gapBondRec_t),
        &(bonds[idx])) != SUCCESS)
@@ -3199,14 +3295,81 @@ static void gapBondMgrReadBonds(void)
       VOID MAP_osal_memset(bonds[idx].addr, 0xFF, B_ADDR_LEN);
       bonds[idx].stateFlags = 0;
     }
+
+    // Keep the IRK in RAM for resolving addresses
+    if((MAP_osal_isbufset(bonds[idx].addr, 0xFF, B_ADDR_LEN) == FALSE) &&
+       (osal_snv_read(DEV_IRK_NV_ID(idx), KEYLEN, irk) == SUCCESS))
+    {
+      gapBondMgrSetIrk(idx, irk);
+    }
+    else
+    {
+      gapBondMgrSetIrk(idx, NULL);
+    }
   }
 
+  gapBondMgrFlushRpaCache(gapBond_maxBonds);
+
   if(autoSyncAcceptList)
   {
     gapBondMgr_SyncAcceptList();
   }
 }
 
+/*********************************************************************
+ * @fn      gapBondMgrSetIrk
+ *
+ * @brief   Update the RAM copy of the IRK of a bond.
+ *
+ * @param   idx - bond index
+ * @param   pIRK - IRK as stored in NV, or NULL if the bond has none
+ *
+ * @return  none
+ */
+static void gapBondMgrSetIrk(uint8_t idx, uint8_t *pIRK)
+{
+  // All 0xFF's is an erased IRK and all zeros is an identity address
+  // without one, neither can resolve an address
+  if((pIRK != NULL) &&
+     (MAP_osal_isbufset(pIRK, 0xFF, KEYLEN) == FALSE) &&
+     (MAP_osal_isbufset(pIRK, 0x00, KEYLEN) == FALSE))
+  {
+    VOID MAP_osal_memcpy(bondIrks[idx].irk, pIRK, KEYLEN);
+
+    // Reverse it (in place) to pass to controller
+    MAP_LL_ENC_ReverseBytes(bondIrks[idx].irk, KEYLEN);
+    bondIrks[idx].valid = TRUE;
+  }
+  else
+  {
+    bondIrks[idx].valid = FALSE;
+  }
+}
+
+/*********************************************************************
+ * @fn      gapBondMgrFlushRpaCache
+ *
+ * @brief   Forget the private addresses resolved to a bond.
+ *
+ * @param   idx - bond index, gapBond_maxBonds for all bonds
+ *
+ * @return  none
+ */
+static void gapBondMgrFlushRpaCache(uint8_t idx)
+{
+#if ( GAPBOND_RPA_CACHE_SIZE > 0 )
+  uint8_t i;
+
+  for(i = 0; i < GAPBOND_RPA_CACHE_SIZE; i++)
+  {
+    if((idx == gapBond_maxBonds) || (gapBond_rpaCache[i].idx == idx))
+    {
+      gapBond_rpaCache[i].idx = gapBond_maxBonds;
+    }
+  }
+#endif // GAPBOND_RPA_CACHE_SIZE > 0
+}
+
 /*********************************************************************
  * @fn      gapBondMgrReadLruBondList
  *
@@ -3443,6 +3606,10 @@ static bStatus_t gapBondMgrEraseBonding(uint8_t idx)
     // Write out FF's over the characteristic configuration entry.
     ret |= osal_snv_write(GATT_CFG_NV_ID(idx), sizeof(gapBondCharCfg_t) * gapBond_maxCharCfg, charCfg);
     MAP_osal_mem_free( charCfg );
+
+    // Addresses can no longer be resolved to this bond
+    gapBondMgrSetIrk(idx, NULL);
+    gapBondMgrFlushRpaCache(idx);
   }
   else
   {
@@ -3537,6 +3704,18 @@ void GAPBondMgr_Init(uint8_t task_id, uint8_t cfg_gapBond_maxBonds, uint8_t cfg_
   }
   MAP_osal_memset(gapBond_lruBondList, 0, sizeof (uint8_t) * gapBond_maxBonds);
 
+  //static gapBondIrk_t bondIrks[GAP_BONDINGS_MAX] = {0};
+  bondIrks = (gapBondIrk_t *)MAP_osal_mem_alloc( sizeof (gapBondIrk_t) * gapBond_maxBonds );
+  if (bondIrks == NULL)
+  {
+    MAP_osal_mem_free(bonds);
+    MAP_osal_mem_free(bondsToDelete);
+    MAP_osal_mem_free(gapBond_lruBondList);
+    HAL_ASSERT( HAL_ASSERT_CAUSE_OUT_OF_MEMORY );
+    return;
+  }
+  MAP_osal_memset(bondIrks, 0, sizeof (gapBondIrk_t) * gapBond_maxBonds);
+
   // Register Call Back functions for GAP
   MAP_GAP_RegisterBondMgrCBs(&gapCBs);
 
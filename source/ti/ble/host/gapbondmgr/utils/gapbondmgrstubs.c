@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== gapbondmgrstubs.c ========
+ *
+ * GAP, GATT, SM, HCI, link database and OSAL functions referenced by
+ * gapbondmgr.c that gapbondmgrtest does not model.  They are defined in
+ * a separate file since their prototypes do not matter here.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+
+/* Called while bonds are registered, saved and erased */
+#define SUCCEEDS(name) int name(void) { return (0); }
+
+/* Not reached by gapbondmgrtest */
+#define NOT_USED(name) void name(void) { abort(); }
+
+SUCCEEDS(GAP_RegisterBondMgrCBs)
+SUCCEEDS(GAP_SetParamValue)
+SUCCEEDS(GATT_RegisterClientSecurityCBs)
+SUCCEEDS(HCI_LE_AddDeviceToResolvingListCmd)
+SUCCEEDS(HCI_LE_RemoveDeviceFromResolvingListCmd)
+
+NOT_USED(GAP_Authenticate)
+NOT_USED(GAP_Bond)
+NOT_USED(GAP_GetDevAddress)
+NOT_USED(GAP_GetIRK)
+NOT_USED(GAP_NumActiveConnections)
+NOT_USED(GAP_PasscodeUpdate)
+NOT_USED(GAP_SendPeripheralSecurityRequest)
+NOT_USED(GAP_Signable)
+NOT_USED(GAP_TerminateAuth)
+NOT_USED(GAP_TerminateLinkReq)
+NOT_USED(GAP_isPairing)
+NOT_USED(GATTServApp_ReadAttr)
+NOT_USED(GATTServApp_RegisterForMsg)
+NOT_USED(GATTServApp_SendServiceChangedInd)
+NOT_USED(GATTServApp_UpdateCharCfg)
+NOT_USED(GATT_FindHandleUUID)
+NOT_USED(GATT_FindNextAttr)
+NOT_USED(GATT_ReadUsingCharUUID)
+NOT_USED(GATT_RequestNextTransaction)
+NOT_USED(GATT_bm_free)
+NOT_USED(GapConfig_SetParameter)
+NOT_USED(HCI_LE_AddAcceptListCmd)
+NOT_USED(HCI_LE_ClearAcceptListCmd)
+NOT_USED(HCI_LE_ClearResolvingListCmd)
+NOT_USED(HCI_LE_SetPrivacyModeCmd)
+NOT_USED(L2CAP_GetMTU)
+NOT_USED(LL_PRIV_FindPeerInRL)
+NOT_USED(OPT_gapBondMgr_GetParameter)
+NOT_USED(OPT_gapBondMgr_Pair)
+NOT_USED(OPT_gapBondMgr_PasscodeRsp)
+NOT_USED(OPT_gapBondMgr_Register)
+NOT_USED(OPT_gapBondMgr_SCGetLocalOOBParameters)
+NOT_USED(OPT_gapBondMgr_SCSetRemoteOOBParameters)
+NOT_USED(OPT_gapBondMgr_ServiceChangeInd)
+NOT_USED(SM_GenerateRandBuf)
+NOT_USED(SM_GetEccKeys)
+NOT_USED(SM_GetScConfirmOob)
+NOT_USED(SM_RegisterTask)
+NOT_USED(SM_SetAllowDebugKeysMode)
+NOT_USED(SM_SetAuthenPairingOnlyMode)
+NOT_USED(SM_SetECCRegenerationCount)
+NOT_USED(gapGetDevAddressMode)
+NOT_USED(gapGetSRK)
+NOT_USED(linkDB_Find)
+NOT_USED(linkDB_GetInfo)
+NOT_USED(linkDB_PerformFunc)
+NOT_USED(linkDB_SecurityModeSCOnly)
+NOT_USED(osal_msg_deallocate)
+NOT_USED(osal_msg_receive)
+NOT_USED(osal_msg_send)
+NOT_USED(osal_set_event)
+NOT_USED(osal_snv_compact)
+
+const uint8_t clientCharCfgUUID[2] = {0x02, 0x29};
+uint8_t gapEndAppTaskID = 0xFF;
+uint8_t gapState;
+void *resolvingList;
+uint8_t rlSize;
@@ -0,0 +1,667 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== gapbondmgrtest.c ========
+ *
+ * Check and benchmark of the resolution of private addresses against the
+ * bonds of the GAP bond manager.
+ *
+ * gapbondmgr.c is included from the SDK sources, with NV modelled as an
+ * array of records and a software AES-128 behind LL_PRIV_ResolveRPA().
+ * Bonds are registered by GAPBondMgr_Init() from NV, then:
+ *
+ *  - the AES and the whole resolution path are checked against the ah()
+ *    sample data of the Bluetooth Core Specification
+ *  - gapBondMgr_FindAddr() is compared with the previous lookup, which
+ *    read and ran the IRK of every bond from NV, for identity addresses,
+ *    addresses of bonded peers and unbonded addresses; bonds without an
+ *    IRK and with an erased IRK must never resolve
+ *  - gapBondMgr_FindAddr() must not read NV
+ *  - with GAPBOND_RPA_CACHE_SIZE > 0, a resolved address costs no AES
+ *    until GAP_PARAM_PRIVATE_ADDR_INT has elapsed, and saving or erasing a
+ *    bond forgets the addresses resolved to it
+ *
+ * The benchmark prints NV reads, AES operations and time per lookup for
+ * the previous lookup and for gapBondMgr_FindAddr(), with 8 and 32 bonds,
+ * for peers that are bonded, that are not, and a mix of both.
+ *
+ * Usage:
+ *
+ *     gapbondmgrtest [lookups]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../src/gapbondmgr.c"
+
+#define MAX_BONDS  32
+#define NV_IDS     0x400
+#define NV_MAX_LEN 64
+
+/* Private address interval in minutes */
+#define PRIVATE_ADDR_INT 15
+
+#define CHECK(cond, ...)                                       \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            if (failures++ < 20)                               \
+            {                                                  \
+                printf("FAIL %s:%d: ", __FILE__, __LINE__);    \
+                printf(__VA_ARGS__);                           \
+                printf("\n");                                  \
+            }                                                  \
+        }                                                      \
+    } while (0)
+
+static int failures;
+static uint32_t randomState = 1;
+
+/* NV model */
+static uint8 nvData[NV_IDS][NV_MAX_LEN];
+static uint8 nvLen[NV_IDS];
+static long nvReads;
+
+static long aesOps;
+static uint32 clockMs;
+
+/* IRKs of the bonds as stored in NV */
+static uint8 bondIrk[MAX_BONDS][KEYLEN];
+
+static uint8 randomByte(void)
+{
+    randomState = randomState * 1103515245U + 12345U;
+    return (randomState >> 16);
+}
+
+/* ======== AES-128 ======== */
+
+static const uint8 sbox[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76, 0xca, 0x82, 0xc9,
+    0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0, 0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f,
+    0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15, 0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07,
+    0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75, 0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3,
+    0x29, 0xe3, 0x2f, 0x84, 0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58,
+    0xcf, 0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8, 0x51, 0xa3,
+    0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2, 0xcd, 0x0c, 0x13, 0xec, 0x5f,
+    0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73, 0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88,
+    0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb, 0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac,
+    0x62, 0x91, 0x95, 0xe4, 0x79, 0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a,
+    0xae, 0x08, 0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a, 0x70,
+    0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e, 0xe1, 0xf8, 0x98, 0x11,
+    0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf, 0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42,
+    0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16};
+
+static uint8 xtime(uint8 x)
+{
+    return ((x << 1) ^ ((x & 0x80) ? 0x1b : 0x00));
+}
+
+/* Encrypt one block, key and data in the byte order of FIPS-197 */
+static void aesEncrypt(const uint8 *key, const uint8 *in, uint8 *out)
+{
+    uint8 roundKey[16];
+    uint8 state[16];
+    uint8 rcon = 1;
+
+    memcpy(roundKey, key, 16);
+    for (int i = 0; i < 16; i++)
+    {
+        state[i] = in[i] ^ roundKey[i];
+    }
+
+    for (int round = 1; round <= 10; round++)
+    {
+        uint8 tmp[16];
+
+        /* SubBytes and ShiftRows */
+        for (int c = 0; c < 4; c++)
+        {
+            for (int r = 0; r < 4; r++)
+            {
+                tmp[4 * c + r] = sbox[state[4 * ((c + r) % 4) + r]];
+            }
+        }
+
+        /* MixColumns, except in the last round */
+        for (int c = 0; c < 4; c++)
+        {
+            uint8 *col = &tmp[4 * c];
+
+            if (round < 10)
+            {
+                uint8 all = col[0] ^ col[1] ^ col[2] ^ col[3];
+                uint8 first = col[0];
+
+                col[0] ^= all ^ xtime(col[0] ^ col[1]);
+                col[1] ^= all ^ xtime(col[1] ^ col[2]);
+                col[2] ^= all ^ xtime(col[2] ^ col[3]);
+                col[3] ^= all ^ xtime(col[3] ^ first);
+            }
+        }
+
+        /* Next round key */
+        roundKey[0] ^= sbox[roundKey[13]] ^ rcon;
+        roundKey[1] ^= sbox[roundKey[14]];
+        roundKey[2] ^= sbox[roundKey[15]];
+        roundKey[3] ^= sbox[roundKey[12]];
+        for (int i = 4; i < 16; i++)
+        {
+            roundKey[i] ^= roundKey[i - 4];
+        }
+        rcon = xtime(rcon);
+
+        for (int i = 0; i < 16; i++)
+        {
+            state[i] = tmp[i] ^ roundKey[i];
+        }
+    }
+    memcpy(out, state, 16);
+}
+
+/* ======== Functions used by gapbondmgr.c ======== */
+
+uint8 osal_snv_read(osalSnvId_t id, osalSnvLen_t len, void *pBuf)
+{
+    nvReads++;
+    if ((id >= NV_IDS) || (nvLen[id] == 0))
+    {
+        return (NV_OPER_FAILED);
+    }
+    memcpy(pBuf, nvData[id], (len < nvLen[id]) ? len : nvLen[id]);
+    return (SUCCESS);
+}
+
+uint8 osal_snv_write(osalSnvId_t id, osalSnvLen_t len, void *pBuf)
+{
+    if ((id >= NV_IDS) || (len > NV_MAX_LEN) || (len == 0))
+    {
+        abort();
+    }
+    memcpy(nvData[id], pBuf, len);
+    nvLen[id] = len;
+    return (SUCCESS);
+}
+
+/* ah() of the Core Specification, the IRK in controller (MSB first) order */
+uint8 LL_PRIV_ResolveRPA(uint8 *rpa, uint8 *irk)
+{
+    uint8 in[16] = {0};
+    uint8 out[16];
+
+    aesOps++;
+    in[13] = rpa[5];
+    in[14] = rpa[4];
+    in[15] = rpa[3];
+    aesEncrypt(irk, in, out);
+    return ((out[13] == rpa[2]) && (out[14] == rpa[1]) && (out[15] == rpa[0]));
+}
+
+void LL_ENC_ReverseBytes(uint8 *buf, uint8 len)
+{
+    for (int i = 0; i < len / 2; i++)
+    {
+        uint8 tmp        = buf[i];
+        buf[i]           = buf[len - 1 - i];
+        buf[len - 1 - i] = tmp;
+    }
+}
+
+uint32 osal_GetSystemClock(void)
+{
+    return (clockMs);
+}
+
+uint16 GAP_GetParamValue(uint16 paramID)
+{
+    return ((paramID == GAP_PARAM_PRIVATE_ADDR_INT) ? PRIVATE_ADDR_INT : 0);
+}
+
+bStatus_t OPT_gapBondMgr_FindAddr(uint8_t *pDevAddr,
+                                  GAP_Peer_Addr_Types_t addrType,
+                                  uint8_t *pIdx,
+                                  GAP_Peer_Addr_Types_t *pIdentityAddrType,
+                                  uint8_t *pIdentityAddr)
+{
+    return (gapBondMgr_FindAddr(pDevAddr, addrType, pIdx, pIdentityAddrType, pIdentityAddr));
+}
+
+void *osal_mem_alloc(uint16 size)
+{
+    return (malloc(size));
+}
+
+void osal_mem_free(void *ptr)
+{
+    free(ptr);
+}
+
+void *osal_memcpy(void *dst, const void GENERIC *src, unsigned int len)
+{
+    memcpy(dst, src, len);
+    return ((uint8 *)dst + len);
+}
+
+void *osal_revmemcpy(void *dst, const void GENERIC *src, unsigned int len)
+{
+    for (unsigned int i = 0; i < len; i++)
+    {
+        ((uint8 *)dst)[i] = ((const uint8 *)src)[len - 1 - i];
+    }
+    return ((uint8 *)dst + len);
+}
+
+void *osal_memdup(const void GENERIC *src, unsigned int len)
+{
+    void *dst = malloc(len);
+
+    if (dst != NULL)
+    {
+        memcpy(dst, src, len);
+    }
+    return (dst);
+}
+
+uint8 osal_memcmp(const void GENERIC *src1, const void GENERIC *src2, unsigned int len)
+{
+    return (memcmp(src1, src2, len) == 0);
+}
+
+void *osal_memset(void *dest, uint8 value, int size)
+{
+    return (memset(dest, value, size));
+}
+
+uint8 osal_isbufset(uint8 *buf, uint8 val, uint8 len)
+{
+    for (uint8 i = 0; i < len; i++)
+    {
+        if (buf[i] != val)
+        {
+            return (FALSE);
+        }
+    }
+    return (TRUE);
+}
+
+/* ======== Test ======== */
+
+/* Private resolvable address of a peer with the given IRK in NV order */
+static void makeRpa(const uint8 *nvIrk, uint8 *rpa)
+{
+    uint8 irk[KEYLEN];
+
+    memcpy(irk, nvIrk, KEYLEN);
+    LL_ENC_ReverseBytes(irk, KEYLEN);
+    rpa[3] = randomByte();
+    rpa[4] = randomByte();
+    rpa[5] = (randomByte() & 0x3F) | 0x40;
+    rpa[0] = rpa[1] = rpa[2] = 0;
+    for (int n = 0; n < 1000 && !LL_PRIV_ResolveRPA(rpa, irk); n++)
+    {
+        /* Only the hash is missing, take it from the AES output */
+        uint8 in[16] = {0};
+        uint8 out[16];
+
+        in[13] = rpa[5];
+        in[14] = rpa[4];
+        in[15] = rpa[3];
+        aesEncrypt(irk, in, out);
+        rpa[0] = out[15];
+        rpa[1] = out[14];
+        rpa[2] = out[13];
+    }
+}
+
+static void randomIrk(uint8 *irk)
+{
+    for (int k = 0; k < KEYLEN; k++)
+    {
+        irk[k] = randomByte();
+    }
+}
+
+/*
+ * Write bonds to NV and register them with GAPBondMgr_Init(). Bond 1 has
+ * no IRK, bond 2 an erased IRK and bond 3 is empty, if there are enough.
+ */
+static void setupBonds(uint8 numBonds)
+{
+    if (bonds != NULL)
+    {
+        free(bonds);
+        free(bondsToDelete);
+        free(gapBond_lruBondList);
+        free(bondIrks);
+    }
+    memset(nvLen, 0, sizeof(nvLen));
+
+    for (uint8 i = 0; i < numBonds; i++)
+    {
+        gapBondRec_t rec = {{0x11, 0x22, 0x33, 0x44, 0x55, i}, ADDRTYPE_PUBLIC, 0};
+
+        randomIrk(bondIrk[i]);
+        if ((i == 3) && (numBonds > 4))
+        {
+            continue;
+        }
+        if ((i == 1) && (numBonds > 4))
+        {
+            memset(bondIrk[i], 0x00, KEYLEN);
+        }
+        if ((i == 2) && (numBonds > 4))
+        {
+            memset(bondIrk[i], 0xFF, KEYLEN);
+        }
+        osal_snv_write(MAIN_RECORD_NV_ID(i), sizeof(rec), &rec);
+        osal_snv_write(DEV_IRK_NV_ID(i), KEYLEN, bondIrk[i]);
+    }
+
+    GAPBondMgr_Init(1, numBonds, 4, FALSE, FALSE);
+}
+
+/* The lookup before the IRKs were kept in RAM */
+static bStatus_t refFindAddr(uint8 *pDevAddr, GAP_Peer_Addr_Types_t addrType, uint8 *pIdx)
+{
+    for (uint8 idx = 0; idx < gapBond_maxBonds; idx++)
+    {
+        if (osal_memcmp(bonds[idx].addr, pDevAddr, B_ADDR_LEN) && (addrType == bonds[idx].addrType))
+        {
+            *pIdx = idx;
+            return (SUCCESS);
+        }
+        if ((addrType == PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID) && (GAP_IS_ADDR_RPR(pDevAddr)))
+        {
+            uint8 irk[KEYLEN];
+
+            osal_snv_read(DEV_IRK_NV_ID(idx), KEYLEN, irk);
+            LL_ENC_ReverseBytes(irk, KEYLEN);
+            if (LL_PRIV_ResolveRPA(pDevAddr, irk) == TRUE)
+            {
+                *pIdx = idx;
+                return (SUCCESS);
+            }
+        }
+    }
+    return (bleGAPNotFound);
+}
+
+static bStatus_t findAddr(uint8 *addr, GAP_Peer_Addr_Types_t addrType, uint8 *pIdx)
+{
+    GAP_Peer_Addr_Types_t idType = 0xFF;
+    uint8 idAddr[B_ADDR_LEN]     = {0};
+    bStatus_t status             = gapBondMgr_FindAddr(addr, addrType, pIdx, &idType, idAddr);
+
+    if ((status == SUCCESS) && (addrType == PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID) && GAP_IS_ADDR_RPR(addr))
+    {
+        CHECK(idType == bonds[*pIdx].addrType, "identity address type %d of bond %d", idType, *pIdx);
+        CHECK(memcmp(idAddr, bonds[*pIdx].addr, B_ADDR_LEN) == 0, "identity address of bond %d", *pIdx);
+    }
+    return (status);
+}
+
+static void checkSampleData(void)
+{
+    /* FIPS-197 appendix C.1 */
+    static const uint8 key[16]      = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                       0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+    static const uint8 plain[16]    = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+                                       0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+    static const uint8 cipher[16]   = {0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+                                       0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a};
+    /* Core Specification Vol 3 Part H D.7: IRK, prand 0x708194, hash 0x0dfbaa */
+    static const uint8 sampleIrk[16] = {0xec, 0x02, 0x34, 0xa3, 0x57, 0xc8, 0xad, 0x05,
+                                        0x34, 0x10, 0x10, 0xa6, 0x0a, 0x39, 0x7d, 0x9b};
+    uint8 sampleRpa[B_ADDR_LEN]     = {0xaa, 0xfb, 0x0d, 0x94, 0x81, 0x70};
+    uint8 out[16];
+    uint8 idx;
+
+    aesEncrypt(key, plain, out);
+    CHECK(memcmp(out, cipher, 16) == 0, "AES-128 sample data");
+
+    /* Bond 0 gets the sample IRK, LSB first as in NV */
+    setupBonds(4);
+    memcpy(bondIrk[0], sampleIrk, KEYLEN);
+    LL_ENC_ReverseBytes(bondIrk[0], KEYLEN);
+    osal_snv_write(DEV_IRK_NV_ID(0), KEYLEN, bondIrk[0]);
+    gapBondMgrReadBonds();
+
+    CHECK(findAddr(sampleRpa, PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID, &idx) == SUCCESS && idx == 0, "ah() sample data");
+    sampleRpa[0] ^= 1;
+    CHECK(findAddr(sampleRpa, PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID, &idx) == bleGAPNotFound, "ah() wrong hash");
+}
+
+static void checkFindAddr(int lookups)
+{
+    setupBonds(MAX_BONDS);
+
+    for (int n = 0; n < lookups; n++)
+    {
+        uint8 addr[B_ADDR_LEN];
+        GAP_Peer_Addr_Types_t addrType = PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID;
+        uint8 owner                    = randomByte() % MAX_BONDS;
+        uint8 kind                     = randomByte() % 4;
+        uint8 idx                      = 0xFF;
+        uint8 refIdx                   = 0xFF;
+        long reads;
+
+        if (kind == 0)
+        {
+            /* Identity address of a bond */
+            memcpy(addr, bonds[owner].addr, B_ADDR_LEN);
+            addrType = bonds[owner].addrType;
+        }
+        else if (kind == 1)
+        {
+            /* Unbonded peer */
+            uint8 irk[KEYLEN];
+
+            randomIrk(irk);
+            makeRpa(irk, addr);
+        }
+        else
+        {
+            makeRpa(bondIrk[owner], addr);
+        }
+
+        reads            = nvReads;
+        bStatus_t status = findAddr(addr, addrType, &idx);
+        CHECK(nvReads == reads, "NV read during gapBondMgr_FindAddr()");
+
+        /*
+         * Bond 1 has no IRK, bond 2 an erased IRK and bond 3 is empty. The
+         * previous lookup ran the all zero IRK of bond 1 too.
+         */
+        if (kind >= 2 && owner >= 1 && owner <= 3)
+        {
+            CHECK(status == bleGAPNotFound, "address resolved to bond %d", owner);
+            continue;
+        }
+
+        bStatus_t expected = refFindAddr(addr, addrType, &refIdx);
+        CHECK(status == expected, "lookup %d: status %d, expected %d", n, status, expected);
+        CHECK(status != SUCCESS || idx == refIdx, "lookup %d: bond %d, expected %d", n, idx, refIdx);
+        if (kind != 1)
+        {
+            CHECK(status == SUCCESS && idx == owner, "lookup %d of bond %d: status %d, bond %d", n, owner, status,
+                  idx);
+        }
+    }
+}
+
+static void checkUpdates(void)
+{
+    uint8 rpa[B_ADDR_LEN];
+    uint8 newIrk[KEYLEN];
+    uint8 newRpa[B_ADDR_LEN];
+    uint8 idx;
+
+    setupBonds(8);
+    makeRpa(bondIrk[5], rpa);
+    clockMs = 0;
+
+    aesOps = 0;
+    CHECK(findAddr(rpa, PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID, &idx) == SUCCESS && idx == 5, "first lookup");
+    CHECK(aesOps > 0, "first lookup without AES");
+
+#if (GAPBOND_RPA_CACHE_SIZE > 0)
+    aesOps = 0;
+    clockMs += PRIVATE_ADDR_INT * 60000 - 1;
+    CHECK(findAddr(rpa, PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID, &idx) == SUCCESS && idx == 5, "cached lookup");
+    CHECK(aesOps == 0, "cached lookup ran %ld AES", aesOps);
+
+    /* More addresses than cache entries push out the oldest ones */
+    for (int i = 0; i < 2 * GAPBOND_RPA_CACHE_SIZE; i++)
+    {
+        uint8 other[B_ADDR_LEN];
+
+        clockMs++;
+        makeRpa(bondIrk[i % 2 ? 4 : 6], other);
+        CHECK(findAddr(other, PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID, &idx) == SUCCESS, "lookup %d", i);
+    }
+    aesOps = 0;
+    CHECK(findAddr(rpa, PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID, &idx) == SUCCESS && idx == 5, "replaced lookup");
+    CHECK(aesOps > 0, "replaced address still cached");
+
+    aesOps = 0;
+    clockMs += PRIVATE_ADDR_INT * 60000;
+    CHECK(findAddr(rpa, PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID, &idx) == SUCCESS && idx == 5, "expired lookup");
+    CHECK(aesOps > 0, "expired address still cached");
+#endif
+
+    /* A new bond in the same slot: the old address must no longer resolve */
+    gapBondRec_t rec = {{0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb}, ADDRTYPE_PUBLIC, 0};
+    randomIrk(newIrk);
+    makeRpa(newIrk, newRpa);
+    CHECK(gapBondMgrSaveBond(5, &rec, NULL, NULL, newIrk, NULL, 0, FALSE) == SUCCESS, "save bond");
+    CHECK(findAddr(rpa, PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID, &idx) == bleGAPNotFound, "replaced bond still found");
+    CHECK(findAddr(newRpa, PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID, &idx) == SUCCESS && idx == 5, "saved bond not found");
+
+    CHECK(gapBondMgrEraseBonding(5) == SUCCESS, "erase bond");
+    CHECK(findAddr(newRpa, PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID, &idx) == bleGAPNotFound, "erased bond still found");
+
+    /* Still consistent with NV after a reset */
+    makeRpa(bondIrk[6], rpa);
+    gapBondMgrReadBonds();
+    CHECK(findAddr(newRpa, PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID, &idx) == bleGAPNotFound, "erased bond found after reset");
+    CHECK(findAddr(rpa, PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID, &idx) == SUCCESS && idx == 6, "bond lost after reset");
+}
+
+static double nsSince(const struct timespec *start, uint32_t count)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (((end.tv_sec - start->tv_sec) * 1e9 + (end.tv_nsec - start->tv_nsec)) / count);
+}
+
+/*
+ * 8 bonded peers nearby, each advertising with one address, and 8
+ * unbonded peers.
+ */
+static void bench(uint8 numBonds, int lookups)
+{
+    static const char *workloads[] = {"bonded", "unbonded", "mixed"};
+    uint8 addr[16][B_ADDR_LEN];
+
+    setupBonds(numBonds);
+    for (int p = 0; p < 16; p++)
+    {
+        uint8 irk[KEYLEN];
+
+        randomIrk(irk);
+        /* Bonded peers skip the bonds without a usable IRK */
+        makeRpa((p < 8) ? bondIrk[(numBonds > 4) ? 4 + p % (numBonds - 4) : p % numBonds] : irk, addr[p]);
+    }
+
+    for (int w = 0; w < 3; w++)
+    {
+        double ns[2];
+        double reads[2];
+        double aes[2];
+
+        for (int impl = 0; impl < 2; impl++)
+        {
+            struct timespec start;
+            uint32_t state = 7;
+
+            nvReads = 0;
+            aesOps  = 0;
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (int n = 0; n < lookups; n++)
+            {
+                uint8 idx;
+                state = state * 1103515245U + 12345U;
+                int p = (w == 0) ? (state >> 16) % 8 : (w == 1) ? 8 + (state >> 16) % 8 : (state >> 16) % 16;
+
+                clockMs += 10;
+                if (impl == 0)
+                {
+                    refFindAddr(addr[p], PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID, &idx);
+                }
+                else
+                {
+                    gapBondMgr_FindAddr(addr[p], PEER_ADDRTYPE_RANDOM_OR_RANDOM_ID, &idx, NULL, NULL);
+                }
+            }
+            ns[impl]    = nsSince(&start, lookups);
+            reads[impl] = (double)nvReads / lookups;
+            aes[impl]   = (double)aesOps / lookups;
+        }
+        printf("%2d bonds, %-8s  NV reads %5.2f -> %5.2f  AES %5.2f -> %5.2f  %7.0f -> %7.0f ns\n", numBonds,
+               workloads[w], reads[0], reads[1], aes[0], aes[1], ns[0], ns[1]);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int lookups = (argc > 1) ? atoi(argv[1]) : 20000;
+
+    checkSampleData();
+    checkFindAddr(lookups);
+    checkUpdates();
+    if (failures != 0)
+    {
+        printf("%d failures\n", failures);
+        return (1);
+    }
+    printf("checks passed\n");
+    printf("previous lookup -> gapBondMgr_FindAddr(), per lookup, GAPBOND_RPA_CACHE_SIZE %d\n",
+           GAPBOND_RPA_CACHE_SIZE);
+    bench(8, lookups);
+    bench(32, lookups);
+    return (0);
+}
@@ -154,6 +154,15 @@ extern "C"
 
 #define GATT_CFG_NO_OPERATION            0x0000 //!< No operation
 
+/**
+ * @defgroup GATT_NOTI_IND_OPTIONS_DEFINES GATT Server Notification/Indication Options
+ * @{
+ */
+
+#define GATT_NOTI_IND_SEGMENT            0x01 //!< Send values longer than (ATT_MTU - 3) octets in several notifications
+
+/** @} End GATT_NOTI_IND_OPTIONS_DEFINES */
+
 /**
  * @defgroup GATT_FORMAT_TYPES_DEFINES GATT Characteristic Format Types
  * @{
@@ -531,6 +540,43 @@ bStatus_t GATTServApp_DeregisterService( uint16 handle, gattAttribute_t **p2pAtt
  */
 extern gattAttribute_t *GATTServApp_FindAttr( gattAttribute_t *pAttrTbl,
                                               uint16 numAttrs, uint8 *pValue );
+
+/**
+ * @brief   Register a service with the GATT Server Application, like
+ *          @ref GATTServApp_RegisterService, and build a lookup index of
+ *          its attribute table.
+ *
+ * The index makes @ref GATTServApp_FindAttr a binary search instead of a
+ * scan of the whole table. It is allocated from the heap (12 bytes plus
+ * 2 bytes per attribute) for tables of at least
+ * GATT_SERV_APP_INDEX_MIN_ATTRS attributes. Without an index, e.g. if the
+ * allocation fails, the service is still registered and lookups scan the
+ * table. Indexes are kept in GATT_SERV_APP_INDEX_BUCKETS (8) lists keyed by
+ * the table address, so a lookup only checks the indexes in one list.
+ *
+ * @param   pAttrs - Array of attribute records to be registered
+ * @param   numAttrs - Number of attributes in array
+ * @param   encKeySize - Minimum encryption key size required by service (7-16 bytes)
+ * @param   pServiceCBs - Service callback function pointers
+ *
+ * @return  Status of @ref GATTServApp_RegisterService
+ */
+extern bStatus_t GATTServApp_RegisterIndexedService( gattAttribute_t *pAttrs,
+                                                     uint16 numAttrs, uint8 encKeySize,
+                                                     const gattServiceCBs_t *pServiceCBs );
+
+/**
+ * @brief   Deregister a service registered with
+ *          @ref GATTServApp_RegisterIndexedService and free its index.
+ *
+ * @param   handle - handle of service to be deregistered
+ * @param   p2pAttrs - pointer to array of attribute records (to be returned)
+ *
+ * @return  Status of @ref GATTServApp_DeregisterService
+ */
+extern bStatus_t GATTServApp_DeregisterIndexedService( uint16 handle,
+                                                       gattAttribute_t **p2pAttrs );
+
 /**
  * @brief   Add function for the GATT Service.
  *
@@ -697,6 +743,41 @@ extern bStatus_t GATTServApp_ProcessCharCfg( gattCharCfg_t *charCfgTbl, uint8 *p
                                         uint16 numAttrs, uint8 taskId,
                                         pfnGATTReadAttrCB_t pfnReadAttrCB );
 
+/**
+ * @brief   Send a characteristic value to all clients that enabled
+ *          notifications or indications of it.
+ *
+ * Unlike @ref GATTServApp_ProcessCharCfg, the value is given by the caller
+ * instead of being read through the read callback for each client, and the
+ * attribute is given instead of being searched for. Each client gets the
+ * value in a buffer of its own, as the stack frees the buffer once sent.
+ *
+ * With @ref GATT_NOTI_IND_SEGMENT, a value longer than (ATT_MTU - 3) octets
+ * of a connection is sent in consecutive notifications sized to that
+ * connection's MTU. Otherwise, and always for indications, only the first
+ * (ATT_MTU - 3) octets are sent.
+ *
+ * @param   charCfgTbl - characteristic configuration table.
+ * @param   pAttr - characteristic value attribute, e.g. from
+ *          @ref GATTServApp_FindAttr.
+ * @param   pValue - value to send, may be NULL if len is 0.
+ * @param   len - length of value. A zero length value is sent as an
+ *          empty notification or indication.
+ * @param   authenticated - whether an authenticated link is required.
+ * @param   taskId - task to be notified of confirmation.
+ * @param   options - @ref GATT_NOTI_IND_OPTIONS_DEFINES
+ *
+ * @return @ref SUCCESS : sent to all clients
+ * @return @ref INVALIDPARAMETER : no table or attribute, or no value for a
+ *         nonzero length. Nothing is sent.
+ * @return @ref bleNoResources : no buffer for a client
+ * @return status of @ref GATT_Notification or @ref GATT_Indication for the
+ *         first client that failed. The remaining clients are still sent to.
+ */
+extern bStatus_t GATTServApp_SendNotiIndAll( gattCharCfg_t *charCfgTbl, gattAttribute_t *pAttr,
+                                             uint8 *pValue, uint16 len, uint8 authenticated,
+                                             uint8 taskId, uint8 options );
+
 /**
  * @brief   Build and send the @ref GATT_CLIENT_CHAR_CFG_UPDATED_EVENT to
  *          the application.
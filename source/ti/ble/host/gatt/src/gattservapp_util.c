@@ -75,20 +75,50 @@
 /*******************************************************************************
  * INCLUDES
  */
+#include <string.h>
+
 /* This Header file contains all BLE API and icall structure definition */
 #include "ti/ble/stack_util/icall/app/icall_ble_api.h"
 /*********************************************************************
  * MACROS
  */
 
+// Bucket of the lookup index of an attribute table. Tables are arrays of
+// attribute records, so the record number of the first attribute spreads
+// them over the buckets.
+#define GATT_SERV_APP_INDEX_BUCKET( pAttrTbl ) \
+  ( ( (uintptr_t)(pAttrTbl) / sizeof( gattAttribute_t ) ) & ( GATT_SERV_APP_INDEX_BUCKETS - 1 ) )
+
 /*********************************************************************
  * CONSTANTS
  */
 
+// Smallest attribute table that gets a lookup index, smaller tables are
+// scanned about as fast as they are searched
+#ifndef GATT_SERV_APP_INDEX_MIN_ATTRS
+  #define GATT_SERV_APP_INDEX_MIN_ATTRS   16
+#endif
+
+// Number of lists the lookup indexes are spread over, a power of 2. A
+// lookup only walks the list of its table, so with up to about this many
+// indexed services, a table without an index is recognized in constant time.
+#ifndef GATT_SERV_APP_INDEX_BUCKETS
+  #define GATT_SERV_APP_INDEX_BUCKETS     8
+#endif
+
 /*********************************************************************
  * TYPEDEFS
  */
 
+// Lookup index of a service attribute table
+typedef struct gattServAppIndex
+{
+  struct gattServAppIndex *pNext;   // next indexed service
+  gattAttribute_t *pAttrTbl;        // indexed attribute table
+  uint16 numAttrs;                  // number of attributes in the table
+  uint16 valueOrder[];              // attribute positions sorted by pValue
+} gattServAppIndex_t;
+
 /*********************************************************************
  * GLOBAL VARIABLES
  */
@@ -105,15 +135,24 @@
  * LOCAL VARIABLES
  */
 
+// Indexed services, by GATT_SERV_APP_INDEX_BUCKET of their attribute table
+static gattServAppIndex_t *gattServAppIndexTbl[GATT_SERV_APP_INDEX_BUCKETS] = { NULL };
+
 /*********************************************************************
  * LOCAL FUNCTIONS
  */
 
 static gattCharCfg_t *gattServApp_FindCharCfgItem( uint16 connHandle,
                                                    gattCharCfg_t *charCfgTbl );
+static void gattServApp_BuildIndex( gattAttribute_t *pAttrTbl, uint16 numAttrs );
+static void gattServApp_RemoveIndex( gattAttribute_t *pAttrTbl );
 static bStatus_t gattServApp_SendNotiInd( uint16 connHandle, uint8 cccValue,
                                           uint8 authenticated, gattAttribute_t *pAttr,
                                           uint8 taskId, pfnGATTReadAttrCB_t pfnReadAttrCB );
+static bStatus_t gattServApp_SendValue( uint16 connHandle, uint8 cccValue,
+                                        uint8 authenticated, uint16 handle,
+                                        uint8 *pValue, uint16 len, uint8 taskId,
+                                        uint8 segment );
 
 /*********************************************************************
  * API FUNCTIONS
@@ -179,6 +218,7 @@ bStatus_t GATTServApp_ProcessCharCfg( gattCharCfg_t *charCfgTbl, uint8 *pValue,
 {
   uint8 i;
   bStatus_t status = SUCCESS;
+  gattAttribute_t *pAttr = NULL;
 
   // Verify input parameters
   if ( ( charCfgTbl == NULL ) || ( pValue == NULL ) ||
@@ -194,23 +234,26 @@ bStatus_t GATTServApp_ProcessCharCfg( gattCharCfg_t *charCfgTbl, uint8 *pValue,
     if ( ( pItem->connHandle != LINKDB_CONNHANDLE_INVALID ) &&
          ( pItem->value != GATT_CFG_NO_OPERATION ) )
     {
-      gattAttribute_t *pAttr;
-
-      // Find the characteristic value attribute
-      pAttr = GATTServApp_FindAttr( attrTbl, numAttrs, pValue );
-      if ( pAttr != NULL )
+      // Find the characteristic value attribute, once for all connections
+      if ( pAttr == NULL )
       {
-        if ( pItem->value & GATT_CLIENT_CFG_NOTIFY )
+        pAttr = GATTServApp_FindAttr( attrTbl, numAttrs, pValue );
+        if ( pAttr == NULL )
         {
-           status |= gattServApp_SendNotiInd( pItem->connHandle, GATT_CLIENT_CFG_NOTIFY,
-                                              authenticated, pAttr, taskId, pfnReadAttrCB );
+          break;
         }
+      }
 
-        if ( pItem->value & GATT_CLIENT_CFG_INDICATE )
-        {
-           status |= gattServApp_SendNotiInd( pItem->connHandle, GATT_CLIENT_CFG_INDICATE,
-                                              authenticated, pAttr, taskId, pfnReadAttrCB );
-        }
+      if ( pItem->value & GATT_CLIENT_CFG_NOTIFY )
+      {
+         status |= gattServApp_SendNotiInd( pItem->connHandle, GATT_CLIENT_CFG_NOTIFY,
+                                            authenticated, pAttr, taskId, pfnReadAttrCB );
+      }
+
+      if ( pItem->value & GATT_CLIENT_CFG_INDICATE )
+      {
+         status |= gattServApp_SendNotiInd( pItem->connHandle, GATT_CLIENT_CFG_INDICATE,
+                                            authenticated, pAttr, taskId, pfnReadAttrCB );
       }
     }
   } // for
@@ -218,6 +261,72 @@ bStatus_t GATTServApp_ProcessCharCfg( gattCharCfg_t *charCfgTbl, uint8 *pValue,
   return ( status );
 }
 
+/*********************************************************************
+ * @fn      GATTServApp_SendNotiIndAll
+ *
+ * @brief   Send a characteristic value to all clients that enabled
+ *          notifications or indications of it.
+ *
+ * @param   charCfgTbl - characteristic configuration table.
+ * @param   pAttr - characteristic value attribute.
+ * @param   pValue - value to send, may be NULL if len is 0.
+ * @param   len - length of value, 0 for an empty notification/indication.
+ * @param   authenticated - whether an authenticated link is required.
+ * @param   taskId - task to be notified of confirmation.
+ * @param   options - GATT_NOTI_IND_SEGMENT to split long notifications.
+ *
+ * @return  SUCCESS, or the first failure status
+ */
+bStatus_t GATTServApp_SendNotiIndAll( gattCharCfg_t *charCfgTbl, gattAttribute_t *pAttr,
+                                      uint8 *pValue, uint16 len, uint8 authenticated,
+                                      uint8 taskId, uint8 options )
+{
+  uint8 i;
+  bStatus_t status = SUCCESS;
+
+  // Verify input parameters
+  if ( ( charCfgTbl == NULL ) || ( pAttr == NULL ) ||
+       ( ( pValue == NULL ) && ( len > 0 ) ) )
+  {
+    return ( INVALIDPARAMETER );
+  }
+
+  for ( i = 0; i < linkDBNumConns; i++ )
+  {
+    gattCharCfg_t *pItem = &(charCfgTbl[i]);
+    bStatus_t connStatus = SUCCESS;
+
+    if ( ( pItem->connHandle == LINKDB_CONNHANDLE_INVALID ) ||
+         ( pItem->value == GATT_CFG_NO_OPERATION ) )
+    {
+      continue;
+    }
+
+    if ( pItem->value & GATT_CLIENT_CFG_NOTIFY )
+    {
+      connStatus = gattServApp_SendValue( pItem->connHandle, GATT_CLIENT_CFG_NOTIFY,
+                                          authenticated, pAttr->handle, pValue, len,
+                                          taskId, options & GATT_NOTI_IND_SEGMENT );
+    }
+
+    // Only one indication can be outstanding, so it is never segmented
+    if ( ( connStatus == SUCCESS ) && ( pItem->value & GATT_CLIENT_CFG_INDICATE ) )
+    {
+      connStatus = gattServApp_SendValue( pItem->connHandle, GATT_CLIENT_CFG_INDICATE,
+                                          authenticated, pAttr->handle, pValue, len,
+                                          taskId, FALSE );
+    }
+
+    // A failing connection doesn't hold back the others
+    if ( status == SUCCESS )
+    {
+      status = connStatus;
+    }
+  } // for
+
+  return ( status );
+}
+
 /*********************************************************************
  * @fn          GATTServApp_FindAttr
  *
@@ -234,6 +343,43 @@ gattAttribute_t *GATTServApp_FindAttr( gattAttribute_t *pAttrTbl,
                                        uint16 numAttrs, uint8 *pValue )
 {
   uint16  i;
+  gattServAppIndex_t *pIndex;
+
+  // Only the indexes sharing a bucket with this table are looked at
+  for ( pIndex = gattServAppIndexTbl[GATT_SERV_APP_INDEX_BUCKET( pAttrTbl )];
+        pIndex != NULL; pIndex = pIndex->pNext )
+  {
+    if ( ( pIndex->pAttrTbl == pAttrTbl ) && ( pIndex->numAttrs >= numAttrs ) )
+    {
+      uint16 low = 0;
+      uint16 high = pIndex->numAttrs;
+
+      // Find the first attribute with this value pointer
+      while ( low < high )
+      {
+        uint16 mid = ( low + high ) / 2;
+
+        if ( (uintptr_t)pAttrTbl[pIndex->valueOrder[mid]].pValue < (uintptr_t)pValue )
+        {
+          low = mid + 1;
+        }
+        else
+        {
+          high = mid;
+        }
+      }
+
+      if ( ( low < pIndex->numAttrs ) &&
+           ( pAttrTbl[pIndex->valueOrder[low]].pValue == pValue ) &&
+           ( pIndex->valueOrder[low] < numAttrs ) )
+      {
+        return ( &(pAttrTbl[pIndex->valueOrder[low]]) );
+      }
+
+      return ( (gattAttribute_t *)NULL );
+    }
+  }
+
   for ( i = 0; i < numAttrs; i++ )
   {
     if ( pAttrTbl[i].pValue == pValue )
@@ -246,6 +392,60 @@ gattAttribute_t *GATTServApp_FindAttr( gattAttribute_t *pAttrTbl,
   return ( (gattAttribute_t *)NULL );
 }
 
+/*********************************************************************
+ * @fn      GATTServApp_RegisterIndexedService
+ *
+ * @brief   Register a service with the GATT Server Application and
+ *          build a lookup index of its attribute table.
+ *
+ * @param   pAttrs - Array of attribute records to be registered
+ * @param   numAttrs - Number of attributes in array
+ * @param   encKeySize - Minimum encryption key size required by service
+ * @param   pServiceCBs - Service callback function pointers
+ *
+ * @return  Status of GATTServApp_RegisterService
+ */
+bStatus_t GATTServApp_RegisterIndexedService( gattAttribute_t *pAttrs,
+                                              uint16 numAttrs, uint8 encKeySize,
+                                              const gattServiceCBs_t *pServiceCBs )
+{
+  bStatus_t status;
+
+  status = GATTServApp_RegisterService( pAttrs, numAttrs, encKeySize, pServiceCBs );
+  if ( status == SUCCESS )
+  {
+    // Without an index the lookups scan the table
+    gattServApp_BuildIndex( pAttrs, numAttrs );
+  }
+
+  return ( status );
+}
+
+/*********************************************************************
+ * @fn      GATTServApp_DeregisterIndexedService
+ *
+ * @brief   Deregister a service registered with
+ *          GATTServApp_RegisterIndexedService and free its index.
+ *
+ * @param   handle - handle of service to be deregistered
+ * @param   p2pAttrs - pointer to array of attribute records (to be returned)
+ *
+ * @return  Status of GATTServApp_DeregisterService
+ */
+bStatus_t GATTServApp_DeregisterIndexedService( uint16 handle,
+                                                gattAttribute_t **p2pAttrs )
+{
+  bStatus_t status;
+
+  status = GATTServApp_DeregisterService( handle, p2pAttrs );
+  if ( ( status == SUCCESS ) && ( p2pAttrs != NULL ) )
+  {
+    gattServApp_RemoveIndex( *p2pAttrs );
+  }
+
+  return ( status );
+}
+
 /*********************************************************************
  * @fn      GATTServApp_ProcessCCCWriteReq
  *
@@ -358,7 +558,17 @@ uint8 GATTServApp_WriteCharCfg( uint16 connHandle, gattCharCfg_t *charCfgTbl,
   pItem = gattServApp_FindCharCfgItem( connHandle, charCfgTbl );
   if ( pItem == NULL )
   {
-    pItem = gattServApp_FindCharCfgItem( LINKDB_CONNHANDLE_INVALID, charCfgTbl );
+    // Prefer the connection handle position so later lookups are direct
+    if ( ( connHandle < linkDBNumConns ) &&
+         ( charCfgTbl[connHandle].connHandle == LINKDB_CONNHANDLE_INVALID ) )
+    {
+      pItem = &(charCfgTbl[connHandle]);
+    }
+    else
+    {
+      pItem = gattServApp_FindCharCfgItem( LINKDB_CONNHANDLE_INVALID, charCfgTbl );
+    }
+
     if ( pItem == NULL )
     {
       return ( ATT_ERR_INSUFFICIENT_RESOURCES );
@@ -390,6 +600,13 @@ static gattCharCfg_t *gattServApp_FindCharCfgItem( uint16 connHandle,
 {
   uint8 i;
 
+  // Clients are stored at their connection handle position when possible
+  if ( ( connHandle < linkDBNumConns ) &&
+       ( charCfgTbl[connHandle].connHandle == connHandle ) )
+  {
+    return ( &(charCfgTbl[connHandle]) );
+  }
+
   for ( i = 0; i < linkDBNumConns; i++ )
   {
     if ( charCfgTbl[i].connHandle == connHandle )
@@ -402,6 +619,87 @@ static gattCharCfg_t *gattServApp_FindCharCfgItem( uint16 connHandle,
   return ( (gattCharCfg_t *)NULL );
 }
 
+/*********************************************************************
+ * @fn      gattServApp_BuildIndex
+ *
+ * @brief   Build the lookup index of a service attribute table. The
+ *          attribute positions are sorted by value pointer, and by
+ *          position for equal pointers so the first match is found.
+ *
+ * @param   pAttrTbl - attribute table.
+ * @param   numAttrs - number of attributes in attribute table.
+ *
+ * @return  none
+ */
+static void gattServApp_BuildIndex( gattAttribute_t *pAttrTbl, uint16 numAttrs )
+{
+  gattServAppIndex_t *pIndex;
+  uint16 i;
+
+  // Replace an older index of the same table
+  gattServApp_RemoveIndex( pAttrTbl );
+
+  if ( numAttrs < GATT_SERV_APP_INDEX_MIN_ATTRS )
+  {
+    return;
+  }
+
+  pIndex = (gattServAppIndex_t *)ICall_malloc( sizeof( gattServAppIndex_t ) +
+                                               ( numAttrs * sizeof( uint16 ) ) );
+  if ( pIndex == NULL )
+  {
+    return;
+  }
+
+  pIndex->pAttrTbl = pAttrTbl;
+  pIndex->numAttrs = numAttrs;
+
+  // Insertion sort, done once per service
+  for ( i = 0; i < numAttrs; i++ )
+  {
+    uint16 j = i;
+
+    while ( ( j > 0 ) &&
+            ( (uintptr_t)pAttrTbl[pIndex->valueOrder[j - 1]].pValue >
+              (uintptr_t)pAttrTbl[i].pValue ) )
+    {
+      pIndex->valueOrder[j] = pIndex->valueOrder[j - 1];
+      j--;
+    }
+    pIndex->valueOrder[j] = i;
+  }
+
+  pIndex->pNext = gattServAppIndexTbl[GATT_SERV_APP_INDEX_BUCKET( pAttrTbl )];
+  gattServAppIndexTbl[GATT_SERV_APP_INDEX_BUCKET( pAttrTbl )] = pIndex;
+}
+
+/*********************************************************************
+ * @fn      gattServApp_RemoveIndex
+ *
+ * @brief   Free the lookup index of a service attribute table.
+ *
+ * @param   pAttrTbl - attribute table.
+ *
+ * @return  none
+ */
+static void gattServApp_RemoveIndex( gattAttribute_t *pAttrTbl )
+{
+  gattServAppIndex_t **ppIndex;
+
+  for ( ppIndex = &gattServAppIndexTbl[GATT_SERV_APP_INDEX_BUCKET( pAttrTbl )];
+        *ppIndex != NULL; ppIndex = &((*ppIndex)->pNext) )
+  {
+    if ( (*ppIndex)->pAttrTbl == pAttrTbl )
+    {
+      gattServAppIndex_t *pIndex = *ppIndex;
+
+      *ppIndex = pIndex->pNext;
+      ICall_free( pIndex );
+      break;
+    }
+  }
+}
+
  /*********************************************************************
  * @fn      gattServApp_SendNotiInd
  *
@@ -461,6 +759,80 @@ static bStatus_t gattServApp_SendNotiInd( uint16 connHandle, uint8 cccValue,
   return ( status );
 }
 
+/*********************************************************************
+ * @fn      gattServApp_SendValue
+ *
+ * @brief   Send a given value in ATT Notifications/an Indication.
+ *
+ * @param   connHandle - connection handle to use.
+ * @param   cccValue - client characteristic configuration value.
+ * @param   authenticated - whether an authenticated link is required.
+ * @param   handle - attribute handle.
+ * @param   pValue - value to send.
+ * @param   len - length of value.
+ * @param   taskId - task to be notified of confirmation.
+ * @param   segment - TRUE to send the value in as many notifications as
+ *                    the connection's MTU needs, FALSE to send only the
+ *                    first (ATT_MTU - 3) octets.
+ *
+ * @return  Success or Failure
+ */
+static bStatus_t gattServApp_SendValue( uint16 connHandle, uint8 cccValue,
+                                        uint8 authenticated, uint16 handle,
+                                        uint8 *pValue, uint16 len, uint8 taskId,
+                                        uint8 segment )
+{
+  uint16 offset = 0;
+
+  do
+  {
+    attHandleValueNoti_t noti;
+    uint16 allocLen;
+    bStatus_t status;
+
+    // The buffer is capped to (ATT_MTU - 3) octets of the connection
+    noti.pValue = (uint8 *)GATT_bm_alloc( connHandle, ATT_HANDLE_VALUE_NOTI,
+                                          len - offset, &allocLen );
+    if ( noti.pValue == NULL )
+    {
+      return ( bleNoResources );
+    }
+
+    if ( allocLen > len - offset )
+    {
+      allocLen = len - offset;
+    }
+
+    // The stack frees the buffer once sent, so each connection gets a copy
+    if ( allocLen > 0 )
+    {
+      memcpy( noti.pValue, pValue + offset, allocLen );
+    }
+    noti.len = allocLen;
+    noti.handle = handle;
+
+    if ( cccValue & GATT_CLIENT_CFG_NOTIFY )
+    {
+      status = GATT_Notification( connHandle, &noti, authenticated );
+    }
+    else // GATT_CLIENT_CFG_INDICATE
+    {
+      status = GATT_Indication( connHandle, (attHandleValueInd_t *)&noti,
+                                authenticated, taskId );
+    }
+
+    if ( status != SUCCESS )
+    {
+      GATT_bm_free( (gattMsg_t *)&noti, ATT_HANDLE_VALUE_NOTI );
+      return ( status );
+    }
+
+    offset += allocLen;
+  } while ( segment && ( offset < len ) );
+
+  return ( SUCCESS );
+}
+
 #endif // ( CENTRAL_CFG | PERIPHERAL_CFG )
 
 /****************************************************************************
@@ -0,0 +1,539 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== gattservapptest.c ========
+ *
+ * Check and benchmark of the GATT server application utilities.
+ *
+ * gattservapp_util.c is compiled from the SDK sources.  The GATT buffer
+ * allocation and the notification and indication calls are modelled
+ * below: buffers are capped to (ATT_MTU - 3) octets of the connection,
+ * and every value sent is appended to a per-connection receive buffer.
+ *
+ *  - GATTServApp_SendNotiIndAll: values of 0 to 1000 octets to
+ *    connections with different MTUs, segmented and not, notifications and
+ *    indications, a failing connection, invalid parameters, and no buffer
+ *    left allocated afterwards.
+ *  - GATTServApp_FindAttr: random tables registered with and without an
+ *    index, with shared, duplicate and NULL value pointers, looked up over
+ *    the whole table and over shorter ranges, compared with a scan of the
+ *    table; no index left allocated after deregistration.
+ *  - Time per call of GATTServApp_SendNotiIndAll and of
+ *    GATTServApp_ProcessCharCfg for 1 to 32 connections.
+ *  - Time per call of GATTServApp_FindAttr on an indexed and on a small
+ *    table that is not indexed, with 0 to 64 other indexed services.
+ *
+ * Usage:
+ *
+ *     gattservapptest
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ti/ble/stack_util/icall/app/icall_ble_api.h"
+
+#define MAX_CONNS   32
+#define MAX_RX      2048
+#define TABLE_ATTRS 24
+#define VALUE_ATTR  21
+#define MAX_ATTRS   200
+#define MAX_SERVICES 80
+
+#define CHECK(cond, ...)                                       \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            if (failures++ < 20)                               \
+            {                                                  \
+                printf("FAIL %s:%d: ", __FILE__, __LINE__);    \
+                printf(__VA_ARGS__);                           \
+                printf("\n");                                  \
+            }                                                  \
+        }                                                      \
+    } while (0)
+
+uint8 linkDBNumConns;
+
+static int failures;
+static int heapBlocks;
+
+/* Registered services, handles are assigned consecutively */
+static gattAttribute_t *services[MAX_SERVICES];
+static int numServices;
+static uint16 nextHandle = 1;
+
+/* Connection model */
+static uint16 mtu[MAX_CONNS];
+static uint8 rx[MAX_CONNS][MAX_RX];
+static uint16 rxLen[MAX_CONNS];
+static uint16 rxPackets[MAX_CONNS];
+static int failAfter[MAX_CONNS];
+static int buffersLeft;
+static int benchMode;
+static uint8 benchPool[MAX_CONNS][256];
+static volatile uint32 benchSink;
+
+/* Value and table for GATTServApp_ProcessCharCfg */
+static uint8 profileValue[244];
+static uint8 *readValue;
+static uint16 readLen;
+static uint8 profileOther[TABLE_ATTRS];
+
+#define ATTR(i) {{ATT_BT_UUID_SIZE, NULL}, GATT_PERMIT_READ, 100 + (i), \
+                 ((i) == VALUE_ATTR) ? profileValue : &profileOther[i]}
+
+static gattAttribute_t profileTable[TABLE_ATTRS] = {
+    ATTR(0),  ATTR(1),  ATTR(2),  ATTR(3),  ATTR(4),  ATTR(5),  ATTR(6),  ATTR(7),
+    ATTR(8),  ATTR(9),  ATTR(10), ATTR(11), ATTR(12), ATTR(13), ATTR(14), ATTR(15),
+    ATTR(16), ATTR(17), ATTR(18), ATTR(19), ATTR(20), ATTR(21), ATTR(22), ATTR(23),
+};
+
+static gattCharCfg_t charCfg[MAX_CONNS];
+
+void *GATT_bm_alloc(uint16 connHandle, uint8 opcode, uint16 size, uint16 *pSizeAlloc)
+{
+    uint16 max = mtu[connHandle] - 3;
+    uint16 len = (size < max) ? size : max;
+
+    if (pSizeAlloc != NULL)
+    {
+        *pSizeAlloc = len;
+    }
+    if (benchMode)
+    {
+        return (benchPool[connHandle]);
+    }
+    buffersLeft++;
+    return (malloc(len + 1));
+}
+
+void GATT_bm_free(gattMsg_t *pMsg, uint8 opcode)
+{
+    if (!benchMode)
+    {
+        free(((attHandleValueNoti_t *)pMsg)->pValue);
+        buffersLeft--;
+    }
+}
+
+bStatus_t GATT_Notification(uint16 connHandle, attHandleValueNoti_t *pNoti, uint8 authenticated)
+{
+    if (benchMode)
+    {
+        benchSink += pNoti->len + pNoti->pValue[0];
+        return (SUCCESS);
+    }
+    if (failAfter[connHandle] > 0 && --failAfter[connHandle] == 0)
+    {
+        return (bleTimeout);
+    }
+    if (pNoti->len > mtu[connHandle] - 3 || rxLen[connHandle] + pNoti->len > MAX_RX)
+    {
+        printf("FAIL notification of %d octets with MTU %d\n", pNoti->len, mtu[connHandle]);
+        exit(1);
+    }
+    memcpy(&rx[connHandle][rxLen[connHandle]], pNoti->pValue, pNoti->len);
+    rxLen[connHandle] += pNoti->len;
+    rxPackets[connHandle]++;
+    free(pNoti->pValue);
+    buffersLeft--;
+    return (SUCCESS);
+}
+
+bStatus_t GATT_Indication(uint16 connHandle, attHandleValueInd_t *pInd, uint8 authenticated, uint8 taskId)
+{
+    return (GATT_Notification(connHandle, (attHandleValueNoti_t *)pInd, authenticated));
+}
+
+bStatus_t GATTServApp_RegisterService(gattAttribute_t *pAttrs, uint16 numAttrs, uint8 encKeySize,
+                                      const gattServiceCBs_t *pServiceCBs)
+{
+    if (numServices == MAX_SERVICES)
+    {
+        return (bleNoResources);
+    }
+    for (uint16 i = 0; i < numAttrs; i++)
+    {
+        pAttrs[i].handle = nextHandle++;
+    }
+    services[numServices++] = pAttrs;
+    return (SUCCESS);
+}
+
+bStatus_t GATTServApp_DeregisterService(uint16 handle, gattAttribute_t **p2pAttrs)
+{
+    for (int i = 0; i < numServices; i++)
+    {
+        if (services[i][0].handle == handle)
+        {
+            if (p2pAttrs != NULL)
+            {
+                *p2pAttrs = services[i];
+            }
+            services[i] = services[--numServices];
+            return (SUCCESS);
+        }
+    }
+    return (FAILURE);
+}
+
+void *ICall_malloc(uint_least16_t size)
+{
+    heapBlocks++;
+    return (malloc(size));
+}
+
+void ICall_free(void *msg)
+{
+    if (msg != NULL)
+    {
+        heapBlocks--;
+    }
+    free(msg);
+}
+
+static bStatus_t readAttrCB(uint16 connHandle, gattAttribute_t *pAttr, uint8 *pValue, uint16 *pLen,
+                            uint16 offset, uint16 maxLen, uint8 method)
+{
+    uint16 len = (readLen < maxLen) ? readLen : maxLen;
+
+    memcpy(pValue, readValue, len);
+    *pLen = len;
+    return (SUCCESS);
+}
+
+static void setConnections(uint8 numConns, uint8 cccValue)
+{
+    static const uint16 mtus[] = {23, 247, 100, 65, 517};
+
+    linkDBNumConns = numConns;
+    for (uint8 c = 0; c < MAX_CONNS; c++)
+    {
+        mtu[c] = mtus[c % 5];
+        charCfg[c].connHandle = c;
+        charCfg[c].value = cccValue;
+    }
+}
+
+static void clearRx(void)
+{
+    memset(rxLen, 0, sizeof(rxLen));
+    memset(rxPackets, 0, sizeof(rxPackets));
+}
+
+static void checkSendNotiIndAll(void)
+{
+    static uint8 data[1000];
+    gattAttribute_t *pAttr = &profileTable[VALUE_ATTR];
+    bStatus_t status;
+
+    for (int i = 0; i < 1000; i++)
+    {
+        data[i] = (uint8)rand();
+    }
+    setConnections(5, GATT_CLIENT_CFG_NOTIFY);
+    charCfg[2].connHandle = LINKDB_CONNHANDLE_INVALID;
+    charCfg[3].value = GATT_CFG_NO_OPERATION;
+
+    /* Segmented notifications of all lengths, including an empty value */
+    for (uint16 len = 0; len < 1000; len += 37)
+    {
+        clearRx();
+        status = GATTServApp_SendNotiIndAll(charCfg, pAttr, data, len, FALSE, 0, GATT_NOTI_IND_SEGMENT);
+        CHECK(status == SUCCESS, "len %d: status 0x%x", len, status);
+        for (int c = 0; c < 5; c++)
+        {
+            uint16 payload = mtu[c] - 3;
+            uint16 packets = (len == 0) ? 1 : (len + payload - 1) / payload;
+
+            if (c == 2 || c == 3)
+            {
+                CHECK(rxPackets[c] == 0, "len %d: sent to connection %d without notifications", len, c);
+                continue;
+            }
+            CHECK(rxLen[c] == len && memcmp(rx[c], data, len) == 0 && rxPackets[c] == packets,
+                  "len %d: connection %d got %d octets in %d notifications", len, c, rxLen[c], rxPackets[c]);
+        }
+    }
+
+    /* An empty value without a buffer */
+    clearRx();
+    status = GATTServApp_SendNotiIndAll(charCfg, pAttr, NULL, 0, FALSE, 0, 0);
+    CHECK(status == SUCCESS && rxPackets[0] == 1 && rxLen[0] == 0, "empty value: status 0x%x, %d notifications",
+          status, rxPackets[0]);
+
+    /* Not segmented, notification and indication */
+    clearRx();
+    charCfg[0].value = GATT_CLIENT_CFG_NOTIFY | GATT_CLIENT_CFG_INDICATE;
+    status = GATTServApp_SendNotiIndAll(charCfg, pAttr, data, 100, FALSE, 0, 0);
+    CHECK(status == SUCCESS && rxLen[0] == 2 * 20 && rxLen[1] == 100 && rxLen[4] == 100,
+          "unsegmented: %d %d %d octets", rxLen[0], rxLen[1], rxLen[4]);
+    charCfg[0].value = GATT_CLIENT_CFG_NOTIFY;
+
+    /* A failing connection doesn't hold back the others */
+    clearRx();
+    failAfter[1] = 2;
+    status = GATTServApp_SendNotiIndAll(charCfg, pAttr, data, 600, FALSE, 0, GATT_NOTI_IND_SEGMENT);
+    CHECK(status == bleTimeout && rxLen[0] == 600 && rxLen[1] == 244 && rxLen[4] == 600,
+          "failing connection: status 0x%x, %d %d %d octets", status, rxLen[0], rxLen[1], rxLen[4]);
+    failAfter[1] = 0;
+
+    /* Invalid parameters send nothing */
+    clearRx();
+    CHECK(GATTServApp_SendNotiIndAll(NULL, pAttr, data, 10, FALSE, 0, 0) == INVALIDPARAMETER &&
+          GATTServApp_SendNotiIndAll(charCfg, NULL, data, 10, FALSE, 0, 0) == INVALIDPARAMETER &&
+          GATTServApp_SendNotiIndAll(charCfg, pAttr, NULL, 10, FALSE, 0, 0) == INVALIDPARAMETER &&
+          rxPackets[0] == 0, "invalid parameters");
+
+    CHECK(buffersLeft == 0, "%d buffers left allocated", buffersLeft);
+}
+
+/* Table laid out like the SDK services: properties shared by all declarations, values, CCC pointers */
+static gattAttribute_t *makeTable(uint16 numAttrs)
+{
+    static uint8 props = GATT_PROP_READ | GATT_PROP_NOTIFY;
+    static uint8 values[MAX_ATTRS][4];
+    static gattCharCfg_t *cccs[MAX_ATTRS];
+    gattAttribute_t *table = calloc(numAttrs, sizeof(*table));
+
+    for (uint16 i = 0; i < numAttrs; i++)
+    {
+        uint8 **ppValue = (uint8 **)&table[i].pValue;
+
+        switch (i % 4)
+        {
+        case 0:
+            *ppValue = &props;
+            break;
+        case 2:
+            *ppValue = (uint8 *)&cccs[i];
+            break;
+        default:
+            *ppValue = values[rand() % MAX_ATTRS];
+            break;
+        }
+        if (rand() % 20 == 0)
+        {
+            *ppValue = NULL;
+        }
+    }
+    return (table);
+}
+
+static gattAttribute_t *scanFindAttr(gattAttribute_t *pAttrTbl, uint16 numAttrs, uint8 *pValue)
+{
+    for (uint16 i = 0; i < numAttrs; i++)
+    {
+        if (pAttrTbl[i].pValue == pValue)
+        {
+            return (&pAttrTbl[i]);
+        }
+    }
+    return (NULL);
+}
+
+static void deregisterAll(void)
+{
+    while (numServices > 0)
+    {
+        gattAttribute_t *table = NULL;
+
+        CHECK(GATTServApp_DeregisterIndexedService(services[0][0].handle, &table) == SUCCESS, "deregister failed");
+        free(table);
+    }
+}
+
+static void checkFindAttr(void)
+{
+    srand(1);
+    for (int round = 0; round < 300; round++)
+    {
+        uint16 numAttrs = 1 + rand() % MAX_ATTRS;
+        gattAttribute_t *table = makeTable(numAttrs);
+        uint16 numUnindexed = 1 + rand() % MAX_ATTRS;
+        gattAttribute_t *unindexed = makeTable(numUnindexed);
+
+        if (numServices == MAX_SERVICES)
+        {
+            deregisterAll();
+        }
+        CHECK(GATTServApp_RegisterIndexedService(table, numAttrs, 16, NULL) == SUCCESS, "register failed");
+        for (int k = 0; k < 2000; k++)
+        {
+            /* Whole table or a shorter range */
+            uint16 range = (k & 1) ? numAttrs : rand() % (numAttrs + 1);
+            uint8 *pValue = (rand() % 2) ? table[rand() % numAttrs].pValue : (uint8 *)&table[rand() % numAttrs];
+
+            CHECK(GATTServApp_FindAttr(table, range, pValue) == scanFindAttr(table, range, pValue),
+                  "indexed table of %d attributes, range %d", numAttrs, range);
+            pValue = unindexed[k % numUnindexed].pValue;
+            CHECK(GATTServApp_FindAttr(unindexed, numUnindexed, pValue) == scanFindAttr(unindexed, numUnindexed, pValue),
+                  "table without index");
+        }
+        free(unindexed);
+        if (round % 2)
+        {
+            gattAttribute_t *back = NULL;
+
+            CHECK(GATTServApp_DeregisterIndexedService(table[0].handle, &back) == SUCCESS && back == table,
+                  "deregister failed");
+            free(table);
+        }
+    }
+    deregisterAll();
+    CHECK(heapBlocks == 0, "%d index blocks left allocated", heapBlocks);
+}
+
+static double nsNow(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (t.tv_sec * 1e9 + t.tv_nsec);
+}
+
+/* Time per call, best of 5 runs */
+static void benchSendNotiIndAll(void)
+{
+    static const uint8 conns[] = {1, 4, 8, 16, 32};
+    static const uint16 lens[] = {20, 244};
+    static uint8 data[244];
+
+    benchMode = 1;
+    readValue = data;
+    printf("%-4s %-5s %16s %16s\n", "N", "len", "ProcessCharCfg", "SendNotiIndAll");
+    for (unsigned a = 0; a < sizeof(conns); a++)
+    {
+        for (unsigned b = 0; b < sizeof(lens) / sizeof(lens[0]); b++)
+        {
+            int iterations = 200000 / conns[a];
+            double best[2] = {1e18, 1e18};
+
+            setConnections(conns[a], GATT_CLIENT_CFG_NOTIFY);
+            for (uint8 c = 0; c < conns[a]; c++)
+            {
+                mtu[c] = 247;
+            }
+            readLen = lens[b];
+            for (int run = 0; run < 5; run++)
+            {
+                double t0 = nsNow();
+                double t1;
+                double t2;
+
+                for (int k = 0; k < iterations; k++)
+                {
+                    GATTServApp_ProcessCharCfg(charCfg, profileValue, FALSE, profileTable, TABLE_ATTRS, 0, readAttrCB);
+                }
+                t1 = nsNow();
+                for (int k = 0; k < iterations; k++)
+                {
+                    GATTServApp_SendNotiIndAll(charCfg, GATTServApp_FindAttr(profileTable, TABLE_ATTRS, profileValue),
+                                               data, lens[b], FALSE, 0, 0);
+                }
+                t2 = nsNow();
+                if ((t1 - t0) / iterations < best[0])
+                {
+                    best[0] = (t1 - t0) / iterations;
+                }
+                if ((t2 - t1) / iterations < best[1])
+                {
+                    best[1] = (t2 - t1) / iterations;
+                }
+            }
+            printf("%-4d %-5d %13.0f ns %13.0f ns\n", conns[a], lens[b], best[0], best[1]);
+        }
+    }
+    benchMode = 0;
+}
+
+/* Time per call, best of 5 runs */
+static double timeFindAttr(gattAttribute_t *pAttrTbl, uint16 numAttrs)
+{
+    const int iterations = 200000;
+    double best = 1e18;
+
+    for (int run = 0; run < 5; run++)
+    {
+        double t0 = nsNow();
+
+        for (int k = 0; k < iterations; k++)
+        {
+            benchSink += (uintptr_t)GATTServApp_FindAttr(pAttrTbl, numAttrs, pAttrTbl[k % numAttrs].pValue);
+        }
+        if ((nsNow() - t0) / iterations < best)
+        {
+            best = (nsNow() - t0) / iterations;
+        }
+    }
+    return (best);
+}
+
+static void benchFindAttr(void)
+{
+    static const int others[] = {0, 8, 64};
+    gattAttribute_t *indexed = makeTable(160);
+    gattAttribute_t *small = makeTable(8);
+
+    GATTServApp_RegisterIndexedService(indexed, 160, 16, NULL);
+    printf("%-16s %20s %20s\n", "indexed services", "FindAttr, indexed", "FindAttr, 8 attrs");
+    for (unsigned a = 0; a < sizeof(others) / sizeof(others[0]); a++)
+    {
+        while (numServices < 1 + others[a])
+        {
+            gattAttribute_t *table = makeTable(32);
+            GATTServApp_RegisterIndexedService(table, 32, 16, NULL);
+        }
+        printf("%-16d %17.1f ns %17.1f ns\n", numServices, timeFindAttr(indexed, 160), timeFindAttr(small, 8));
+    }
+    deregisterAll();
+    free(small);
+}
+
+int main(void)
+{
+    checkSendNotiIndAll();
+    checkFindAttr();
+    if (failures != 0)
+    {
+        printf("%d failures\n", failures);
+        return (1);
+    }
+    printf("checks passed\n");
+    benchSendNotiIndAll();
+    benchFindAttr();
+    return (0);
+}
@@ -216,10 +216,10 @@ uint8_t CAS_addService( void )
     GATTServApp_InitCharCfg( LINKDB_CONNHANDLE_INVALID, casIndicationConfig );
 
     // Register GATT attribute list and CBs with GATT Server
-    status = GATTServApp_RegisterService( cas_attrTbl,
-                                          GATT_NUM_ATTRS( cas_attrTbl ),
-                                          GATT_MAX_ENCRYPT_KEY_SIZE,
-                                          &cas_servCBs );
+    status = GATTServApp_RegisterIndexedService( cas_attrTbl,
+                                                 GATT_NUM_ATTRS( cas_attrTbl ),
+                                                 GATT_MAX_ENCRYPT_KEY_SIZE,
+                                                 &cas_servCBs );
   }
   else
   {
@@ -283,10 +283,10 @@ bStatus_t CGMS_addService( void )
   }
 
   // Register GATT attribute list and CBs with GATT Server
-  status = GATTServApp_RegisterService( cgms_attrTbl,
-                                        GATT_NUM_ATTRS( cgms_attrTbl ),
-                                        GATT_MAX_ENCRYPT_KEY_SIZE,
-                                        &cgms_servCB );
+  status = GATTServApp_RegisterIndexedService( cgms_attrTbl,
+                                               GATT_NUM_ATTRS( cgms_attrTbl ),
+                                               GATT_MAX_ENCRYPT_KEY_SIZE,
+                                               &cgms_servCB );
 
   // Return status value
   return ( status );
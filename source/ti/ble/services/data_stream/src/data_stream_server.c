@@ -61,8 +61,6 @@
 /*********************************************************************
  * CONSTANTS
  */
-// The size of the notification header is opcode + handle
-#define DSS_NOTI_HDR_SIZE   (ATT_OPCODE_SIZE + 2)
 
 /*********************************************************************
  * TYPEDEFS
@@ -197,10 +195,10 @@ bStatus_t DSS_addService( void )
   GATTServApp_InitCharCfg( LINKDB_CONNHANDLE_INVALID, dss_dataOut_config );
 
   // Register GATT attribute list and CBs with GATT Server
-  status = GATTServApp_RegisterService( dss_attrTbl,
-                                        GATT_NUM_ATTRS( dss_attrTbl ),
-                                        GATT_MAX_ENCRYPT_KEY_SIZE,
-                                        &dss_servCBs );
+  status = GATTServApp_RegisterIndexedService( dss_attrTbl,
+                                               GATT_NUM_ATTRS( dss_attrTbl ),
+                                               GATT_MAX_ENCRYPT_KEY_SIZE,
+                                               &dss_servCBs );
 
   // Return status value
   return ( status );
@@ -388,10 +386,6 @@ static bStatus_t DSS_sendNotification(uint8 *pValue, uint16 len)
 {
   bStatus_t status = SUCCESS;
   gattAttribute_t *pAttr = NULL;
-  attHandleValueNoti_t noti = {0};
-  linkDBInfo_t connInfo = {0};
-  uint16 offset = 0;
-  uint8 i = 0;
 
   // Verify input parameters
   if ( pValue == NULL )
@@ -399,72 +393,34 @@ static bStatus_t DSS_sendNotification(uint8 *pValue, uint16 len)
     return ( INVALIDPARAMETER );
   }
 
+  // There is nothing to send for an empty value
+  if ( len == 0 )
+  {
+    return ( SUCCESS );
+  }
+
   // Find the characteristic value attribute
   pAttr = GATTServApp_FindAttr(dss_attrTbl, GATT_NUM_ATTRS(dss_attrTbl), &dss_dataOut_val);
   if ( pAttr != NULL )
   {
+    // Send the data over BLE notifications to every connection that has
+    // registered for them, split to chunks of each connection's MTU size
+    status = GATTServApp_SendNotiIndAll( dss_dataOut_config, pAttr, pValue, len,
+                                         FALSE, 0, GATT_NOTI_IND_SEGMENT );
 
-    // Check the ccc value for each BLE connection
-    for ( i = 0; i < MAX_NUM_BLE_CONNS; i++ )
+    if ( status != SUCCESS )
     {
-      gattCharCfg_t *pItem = &( dss_dataOut_config[i] );
-
-      // If the connection has register for notifications
-      if ( ( pItem->connHandle != LINKDB_CONNHANDLE_INVALID ) &&
-           ( pItem->value == GATT_CLIENT_CFG_NOTIFY) )
-      {
-        // Find out what the maximum MTU size is for each connection
-        status = linkDB_GetInfo(pItem->connHandle, &connInfo);
-        offset = 0;
-
-        while ( status != bleTimeout && status != bleNotConnected &&  len > offset )
-        {
-          // Determine allocation size
-          uint16_t allocLen = (len - offset);
-          if ( allocLen > ( connInfo.MTU - DSS_NOTI_HDR_SIZE ) )
-          {
-            // If len > MTU split data to chunks of MTU size
-            allocLen = connInfo.MTU - DSS_NOTI_HDR_SIZE;
-          }
-
-          noti.len = allocLen;
-          noti.pValue = (uint8 *)GATT_bm_alloc( pItem->connHandle, ATT_HANDLE_VALUE_NOTI, allocLen, 0 );
-          if ( noti.pValue != NULL )
-          {
-            // If allocation was successful, copy out data and send it
-            memcpy(noti.pValue, pValue + offset, noti.len);
-            noti.handle = pAttr->handle;
-
-            // Send the data over BLE notifications
-            status = GATT_Notification( pItem->connHandle, &noti, FALSE );
-
-            // If unable to send the data, free allocated buffers and return
-            if ( status != SUCCESS )
-            {
-              GATT_bm_free( (gattMsg_t *)&noti, ATT_HANDLE_VALUE_NOTI );
-
-              // Failed to send notification, print error message
-              MenuModule_printf(APP_MENU_PROFILE_STATUS_LINE4, 0,
-                                "Failed to send notification - Error: " MENU_MODULE_COLOR_RED "%d " MENU_MODULE_COLOR_RESET,
-                                 status);
-            }
-            else
-            {
-              // Increment data offset
-              offset += allocLen;
-
-              // Notification sent
-              MenuModule_printf(APP_MENU_PROFILE_STATUS_LINE4, 0,
-                                "Notification sent");
-            }
-          }
-          else
-          {
-            status = bleNoResources;
-          }
-        } // End of while
-      }
-    } // End of for
+      // Failed to send notification, print error message
+      MenuModule_printf(APP_MENU_PROFILE_STATUS_LINE4, 0,
+                        "Failed to send notification - Error: " MENU_MODULE_COLOR_RED "%d " MENU_MODULE_COLOR_RESET,
+                         status);
+    }
+    else
+    {
+      // Notification sent
+      MenuModule_printf(APP_MENU_PROFILE_STATUS_LINE4, 0,
+                        "Notification sent");
+    }
   } // End of if
 
   // Return status value
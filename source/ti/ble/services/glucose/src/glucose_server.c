@@ -215,10 +215,10 @@ bStatus_t GLS_addService( void )
   }
 
   // Register GATT attribute list and CBs with GATT Server
-  status = GATTServApp_RegisterService( gls_attrTbl,
-                                        GATT_NUM_ATTRS( gls_attrTbl ),
-                                        GATT_MAX_ENCRYPT_KEY_SIZE,
-                                        &gls_servCB );
+  status = GATTServApp_RegisterIndexedService( gls_attrTbl,
+                                               GATT_NUM_ATTRS( gls_attrTbl ),
+                                               GATT_MAX_ENCRYPT_KEY_SIZE,
+                                               &gls_servCB );
 
   // Return status value
   return ( status );
@@ -248,10 +248,10 @@ bStatus_t OAD_AddService(oadServiceCB_t pfnOadServiceCB)
         // Register a write callback function.
         oadWriteCB = pfnOadServiceCB;
 
-        status = GATTServApp_RegisterService(oadAttrTbl,
-                                            GATT_NUM_ATTRS(oadAttrTbl),
-                                            GATT_MAX_ENCRYPT_KEY_SIZE,
-                                            &oadServiceCBs);
+        status = GATTServApp_RegisterIndexedService(oadAttrTbl,
+                                                   GATT_NUM_ATTRS(oadAttrTbl),
+                                                   GATT_MAX_ENCRYPT_KEY_SIZE,
+                                                   &oadServiceCBs);
     }
     else
     {
@@ -63,9 +63,55 @@
 #define START_PTR( bd_ptr )  ( (bd_ptr) + 1 )
 #define END_PTR( bd_ptr )    ( (uint8 *)START_PTR( bd_ptr ) + (bd_ptr)->payload_len )
 
+// Distance between two blocks of a pool with 'size' byte payloads
+#define BM_POOL_STRIDE( size )  ( sizeof( bm_desc_t ) + ( ( (size) + 3 ) & ~3 ) )
+
 /*********************************************************************
  * CONSTANTS
  */
+// Number of buffers whose descriptor can be found in constant time from
+// the pointer returned by osal_bm_alloc() or by the last call to
+// osal_bm_adjust_header(). Other pointers inside these buffers, and
+// buffers allocated beyond this number, are found by a search. Maximum
+// is 254.
+#ifndef OSAL_BM_MAX_BUFFERS
+#define OSAL_BM_MAX_BUFFERS       16
+#endif // OSAL_BM_MAX_BUFFERS
+
+// Optional fixed size buffer pools. A request is served by the first pool
+// whose block size fits it and which has a free block, otherwise by the
+// heap. Pool buffers are found in constant time from any payload pointer,
+// including pointers moved by osal_bm_adjust_header(). Pool 1 should hold
+// the smaller blocks. Maximum number of blocks per pool is 255.
+#ifndef OSAL_BM_POOL1_BLOCK_SIZE
+#define OSAL_BM_POOL1_BLOCK_SIZE  0
+#endif // OSAL_BM_POOL1_BLOCK_SIZE
+
+#ifndef OSAL_BM_POOL1_NUM_BLOCKS
+#define OSAL_BM_POOL1_NUM_BLOCKS  0
+#endif // OSAL_BM_POOL1_NUM_BLOCKS
+
+#ifndef OSAL_BM_POOL2_BLOCK_SIZE
+#define OSAL_BM_POOL2_BLOCK_SIZE  0
+#endif // OSAL_BM_POOL2_BLOCK_SIZE
+
+#ifndef OSAL_BM_POOL2_NUM_BLOCKS
+#define OSAL_BM_POOL2_NUM_BLOCKS  0
+#endif // OSAL_BM_POOL2_NUM_BLOCKS
+
+#if ( OSAL_BM_POOL1_BLOCK_SIZE > 0 ) && ( OSAL_BM_POOL1_NUM_BLOCKS > 0 )
+#define BM_POOL1_ENABLED
+#endif
+
+#if ( OSAL_BM_POOL2_BLOCK_SIZE > 0 ) && ( OSAL_BM_POOL2_NUM_BLOCKS > 0 )
+#define BM_POOL2_ENABLED
+#endif
+
+// Descriptor not registered in bm_slots
+#define BM_NO_SLOT                0xFF
+
+// Entries of bm_adj_table, at most half of them are in use
+#define BM_ADJ_TABLE_SIZE         ( 2 * OSAL_BM_MAX_BUFFERS )
 
 /*********************************************************************
  * TYPEDEFS
@@ -74,8 +120,22 @@ typedef struct bm_desc
 {
   struct bm_desc *next_ptr;    // pointer to next buffer descriptor
   uint16          payload_len; // length of user's buffer
+  uint8           slot;        // index in bm_slots, BM_NO_SLOT if none
+  uint8           pool;        // index of owning pool + 1, 0 for heap
 } bm_desc_t;
 
+#if defined( BM_POOL1_ENABLED ) || defined( BM_POOL2_ENABLED )
+typedef struct
+{
+  uint8     *base_ptr;   // first block of the pool
+  bm_desc_t *free_ptr;   // released blocks
+  uint16     block_size; // payload bytes per block
+  uint16     stride;     // bytes from one block to the next
+  uint8      num_blocks; // blocks in the pool
+  uint8      num_used;   // blocks handed out at least once
+} bm_pool_t;
+#endif
+
 /*********************************************************************
  * GLOBAL VARIABLES
  */
@@ -88,14 +148,66 @@ extern void llHealthUpdateWrapperForOsal(void);
 /*********************************************************************
  * LOCAL VARIABLES
  */
-// Linked list of allocated buffer descriptors
+// Linked list of allocated buffer descriptors without a slot
 static bm_desc_t *bm_list_ptr = NULL;
+
+// Allocated buffer descriptors, indexed by their 'slot'
+static bm_desc_t *bm_slots[OSAL_BM_MAX_BUFFERS];
+
+// Free entries of bm_slots
+static uint8 bm_free_slots[OSAL_BM_MAX_BUFFERS];
+static uint8 bm_num_free_slots;
+
+// Entries of bm_slots handed out at least once
+static uint8 bm_num_used_slots;
+
+// Payload pointer returned by the last osal_bm_adjust_header() call for
+// each entry of bm_slots, NULL if it is the pointer returned at allocation
+static uint8 *bm_adj_ptrs[OSAL_BM_MAX_BUFFERS];
+
+// Open addressing hash table of the bm_adj_ptrs entries in use, keyed by
+// the adjusted pointer. Holds the slot + 1, 0 if free.
+static uint8 bm_adj_table[BM_ADJ_TABLE_SIZE];
+
+#ifdef BM_POOL1_ENABLED
+static uint32 bm_pool1_mem[( OSAL_BM_POOL1_NUM_BLOCKS *
+                             BM_POOL_STRIDE( OSAL_BM_POOL1_BLOCK_SIZE ) ) / sizeof( uint32 )];
+#endif // BM_POOL1_ENABLED
+
+#ifdef BM_POOL2_ENABLED
+static uint32 bm_pool2_mem[( OSAL_BM_POOL2_NUM_BLOCKS *
+                             BM_POOL_STRIDE( OSAL_BM_POOL2_BLOCK_SIZE ) ) / sizeof( uint32 )];
+#endif // BM_POOL2_ENABLED
+
+#if defined( BM_POOL1_ENABLED ) || defined( BM_POOL2_ENABLED )
+static bm_pool_t bm_pools[] =
+{
+#ifdef BM_POOL1_ENABLED
+  { (uint8 *)bm_pool1_mem, NULL, OSAL_BM_POOL1_BLOCK_SIZE,
+    BM_POOL_STRIDE( OSAL_BM_POOL1_BLOCK_SIZE ), OSAL_BM_POOL1_NUM_BLOCKS, 0 },
+#endif // BM_POOL1_ENABLED
+#ifdef BM_POOL2_ENABLED
+  { (uint8 *)bm_pool2_mem, NULL, OSAL_BM_POOL2_BLOCK_SIZE,
+    BM_POOL_STRIDE( OSAL_BM_POOL2_BLOCK_SIZE ), OSAL_BM_POOL2_NUM_BLOCKS, 0 },
+#endif // BM_POOL2_ENABLED
+};
+
+#define BM_NUM_POOLS  ( sizeof( bm_pools ) / sizeof( bm_pools[0] ) )
+#endif
+
 // pre release callback
 bm_notify_t bm_preReleaseBuffCB = NULL;
 /*********************************************************************
  * LOCAL FUNCTIONS
  */
 static bm_desc_t *bm_desc_from_payload ( uint8 *payload_ptr );
+static bm_desc_t *bm_find_desc( uint8 *payload_ptr );
+static bm_desc_t *bm_alloc_desc( uint16 size );
+static void bm_free_desc( bm_desc_t *bd_ptr );
+static uint16 bm_adj_hash( uint8 *payload_ptr );
+static bm_desc_t *bm_adj_find( uint8 *payload_ptr );
+static void bm_adj_set( bm_desc_t *bd_ptr, uint8 *payload_ptr );
+static void bm_adj_clear( uint8 slot );
 
 /*********************************************************************
  * @fn      osal_bm_reg_callback
@@ -142,17 +254,10 @@ void *osal_bm_alloc( uint16 size )
 
   HAL_ENTER_CRITICAL_SECTION(cs);
 
-  bd_ptr = osal_mem_alloc( allocSize );
+  bd_ptr = bm_alloc_desc( size );
 
   if ( bd_ptr != NULL )
   {
-    // set the buffer descriptor info
-    bd_ptr->payload_len  = size;
-
-    // add item to the beginning of the list
-    bd_ptr->next_ptr = bm_list_ptr;
-    bm_list_ptr = bd_ptr;
-
     // return start of the buffer
     bd_ptr = START_PTR( bd_ptr );
   }
@@ -174,8 +279,7 @@ void *osal_bm_alloc( uint16 size )
 void osal_bm_free( void *payload_ptr )
 {
   halIntState_t cs;
-  bm_desc_t *loop_ptr;
-  bm_desc_t *prev_ptr;
+  bm_desc_t *bd_ptr;
 
   if (NULL == payload_ptr)
   {
@@ -213,35 +317,11 @@ void osal_bm_free( void *payload_ptr )
     }
   }
 
-  prev_ptr = NULL;
-
-  loop_ptr = bm_list_ptr;
-  while ( loop_ptr != NULL )
+  bd_ptr = bm_find_desc( (uint8 *)payload_ptr );
+  if ( bd_ptr != NULL )
   {
-    if ( payload_ptr >= (void *)START_PTR( loop_ptr ) &&
-         payload_ptr <= (void *)END_PTR( loop_ptr) )
-    {
-      // unlink item from the linked list
-      if ( prev_ptr == NULL )
-      {
-        // it's the first item on the list
-        bm_list_ptr = loop_ptr->next_ptr;
-      }
-      else
-      {
-        prev_ptr->next_ptr = loop_ptr->next_ptr;
-      }
-
-      // free the memory
-      osal_mem_free( loop_ptr );
-
-      // we're done here
-      break;
-    }
-
-    // move on to next item
-    prev_ptr = loop_ptr;
-    loop_ptr = loop_ptr->next_ptr;
+    // free the memory
+    bm_free_desc( bd_ptr );
   }
 
   HAL_EXIT_CRITICAL_SECTION(cs);
@@ -262,10 +342,13 @@ void osal_bm_free( void *payload_ptr )
  */
 void *osal_bm_adjust_header( void *payload_ptr, int16 size )
 {
+  halIntState_t cs;
   bm_desc_t *bd_ptr;
   uint8 *new_payload_ptr;
 
-  bd_ptr = bm_desc_from_payload( (uint8 *)payload_ptr );
+  HAL_ENTER_CRITICAL_SECTION(cs);
+
+  bd_ptr = bm_find_desc( (uint8 *)payload_ptr );
   if ( bd_ptr != NULL )
   {
     new_payload_ptr = (uint8 *)( (uint8 *)payload_ptr - size );
@@ -274,11 +357,18 @@ void *osal_bm_adjust_header( void *payload_ptr, int16 size )
     if ( new_payload_ptr >= (uint8 *)START_PTR( bd_ptr ) &&
          new_payload_ptr <= (uint8 *)END_PTR( bd_ptr ) )
     {
+      // the new pointer is the one the buffer will be freed with
+      bm_adj_set( bd_ptr, new_payload_ptr );
+
+      HAL_EXIT_CRITICAL_SECTION(cs);
+
       // return new payload pointer
       return ( (void *)new_payload_ptr );
     }
   }
 
+  HAL_EXIT_CRITICAL_SECTION(cs);
+
   // return original value
   return ( payload_ptr );
 }
@@ -329,27 +419,383 @@ void *osal_bm_adjust_tail( void *payload_ptr, int16 size )
 static bm_desc_t *bm_desc_from_payload ( uint8 *payload_ptr )
 {
   halIntState_t cs;
-  bm_desc_t *loop_ptr;
+  bm_desc_t *bd_ptr;
 
   HAL_ENTER_CRITICAL_SECTION(cs);
 
-  loop_ptr = bm_list_ptr;
-  while ( loop_ptr != NULL )
+  bd_ptr = bm_find_desc( payload_ptr );
+
+  HAL_EXIT_CRITICAL_SECTION(cs);
+
+  return ( bd_ptr );
+}
+
+/*********************************************************************
+ * @fn      bm_find_desc
+ *
+ * @brief   Find buffer descriptor from any pointer inside its payload.
+ *          Pool buffers, and heap buffers with a slot through the pointer
+ *          returned at allocation or by the last header adjustment, are
+ *          found in constant time. Other pointers are searched for.
+ *          Interrupts must be disabled.
+ *
+ * @param   payload_ptr - pointer to payload
+ *
+ * @return  pointer to buffer descriptor, NULL if not found
+ */
+static bm_desc_t *bm_find_desc( uint8 *payload_ptr )
+{
+  bm_desc_t *bd_ptr;
+  uint8 i;
+
+#if defined( BM_POOL1_ENABLED ) || defined( BM_POOL2_ENABLED )
+  for ( i = 0; i < BM_NUM_POOLS; i++ )
   {
-    if ( payload_ptr >= (uint8 *)START_PTR( loop_ptr ) &&
-         payload_ptr <= (uint8 *)END_PTR( loop_ptr) )
+    bm_pool_t *pool_ptr = &bm_pools[i];
+
+    if ( ( payload_ptr > pool_ptr->base_ptr ) &&
+         ( payload_ptr <= pool_ptr->base_ptr + (uint32)pool_ptr->num_blocks * pool_ptr->stride ) )
+    {
+      // block holding the pointer, the end of a full block being the start
+      // of the next one
+      bd_ptr = (bm_desc_t *)( pool_ptr->base_ptr +
+                              ( ( payload_ptr - 1 - pool_ptr->base_ptr ) / pool_ptr->stride ) * pool_ptr->stride );
+
+      if ( ( bd_ptr->pool == i + 1 ) &&
+           payload_ptr >= (uint8 *)START_PTR( bd_ptr ) &&
+           payload_ptr <= (uint8 *)END_PTR( bd_ptr ) )
+      {
+        return ( bd_ptr );
+      }
+
+      return ( NULL );
+    }
+  }
+#endif
+
+  // descriptor sits right before the payload unless the header was adjusted
+  bd_ptr = (bm_desc_t *)payload_ptr - 1;
+  if ( ( bd_ptr->slot < bm_num_used_slots ) && ( bm_slots[bd_ptr->slot] == bd_ptr ) )
+  {
+    return ( bd_ptr );
+  }
+
+  bd_ptr = bm_adj_find( payload_ptr );
+  if ( bd_ptr != NULL )
+  {
+    return ( bd_ptr );
+  }
+
+  // any other pointer inside a buffer, e.g. a payload offset set by the
+  // allocating layer
+  for ( i = 0; i < bm_num_used_slots; i++ )
+  {
+    bd_ptr = bm_slots[i];
+    if ( ( bd_ptr != NULL ) &&
+         payload_ptr >= (uint8 *)START_PTR( bd_ptr ) &&
+         payload_ptr <= (uint8 *)END_PTR( bd_ptr ) )
+    {
+      return ( bd_ptr );
+    }
+  }
+
+  bd_ptr = bm_list_ptr;
+  while ( bd_ptr != NULL )
+  {
+    if ( payload_ptr >= (uint8 *)START_PTR( bd_ptr ) &&
+         payload_ptr <= (uint8 *)END_PTR( bd_ptr) )
     {
       // item found
       break;
     }
 
     // move on to next item
-    loop_ptr = loop_ptr->next_ptr;
+    bd_ptr = bd_ptr->next_ptr;
   }
 
-  HAL_EXIT_CRITICAL_SECTION(cs);
+  return ( bd_ptr );
+}
+
+/*********************************************************************
+ * @fn      bm_alloc_desc
+ *
+ * @brief   Allocate a buffer from a pool or from the heap and register
+ *          its descriptor. Interrupts must be disabled.
+ *
+ * @param   size - number of payload bytes
+ *
+ * @return  pointer to buffer descriptor, NULL if out of memory
+ */
+static bm_desc_t *bm_alloc_desc( uint16 size )
+{
+  bm_desc_t *bd_ptr = NULL;
+
+#if defined( BM_POOL1_ENABLED ) || defined( BM_POOL2_ENABLED )
+  uint8 i;
+
+  for ( i = 0; ( i < BM_NUM_POOLS ) && ( bd_ptr == NULL ); i++ )
+  {
+    bm_pool_t *pool_ptr = &bm_pools[i];
+
+    if ( size > pool_ptr->block_size )
+    {
+      continue;
+    }
+
+    if ( pool_ptr->free_ptr != NULL )
+    {
+      bd_ptr = pool_ptr->free_ptr;
+      pool_ptr->free_ptr = bd_ptr->next_ptr;
+    }
+    else if ( pool_ptr->num_used < pool_ptr->num_blocks )
+    {
+      bd_ptr = (bm_desc_t *)( pool_ptr->base_ptr + (uint32)pool_ptr->num_used * pool_ptr->stride );
+      pool_ptr->num_used++;
+    }
+
+    if ( bd_ptr != NULL )
+    {
+      bd_ptr->payload_len = size;
+      bd_ptr->slot        = BM_NO_SLOT;
+      bd_ptr->pool        = i + 1;
+      bd_ptr->next_ptr    = NULL;
+
+      return ( bd_ptr );
+    }
+  }
+#endif
+
+  bd_ptr = osal_mem_alloc( sizeof( bm_desc_t ) + size );
+
+  if ( bd_ptr != NULL )
+  {
+    // set the buffer descriptor info
+    bd_ptr->payload_len = size;
+    bd_ptr->pool        = 0;
+    bd_ptr->next_ptr    = NULL;
+
+    if ( bm_num_free_slots > 0 )
+    {
+      bd_ptr->slot = bm_free_slots[--bm_num_free_slots];
+    }
+    else if ( bm_num_used_slots < OSAL_BM_MAX_BUFFERS )
+    {
+      bd_ptr->slot = bm_num_used_slots++;
+    }
+    else
+    {
+      bd_ptr->slot = BM_NO_SLOT;
+    }
+
+    if ( bd_ptr->slot != BM_NO_SLOT )
+    {
+      bm_slots[bd_ptr->slot] = bd_ptr;
+    }
+    else
+    {
+      // add item to the beginning of the list
+      bd_ptr->next_ptr = bm_list_ptr;
+      bm_list_ptr = bd_ptr;
+    }
+  }
+
+  return ( bd_ptr );
+}
+
+/*********************************************************************
+ * @fn      bm_free_desc
+ *
+ * @brief   Unregister a buffer descriptor and return the buffer to its
+ *          pool or to the heap. Interrupts must be disabled.
+ *
+ * @param   bd_ptr - pointer to buffer descriptor
+ *
+ * @return  none
+ */
+static void bm_free_desc( bm_desc_t *bd_ptr )
+{
+#if defined( BM_POOL1_ENABLED ) || defined( BM_POOL2_ENABLED )
+  if ( bd_ptr->pool != 0 )
+  {
+    bm_pool_t *pool_ptr = &bm_pools[bd_ptr->pool - 1];
+
+    bd_ptr->pool = 0;
+    bd_ptr->next_ptr = pool_ptr->free_ptr;
+    pool_ptr->free_ptr = bd_ptr;
+
+    return;
+  }
+#endif
+
+  if ( bd_ptr->slot != BM_NO_SLOT )
+  {
+    if ( bm_adj_ptrs[bd_ptr->slot] != NULL )
+    {
+      bm_adj_clear( bd_ptr->slot );
+    }
+
+    bm_slots[bd_ptr->slot] = NULL;
+    bm_free_slots[bm_num_free_slots++] = bd_ptr->slot;
+  }
+  else
+  {
+    bm_desc_t *loop_ptr = bm_list_ptr;
+    bm_desc_t *prev_ptr = NULL;
+
+    while ( loop_ptr != bd_ptr )
+    {
+      prev_ptr = loop_ptr;
+      loop_ptr = loop_ptr->next_ptr;
+    }
+
+    // unlink item from the linked list
+    if ( prev_ptr == NULL )
+    {
+      // it's the first item on the list
+      bm_list_ptr = bd_ptr->next_ptr;
+    }
+    else
+    {
+      prev_ptr->next_ptr = bd_ptr->next_ptr;
+    }
+  }
+
+  osal_mem_free( bd_ptr );
+}
+
+/*********************************************************************
+ * @fn      bm_adj_hash
+ *
+ * @brief   Home entry of an adjusted payload pointer in bm_adj_table.
+ *
+ * @param   payload_ptr - adjusted payload pointer
+ *
+ * @return  index in bm_adj_table
+ */
+static uint16 bm_adj_hash( uint8 *payload_ptr )
+{
+  // multiplicative hash, scaled to the table size without a division
+  uint32_t hash = ( (uint32_t)payload_ptr * 2654435761u ) >> 16;
+
+  return ( (uint16)( ( hash * BM_ADJ_TABLE_SIZE ) >> 16 ) );
+}
+
+/*********************************************************************
+ * @fn      bm_adj_find
+ *
+ * @brief   Find the heap buffer whose header was last adjusted to a
+ *          payload pointer. Interrupts must be disabled.
+ *
+ * @param   payload_ptr - pointer to payload
+ *
+ * @return  pointer to buffer descriptor, NULL if not found
+ */
+static bm_desc_t *bm_adj_find( uint8 *payload_ptr )
+{
+  uint16 i = bm_adj_hash( payload_ptr );
+
+  // the table is never full, so there is always a free entry to stop at
+  while ( bm_adj_table[i] != 0 )
+  {
+    uint8 slot = bm_adj_table[i] - 1;
+
+    if ( bm_adj_ptrs[slot] == payload_ptr )
+    {
+      return ( bm_slots[slot] );
+    }
+
+    i = ( i + 1 < BM_ADJ_TABLE_SIZE ) ? ( i + 1 ) : 0;
+  }
+
+  return ( NULL );
+}
+
+/*********************************************************************
+ * @fn      bm_adj_set
+ *
+ * @brief   Record the adjusted payload pointer of a buffer. Only heap
+ *          buffers with a slot are recorded, pool buffers are found from
+ *          any payload pointer. Interrupts must be disabled.
+ *
+ * @param   bd_ptr - pointer to buffer descriptor
+ * @param   payload_ptr - adjusted payload pointer
+ *
+ * @return  none
+ */
+static void bm_adj_set( bm_desc_t *bd_ptr, uint8 *payload_ptr )
+{
+  uint16 i;
+
+  if ( bd_ptr->slot == BM_NO_SLOT )
+  {
+    return;
+  }
+
+  if ( bm_adj_ptrs[bd_ptr->slot] != NULL )
+  {
+    bm_adj_clear( bd_ptr->slot );
+  }
+
+  // the pointer returned at allocation is found without the table
+  if ( payload_ptr == (uint8 *)START_PTR( bd_ptr ) )
+  {
+    return;
+  }
+
+  i = bm_adj_hash( payload_ptr );
+  while ( bm_adj_table[i] != 0 )
+  {
+    i = ( i + 1 < BM_ADJ_TABLE_SIZE ) ? ( i + 1 ) : 0;
+  }
+
+  bm_adj_table[i] = bd_ptr->slot + 1;
+  bm_adj_ptrs[bd_ptr->slot] = payload_ptr;
+}
+
+/*********************************************************************
+ * @fn      bm_adj_clear
+ *
+ * @brief   Remove the adjusted payload pointer of a slot from
+ *          bm_adj_table. Later entries of the same probe sequence are
+ *          moved back, so that lookups need no deleted markers.
+ *          Interrupts must be disabled.
+ *
+ * @param   slot - entry of bm_slots with an adjusted pointer
+ *
+ * @return  none
+ */
+static void bm_adj_clear( uint8 slot )
+{
+  uint16 i = bm_adj_hash( bm_adj_ptrs[slot] );
+  uint16 j;
+
+  while ( bm_adj_table[i] != slot + 1 )
+  {
+    i = ( i + 1 < BM_ADJ_TABLE_SIZE ) ? ( i + 1 ) : 0;
+  }
+
+  for ( j = i; ; )
+  {
+    uint16 home;
+
+    j = ( j + 1 < BM_ADJ_TABLE_SIZE ) ? ( j + 1 ) : 0;
+    if ( bm_adj_table[j] == 0 )
+    {
+      break;
+    }
+
+    // move the entry into the hole unless its home lies between them
+    home = bm_adj_hash( bm_adj_ptrs[bm_adj_table[j] - 1] );
+    if ( ( i <= j ) ? ( ( home <= i ) || ( home > j ) )
+                    : ( ( home <= i ) && ( home > j ) ) )
+    {
+      bm_adj_table[i] = bm_adj_table[j];
+      i = j;
+    }
+  }
 
-  return ( loop_ptr );
+  bm_adj_table[i] = 0;
+  bm_adj_ptrs[slot] = NULL;
 }
 
 
@@ -63,6 +63,12 @@
  */
 #define MILLS_IN_MICROS                   1000
 
+// Number of preallocated timer records. Timers beyond this number are
+// allocated from the OSAL heap.
+#ifndef OSAL_TIMERS_POOL_SIZE
+#define OSAL_TIMERS_POOL_SIZE             8
+#endif // OSAL_TIMERS_POOL_SIZE
+
 /*********************************************************************
  * TYPEDEFS
  */
@@ -73,6 +79,9 @@ typedef union {
   uint8 time8[4];
 } osalTime_t;
 
+// Timers are kept sorted by expiry. The timeout of each record is relative
+// to the expiry of the record before it, so the head holds the time to the
+// next expiry and a tick update only touches the timers that expire.
 typedef struct
 {
   void   *next;
@@ -105,12 +114,27 @@ uint_least32_t osal_last_timestamp;
 // Milliseconds since last reboot
 static uint32 osal_systemClock;
 
+#if OSAL_TIMERS_POOL_SIZE > 0
+// Preallocated timer records
+static osalTimerRec_t osalTimerPool[OSAL_TIMERS_POOL_SIZE];
+
+// Released pool records
+static osalTimerRec_t *osalTimerFreeList;
+
+// Number of pool records handed out at least once
+static uint8 osalTimerPoolUsed;
+#endif // OSAL_TIMERS_POOL_SIZE
+
 /*********************************************************************
  * LOCAL FUNCTION PROTOTYPES
  */
 osalTimerRec_t  *osalAddTimer( uint8 task_id, uint32 event_flag, uint32 timeout );
 osalTimerRec_t *osalFindTimer( uint8 task_id, uint32 event_flag );
 void osalDeleteTimer( osalTimerRec_t *rmTimer );
+static osalTimerRec_t *osalTimerAlloc( void );
+static void osalTimerFree( osalTimerRec_t *rmTimer );
+static void osalInsertTimer( osalTimerRec_t *newTimer );
+static void osalRemoveTimer( osalTimerRec_t *rmTimer );
 
 /*********************************************************************
  * FUNCTIONS
@@ -133,6 +157,150 @@ void osalTimerInit( void )
   osal_last_timestamp = (uint_least32_t) ICall_getTicks();
 }
 
+/*********************************************************************
+ * @fn      osalTimerAlloc
+ *
+ * @brief   Get a timer record, from the pool when one is free.
+ *          Ints must be disabled.
+ *
+ * @param   none
+ *
+ * @return  osalTimerRec_t * - timer record or NULL
+ */
+static osalTimerRec_t *osalTimerAlloc( void )
+{
+#if OSAL_TIMERS_POOL_SIZE > 0
+  osalTimerRec_t *newTimer;
+
+  if ( osalTimerFreeList != NULL )
+  {
+    newTimer = osalTimerFreeList;
+    osalTimerFreeList = newTimer->next;
+
+    return ( newTimer );
+  }
+
+  if ( osalTimerPoolUsed < OSAL_TIMERS_POOL_SIZE )
+  {
+    return ( &osalTimerPool[osalTimerPoolUsed++] );
+  }
+#endif // OSAL_TIMERS_POOL_SIZE
+
+  return ( osal_mem_alloc( sizeof( osalTimerRec_t ) ) );
+}
+
+/*********************************************************************
+ * @fn      osalTimerFree
+ *
+ * @brief   Release a timer record obtained with osalTimerAlloc().
+ *          Ints must be disabled.
+ *
+ * @param   rmTimer
+ *
+ * @return  none
+ */
+static void osalTimerFree( osalTimerRec_t *rmTimer )
+{
+#if OSAL_TIMERS_POOL_SIZE > 0
+  if ( (rmTimer >= &osalTimerPool[0]) &&
+       (rmTimer < &osalTimerPool[OSAL_TIMERS_POOL_SIZE]) )
+  {
+    rmTimer->next = osalTimerFreeList;
+    osalTimerFreeList = rmTimer;
+
+    return;
+  }
+#endif // OSAL_TIMERS_POOL_SIZE
+
+  osal_mem_free( rmTimer );
+}
+
+/*********************************************************************
+ * @fn      osalInsertTimer
+ *
+ * @brief   Insert a timer in the sorted timer list. The timer's timeout
+ *          is given from now and is converted to the time after the
+ *          timer ahead of it. Timers with the same expiry stay in the
+ *          order they were inserted.
+ *          Ints must be disabled.
+ *
+ * @param   newTimer
+ *
+ * @return  none
+ */
+static void osalInsertTimer( osalTimerRec_t *newTimer )
+{
+  osalTimerRec_t *srchTimer = timerHead;
+  osalTimerRec_t *prevTimer = NULL;
+  uint32 timeout = newTimer->timeout.time32;
+
+  // Skip the timers expiring no later than this one
+  while ( (srchTimer != NULL) && (srchTimer->timeout.time32 <= timeout) )
+  {
+    timeout -= srchTimer->timeout.time32;
+    prevTimer = srchTimer;
+    srchTimer = srchTimer->next;
+  }
+
+  newTimer->timeout.time32 = timeout;
+  newTimer->next = srchTimer;
+
+  if ( srchTimer != NULL )
+  {
+    // Next timer now expires relative to this one
+    srchTimer->timeout.time32 -= timeout;
+  }
+
+  if ( prevTimer == NULL )
+  {
+    timerHead = newTimer;
+  }
+  else
+  {
+    prevTimer->next = newTimer;
+  }
+}
+
+/*********************************************************************
+ * @fn      osalRemoveTimer
+ *
+ * @brief   Take a timer out of the timer list, without freeing it.
+ *          Ints must be disabled.
+ *
+ * @param   rmTimer
+ *
+ * @return  none
+ */
+static void osalRemoveTimer( osalTimerRec_t *rmTimer )
+{
+  osalTimerRec_t *srchTimer = timerHead;
+  osalTimerRec_t *prevTimer = NULL;
+
+  while ( (srchTimer != NULL) && (srchTimer != rmTimer) )
+  {
+    prevTimer = srchTimer;
+    srchTimer = srchTimer->next;
+  }
+
+  if ( srchTimer != NULL )
+  {
+    if ( rmTimer->next != NULL )
+    {
+      // Give the remaining time to the next timer
+      ((osalTimerRec_t *)rmTimer->next)->timeout.time32 += rmTimer->timeout.time32;
+    }
+
+    if ( prevTimer == NULL )
+    {
+      timerHead = rmTimer->next;
+    }
+    else
+    {
+      prevTimer->next = rmTimer->next;
+    }
+  }
+}
+
 /*********************************************************************
  * @fn      osalAddTimer
  *
@@ -148,21 +316,22 @@ void osalTimerInit( void )
 osalTimerRec_t * osalAddTimer( uint8 task_id, uint32 event_flag, uint32 timeout )
 {
   osalTimerRec_t *newTimer;
-  osalTimerRec_t *srchTimer;
 
   // Look for an existing timer first
   newTimer = osalFindTimer( task_id, event_flag );
   if ( newTimer )
   {
-    // Timer is found - update it.
+    // Timer is found - move it to its new position.
+    osalRemoveTimer( newTimer );
     newTimer->timeout.time32 = timeout;
+    osalInsertTimer( newTimer );
 
     return ( newTimer );
   }
   else
   {
     // New Timer
-    newTimer = osal_mem_alloc( sizeof( osalTimerRec_t ) );
+    newTimer = osalTimerAlloc();
 
     if ( newTimer )
     {
@@ -170,27 +339,10 @@ osalTimerRec_t * osalAddTimer( uint8 task_id, uint32 event_flag, uint32 timeout
       newTimer->task_id = task_id;
       newTimer->event_flag = event_flag;
       newTimer->timeout.time32 = timeout;
-      newTimer->next = (void *)NULL;
       newTimer->reloadTimeout = 0;
 
-      // Does the timer list already exist
-      if ( timerHead == NULL )
-      {
-        // Start task list
-        timerHead = newTimer;
-      }
-      else
-      {
-        // Add it to the end of the timer list
-        srchTimer = timerHead;
-
-        // Stop at the last record
-        while ( srchTimer->next )
-          srchTimer = srchTimer->next;
-
-        // Add to the list
-        srchTimer->next = newTimer;
-      }
+      // Add it in expiry order
+      osalInsertTimer( newTimer );
 
       return ( newTimer );
     }
@@ -239,8 +391,8 @@ osalTimerRec_t *osalFindTimer( uint8 task_id, uint32 event_flag )
  * @fn      osalDeleteTimer
  *
  * @brief   Delete a timer from a timer list.
+ *          Ints must be disabled.
  *
- * @param   table
  * @param   rmTimer
  *
  * @return  none
@@ -250,9 +402,9 @@ void osalDeleteTimer( osalTimerRec_t *rmTimer )
   // Does the timer list really exist
   if ( rmTimer )
   {
-    // Clear the event flag and osalTimerUpdate() will delete
-    // the timer from the list.
-    rmTimer->event_flag = 0;
+    // Take it out now so the next timeout stays exact
+    osalRemoveTimer( rmTimer );
+    osalTimerFree( rmTimer );
   }
 }
 
@@ -416,11 +568,20 @@ uint32 osal_get_timeoutEx( uint8 task_id, uint16 event_id )
 
   HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
 
-  tmr = osalFindTimer( task_id, event_id );
+  // Timeouts are relative to the timer ahead, add them up
+  for ( tmr = timerHead; tmr != NULL; tmr = tmr->next )
+  {
+    rtrn += tmr->timeout.time32;
+
+    if ( (tmr->event_flag == event_id) && (tmr->task_id == task_id) )
+    {
+      break;
+    }
+  }
 
-  if ( tmr )
+  if ( tmr == NULL )
   {
-    rtrn = tmr->timeout.time32;
+    rtrn = 0;
   }
 
   HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
@@ -472,116 +633,62 @@ uint8 osal_timer_num_active( void )
 void osalTimerUpdate( uint32 updateTime )
 {
   halIntState_t intState;
-  osalTimerRec_t *srchTimer;
-  osalTimerRec_t *prevTimer;
-
-  osalTime_t timeUnion;
-  timeUnion.time32 = updateTime;
+  osalTimerRec_t *expTimer;
+  uint8 task_id;
+  uint32 event_flag;
 
   HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
   // Update the system time
   osal_systemClock += updateTime;
   HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
 
-  // Look for open timer slot
-  if ( timerHead != NULL )
+  // Only the timers at the head of the list can expire
+  for ( ;; )
   {
-    // Add it to the end of the timer list
-    srchTimer = timerHead;
-    prevTimer = (void *)NULL;
+    HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
 
-    // Look for open timer slot
-    while ( srchTimer )
+    expTimer = timerHead;
+    if ( expTimer == NULL )
     {
-      osalTimerRec_t *freeTimer = NULL;
-
-      HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
-
-      // To minimize time in this critical section, avoid 32-bit math
-      if ((timeUnion.time16[1] == 0) && (timeUnion.time8[1] == 0))
-      {
-        // If upper 24 bits are zero, check lower 8 bits for roll over
-        if (srchTimer->timeout.time8[0] >= timeUnion.time8[0])
-        {
-          // 8-bit math
-          srchTimer->timeout.time8[0] -= timeUnion.time8[0];
-        }
-        else
-        {
-          // 32-bit math
-          if (srchTimer->timeout.time32 > timeUnion.time32)
-          {
-            srchTimer->timeout.time32 -= timeUnion.time32;
-          }
-          else
-          {
-            srchTimer->timeout.time32 = 0;
-          }
-        }
-      }
-      else
-      {
-          // 32-bit math
-        if (srchTimer->timeout.time32 > timeUnion.time32)
-        {
-          srchTimer->timeout.time32 -= timeUnion.time32;
-        }
-        else
-        {
-          srchTimer->timeout.time32 = 0;
-        }
-      }
-
-      // Check for reloading
-      if ( (srchTimer->timeout.time16[0] == 0) && (srchTimer->timeout.time16[1] == 0) &&
-           (srchTimer->reloadTimeout) && (srchTimer->event_flag) )
-      {
-        // Notify the task of a timeout
-        osal_set_event( srchTimer->task_id, srchTimer->event_flag );
-
-        // Reload the timer timeout value
-        srchTimer->timeout.time32 = srchTimer->reloadTimeout;
-      }
-
-      // When timeout or delete (event_flag == 0)
-      if ( ((srchTimer->timeout.time16[0] == 0) && (srchTimer->timeout.time16[1] == 0)) ||
-            (srchTimer->event_flag == 0) )
-      {
-        // Take out of list
-        if ( prevTimer == NULL )
-        {
-          timerHead = srchTimer->next;
-        }
-        else
-        {
-          prevTimer->next = srchTimer->next;
-        }
-
-        // Setup to free memory
-        freeTimer = srchTimer;
-
-        // Next
-        srchTimer = srchTimer->next;
-      }
-      else
-      {
-        // Get next
-        prevTimer = srchTimer;
-        srchTimer = srchTimer->next;
-      }
+      HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
+      break;
+    }
 
+    if ( expTimer->timeout.time32 > updateTime )
+    {
+      // Later timers are relative to this one and need no update
+      expTimer->timeout.time32 -= updateTime;
       HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
+      break;
+    }
+
+    // Timeout - take out of list
+    updateTime -= expTimer->timeout.time32;
+    timerHead = expTimer->next;
+
+    task_id = expTimer->task_id;
+    event_flag = expTimer->event_flag;
 
-      if ( freeTimer )
-      {
-        if ( (freeTimer->timeout.time16[0] == 0) && (freeTimer->timeout.time16[1] == 0) )
-        {
-          osal_set_event( freeTimer->task_id, freeTimer->event_flag );
-        }
-        osal_mem_free( freeTimer );
-      }
+    if ( expTimer->reloadTimeout )
+    {
+      // Reload the timer timeout value while it is still held off, so it is
+      // always found by osal_stop_timerEx and osal_start_timerEx. The rest of
+      // the update is added so that it restarts from now rather than from
+      // its expiry, and can't expire again in this update.
+      expTimer->timeout.time32 = expTimer->reloadTimeout + updateTime;
+      osalInsertTimer( expTimer );
+    }
+    else
+    {
+      osalTimerFree( expTimer );
     }
+
+    HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
+
+    // Notify the task of a timeout
+    osal_set_event( task_id, event_flag );
   }
+
 }
 
 /*********************************************************************
@@ -589,8 +696,9 @@ void osalTimerUpdate( uint32 updateTime )
  *
  * @brief
  *
- *   Search timer table to return the lowest timeout value. If the
- *   timer list is empty, then the returned timeout will be zero.
+ *   Return the lowest timeout value, which is the one of the first
+ *   timer in the sorted timer list. If the timer list is empty, then
+ *   the returned timeout will be zero.
  *
  * @param   none
  *
@@ -599,24 +707,10 @@ void osalTimerUpdate( uint32 updateTime )
 uint32 osal_next_timeout( void )
 {
   uint32 nextTimeout;
-  osalTimerRec_t *srchTimer;
 
   if ( timerHead != NULL )
   {
-    // Head of the timer list
-    srchTimer = timerHead;
-    nextTimeout = OSAL_TIMERS_MAX_TIMEOUT;
-
-    // Look for the next timeout timer
-    while ( srchTimer != NULL )
-    {
-      if (srchTimer->timeout.time32 < nextTimeout)
-      {
-        nextTimeout = srchTimer->timeout.time32;
-      }
-      // Check next timer
-      srchTimer = srchTimer->next;
-    }
+    nextTimeout = timerHead->timeout.time32;
   }
   else
   {
@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== bmtest.c ========
+ *
+ * Randomized check and lookup benchmark of the osal_bm buffer manager.
+ *
+ * The check allocates, adjusts and frees buffers in random order and
+ * verifies every result against a model of the buffers:
+ *  - buffers are handed out at an offset from the allocation, as
+ *    L2CAP_bm_alloc() and the LL RX path do;
+ *  - osal_bm_adjust_header() is called on the pointer of the last
+ *    adjustment and on other pointers inside the payload;
+ *  - osal_bm_adjust_tail() must find the end of the payload from any
+ *    pointer inside it;
+ *  - buffers are freed through the allocation pointer, the last adjusted
+ *    pointer or any other pointer inside the payload.
+ * All buffers must be back on the heap or in their pool at the end.
+ *
+ * Usage:
+ *
+ *     bmtest [-s seed] [-n iterations]
+ *     bmtest -b live
+ *
+ *     -b: time a lookup with 'live' other buffers allocated.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "ti/ble/stack_util/osal/osal.h"
+#include "ti/ble/stack_util/osal/osal_bufmgr.h"
+
+#define MAX_LIVE  300
+
+typedef struct
+{
+    uint8 *alloc;   /* returned by osal_bm_alloc() */
+    uint8 *cur;     /* returned by the last osal_bm_adjust_header() */
+    uint16 len;     /* payload length */
+} Buf;
+
+static Buf bufs[MAX_LIVE];
+static int numBufs;
+static long heapLive;
+static long errors;
+static uint32_t rndState = 1;
+
+/* Stubs of the heap, ICall and LL functions used by osal_bufmgr.c */
+void *osal_mem_alloc(uint16 size)
+{
+    heapLive++;
+    return malloc(size);
+}
+
+void osal_mem_free(void *ptr)
+{
+    heapLive--;
+    free(ptr);
+}
+
+static ICall_CSState enterCS(void)
+{
+    return 0;
+}
+
+static void leaveCS(ICall_CSState key)
+{
+    (void)key;
+}
+
+ICall_EnterCS ICall_enterCriticalSection = enterCS;
+ICall_LeaveCS ICall_leaveCriticalSection = leaveCS;
+
+bool OPT_ll_healthCheckIsEnable(void)
+{
+    return false;
+}
+
+void llHealthUpdateWrapperForOsal(void)
+{
+}
+
+uint8 llQueryTxQueue(uint32 addr)
+{
+    (void)addr;
+    return FALSE;
+}
+
+static uint32_t rnd(uint32_t n)
+{
+    rndState ^= rndState << 13;
+    rndState ^= rndState >> 17;
+    rndState ^= rndState << 5;
+    return rndState % n;
+}
+
+static void fail(const char *what, Buf *b, uint8 *ptr)
+{
+    if (errors++ < 10)
+    {
+        printf("%s: len %u, pointer at offset %ld\n", what, b->len,
+               (long)(ptr - b->alloc));
+    }
+}
+
+/* Any pointer inside the payload, both ends included */
+static uint8 *interior(Buf *b)
+{
+    return b->alloc + rnd(b->len + 1);
+}
+
+static void doAlloc(void)
+{
+    Buf *b = &bufs[numBufs];
+    uint16 len = 1 + rnd(rnd(4) ? 40 : 260);
+    uint16 off = rnd(len + 1);
+
+    b->alloc = osal_bm_alloc(len);
+    if (b->alloc == NULL)
+    {
+        fail("alloc", b, NULL);
+        return;
+    }
+    memset(b->alloc, 0xA5, len);
+    b->len = len;
+
+    /* The layer that allocated it hands the buffer out at an offset */
+    b->cur = b->alloc + off;
+    numBufs++;
+}
+
+static void doAdjustHeader(Buf *b, uint8 *from)
+{
+    int16 size = (int16)(from - b->alloc) - (int16)rnd(b->len + 1);
+    uint8 *ptr = osal_bm_adjust_header(from, size);
+
+    if (ptr != from - size)
+    {
+        fail("adjust_header", b, from);
+    }
+    b->cur = ptr;
+}
+
+static void doCheckTail(Buf *b, uint8 *from)
+{
+    if (osal_bm_adjust_tail(from, 0) != b->alloc + b->len)
+    {
+        fail("adjust_tail", b, from);
+    }
+}
+
+static void doFree(int i)
+{
+    Buf *b = &bufs[i];
+    uint8 *ptr;
+
+    switch (rnd(3))
+    {
+        case 0:
+            ptr = b->alloc;
+            break;
+        case 1:
+            ptr = b->cur;
+            break;
+        default:
+            ptr = interior(b);
+            break;
+    }
+    doCheckTail(b, ptr);
+    osal_bm_free(ptr);
+    bufs[i] = bufs[--numBufs];
+}
+
+static int check(long iterations)
+{
+    long it;
+
+    for (it = 0; it < iterations; it++)
+    {
+        uint32_t op = rnd(10);
+        Buf *b;
+
+        if (numBufs == 0 || (op < 3 && numBufs < MAX_LIVE))
+        {
+            doAlloc();
+            continue;
+        }
+
+        b = &bufs[rnd(numBufs)];
+        if (op < 5)
+        {
+            doAdjustHeader(b, b->cur);
+        }
+        else if (op < 6)
+        {
+            doAdjustHeader(b, interior(b));
+        }
+        else if (op < 8)
+        {
+            doCheckTail(b, interior(b));
+        }
+        else
+        {
+            doFree(b - bufs);
+        }
+    }
+
+    while (numBufs > 0)
+    {
+        doFree(numBufs - 1);
+    }
+
+    printf("%ld iterations, %ld errors, %ld heap buffers left\n",
+           iterations, errors, heapLive);
+
+    return (errors != 0 || heapLive != 0);
+}
+
+static double now(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+static int bench(int live)
+{
+    static uint8 *keep[1000];
+    volatile uint8 *sink;
+    const int loops = 1000000;
+    uint8 *adjusted;
+    uint8 *offset;
+    uint8 *ptr;
+    double t0;
+    int i;
+
+    if (live > 1000)
+    {
+        live = 1000;
+    }
+    for (i = 0; i < live; i++)
+    {
+        keep[i] = osal_bm_alloc(64);
+    }
+
+    ptr = osal_bm_alloc(64);
+    offset = ptr + 4;
+    adjusted = osal_bm_adjust_header(ptr, -8);
+
+    t0 = now();
+    for (i = 0; i < loops; i++)
+    {
+        sink = osal_bm_adjust_tail(adjusted, 0);
+    }
+    printf("%d live: %.1f ns per lookup of the adjusted pointer", live,
+           (now() - t0) / loops);
+
+    t0 = now();
+    for (i = 0; i < loops; i++)
+    {
+        sink = osal_bm_adjust_tail(offset, 0);
+    }
+    printf(", %.1f ns of another interior pointer\n", (now() - t0) / loops);
+    (void)sink;
+
+    osal_bm_free(adjusted);
+    for (i = 0; i < live; i++)
+    {
+        osal_bm_free(keep[i]);
+    }
+
+    return (heapLive != 0);
+}
+
+int main(int argc, char *argv[])
+{
+    long iterations = 2000000;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:n:s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'b':
+                return bench(atoi(optarg));
+            case 'n':
+                iterations = atol(optarg);
+                break;
+            case 's':
+                rndState = strtoul(optarg, NULL, 0) | 1;
+                break;
+            default:
+                fprintf(stderr, "usage: bmtest [-s seed] [-n iterations] | -b live\n");
+                return 2;
+        }
+    }
+
+    return check(iterations);
+}
@@ -2,7 +2,7 @@
 
  @file  crc32.h
 
- @brief TThis module contains crc32 calculation api.
+ @brief This module contains crc32 calculation api.
 
  Group: WCS, BTS
  Target Device: cc23xx
@@ -55,8 +55,57 @@ extern "C" {
  */
 
 #include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ *                                          Constants
+ */
+
+/* Byte-at-a-time shift and XOR. Smallest footprint, no lookup table. */
+#define CRC32_ALGO_BITWISE 0
+/* One 256 entry lookup table (1 kB of flash), one byte per lookup */
+#define CRC32_ALGO_TABLE   1
+/* Four 256 entry lookup tables (4 kB of flash), four bytes per round */
+#define CRC32_ALGO_SLICE4  2
+/* Eight 256 entry lookup tables (8 kB of flash), eight bytes per round */
+#define CRC32_ALGO_SLICE8  3
+
+/* Algorithm used by CRC32_update() and CRC32_calc(). The BIM shares its flash
+ * page with the CCFG, so the default keeps the table-less implementation.
+ * Applications that verify images or large data sets at run time can trade
+ * flash for throughput by defining CRC32_ALGO as CRC32_ALGO_SLICE8.
+ */
+#ifndef CRC32_ALGO
+    #define CRC32_ALGO CRC32_ALGO_BITWISE
+#endif
+
+/* Optional hardware backend. If CRC32_HW_UPDATE is defined as the name of a
+ * function with the CRC32_update() signature, CRC32_update() forwards all data
+ * to it. The function receives and returns the running (not finalized) CRC.
+ */
+#ifdef CRC32_HW_UPDATE
+extern uint32_t CRC32_HW_UPDATE(uint32_t crc, const uint8_t *data, uint32_t len);
+#endif
+
+/* Seed for CRC32_update() */
+#define CRC32_INIT_VALUE 0xFFFFFFFFUL
+
+/*******************************************************************************
+ *                                          Macros
+ */
+
+/* Start a new CRC32 calculation */
+#define CRC32_init() (CRC32_INIT_VALUE)
+
+/* Convert a running CRC32 from CRC32_update() into the final CRC32 value */
+#define CRC32_final(crc) ((crc) ^ 0xFFFFFFFFUL)
+
+/*******************************************************************************
+ *                                          Functions
+ */
 
 extern uint32_t CRC32_value(uint32_t inCRC);
+extern uint32_t CRC32_update(uint32_t crc, const uint8_t *data, uint32_t len);
 extern uint32_t CRC32_calc(uint8_t page, uint32_t pageSize, uint16_t offset, uint32_t len, bool useExtFl);
 extern void *CRC32_memCpy(void *dest, const void *src, uint16_t len);
 
@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== crc32test.c ========
+ *
+ * Check and benchmark of the CRC32 module.
+ *
+ * crc32.c is compiled from the SDK sources with the CRC32_ALGO (or
+ * CRC32_HW_UPDATE) given on the command line and checked against a plain
+ * bitwise CRC32:
+ *
+ * - "123456789" gives 0xCBF43926
+ * - CRC32_update() gives the same result for unaligned data and for data
+ *   split across several calls
+ * - CRC32_calc() on internal flash, which is mapped to host memory at its
+ *   device address, and on external flash, which is read through
+ *   readFlashPg() below, skips the CRC section of the image header
+ * - CRC32_calc() rejects invalid lengths
+ *
+ * The benchmark prints the CRC32_update() throughput.
+ *
+ * Usage:
+ *
+ *     crc32test [kilobytes]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+
+#include "ti/common/cc26xx/crc/crc32.h"
+#include "ti/common/cc26xx/flash_interface/flash_interface.h"
+#include "ti/common/cc26xx/oad/oad_image_header.h"
+
+/* Internal flash pages mapped to host memory, starting at INT_FLASH_PAGE */
+#define INT_FLASH_PAGE  64
+#define INT_FLASH_PAGES 64
+#define INT_FLASH_SIZE  (INT_FLASH_PAGES * INTFLASH_PAGE_SIZE)
+
+#if defined(CRC32_HW_UPDATE)
+    #define CRC32_NAME "CRC32_HW_UPDATE"
+#elif (CRC32_ALGO == CRC32_ALGO_SLICE8)
+    #define CRC32_NAME "CRC32_ALGO_SLICE8"
+#elif (CRC32_ALGO == CRC32_ALGO_SLICE4)
+    #define CRC32_NAME "CRC32_ALGO_SLICE4"
+#elif (CRC32_ALGO == CRC32_ALGO_TABLE)
+    #define CRC32_NAME "CRC32_ALGO_TABLE"
+#else
+    #define CRC32_NAME "CRC32_ALGO_BITWISE"
+#endif
+
+#define CHECK(cond, ...)                                       \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            if (failures++ < 20)                               \
+            {                                                  \
+                printf("FAIL %s:%d: ", __FILE__, __LINE__);    \
+                printf(__VA_ARGS__);                           \
+                printf("\n");                                  \
+            }                                                  \
+        }                                                      \
+    } while (0)
+
+static int failures;
+static uint8_t extFlash[EFL_FLASH_SIZE];
+static uint8_t *intFlash;
+static uint32_t extReads;
+
+static uint32_t refCrc32(const uint8_t *data, uint32_t len)
+{
+    uint32_t crc = 0xFFFFFFFFU;
+
+    while (len--)
+    {
+        crc ^= *data++;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320U & -(crc & 1));
+        }
+    }
+    return (crc ^ 0xFFFFFFFFU);
+}
+
+/* External flash read, as in flash_interface_ext_rtos_NVS.c */
+uint8_t readFlashPg(uint8_t page, uint32_t offset, uint8_t *pBuf, uint16_t len)
+{
+    uint32_t addr = FLASH_ADDRESS(page, offset);
+
+    extReads++;
+    memset(pBuf, 0xFF, len);
+    if (addr < EFL_FLASH_SIZE)
+    {
+        memcpy(pBuf, &extFlash[addr], (EFL_FLASH_SIZE - addr < len) ? (EFL_FLASH_SIZE - addr) : len);
+    }
+    return (FLASH_SUCCESS);
+}
+
+#ifdef CRC32_HW_UPDATE
+static uint32_t hwCalls;
+
+/* Hardware backend stand-in, returns the running CRC like CRC32_update() */
+uint32_t CRC32_HW_UPDATE(uint32_t crc, const uint8_t *data, uint32_t len)
+{
+    hwCalls++;
+    while (len--)
+    {
+        crc ^= *data++;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320U & -(crc & 1));
+        }
+    }
+    return (crc);
+}
+#endif
+
+static void fill(uint8_t *buf, uint32_t len, uint32_t seed)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        seed = seed * 1664525U + 1013904223U;
+        buf[i] = seed >> 24;
+    }
+}
+
+static void checkUpdate(void)
+{
+    static uint8_t buf[4096];
+    uint32_t crc;
+
+    crc = CRC32_final(CRC32_update(CRC32_init(), (const uint8_t *)"123456789", 9));
+    CHECK(crc == 0xCBF43926U, "known answer %08x", (unsigned)crc);
+    CHECK(CRC32_final(CRC32_update(CRC32_init(), buf, 0)) == 0, "empty data");
+
+    fill(buf, sizeof(buf), 1);
+    for (uint32_t offset = 0; offset < 8; offset++)
+    {
+        for (uint32_t len = 0; len < 300; len++)
+        {
+            uint32_t expected = refCrc32(buf + offset, len);
+            uint32_t split    = len % 13;
+
+            crc = CRC32_final(CRC32_update(CRC32_init(), buf + offset, len));
+            CHECK(crc == expected, "offset %u length %u: %08x, expected %08x", offset, len, crc, expected);
+
+            crc = CRC32_update(CRC32_init(), buf + offset, split);
+            crc = CRC32_update(crc, buf + offset + split, len - split);
+            crc = CRC32_final(crc);
+            CHECK(crc == expected, "offset %u length %u split at %u: %08x, expected %08x", offset, len, split, crc,
+                  expected);
+        }
+    }
+
+    crc = CRC32_final(CRC32_update(CRC32_init(), buf, sizeof(buf)));
+    CHECK(crc == refCrc32(buf, sizeof(buf)), "%u bytes", (unsigned)sizeof(buf));
+}
+
+static void checkCalc(void)
+{
+    static const uint32_t lengths[] = {1,
+                                       IMG_DATA_OFFSET,
+                                       IMG_DATA_OFFSET + 1,
+                                       255,
+                                       256,
+                                       257,
+                                       INTFLASH_PAGE_SIZE - 1,
+                                       INTFLASH_PAGE_SIZE,
+                                       INTFLASH_PAGE_SIZE + 1,
+                                       3 * INTFLASH_PAGE_SIZE + 100,
+                                       16 * INTFLASH_PAGE_SIZE};
+
+    fill(intFlash, INT_FLASH_SIZE, 2);
+    fill(extFlash, sizeof(extFlash), 3);
+
+    for (uint32_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+    {
+        uint32_t len = lengths[i];
+
+        for (uint8_t page = INT_FLASH_PAGE; page < INT_FLASH_PAGE + 4; page++)
+        {
+            for (uint16_t offset = 0; offset < 64; offset += 20)
+            {
+                const uint8_t *image = (const uint8_t *)(uintptr_t)FLASH_ADDRESS(page, offset);
+                uint32_t expected    = refCrc32(image + IMG_DATA_OFFSET,
+                                                (len > IMG_DATA_OFFSET) ? len - IMG_DATA_OFFSET : 0);
+                uint32_t crc         = CRC32_calc(page, INTFLASH_PAGE_SIZE, offset, len, false);
+
+                CHECK(crc == expected, "internal page %u offset %u length %u: %08x, expected %08x", page, offset,
+                      len, crc, expected);
+            }
+
+            /* External flash images start at the beginning of a page */
+            uint32_t expected = refCrc32(&extFlash[FLASH_ADDRESS(page, 0) + IMG_DATA_OFFSET],
+                                         (len > IMG_DATA_OFFSET) ? len - IMG_DATA_OFFSET : 0);
+            uint32_t crc      = CRC32_calc(page, INTFLASH_PAGE_SIZE, 0, len, true);
+
+            CHECK(crc == expected, "external page %u length %u: %08x, expected %08x", page, len, crc, expected);
+        }
+    }
+
+    CHECK(CRC32_calc(INT_FLASH_PAGE, INTFLASH_PAGE_SIZE, 0, 0, false) == 0, "zero length");
+    CHECK(CRC32_calc(INT_FLASH_PAGE, INTFLASH_PAGE_SIZE, 0, 0xFFFFFFFF, false) == 0, "erased length");
+    CHECK(CRC32_calc(INT_FLASH_PAGE, INTFLASH_PAGE_SIZE, 0, MAX_ONCHIP_FLASH_PAGES * INTFLASH_PAGE_SIZE + 1, false) ==
+              0,
+          "internal length above the flash size");
+    extReads = 0;
+    CHECK(CRC32_calc(0, INTFLASH_PAGE_SIZE, 0, EFL_FLASH_SIZE + 1, true) == 0, "external length above the flash size");
+    CHECK(extReads == 0, "flash read for an invalid length");
+}
+
+static double nsSince(const struct timespec *start, uint32_t count)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (((end.tv_sec - start->tv_sec) * 1e9 + (end.tv_nsec - start->tv_nsec)) / count);
+}
+
+static void bench(uint32_t kilobytes)
+{
+    struct timespec start;
+    volatile uint32_t sink = 0;
+    uint32_t repeats       = 64;
+    uint32_t len           = kilobytes * 1024;
+    uint8_t *buf           = malloc(len + 1);
+
+    fill(buf, len + 1, 4);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t n = 0; n < repeats; n++)
+    {
+        sink += CRC32_update(CRC32_init(), buf + (n & 1), len);
+    }
+    double update = nsSince(&start, repeats);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t n = 0; n < repeats; n++)
+    {
+        sink += refCrc32(buf + (n & 1), len);
+    }
+    double bitwise = nsSince(&start, repeats);
+
+    printf("%s: CRC32_update() %.0f MB/s, plain bitwise loop %.0f MB/s\n", CRC32_NAME, len * 1e3 / update,
+           len * 1e3 / bitwise);
+    free(buf);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t kilobytes = (argc > 1) ? atoi(argv[1]) : 256;
+
+    /* Internal flash is addressed directly by CRC32_calc() */
+    intFlash = mmap((void *)(uintptr_t)FLASH_ADDRESS(INT_FLASH_PAGE, 0), INT_FLASH_SIZE, PROT_READ | PROT_WRITE,
+                    MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (intFlash == MAP_FAILED)
+    {
+        perror("mmap");
+        return (1);
+    }
+
+    checkUpdate();
+    checkCalc();
+#ifdef CRC32_HW_UPDATE
+    CHECK(hwCalls != 0, "hardware backend not used");
+#endif
+    if (failures != 0)
+    {
+        printf("%d failures\n", failures);
+        return (1);
+    }
+    printf("checks passed\n");
+    bench(kilobytes);
+    return (0);
+}
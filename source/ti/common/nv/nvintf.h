@@ -83,6 +83,36 @@ nvFps.initNV(NULL);
 nvFps.compactNv(NULL);
 status = nvFps.readItem(id, 0, len, buf);
 
+Drivers which support incremental compaction populate .compactStep() and
+.setCompactThreshold(). The threshold callback is invoked from the context of
+the NV call that made free space drop below the threshold, with the driver
+locked, so it should only signal the application (e.g. post an event). The
+application then calls .compactStep() from idle time until it no longer
+returns NVINTF_PENDING, instead of letting a later write compact in line:
+
+void nvCompactCb(uint32_t freeBytes)
+{
+    // Schedule compaction from the application task
+}
+
+nvFps.setCompactThreshold(minFree, nvCompactCb);
+...
+while (nvFps.compactStep(1) == NVINTF_PENDING)
+{
+    // Yield to time critical work between steps
+}
+
+Drivers which support write transactions populate .beginTxn(), .stageItem()
+and .commitTxn(). Items staged between .beginTxn() and .commitTxn() are
+written together, and after a reset either all or none of them have been
+updated. Staged buffers are not copied, so they must remain valid until
+.commitTxn() returns. A transaction must be built and committed by one task:
+
+nvFps.beginTxn();
+nvFps.stageItem(bondId, sizeof(bond), &bond);
+nvFps.stageItem(cccdId, sizeof(cccd), &cccd);
+status = nvFps.commitTxn();
+
 */
 
 //*****************************************************************************
@@ -119,6 +149,7 @@ status = nvFps.readItem(id, 0, len, buf);
 #define NVINTF_BADVERSION 12
 #define NVINTF_EXIST      13
 #define NVINTF_NO_SIG     14
+#define NVINTF_PENDING    15
 
 // doNext flag options
 #define NVINTF_DOSTART  0x1  // starts new search
@@ -214,6 +245,24 @@ typedef uint32_t (*NVINTF_getFreeNV)(void);
 typedef uint32_t (*NVINTF_sanityCheck)(void);
 #endif
 
+//! Function pointer definition for the NVINTF_compactStep() function
+typedef uint8_t (*NVINTF_compactStep)(uint16_t budget);
+
+//! Callback type for the NVINTF_setCompactThreshold() function
+typedef void (*NVINTF_compactNeededCb)(uint32_t freeBytes);
+
+//! Function pointer definition for the NVINTF_setCompactThreshold() function
+typedef void (*NVINTF_setCompactThreshold)(uint16_t minFree, NVINTF_compactNeededCb cbFxn);
+
+//! Function pointer definition for the NVINTF_beginTxn() function
+typedef uint8_t (*NVINTF_beginTxn)(void);
+
+//! Function pointer definition for the NVINTF_stageItem() function
+typedef uint8_t (*NVINTF_stageItem)(NVINTF_itemID_t id, uint16_t length, void *buffer);
+
+//! Function pointer definition for the NVINTF_commitTxn() function
+typedef uint8_t (*NVINTF_commitTxn)(void);
+
 //! Structure of NV API function pointers
 typedef struct nvintf_nvfuncts_t
 {
@@ -251,6 +300,16 @@ typedef struct nvintf_nvfuncts_t
     //! Sanity Check function
     NVINTF_sanityCheck sanityCheck;
 #endif
+    //! Incremental compaction function
+    NVINTF_compactStep compactStep;
+    //! Set compaction threshold function
+    NVINTF_setCompactThreshold setCompactThreshold;
+    //! Begin write transaction function
+    NVINTF_beginTxn beginTxn;
+    //! Stage item in write transaction function
+    NVINTF_stageItem stageItem;
+    //! Commit write transaction function
+    NVINTF_commitTxn commitTxn;
 } NVINTF_nvFuncts_t;
 
 //*****************************************************************************
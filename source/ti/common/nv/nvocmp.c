@@ -176,6 +176,43 @@ is enabled by default on this family of devices.
 NVOCMP_RAM_BUFFER_SIZE - Sets the size for the RAM buffer used when
 RAM optimization is enabled. Default value is 500.
 
+NVOCMP_ITEM_INDEX - Enables a RAM index of the active items, sorted by
+compressed ID, which maps each item to the page and offset of its header.
+Exact (sysid/itemid/subid) lookups done by read, write, update, delete and
+getItemLen use a binary search of the index instead of walking the NV pages
+backwards. The index is built by one page traversal on the first lookup after
+initialization or compaction, and is then kept up to date as items are written
+and deleted. Items which do not fit in the index are still found by the normal
+page traversal.
+NVOCMP_ITEM_INDEX_SIZE - Number of items that can be held by the RAM index
+when NVOCMP_ITEM_INDEX is enabled. Each entry uses 8 bytes of RAM. Default
+value is 128.
+
+Incremental compaction:
+Compaction triggered by a write runs in line with that write. To keep it out
+of time critical paths, the application can register a free space threshold
+and a callback with setCompactThreshold(). The callback is invoked once when
+a write leaves less free space than the threshold, and the application then
+calls compactStep(budget) from idle time. Each step compacts at most 'budget'
+destination pages and leaves NV in the same power-loss safe state as the end
+of a regular compaction pass, so steps can be spread over time. With two or
+fewer NV pages, a single step performs the whole compaction. compactStep()
+returns NVINTF_PENDING while free space is still below the threshold and the
+last step reclaimed space.
+
+Write transactions:
+Items staged with stageItem() between beginTxn() and commitTxn() are written
+as one group. commitTxn() writes the staged items back to back on the active
+page with their valid marks cleared, followed by a marker item holding the
+item count. Clearing the valid mark of the marker is the commit point, after
+which the items are marked valid and their older copies inactive. If a reset
+occurs before the commit point, initialization discards the staged items and
+the older copies remain current. If it occurs after, initialization completes
+the transaction. All staged items must fit on one page together with the
+marker.
+NVOCMP_TXN_MAXITEMS - Number of items that can be staged in one transaction.
+Each staged item uses 24 bytes of RAM. Default value is 8.
+
 Dependencies:
 Requires NVS for NV access.
 Requires TI-RTOS GateMutexPri or POSIX mutex to be enabled in configuration.
@@ -281,6 +318,14 @@ Requires API's in a crc.h to implement CRC functionality.
 static const NVINTF_itemID_t diagId = NVOCMP_NVID_DIAG;
 #endif // NVOCMP_STATS
 
+// NV item ID for the write transaction commit marker
+static const NVINTF_itemID_t txnId = NVOCMP_NVID_TXN;
+
+// Maximum number of items staged in one write transaction
+#ifndef NVOCMP_TXN_MAXITEMS
+    #define NVOCMP_TXN_MAXITEMS 8
+#endif
+
 // CRC options
 // When not NULL, reads will result in a CRC check before returning
 #define NVOCMP_CRCONREAD 1
@@ -605,6 +650,13 @@ typedef struct
 // the 'stats' field of the itemHdr_t struct when the item is read
 #define NVOCMP_FOLLOWBIT   0x4
 
+// Valid id mark as positioned in header byte NVOCMP_HDRVLDOFS
+#if NVOCMP_HDRLE
+    #define NVOCMP_HDRVALIDMARK (NVOCMP_VALIDIDBIT << 6)
+#else
+    #define NVOCMP_HDRVALIDMARK NVOCMP_VALIDIDBIT
+#endif
+
 // Index of last item header byte
 #define NVOCMP_ITEMHDREND (NVOCMP_ITEMHDRLEN - 1)
 
@@ -681,6 +733,7 @@ typedef struct
     uint8_t actPage;      // current active page
     uint8_t xsrcPage;     // transfer source page
     uint8_t forceCompact; // force compaction to happen
+    uint8_t compactLimit; // max destination pages per compaction, 0 = no limit
     uint16_t actOffset;   // active page offset
     uint16_t xsrcOffset;  // transfer source page offset
     uint16_t xdstOffset;  // transfer destination page offset
@@ -743,9 +796,62 @@ static bool (*NVOCMP_voltCheckFptr)(void);
 static uint16_t NVOCMP_badCRCCount = 0;
 #endif // NVOCMP_STATS
 
+// Free space threshold and callback for incremental compaction
+static uint16_t NVOCMP_compactMinFree;
+static NVINTF_compactNeededCb NVOCMP_compactNeededCbFxn;
+static bool NVOCMP_compactNotified;
+
+// Items staged for the pending write transaction. Only one transaction can
+// be staged at a time, it is built and committed by a single task.
+typedef struct
+{
+    NVOCMP_itemHdr_t hdr; // Staged item, hpage/hofs locate the copy it replaces
+    uint8_t *pBuf;        // Caller's data, must remain valid until commit
+} NVOCMP_txnItem_t;
+
+// Length of the commit marker, which holds the number of staged items
+#define NVOCMP_TXNMARKERLEN (NVOCMP_ITEMHDRLEN + sizeof(uint16_t))
+
+static NVOCMP_txnItem_t NVOCMP_txnItems[NVOCMP_TXN_MAXITEMS];
+static uint8_t NVOCMP_txnCount;
+static uint16_t NVOCMP_txnSize = NVOCMP_TXNMARKERLEN;
+
 NVOCMP_initAction_t gAction;
 uint8_t NVOCMP_size;
 
+#ifdef NVOCMP_ITEM_INDEX
+    #ifndef NVOCMP_ITEM_INDEX_SIZE
+        #define NVOCMP_ITEM_INDEX_SIZE 128
+    #endif
+
+// Item index states
+typedef enum NVOCMP_indexState
+{
+    NVOCMP_INDEX_STALE = 0, // Index must be rebuilt before use
+    NVOCMP_INDEX_VALID,     // Index holds every active item
+    NVOCMP_INDEX_PARTIAL,   // Index is full, missing items may be in NV
+    NVOCMP_INDEX_UNUSED,    // Corruption seen, use page traversal until compaction
+} NVOCMP_indexState_t;
+
+// Item index entry, one per active item
+typedef struct
+{
+    uint32_t cmpid; // Compressed ID
+    uint16_t hofs;  // Header offset
+    uint8_t hpage;  // Header page
+} NVOCMP_indexEntry_t;
+
+// Item index, entries are sorted by compressed ID
+typedef struct
+{
+    NVOCMP_indexState_t state;
+    uint16_t count;
+    NVOCMP_indexEntry_t entry[NVOCMP_ITEM_INDEX_SIZE];
+} NVOCMP_itemIndex_t;
+
+static NVOCMP_itemIndex_t NVOCMP_itemIndex;
+#endif // NVOCMP_ITEM_INDEX
+
 //*****************************************************************************
 // NV API Function Prototypes
 //*****************************************************************************
@@ -772,6 +878,11 @@ static void NVOCMP_unlockNvApi(int32_t);
 static bool NVOCMP_expectCompApi(uint16_t len);
 static uint8_t NVOCMP_eraseNvApi(void);
 static uint32_t NVOCMP_getFreeNvApi(void);
+static uint8_t NVOCMP_compactStepApi(uint16_t budget);
+static void NVOCMP_setCompactThresholdApi(uint16_t minFree, NVINTF_compactNeededCb cbFxn);
+static uint8_t NVOCMP_beginTxnApi(void);
+static uint8_t NVOCMP_stageItemApi(NVINTF_itemID_t id, uint16_t len, void *buf);
+static uint8_t NVOCMP_commitTxnApi(void);
 
 #ifdef ENABLE_SANITY_CHECK
 static uint32_t NVOCMP_sanityCheckApi(void);
@@ -805,6 +916,9 @@ static uint8_t NVOCMP_getDstPage(NVOCMP_nvHandle_t *pNvHandle, uint16_t len);
 static void NVOCMP_changePageState(NVOCMP_nvHandle_t *pNvHandle, uint8_t pg, NVOCMP_pageState_t state);
 static void NVOCMP_setPageState(NVOCMP_nvHandle_t *pNvHandle, uint8_t pg, NVOCMP_pageState_t state);
 static void NVOCMP_setItemInactive(NVOCMP_nvHandle_t *pNvHandle, uint8_t pg, uint16_t iOfs);
+static void NVOCMP_setItemValid(uint8_t pg, uint16_t iOfs);
+static void NVOCMP_finishTxn(NVOCMP_nvHandle_t *pNvHandle, uint8_t pg, uint16_t mOfs, NVOCMP_txnItem_t *pItems);
+static void NVOCMP_resumeTxn(NVOCMP_nvHandle_t *pNvHandle);
 static uint8_t NVOCMP_readItem(NVOCMP_itemHdr_t *iHdr, uint16_t ofs, uint16_t len, void *pBuf, bool flag);
 static uint8_t NVOCMP_checkItem(NVINTF_itemID_t *id, uint16_t len, NVOCMP_itemHdr_t *iHdr, uint8_t flag);
 static inline void NVOCMP_read(uint8_t pg, uint16_t off, uint8_t *pBuf, uint16_t len);
@@ -817,6 +931,7 @@ static uint8_t NVOCMP_doRAMCRC(uint8_t *input, uint16_t len, uint8_t crc);
 static uint8_t NVOCMP_verifyCRC(uint16_t iOfs, uint16_t len, uint8_t crc, uint8_t pg, bool flag);
 static uint8_t NVOCMP_readByte(uint8_t pg, uint16_t ofs);
 static void NVOCMP_writeByte(uint8_t pg, uint16_t ofs, uint8_t bwv);
+static void NVOCMP_checkCompactThreshold(void);
 
 #if (NVOCMP_NVPAGES > NVOCMP_NVTWOP)
 static uint8_t NVOCMP_findDstPage(NVOCMP_nvHandle_t *pNvHandle);
@@ -833,6 +948,14 @@ static void NVOCMP_migratePage(NVOCMP_nvHandle_t *pNvHandle, uint8_t page);
 static void NVOCMP_copyItem(uint8_t srcPg, uint8_t dstPg, uint16_t sOfs, uint16_t dOfs, uint16_t len);
 #endif
 
+#ifdef NVOCMP_ITEM_INDEX
+static void NVOCMP_indexInvalidate(void);
+static void NVOCMP_indexBuild(NVOCMP_nvHandle_t *pNvHandle);
+static void NVOCMP_indexUpdate(uint32_t cmpid, uint8_t pg, uint16_t hofs, bool replace);
+static void NVOCMP_indexRemove(uint8_t pg, uint16_t hofs);
+static int8_t NVOCMP_indexFind(NVOCMP_nvHandle_t *pNvHandle, NVOCMP_itemHdr_t *pHdr);
+#endif
+
 //*****************************************************************************
 // Load Pointer Functions (These are declared in nvoctp.h)
 //*****************************************************************************
@@ -868,6 +991,11 @@ void NVOCMP_loadApiPtrs(NVINTF_nvFuncts_t *pfn)
 #ifdef ENABLE_SANITY_CHECK
     pfn->sanityCheck = &NVOCMP_sanityCheckApi;
 #endif
+    pfn->compactStep         = &NVOCMP_compactStepApi;
+    pfn->setCompactThreshold = &NVOCMP_setCompactThresholdApi;
+    pfn->beginTxn            = &NVOCMP_beginTxnApi;
+    pfn->stageItem           = &NVOCMP_stageItemApi;
+    pfn->commitTxn           = &NVOCMP_commitTxnApi;
 }
 
 /**
@@ -903,6 +1031,11 @@ void NVOCMP_loadApiPtrsMin(NVINTF_nvFuncts_t *pfn)
 #ifdef ENABLE_SANITY_CHECK
     pfn->sanityCheck = &NVOCMP_sanityCheckApi;
 #endif
+    pfn->compactStep         = NULL;
+    pfn->setCompactThreshold = NULL;
+    pfn->beginTxn            = NULL;
+    pfn->stageItem           = NULL;
+    pfn->commitTxn           = NULL;
 }
 
 /**
@@ -937,6 +1070,11 @@ void NVOCMP_loadApiPtrsExt(NVINTF_nvFuncts_t *pfn)
 #ifdef ENABLE_SANITY_CHECK
     pfn->sanityCheck = &NVOCMP_sanityCheckApi;
 #endif
+    pfn->compactStep         = &NVOCMP_compactStepApi;
+    pfn->setCompactThreshold = &NVOCMP_setCompactThresholdApi;
+    pfn->beginTxn            = &NVOCMP_beginTxnApi;
+    pfn->stageItem           = &NVOCMP_stageItemApi;
+    pfn->commitTxn           = &NVOCMP_commitTxnApi;
 }
 
 /**
@@ -1126,6 +1264,11 @@ static uint8_t NVOCMP_initNvApi(void *param)
         NVOCMP_nvHandle.actPage   = NVOCMP_NULLPAGE;
         NVOCMP_nvHandle.actOffset = FLASH_PAGE_SIZE;
 
+#ifdef NVOCMP_ITEM_INDEX
+        // Index is built on first lookup, once pages are settled
+        NVOCMP_indexInvalidate();
+#endif
+
         NVOCMP_initNv(&NVOCMP_nvHandle);
 
 #if defined(NVOCMP_STATS)
@@ -1295,6 +1438,95 @@ static uint8_t NVOCMP_compactNvApi(uint16_t minAvail)
     NVOCMP_UNLOCK(err);
 }
 
+/******************************************************************************
+ * @fn      NVOCMP_compactStepApi
+ *
+ * @brief   API function to perform one bounded step of NV compaction. This
+ *          is meant to be called from idle time, after the callback set by
+ *          setCompactThresholdApi() has been invoked, so that writes do not
+ *          have to compact in line.
+ *
+ * @param   budget - maximum number of destination pages to fill in this
+ *                   step (0 is treated as 1). Ignored with two or fewer NV
+ *                   pages, where a step is a whole compaction.
+ *
+ * @return  NVINTF_SUCCESS if no more compaction is needed,
+ *          NVINTF_PENDING if free space is still below the threshold,
+ *          or specific failure code
+ */
+static uint8_t NVOCMP_compactStepApi(uint16_t budget)
+{
+    uint8_t err = NVINTF_SUCCESS;
+
+    // Check voltage if possible
+    NVOCMP_FLASHACCESS(err)
+    if (err)
+    {
+        return (err);
+    }
+
+    // Prevent RTOS thread contention
+    NVOCMP_LOCK();
+    err = NVOCMP_failF;
+    // Check for a fatal error
+    if (err == NVINTF_SUCCESS)
+    {
+        uint32_t before = NVOCMP_getFreeNvApi();
+        uint32_t after  = before;
+
+        // Without a threshold every call is a compaction step
+        if ((NVOCMP_compactMinFree == 0) || (before < NVOCMP_compactMinFree))
+        {
+            NVOCMP_nvHandle.compactLimit = (budget == 0) ? 1 : ((budget > NVOCMP_NVSIZE) ? NVOCMP_NVSIZE : budget);
+            (void)NVOCMP_compactPage(&NVOCMP_nvHandle, 0);
+            NVOCMP_nvHandle.compactLimit = 0;
+            // 'failW' indicates compaction status
+            err   = NVOCMP_failW;
+            after = NVOCMP_getFreeNvApi();
+        }
+
+        if (after >= NVOCMP_compactMinFree)
+        {
+            // Notify again next time free space drops below the threshold
+            NVOCMP_compactNotified = false;
+        }
+        else if ((err == NVINTF_SUCCESS) && (after > before))
+        {
+            // Step reclaimed space, more steps may reclaim more
+            err = NVINTF_PENDING;
+        }
+    }
+
+#ifdef NV_LINUX
+    if ((err == NVINTF_SUCCESS) || (err == NVINTF_PENDING))
+    {
+        NV_LINUX_save();
+    }
+#endif
+
+    NVOCMP_UNLOCK(err);
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_setCompactThresholdApi
+ *
+ * @brief   API function to set the free space threshold below which the
+ *          application wants to be told that compaction is needed. The
+ *          callback is invoked with the driver locked, from the call that
+ *          wrote the item, and must not call NV API functions.
+ *
+ * @param   minFree - threshold of free bytes, 0 to disable
+ * @param   cbFxn - callback function, NULL to disable
+ *
+ * @return  none
+ */
+static void NVOCMP_setCompactThresholdApi(uint16_t minFree, NVINTF_compactNeededCb cbFxn)
+{
+    NVOCMP_compactMinFree     = minFree;
+    NVOCMP_compactNeededCbFxn = cbFxn;
+    NVOCMP_compactNotified    = false;
+}
+
 //*****************************************************************************
 // API Functions - NV Data Items
 //*****************************************************************************
@@ -1742,6 +1974,241 @@ static uint8_t NVOCMP_writeItemApi(NVINTF_itemID_t id, uint16_t len, void *pBuf)
     NVOCMP_UNLOCK(err);
 }
 
+/******************************************************************************
+ * @fn      NVOCMP_beginTxnApi
+ *
+ * @brief   API function to start a write transaction. Any items staged by a
+ *          transaction which was not committed are discarded.
+ *
+ * @return  NVINTF_SUCCESS or specific failure code
+ */
+static uint8_t NVOCMP_beginTxnApi(void)
+{
+    if (NVOCMP_failF == NVINTF_NOTREADY)
+    {
+        // NV driver has not been initialized
+        NVOCMP_ASSERT(false, "Driver uninitialized.")
+        return (NVINTF_NOTREADY);
+    }
+
+    NVOCMP_txnCount = 0;
+    NVOCMP_txnSize  = NVOCMP_TXNMARKERLEN;
+
+    return (NVINTF_SUCCESS);
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_stageItemApi
+ *
+ * @brief   API function to add an item to the pending write transaction.
+ *          Nothing is written to NV until NVOCMP_commitTxnApi() is called,
+ *          and the data buffer is not copied, so it must remain valid until
+ *          then. Staging an item which is already staged replaces it.
+ *
+ * @param   id   - NV item type identifier
+ * @param   len  - data buffer length to write into NV block (0 is illegal)
+ * @param   pBuf - pointer to caller's data buffer to write (NULL is illegal)
+ *
+ * @return  NVINTF_SUCCESS or specific failure code
+ */
+static uint8_t NVOCMP_stageItemApi(NVINTF_itemID_t id, uint16_t len, void *pBuf)
+{
+    uint8_t err;
+    uint8_t i;
+    uint16_t size;
+    NVOCMP_itemHdr_t iHdr;
+
+    // Parameter Sanity Check
+    if (pBuf == NULL || len == 0)
+    {
+        return (NVINTF_BADPARAM);
+    }
+
+    err = NVOCMP_checkItem(&id, len, &iHdr, NVOCMP_FINDSTRICT);
+    if (err)
+    {
+        return (err);
+    }
+
+    if (!memcmp(&id, &txnId, sizeof(NVINTF_itemID_t)))
+    {
+        // Reserved for the commit marker
+        return (NVINTF_BADITEMID);
+    }
+
+    // Look for an earlier copy in this transaction
+    for (i = 0; i < NVOCMP_txnCount; i++)
+    {
+        if (NVOCMP_txnItems[i].hdr.cmpid == iHdr.cmpid)
+        {
+            break;
+        }
+    }
+
+    size = NVOCMP_txnSize + NVOCMP_ITEMHDRLEN + len;
+    if (i < NVOCMP_txnCount)
+    {
+        size -= NVOCMP_ITEMHDRLEN + NVOCMP_txnItems[i].hdr.len;
+    }
+    else if (NVOCMP_txnCount >= NVOCMP_TXN_MAXITEMS)
+    {
+        return (NVINTF_FAILURE);
+    }
+
+    if (size > NVOCMP_PGDATALEN)
+    {
+        // Staged items must fit on one page
+        return (NVINTF_BADLENGTH);
+    }
+
+    NVOCMP_txnItems[i].hdr  = iHdr;
+    NVOCMP_txnItems[i].pBuf = pBuf;
+    NVOCMP_txnSize          = size;
+    if (i == NVOCMP_txnCount)
+    {
+        NVOCMP_txnCount++;
+    }
+
+    return (NVINTF_SUCCESS);
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_commitTxnApi
+ *
+ * @brief   API function to write all items staged since the last call to
+ *          NVOCMP_beginTxnApi(). After a reset, either all of the staged
+ *          items or none of them have been written.
+ *
+ * @return  NVINTF_SUCCESS or specific failure code
+ */
+static uint8_t NVOCMP_commitTxnApi(void)
+{
+    uint8_t err;
+    uint8_t i;
+    uint8_t mPg;
+    uint16_t mOfs;
+    uint16_t count = NVOCMP_txnCount;
+    NVOCMP_itemHdr_t iHdr;
+    NVINTF_itemID_t id = txnId;
+
+    if (NVOCMP_txnCount == 0)
+    {
+        return (NVINTF_SUCCESS);
+    }
+
+    err = NVOCMP_checkItem(&id, sizeof(count), &iHdr, NVOCMP_FINDSTRICT);
+    if (err)
+    {
+        return (err);
+    }
+
+    // Check voltage if possible
+    NVOCMP_FLASHACCESS(err)
+    if (err)
+    {
+        return (err);
+    }
+
+    // Prevent RTOS thread contention
+    NVOCMP_LOCK();
+
+    err = NVOCMP_failF;
+    if (err == NVINTF_SUCCESS)
+    {
+        NVOCMP_failW = NVINTF_SUCCESS;
+        if (NVOCMP_getDstPage(&NVOCMP_nvHandle, NVOCMP_txnSize) == NVOCMP_NULLPAGE)
+        {
+            // Won't fit on the active page, compact and check again
+            if (NVOCMP_compactPage(&NVOCMP_nvHandle, NVOCMP_txnSize) < NVOCMP_txnSize)
+            {
+                // Failure means there's no place to put these items
+                NVOCMP_ALERT(false, "Out of NV.")
+                err = (NVOCMP_failW != NVINTF_SUCCESS) ? NVOCMP_failW : NVINTF_BADLENGTH;
+            }
+        }
+    }
+
+    if ((err == NVINTF_SUCCESS) &&
+        ((NVOCMP_nvHandle.actOffset + NVOCMP_txnSize) > FLASH_PAGE_SIZE))
+    {
+        err = NVINTF_BADLENGTH;
+    }
+
+    if (err == NVINTF_SUCCESS)
+    {
+        NVOCMP_itemHdr_t hdr;
+
+        // Locate the copies to be replaced, before any staged item is written
+        for (i = 0; i < NVOCMP_txnCount; i++)
+        {
+            hdr.sysid  = NVOCMP_txnItems[i].hdr.sysid;
+            hdr.itemid = NVOCMP_txnItems[i].hdr.itemid;
+            hdr.subid  = NVOCMP_txnItems[i].hdr.subid;
+            if (NVOCMP_findItem(&NVOCMP_nvHandle,
+                                NVOCMP_nvHandle.actPage,
+                                NVOCMP_nvHandle.actOffset,
+                                &hdr,
+                                NVOCMP_FINDSTRICT,
+                                NULL) == NVINTF_SUCCESS)
+            {
+                NVOCMP_txnItems[i].hdr.hpage = hdr.hpage;
+                NVOCMP_txnItems[i].hdr.hofs  = hdr.hofs;
+            }
+            else
+            {
+                NVOCMP_txnItems[i].hdr.hofs = 0;
+            }
+        }
+
+        // Write staged items and the marker in one pass, all hidden
+        mPg  = NVOCMP_nvHandle.actPage;
+        mOfs = NVOCMP_nvHandle.actOffset + NVOCMP_txnSize - NVOCMP_ITEMHDRLEN;
+        for (i = 0; (i < NVOCMP_txnCount) && (NVOCMP_failW == NVINTF_SUCCESS); i++)
+        {
+            hdr       = NVOCMP_txnItems[i].hdr;
+            hdr.stats = NVOCMP_VALIDIDBIT;
+            NVOCMP_writeItem(&NVOCMP_nvHandle, &hdr, mPg, NVOCMP_nvHandle.actOffset, NVOCMP_txnItems[i].pBuf);
+        }
+        if (NVOCMP_failW == NVINTF_SUCCESS)
+        {
+            iHdr.stats = NVOCMP_VALIDIDBIT;
+            NVOCMP_writeItem(&NVOCMP_nvHandle, &iHdr, mPg, NVOCMP_nvHandle.actOffset, (uint8_t *)&count);
+        }
+
+        if (NVOCMP_failW == NVINTF_SUCCESS)
+        {
+            // Commit point
+            NVOCMP_setItemValid(mPg, mOfs);
+        }
+
+        if (NVOCMP_failW == NVINTF_SUCCESS)
+        {
+            NVOCMP_finishTxn(&NVOCMP_nvHandle, mPg, mOfs, NVOCMP_txnItems);
+        }
+        else if (NVOCMP_nvHandle.actOffset > mOfs)
+        {
+            // Marker was written but not committed, discard the staged items
+            NVOCMP_setItemInactive(&NVOCMP_nvHandle, mPg, mOfs);
+        }
+        err = NVOCMP_failW;
+
+        // Let the application schedule compaction before it is needed in line
+        NVOCMP_checkCompactThreshold();
+    }
+
+    NVOCMP_txnCount = 0;
+    NVOCMP_txnSize  = NVOCMP_TXNMARKERLEN;
+
+#ifdef NV_LINUX
+    if (err == NVINTF_SUCCESS)
+    {
+        NV_LINUX_save();
+    }
+#endif
+
+    NVOCMP_UNLOCK(err);
+}
+
 //*****************************************************************************
 // Extended API Functions
 //*****************************************************************************
@@ -1982,6 +2449,35 @@ static bool NVOCMP_expectCompApi(uint16_t len)
 // Local NV Driver Utility Functions
 //*****************************************************************************
 
+/******************************************************************************
+ * @fn      NVOCMP_checkCompactThreshold
+ *
+ * @brief   Invoke the compaction needed callback once when free space drops
+ *          below the threshold set by setCompactThresholdApi()
+ *
+ * @return  none
+ */
+static void NVOCMP_checkCompactThreshold(void)
+{
+    uint32_t freeBytes;
+
+    if ((NVOCMP_compactNeededCbFxn == NULL) || (NVOCMP_compactMinFree == 0))
+    {
+        return;
+    }
+
+    freeBytes = NVOCMP_getFreeNvApi();
+    if (freeBytes >= NVOCMP_compactMinFree)
+    {
+        NVOCMP_compactNotified = false;
+    }
+    else if (!NVOCMP_compactNotified)
+    {
+        NVOCMP_compactNotified = true;
+        NVOCMP_compactNeededCbFxn(freeBytes);
+    }
+}
+
 #ifdef NVOCMP_GPRAM
 /******************************************************************************
  * @fn      NVOCMP_disableCache
@@ -2477,12 +2973,16 @@ static void NVOCMP_initNv(NVOCMP_nvHandle_t *pNvHandle)
                 pNvHandle->actPage   = pgAct;
                 pNvHandle->actOffset = pNvHandle->pageInfo[pgAct].offset;
 
+                // Complete or discard a transaction interrupted by reset
+                NVOCMP_resumeTxn(pNvHandle);
+
                 NVOCMP_itemHdr_t iHdr;
                 int8_t status;
                 if (pNvHandle->actOffset > NVOCMP_PGDATAOFS + NVOCMP_ITEMHDRLEN)
                 {
                     NVOCMP_readHeader(pNvHandle->actPage, pNvHandle->actOffset - NVOCMP_ITEMHDRLEN, &iHdr, false);
-                    if (iHdr.stats & NVOCMP_FOLLOWBIT)
+                    // Uncommitted staged items are removed by compaction
+                    if ((iHdr.stats & NVOCMP_FOLLOWBIT) && !(iHdr.stats & NVOCMP_VALIDIDBIT))
                     {
                         status = NVOCMP_findItem(pNvHandle,
                                                  pNvHandle->actPage,
@@ -2698,13 +3198,16 @@ static void NVOCMP_initNv(NVOCMP_nvHandle_t *pNvHandle)
     {
         case NVOCMP_NORMAL_RESUME:
             // resume state, set head page, act page and tail page
+            // Complete or discard a transaction interrupted by reset
+            NVOCMP_resumeTxn(pNvHandle);
             do
             {
                 compaction_occurred = false;
                 if (pNvHandle->actOffset > NVOCMP_PGDATAOFS + NVOCMP_ITEMHDRLEN)
                 {
                     NVOCMP_readHeader(pNvHandle->actPage, pNvHandle->actOffset - NVOCMP_ITEMHDRLEN, &iHdr, false);
-                    if (iHdr.stats & NVOCMP_FOLLOWBIT)
+                    // Uncommitted staged items are removed by compaction
+                    if ((iHdr.stats & NVOCMP_FOLLOWBIT) && !(iHdr.stats & NVOCMP_VALIDIDBIT))
                     {
                         /* Cache current active page value before search starts */
                         prevactPage = pNvHandle->actPage;
@@ -2828,10 +3331,13 @@ static void NVOCMP_initNv(NVOCMP_nvHandle_t *pNvHandle)
     {
         case NVOCMP_NORMAL_RESUME:
             // resume state, set head page, act page and tail page
+            // Complete or discard a transaction interrupted by reset
+            NVOCMP_resumeTxn(pNvHandle);
             if (pNvHandle->actOffset > NVOCMP_PGDATAOFS + NVOCMP_ITEMHDRLEN)
             {
                 NVOCMP_readHeader(pNvHandle->actPage, pNvHandle->actOffset - NVOCMP_ITEMHDRLEN, &iHdr, false);
-                if (iHdr.stats & NVOCMP_FOLLOWBIT)
+                // Uncommitted staged items are removed by compaction
+                if ((iHdr.stats & NVOCMP_FOLLOWBIT) && !(iHdr.stats & NVOCMP_VALIDIDBIT))
                 {
                     status = NVOCMP_findItem(pNvHandle,
                                              pNvHandle->actPage,
@@ -2922,6 +3428,7 @@ static uint8_t NVOCMP_checkItem(NVINTF_itemID_t *id, uint16_t len, NVOCMP_itemHd
     pHdr->itemid = id->itemID;
     pHdr->sysid  = id->systemID;
     pHdr->sig    = NVOCMP_SIGNATURE;
+    pHdr->stats  = 0;
 
     return (NVINTF_SUCCESS);
 }
@@ -3078,6 +3585,9 @@ static uint8_t NVOCMP_addItem(NVOCMP_nvHandle_t *pNvHandle,
     NVOCMP_writeItem(pNvHandle, iHdr, pNvHandle->actPage, pNvHandle->actOffset, pBuf);
 #endif
 
+    // Let the application schedule compaction before it is needed in line
+    NVOCMP_checkCompactThreshold();
+
     // Status of writing/erasing Flash
     return (NVOCMP_failW);
 }
@@ -3174,6 +3684,10 @@ static uint8_t NVOCMP_erase(NVOCMP_nvHandle_t *pNvHandle, uint8_t dstPg)
         nvsRes = NVS_erase(NVOCMP_nvsHandle, NVOCMP_FLASHOFFSET(dstPg, 0), NVOCMP_nvsAttrs.sectorSize);
 #else
         nvsRes  = NV_LINUX_erase(dstPg);
+#endif
+#ifdef NVOCMP_ITEM_INDEX
+        // Items may have been moved or removed
+        NVOCMP_indexInvalidate();
 #endif
         if (nvsRes < 0)
         {
@@ -3293,6 +3807,11 @@ static void NVOCMP_writeItem(NVOCMP_nvHandle_t *pNvHandle,
             // Note NVOCMP_VALIDIDBIT set implicitly zero
             cHdr[5] = ((newCRC & 0x3F) << 2) | NVOCMP_ACTIVEIDBIT;
 #endif
+            if (pHdr->stats & NVOCMP_VALIDIDBIT)
+            {
+                // Staged item, hidden until its transaction commits
+                cHdr[5] |= NVOCMP_HDRVALIDMARK;
+            }
             cHdr[6] = NVOCMP_SIGNATURE;
             memcpy(NVOCMP_itemBuffer + dLen, (const void *)cHdr, NVOCMP_ITEMHDRLEN);
             // NVS_write
@@ -3301,6 +3820,13 @@ static void NVOCMP_writeItem(NVOCMP_nvHandle_t *pNvHandle,
             dstOff += iLen;
             pNvHandle->actOffset += iLen;
             pNvHandle->pageInfo[dstPg].offset = dstOff;
+#ifdef NVOCMP_ITEM_INDEX
+            if (!NVOCMP_failW && !(pHdr->stats & NVOCMP_VALIDIDBIT))
+            {
+                // New copy supersedes any indexed one
+                NVOCMP_indexUpdate(pHdr->cmpid, dstPg, hOfs, true);
+            }
+#endif
         }
         else
         {
@@ -3321,6 +3847,11 @@ static void NVOCMP_writeItem(NVOCMP_nvHandle_t *pNvHandle,
             // Note NVOCMP_VALIDIDBIT set implicitly zero
             cHdr[5] = ((newCRC & 0x3F) << 2) | NVOCMP_ACTIVEIDBIT;
 #endif
+            if (pHdr->stats & NVOCMP_VALIDIDBIT)
+            {
+                // Staged item, hidden until its transaction commits
+                cHdr[5] |= NVOCMP_HDRVALIDMARK;
+            }
             cHdr[6]      = NVOCMP_SIGNATURE;
             // Write data
             NVOCMP_failW = NVOCMP_write(dstPg, dstOff, pBuf, dLen);
@@ -3333,6 +3864,13 @@ static void NVOCMP_writeItem(NVOCMP_nvHandle_t *pNvHandle,
                 dstOff += iLen;
                 pNvHandle->actOffset += iLen;
                 pNvHandle->pageInfo[dstPg].offset = dstOff;
+#ifdef NVOCMP_ITEM_INDEX
+                if (!(pHdr->stats & NVOCMP_VALIDIDBIT))
+                {
+                    // New copy supersedes any indexed one
+                    NVOCMP_indexUpdate(pHdr->cmpid, dstPg, hOfs, true);
+                }
+#endif
             }
             else
             {
@@ -3517,6 +4055,9 @@ static void NVOCMP_setItemInactive(NVOCMP_nvHandle_t *pNvHandle, uint8_t pg, uin
 #endif
     // Mark the item as inactive
     NVOCMP_writeByte(pg, iOfs + NVOCMP_HDRVLDOFS, tmp);
+#ifdef NVOCMP_ITEM_INDEX
+    NVOCMP_indexRemove(pg, iOfs);
+#endif
 
     if (pNvHandle->pageInfo[pg].allActive)
     {
@@ -3527,6 +4068,153 @@ static void NVOCMP_setItemInactive(NVOCMP_nvHandle_t *pNvHandle, uint8_t pg, uin
     }
 }
 
+/******************************************************************************
+ * @fn      NVOCMP_setItemValid
+ *
+ * @brief   Mark a staged item as valid
+ *
+ * @param   pg - page where the item is located
+ * @param   iOfs - Offset to item header (lowest address) in active page
+ *
+ * @return  none
+ */
+static void NVOCMP_setItemValid(uint8_t pg, uint16_t iOfs)
+{
+    uint8_t tmp;
+
+    // Get byte with validity bit
+    tmp = NVOCMP_readByte(pg, iOfs + NVOCMP_HDRVLDOFS);
+
+    // Clear VALID_IDS_MARK, '0' indicates valid
+    tmp &= ~NVOCMP_HDRVALIDMARK;
+
+    // Mark the item as valid
+    NVOCMP_writeByte(pg, iOfs + NVOCMP_HDRVLDOFS, tmp);
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_finishTxn
+ *
+ * @brief   Complete a committed write transaction. The staged items preceding
+ *          the marker are marked valid, the copies they replace are marked
+ *          inactive, then the marker itself. Each step can be repeated, so a
+ *          transaction interrupted by reset is finished again on init.
+ *
+ * @param   pNvHandle - pointer to NV handle
+ * @param   pg - page where the marker is located
+ * @param   mOfs - Offset to marker header
+ * @param   pItems - staged items with the location of the copies they
+ *                   replace, NULL to search for those copies
+ *
+ * @return  none
+ */
+static void NVOCMP_finishTxn(NVOCMP_nvHandle_t *pNvHandle, uint8_t pg, uint16_t mOfs, NVOCMP_txnItem_t *pItems)
+{
+    uint16_t count;
+    uint16_t n;
+    uint16_t ofs;
+    uint16_t startOfs;
+    NVOCMP_itemHdr_t iHdr;
+    NVOCMP_itemHdr_t hdr;
+
+    NVOCMP_read(pg, mOfs - sizeof(count), (uint8_t *)&count, sizeof(count));
+
+    // Find the first staged item, the end of older items
+    ofs = mOfs - sizeof(count);
+    for (n = 0; n < count; n++)
+    {
+        if (ofs < (NVOCMP_PGDATAOFS + NVOCMP_ITEMHDRLEN))
+        {
+            break;
+        }
+        NVOCMP_readHeader(pg, ofs - NVOCMP_ITEMHDRLEN, &iHdr, false);
+        if (!(iHdr.stats & NVOCMP_FOLLOWBIT) || ((iHdr.len + NVOCMP_ITEMHDRLEN + NVOCMP_PGDATAOFS) > ofs))
+        {
+            break;
+        }
+        ofs -= NVOCMP_ITEMHDRLEN + iHdr.len;
+    }
+    NVOCMP_ALERT(n == count, "Transaction items corrupted.")
+    startOfs = ofs;
+    count    = n;
+
+    // Staged items were written in order, walk back from the last one
+    ofs = mOfs - sizeof(count);
+    for (n = count; n > 0; n--)
+    {
+        ofs -= NVOCMP_ITEMHDRLEN;
+        NVOCMP_readHeader(pg, ofs, &iHdr, false);
+        if (iHdr.stats & NVOCMP_ACTIVEIDBIT)
+        {
+            if (pItems != NULL)
+            {
+                hdr = pItems[n - 1].hdr;
+            }
+            else
+            {
+                hdr.sysid  = iHdr.sysid;
+                hdr.itemid = iHdr.itemid;
+                hdr.subid  = iHdr.subid;
+                if (NVOCMP_findItem(pNvHandle, pg, startOfs, &hdr, NVOCMP_FINDSTRICT, NULL) != NVINTF_SUCCESS)
+                {
+                    hdr.hofs = 0;
+                }
+            }
+
+            NVOCMP_setItemValid(pg, ofs);
+#ifdef NVOCMP_ITEM_INDEX
+            // New copy supersedes any indexed one
+            NVOCMP_indexUpdate(iHdr.cmpid, pg, ofs, true);
+#endif
+            if (hdr.hofs > 0)
+            {
+                // Mark old item as inactive
+                NVOCMP_setItemInactive(pNvHandle, hdr.hpage, hdr.hofs);
+            }
+        }
+        ofs -= iHdr.len;
+    }
+
+    // Transaction is complete
+    NVOCMP_setItemInactive(pNvHandle, pg, mOfs);
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_resumeTxn
+ *
+ * @brief   Check whether a reset interrupted a write transaction, in which
+ *          case its marker is the last item on the active page. A marker
+ *          that was not committed is removed, a committed one is finished.
+ *
+ * @param   pNvHandle - pointer to NV handle
+ *
+ * @return  none
+ */
+static void NVOCMP_resumeTxn(NVOCMP_nvHandle_t *pNvHandle)
+{
+    NVOCMP_itemHdr_t mHdr;
+
+    if (pNvHandle->actOffset > NVOCMP_PGDATAOFS + NVOCMP_ITEMHDRLEN)
+    {
+        NVOCMP_readHeader(pNvHandle->actPage, pNvHandle->actOffset - NVOCMP_ITEMHDRLEN, &mHdr, false);
+        if ((mHdr.stats & NVOCMP_FOLLOWBIT) && (mHdr.stats & NVOCMP_ACTIVEIDBIT) &&
+            (mHdr.cmpid == NVOCMP_CMPRID(txnId.systemID, txnId.itemID, txnId.subID)) &&
+            (mHdr.len == sizeof(uint16_t)))
+        {
+            if (mHdr.stats & NVOCMP_VALIDIDBIT)
+            {
+                // Reset before the commit point, older copies remain current
+                NVOCMP_setItemInactive(pNvHandle, mHdr.hpage, mHdr.hofs);
+            }
+            else
+            {
+                // Reset after the commit point, complete the transaction
+                NVOCMP_finishTxn(pNvHandle, mHdr.hpage, mHdr.hofs, NULL);
+            }
+        }
+    }
+}
+
 /******************************************************************************
  * @fn      NVOCMP_setCompactHdr
  *
@@ -3753,6 +4441,18 @@ static int8_t NVOCMP_findItem(NVOCMP_nvHandle_t *pNvHandle,
     #endif
     uint32_t cid = NVOCMP_CMPRID(pHdr->sysid, pHdr->itemid, pHdr->subid);
 
+    #ifdef NVOCMP_ITEM_INDEX
+    // Exact searches from the newest item can be answered by the index
+    if ((flag == NVOCMP_FINDSTRICT) && (pg == pNvHandle->actPage) && (ofs == pNvHandle->actOffset))
+    {
+        int8_t status = NVOCMP_indexFind(pNvHandle, pHdr);
+        if (status != NVINTF_FAILURE)
+        {
+            return (status);
+        }
+    }
+    #endif
+
     #ifdef NVOCMP_GPRAM
     NVOCMP_disableCache(&vm);
     #endif
@@ -3905,6 +4605,18 @@ static int8_t NVOCMP_findItem(NVOCMP_nvHandle_t *pNvHandle,
     uint8_t p           = pg;
     uint32_t cid        = NVOCMP_CMPRID(pHdr->sysid, pHdr->itemid, pHdr->subid);
 
+    #ifdef NVOCMP_ITEM_INDEX
+    // Exact searches from the newest item can be answered by the index
+    if ((flag == NVOCMP_FINDSTRICT) && (pg == pNvHandle->actPage) && (ofs == pNvHandle->actOffset))
+    {
+        int8_t status = NVOCMP_indexFind(pNvHandle, pHdr);
+        if (status != NVINTF_FAILURE)
+        {
+            return (status);
+        }
+    }
+    #endif
+
     #if (NVOCMP_NVPAGES > NVOCMP_NVTWOP)
     uint16_t nvSearched = 0;
     for (p = pg; nvSearched < NVOCMP_NVSIZE; p = NVOCMP_DECPAGE(p), ofs = pNvHandle->pageInfo[p].offset)
@@ -4037,6 +4749,248 @@ static int8_t NVOCMP_findItem(NVOCMP_nvHandle_t *pNvHandle,
 }
 #endif
 
+#ifdef NVOCMP_ITEM_INDEX
+/******************************************************************************
+ * @fn      NVOCMP_indexInvalidate
+ *
+ * @brief   Mark the item index stale so it is rebuilt on the next lookup
+ *
+ * @return  none
+ */
+static void NVOCMP_indexInvalidate(void)
+{
+    NVOCMP_itemIndex.state = NVOCMP_INDEX_STALE;
+    NVOCMP_itemIndex.count = 0;
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_indexSearch
+ *
+ * @brief   Binary search of the item index
+ *
+ * @param   cmpid - compressed ID to look for
+ *
+ * @return  Position of first entry with compressed ID >= cmpid
+ */
+static uint16_t NVOCMP_indexSearch(uint32_t cmpid)
+{
+    uint16_t lo = 0;
+    uint16_t hi = NVOCMP_itemIndex.count;
+
+    while (lo < hi)
+    {
+        uint16_t mid = lo + ((hi - lo) >> 1);
+
+        if (NVOCMP_itemIndex.entry[mid].cmpid < cmpid)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return (lo);
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_indexUpdate
+ *
+ * @brief   Add an item to the index or move an indexed item
+ *
+ * @param   cmpid - compressed ID of the item
+ * @param   pg - page where the item header is located
+ * @param   hofs - offset of the item header
+ * @param   replace - true to replace an existing entry, false to keep it
+ *
+ * @return  none
+ */
+static void NVOCMP_indexUpdate(uint32_t cmpid, uint8_t pg, uint16_t hofs, bool replace)
+{
+    NVOCMP_indexEntry_t *pEntry;
+    uint16_t pos;
+
+    if ((NVOCMP_itemIndex.state != NVOCMP_INDEX_VALID) && (NVOCMP_itemIndex.state != NVOCMP_INDEX_PARTIAL))
+    {
+        return;
+    }
+
+    pos    = NVOCMP_indexSearch(cmpid);
+    pEntry = &NVOCMP_itemIndex.entry[pos];
+    if ((pos < NVOCMP_itemIndex.count) && (pEntry->cmpid == cmpid))
+    {
+        if (replace)
+        {
+            pEntry->hpage = pg;
+            pEntry->hofs  = hofs;
+        }
+        return;
+    }
+
+    if (NVOCMP_itemIndex.count >= NVOCMP_ITEM_INDEX_SIZE)
+    {
+        // No room, lookups of missing items fall back to page traversal
+        NVOCMP_itemIndex.state = NVOCMP_INDEX_PARTIAL;
+        return;
+    }
+
+    // Open a slot to keep the entries sorted
+    memmove(pEntry + 1, pEntry, (NVOCMP_itemIndex.count - pos) * sizeof(NVOCMP_indexEntry_t));
+    pEntry->cmpid = cmpid;
+    pEntry->hpage = pg;
+    pEntry->hofs  = hofs;
+    NVOCMP_itemIndex.count++;
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_indexRemove
+ *
+ * @brief   Remove the entry pointing to an item which has been set inactive
+ *
+ * @param   pg - page where the item header is located
+ * @param   hofs - offset of the item header
+ *
+ * @return  none
+ */
+static void NVOCMP_indexRemove(uint8_t pg, uint16_t hofs)
+{
+    uint16_t pos;
+
+    if ((NVOCMP_itemIndex.state != NVOCMP_INDEX_VALID) && (NVOCMP_itemIndex.state != NVOCMP_INDEX_PARTIAL))
+    {
+        return;
+    }
+
+    // Entries are sorted by ID, so removal by location is a linear RAM scan
+    for (pos = 0; pos < NVOCMP_itemIndex.count; pos++)
+    {
+        if ((NVOCMP_itemIndex.entry[pos].hofs == hofs) && (NVOCMP_itemIndex.entry[pos].hpage == pg))
+        {
+            NVOCMP_itemIndex.count--;
+            memmove(&NVOCMP_itemIndex.entry[pos],
+                    &NVOCMP_itemIndex.entry[pos + 1],
+                    (NVOCMP_itemIndex.count - pos) * sizeof(NVOCMP_indexEntry_t));
+            break;
+        }
+    }
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_indexBuild
+ *
+ * @brief   Build the item index with one traversal of the NV pages, from the
+ *          newest item to the oldest one. If a corrupted item is found, the
+ *          index is left unused so that findItem() handles the corruption.
+ *
+ * @param   pNvHandle - pointer to NV handle
+ *
+ * @return  none
+ */
+static void NVOCMP_indexBuild(NVOCMP_nvHandle_t *pNvHandle)
+{
+    uint8_t p    = pNvHandle->actPage;
+    uint16_t ofs = pNvHandle->actOffset;
+    NVOCMP_itemHdr_t iHdr;
+
+    NVOCMP_itemIndex.count = 0;
+    NVOCMP_itemIndex.state = NVOCMP_INDEX_VALID;
+
+    #if (NVOCMP_NVPAGES > NVOCMP_NVTWOP)
+    uint16_t nvSearched = 0;
+    for (p = pNvHandle->actPage; nvSearched < NVOCMP_NVSIZE; p = NVOCMP_DECPAGE(p), ofs = pNvHandle->pageInfo[p].offset)
+    {
+        nvSearched++;
+        if (p == pNvHandle->tailPage)
+        {
+            continue;
+        }
+    #endif
+        while (ofs >= (NVOCMP_PGDATAOFS + NVOCMP_ITEMHDRLEN))
+        {
+            // Align to start of item header
+            ofs -= NVOCMP_ITEMHDRLEN;
+
+            // Read and decompress item header
+            NVOCMP_readHeader(p, ofs, &iHdr, false);
+
+            if (!(iHdr.stats & NVOCMP_FOLLOWBIT) || (iHdr.len >= ofs))
+            {
+                NVOCMP_ALERT(false, "Corruption found, item index not used.")
+                NVOCMP_itemIndex.state = NVOCMP_INDEX_UNUSED;
+                NVOCMP_itemIndex.count = 0;
+                return;
+            }
+
+            if ((iHdr.stats & NVOCMP_ACTIVEIDBIT) && !(iHdr.stats & NVOCMP_VALIDIDBIT))
+            {
+                // Newest copy is found first, keep it
+                NVOCMP_indexUpdate(iHdr.cmpid, p, ofs, false);
+            }
+
+            ofs -= iHdr.len;
+        }
+    #if (NVOCMP_NVPAGES > NVOCMP_NVTWOP)
+    }
+    #endif
+}
+
+/******************************************************************************
+ * @fn      NVOCMP_indexFind
+ *
+ * @brief   Find the newest active copy of an item using the item index
+ *
+ * @param   pNvHandle - pointer to NV handle
+ * @param   pHdr - pointer to item header, sysid/itemid/subid are inputs
+ *
+ * @return  NVINTF_SUCCESS, if the item is found
+ *          NVINTF_NOTFOUND, if the item does not exist
+ *          NVINTF_FAILURE, if the index cannot answer and pages
+ *          must be searched
+ */
+static int8_t NVOCMP_indexFind(NVOCMP_nvHandle_t *pNvHandle, NVOCMP_itemHdr_t *pHdr)
+{
+    NVOCMP_indexEntry_t *pEntry;
+    NVOCMP_itemHdr_t iHdr;
+    uint32_t cid = NVOCMP_CMPRID(pHdr->sysid, pHdr->itemid, pHdr->subid);
+    uint16_t pos;
+
+    if (NVOCMP_itemIndex.state == NVOCMP_INDEX_STALE)
+    {
+        NVOCMP_indexBuild(pNvHandle);
+    }
+
+    if (NVOCMP_itemIndex.state == NVOCMP_INDEX_UNUSED)
+    {
+        return (NVINTF_FAILURE);
+    }
+
+    pos    = NVOCMP_indexSearch(cid);
+    pEntry = &NVOCMP_itemIndex.entry[pos];
+    if ((pos >= NVOCMP_itemIndex.count) || (pEntry->cmpid != cid))
+    {
+        if (NVOCMP_itemIndex.state == NVOCMP_INDEX_PARTIAL)
+        {
+            return (NVINTF_FAILURE);
+        }
+        pHdr->hofs = 0;
+        return (NVINTF_NOTFOUND);
+    }
+
+    // Confirm the indexed header still describes this item
+    NVOCMP_readHeader(pEntry->hpage, pEntry->hofs, &iHdr, false);
+    if ((iHdr.cmpid != cid) || !(iHdr.stats & NVOCMP_ACTIVEIDBIT) || (iHdr.stats & NVOCMP_VALIDIDBIT))
+    {
+        NVOCMP_ALERT(false, "Item index out of date.")
+        NVOCMP_indexInvalidate();
+        return (NVINTF_FAILURE);
+    }
+
+    memcpy(pHdr, &iHdr, sizeof(NVOCMP_itemHdr_t));
+    return (NVINTF_SUCCESS);
+}
+#endif // NVOCMP_ITEM_INDEX
+
 #if (NVOCMP_NVPAGES > NVOCMP_NVTWOP)
 /******************************************************************************
  * @fn      NVOCMP_cleanPage
@@ -4139,6 +5093,7 @@ static int16_t NVOCMP_compactPage(NVOCMP_nvHandle_t *pNvHandle, uint16_t nBytes)
     NVOCMP_compactStatus_t status;
     NVOCMP_pageHdr_t pageHdr;
     uint8_t allActivePages = 0;
+    uint8_t dstPages       = 0;
     uint8_t err            = NVINTF_SUCCESS;
 
     // Check voltage if possible
@@ -4301,6 +5256,12 @@ static int16_t NVOCMP_compactPage(NVOCMP_nvHandle_t *pNvHandle, uint16_t nBytes)
         {
             break;
         }
+        // Incremental compaction, stop once the step budget is used
+        dstPages++;
+        if (pNvHandle->compactLimit && (dstPages >= pNvHandle->compactLimit))
+        {
+            break;
+        }
     }
 
     pg = NVOCMP_findPage(NVOCMP_PGACT);
@@ -4541,6 +5502,10 @@ static NVOCMP_compactStatus_t NVOCMP_compact(NVOCMP_nvHandle_t *pNvHandle)
     // Reset Flash erase/write fail indicator
     NVOCMP_failW = NVINTF_SUCCESS;
     srcStartPg   = pNvHandle->compactInfo.xSrcSPage;
+    #ifdef NVOCMP_ITEM_INDEX
+    // Items are about to move, index is rebuilt on next lookup
+    NVOCMP_indexInvalidate();
+    #endif
     srcEndPg     = NVOCMP_ADDPAGE(srcStartPg, pNvHandle->compactInfo.xSrcPages - 1);
 
     // Stop looking when we get to this offset
@@ -4790,6 +5755,10 @@ static NVOCMP_compactStatus_t NVOCMP_compact(NVOCMP_nvHandle_t *pNvHandle)
     #endif
     // Reset Flash erase/write fail indicator
     NVOCMP_failW = NVINTF_SUCCESS;
+    #ifdef NVOCMP_ITEM_INDEX
+    // Items are about to move, index is rebuilt on next lookup
+    NVOCMP_indexInvalidate();
+    #endif
 
     // Stop looking when we get to this offset
     endOff = NVOCMP_PGDATAOFS + NVOCMP_ITEMHDRLEN - 1;
@@ -5058,22 +6027,19 @@ static uint8_t NVOCMP_doNVCRC(uint8_t pg, uint16_t ofs, uint16_t len, uint8_t cr
     uint8_t tmp[NVOCMP_XFERBLKMAX];
     crc_t newCRC = (crc_t)crc;
 
+#ifndef NVOCMP_RAM_OPTIMIZATION
+    // Item is already in the RAM buffer, compute CRC in place
+    if (flag)
+    {
+        return (crc_update(newCRC, pTBuffer + ofs, len));
+    }
+#endif
+
     // Read flash and compute CRC in blocks
     while (len > 0)
     {
         rdLen = (len < NVOCMP_XFERBLKMAX ? len : NVOCMP_XFERBLKMAX);
-#ifndef NVOCMP_RAM_OPTIMIZATION
-        if (flag)
-        {
-            memcpy((uint8_t *)tmp, (uint8_t *)(pTBuffer + ofs), rdLen);
-        }
-        else
-        {
-#endif
-            NVOCMP_read(pg, ofs, tmp, rdLen);
-#ifndef NVOCMP_RAM_OPTIMIZATION
-        }
-#endif
+        NVOCMP_read(pg, ofs, tmp, rdLen);
         newCRC = crc_update(newCRC, tmp, rdLen);
         len -= rdLen;
         ofs += rdLen;
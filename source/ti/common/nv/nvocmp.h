@@ -67,6 +67,12 @@ extern "C" {
         NVINTF_SYSID_NVDRVR, 1, 0 \
     }
 
+// Write transaction commit marker, used internally by the driver
+#define NVOCMP_NVID_TXN           \
+    {                             \
+        NVINTF_SYSID_NVDRVR, 2, 0 \
+    }
+
 //*****************************************************************************
 // Typedefs
 //*****************************************************************************
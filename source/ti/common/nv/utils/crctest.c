@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== crctest.c ========
+ *
+ * Check and benchmark of the NV item CRC.
+ *
+ * crc.c is compiled from the SDK sources, with or without CRC_SLICE_BY_4,
+ * and crc_update() is checked against a bitwise CRC-8 with the polynomial
+ * 0x97 for unaligned data and for data split across several calls. The
+ * CRC is stored in flash with each NV item, so both configurations must
+ * give the same values.
+ *
+ * The benchmark prints the crc_update() throughput for a typical NV item
+ * size and for a large item.
+ *
+ * Usage:
+ *
+ *     crctest [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ti/common/nv/crc.h"
+
+#ifdef CRC_SLICE_BY_4
+    #define CRC_NAME "CRC_SLICE_BY_4"
+#else
+    #define CRC_NAME "single table"
+#endif
+
+#define CHECK(cond, ...)                                       \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            if (failures++ < 20)                               \
+            {                                                  \
+                printf("FAIL %s:%d: ", __FILE__, __LINE__);    \
+                printf(__VA_ARGS__);                           \
+                printf("\n");                                  \
+            }                                                  \
+        }                                                      \
+    } while (0)
+
+static int failures;
+
+static crc_t refCrc(crc_t crc, const uint8_t *data, size_t len)
+{
+    while (len--)
+    {
+        crc ^= *data++;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x97 : (crc << 1);
+        }
+    }
+    return (crc);
+}
+
+static void fill(uint8_t *buf, uint32_t len, uint32_t seed)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        seed = seed * 1664525U + 1013904223U;
+        buf[i] = seed >> 24;
+    }
+}
+
+static void check(int iterations)
+{
+    static uint8_t buf[4096];
+    uint32_t seed = 1;
+
+    fill(buf, sizeof(buf), 1);
+
+    for (uint32_t value = 0; value < 256; value++)
+    {
+        uint8_t byte = value;
+        CHECK(crc_update(crc_init(), &byte, 1) == refCrc(0, &byte, 1), "byte %02x", (unsigned)value);
+    }
+
+    for (uint32_t offset = 0; offset < 4; offset++)
+    {
+        for (uint32_t len = 0; len < 600; len++)
+        {
+            crc_t expected = refCrc(0, buf + offset, len);
+            crc_t crc      = crc_finalize(crc_update(crc_init(), buf + offset, len));
+
+            CHECK(crc == expected, "offset %u length %u: %02x, expected %02x", offset, len, crc, expected);
+        }
+    }
+
+    /* Chained updates with random seeds, offsets and split points */
+    for (int n = 0; n < iterations; n++)
+    {
+        seed          = seed * 1664525U + 1013904223U;
+        crc_t start   = seed >> 24;
+        size_t offset = (seed >> 4) & 7;
+        size_t len    = (seed >> 8) % 1000;
+        size_t split  = (len != 0) ? (seed >> 16) % len : 0;
+
+        crc_t expected = refCrc(start, buf + offset, len);
+        crc_t crc      = crc_update(start, buf + offset, split);
+        crc            = crc_update(crc, buf + offset + split, len - split);
+
+        CHECK(crc == expected, "seed %02x offset %u length %u split at %u: %02x, expected %02x", start,
+              (unsigned)offset, (unsigned)len, (unsigned)split, crc, expected);
+    }
+}
+
+static double nsSince(const struct timespec *start, uint32_t count)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (((end.tv_sec - start->tv_sec) * 1e9 + (end.tv_nsec - start->tv_nsec)) / count);
+}
+
+static void bench(uint32_t len, uint32_t repeats)
+{
+    static uint8_t buf[4097];
+    struct timespec start;
+    volatile crc_t sink = 0;
+
+    fill(buf, sizeof(buf), 2);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t n = 0; n < repeats; n++)
+    {
+        sink += crc_update(crc_init(), buf + (n & 1), len);
+    }
+    double update = nsSince(&start, repeats);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t n = 0; n < repeats; n++)
+    {
+        sink += refCrc(0, buf + (n & 1), len);
+    }
+    double bitwise = nsSince(&start, repeats);
+
+    printf("%s, %u byte item: crc_update() %.1f ns, bitwise loop %.1f ns\n", CRC_NAME, len, update, bitwise);
+}
+
+int main(int argc, char *argv[])
+{
+    int iterations = (argc > 1) ? atoi(argv[1]) : 100000;
+
+    check(iterations);
+    if (failures != 0)
+    {
+        printf("%d failures\n", failures);
+        return (1);
+    }
+    printf("checks passed\n");
+    bench(64, 1000000);
+    bench(4096, 20000);
+    return (0);
+}
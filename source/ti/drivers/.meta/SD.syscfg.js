@@ -54,9 +54,50 @@ will be accessible by the application.
 [1]: /drivers/doxygen/html/_s_d_fat_f_s_8h.html#details "C API reference"
 `,
         default: false
+    },
+    {
+        name: "cacheSectors",
+        displayName: "Cache Sectors",
+        description: "Number of sectors in the sector cache. 0 disables the"
+            + " cache.",
+        longDescription: `Single sector reads, which FatFS uses for file
+system metadata, are served from a cache of this many 512 byte sectors. The
+cache is write-through and takes 512 bytes of RAM per sector.
+`,
+        isInteger: true,
+        default: 0
+    },
+    {
+        name: "readAheadSectors",
+        displayName: "Read Ahead Sectors",
+        description: "Number of consecutive sectors read into the cache when"
+            + " a single sector read misses it.",
+        isInteger: true,
+        default: 2
     }
 ];
 
+/*
+ *  ======== validate ========
+ *  Validate this instance's configuration
+ *
+ *  @param inst       - SD instance to be validated
+ *  @param validation - object to hold detected validation issues
+ */
+function validate(inst, validation)
+{
+    if (inst.cacheSectors < 0 || inst.cacheSectors > 8) {
+        Common.logError(validation, inst, "cacheSectors",
+            "Must be in the range 0 to 8");
+    }
+
+    if (inst.cacheSectors > 0 && (inst.readAheadSectors < 1 ||
+        inst.readAheadSectors > inst.cacheSectors)) {
+        Common.logError(validation, inst, "readAheadSectors",
+            "Must be in the range 1 to " + inst.cacheSectors);
+    }
+}
+
 /*
  *  ========= filterHardware ========
  *  param component - hardware object describing signals and
@@ -262,6 +303,7 @@ operations on SD cards.
     pinmuxRequirements: pinmuxRequirements,
     moduleInstances: moduleInstances,
     filterHardware: filterHardware,
+    validate: validate,
     _getPinResources: _getPinResources,
     templates             : {
         /* contribute libraries to linker command file */
@@ -72,6 +72,16 @@ let config = [
         description: "Size of the write verification buffer in bytes.",
         default: 0x100
     },
+    {
+        name: "writeBuffer",
+        displayName: "Write Buffer",
+        description: "Combine small writes into whole page programs.",
+        longDescription: "When enabled, a page sized buffer is allocated for"
+            + " the region and NVS_write() calls without flags are collected"
+            + " in it before they are programmed. Buffered data is lost on a"
+            + " reset until it is flushed with NVSSPI25X_CMD_FLUSH.",
+        default: false
+    },
     {
         name: "statusPollDelay",
         displayName: "Status Poll Delay",
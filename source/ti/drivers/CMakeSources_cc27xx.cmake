@@ -8,6 +8,7 @@ set(SOURCES_CC27XX
     ADCBuf.c
     adcbuf/ADCBufLPF3.c
     apu/APULPF3.c
+    apu/APULPF3Sequence.c
     batterymonitor/BatteryMonitorLPF3.c
     batterymonitor/BatMonSupportLPF3.c
     CAN.c
@@ -603,7 +603,7 @@ int_fast16_t APULPF3_covMatrixSpatialSmoothing(APULPF3_ComplexVector *vec,
 
     inputSize = APULPF3_prepareVectors(vec, vec);
 
-    APULPF3_prepareResult(covMatrixSize * covMatrixSize, inputSize, result->data);
+    APULPF3_prepareResult((covMatrixSize * (covMatrixSize + 1)) / 2, inputSize, result->data);
 
     APUSpSmoothCovMatrix(vec->size, object.argA, covMatrixSize, object.result, fbAveraging);
 
@@ -691,7 +691,7 @@ int_fast16_t APULPF3_matrixMult(APULPF3_ComplexMatrix *matA, APULPF3_ComplexMatr
         }
 
         inputSize = APULPF3_prepareMatrices(matA, matB);
-        APULPF3_prepareResult(matA->cols * matB->rows, inputSize, result->data);
+        APULPF3_prepareResult(matA->rows * matB->cols, inputSize, result->data);
 
         APUMatrixMult(matA->rows, matA->cols, matB->cols, object.argA, object.argB, object.result);
 
@@ -904,7 +904,7 @@ int_fast16_t APULPF3_jacobiEVD(APULPF3_ComplexTriangleMatrix *mat,
                                float epsTol,
                                APULPF3_ComplexVector *result)
 {
-    APULPF3_ComplexMatrix EVDmat;
+    APULPF3_ComplexVector EVDvec;
     uint16_t resultSize;
     float complex *eigVecs;
 
@@ -918,10 +918,10 @@ int_fast16_t APULPF3_jacobiEVD(APULPF3_ComplexTriangleMatrix *mat,
         object.scratchpad = true;
     }
 
-    EVDmat.data = mat->data;
-    EVDmat.rows = mat->size;
-    EVDmat.cols = mat->size;
-    APULPF3_prepareMatrices(&EVDmat, &EVDmat);
+    /* Only load the upper triangle, which is all the input buffer holds. */
+    EVDvec.data = mat->data;
+    EVDvec.size = (mat->size * mat->size + mat->size) / 2;
+    APULPF3_prepareVectors(&EVDvec, &EVDvec);
 
     /* Produces both the upper triangular part of a NxN in-place matrix and an NxN matrix. */
     resultSize = (mat->size * mat->size) + ((mat->size * mat->size + mat->size) / 2);
@@ -1098,6 +1098,28 @@ void *APULPF3_loadArgMirrored(uint16_t argSize, uint16_t offset, float complex *
     return arg;
 }
 
+/*
+ *  ======== APULPF3_readArgMirrored ========
+ */
+void APULPF3_readArgMirrored(uint16_t argSize, uint16_t offset, float complex *dst)
+{
+    float loadVal;
+    float *memPtr      = (float *)(APURAM_DATA0_BASE + offset * 8);
+    float *destination = (float *)dst;
+
+    for (uint32_t i = 0; i < 2 * argSize; i++)
+    {
+        /*
+         * Read individual floats with a nop to
+         * prevent back-to-back memory accesses.
+         */
+        loadVal = memPtr[i];
+        __asm volatile("nop");
+        destination[i] = loadVal;
+        __asm volatile("nop");
+    }
+}
+
 /*
  *  ======== APULPF3_loadTriangular ========
  */
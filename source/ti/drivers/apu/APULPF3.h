@@ -82,6 +82,41 @@
  *  Copying data back from APU memory is automatically handled by the driver,
  *  and happens in an interrupt when the result pointer is outside APU memory.
  *
+ *  @anchor ti_drivers_APU_Sequences
+ *  ## Operation sequences
+ *  Pipelines such as FFT, magnitude and peak search, or covariance matrix,
+ *  EVD and sort, can be recorded as an #APULPF3_Sequence: an array of steps
+ *  whose operands are offsets in APU memory. #APULPF3_validateSequence()
+ *  checks the data flow once, after which #APULPF3_runSequence() loads the
+ *  input, runs every step in scratchpad mode and copies out only the final
+ *  result, instead of moving every intermediate result through system RAM.
+ *  @code
+ *  static const APULPF3_SequenceStep steps[] = {
+ *      APULPF3_SEQ_FFT(0, 256, false),
+ *      APULPF3_SEQ_CARTESIAN_TO_POLAR(0, 256, 256),
+ *      APULPF3_SEQ_VECTOR_MAX_MIN(256, 256, 0.01f, false, 512),
+ *  };
+ *  static APULPF3_Sequence seq = {.steps = steps, .numSteps = 3,
+ *                                 .inputOffset = 0, .inputSize = 256,
+ *                                 .outputOffset = 512, .outputSize = 256};
+ *
+ *  APULPF3_validateSequence(&seq);
+ *
+ *  APULPF3_startOperationSequence();
+ *  APULPF3_runSequence(&seq, samples, peaks);
+ *  APULPF3_stopOperationSequence();
+ *  @endcode
+ *
+ *  @anchor ti_drivers_APU_Emulation
+ *  ## Host emulation
+ *  APULPF3Emu.c implements this API on a host machine, so that algorithms
+ *  built on the driver can be tested and profiled off-target. Build it and
+ *  APULPF3EmuKernels.c in place of APULPF3.c, with APULPF3_EMULATION and the
+ *  device family (e.g. DeviceFamily_CC27XX) defined. APU RAM is then an array
+ *  that #APULPF3_MEM_BASE points to, and data is placed in it like on target.
+ *  Results are single precision and identical on all hosts, but may differ
+ *  from the APU in the last bits.
+ *
  *  The primary purpose of this driver is executing the MUSIC algorithm for
  *  distance estimation in Bluetooth Channel Sounding. An implementation of
  *  MUSIC using the APU can be found in the apu_music example.
@@ -276,6 +311,181 @@ typedef struct
     APULPF3_SchedulingMode schedulingMode;
 } APULPF3_HWAttrs;
 
+/*!
+ *  @brief  Operations that can be recorded in an #APULPF3_Sequence.
+ *
+ *  Each maps to the APULPF3 function of the same name.
+ */
+typedef enum
+{
+    APULPF3_SequenceOp_dotProduct = 0,
+    APULPF3_SequenceOp_vectorMult,
+    APULPF3_SequenceOp_vectorSum,
+    APULPF3_SequenceOp_vectorScalarSum,
+    APULPF3_SequenceOp_vectorScalarMult,
+    APULPF3_SequenceOp_vectorR2C,
+    APULPF3_SequenceOp_vectorMaxMin,
+    APULPF3_SequenceOp_cartesianToPolarVector,
+    APULPF3_SequenceOp_polarToCartesianVector,
+    APULPF3_SequenceOp_sortVector,
+    APULPF3_SequenceOp_covMatrixSpatialSmoothing,
+    APULPF3_SequenceOp_computeFFT,
+    APULPF3_SequenceOp_matrixMult,
+    APULPF3_SequenceOp_matrixSum,
+    APULPF3_SequenceOp_HermLo,
+    APULPF3_SequenceOp_matrixScalarSum,
+    APULPF3_SequenceOp_matrixScalarMult,
+    APULPF3_SequenceOp_matrixNorm,
+    APULPF3_SequenceOp_jacobiEVD,
+    APULPF3_SequenceOp_gaussJordanElim,
+    APULPF3_SequenceOp_unitCircle,
+    APULPF3_SequenceOp_count,
+} APULPF3_SequenceOp;
+
+/*!
+ *  @brief  One operation of an #APULPF3_Sequence.
+ *
+ *  Operands are offsets into APU memory, counted in complex numbers. Use the
+ *  APULPF3_SEQ_* macros to fill in a step; they document which fields each
+ *  operation uses.
+ */
+typedef struct
+{
+    /*! Operation to perform */
+    APULPF3_SequenceOp op;
+    /*! Offset of the first operand */
+    uint16_t argA;
+    /*! Offset of the second operand, scalar or temporary vector */
+    uint16_t argB;
+    /*! Offset of the result */
+    uint16_t result;
+    /*! Vector length, matrix rows or triangle matrix size */
+    uint16_t rows;
+    /*! Matrix columns, or the size of the covariance matrix */
+    uint16_t cols;
+    /*! Columns of the second matrix, R2C operator, iterations or unit circle constant */
+    uint16_t param;
+    /*! Unit circle phase */
+    uint16_t phase;
+    /*! Conjugate, subtraction, min, inverse or forward-backward averaging */
+    bool flag;
+    /*! Max/min or zero threshold, or EVD stop threshold */
+    float threshold;
+    /*! EVD epsilon tolerance */
+    float epsTol;
+    /*! Scalar operand, written to @c argB when the step runs */
+    float complex scalar;
+} APULPF3_SequenceStep;
+
+/*!
+ *  @brief  A validated chain of APU operations, see @ref ti_drivers_APU_Sequences.
+ */
+typedef struct
+{
+    /*! Operations, in execution order */
+    const APULPF3_SequenceStep *steps;
+    /*! Number of operations */
+    uint16_t numSteps;
+    /*! Offset in APU memory that the input is loaded to */
+    uint16_t inputOffset;
+    /*! Number of complex numbers in the input, may be 0 */
+    uint16_t inputSize;
+    /*! Offset in APU memory of the final result */
+    uint16_t outputOffset;
+    /*! Number of complex numbers in the final result */
+    uint16_t outputSize;
+    /*! Set by #APULPF3_validateSequence() */
+    bool isValid;
+} APULPF3_Sequence;
+
+/*!
+ * @brief Number of complex numbers in APU memory.
+ */
+#define APULPF3_MEM_ELEMENTS (APURAM_DATA0_SIZE / sizeof(float complex))
+
+/*!
+ * @brief Number of complex numbers at the end of APU memory that the APU
+ *        firmware uses as a heap for scalar operands, see APU_HEAP_ADDR in
+ *        driverlib apu.c.
+ */
+#define APULPF3_FW_HEAP_SIZE 50U
+
+/*!
+ * @brief Part of APU memory available to sequences, in complex numbers:
+ *        everything below the firmware heap.
+ */
+#define APULPF3_SEQUENCE_MEM_SIZE (APULPF3_MEM_ELEMENTS - APULPF3_FW_HEAP_SIZE)
+
+/*! @brief Step computing dot(A, B) of N elements, conjugating B if @c conj */
+#define APULPF3_SEQ_DOT_PRODUCT(A, B, N, conj, R) \
+    {.op = APULPF3_SequenceOp_dotProduct, .argA = (A), .argB = (B), .result = (R), .rows = (N), .flag = (conj)}
+/*! @brief Step computing A .* B of N elements, conjugating B if @c conj */
+#define APULPF3_SEQ_VECTOR_MULT(A, B, N, conj, R) \
+    {.op = APULPF3_SequenceOp_vectorMult, .argA = (A), .argB = (B), .result = (R), .rows = (N), .flag = (conj)}
+/*! @brief Step computing A + B, or A - B if @c sub, of N elements */
+#define APULPF3_SEQ_VECTOR_SUM(A, B, N, sub, R) \
+    {.op = APULPF3_SequenceOp_vectorSum, .argA = (A), .argB = (B), .result = (R), .rows = (N), .flag = (sub)}
+/*! @brief Step computing A + s, or A - s if @c sub. @c s is stored at @c S */
+#define APULPF3_SEQ_VECTOR_SCALAR_SUM(A, N, s, S, sub, R)                                                    \
+    {.op = APULPF3_SequenceOp_vectorScalarSum, .argA = (A), .argB = (S), .result = (R), .rows = (N), \
+     .flag = (sub), .scalar = (s)}
+/*! @brief Step computing A * s. @c s is stored at @c S */
+#define APULPF3_SEQ_VECTOR_SCALAR_MULT(A, N, s, S, R) \
+    {.op = APULPF3_SequenceOp_vectorScalarMult, .argA = (A), .argB = (S), .result = (R), .rows = (N), .scalar = (s)}
+/*! @brief Step converting A and B with the #APULPF3_R2COp @c operator */
+#define APULPF3_SEQ_VECTOR_R2C(A, B, N, operator, R) \
+    {.op = APULPF3_SequenceOp_vectorR2C, .argA = (A), .argB = (B), .result = (R), .rows = (N), .param = (operator)}
+/*! @brief Step computing max(real(A), thr), or min if @c min */
+#define APULPF3_SEQ_VECTOR_MAX_MIN(A, N, thr, min, R)                                                     \
+    {.op = APULPF3_SequenceOp_vectorMaxMin, .argA = (A), .result = (R), .rows = (N), .threshold = (thr), \
+     .flag = (min)}
+/*! @brief Step converting A from Cartesian to polar format */
+#define APULPF3_SEQ_CARTESIAN_TO_POLAR(A, N, R) \
+    {.op = APULPF3_SequenceOp_cartesianToPolarVector, .argA = (A), .result = (R), .rows = (N)}
+/*! @brief Step converting A from polar to Cartesian format, using N elements at @c T as temporary */
+#define APULPF3_SEQ_POLAR_TO_CARTESIAN(A, N, T, R) \
+    {.op = APULPF3_SequenceOp_polarToCartesianVector, .argA = (A), .argB = (T), .result = (R), .rows = (N)}
+/*! @brief Step sorting A in place */
+#define APULPF3_SEQ_SORT_VECTOR(A, N) {.op = APULPF3_SequenceOp_sortVector, .argA = (A), .result = (A), .rows = (N)}
+/*! @brief Step computing the LxL covariance upper triangle matrix of A */
+#define APULPF3_SEQ_COV_MATRIX(A, N, L, fb, R)                                                                    \
+    {.op = APULPF3_SequenceOp_covMatrixSpatialSmoothing, .argA = (A), .result = (R), .rows = (N), .cols = (L), \
+     .flag = (fb)}
+/*! @brief Step computing the FFT, or IFFT if @c inverse, of A in place */
+#define APULPF3_SEQ_FFT(A, N, inverse) \
+    {.op = APULPF3_SequenceOp_computeFFT, .argA = (A), .result = (A), .rows = (N), .flag = (inverse)}
+/*! @brief Step computing A * B, with A of size MxN and B of size NxP */
+#define APULPF3_SEQ_MATRIX_MULT(A, B, M, N, P, R) \
+    {.op = APULPF3_SequenceOp_matrixMult, .argA = (A), .argB = (B), .result = (R), .rows = (M), .cols = (N), .param = (P)}
+/*! @brief Step computing A + B of size MxN */
+#define APULPF3_SEQ_MATRIX_SUM(A, B, M, N, R) \
+    {.op = APULPF3_SequenceOp_matrixSum, .argA = (A), .argB = (B), .result = (R), .rows = (M), .cols = (N)}
+/*! @brief Step converting the NxN upper triangle matrix A to its lower Hermitian */
+#define APULPF3_SEQ_HERM_LO(A, N, R) {.op = APULPF3_SequenceOp_HermLo, .argA = (A), .result = (R), .rows = (N)}
+/*! @brief Step computing A + s of size MxN. @c s is stored at @c S */
+#define APULPF3_SEQ_MATRIX_SCALAR_SUM(A, M, N, s, S, R)                                                          \
+    {.op = APULPF3_SequenceOp_matrixScalarSum, .argA = (A), .argB = (S), .result = (R), .rows = (M), .cols = (N), \
+     .scalar = (s)}
+/*! @brief Step computing A * s of size MxN. @c s is stored at @c S */
+#define APULPF3_SEQ_MATRIX_SCALAR_MULT(A, M, N, s, S, R)                                                          \
+    {.op = APULPF3_SequenceOp_matrixScalarMult, .argA = (A), .argB = (S), .result = (R), .rows = (M), .cols = (N), \
+     .scalar = (s)}
+/*! @brief Step computing the norm of A of size MxN */
+#define APULPF3_SEQ_MATRIX_NORM(A, M, N, R) \
+    {.op = APULPF3_SequenceOp_matrixNorm, .argA = (A), .result = (R), .rows = (M), .cols = (N)}
+/*! @brief Step computing the EVD of the NxN upper triangle matrix A. Eigenvalues replace A, eigenvectors go to @c V */
+#define APULPF3_SEQ_JACOBI_EVD(A, N, maxIter, stop, eps, V)                                                          \
+    {.op = APULPF3_SequenceOp_jacobiEVD, .argA = (A), .result = (V), .rows = (N), .param = (maxIter), .threshold = (stop), \
+     .epsTol = (eps)}
+/*! @brief Step performing Gauss-Jordan elimination on A of size MxN in place */
+#define APULPF3_SEQ_GAUSS_JORDAN(A, M, N, zero)                                                                \
+    {.op = APULPF3_SequenceOp_gaussJordanElim, .argA = (A), .result = (A), .rows = (M), .cols = (N), \
+     .threshold = (zero)}
+/*! @brief Step generating N unit circle points */
+#define APULPF3_SEQ_UNIT_CIRCLE(N, constant, ph, conj, R)                                                      \
+    {.op = APULPF3_SequenceOp_unitCircle, .result = (R), .rows = (N), .param = (constant), .phase = (ph), \
+     .flag = (conj)}
+
 /** @addtogroup APULPF3_STATUS
  *  @{
  */
@@ -302,10 +512,22 @@ typedef struct
  */
 #define APULPF3_RESULT_INPLACE 0
 
+#if defined(APULPF3_EMULATION)
+/*!
+ * @brief Emulated APU RAM, see @ref ti_drivers_APU_Emulation.
+ */
+extern float complex APULPF3Emu_mem[APURAM_DATA0_SIZE / sizeof(float complex)];
+
 /*!
  * @brief Start of APU RAM.
  */
-#define APULPF3_MEM_BASE APURAM_DATA0_BASE
+    #define APULPF3_MEM_BASE ((uintptr_t)APULPF3Emu_mem)
+#else
+/*!
+ * @brief Start of APU RAM.
+ */
+    #define APULPF3_MEM_BASE APURAM_DATA0_BASE
+#endif
 
 /*!
  * @brief Size of APU RAM in mirrored mode.
@@ -1059,6 +1281,59 @@ void *APULPF3_loadTriangular(APULPF3_ComplexMatrix *mat, uint16_t offset);
  */
 void *APULPF3_loadArgMirrored(uint16_t argSize, uint16_t offset, float complex *src);
 
+/*!
+ * @brief Read a result from APU memory, assuming the APU is in mirrored mode.
+ *
+ * @param[in] argSize how many complex numbers to read
+ *
+ * @param[in] offset offset into APU memory to read from
+ *
+ * @param[out] dst destination pointer, outside APU memory
+ */
+void APULPF3_readArgMirrored(uint16_t argSize, uint16_t offset, float complex *dst);
+
+/*!
+ * @brief Validate an operation sequence.
+ *
+ * Checks that every step is a known operation with valid dimensions, that
+ * all operands and results lie in the first #APULPF3_SEQUENCE_MEM_SIZE
+ * elements of APU memory, that results do not overlap the operands of their
+ * step (apart from in-place operations), and that every operand is either
+ * the input, a scalar of the step, or the result of an earlier step. On
+ * success the sequence is marked valid and can be run any number of times.
+ *
+ * @param[in,out] seq sequence to validate
+ *
+ * @return A status code indicating whether the sequence is valid.
+ *
+ *  @retval #APULPF3_STATUS_SUCCESS The sequence is valid.
+ *  @retval #APULPF3_STATUS_ERROR   The sequence is invalid.
+ */
+int_fast16_t APULPF3_validateSequence(APULPF3_Sequence *seq);
+
+/*!
+ * @brief Run a validated operation sequence.
+ *
+ * Loads the input into APU memory, runs all steps in scratchpad mode and
+ * copies only the final result out.
+ *
+ * @pre Must be called between APULPF3_startOperationSequence() and
+ *      APULPF3_stopOperationSequence(). A sequence can be run repeatedly
+ *      within one such pair.
+ *
+ * @param[in] seq sequence validated with #APULPF3_validateSequence()
+ *
+ * @param[in] input @c seq->inputSize complex numbers, or NULL if there is no input
+ *
+ * @param[out] output buffer for @c seq->outputSize complex numbers
+ *
+ * @return A status code indicating whether the sequence was run.
+ *
+ *  @retval #APULPF3_STATUS_SUCCESS The call was successful.
+ *  @retval #APULPF3_STATUS_ERROR   The sequence has not been validated.
+ */
+int_fast16_t APULPF3_runSequence(const APULPF3_Sequence *seq, float complex *input, float complex *output);
+
 #ifdef __cplusplus
 }
 #endif
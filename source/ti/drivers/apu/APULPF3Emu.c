@@ -0,0 +1,1292 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== APULPF3Emu.c ========
+ *
+ *  Host implementation of the APULPF3 driver API, for running and
+ *  benchmarking APU algorithms off-target. Build it instead of APULPF3.c,
+ *  together with APULPF3EmuKernels.c, with APULPF3_EMULATION and the
+ *  DeviceFamily defined, for example:
+ *
+ *      cc -O2 -march=native -DAPULPF3_EMULATION -DDeviceFamily_CC27XX
+ *         -I<sdk>/source APULPF3Emu.c APULPF3EmuKernels.c app.c -lm
+ *
+ *  APU RAM is emulated by APULPF3Emu_mem, which APULPF3_MEM_BASE points to.
+ *  Operations place arguments and results in it exactly like the driver
+ *  does, so scratchpad mode and APULPF3_loadArgMirrored()/
+ *  APULPF3_loadTriangular() behave the same as on target, including which
+ *  parts of APU memory an operation overwrites.
+ *
+ *  Results are computed in single precision. They are deterministic and
+ *  identical for all kernel variants (see APULPF3EmuKernels.h), but the APU
+ *  firmware may round differently, so compare against target results with a
+ *  tolerance.
+ */
+
+#if defined(__clang__)
+    #pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+    #pragma GCC optimize("fp-contract=off")
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <complex.h>
+#include <math.h>
+
+#include <ti/drivers/apu/APULPF3.h>
+#include <ti/drivers/apu/APULPF3EmuKernels.h>
+
+#if !defined(APULPF3_EMULATION)
+    #error "APULPF3Emu.c is a host backend; build it with APULPF3_EMULATION defined"
+#endif
+
+/* Number of complex numbers in APU memory */
+#define APULPF3EMU_MEM_ELEMENTS (APURAM_DATA0_SIZE / sizeof(float complex))
+
+/* Heap location the firmware uses for scalar operands, see driverlib apu.c */
+#define APULPF3EMU_HEAP_ADDR (APULPF3EMU_MEM_ELEMENTS - APULPF3_FW_HEAP_SIZE)
+
+#define APULPF3EMU_PI 3.14159265358979323846
+
+/* Forward declarations */
+static bool APULPF3_inAPU(void *ptr);
+static void APULPF3_copyBack(void);
+static void APULPF3Emu_vectorSort(uint16_t N, float complex *pInput);
+static void APULPF3Emu_spSmoothCovMatrix(uint16_t N, float complex *pInput, uint16_t L, float complex *pResult, bool fb);
+static void APULPF3Emu_computeFft(uint16_t N, float complex *pX, bool inverse);
+static void APULPF3Emu_jacobiEVD(uint16_t N,
+                                 float complex *pInput,
+                                 float complex *pResultV,
+                                 uint16_t maxIter,
+                                 float minSum,
+                                 float epsTol);
+static void APULPF3Emu_gaussJordanElim(uint16_t M, uint16_t N, float complex *pInput, float epsTol);
+static void APULPF3Emu_hermLo(uint16_t N, float complex *pInput, float complex *pResult);
+
+/*
+ *  APU object structure, as in APULPF3.c
+ */
+typedef struct
+{
+    float complex *result; /* Temporary result pointer, in APU memory */
+
+    float complex *argA; /* Argument pointer, in APU memory */
+
+    float complex *argB; /* Argument pointer, in APU memory */
+
+    float complex *resultBuffer; /* Final result pointer, may be in APU memory*/
+
+    bool scratchpad; /* Whether or not to copy to/from APU memory */
+
+    uint16_t resultSize; /* APU result size */
+
+    bool isInitialized; /* Has open() been called */
+
+} APULPF3_Object;
+
+static APULPF3_Object object = {0};
+
+/* Emulated APU RAM */
+float complex APULPF3Emu_mem[APULPF3EMU_MEM_ELEMENTS] __attribute__((aligned(32)));
+
+/* exp(-j*2*pi*k/1024), used for FFT twiddles and unit circle generation */
+static float complex unitCircle[1024];
+
+/* Scratch for operations that need more than their output in the firmware */
+static float complex work[APULPF3EMU_MEM_ELEMENTS];
+static float complex workV[APULPF3EMU_MEM_ELEMENTS];
+
+/*
+ *  ======== APULPF3_inAPU ========
+ * Checks if an address is in APU memory.
+ */
+static bool APULPF3_inAPU(void *ptr)
+{
+    uintptr_t addr = (uintptr_t)ptr;
+    return (uintptr_t)APULPF3Emu_mem <= addr && addr < (uintptr_t)&APULPF3Emu_mem[APULPF3EMU_MEM_ELEMENTS];
+}
+
+/*
+ *  ======== APULPF3_copyBack ========
+ * If not in scratchpad mode, copy data back from APU memory to a result buffer.
+ */
+static void APULPF3_copyBack(void)
+{
+    if (!object.scratchpad)
+    {
+        memmove(object.resultBuffer, object.result, object.resultSize * sizeof(float complex));
+    }
+}
+
+/*
+ *  ======== APULPF3_init ========
+ */
+void APULPF3_init(void)
+{
+    if (!object.isInitialized)
+    {
+        /* Build the table from the first octant so that it is exactly symmetric */
+        for (uint16_t k = 0; k <= 128; k++)
+        {
+            float c = (float)cos(2.0 * APULPF3EMU_PI * k / 1024.0);
+            float s = (float)sin(2.0 * APULPF3EMU_PI * k / 1024.0);
+
+            unitCircle[k]                 = CMPLXF(c, -s);
+            unitCircle[(256 - k) & 1023U] = CMPLXF(s, -c);
+        }
+        for (uint16_t k = 0; k < 256; k++)
+        {
+            float complex w = unitCircle[k];
+
+            unitCircle[k + 256] = CMPLXF(cimagf(w), -crealf(w));
+            unitCircle[k + 512] = CMPLXF(-crealf(w), -cimagf(w));
+            unitCircle[k + 768] = CMPLXF(-cimagf(w), crealf(w));
+        }
+
+        object.isInitialized = true;
+    }
+}
+
+/*
+ *  ======== APULPF3_startOperationSequence ========
+ */
+void APULPF3_startOperationSequence()
+{
+    /* Nothing to arbitrate on the host */
+}
+
+/*
+ *  ======== APULPF3_stopOperationSequence ========
+ */
+void APULPF3_stopOperationSequence()
+{
+}
+
+/* Vector-vector functions */
+
+/*
+ *  ======== APULPF3_dotProduct ========
+ */
+int_fast16_t APULPF3_dotProduct(APULPF3_ComplexVector *vecA,
+                                APULPF3_ComplexVector *vecB,
+                                bool conjugate,
+                                float complex *result)
+{
+    uint16_t inputSize;
+    int_fast16_t returnVal = APULPF3_STATUS_ERROR;
+
+    if (vecA->size == vecB->size)
+    {
+        object.scratchpad = APULPF3_inAPU(vecA->data) && APULPF3_inAPU(vecB->data) && APULPF3_inAPU(result);
+
+        inputSize = APULPF3_prepareVectors(vecA, vecB);
+        APULPF3_prepareResult(1, inputSize, result);
+
+        APULPF3EmuKernels_dot((float *)object.result,
+                              (const float *)object.argA,
+                              (const float *)object.argB,
+                              vecA->size,
+                              conjugate);
+
+        APULPF3_copyBack();
+        returnVal = APULPF3_STATUS_SUCCESS;
+    }
+
+    return returnVal;
+}
+
+/*
+ *  ======== APULPF3_vectorMult ========
+ */
+int_fast16_t APULPF3_vectorMult(APULPF3_ComplexVector *vecA,
+                                APULPF3_ComplexVector *vecB,
+                                bool conjugate,
+                                APULPF3_ComplexVector *result)
+{
+    uint16_t inputSize;
+    int_fast16_t returnVal = APULPF3_STATUS_ERROR;
+
+    if (vecA->size == vecB->size)
+    {
+        object.scratchpad = APULPF3_inAPU(vecA->data) && APULPF3_inAPU(vecB->data) && APULPF3_inAPU(result->data);
+
+        inputSize = APULPF3_prepareVectors(vecA, vecB);
+        APULPF3_prepareResult(vecA->size, inputSize, result->data);
+
+        APULPF3EmuKernels_mult((float *)object.result,
+                               (const float *)object.argA,
+                               (const float *)object.argB,
+                               vecA->size,
+                               conjugate);
+
+        APULPF3_copyBack();
+        returnVal = APULPF3_STATUS_SUCCESS;
+    }
+
+    return returnVal;
+}
+
+/*
+ *  ======== APULPF3_vectorSum ========
+ */
+int_fast16_t APULPF3_vectorSum(APULPF3_ComplexVector *vecA,
+                               APULPF3_ComplexVector *vecB,
+                               bool subtraction,
+                               APULPF3_ComplexVector *result)
+{
+    uint16_t inputSize;
+    int_fast16_t returnVal = APULPF3_STATUS_ERROR;
+
+    if (vecA->size == vecB->size)
+    {
+        object.scratchpad = APULPF3_inAPU(vecA->data) && APULPF3_inAPU(vecB->data) && APULPF3_inAPU(result->data);
+
+        inputSize = APULPF3_prepareVectors(vecA, vecB);
+        APULPF3_prepareResult(vecA->size, inputSize, result->data);
+
+        APULPF3EmuKernels_sum((float *)object.result,
+                              (const float *)object.argA,
+                              (const float *)object.argB,
+                              vecA->size,
+                              subtraction);
+
+        APULPF3_copyBack();
+        returnVal = APULPF3_STATUS_SUCCESS;
+    }
+
+    return returnVal;
+}
+
+/*
+ *  ======== APULPF3_vectorScalarSum ========
+ */
+int_fast16_t APULPF3_vectorScalarSum(APULPF3_ComplexVector *vecA,
+                                     float complex *scalar,
+                                     bool subtraction,
+                                     APULPF3_ComplexVector *result)
+{
+    APULPF3_ComplexVector vecB;
+    uint16_t inputSize;
+
+    object.scratchpad = APULPF3_inAPU(vecA->data) && APULPF3_inAPU(scalar) && APULPF3_inAPU(result->data);
+
+    vecB.data = scalar;
+    vecB.size = 1;
+    inputSize = APULPF3_prepareVectors(vecA, &vecB);
+    APULPF3_prepareResult(vecA->size, inputSize, result->data);
+
+    APULPF3EmuKernels_scalarSum((float *)object.result,
+                                (const float *)object.argA,
+                                (const float *)object.argB,
+                                vecA->size,
+                                subtraction);
+
+    APULPF3_copyBack();
+    return APULPF3_STATUS_SUCCESS;
+}
+
+/*
+ *  ======== APULPF3_vectorScalarMult ========
+ */
+int_fast16_t APULPF3_vectorScalarMult(APULPF3_ComplexVector *vecA, float complex *scalar, APULPF3_ComplexVector *result)
+{
+    APULPF3_ComplexVector vecB;
+    uint16_t inputSize;
+
+    object.scratchpad = APULPF3_inAPU(vecA->data) && APULPF3_inAPU(scalar) && APULPF3_inAPU(result->data);
+
+    vecB.data = scalar;
+    vecB.size = 1;
+    inputSize = APULPF3_prepareVectors(vecA, &vecB);
+    APULPF3_prepareResult(vecA->size, inputSize, result->data);
+
+    APULPF3EmuKernels_scalarMult((float *)object.result,
+                                 (const float *)object.argA,
+                                 (const float *)object.argB,
+                                 vecA->size);
+
+    APULPF3_copyBack();
+    return APULPF3_STATUS_SUCCESS;
+}
+
+/*
+ *  ======== APULPF3_vectorR2C ========
+ */
+int_fast16_t APULPF3_vectorR2C(APULPF3_ComplexVector *vecA,
+                               APULPF3_ComplexVector *vecB,
+                               APULPF3_R2COp
+                               operator,
+                               APULPF3_ComplexVector * result)
+{
+    uint16_t inputSize;
+
+    /* Operators that only use vecA accept NULL for vecB */
+    if (vecB == NULL)
+    {
+        vecB = vecA;
+    }
+
+    object.scratchpad = APULPF3_inAPU(vecA->data) && APULPF3_inAPU(vecB->data) && APULPF3_inAPU(result->data);
+
+    inputSize = APULPF3_prepareVectors(vecA, vecB);
+    APULPF3_prepareResult(vecA->size, inputSize, result->data);
+
+    for (uint16_t i = 0; i < vecA->size; i++)
+    {
+        float re = crealf(object.argA[i]);
+        float im = cimagf(object.argA[i]);
+
+        switch (operator)
+        {
+            case APULPF3_R2COp_R2C:
+                object.result[i] = CMPLXF(re, crealf(object.argB[i]));
+                break;
+            case APULPF3_R2COp_R2CC:
+                object.result[i] = CMPLXF(re, -crealf(object.argB[i]));
+                break;
+            case APULPF3_R2COp_R2CA:
+                object.result[i] = CMPLXF(im, re);
+                break;
+            case APULPF3_R2COp_R2CAA:
+                object.result[i] = CMPLXF(im, -re);
+                break;
+            case APULPF3_R2COp_RA:
+                object.result[i] = CMPLXF(re, 0.0f);
+                break;
+            case APULPF3_R2COp_IMA:
+                object.result[i] = CMPLXF(im, 0.0f);
+                break;
+            case APULPF3_R2COp_ABS:
+            default:
+                object.result[i] = CMPLXF(fabsf(re), fabsf(im));
+                break;
+        }
+    }
+
+    APULPF3_copyBack();
+    return APULPF3_STATUS_SUCCESS;
+}
+
+/*
+ *  ======== APULPF3_vectorMaxMin ========
+ */
+int_fast16_t APULPF3_vectorMaxMin(APULPF3_ComplexVector *vec,
+                                  float scalarThreshold,
+                                  bool min,
+                                  APULPF3_ComplexVector *result)
+{
+    uint16_t inputSize;
+
+    object.scratchpad = APULPF3_inAPU(vec->data) && APULPF3_inAPU(result->data);
+
+    inputSize = APULPF3_prepareVectors(vec, vec);
+    APULPF3_prepareResult(vec->size, inputSize, result->data);
+
+    /* The threshold is passed through the firmware heap */
+    APULPF3Emu_mem[APULPF3EMU_HEAP_ADDR + 1] = CMPLXF(scalarThreshold, 0.0f);
+
+    APULPF3EmuKernels_maxMin((float *)object.result, (const float *)object.argA, scalarThreshold, vec->size, min);
+
+    APULPF3_copyBack();
+    return APULPF3_STATUS_SUCCESS;
+}
+
+/*
+ *  ======== APULPF3_cartesianToPolarVector ========
+ */
+int_fast16_t APULPF3_cartesianToPolarVector(APULPF3_ComplexVector *vec, APULPF3_ComplexVector *result)
+{
+    uint16_t inputSize;
+
+    object.scratchpad = APULPF3_inAPU(vec->data) && APULPF3_inAPU(result->data);
+
+    inputSize = APULPF3_prepareVectors(vec, vec);
+    APULPF3_prepareResult(vec->size, inputSize, result->data);
+
+    for (uint16_t i = 0; i < vec->size; i++)
+    {
+        float re = crealf(object.argA[i]);
+        float im = cimagf(object.argA[i]);
+
+        /* Angle in units of pi radians */
+        object.result[i] = CMPLXF(sqrtf(re * re + im * im), atan2f(im, re) / (float)APULPF3EMU_PI);
+    }
+
+    APULPF3_copyBack();
+    return APULPF3_STATUS_SUCCESS;
+}
+
+/*
+ *  ======== APULPF3_polarToCartesianVector ========
+ */
+int_fast16_t APULPF3_polarToCartesianVector(APULPF3_ComplexVector *vec,
+                                            float complex *temp,
+                                            APULPF3_ComplexVector *result)
+{
+    uint16_t inputSize;
+
+    object.scratchpad = APULPF3_inAPU(vec->data) && APULPF3_inAPU(result->data) && APULPF3_inAPU(temp);
+
+    inputSize = APULPF3_prepareVectors(vec, vec);
+    APULPF3_prepareResult(vec->size, inputSize, result->data);
+    if (!object.scratchpad)
+    {
+        /* Assign temp vector after input and result */
+        temp = object.result + 2 * vec->size;
+    }
+
+    /* The firmware stores exp(j*angle) in the temporary vector */
+    for (uint16_t i = 0; i < vec->size; i++)
+    {
+        float angle = cimagf(object.argA[i]) * (float)APULPF3EMU_PI;
+        temp[i]     = CMPLXF(cosf(angle), sinf(angle));
+    }
+    for (uint16_t i = 0; i < vec->size; i++)
+    {
+        float magnitude  = crealf(object.argA[i]);
+        object.result[i] = CMPLXF(magnitude * crealf(temp[i]), magnitude * cimagf(temp[i]));
+    }
+
+    APULPF3_copyBack();
+    return APULPF3_STATUS_SUCCESS;
+}
+
+/* Vector algorithms */
+
+/*
+ *  ======== APULPF3_sortVector ========
+ */
+int_fast16_t APULPF3_sortVector(APULPF3_ComplexVector *vec, APULPF3_ComplexVector *result)
+{
+    object.scratchpad = APULPF3_inAPU(vec->data) && APULPF3_inAPU(result->data);
+
+    APULPF3_prepareVectors(vec, vec);
+    APULPF3_prepareResult(vec->size, APULPF3_RESULT_INPLACE, result->data);
+
+    APULPF3Emu_vectorSort(vec->size, object.argA);
+
+    APULPF3_copyBack();
+    return APULPF3_STATUS_SUCCESS;
+}
+
+/*
+ *  ======== APULPF3_covMatrixSpatialSmoothing ========
+ */
+int_fast16_t APULPF3_covMatrixSpatialSmoothing(APULPF3_ComplexVector *vec,
+                                               uint16_t covMatrixSize,
+                                               bool fbAveraging,
+                                               APULPF3_ComplexTriangleMatrix *result)
+{
+    uint16_t inputSize;
+
+    object.scratchpad = APULPF3_inAPU(vec->data) && APULPF3_inAPU(result->data);
+
+    inputSize = APULPF3_prepareVectors(vec, vec);
+    APULPF3_prepareResult((covMatrixSize * (covMatrixSize + 1)) / 2, inputSize, result->data);
+
+    APULPF3Emu_spSmoothCovMatrix(vec->size, object.argA, covMatrixSize, object.result, fbAveraging);
+
+    APULPF3_copyBack();
+    return APULPF3_STATUS_SUCCESS;
+}
+
+/*
+ *  ======== APULPF3_computeFFT ========
+ */
+int_fast16_t APULPF3_computeFFT(APULPF3_ComplexVector *vec, bool inverse, APULPF3_ComplexVector *result)
+{
+    int_fast16_t returnVal = APULPF3_STATUS_ERROR;
+
+    /* Check if size is a power of 2 that fits in APU memory. */
+    if ((vec->size & (vec->size - 1)) == 0 && vec->size <= APULPF3EMU_MEM_ELEMENTS)
+    {
+        /* Configuring the FFT produces no result on the host */
+        object.scratchpad = APULPF3_inAPU(vec->data) && APULPF3_inAPU(result->data);
+
+        APULPF3_prepareVectors(vec, vec);
+        APULPF3_prepareResult(vec->size, APULPF3_RESULT_INPLACE, result->data);
+
+        APULPF3Emu_computeFft(vec->size, object.argA, inverse);
+
+        APULPF3_copyBack();
+        returnVal = APULPF3_STATUS_SUCCESS;
+    }
+
+    return returnVal;
+}
+
+/* Matrix functions */
+
+/*
+ *  ======== APULPF3_matrixMult ========
+ */
+int_fast16_t APULPF3_matrixMult(APULPF3_ComplexMatrix *matA, APULPF3_ComplexMatrix *matB, APULPF3_ComplexMatrix *result)
+{
+    uint16_t inputSize;
+    int_fast16_t returnVal = APULPF3_STATUS_ERROR;
+
+    if (matA->cols == matB->rows)
+    {
+        object.scratchpad = APULPF3_inAPU(matA->data) && APULPF3_inAPU(matB->data) && APULPF3_inAPU(result->data);
+
+        inputSize = APULPF3_prepareMatrices(matA, matB);
+        APULPF3_prepareResult(matA->rows * matB->cols, inputSize, result->data);
+
+        /* Column j of the result accumulates A(:, k) * B(k, j) for k in order */
+        for (uint16_t j = 0; j < matB->cols; j++)
+        {
+            float complex *col = &object.result[j * matA->rows];
+
+            memset(col, 0, matA->rows * sizeof(float complex));
+            for (uint16_t k = 0; k < matA->cols; k++)
+            {
+                APULPF3EmuKernels_scalarMac((float *)col,
+                                            (const float *)&object.argA[k * matA->rows],
+                                            (const float *)&object.argB[j * matB->rows + k],
+                                            matA->rows);
+            }
+        }
+
+        APULPF3_copyBack();
+        returnVal = APULPF3_STATUS_SUCCESS;
+    }
+
+    return returnVal;
+}
+
+/*
+ *  ======== APULPF3_matrixSum ========
+ */
+int_fast16_t APULPF3_matrixSum(APULPF3_ComplexMatrix *matA, APULPF3_ComplexMatrix *matB, APULPF3_ComplexMatrix *result)
+{
+    uint16_t inputSize;
+    int_fast16_t returnVal = APULPF3_STATUS_ERROR;
+
+    if (matA->rows == matB->rows && matA->cols == matB->cols)
+    {
+        object.scratchpad = APULPF3_inAPU(matA->data) && APULPF3_inAPU(matB->data) && APULPF3_inAPU(result->data);
+
+        inputSize = APULPF3_prepareMatrices(matA, matB);
+        APULPF3_prepareResult(matA->rows * matA->cols, inputSize, result->data);
+
+        APULPF3EmuKernels_sum((float *)object.result,
+                              (const float *)object.argA,
+                              (const float *)object.argB,
+                              matA->rows * matA->cols,
+                              false);
+
+        APULPF3_copyBack();
+        returnVal = APULPF3_STATUS_SUCCESS;
+    }
+
+    return returnVal;
+}
+
+/*
+ *  ======== APULPF3_HermLo ========
+ */
+int_fast16_t APULPF3_HermLo(APULPF3_ComplexTriangleMatrix *mat, APULPF3_ComplexTriangleMatrix *result)
+{
+    uint16_t inputSize;
+    uint16_t length;
+    int_fast16_t returnVal = APULPF3_STATUS_ERROR;
+
+    if (mat->size == result->size)
+    {
+        object.scratchpad = APULPF3_inAPU(mat->data) && APULPF3_inAPU(result->data);
+
+        length                       = (mat->size * (mat->size + 1)) >> 1;
+        APULPF3_ComplexVector vecIn  = {.data = mat->data, .size = length};
+        APULPF3_ComplexVector vecOut = {.data = result->data, .size = length};
+
+        inputSize = APULPF3_prepareVectors(&vecIn, &vecIn);
+        APULPF3_prepareResult(vecOut.size, inputSize, vecOut.data);
+
+        APULPF3Emu_hermLo(mat->size, object.argA, object.result);
+
+        APULPF3_copyBack();
+        returnVal = APULPF3_STATUS_SUCCESS;
+    }
+
+    return returnVal;
+}
+
+/*
+ *  ======== APULPF3_matrixScalarSum ========
+ */
+int_fast16_t APULPF3_matrixScalarSum(APULPF3_ComplexMatrix *mat, float complex *scalar, APULPF3_ComplexMatrix *result)
+{
+    float complex *tempArgB;
+    uint16_t inputSize;
+
+    object.scratchpad = APULPF3_inAPU(mat->data) && APULPF3_inAPU(scalar) && APULPF3_inAPU(result->data);
+    if (object.scratchpad)
+    {
+        tempArgB = scalar;
+    }
+    else
+    {
+        tempArgB = APULPF3_loadArgMirrored(1, mat->rows * mat->cols, scalar);
+    }
+
+    /* This function overwrites argB so we have saved it somewhere else. */
+    inputSize   = APULPF3_prepareMatrices(mat, mat);
+    object.argB = tempArgB;
+    APULPF3_prepareResult(mat->rows * mat->cols, 1 + inputSize, result->data);
+
+    APULPF3EmuKernels_scalarSum((float *)object.result,
+                                (const float *)object.argA,
+                                (const float *)object.argB,
+                                mat->rows * mat->cols,
+                                false);
+
+    APULPF3_copyBack();
+    return APULPF3_STATUS_SUCCESS;
+}
+
+/*
+ *  ======== APULPF3_matrixScalarMult ========
+ */
+int_fast16_t APULPF3_matrixScalarMult(APULPF3_ComplexMatrix *mat, float complex *scalar, APULPF3_ComplexMatrix *result)
+{
+    float complex *tempArgB;
+    uint16_t inputSize;
+
+    object.scratchpad = APULPF3_inAPU(mat->data) && APULPF3_inAPU(scalar) && APULPF3_inAPU(result->data);
+    if (object.scratchpad)
+    {
+        tempArgB = scalar;
+    }
+    else
+    {
+        tempArgB = APULPF3_loadArgMirrored(1, mat->rows * mat->cols, scalar);
+    }
+
+    inputSize   = APULPF3_prepareMatrices(mat, mat);
+    object.argB = tempArgB;
+    APULPF3_prepareResult(mat->rows * mat->cols, 1 + inputSize, result->data);
+
+    APULPF3EmuKernels_scalarMult((float *)object.result,
+                                 (const float *)object.argA,
+                                 (const float *)object.argB,
+                                 mat->rows * mat->cols);
+
+    APULPF3_copyBack();
+    return APULPF3_STATUS_SUCCESS;
+}
+
+/*
+ *  ======== APULPF3_matrixNorm ========
+ */
+int_fast16_t APULPF3_matrixNorm(APULPF3_ComplexMatrix *mat, float complex *result)
+{
+    uint16_t inputSize;
+
+    object.scratchpad = APULPF3_inAPU(mat->data) && APULPF3_inAPU(result);
+
+    inputSize = APULPF3_prepareMatrices(mat, mat);
+    APULPF3_prepareResult(1, inputSize, result);
+
+    /* Like the APU, produce the square of the norm */
+    object.result[0] = CMPLXF(APULPF3EmuKernels_sumSquares((const float *)object.argA, mat->rows * mat->cols), 0.0f);
+
+    APULPF3_copyBack();
+    *result = sqrtf(crealf(*result));
+    return APULPF3_STATUS_SUCCESS;
+}
+
+/* Matrix algorithms */
+
+/*
+ *  ======== APULPF3_jacobiEVD ========
+ */
+int_fast16_t APULPF3_jacobiEVD(APULPF3_ComplexTriangleMatrix *mat,
+                               uint16_t maxIter,
+                               float stopThreshold,
+                               float epsTol,
+                               APULPF3_ComplexVector *result)
+{
+    APULPF3_ComplexVector EVDvec;
+    uint16_t resultSize;
+    float complex *eigVecs;
+
+    object.scratchpad = APULPF3_inAPU(mat->data) && APULPF3_inAPU(result->data);
+
+    /* Only load the upper triangle, which is all the input buffer holds. */
+    EVDvec.data = mat->data;
+    EVDvec.size = (mat->size * mat->size + mat->size) / 2;
+    APULPF3_prepareVectors(&EVDvec, &EVDvec);
+
+    /* Produces both the upper triangular part of a NxN in-place matrix and an NxN matrix. */
+    resultSize = (mat->size * mat->size) + ((mat->size * mat->size + mat->size) / 2);
+    APULPF3_prepareResult(resultSize, APULPF3_RESULT_INPLACE, result->data);
+    if (!object.scratchpad)
+    {
+        /* object.result will point to eigenvalues, which is followed by the eigenvectors. */
+        eigVecs      = object.result + ((mat->size * mat->size + mat->size) / 2);
+        result->size = resultSize;
+        APULPF3Emu_jacobiEVD(mat->size, object.argA, eigVecs, maxIter, stopThreshold, epsTol);
+    }
+    else
+    {
+        /* object.result will point to just the eigenvectors. Eigenvalues have overwritten argA. */
+        APULPF3Emu_jacobiEVD(mat->size, object.argA, object.result, maxIter, stopThreshold, epsTol);
+        result->size = (mat->size * mat->size);
+    }
+
+    APULPF3_copyBack();
+    return APULPF3_STATUS_SUCCESS;
+}
+
+/*
+ *  ======== APULPF3_gaussJordanElim ========
+ */
+int_fast16_t APULPF3_gaussJordanElim(APULPF3_ComplexMatrix *mat, float zeroThreshold, APULPF3_ComplexMatrix *result)
+{
+    object.scratchpad = APULPF3_inAPU(mat->data) && APULPF3_inAPU(result->data);
+
+    APULPF3_prepareMatrices(mat, mat);
+    APULPF3_prepareResult(mat->cols * mat->rows, APULPF3_RESULT_INPLACE, result->data);
+
+    APULPF3Emu_gaussJordanElim(mat->rows, mat->cols, object.argA, zeroThreshold);
+
+    APULPF3_copyBack();
+    return APULPF3_STATUS_SUCCESS;
+}
+
+/*
+ *  ======== APULPF3_unitCircle ========
+ */
+int_fast16_t APULPF3_unitCircle(uint16_t numPoints,
+                                uint16_t constant,
+                                uint16_t phase,
+                                bool conjugate,
+                                APULPF3_ComplexVector *result)
+{
+    object.scratchpad = APULPF3_inAPU(result->data);
+
+    APULPF3_prepareResult(numPoints, APULPF3_RESULT_INPLACE, result->data);
+
+    for (uint32_t k = 0; k < numPoints; k++)
+    {
+        /* M and phase are 10-bit values, so the angle wraps at 1024 */
+        float complex w  = unitCircle[(k * (constant & 1023U) + (phase & 1023U)) & 1023U];
+        object.result[k] = conjugate ? conjf(w) : w;
+    }
+
+    APULPF3_copyBack();
+    return APULPF3_STATUS_SUCCESS;
+}
+
+/* Utility functions */
+
+/*
+ *  ======== APULPF3_prepareVectors ========
+ */
+uint16_t APULPF3_prepareVectors(APULPF3_ComplexVector *vecA, APULPF3_ComplexVector *vecB)
+{
+    complex float *argA = vecA->data;
+    complex float *argB = vecB->data;
+    uint16_t inputSize  = 0;
+
+    if (!object.scratchpad)
+    {
+        argA = APULPF3_loadArgMirrored(vecA->size, 0, vecA->data);
+
+        /* Are the vectors the same? */
+        if ((vecA->data == vecB->data) && (vecA->size == vecB->size))
+        {
+            argB      = argA;
+            inputSize = vecA->size;
+        }
+        else
+        {
+            /* If they aren't the same put argB right after argA. */
+            argB      = APULPF3_loadArgMirrored(vecB->size, vecA->size, vecB->data);
+            inputSize = vecA->size + vecB->size;
+        }
+    }
+
+    object.argA = argA;
+    object.argB = argB;
+
+    return inputSize;
+}
+
+/*
+ *  ======== APULPF3_prepareMatrices ========
+ */
+uint16_t APULPF3_prepareMatrices(APULPF3_ComplexMatrix *matA, APULPF3_ComplexMatrix *matB)
+{
+    complex float *argA = matA->data;
+    complex float *argB = matB->data;
+    uint16_t inputSize  = 0;
+    uint16_t sizeA      = matA->cols * matA->rows;
+    uint16_t sizeB      = matB->cols * matB->rows;
+
+    if (!object.scratchpad)
+    {
+        argA = APULPF3_loadArgMirrored(sizeA, 0, matA->data);
+
+        /* Are the matrices the same? */
+        if ((matA->data == matB->data) && (matA->rows == matB->rows) && (matA->cols == matB->cols))
+        {
+            argB      = argA;
+            inputSize = sizeA;
+        }
+        else
+        {
+            /* If they aren't the same put argB right after argA. */
+            argB      = APULPF3_loadArgMirrored(sizeB, sizeA, matB->data);
+            inputSize = sizeA + sizeB;
+        }
+    }
+
+    object.argA = argA;
+    object.argB = argB;
+
+    return inputSize;
+}
+
+/*
+ *  ======== APULPF3_loadArgMirrored ========
+ */
+void *APULPF3_loadArgMirrored(uint16_t argSize, uint16_t offset, float complex *src)
+{
+    /* Sources may already be in APU memory and overlap the destination */
+    memmove(&APULPF3Emu_mem[offset], src, argSize * sizeof(float complex));
+
+    return &APULPF3Emu_mem[offset];
+}
+
+/*
+ *  ======== APULPF3_readArgMirrored ========
+ */
+void APULPF3_readArgMirrored(uint16_t argSize, uint16_t offset, float complex *dst)
+{
+    memmove(dst, &APULPF3Emu_mem[offset], argSize * sizeof(float complex));
+}
+
+/*
+ *  ======== APULPF3_loadTriangular ========
+ */
+void *APULPF3_loadTriangular(APULPF3_ComplexMatrix *mat, uint16_t offset)
+{
+    float complex *memPtr = &APULPF3Emu_mem[offset];
+    uint16_t elemCount    = 0;
+
+    for (uint32_t i = 0; i < mat->cols; i++)
+    {
+        for (uint32_t j = 0; j <= i; j++)
+        {
+            memPtr[elemCount++] = mat->data[i * mat->cols + j];
+        }
+    }
+
+    return memPtr;
+}
+
+/*
+ *  ======== APULPF3_prepareResult ========
+ */
+void APULPF3_prepareResult(uint16_t resultSize, uint16_t offset, complex float *resultBuffer)
+{
+    object.resultBuffer = resultBuffer;
+    object.resultSize   = resultSize;
+
+    if (!object.scratchpad)
+    {
+        /* If not in scratchpad mode, place at a known location in APU memory. */
+        object.result = &APULPF3Emu_mem[offset];
+    }
+    else
+    {
+        /* Otherwise result goes where the user has placed it in APU memory. */
+        object.result = resultBuffer;
+    }
+}
+
+/* Emulated firmware operations */
+
+/*
+ *  ======== APULPF3Emu_vectorSort ========
+ *  Stable merge sort on the real parts, in descending order.
+ */
+static void APULPF3Emu_vectorSort(uint16_t N, float complex *pInput)
+{
+    float complex *src = pInput;
+    float complex *dst = work;
+
+    for (uint32_t width = 1; width < N; width *= 2)
+    {
+        for (uint32_t lo = 0; lo < N; lo += 2 * width)
+        {
+            uint32_t mid = (lo + width < N) ? lo + width : N;
+            uint32_t hi  = (lo + 2 * width < N) ? lo + 2 * width : N;
+            uint32_t i   = lo;
+            uint32_t j   = mid;
+
+            for (uint32_t k = lo; k < hi; k++)
+            {
+                /* Take from the right run only if strictly larger, to keep the order of equal keys */
+                if (i < mid && (j >= hi || !(crealf(src[j]) > crealf(src[i]))))
+                {
+                    dst[k] = src[i++];
+                }
+                else
+                {
+                    dst[k] = src[j++];
+                }
+            }
+        }
+        float complex *swap = src;
+        src                 = dst;
+        dst                 = swap;
+    }
+
+    if (src != pInput)
+    {
+        memcpy(pInput, src, N * sizeof(float complex));
+    }
+}
+
+/*
+ *  ======== APULPF3Emu_spSmoothCovMatrix ========
+ *  R(i, j) = sum(x[k + i] * conj(x[k + j])) / K, k = 0 to K - 1, K = N - L + 1.
+ *  With forward-backward averaging, Rfb = 1/2 (R + J * conj(R) * J).
+ */
+static void APULPF3Emu_spSmoothCovMatrix(uint16_t N, float complex *pInput, uint16_t L, float complex *pResult, bool fb)
+{
+    uint16_t K = N - L + 1;
+    float scale = 1.0f / (float)K;
+
+    /* Full upper triangle in work, indexed like the result */
+    for (uint16_t j = 0; j < L; j++)
+    {
+        for (uint16_t i = 0; i <= j; i++)
+        {
+            float complex r;
+            APULPF3EmuKernels_dot((float *)&r, (const float *)&pInput[i], (const float *)&pInput[j], K, true);
+            work[(j * (j + 1)) / 2 + i] = CMPLXF(crealf(r) * scale, cimagf(r) * scale);
+        }
+    }
+
+    for (uint16_t j = 0; j < L; j++)
+    {
+        for (uint16_t i = 0; i <= j; i++)
+        {
+            float complex r = work[(j * (j + 1)) / 2 + i];
+            if (fb)
+            {
+                /* conj(R(L-1-i, L-1-j)) is the upper element R(L-1-j, L-1-i) */
+                uint16_t row   = L - 1 - j;
+                uint16_t col   = L - 1 - i;
+                float complex m = work[(col * (col + 1)) / 2 + row];
+                r               = CMPLXF(0.5f * (crealf(r) + crealf(m)), 0.5f * (cimagf(r) + cimagf(m)));
+            }
+            pResult[(j * (j + 1)) / 2 + i] = r;
+        }
+    }
+}
+
+/*
+ *  ======== APULPF3Emu_computeFft ========
+ *  In-place radix-2 decimation in time. The inverse is scaled by 1/N.
+ */
+static void APULPF3Emu_computeFft(uint16_t N, float complex *pX, bool inverse)
+{
+    /* Bit reversal permutation */
+    for (uint32_t i = 1, j = 0; i < N; i++)
+    {
+        uint32_t bit = N >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j)
+        {
+            float complex t = pX[i];
+            pX[i]           = pX[j];
+            pX[j]           = t;
+        }
+    }
+
+    for (uint32_t len = 2; len <= N; len *= 2)
+    {
+        uint32_t half   = len / 2;
+        uint32_t stride = 1024U / len;
+
+        for (uint32_t k = 0; k < half; k++)
+        {
+            work[k] = inverse ? conjf(unitCircle[k * stride]) : unitCircle[k * stride];
+        }
+        for (uint32_t start = 0; start < N; start += len)
+        {
+            APULPF3EmuKernels_butterfly((float *)&pX[start], (float *)&pX[start + half], (const float *)work, half);
+        }
+    }
+
+    if (inverse)
+    {
+        float complex scale = CMPLXF(1.0f / (float)N, 0.0f);
+        APULPF3EmuKernels_scalarMult((float *)pX, (const float *)pX, (const float *)&scale, N);
+    }
+}
+
+/*
+ *  ======== APULPF3Emu_jacobiEVD ========
+ *  Cyclic Jacobi on the full Hermitian matrix. Each rotation J = D * P first
+ *  turns a(p, q) real with a phase on column q, then zeroes it with a real
+ *  Givens rotation; A = J' * A * J and V = V * J.
+ */
+static void APULPF3Emu_jacobiEVD(uint16_t N,
+                                 float complex *pInput,
+                                 float complex *pResultV,
+                                 uint16_t maxIter,
+                                 float minSum,
+                                 float epsTol)
+{
+    float complex *A = work;  /* A(i, j) at A[j * N + i] */
+    float complex *V = workV; /* Written to pResultV when done */
+
+    for (uint16_t j = 0; j < N; j++)
+    {
+        for (uint16_t i = 0; i <= j; i++)
+        {
+            float complex a = pInput[(j * (j + 1)) / 2 + i];
+            A[j * N + i]    = a;
+            A[i * N + j]    = conjf(a);
+        }
+        A[j * N + j] = CMPLXF(crealf(A[j * N + j]), 0.0f);
+    }
+    for (uint32_t i = 0; i < (uint32_t)N * N; i++)
+    {
+        V[i] = 0.0f;
+    }
+    for (uint16_t i = 0; i < N; i++)
+    {
+        V[i * N + i] = 1.0f;
+    }
+
+    for (uint16_t iter = 0; iter < maxIter; iter++)
+    {
+        float offSum = 0.0f;
+        for (uint16_t q = 1; q < N; q++)
+        {
+            for (uint16_t p = 0; p < q; p++)
+            {
+                offSum += cabsf(A[q * N + p]);
+            }
+        }
+        if (offSum < minSum)
+        {
+            break;
+        }
+
+        for (uint16_t q = 1; q < N; q++)
+        {
+            for (uint16_t p = 0; p < q; p++)
+            {
+                float complex apq = A[q * N + p];
+                float r           = cabsf(apq);
+                if (r <= epsTol)
+                {
+                    continue;
+                }
+                float complex phase = CMPLXF(crealf(apq) / r, -cimagf(apq) / r); /* conj(apq) / |apq| */
+                float theta         = (crealf(A[q * N + q]) - crealf(A[p * N + p])) / (2.0f * r);
+                float t             = 1.0f / (fabsf(theta) + sqrtf(theta * theta + 1.0f));
+                if (theta < 0.0f)
+                {
+                    t = -t;
+                }
+                float c = 1.0f / sqrtf(t * t + 1.0f);
+                float s = t * c;
+
+                float complex jpp = c;
+                float complex jpq = s;
+                float complex jqp = -s * phase;
+                float complex jqq = c * phase;
+
+                /* A = A * J, V = V * J */
+                for (uint16_t k = 0; k < N; k++)
+                {
+                    float complex akp = A[p * N + k];
+                    float complex akq = A[q * N + k];
+                    A[p * N + k]      = akp * jpp + akq * jqp;
+                    A[q * N + k]      = akp * jpq + akq * jqq;
+
+                    float complex vkp = V[p * N + k];
+                    float complex vkq = V[q * N + k];
+                    V[p * N + k]      = vkp * jpp + vkq * jqp;
+                    V[q * N + k]      = vkp * jpq + vkq * jqq;
+                }
+                /* A = J' * A */
+                for (uint16_t k = 0; k < N; k++)
+                {
+                    float complex apk = A[k * N + p];
+                    float complex aqk = A[k * N + q];
+                    A[k * N + p]      = conjf(jpp) * apk + conjf(jqp) * aqk;
+                    A[k * N + q]      = conjf(jpq) * apk + conjf(jqq) * aqk;
+                }
+                A[q * N + p] = 0.0f;
+                A[p * N + q] = 0.0f;
+                A[p * N + p] = CMPLXF(crealf(A[p * N + p]), 0.0f);
+                A[q * N + q] = CMPLXF(crealf(A[q * N + q]), 0.0f);
+            }
+        }
+    }
+
+    /* Sort eigenvalues in descending order, permuting A and V alike (selection sort, N is small) */
+    for (uint16_t i = 0; i + 1 < N; i++)
+    {
+        uint16_t best = i;
+        for (uint16_t k = i + 1; k < N; k++)
+        {
+            if (crealf(A[k * N + k]) > crealf(A[best * N + best]))
+            {
+                best = k;
+            }
+        }
+        if (best != i)
+        {
+            for (uint16_t k = 0; k < N; k++)
+            {
+                float complex t;
+                t                = A[i * N + k];
+                A[i * N + k]     = A[best * N + k];
+                A[best * N + k]  = t;
+                t                = V[i * N + k];
+                V[i * N + k]     = V[best * N + k];
+                V[best * N + k]  = t;
+            }
+            for (uint16_t k = 0; k < N; k++)
+            {
+                float complex t = A[k * N + i];
+                A[k * N + i]    = A[k * N + best];
+                A[k * N + best] = t;
+            }
+        }
+    }
+
+    for (uint16_t j = 0; j < N; j++)
+    {
+        for (uint16_t i = 0; i <= j; i++)
+        {
+            pInput[(j * (j + 1)) / 2 + i] = A[j * N + i];
+        }
+    }
+    memcpy(pResultV, V, (uint32_t)N * N * sizeof(float complex));
+}
+
+/*
+ *  ======== APULPF3Emu_gaussJordanElim ========
+ *  In-place reduction to reduced row echelon form with partial pivoting.
+ *  Columns whose largest remaining magnitude is below epsTol are skipped.
+ */
+static void APULPF3Emu_gaussJordanElim(uint16_t M, uint16_t N, float complex *pInput, float epsTol)
+{
+    uint16_t row = 0;
+
+    for (uint16_t col = 0; col < N && row < M; col++)
+    {
+        uint16_t pivot = row;
+        float best     = cabsf(pInput[col * M + row]);
+        for (uint16_t r = row + 1; r < M; r++)
+        {
+            float mag = cabsf(pInput[col * M + r]);
+            if (mag > best)
+            {
+                best  = mag;
+                pivot = r;
+            }
+        }
+        if (best < epsTol)
+        {
+            continue;
+        }
+
+        if (pivot != row)
+        {
+            for (uint16_t k = 0; k < N; k++)
+            {
+                float complex t        = pInput[k * M + row];
+                pInput[k * M + row]   = pInput[k * M + pivot];
+                pInput[k * M + pivot] = t;
+            }
+        }
+
+        float complex inv = 1.0f / pInput[col * M + row];
+        for (uint16_t k = col; k < N; k++)
+        {
+            pInput[k * M + row] *= inv;
+        }
+        pInput[col * M + row] = 1.0f;
+
+        for (uint16_t r = 0; r < M; r++)
+        {
+            float complex factor = pInput[col * M + r];
+            if (r == row || factor == 0.0f)
+            {
+                continue;
+            }
+            for (uint16_t k = col; k < N; k++)
+            {
+                pInput[k * M + r] -= factor * pInput[k * M + row];
+            }
+            pInput[col * M + r] = 0.0f;
+        }
+        row++;
+    }
+}
+
+/*
+ *  ======== APULPF3Emu_hermLo ========
+ *  Upper triangle, column-major, to lower triangle, column-major: L(i, j) = conj(U(j, i)).
+ */
+static void APULPF3Emu_hermLo(uint16_t N, float complex *pInput, float complex *pResult)
+{
+    uint16_t index = 0;
+
+    /* Go through work, as the result may be the input */
+    for (uint16_t j = 0; j < N; j++)
+    {
+        for (uint16_t i = j; i < N; i++)
+        {
+            work[index++] = conjf(pInput[(i * (i + 1)) / 2 + j]);
+        }
+    }
+    memcpy(pResult, work, index * sizeof(float complex));
+}
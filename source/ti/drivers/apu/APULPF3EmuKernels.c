@@ -0,0 +1,559 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== APULPF3EmuKernels.c ========
+ */
+
+/* Products must be rounded before they are summed for all variants to agree */
+#if defined(__clang__)
+    #pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+    #pragma GCC optimize("fp-contract=off")
+#endif
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <ti/drivers/apu/APULPF3EmuKernels.h>
+
+#if !defined(APULPF3EMU_FORCE_SCALAR) && defined(__AVX__)
+    #define APULPF3EMU_AVX
+    #include <immintrin.h>
+#elif !defined(APULPF3EMU_FORCE_SCALAR) && defined(__SSE3__)
+    #define APULPF3EMU_SSE3
+    #include <pmmintrin.h>
+#elif !defined(APULPF3EMU_FORCE_SCALAR) && defined(__ARM_NEON) && defined(__aarch64__)
+    #define APULPF3EMU_NEON
+    #include <arm_neon.h>
+#endif
+
+/*
+ * Scalar building blocks. The vector variants below compute exactly the same
+ * operations per element, in the same order.
+ */
+static inline void cmul(float *dst, const float *a, const float *b)
+{
+    float re = a[0] * b[0] - a[1] * b[1];
+    float im = a[1] * b[0] + a[0] * b[1];
+    dst[0]   = re;
+    dst[1]   = im;
+}
+
+static inline void cmulConj(float *dst, const float *a, const float *b)
+{
+    float re = a[0] * b[0] + a[1] * b[1];
+    float im = a[1] * b[0] - a[0] * b[1];
+    dst[0]   = re;
+    dst[1]   = im;
+}
+
+static inline float selectMaxMin(float x, float threshold, bool min)
+{
+    /* Written to match the NaN behavior of the vector compare-and-select */
+    if (min)
+    {
+        return (x < threshold) ? x : threshold;
+    }
+    return (x > threshold) ? x : threshold;
+}
+
+#if defined(APULPF3EMU_AVX)
+typedef __m256 Vec;
+    #define VEC_N 4 /* Complex elements per vector */
+
+static inline Vec vload(const float *p)
+{
+    return _mm256_loadu_ps(p);
+}
+static inline void vstore(float *p, Vec v)
+{
+    _mm256_storeu_ps(p, v);
+}
+static inline Vec vzero(void)
+{
+    return _mm256_setzero_ps();
+}
+static inline Vec vadd(Vec a, Vec b)
+{
+    return _mm256_add_ps(a, b);
+}
+static inline Vec vsub(Vec a, Vec b)
+{
+    return _mm256_sub_ps(a, b);
+}
+static inline Vec vmul(Vec a, Vec b)
+{
+    return _mm256_mul_ps(a, b);
+}
+static inline Vec vbroadcast(const float *s)
+{
+    return _mm256_castpd_ps(_mm256_broadcast_sd((const double *)(const void *)s));
+}
+static inline Vec vswap(Vec a)
+{
+    return _mm256_permute_ps(a, 0xB1);
+}
+static inline Vec vdupRe(Vec a)
+{
+    return _mm256_moveldup_ps(a);
+}
+static inline Vec vdupIm(Vec a)
+{
+    return _mm256_movehdup_ps(a);
+}
+static inline Vec vaddsub(Vec a, Vec b)
+{
+    return _mm256_addsub_ps(a, b);
+}
+static inline Vec vneg(Vec a)
+{
+    return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f));
+}
+static inline Vec vmaxMin(Vec x, Vec threshold, bool min)
+{
+    Vec mask = min ? _mm256_cmp_ps(x, threshold, _CMP_LT_OQ) : _mm256_cmp_ps(x, threshold, _CMP_GT_OQ);
+    Vec sel  = _mm256_blendv_ps(threshold, x, mask);
+    /* Clear the imaginary parts */
+    return _mm256_blend_ps(sel, _mm256_setzero_ps(), 0xAA);
+}
+static inline Vec vset1(float s)
+{
+    return _mm256_set1_ps(s);
+}
+#elif defined(APULPF3EMU_SSE3)
+typedef __m128 Vec;
+    #define VEC_N 2
+
+static inline Vec vload(const float *p)
+{
+    return _mm_loadu_ps(p);
+}
+static inline void vstore(float *p, Vec v)
+{
+    _mm_storeu_ps(p, v);
+}
+static inline Vec vzero(void)
+{
+    return _mm_setzero_ps();
+}
+static inline Vec vadd(Vec a, Vec b)
+{
+    return _mm_add_ps(a, b);
+}
+static inline Vec vsub(Vec a, Vec b)
+{
+    return _mm_sub_ps(a, b);
+}
+static inline Vec vmul(Vec a, Vec b)
+{
+    return _mm_mul_ps(a, b);
+}
+static inline Vec vbroadcast(const float *s)
+{
+    return _mm_castpd_ps(_mm_load1_pd((const double *)(const void *)s));
+}
+static inline Vec vswap(Vec a)
+{
+    return _mm_shuffle_ps(a, a, 0xB1);
+}
+static inline Vec vdupRe(Vec a)
+{
+    return _mm_moveldup_ps(a);
+}
+static inline Vec vdupIm(Vec a)
+{
+    return _mm_movehdup_ps(a);
+}
+static inline Vec vaddsub(Vec a, Vec b)
+{
+    return _mm_addsub_ps(a, b);
+}
+static inline Vec vneg(Vec a)
+{
+    return _mm_xor_ps(a, _mm_set1_ps(-0.0f));
+}
+static inline Vec vmaxMin(Vec x, Vec threshold, bool min)
+{
+    Vec mask = min ? _mm_cmplt_ps(x, threshold) : _mm_cmpgt_ps(x, threshold);
+    Vec sel  = _mm_or_ps(_mm_and_ps(mask, x), _mm_andnot_ps(mask, threshold));
+    /* Clear the imaginary parts */
+    return _mm_and_ps(sel, _mm_castsi128_ps(_mm_set_epi32(0, -1, 0, -1)));
+}
+static inline Vec vset1(float s)
+{
+    return _mm_set1_ps(s);
+}
+#elif defined(APULPF3EMU_NEON)
+typedef float32x4_t Vec;
+    #define VEC_N 2
+
+static inline Vec vload(const float *p)
+{
+    return vld1q_f32(p);
+}
+static inline void vstore(float *p, Vec v)
+{
+    vst1q_f32(p, v);
+}
+static inline Vec vzero(void)
+{
+    return vdupq_n_f32(0.0f);
+}
+static inline Vec vadd(Vec a, Vec b)
+{
+    return vaddq_f32(a, b);
+}
+static inline Vec vsub(Vec a, Vec b)
+{
+    return vsubq_f32(a, b);
+}
+static inline Vec vmul(Vec a, Vec b)
+{
+    return vmulq_f32(a, b);
+}
+static inline Vec vbroadcast(const float *s)
+{
+    return vreinterpretq_f32_f64(vld1q_dup_f64((const float64_t *)(const void *)s));
+}
+static inline Vec vswap(Vec a)
+{
+    return vrev64q_f32(a);
+}
+static inline Vec vdupRe(Vec a)
+{
+    return vtrn1q_f32(a, a);
+}
+static inline Vec vdupIm(Vec a)
+{
+    return vtrn2q_f32(a, a);
+}
+static inline Vec vaddsub(Vec a, Vec b)
+{
+    static const float sign[4] = {-1.0f, 1.0f, -1.0f, 1.0f};
+    /* Multiplying by -1 is exact, so this matches a - b, a + b */
+    return vaddq_f32(a, vmulq_f32(b, vld1q_f32(sign)));
+}
+static inline Vec vneg(Vec a)
+{
+    return vnegq_f32(a);
+}
+static inline Vec vmaxMin(Vec x, Vec threshold, bool min)
+{
+    static const uint32_t reMask[4] = {0xFFFFFFFFU, 0U, 0xFFFFFFFFU, 0U};
+    uint32x4_t mask = min ? vcltq_f32(x, threshold) : vcgtq_f32(x, threshold);
+    Vec sel         = vbslq_f32(mask, x, threshold);
+    /* Clear the imaginary parts */
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(sel), vld1q_u32(reMask)));
+}
+static inline Vec vset1(float s)
+{
+    return vdupq_n_f32(s);
+}
+#endif
+
+#if defined(VEC_N)
+/* (ar*br - ai*bi, ai*br + ar*bi) per element */
+static inline Vec vcmul(Vec a, Vec b)
+{
+    return vaddsub(vmul(a, vdupRe(b)), vmul(vswap(a), vdupIm(b)));
+}
+
+/* (ar*br + ai*bi, ai*br - ar*bi) per element */
+static inline Vec vcmulConj(Vec a, Vec b)
+{
+    return vaddsub(vmul(a, vdupRe(b)), vneg(vmul(vswap(a), vdupIm(b))));
+}
+#endif
+
+/*
+ *  ======== APULPF3EmuKernels_isa ========
+ */
+const char *APULPF3EmuKernels_isa(void)
+{
+#if defined(APULPF3EMU_AVX)
+    return "avx";
+#elif defined(APULPF3EMU_SSE3)
+    return "sse3";
+#elif defined(APULPF3EMU_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+/*
+ *  ======== APULPF3EmuKernels_mult ========
+ */
+void APULPF3EmuKernels_mult(float *dst, const float *a, const float *b, size_t n, bool conjugate)
+{
+    size_t i = 0;
+
+#if defined(VEC_N)
+    for (; i + VEC_N <= n; i += VEC_N)
+    {
+        Vec va = vload(&a[2 * i]);
+        Vec vb = vload(&b[2 * i]);
+        vstore(&dst[2 * i], conjugate ? vcmulConj(va, vb) : vcmul(va, vb));
+    }
+#endif
+    for (; i < n; i++)
+    {
+        if (conjugate)
+        {
+            cmulConj(&dst[2 * i], &a[2 * i], &b[2 * i]);
+        }
+        else
+        {
+            cmul(&dst[2 * i], &a[2 * i], &b[2 * i]);
+        }
+    }
+}
+
+/*
+ *  ======== APULPF3EmuKernels_scalarMult ========
+ */
+void APULPF3EmuKernels_scalarMult(float *dst, const float *a, const float *s, size_t n)
+{
+    float scalar[2] = {s[0], s[1]};
+    size_t i        = 0;
+
+#if defined(VEC_N)
+    Vec vs = vbroadcast(scalar);
+    for (; i + VEC_N <= n; i += VEC_N)
+    {
+        vstore(&dst[2 * i], vcmul(vload(&a[2 * i]), vs));
+    }
+#endif
+    for (; i < n; i++)
+    {
+        cmul(&dst[2 * i], &a[2 * i], scalar);
+    }
+}
+
+/*
+ *  ======== APULPF3EmuKernels_scalarMac ========
+ */
+void APULPF3EmuKernels_scalarMac(float *dst, const float *a, const float *s, size_t n)
+{
+    float scalar[2] = {s[0], s[1]};
+    size_t i        = 0;
+
+#if defined(VEC_N)
+    Vec vs = vbroadcast(scalar);
+    for (; i + VEC_N <= n; i += VEC_N)
+    {
+        vstore(&dst[2 * i], vadd(vload(&dst[2 * i]), vcmul(vload(&a[2 * i]), vs)));
+    }
+#endif
+    for (; i < n; i++)
+    {
+        float p[2];
+        cmul(p, &a[2 * i], scalar);
+        dst[2 * i] += p[0];
+        dst[2 * i + 1] += p[1];
+    }
+}
+
+/*
+ *  ======== APULPF3EmuKernels_sum ========
+ */
+void APULPF3EmuKernels_sum(float *dst, const float *a, const float *b, size_t n, bool subtraction)
+{
+    size_t i = 0;
+
+#if defined(VEC_N)
+    for (; i + VEC_N <= n; i += VEC_N)
+    {
+        Vec va = vload(&a[2 * i]);
+        Vec vb = vload(&b[2 * i]);
+        vstore(&dst[2 * i], subtraction ? vsub(va, vb) : vadd(va, vb));
+    }
+#endif
+    for (i *= 2; i < 2 * n; i++)
+    {
+        dst[i] = subtraction ? (a[i] - b[i]) : (a[i] + b[i]);
+    }
+}
+
+/*
+ *  ======== APULPF3EmuKernels_scalarSum ========
+ */
+void APULPF3EmuKernels_scalarSum(float *dst, const float *a, const float *s, size_t n, bool subtraction)
+{
+    float scalar[2] = {s[0], s[1]};
+    size_t i        = 0;
+
+#if defined(VEC_N)
+    Vec vs = vbroadcast(scalar);
+    for (; i + VEC_N <= n; i += VEC_N)
+    {
+        Vec va = vload(&a[2 * i]);
+        vstore(&dst[2 * i], subtraction ? vsub(va, vs) : vadd(va, vs));
+    }
+#endif
+    for (i *= 2; i < 2 * n; i++)
+    {
+        dst[i] = subtraction ? (a[i] - scalar[i & 1]) : (a[i] + scalar[i & 1]);
+    }
+}
+
+/*
+ *  ======== APULPF3EmuKernels_dot ========
+ */
+void APULPF3EmuKernels_dot(float *dst, const float *a, const float *b, size_t n, bool conjugate)
+{
+    float lanes[2 * APULPF3EMU_LANES] = {0};
+    size_t i                           = 0;
+
+#if defined(VEC_N)
+    Vec acc[APULPF3EMU_LANES / VEC_N];
+    for (size_t j = 0; j < APULPF3EMU_LANES / VEC_N; j++)
+    {
+        acc[j] = vzero();
+    }
+    for (; i + APULPF3EMU_LANES <= n; i += APULPF3EMU_LANES)
+    {
+        for (size_t j = 0; j < APULPF3EMU_LANES / VEC_N; j++)
+        {
+            Vec va = vload(&a[2 * (i + j * VEC_N)]);
+            Vec vb = vload(&b[2 * (i + j * VEC_N)]);
+            acc[j] = vadd(acc[j], conjugate ? vcmulConj(va, vb) : vcmul(va, vb));
+        }
+    }
+    for (size_t j = 0; j < APULPF3EMU_LANES / VEC_N; j++)
+    {
+        vstore(&lanes[2 * j * VEC_N], acc[j]);
+    }
+#endif
+    for (; i < n; i++)
+    {
+        float p[2];
+        float *lane = &lanes[2 * (i % APULPF3EMU_LANES)];
+        if (conjugate)
+        {
+            cmulConj(p, &a[2 * i], &b[2 * i]);
+        }
+        else
+        {
+            cmul(p, &a[2 * i], &b[2 * i]);
+        }
+        lane[0] += p[0];
+        lane[1] += p[1];
+    }
+
+    dst[0] = (lanes[0] + lanes[2]) + (lanes[4] + lanes[6]);
+    dst[1] = (lanes[1] + lanes[3]) + (lanes[5] + lanes[7]);
+}
+
+/*
+ *  ======== APULPF3EmuKernels_sumSquares ========
+ */
+float APULPF3EmuKernels_sumSquares(const float *a, size_t n)
+{
+    /* Each lane is kept twice, in the real and imaginary position */
+    float lanes[2 * APULPF3EMU_LANES] = {0};
+    size_t i                           = 0;
+
+#if defined(VEC_N)
+    Vec acc[APULPF3EMU_LANES / VEC_N];
+    for (size_t j = 0; j < APULPF3EMU_LANES / VEC_N; j++)
+    {
+        acc[j] = vzero();
+    }
+    for (; i + APULPF3EMU_LANES <= n; i += APULPF3EMU_LANES)
+    {
+        for (size_t j = 0; j < APULPF3EMU_LANES / VEC_N; j++)
+        {
+            Vec sq = vmul(vload(&a[2 * (i + j * VEC_N)]), vload(&a[2 * (i + j * VEC_N)]));
+            acc[j] = vadd(acc[j], vadd(sq, vswap(sq)));
+        }
+    }
+    for (size_t j = 0; j < APULPF3EMU_LANES / VEC_N; j++)
+    {
+        vstore(&lanes[2 * j * VEC_N], acc[j]);
+    }
+#endif
+    for (; i < n; i++)
+    {
+        lanes[2 * (i % APULPF3EMU_LANES)] += a[2 * i] * a[2 * i] + a[2 * i + 1] * a[2 * i + 1];
+    }
+
+    return (lanes[0] + lanes[2]) + (lanes[4] + lanes[6]);
+}
+
+/*
+ *  ======== APULPF3EmuKernels_maxMin ========
+ */
+void APULPF3EmuKernels_maxMin(float *dst, const float *a, float threshold, size_t n, bool min)
+{
+    size_t i = 0;
+
+#if defined(VEC_N)
+    Vec vt = vset1(threshold);
+    for (; i + VEC_N <= n; i += VEC_N)
+    {
+        vstore(&dst[2 * i], vmaxMin(vload(&a[2 * i]), vt, min));
+    }
+#endif
+    for (; i < n; i++)
+    {
+        dst[2 * i]     = selectMaxMin(a[2 * i], threshold, min);
+        dst[2 * i + 1] = 0.0f;
+    }
+}
+
+/*
+ *  ======== APULPF3EmuKernels_butterfly ========
+ */
+void APULPF3EmuKernels_butterfly(float *lo, float *hi, const float *w, size_t n)
+{
+    size_t i = 0;
+
+#if defined(VEC_N)
+    for (; i + VEC_N <= n; i += VEC_N)
+    {
+        Vec t  = vcmul(vload(&hi[2 * i]), vload(&w[2 * i]));
+        Vec vl = vload(&lo[2 * i]);
+        vstore(&hi[2 * i], vsub(vl, t));
+        vstore(&lo[2 * i], vadd(vl, t));
+    }
+#endif
+    for (; i < n; i++)
+    {
+        float t[2];
+        cmul(t, &hi[2 * i], &w[2 * i]);
+        hi[2 * i]     = lo[2 * i] - t[0];
+        hi[2 * i + 1] = lo[2 * i + 1] - t[1];
+        lo[2 * i] += t[0];
+        lo[2 * i + 1] += t[1];
+    }
+}
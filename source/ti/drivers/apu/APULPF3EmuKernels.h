@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!*****************************************************************************
+ *  @file       APULPF3EmuKernels.h
+ *  @brief      Vector kernels of the host APU emulation
+ *
+ *  Internal to APULPF3Emu.c. Complex numbers are handled as interleaved
+ *  (real, imaginary) float pairs, with @c n counting complex elements.
+ *
+ *  The kernels are built for SSE3, AVX or AArch64 NEON when the compiler
+ *  targets them, and as portable C otherwise. Define
+ *  APULPF3EMU_FORCE_SCALAR to always use the portable C kernels.
+ *
+ *  All variants give bit-identical results: products are rounded before they
+ *  are added (the kernels must be built without floating point contraction,
+ *  which the source enforces where the compiler allows it), and reductions
+ *  sum element i into lane (i % #APULPF3EMU_LANES) and combine the lanes as
+ *  (lane0 + lane1) + (lane2 + lane3).
+ *******************************************************************************
+ */
+#ifndef ti_drivers_apu_APULPF3EmuKernels__include
+#define ti_drivers_apu_APULPF3EmuKernels__include
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ *  @brief Number of partial sums used by reductions
+ */
+#define APULPF3EMU_LANES 4
+
+/*!
+ *  @brief Name of the instruction set the kernels were built for
+ */
+const char *APULPF3EmuKernels_isa(void);
+
+/*!
+ *  @brief dst[i] = a[i] * b[i], or a[i] * conj(b[i]) if @c conjugate
+ */
+void APULPF3EmuKernels_mult(float *dst, const float *a, const float *b, size_t n, bool conjugate);
+
+/*!
+ *  @brief dst[i] = a[i] * s
+ */
+void APULPF3EmuKernels_scalarMult(float *dst, const float *a, const float *s, size_t n);
+
+/*!
+ *  @brief dst[i] += a[i] * s
+ */
+void APULPF3EmuKernels_scalarMac(float *dst, const float *a, const float *s, size_t n);
+
+/*!
+ *  @brief dst[i] = a[i] + b[i], or a[i] - b[i] if @c subtraction
+ */
+void APULPF3EmuKernels_sum(float *dst, const float *a, const float *b, size_t n, bool subtraction);
+
+/*!
+ *  @brief dst[i] = a[i] + s, or a[i] - s if @c subtraction
+ */
+void APULPF3EmuKernels_scalarSum(float *dst, const float *a, const float *s, size_t n, bool subtraction);
+
+/*!
+ *  @brief dst = sum(a[i] * b[i]), or sum(a[i] * conj(b[i])) if @c conjugate
+ *
+ *  @c a and @c b may be unaligned windows into the same vector.
+ */
+void APULPF3EmuKernels_dot(float *dst, const float *a, const float *b, size_t n, bool conjugate);
+
+/*!
+ *  @brief Return sum(|a[i]|^2)
+ */
+float APULPF3EmuKernels_sumSquares(const float *a, size_t n);
+
+/*!
+ *  @brief dst[i] = max(real(a[i]), threshold), or min if @c min, with zero imaginary part
+ */
+void APULPF3EmuKernels_maxMin(float *dst, const float *a, float threshold, size_t n, bool min);
+
+/*!
+ *  @brief Radix-2 butterflies: t = hi[i] * w[i]; hi[i] = lo[i] - t; lo[i] = lo[i] + t
+ */
+void APULPF3EmuKernels_butterfly(float *lo, float *hi, const float *w, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ti_drivers_apu_APULPF3EmuKernels__include */
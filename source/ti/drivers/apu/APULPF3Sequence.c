@@ -0,0 +1,465 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== APULPF3Sequence.c ========
+ *
+ *  Operation sequences, built on the scratchpad mode of the APULPF3 API.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <complex.h>
+
+#include <ti/drivers/apu/APULPF3.h>
+
+/* Maximum number of operand regions of one step */
+#define APULPF3_SEQUENCE_MAX_REGIONS 2
+
+/*
+ *  Region of APU memory, in complex numbers
+ */
+typedef struct
+{
+    uint16_t offset;
+    uint16_t size;
+} APULPF3_Region;
+
+/*
+ *  Memory accesses of one step
+ */
+typedef struct
+{
+    APULPF3_Region in[APULPF3_SEQUENCE_MAX_REGIONS];  /* Operands read by the operation */
+    APULPF3_Region out[APULPF3_SEQUENCE_MAX_REGIONS]; /* Results, scalars and temporaries written */
+    bool inPlace;                                     /* out[0] is allowed to be in[0] */
+} APULPF3_StepAccess;
+
+static bool APULPF3_getStepAccess(const APULPF3_SequenceStep *step, APULPF3_StepAccess *access);
+static bool APULPF3_regionsOverlap(const APULPF3_Region *a, const APULPF3_Region *b);
+static bool APULPF3_isDefined(const uint8_t *defined, const APULPF3_Region *region);
+static void APULPF3_setDefined(uint8_t *defined, const APULPF3_Region *region);
+
+/*
+ *  ======== APULPF3_getStepAccess ========
+ *  Describe which APU memory a step reads and writes. Returns false if the
+ *  dimensions of the step are invalid.
+ */
+static bool APULPF3_getStepAccess(const APULPF3_SequenceStep *step, APULPF3_StepAccess *access)
+{
+    uint32_t n        = step->rows;
+    uint32_t matSize  = (uint32_t)step->rows * step->cols;
+    uint32_t triSize  = (n * (n + 1)) / 2;
+    uint32_t argASize = 0;
+    uint32_t argBSize = 0;
+    uint32_t outSize  = 0;
+    bool argBIsInput  = false;
+    bool valid        = (n > 0);
+
+    *access = (APULPF3_StepAccess){0};
+
+    switch (step->op)
+    {
+        case APULPF3_SequenceOp_dotProduct:
+            argASize    = n;
+            argBSize    = n;
+            argBIsInput = true;
+            outSize     = 1;
+            break;
+        case APULPF3_SequenceOp_vectorMult:
+        case APULPF3_SequenceOp_vectorSum:
+            argASize    = n;
+            argBSize    = n;
+            argBIsInput = true;
+            outSize     = n;
+            break;
+        case APULPF3_SequenceOp_vectorR2C:
+            argASize = n;
+            if (step->param == APULPF3_R2COp_R2C || step->param == APULPF3_R2COp_R2CC)
+            {
+                argBSize    = n;
+                argBIsInput = true;
+            }
+            outSize = n;
+            break;
+        case APULPF3_SequenceOp_vectorScalarSum:
+        case APULPF3_SequenceOp_vectorScalarMult:
+            argASize = n;
+            argBSize = 1;
+            outSize  = n;
+            break;
+        case APULPF3_SequenceOp_vectorMaxMin:
+        case APULPF3_SequenceOp_cartesianToPolarVector:
+            argASize = n;
+            outSize  = n;
+            break;
+        case APULPF3_SequenceOp_polarToCartesianVector:
+            /* argB is the temporary vector */
+            argASize = n;
+            argBSize = n;
+            outSize  = n;
+            break;
+        case APULPF3_SequenceOp_sortVector:
+            argASize        = n;
+            outSize         = n;
+            access->inPlace = true;
+            break;
+        case APULPF3_SequenceOp_computeFFT:
+            argASize        = n;
+            outSize         = n;
+            access->inPlace = true;
+            valid           = valid && ((n & (n - 1)) == 0);
+            break;
+        case APULPF3_SequenceOp_covMatrixSpatialSmoothing:
+            argASize = n;
+            outSize  = ((uint32_t)step->cols * (step->cols + 1)) / 2;
+            valid    = valid && (step->cols > 0) && (step->cols <= n);
+            break;
+        case APULPF3_SequenceOp_matrixMult:
+            argASize    = matSize;
+            argBSize    = (uint32_t)step->cols * step->param;
+            argBIsInput = true;
+            outSize     = (uint32_t)step->rows * step->param;
+            valid       = valid && (step->cols > 0) && (step->param > 0);
+            break;
+        case APULPF3_SequenceOp_matrixSum:
+            argASize    = matSize;
+            argBSize    = matSize;
+            argBIsInput = true;
+            outSize     = matSize;
+            valid       = valid && (step->cols > 0);
+            break;
+        case APULPF3_SequenceOp_matrixScalarSum:
+        case APULPF3_SequenceOp_matrixScalarMult:
+            argASize = matSize;
+            argBSize = 1;
+            outSize  = matSize;
+            valid    = valid && (step->cols > 0);
+            break;
+        case APULPF3_SequenceOp_matrixNorm:
+            argASize = matSize;
+            outSize  = 1;
+            valid    = valid && (step->cols > 0);
+            break;
+        case APULPF3_SequenceOp_HermLo:
+            argASize = triSize;
+            outSize  = triSize;
+            break;
+        case APULPF3_SequenceOp_jacobiEVD:
+            /* Eigenvalues replace the input, eigenvectors go to the result */
+            argASize = triSize;
+            outSize  = n * n;
+            break;
+        case APULPF3_SequenceOp_gaussJordanElim:
+            argASize        = matSize;
+            outSize         = matSize;
+            access->inPlace = true;
+            valid           = valid && (step->cols > 0);
+            break;
+        case APULPF3_SequenceOp_unitCircle:
+            outSize = n;
+            break;
+        default:
+            valid = false;
+            break;
+    }
+
+    if (!valid || argASize > APULPF3_SEQUENCE_MEM_SIZE || argBSize > APULPF3_SEQUENCE_MEM_SIZE ||
+        outSize > APULPF3_SEQUENCE_MEM_SIZE)
+    {
+        return false;
+    }
+
+    access->in[0]  = (APULPF3_Region){step->argA, (uint16_t)argASize};
+    access->out[0] = (APULPF3_Region){step->result, (uint16_t)outSize};
+    if (argBIsInput)
+    {
+        access->in[1] = (APULPF3_Region){step->argB, (uint16_t)argBSize};
+    }
+    else if (step->op == APULPF3_SequenceOp_jacobiEVD)
+    {
+        access->out[1] = access->in[0];
+    }
+    else
+    {
+        /* Scalars and temporaries are written by the step */
+        access->out[1] = (APULPF3_Region){step->argB, (uint16_t)argBSize};
+    }
+
+    return true;
+}
+
+/*
+ *  ======== APULPF3_regionsOverlap ========
+ */
+static bool APULPF3_regionsOverlap(const APULPF3_Region *a, const APULPF3_Region *b)
+{
+    return a->size > 0 && b->size > 0 && a->offset < b->offset + b->size && b->offset < a->offset + a->size;
+}
+
+/*
+ *  ======== APULPF3_isDefined ========
+ *  Check that all elements of a region have been written.
+ */
+static bool APULPF3_isDefined(const uint8_t *defined, const APULPF3_Region *region)
+{
+    for (uint32_t i = region->offset; i < (uint32_t)region->offset + region->size; i++)
+    {
+        if ((defined[i >> 3] & (1U << (i & 7U))) == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ *  ======== APULPF3_setDefined ========
+ */
+static void APULPF3_setDefined(uint8_t *defined, const APULPF3_Region *region)
+{
+    for (uint32_t i = region->offset; i < (uint32_t)region->offset + region->size; i++)
+    {
+        defined[i >> 3] |= (uint8_t)(1U << (i & 7U));
+    }
+}
+
+/*
+ *  ======== APULPF3_validateSequence ========
+ */
+int_fast16_t APULPF3_validateSequence(APULPF3_Sequence *seq)
+{
+    uint8_t defined[(APULPF3_SEQUENCE_MEM_SIZE + 7) / 8] = {0};
+    APULPF3_Region input  = {seq->inputOffset, seq->inputSize};
+    APULPF3_Region output = {seq->outputOffset, seq->outputSize};
+    APULPF3_StepAccess access;
+
+    seq->isValid = false;
+
+    if ((seq->steps == NULL && seq->numSteps > 0) || (uint32_t)input.offset + input.size > APULPF3_SEQUENCE_MEM_SIZE ||
+        (uint32_t)output.offset + output.size > APULPF3_SEQUENCE_MEM_SIZE)
+    {
+        return APULPF3_STATUS_ERROR;
+    }
+    APULPF3_setDefined(defined, &input);
+
+    for (uint16_t i = 0; i < seq->numSteps; i++)
+    {
+        if (!APULPF3_getStepAccess(&seq->steps[i], &access))
+        {
+            return APULPF3_STATUS_ERROR;
+        }
+
+        for (uint8_t j = 0; j < APULPF3_SEQUENCE_MAX_REGIONS; j++)
+        {
+            if ((uint32_t)access.in[j].offset + access.in[j].size > APULPF3_SEQUENCE_MEM_SIZE ||
+                (uint32_t)access.out[j].offset + access.out[j].size > APULPF3_SEQUENCE_MEM_SIZE)
+            {
+                return APULPF3_STATUS_ERROR;
+            }
+            /* Operands must come from the input or an earlier step */
+            if (!APULPF3_isDefined(defined, &access.in[j]))
+            {
+                return APULPF3_STATUS_ERROR;
+            }
+        }
+
+        if (access.inPlace)
+        {
+            if (seq->steps[i].result != seq->steps[i].argA)
+            {
+                return APULPF3_STATUS_ERROR;
+            }
+        }
+        else
+        {
+            /* In scratchpad mode results must not overlap the operands, nor each other */
+            for (uint8_t j = 0; j < APULPF3_SEQUENCE_MAX_REGIONS; j++)
+            {
+                if (APULPF3_regionsOverlap(&access.out[0], &access.in[j]) ||
+                    (seq->steps[i].op != APULPF3_SequenceOp_jacobiEVD &&
+                     APULPF3_regionsOverlap(&access.out[1], &access.in[j])))
+                {
+                    return APULPF3_STATUS_ERROR;
+                }
+            }
+            if (APULPF3_regionsOverlap(&access.out[0], &access.out[1]))
+            {
+                return APULPF3_STATUS_ERROR;
+            }
+        }
+
+        for (uint8_t j = 0; j < APULPF3_SEQUENCE_MAX_REGIONS; j++)
+        {
+            APULPF3_setDefined(defined, &access.out[j]);
+        }
+    }
+
+    if (!APULPF3_isDefined(defined, &output))
+    {
+        return APULPF3_STATUS_ERROR;
+    }
+
+    seq->isValid = true;
+    return APULPF3_STATUS_SUCCESS;
+}
+
+/*
+ *  ======== APULPF3_runSequence ========
+ */
+int_fast16_t APULPF3_runSequence(const APULPF3_Sequence *seq, float complex *input, float complex *output)
+{
+    float complex *mem     = (float complex *)APULPF3_MEM_BASE;
+    int_fast16_t returnVal = APULPF3_STATUS_ERROR;
+
+    if (!seq->isValid)
+    {
+        return APULPF3_STATUS_ERROR;
+    }
+
+    if (seq->inputSize > 0)
+    {
+        APULPF3_loadArgMirrored(seq->inputSize, seq->inputOffset, input);
+    }
+
+    /* All operands are in APU memory, so every operation runs in scratchpad mode */
+    for (uint16_t i = 0; i < seq->numSteps; i++)
+    {
+        const APULPF3_SequenceStep *step = &seq->steps[i];
+
+        APULPF3_ComplexVector vecA        = {.data = &mem[step->argA], .size = step->rows};
+        APULPF3_ComplexVector vecB        = {.data = &mem[step->argB], .size = step->rows};
+        APULPF3_ComplexVector vecResult   = {.data = &mem[step->result], .size = step->rows};
+        APULPF3_ComplexMatrix matA        = {.data = &mem[step->argA], .rows = step->rows, .cols = step->cols};
+        APULPF3_ComplexMatrix matResult   = {.data = &mem[step->result], .rows = step->rows, .cols = step->cols};
+        APULPF3_ComplexTriangleMatrix triA = {.data = &mem[step->argA], .size = step->rows};
+
+        switch (step->op)
+        {
+            case APULPF3_SequenceOp_dotProduct:
+                returnVal = APULPF3_dotProduct(&vecA, &vecB, step->flag, &mem[step->result]);
+                break;
+            case APULPF3_SequenceOp_vectorMult:
+                returnVal = APULPF3_vectorMult(&vecA, &vecB, step->flag, &vecResult);
+                break;
+            case APULPF3_SequenceOp_vectorSum:
+                returnVal = APULPF3_vectorSum(&vecA, &vecB, step->flag, &vecResult);
+                break;
+            case APULPF3_SequenceOp_vectorScalarSum:
+                APULPF3_loadArgMirrored(1, step->argB, (float complex *)&step->scalar);
+                returnVal = APULPF3_vectorScalarSum(&vecA, &mem[step->argB], step->flag, &vecResult);
+                break;
+            case APULPF3_SequenceOp_vectorScalarMult:
+                APULPF3_loadArgMirrored(1, step->argB, (float complex *)&step->scalar);
+                returnVal = APULPF3_vectorScalarMult(&vecA, &mem[step->argB], &vecResult);
+                break;
+            case APULPF3_SequenceOp_vectorR2C:
+                returnVal = APULPF3_vectorR2C(&vecA, &vecB, (APULPF3_R2COp)step->param, &vecResult);
+                break;
+            case APULPF3_SequenceOp_vectorMaxMin:
+                returnVal = APULPF3_vectorMaxMin(&vecA, step->threshold, step->flag, &vecResult);
+                break;
+            case APULPF3_SequenceOp_cartesianToPolarVector:
+                returnVal = APULPF3_cartesianToPolarVector(&vecA, &vecResult);
+                break;
+            case APULPF3_SequenceOp_polarToCartesianVector:
+                returnVal = APULPF3_polarToCartesianVector(&vecA, &mem[step->argB], &vecResult);
+                break;
+            case APULPF3_SequenceOp_sortVector:
+                returnVal = APULPF3_sortVector(&vecA, &vecA);
+                break;
+            case APULPF3_SequenceOp_covMatrixSpatialSmoothing:
+            {
+                APULPF3_ComplexTriangleMatrix cov = {.data = &mem[step->result], .size = step->cols};
+                returnVal = APULPF3_covMatrixSpatialSmoothing(&vecA, step->cols, step->flag, &cov);
+                break;
+            }
+            case APULPF3_SequenceOp_computeFFT:
+                returnVal = APULPF3_computeFFT(&vecA, step->flag, &vecA);
+                break;
+            case APULPF3_SequenceOp_matrixMult:
+            {
+                APULPF3_ComplexMatrix matB = {.data = &mem[step->argB], .rows = step->cols, .cols = step->param};
+                matResult.cols             = step->param;
+                returnVal                  = APULPF3_matrixMult(&matA, &matB, &matResult);
+                break;
+            }
+            case APULPF3_SequenceOp_matrixSum:
+            {
+                APULPF3_ComplexMatrix matB = {.data = &mem[step->argB], .rows = step->rows, .cols = step->cols};
+                returnVal                  = APULPF3_matrixSum(&matA, &matB, &matResult);
+                break;
+            }
+            case APULPF3_SequenceOp_HermLo:
+            {
+                APULPF3_ComplexTriangleMatrix triResult = {.data = &mem[step->result], .size = step->rows};
+                returnVal                               = APULPF3_HermLo(&triA, &triResult);
+                break;
+            }
+            case APULPF3_SequenceOp_matrixScalarSum:
+                APULPF3_loadArgMirrored(1, step->argB, (float complex *)&step->scalar);
+                returnVal = APULPF3_matrixScalarSum(&matA, &mem[step->argB], &matResult);
+                break;
+            case APULPF3_SequenceOp_matrixScalarMult:
+                APULPF3_loadArgMirrored(1, step->argB, (float complex *)&step->scalar);
+                returnVal = APULPF3_matrixScalarMult(&matA, &mem[step->argB], &matResult);
+                break;
+            case APULPF3_SequenceOp_matrixNorm:
+                returnVal = APULPF3_matrixNorm(&matA, &mem[step->result]);
+                break;
+            case APULPF3_SequenceOp_jacobiEVD:
+                returnVal = APULPF3_jacobiEVD(&triA, step->param, step->threshold, step->epsTol, &vecResult);
+                break;
+            case APULPF3_SequenceOp_gaussJordanElim:
+                returnVal = APULPF3_gaussJordanElim(&matA, step->threshold, &matA);
+                break;
+            case APULPF3_SequenceOp_unitCircle:
+                returnVal = APULPF3_unitCircle(step->rows, step->param, step->phase, step->flag, &vecResult);
+                break;
+            default:
+                returnVal = APULPF3_STATUS_ERROR;
+                break;
+        }
+
+        if (returnVal != APULPF3_STATUS_SUCCESS)
+        {
+            return returnVal;
+        }
+    }
+
+    if (seq->outputSize > 0)
+    {
+        APULPF3_readArgMirrored(seq->outputSize, seq->outputOffset, output);
+    }
+
+    return APULPF3_STATUS_SUCCESS;
+}
@@ -0,0 +1,585 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== apuemutest.c ========
+ *
+ * Check and benchmark of the APULPF3 host emulation.
+ *
+ * Every APULPF3 operation is compared with a double precision reference,
+ * with the arguments in host memory and in APU memory (scratchpad mode):
+ *
+ * - vector operations for lengths 1 to 255, FFT and inverse FFT up to
+ *   1024 points and unit circle points
+ * - matrix multiplication, sums, scalar operations and norm, including a
+ *   check that matrixMult writes no more than rows(A) x cols(B) elements
+ * - covariance matrix with and without forward-backward averaging, which
+ *   must write no more than the upper triangle, HermLo and Jacobi EVD
+ *   (A V = V diag(lambda), eigenvalues in descending order)
+ * - Gauss-Jordan elimination of a matrix with a dependent column
+ *
+ * All results are also written to the dump file. The kernels are meant to
+ * give bit-identical results on every instruction set, so "make check"
+ * compares the dumps of the builds in ISAS byte for byte.
+ *
+ * The benchmark prints the time per call, including the copies to and from
+ * APU memory.
+ *
+ * Usage:
+ *
+ *     apuemutest [dump file]
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <complex.h>
+
+#include <ti/drivers/apu/APULPF3.h>
+#include <ti/drivers/apu/APULPF3EmuKernels.h>
+
+#define MEM ((float complex *)APULPF3_MEM_BASE)
+
+#define CHECK(cond, ...)                                       \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            failures++;                                        \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__);        \
+            printf(__VA_ARGS__);                               \
+            printf("\n");                                      \
+        }                                                      \
+    } while (0)
+
+static int failures;
+static uint32_t randomState = 12345;
+static FILE *dump;
+
+static float complex a[1024];
+static float complex b[1024];
+static float complex r[1024];
+static float complex t[1024];
+static double complex ref[1024];
+
+static float randomFloat(void)
+{
+    randomState = randomState * 1103515245U + 12345U;
+    return (((randomState >> 8) & 0xFFFF) / 32768.0f - 1.0f);
+}
+
+static void fill(float complex *p, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        p[i] = CMPLXF(randomFloat(), randomFloat());
+    }
+}
+
+static void output(const char *name, const float complex *p, int n)
+{
+    fwrite(name, 1, strlen(name), dump);
+    fwrite(p, sizeof(*p), n, dump);
+}
+
+/* Compare with the reference, relative to the largest reference element */
+static void compare(const char *name, const float complex *p, const double complex *expected, int n, double tol)
+{
+    double maxError = 0;
+    double maxValue = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        maxError = fmax(maxError, cabs((double complex)p[i] - expected[i]));
+        maxValue = fmax(maxValue, cabs(expected[i]));
+    }
+    double error = maxError / fmax(maxValue, 1.0);
+    CHECK(error <= tol, "%s, %d elements: relative error %.3g", name, n, error);
+    output(name, p, n);
+}
+
+static double complex product(float complex x, float complex y, bool conjugate)
+{
+    return ((double complex)x * (conjugate ? conj((double complex)y) : (double complex)y));
+}
+
+static void checkVectors(void)
+{
+    static const int sizes[] = {1, 2, 3, 5, 7, 8, 13, 16, 31, 64, 100, 255};
+    static const APULPF3_R2COp r2cOps[] = {APULPF3_R2COp_R2C,
+                                           APULPF3_R2COp_R2CC,
+                                           APULPF3_R2COp_R2CA,
+                                           APULPF3_R2COp_R2CAA,
+                                           APULPF3_R2COp_RA,
+                                           APULPF3_R2COp_IMA,
+                                           APULPF3_R2COp_ABS};
+    const float complex scalar = CMPLXF(0.3f, -0.7f);
+    char name[64];
+
+    for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        int n = sizes[s];
+
+        for (int sp = 0; sp < 2; sp++)
+        {
+            float complex *A = a;
+            float complex *B = b;
+            float complex *R = r;
+            float complex dot;
+            float complex *D = &dot;
+            float complex scalarArg = scalar;
+            float complex *S = &scalarArg;
+
+            fill(a, n);
+            fill(b, n);
+            if (sp)
+            {
+                memcpy(MEM, a, n * sizeof(*a));
+                memcpy(MEM + n, b, n * sizeof(*b));
+                A = MEM;
+                B = MEM + n;
+                R = MEM + 2 * n;
+                D = MEM + 3 * n;
+                S = MEM + 3 * n;
+            }
+            APULPF3_ComplexVector va = {A, n};
+            APULPF3_ComplexVector vb = {B, n};
+            APULPF3_ComplexVector vr = {R, n};
+
+            for (int c = 0; c < 2; c++)
+            {
+                APULPF3_vectorMult(&va, &vb, c, &vr);
+                for (int i = 0; i < n; i++)
+                {
+                    ref[i] = product(a[i], b[i], c);
+                }
+                snprintf(name, sizeof(name), "mult%d sp%d", c, sp);
+                compare(name, R, ref, n, 1e-6);
+
+                APULPF3_dotProduct(&va, &vb, c, D);
+                double complex sum = 0;
+                for (int i = 0; i < n; i++)
+                {
+                    sum += product(a[i], b[i], c);
+                }
+                snprintf(name, sizeof(name), "dot%d sp%d", c, sp);
+                compare(name, D, &sum, 1, 1e-5 * (n > 8 ? n / 8 : 1));
+
+                APULPF3_vectorSum(&va, &vb, c, &vr);
+                for (int i = 0; i < n; i++)
+                {
+                    ref[i] = c ? (double complex)a[i] - b[i] : (double complex)a[i] + b[i];
+                }
+                snprintf(name, sizeof(name), "sum%d sp%d", c, sp);
+                compare(name, R, ref, n, 1e-6);
+
+                *S = scalar;
+                APULPF3_vectorScalarSum(&va, S, c, &vr);
+                for (int i = 0; i < n; i++)
+                {
+                    ref[i] = c ? (double complex)a[i] - scalar : (double complex)a[i] + scalar;
+                }
+                snprintf(name, sizeof(name), "scalarSum%d sp%d", c, sp);
+                compare(name, R, ref, n, 1e-6);
+            }
+
+            *S = scalar;
+            APULPF3_vectorScalarMult(&va, S, &vr);
+            for (int i = 0; i < n; i++)
+            {
+                ref[i] = (double complex)a[i] * scalar;
+            }
+            snprintf(name, sizeof(name), "scalarMult sp%d", sp);
+            compare(name, R, ref, n, 1e-6);
+
+            for (int min = 0; min < 2; min++)
+            {
+                APULPF3_vectorMaxMin(&va, 0.1f, min, &vr);
+                for (int i = 0; i < n; i++)
+                {
+                    ref[i] = min ? fmin(crealf(a[i]), 0.1f) : fmax(crealf(a[i]), 0.1f);
+                }
+                snprintf(name, sizeof(name), "maxMin%d sp%d", min, sp);
+                compare(name, R, ref, n, 0);
+            }
+
+            for (unsigned int op = 0; op < sizeof(r2cOps) / sizeof(r2cOps[0]); op++)
+            {
+                APULPF3_vectorR2C(&va, &vb, r2cOps[op], &vr);
+                snprintf(name, sizeof(name), "r2c%u sp%d", op, sp);
+                output(name, R, n);
+            }
+
+            APULPF3_cartesianToPolarVector(&va, &vr);
+            for (int i = 0; i < n; i++)
+            {
+                ref[i] = CMPLX(cabs((double complex)a[i]), carg((double complex)a[i]) / M_PI);
+            }
+            snprintf(name, sizeof(name), "cartesianToPolar sp%d", sp);
+            compare(name, R, ref, n, 1e-6);
+
+            if (!sp)
+            {
+                /* Back from polar form */
+                APULPF3_ComplexVector vt = {t, n};
+
+                memcpy(t, r, n * sizeof(*t));
+                APULPF3_polarToCartesianVector(&vt, NULL, &vr);
+                for (int i = 0; i < n; i++)
+                {
+                    ref[i] = a[i];
+                }
+                compare("polarToCartesian", r, ref, n, 1e-6);
+
+                memcpy(t, a, n * sizeof(*t));
+                APULPF3_sortVector(&vt, &vr);
+                for (int i = 1; i < n; i++)
+                {
+                    CHECK(crealf(r[i]) <= crealf(r[i - 1]), "sort of %d elements: element %d out of order", n, i);
+                }
+                output("sort", r, n);
+            }
+        }
+    }
+}
+
+static void checkFFT(void)
+{
+    for (int n = 1; n <= 1024; n *= 2)
+    {
+        APULPF3_ComplexVector va = {a, n};
+        APULPF3_ComplexVector vr = {r, n};
+
+        fill(a, n);
+        memcpy(t, a, n * sizeof(*t));
+        APULPF3_computeFFT(&va, false, &vr);
+        for (int k = 0; k < n; k++)
+        {
+            double complex sum = 0;
+            for (int i = 0; i < n; i++)
+            {
+                sum += (double complex)t[i] * cexp(-2 * M_PI * I * (double)((long)i * k % n) / n);
+            }
+            ref[k] = sum;
+        }
+        compare("fft", r, ref, n, 2e-6 * (log2(n) + 1));
+
+        memcpy(a, r, n * sizeof(*a));
+        APULPF3_computeFFT(&va, true, &vr);
+        for (int i = 0; i < n; i++)
+        {
+            ref[i] = t[i];
+        }
+        compare("ifft", r, ref, n, 2e-6 * (log2(n) + 1));
+    }
+
+    APULPF3_ComplexVector vr = {r, 100};
+
+    APULPF3_unitCircle(100, 7, 3, false, &vr);
+    for (int k = 0; k < 100; k++)
+    {
+        ref[k] = cexp(-2 * M_PI * I * ((k * 7 + 3) % 1024) / 1024.0);
+    }
+    compare("unitCircle", r, ref, 100, 1e-7);
+
+    APULPF3_unitCircle(100, 7, 3, true, &vr);
+    for (int k = 0; k < 100; k++)
+    {
+        ref[k] = conj(ref[k]);
+    }
+    compare("unitCircle conjugate", r, ref, 100, 1e-7);
+}
+
+static void checkMatrices(void)
+{
+    const float complex scalar = CMPLXF(-0.2f, 0.9f);
+
+    for (int M = 1; M <= 9; M += 4)
+    {
+        for (int K = 1; K <= 7; K += 3)
+        {
+            for (int N = 1; N <= 8; N += 3)
+            {
+                APULPF3_ComplexMatrix ma = {a, M, K};
+                APULPF3_ComplexMatrix mb = {b, K, N};
+                APULPF3_ComplexMatrix mr = {r, M, N};
+
+                fill(a, M * K);
+                fill(b, K * N);
+                memset(r, 0x7f, sizeof(r));
+                APULPF3_matrixMult(&ma, &mb, &mr);
+                for (int j = 0; j < N; j++)
+                {
+                    for (int i = 0; i < M; i++)
+                    {
+                        double complex sum = 0;
+                        for (int k = 0; k < K; k++)
+                        {
+                            sum += (double complex)a[k * M + i] * b[j * K + k];
+                        }
+                        ref[j * M + i] = sum;
+                    }
+                }
+                compare("matrixMult", r, ref, M * N, 1e-5);
+                CHECK(memcmp(&r[M * N], &r[1023], sizeof(r[0])) == 0, "matrixMult %dx%d * %dx%d wrote past the result",
+                      M, K, K, N);
+
+                APULPF3_ComplexMatrix mb2 = {b, M, K};
+                APULPF3_ComplexMatrix mr2 = {r, M, K};
+                float complex s           = scalar;
+
+                APULPF3_matrixSum(&ma, &mb2, &mr2);
+                for (int i = 0; i < M * K; i++)
+                {
+                    ref[i] = (double complex)a[i] + b[i];
+                }
+                compare("matrixSum", r, ref, M * K, 1e-6);
+
+                APULPF3_matrixScalarSum(&ma, &s, &mr2);
+                for (int i = 0; i < M * K; i++)
+                {
+                    ref[i] = (double complex)a[i] + scalar;
+                }
+                compare("matrixScalarSum", r, ref, M * K, 1e-6);
+
+                APULPF3_matrixScalarMult(&ma, &s, &mr2);
+                for (int i = 0; i < M * K; i++)
+                {
+                    ref[i] = (double complex)a[i] * scalar;
+                }
+                compare("matrixScalarMult", r, ref, M * K, 1e-6);
+
+                float complex norm;
+                double sum = 0;
+                APULPF3_matrixNorm(&ma, &norm);
+                for (int i = 0; i < M * K; i++)
+                {
+                    sum += pow(cabs((double complex)a[i]), 2);
+                }
+                double complex expected = sqrt(sum);
+                compare("matrixNorm", &norm, &expected, 1, 1e-6);
+            }
+        }
+    }
+}
+
+static void checkCovariance(void)
+{
+    static float complex lower[1024];
+    static float complex upper[1024];
+    static float complex evd[1024];
+    static double complex cov[16][16];
+    const int n = 40;
+
+    for (int L = 2; L <= 12; L += 5)
+    {
+        for (int fb = 0; fb < 2; fb++)
+        {
+            APULPF3_ComplexVector va          = {a, n};
+            APULPF3_ComplexTriangleMatrix tr  = {r, L};
+            APULPF3_ComplexTriangleMatrix tlo = {lower, L};
+            APULPF3_ComplexVector vevd        = {evd, 0};
+            int K                             = n - L + 1;
+            int size                          = 0;
+
+            fill(a, n);
+            memset(r, 0x7f, sizeof(r));
+            APULPF3_covMatrixSpatialSmoothing(&va, L, fb, &tr);
+            for (int i = 0; i < L; i++)
+            {
+                for (int j = 0; j < L; j++)
+                {
+                    double complex sum = 0;
+                    for (int k = 0; k < K; k++)
+                    {
+                        sum += (double complex)a[k + i] * conj((double complex)a[k + j]);
+                    }
+                    cov[i][j] = sum / K;
+                }
+            }
+            for (int j = 0; j < L; j++)
+            {
+                for (int i = 0; i <= j; i++)
+                {
+                    ref[size++] = fb ? 0.5 * (cov[i][j] + conj(cov[L - 1 - i][L - 1 - j])) : cov[i][j];
+                }
+            }
+            compare("covMatrix", r, ref, size, 1e-5);
+            CHECK(memcmp(&r[size], &r[1023], sizeof(r[0])) == 0, "covMatrix L = %d wrote past the triangle", L);
+
+            APULPF3_HermLo(&tr, &tlo);
+            size = 0;
+            for (int j = 0; j < L; j++)
+            {
+                for (int i = j; i < L; i++)
+                {
+                    ref[size++] = conj((double complex)r[i * (i + 1) / 2 + j]);
+                }
+            }
+            compare("HermLo", lower, ref, size, 0);
+
+            /* The EVD overwrites its input */
+            memcpy(upper, r, size * sizeof(*r));
+            APULPF3_jacobiEVD(&tr, 100, 1e-7f, 1e-9f, &vevd);
+            int vectors = (L * L + L) / 2;
+            CHECK(vevd.size == L * L + vectors, "jacobiEVD L = %d: result size %d", L, vevd.size);
+
+            double maxError = 0;
+            for (int k = 0; k < L; k++)
+            {
+                double lambda = crealf(evd[k * (k + 1) / 2 + k]);
+
+                CHECK(k == 0 || lambda <= crealf(evd[(k - 1) * k / 2 + k - 1]) + 1e-6,
+                      "jacobiEVD L = %d: eigenvalue %d out of order", L, k);
+                for (int i = 0; i < L; i++)
+                {
+                    double complex sum = 0;
+                    for (int m = 0; m < L; m++)
+                    {
+                        double complex element = (i <= m) ? (double complex)upper[m * (m + 1) / 2 + i]
+                                                          : conj((double complex)upper[i * (i + 1) / 2 + m]);
+                        sum += element * evd[vectors + k * L + m];
+                    }
+                    maxError = fmax(maxError, cabs(sum - lambda * (double complex)evd[vectors + k * L + i]));
+                }
+            }
+            CHECK(maxError <= 1e-4, "jacobiEVD L = %d: residual %g", L, maxError);
+            output("jacobiEVD", evd, vevd.size);
+        }
+    }
+}
+
+static void checkGaussJordan(void)
+{
+    const int M = 4;
+    const int N = 6;
+    static const int pivots[4] = {0, 1, 2, 4};
+    APULPF3_ComplexMatrix m  = {a, M, N};
+    APULPF3_ComplexMatrix mr = {r, M, N};
+
+    /* Column 3 is twice column 0 */
+    fill(a, M * N);
+    for (int i = 0; i < M; i++)
+    {
+        a[3 * M + i] = a[i] * 2.0f;
+    }
+    APULPF3_gaussJordanElim(&m, 1e-5f, &mr);
+    output("gaussJordan", r, M * N);
+
+    for (int k = 0; k < 4; k++)
+    {
+        for (int i = 0; i < M; i++)
+        {
+            CHECK(cabsf(r[pivots[k] * M + i] - (i == k)) <= 1e-5, "gaussJordan pivot column %d row %d", pivots[k],
+                  i);
+        }
+    }
+    for (int i = 0; i < M; i++)
+    {
+        CHECK(cabsf(r[3 * M + i] - (i == 0 ? 2.0f : 0.0f)) <= 1e-4, "gaussJordan dependent column row %d", i);
+    }
+}
+
+static double nsSince(const struct timespec *start, int count)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (((end.tv_sec - start->tv_sec) * 1e9 + (end.tv_nsec - start->tv_nsec)) / count);
+}
+
+#define BENCH(name, call, repeats)                                                      \
+    do                                                                                  \
+    {                                                                                   \
+        struct timespec start;                                                          \
+        clock_gettime(CLOCK_MONOTONIC, &start);                                         \
+        for (int rep = 0; rep < (repeats); rep++)                                       \
+        {                                                                               \
+            call;                                                                       \
+        }                                                                               \
+        printf("%-8s %-12s %9.1f ns\n", APULPF3EmuKernels_isa(), name, nsSince(&start, repeats)); \
+    } while (0)
+
+static void bench(void)
+{
+    static float complex triangle[1024];
+    float complex dot;
+
+    for (int i = 0; i < 512; i++)
+    {
+        a[i] = i * 0.001f + I * 0.5f;
+        b[i] = 1.0f - I * i * 0.002f;
+    }
+
+    APULPF3_ComplexVector va  = {a, 256};
+    APULPF3_ComplexVector vb  = {b, 256};
+    APULPF3_ComplexVector vr  = {r, 256};
+    APULPF3_ComplexVector vf  = {a, 512};
+    APULPF3_ComplexVector vfr = {r, 512};
+    APULPF3_ComplexVector vc  = {a, 80};
+    APULPF3_ComplexTriangleMatrix tr = {triangle, 16};
+    APULPF3_ComplexMatrix ma  = {a, 16, 16};
+    APULPF3_ComplexMatrix mb  = {b, 16, 16};
+    APULPF3_ComplexMatrix mr  = {r, 16, 16};
+
+    BENCH("mult 256", APULPF3_vectorMult(&va, &vb, true, &vr), 200000);
+    BENCH("dot 256", APULPF3_dotProduct(&va, &vb, true, &dot), 200000);
+    BENCH("FFT 512", APULPF3_computeFFT(&vf, false, &vfr), 20000);
+    BENCH("cov 80/16", APULPF3_covMatrixSpatialSmoothing(&vc, 16, true, &tr), 20000);
+    BENCH("mmul 16x16", APULPF3_matrixMult(&ma, &mb, &mr), 20000);
+}
+
+int main(int argc, char *argv[])
+{
+    dump = fopen((argc > 1) ? argv[1] : "/dev/null", "wb");
+    if (dump == NULL)
+    {
+        perror(argv[1]);
+        return (1);
+    }
+
+    APULPF3_init();
+    checkVectors();
+    checkFFT();
+    checkMatrices();
+    checkCovariance();
+    checkGaussJordan();
+    fclose(dump);
+    if (failures != 0)
+    {
+        printf("%d failures\n", failures);
+        return (1);
+    }
+    printf("%s: checks passed\n", APULPF3EmuKernels_isa());
+    bench();
+    return (0);
+}
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== apusequencetest.c ========
+ *
+ * Check and benchmark of the APULPF3 operation sequences on the host
+ * emulation of the APU.
+ *
+ * Two pipelines are run as sequences and as the same operations called one
+ * by one, and the results are compared byte for byte:
+ *
+ * - FFT of 256 points, conversion to polar form and thresholding
+ * - covariance matrix of 80 samples with L = 16 and Jacobi EVD
+ *
+ * Invalid sequences, including ones that reach into the firmware heap
+ * above #APULPF3_SEQUENCE_MEM_SIZE, must be rejected by
+ * APULPF3_validateSequence() and APULPF3_runSequence().  The benchmark
+ * prints the time per pipeline run both ways; on the host copies to and
+ * from APU memory are nearly free, so it mainly checks that sequences
+ * add no overhead.
+ *
+ * Usage:
+ *
+ *     apusequencetest
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <complex.h>
+
+#include <ti/drivers/apu/APULPF3.h>
+
+#define FFT_SIZE   256
+#define NUM_SAMPLE 80
+#define L          16
+#define TRIANGLE   (L * (L + 1) / 2)
+
+#define CHECK(cond, ...)                                       \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            failures++;                                        \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__);        \
+            printf(__VA_ARGS__);                               \
+            printf("\n");                                      \
+        }                                                      \
+    } while (0)
+
+static int failures;
+static uint32_t randomState = 7;
+
+static float randomFloat(void)
+{
+    randomState = randomState * 1103515245U + 12345U;
+    return (((randomState >> 8) & 0xFFFF) / 32768.0f - 1.0f);
+}
+
+static double usSince(const struct timespec *start, int count)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (((end.tv_sec - start->tv_sec) * 1e6 + (end.tv_nsec - start->tv_nsec) / 1e3) / count);
+}
+
+/* FFT -> cartesian to polar -> max/min */
+static const APULPF3_SequenceStep fftSteps[] = {
+    APULPF3_SEQ_FFT(0, FFT_SIZE, false),
+    APULPF3_SEQ_CARTESIAN_TO_POLAR(0, FFT_SIZE, FFT_SIZE),
+    APULPF3_SEQ_VECTOR_MAX_MIN(FFT_SIZE, FFT_SIZE, 0.5f, false, 2 * FFT_SIZE),
+};
+
+static APULPF3_Sequence fftSequence = {
+    .steps        = fftSteps,
+    .numSteps     = 3,
+    .inputOffset  = 0,
+    .inputSize    = FFT_SIZE,
+    .outputOffset = 2 * FFT_SIZE,
+    .outputSize   = FFT_SIZE,
+};
+
+/* Covariance matrix -> Jacobi EVD -> Frobenius norm of the eigenvectors */
+static const APULPF3_SequenceStep evdSteps[] = {
+    APULPF3_SEQ_COV_MATRIX(0, NUM_SAMPLE, L, true, NUM_SAMPLE),
+    APULPF3_SEQ_JACOBI_EVD(NUM_SAMPLE, L, 30, 1e-6f, 1e-9f, NUM_SAMPLE + TRIANGLE),
+    APULPF3_SEQ_MATRIX_NORM(NUM_SAMPLE + TRIANGLE, L, L, 0),
+};
+
+static APULPF3_Sequence evdSequence = {
+    .steps        = evdSteps,
+    .numSteps     = 3,
+    .inputOffset  = 0,
+    .inputSize    = NUM_SAMPLE,
+    .outputOffset = NUM_SAMPLE + TRIANGLE,
+    .outputSize   = L * L,
+};
+
+static float complex fftInput[FFT_SIZE];
+static float complex evdInput[NUM_SAMPLE];
+
+static void runFftUnchained(float complex *out)
+{
+    static float complex work[FFT_SIZE];
+    static float complex polar[FFT_SIZE];
+    APULPF3_ComplexVector vWork   = {work, FFT_SIZE};
+    APULPF3_ComplexVector vPolar  = {polar, FFT_SIZE};
+    APULPF3_ComplexVector vResult = {out, FFT_SIZE};
+
+    memcpy(work, fftInput, sizeof(work));
+    APULPF3_computeFFT(&vWork, false, &vWork);
+    APULPF3_cartesianToPolarVector(&vWork, &vPolar);
+    APULPF3_vectorMaxMin(&vPolar, 0.5f, false, &vResult);
+}
+
+/* The eigenvectors follow the eigenvalues in the result */
+static void runEvdUnchained(float complex *out)
+{
+    static float complex triangle[TRIANGLE];
+    APULPF3_ComplexVector vInput               = {evdInput, NUM_SAMPLE};
+    APULPF3_ComplexTriangleMatrix mCovariance = {triangle, L};
+    APULPF3_ComplexVector vResult              = {out, 0};
+
+    APULPF3_covMatrixSpatialSmoothing(&vInput, L, true, &mCovariance);
+    APULPF3_jacobiEVD(&mCovariance, 30, 1e-6f, 1e-9f, &vResult);
+}
+
+static void checkPipelines(void)
+{
+    static float complex chained[FFT_SIZE];
+    static float complex unchained[L * L + TRIANGLE];
+
+    CHECK(APULPF3_validateSequence(&fftSequence) == APULPF3_STATUS_SUCCESS, "FFT sequence rejected");
+    CHECK(APULPF3_runSequence(&fftSequence, fftInput, chained) == APULPF3_STATUS_SUCCESS, "FFT sequence failed");
+    runFftUnchained(unchained);
+    CHECK(memcmp(chained, unchained, FFT_SIZE * sizeof(float complex)) == 0, "FFT sequence result differs");
+
+    CHECK(APULPF3_validateSequence(&evdSequence) == APULPF3_STATUS_SUCCESS, "EVD sequence rejected");
+    CHECK(APULPF3_runSequence(&evdSequence, evdInput, chained) == APULPF3_STATUS_SUCCESS, "EVD sequence failed");
+    runEvdUnchained(unchained);
+    CHECK(memcmp(chained, &unchained[TRIANGLE], L * L * sizeof(float complex)) == 0, "EVD sequence result differs");
+}
+
+static void checkInvalidSequences(void)
+{
+    static float complex out[FFT_SIZE];
+    /* Operand never written */
+    static const APULPF3_SequenceStep undefinedOperand[] = {APULPF3_SEQ_CARTESIAN_TO_POLAR(300, 10, 400)};
+    /* Result overlapping the operand of an operation that is not in place */
+    static const APULPF3_SequenceStep overlap[] = {APULPF3_SEQ_CARTESIAN_TO_POLAR(0, 10, 5)};
+    /* FFT size not a power of 2 */
+    static const APULPF3_SequenceStep fftSize[] = {APULPF3_SEQ_FFT(0, 12, false)};
+    /* Result reaching into the firmware heap */
+    static const APULPF3_SequenceStep heap[] = {
+        APULPF3_SEQ_CARTESIAN_TO_POLAR(0, 10, APULPF3_SEQUENCE_MEM_SIZE - 9)};
+    /* Eigenvectors overlapping the 10 element triangle */
+    static const APULPF3_SequenceStep evd[] = {APULPF3_SEQ_JACOBI_EVD(0, 4, 10, 0, 0, 5)};
+    /* Scalar operand inside the input */
+    static const APULPF3_SequenceStep scalar[] = {APULPF3_SEQ_VECTOR_SCALAR_MULT(0, 10, 2.0f, 5, 20)};
+    /* Matrices larger than APU memory */
+    static const APULPF3_SequenceStep matrix[] = {APULPF3_SEQ_MATRIX_MULT(0, 0, 300, 300, 300, 0)};
+    static const APULPF3_SequenceStep *const invalid[] = {undefinedOperand, overlap, fftSize, heap, evd, scalar, matrix};
+    /* Same as heap, ending just below the firmware heap */
+    static const APULPF3_SequenceStep belowHeap[] = {
+        APULPF3_SEQ_CARTESIAN_TO_POLAR(0, 10, APULPF3_SEQUENCE_MEM_SIZE - 10)};
+
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+    {
+        APULPF3_Sequence sequence = {
+            .steps        = invalid[i],
+            .numSteps     = 1,
+            .inputOffset  = 0,
+            .inputSize    = 10,
+            .outputOffset = 0,
+            .outputSize   = 1,
+        };
+
+        CHECK(APULPF3_validateSequence(&sequence) != APULPF3_STATUS_SUCCESS, "invalid sequence %zu accepted", i);
+        CHECK(APULPF3_runSequence(&sequence, fftInput, out) != APULPF3_STATUS_SUCCESS, "invalid sequence %zu run", i);
+    }
+
+    APULPF3_Sequence sequence = {
+        .steps        = belowHeap,
+        .numSteps     = 1,
+        .inputOffset  = 0,
+        .inputSize    = 10,
+        .outputOffset = APULPF3_SEQUENCE_MEM_SIZE - 10,
+        .outputSize   = 10,
+    };
+    CHECK(APULPF3_validateSequence(&sequence) == APULPF3_STATUS_SUCCESS, "sequence below the firmware heap rejected");
+
+    /* Output never written by the sequence */
+    sequence              = fftSequence;
+    sequence.outputOffset = 3 * FFT_SIZE;
+    sequence.outputSize   = 1;
+    CHECK(APULPF3_validateSequence(&sequence) != APULPF3_STATUS_SUCCESS, "undefined output accepted");
+
+    /* The firmware heap is the top of APU memory, as in driverlib apu.c */
+    CHECK(APULPF3_SEQUENCE_MEM_SIZE == 974, "APULPF3_SEQUENCE_MEM_SIZE is %u", (unsigned)APULPF3_SEQUENCE_MEM_SIZE);
+}
+
+static void bench(void)
+{
+    static float complex out[L * L + TRIANGLE];
+    struct timespec start;
+    double chained;
+    double unchained;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int n = 0; n < 20000; n++)
+    {
+        APULPF3_runSequence(&fftSequence, fftInput, out);
+    }
+    chained = usSince(&start, 20000);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int n = 0; n < 20000; n++)
+    {
+        runFftUnchained(out);
+    }
+    unchained = usSince(&start, 20000);
+    printf("FFT %d -> polar -> max: %.2f us chained, %.2f us unchained\n", FFT_SIZE, chained, unchained);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int n = 0; n < 2000; n++)
+    {
+        APULPF3_runSequence(&evdSequence, evdInput, out);
+    }
+    chained = usSince(&start, 2000);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int n = 0; n < 2000; n++)
+    {
+        runEvdUnchained(out);
+    }
+    unchained = usSince(&start, 2000);
+    printf("covariance %d/L=%d -> EVD: %.2f us chained, %.2f us unchained\n", NUM_SAMPLE, L, chained, unchained);
+}
+
+int main(void)
+{
+    for (int i = 0; i < FFT_SIZE; i++)
+    {
+        fftInput[i] = CMPLXF(randomFloat(), randomFloat());
+    }
+    for (int i = 0; i < NUM_SAMPLE; i++)
+    {
+        evdInput[i] = CMPLXF(randomFloat(), randomFloat());
+    }
+
+    APULPF3_init();
+    APULPF3_startOperationSequence();
+    checkPipelines();
+    checkInvalidSequences();
+    if (failures != 0)
+    {
+        APULPF3_stopOperationSequence();
+        printf("%d failures\n", failures);
+        return (1);
+    }
+    printf("checks passed\n");
+    bench();
+    APULPF3_stopOperationSequence();
+    return (0);
+}
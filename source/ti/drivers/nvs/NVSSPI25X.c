@@ -40,6 +40,7 @@
 #include <string.h>
 #include <stdlib.h>
 
+#include <ti/drivers/dpl/DebugP.h>
 #include <ti/drivers/dpl/HwiP.h>
 #include <ti/drivers/dpl/SemaphoreP.h>
 #include <ti/drivers/dpl/ClockP.h>
@@ -74,9 +75,14 @@
 /* Size of hardware sector erased by SPIFLASH_SECTOR_ERASE */
 #define SPIFLASH_SECTOR_SIZE 0x10000
 
+static int_fast16_t bufferedWrite(NVS_Handle handle, size_t offset, const uint8_t *src, size_t size);
 static int_fast16_t checkEraseRange(NVS_Handle handle, size_t offset, size_t size);
 static int_fast16_t doErase(NVS_Handle handle, size_t offset, size_t size);
+static int_fast16_t doProgram(NVS_Handle handle, size_t offset, const uint8_t *src, size_t size);
 static int_fast16_t doRead(NVS_Handle handle, size_t offset, void *buffer, size_t bufferSize);
+static int_fast16_t eraseAheadService(NVS_Handle handle);
+static int_fast16_t eraseAheadSync(NVS_Handle handle, size_t offset, size_t size);
+static int_fast16_t flushWriteBuf(NVS_Handle handle);
 static int_fast16_t doWriteVerify(NVS_Handle handle,
                                   size_t offset,
                                   void *src,
@@ -89,6 +95,7 @@ static int_fast16_t extFlashSpiWrite(const uint8_t *buf, size_t len);
 static int_fast16_t extFlashSpiRead(uint8_t *buf, size_t len);
 static int_fast16_t extFlashPowerDown(NVS_Handle nvsHandle);
 static int_fast16_t extFlashPowerStandby(NVS_Handle nvsHandle);
+static int_fast16_t extFlashReadStatus(NVS_Handle nvsHandle, uint8_t *status);
 static int_fast16_t extFlashWaitReady(NVS_Handle nvsHandle);
 static int_fast16_t extFlashWriteEnable(NVS_Handle nvsHandle);
 static int_fast16_t extFlashMassErase(NVS_Handle nvsHandle);
@@ -131,6 +138,7 @@ void NVSSPI25X_close(NVS_Handle handle)
 {
     NVSSPI25X_HWAttrs const *hwAttrs;
     NVSSPI25X_Object *object;
+    int_fast16_t status;
 
     SemaphoreP_pend(writeSem, SemaphoreP_WAIT_FOREVER);
 
@@ -140,6 +148,19 @@ void NVSSPI25X_close(NVS_Handle handle)
     spiHandle       = object->spiHandle;
     spiCsnGpioIndex = hwAttrs->spiCsnGpioIndex;
 
+    /*
+     * Program buffered data and complete the queued erases. Close cannot
+     * report an error, so flush first where data must not be lost.
+     */
+    status = flushWriteBuf(handle);
+    DebugP_assert(status == NVS_STATUS_SUCCESS);
+    if (object->eraseAheadEnd != 0)
+    {
+        status = doErase(handle, object->eraseAheadOffset, object->eraseAheadEnd - object->eraseAheadOffset);
+        DebugP_assert(status == NVS_STATUS_SUCCESS);
+    }
+    (void)status;
+
     /* Close the SPI if we opened it */
     if (hwAttrs->spiHandle == NULL)
     {
@@ -173,20 +194,77 @@ int_fast16_t NVSSPI25X_control(NVS_Handle handle, uint_fast16_t cmd, uintptr_t a
 {
     NVSSPI25X_HWAttrs const *hwAttrs;
     NVSSPI25X_Object *object;
+    NVSSPI25X_EraseAheadArgs *eraseArgs;
+    int_fast16_t status;
+
+    hwAttrs = handle->hwAttrs;
+    object  = handle->object;
 
-    if (cmd != NVSSPI25X_CMD_MASS_ERASE)
+    if (cmd == NVSSPI25X_CMD_MASS_ERASE)
+    {
+        /* Set protected global variables */
+        spiHandle       = object->spiHandle;
+        spiCsnGpioIndex = hwAttrs->spiCsnGpioIndex;
+
+        /* Everything buffered or queued is about to be erased */
+        object->writeBufEnd      = 0;
+        object->eraseAheadOffset = 0;
+        object->eraseAheadEnd    = 0;
+
+        return (extFlashMassErase(handle));
+    }
+
+    if ((cmd != NVSSPI25X_CMD_FLUSH) && (cmd != NVSSPI25X_CMD_ERASE_AHEAD))
     {
         return (NVS_STATUS_UNDEFINEDCMD);
     }
 
-    hwAttrs = handle->hwAttrs;
-    object  = handle->object;
+    SemaphoreP_pend(writeSem, SemaphoreP_WAIT_FOREVER);
 
     /* Set protected global variables */
     spiHandle       = object->spiHandle;
     spiCsnGpioIndex = hwAttrs->spiCsnGpioIndex;
 
-    return (extFlashMassErase(handle));
+    if (cmd == NVSSPI25X_CMD_FLUSH)
+    {
+        status = flushWriteBuf(handle);
+
+        /* Wait for the page program to complete */
+        if (status == NVS_STATUS_SUCCESS)
+        {
+            status = extFlashWaitReady(handle);
+        }
+    }
+    else
+    {
+        eraseArgs = (NVSSPI25X_EraseAheadArgs *)arg;
+        status    = NVS_STATUS_SUCCESS;
+
+        if ((eraseArgs != NULL) && (eraseArgs->size == 0))
+        {
+            object->eraseAheadOffset = 0;
+            object->eraseAheadEnd    = 0;
+        }
+        else if (eraseArgs != NULL)
+        {
+            status = checkEraseRange(handle, eraseArgs->offset, eraseArgs->size);
+
+            if (status == NVS_STATUS_SUCCESS)
+            {
+                object->eraseAheadOffset = eraseArgs->offset;
+                object->eraseAheadEnd    = eraseArgs->offset + eraseArgs->size;
+            }
+        }
+    }
+
+    if (status == NVS_STATUS_SUCCESS)
+    {
+        status = eraseAheadService(handle);
+    }
+
+    SemaphoreP_post(writeSem);
+
+    return (status);
 }
 
 /*
@@ -194,12 +272,23 @@ int_fast16_t NVSSPI25X_control(NVS_Handle handle, uint_fast16_t cmd, uintptr_t a
  */
 int_fast16_t NVSSPI25X_erase(NVS_Handle handle, size_t offset, size_t size)
 {
+    NVSSPI25X_HWAttrs const *hwAttrs;
+    NVSSPI25X_Object *object;
     int_fast16_t status;
 
+    hwAttrs = handle->hwAttrs;
+    object  = handle->object;
+
     SemaphoreP_pend(writeSem, SemaphoreP_WAIT_FOREVER);
 
+    /* Set protected global variables */
+    spiHandle       = object->spiHandle;
+    spiCsnGpioIndex = hwAttrs->spiCsnGpioIndex;
+
     status = doErase(handle, offset, size);
 
+    eraseAheadService(handle);
+
     SemaphoreP_post(writeSem);
 
     return (status);
@@ -309,6 +398,10 @@ NVS_Handle NVSSPI25X_open(uint_least8_t index, NVS_Params *params)
     sectorSize             = hwAttrs->sectorSize;
     object->sectorBaseMask = ~(sectorSize - 1);
 
+    object->writeBufEnd      = 0;
+    object->eraseAheadOffset = 0;
+    object->eraseAheadEnd    = 0;
+
     /* The regionBase must be aligned on a flash page boundary */
     if ((hwAttrs->regionBaseOffset) & (sectorSize - 1))
     {
@@ -391,9 +484,11 @@ NVS_Handle NVSSPI25X_open(uint_least8_t index, NVS_Params *params)
 int_fast16_t NVSSPI25X_read(NVS_Handle handle, size_t offset, void *buffer, size_t bufferSize)
 {
     NVSSPI25X_HWAttrs const *hwAttrs;
+    NVSSPI25X_Object *object;
     int retval = NVS_STATUS_SUCCESS;
 
     hwAttrs = handle->hwAttrs;
+    object  = handle->object;
 
     /* Validate offset and bufferSize */
     if (offset + bufferSize > hwAttrs->regionSize)
@@ -407,7 +502,18 @@ int_fast16_t NVSSPI25X_read(NVS_Handle handle, size_t offset, void *buffer, size
      */
     SemaphoreP_pend(writeSem, SemaphoreP_WAIT_FOREVER);
 
-    retval = doRead(handle, offset, buffer, bufferSize);
+    /* Set protected global variables */
+    spiHandle       = object->spiHandle;
+    spiCsnGpioIndex = hwAttrs->spiCsnGpioIndex;
+
+    retval = eraseAheadSync(handle, offset, bufferSize);
+
+    if (retval == NVS_STATUS_SUCCESS)
+    {
+        retval = doRead(handle, offset, buffer, bufferSize);
+    }
+
+    eraseAheadService(handle);
 
     SemaphoreP_post(writeSem);
 
@@ -429,11 +535,8 @@ int_fast16_t NVSSPI25X_write(NVS_Handle handle, size_t offset, void *buffer, siz
 {
     NVSSPI25X_Object *object;
     NVSSPI25X_HWAttrs const *hwAttrs;
-    size_t length, foffset;
-    uint32_t status = true;
-    uint8_t *srcBuf;
+    size_t length;
     int retval = NVS_STATUS_SUCCESS;
-    uint8_t wbuf[4];
 
     hwAttrs = handle->hwAttrs;
     object  = handle->object;
@@ -451,6 +554,33 @@ int_fast16_t NVSSPI25X_write(NVS_Handle handle, size_t offset, void *buffer, siz
     spiHandle       = object->spiHandle;
     spiCsnGpioIndex = hwAttrs->spiCsnGpioIndex;
 
+    /* Queued erases of the destination must happen before the write */
+    retval = eraseAheadSync(handle, offset, bufferSize);
+    if (retval != NVS_STATUS_SUCCESS)
+    {
+        SemaphoreP_post(writeSem);
+        return (retval);
+    }
+
+    /* Small writes without flags are combined in the write buffer */
+    if ((flags == 0) && (hwAttrs->writeBuf != NULL))
+    {
+        retval = bufferedWrite(handle, offset, buffer, bufferSize);
+
+        eraseAheadService(handle);
+
+        SemaphoreP_post(writeSem);
+        return (retval);
+    }
+
+    /* Verification and erase operate on the programmed flash contents */
+    retval = flushWriteBuf(handle);
+    if (retval != NVS_STATUS_SUCCESS)
+    {
+        SemaphoreP_post(writeSem);
+        return (retval);
+    }
+
     /* If erase is set, erase destination sector(s) first */
     if (flags & NVS_WRITE_ERASE)
     {
@@ -484,88 +614,116 @@ int_fast16_t NVSSPI25X_write(NVS_Handle handle, size_t offset, void *buffer, siz
         }
     }
 
-    srcBuf  = buffer;
-    length  = bufferSize;
-    foffset = (size_t)hwAttrs->regionBaseOffset + offset;
+    retval = doProgram(handle, offset, buffer, bufferSize);
 
-    while (length > 0)
+    if ((retval == NVS_STATUS_SUCCESS) && (flags & NVS_WRITE_POST_VERIFY))
     {
-        size_t ilen; /* Interim length per instruction */
-
-        /* Wait till previous erase/program operation completes */
-        int ret = extFlashWaitReady(handle);
-
-        if (ret)
+        if ((hwAttrs->verifyBuf == NULL) || (hwAttrs->verifyBufSize == 0))
         {
-            status = false;
-            break;
+            SemaphoreP_post(writeSem);
+            return (NVS_STATUS_VERIFYBUFFER);
         }
 
-        ret = extFlashWriteEnable(handle);
+        retval = doWriteVerify(handle, offset, buffer, bufferSize, hwAttrs->verifyBuf, hwAttrs->verifyBufSize, false);
+    }
 
-        if (ret)
-        {
-            status = false;
-            break;
-        }
+    eraseAheadService(handle);
 
-        ilen = SPIFLASH_PROGRAM_PAGE_SIZE - (foffset % SPIFLASH_PROGRAM_PAGE_SIZE);
-        if (length < ilen)
+    SemaphoreP_post(writeSem);
+
+    return (retval);
+}
+
+/*
+ *  ======== bufferedWrite =======
+ *  Write through the write buffer. Flash programming ANDs bits, and
+ *  programming 0xFF leaves a byte unchanged, so writes to the buffered page
+ *  are merged into a buffer initialized to 0xFF and only the range spanned
+ *  by the merged writes is programmed.
+ */
+static int_fast16_t bufferedWrite(NVS_Handle handle, size_t offset, const uint8_t *src, size_t size)
+{
+    NVSSPI25X_Object *object;
+    NVSSPI25X_HWAttrs const *hwAttrs;
+    size_t page, start, ilen, i;
+    int_fast16_t status;
+
+    hwAttrs = handle->hwAttrs;
+    object  = handle->object;
+
+    while (size > 0)
+    {
+        /* Page offsets are relative to the region, which is page aligned */
+        page  = offset & ~((size_t)NVSSPI25X_WRITE_BUF_SIZE - 1);
+        start = offset - page;
+        ilen  = NVSSPI25X_WRITE_BUF_SIZE - start;
+        if (size < ilen)
         {
-            ilen = length;
+            ilen = size;
         }
 
-        wbuf[0] = SPIFLASH_WRITE;
-        wbuf[1] = (foffset >> 16) & 0xff;
-        wbuf[2] = (foffset >> 8) & 0xff;
-        wbuf[3] = foffset & 0xff;
-
-        foffset += ilen;
-        length -= ilen;
+        if ((object->writeBufEnd == 0) || (object->writeBufOffset != page))
+        {
+            /* Earlier writes to another page reach the flash first */
+            status = flushWriteBuf(handle);
+            if (status != NVS_STATUS_SUCCESS)
+            {
+                return (status);
+            }
 
-        /*
-         * Up to 100ns CS hold time (which is not clear
-         * whether it's application only in between reads)
-         * is not imposed here since above instructions
-         * should be enough to delay
-         * as much.
-         */
-        NVSSPI25X_assertSpiCs(handle, spiCsnGpioIndex);
+            if (ilen == NVSSPI25X_WRITE_BUF_SIZE)
+            {
+                /* Nothing to combine with, program the whole page directly */
+                status = doProgram(handle, offset, src, ilen);
+                if (status != NVS_STATUS_SUCCESS)
+                {
+                    return (status);
+                }
+
+                offset += ilen;
+                src += ilen;
+                size -= ilen;
+                continue;
+            }
 
-        if (extFlashSpiWrite(wbuf, sizeof(wbuf)) != NVS_STATUS_SUCCESS)
+            memset(hwAttrs->writeBuf, 0xFF, NVSSPI25X_WRITE_BUF_SIZE);
+            object->writeBufOffset = page;
+            object->writeBufStart  = start;
+            object->writeBufEnd    = start + ilen;
+        }
+        else
         {
-            status = false;
-            break;
+            if (start < object->writeBufStart)
+            {
+                object->writeBufStart = start;
+            }
+            if (start + ilen > object->writeBufEnd)
+            {
+                object->writeBufEnd = start + ilen;
+            }
         }
 
-        if (extFlashSpiWrite(srcBuf, ilen) != NVS_STATUS_SUCCESS)
+        for (i = 0; i < ilen; i++)
         {
-            status = false;
-            break;
+            hwAttrs->writeBuf[start + i] &= src[i];
         }
 
-        srcBuf += ilen;
-        NVSSPI25X_deassertSpiCs(handle, spiCsnGpioIndex);
-    }
+        offset += ilen;
+        src += ilen;
+        size -= ilen;
 
-    if (status == false)
-    {
-        retval = NVS_STATUS_ERROR;
-    }
-    else if (flags & NVS_WRITE_POST_VERIFY)
-    {
-        if ((hwAttrs->verifyBuf == NULL) || (hwAttrs->verifyBufSize == 0))
+        /* Sequential writes have moved past this page */
+        if (start + ilen == NVSSPI25X_WRITE_BUF_SIZE)
         {
-            SemaphoreP_post(writeSem);
-            return (NVS_STATUS_VERIFYBUFFER);
+            status = flushWriteBuf(handle);
+            if (status != NVS_STATUS_SUCCESS)
+            {
+                return (status);
+            }
         }
-
-        retval = doWriteVerify(handle, offset, buffer, bufferSize, hwAttrs->verifyBuf, hwAttrs->verifyBufSize, false);
     }
 
-    SemaphoreP_post(writeSem);
-
-    return (retval);
+    return (NVS_STATUS_SUCCESS);
 }
 
 /*
@@ -659,6 +817,7 @@ static int_fast16_t doErase(NVS_Handle handle, size_t offset, size_t size)
     NVSSPI25X_Object *object;
     uint32_t sectorBase;
     size_t eraseSize;
+    size_t end;
     int_fast16_t rangeStatus;
     uint8_t wbuf[4];
 
@@ -679,6 +838,7 @@ static int_fast16_t doErase(NVS_Handle handle, size_t offset, size_t size)
 
     /* Start erase at this address */
     sectorBase = (uint32_t)hwAttrs->regionBaseOffset + offset;
+    end        = offset + size;
 
     while (size)
     {
@@ -727,6 +887,88 @@ static int_fast16_t doErase(NVS_Handle handle, size_t offset, size_t size)
         size -= eraseSize;
     }
 
+    /* Drop buffered data of the erased sectors */
+    if ((object->writeBufEnd != 0) && (object->writeBufOffset >= offset) && (object->writeBufOffset < end))
+    {
+        object->writeBufEnd = 0;
+    }
+
+    /* Remove the erased sectors from the head of the erase ahead queue */
+    if ((object->eraseAheadEnd != 0) && (object->eraseAheadOffset >= offset) && (object->eraseAheadOffset < end))
+    {
+        object->eraseAheadOffset = end;
+        if (object->eraseAheadOffset >= object->eraseAheadEnd)
+        {
+            object->eraseAheadOffset = 0;
+            object->eraseAheadEnd    = 0;
+        }
+    }
+
+    return (NVS_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== doProgram =======
+ *  Program the flash page by page
+ */
+static int_fast16_t doProgram(NVS_Handle handle, size_t offset, const uint8_t *src, size_t size)
+{
+    NVSSPI25X_HWAttrs const *hwAttrs;
+    size_t ilen; /* Interim length per instruction */
+    size_t foffset;
+    uint8_t wbuf[4];
+
+    hwAttrs = handle->hwAttrs;
+
+    foffset = (size_t)hwAttrs->regionBaseOffset + offset;
+
+    while (size > 0)
+    {
+        /* Wait till previous erase/program operation completes */
+        if (extFlashWaitReady(handle))
+        {
+            return (NVS_STATUS_ERROR);
+        }
+
+        if (extFlashWriteEnable(handle))
+        {
+            return (NVS_STATUS_ERROR);
+        }
+
+        ilen = SPIFLASH_PROGRAM_PAGE_SIZE - (foffset % SPIFLASH_PROGRAM_PAGE_SIZE);
+        if (size < ilen)
+        {
+            ilen = size;
+        }
+
+        wbuf[0] = SPIFLASH_WRITE;
+        wbuf[1] = (foffset >> 16) & 0xff;
+        wbuf[2] = (foffset >> 8) & 0xff;
+        wbuf[3] = foffset & 0xff;
+
+        foffset += ilen;
+        size -= ilen;
+
+        /*
+         * Up to 100ns CS hold time (which is not clear
+         * whether it's application only in between reads)
+         * is not imposed here since above instructions
+         * should be enough to delay
+         * as much.
+         */
+        NVSSPI25X_assertSpiCs(handle, spiCsnGpioIndex);
+
+        if ((extFlashSpiWrite(wbuf, sizeof(wbuf)) != NVS_STATUS_SUCCESS) ||
+            (extFlashSpiWrite(src, ilen) != NVS_STATUS_SUCCESS))
+        {
+            NVSSPI25X_deassertSpiCs(handle, spiCsnGpioIndex);
+            return (NVS_STATUS_ERROR);
+        }
+
+        src += ilen;
+        NVSSPI25X_deassertSpiCs(handle, spiCsnGpioIndex);
+    }
+
     return (NVS_STATUS_SUCCESS);
 }
 
@@ -779,9 +1021,127 @@ static int_fast16_t doRead(NVS_Handle handle, size_t offset, void *buffer, size_
 
     NVSSPI25X_deassertSpiCs(handle, spiCsnGpioIndex);
 
+    /* Overlay the buffered data, which is what the flash will contain */
+    if ((retval == NVS_STATUS_SUCCESS) && (object->writeBufEnd != 0))
+    {
+        size_t first, last, i;
+
+        first = object->writeBufOffset + object->writeBufStart;
+        last  = object->writeBufOffset + object->writeBufEnd;
+
+        if (first < offset)
+        {
+            first = offset;
+        }
+        if (last > offset + bufferSize)
+        {
+            last = offset + bufferSize;
+        }
+
+        for (i = first; i < last; i++)
+        {
+            ((uint8_t *)buffer)[i - offset] &= hwAttrs->writeBuf[i - object->writeBufOffset];
+        }
+    }
+
     return (retval);
 }
 
+/*
+ *  ======== eraseAheadService =======
+ *  Start erasing the next queued sector if the flash is idle
+ */
+static int_fast16_t eraseAheadService(NVS_Handle handle)
+{
+    NVSSPI25X_Object *object;
+    NVSSPI25X_HWAttrs const *hwAttrs;
+    size_t sectorBase;
+    size_t size;
+    uint8_t status;
+    int_fast16_t retval;
+
+    object  = handle->object;
+    hwAttrs = handle->hwAttrs;
+
+    if (object->eraseAheadEnd == 0)
+    {
+        return (NVS_STATUS_SUCCESS);
+    }
+
+    retval = extFlashReadStatus(handle, &status);
+    if ((retval != NVS_STATUS_SUCCESS) || (status & SPIFLASH_STATUS_BIT_BUSY))
+    {
+        return (retval);
+    }
+
+    /* Erase 64K at once where the queue allows it */
+    sectorBase = hwAttrs->regionBaseOffset + object->eraseAheadOffset;
+    size       = hwAttrs->sectorSize;
+    if ((object->eraseAheadEnd - object->eraseAheadOffset >= SPIFLASH_SECTOR_SIZE) &&
+        ((sectorBase & (SPIFLASH_SECTOR_SIZE - 1)) == 0))
+    {
+        size = SPIFLASH_SECTOR_SIZE;
+    }
+
+    return (doErase(handle, object->eraseAheadOffset, size));
+}
+
+/*
+ *  ======== eraseAheadSync =======
+ *  Erase the queued sectors up to the end of the given range
+ */
+static int_fast16_t eraseAheadSync(NVS_Handle handle, size_t offset, size_t size)
+{
+    NVSSPI25X_Object *object;
+    NVSSPI25X_HWAttrs const *hwAttrs;
+    size_t end;
+
+    object  = handle->object;
+    hwAttrs = handle->hwAttrs;
+
+    if ((object->eraseAheadEnd == 0) || (size == 0) || (offset >= object->eraseAheadEnd) ||
+        (offset + size <= object->eraseAheadOffset))
+    {
+        return (NVS_STATUS_SUCCESS);
+    }
+
+    /* Round up to the end of the last sector touched */
+    end = (offset + size + hwAttrs->sectorSize - 1) & object->sectorBaseMask;
+    if (end > object->eraseAheadEnd)
+    {
+        end = object->eraseAheadEnd;
+    }
+
+    return (doErase(handle, object->eraseAheadOffset, end - object->eraseAheadOffset));
+}
+
+/*
+ *  ======== flushWriteBuf =======
+ *  Program the buffered data. Does not wait for the program to complete.
+ */
+static int_fast16_t flushWriteBuf(NVS_Handle handle)
+{
+    NVSSPI25X_Object *object;
+    NVSSPI25X_HWAttrs const *hwAttrs;
+    size_t start, end;
+
+    object  = handle->object;
+    hwAttrs = handle->hwAttrs;
+
+    if (object->writeBufEnd == 0)
+    {
+        return (NVS_STATUS_SUCCESS);
+    }
+
+    start = object->writeBufStart;
+    end   = object->writeBufEnd;
+
+    /* The buffer is released even if programming fails */
+    object->writeBufEnd = 0;
+
+    return (doProgram(handle, object->writeBufOffset + start, &hwAttrs->writeBuf[start], end - start));
+}
+
 /*
  *  ======== extFlashPowerDown =======
  *  Issue power down command
@@ -850,13 +1210,29 @@ static int_fast16_t extFlashMassErase(NVS_Handle nvsHandle)
     return (extFlashWaitReady(nvsHandle));
 }
 
+/*
+ *  ======== extFlashReadStatus =======
+ *  Read the status register
+ */
+static int_fast16_t extFlashReadStatus(NVS_Handle nvsHandle, uint8_t *status)
+{
+    const uint8_t wbuf[1] = {SPIFLASH_READ_STATUS};
+    int_fast16_t ret;
+
+    NVSSPI25X_assertSpiCs(nvsHandle, spiCsnGpioIndex);
+    extFlashSpiWrite(wbuf, sizeof(wbuf));
+    ret = extFlashSpiRead(status, sizeof(*status));
+    NVSSPI25X_deassertSpiCs(nvsHandle, spiCsnGpioIndex);
+
+    return (ret);
+}
+
 /*
  *  ======== extFlashWaitReady =======
  *  Wait for any previous job to complete.
  */
 static int_fast16_t extFlashWaitReady(NVS_Handle nvsHandle)
 {
-    const uint8_t wbuf[1] = {SPIFLASH_READ_STATUS};
     int_fast16_t ret;
     uint8_t buf;
 
@@ -865,10 +1241,7 @@ static int_fast16_t extFlashWaitReady(NVS_Handle nvsHandle)
 
     for (;;)
     {
-        NVSSPI25X_assertSpiCs(nvsHandle, spiCsnGpioIndex);
-        extFlashSpiWrite(wbuf, sizeof(wbuf));
-        ret = extFlashSpiRead(&buf, sizeof(buf));
-        NVSSPI25X_deassertSpiCs(nvsHandle, spiCsnGpioIndex);
+        ret = extFlashReadStatus(nvsHandle, &buf);
 
         if (ret != NVS_STATUS_SUCCESS)
         {
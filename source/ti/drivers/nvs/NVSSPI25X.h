@@ -186,6 +186,58 @@
  *  @warning  All 4 of the above APIs must be provided by the user if this
  *  option is used, otherwise default internal implementations of the APIs
  *  will be called that will likely lead to application failure.
+ *
+ *  ## @anchor WRITE_BUF Write Buffer ##
+ *
+ *  Every page program keeps the SPI flash busy for a fixed setup time plus
+ *  a time per byte, so a sequence of small writes into the same page costs
+ *  far more than a single program of that page. If a region is given a
+ *  write buffer of #NVSSPI25X_WRITE_BUF_SIZE bytes in the
+ *  [writeBuf](@ref NVSSPI25X_HWAttrs.writeBuf) field, NVS_write() calls
+ *  without flags are collected in it and the buffered page is programmed
+ *  once a write reaches the end of the page, a write to another page
+ *  arrives, or the buffer is flushed. Writes that cover whole pages are
+ *  programmed directly, after the buffered page, so data always reaches
+ *  the flash in the order it was written.
+ *
+ *  NVS_read() returns the buffered data as if it had been programmed.
+ *  Writes with any of the NVS_WRITE_ERASE, NVS_WRITE_PRE_VERIFY or
+ *  NVS_WRITE_POST_VERIFY flags flush the buffer before they start and are
+ *  not buffered themselves. Buffered data is lost on a reset, so the
+ *  application must issue #NVSSPI25X_CMD_FLUSH (or close the region) at
+ *  the points where its data must be persistent. An error programming the
+ *  buffered page is returned by the call that programs it. NVS_close()
+ *  cannot return an error: it programs the buffered page and completes
+ *  the queued erases, and a failure there only trips a DebugP assert. Use
+ *  #NVSSPI25X_CMD_FLUSH before closing to see the status.
+ *
+ *  Each region needs its own write buffer.
+ *
+ *  ## @anchor ERASE_AHEAD Erase Ahead ##
+ *
+ *  A sector erase keeps the SPI flash busy for tens of milliseconds. An
+ *  application that knows which sectors it is about to fill, such as an
+ *  over-the-air download, can queue them with #NVSSPI25X_CMD_ERASE_AHEAD.
+ *  The driver then starts erasing the next queued sector whenever an
+ *  NVS API call on the region finds the flash idle at its end, without
+ *  waiting for the erase to complete, so erases overlap with the time the
+ *  application spends between calls. A read or write touching a queued
+ *  sector first erases the queued sectors up to and including that sector.
+ *
+ *  @code
+ *  NVSSPI25X_EraseAheadArgs eraseArgs;
+ *
+ *  eraseArgs.offset = 0;
+ *  eraseArgs.size   = imageSize rounded up to sector size;
+ *  NVS_control(nvsHandle, NVSSPI25X_CMD_ERASE_AHEAD, (uintptr_t)&eraseArgs);
+ *
+ *  while (receiving image) {
+ *      NVS_write(nvsHandle, offset, block, blockSize, 0);
+ *      offset += blockSize;
+ *  }
+ *
+ *  NVS_control(nvsHandle, NVSSPI25X_CMD_FLUSH, 0);
+ *  @endcode
  */
 
 #ifndef ti_drivers_nvs_NVSSPI25X__include
@@ -207,10 +259,45 @@ extern "C" {
  *  with the NVS_Handle passed to the control command, the user must
  *  carefully orchestrate the use of the command.
  *
- *  Mass Erase is the only control command supported.
+ *  Data held in the [write buffer](@ref WRITE_BUF) and sectors queued
+ *  for [erase ahead](@ref ERASE_AHEAD) of the region are discarded.
  */
 #define NVSSPI25X_CMD_MASS_ERASE (NVS_CMD_RESERVED + 0)
 
+/*!
+ *  @brief Command to program the data held in the write buffer
+ *
+ *  Programs the page held in the region's [write buffer](@ref WRITE_BUF)
+ *  and waits until the flash has completed it. The @c arg argument is
+ *  not used.
+ *
+ *  Returns #NVS_STATUS_SUCCESS if the buffer was empty or has been
+ *  programmed, and #NVS_STATUS_ERROR otherwise.
+ */
+#define NVSSPI25X_CMD_FLUSH (NVS_CMD_RESERVED + 1)
+
+/*!
+ *  @brief Command to queue sectors for erase ahead
+ *
+ *  The @c arg argument is a pointer to a #NVSSPI25X_EraseAheadArgs
+ *  structure describing the sectors to erase, which replace any sectors
+ *  still queued by a previous command. A @c size of 0 cancels the queued
+ *  sectors. If @c arg is NULL the driver only starts the next queued
+ *  erase if the flash is idle, which lets the application advance the
+ *  queue from an idle loop. See [Erase Ahead](@ref ERASE_AHEAD).
+ *
+ *  The @c offset and @c size arguments have the same requirements as
+ *  for NVS_erase() and the same error codes are returned.
+ */
+#define NVSSPI25X_CMD_ERASE_AHEAD (NVS_CMD_RESERVED + 2)
+
+/*!
+ *  @brief Size in bytes of the write buffer
+ *
+ *  Equal to the page size of the SPI flash.
+ */
+#define NVSSPI25X_WRITE_BUF_SIZE (256)
+
 /*!
  *  @brief Disable internal management of SPI chip select
  *
@@ -235,6 +322,15 @@ extern "C" {
  */
 extern const NVS_FxnTable NVSSPI25X_fxnTable;
 
+/*!
+ *  @brief      Argument of the #NVSSPI25X_CMD_ERASE_AHEAD command
+ */
+typedef struct
+{
+    size_t offset; /*!< Region offset of the first sector to erase */
+    size_t size;   /*!< Number of bytes to erase, or 0 to cancel */
+} NVSSPI25X_EraseAheadArgs;
+
 /*!
  *  @brief      NVSSPI25X attributes
  *
@@ -318,6 +414,15 @@ typedef struct
      * of time, but may also result in increased latency.
      */
     uint32_t statusPollDelayUs;
+    /*! @brief Write buffer
+     *
+     * A buffer of #NVSSPI25X_WRITE_BUF_SIZE bytes used to combine small
+     * writes into whole page programs, or NULL to program every write
+     * directly. Unlike the 'verifyBuf', this buffer holds data between
+     * calls and must not be shared with other regions. See
+     * [Write Buffer](@ref WRITE_BUF).
+     */
+    uint8_t *writeBuf;
 } NVSSPI25X_HWAttrs;
 
 /*
@@ -330,6 +435,11 @@ typedef struct
     bool opened; /* Has this region been opened */
     SPI_Handle spiHandle;
     size_t sectorBaseMask;
+    size_t writeBufOffset;   /* Region offset of the buffered page */
+    uint16_t writeBufStart;  /* First buffered byte within the page */
+    uint16_t writeBufEnd;    /* End of the buffered bytes, 0 if empty */
+    size_t eraseAheadOffset; /* Next sector queued for erase ahead */
+    size_t eraseAheadEnd;    /* End of the sectors queued for erase ahead */
 } NVSSPI25X_Object;
 
 /*
@@ -0,0 +1,470 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== nvsspi25xtest.c ========
+ *
+ * Check and benchmark of the NVSSPI25X driver on the emulated SPI flash
+ * of spiflash.c.
+ *
+ *  - A randomized model check runs writes (with and without flags),
+ *    reads, erases, flushes, erase ahead and reopens against a NOR model
+ *    of the region, with and without the write buffer.  The flash must
+ *    match the model after every flush and close, and the driver must
+ *    never send a command the flash would reject.
+ *  - An ordering check writes log records, some of them page aligned, and
+ *    checks after every write that the data found in flash, as after a
+ *    reset, is a prefix of the data written.
+ *  - Benchmarks of an over-the-air image download and of small records.
+ *
+ * Usage:
+ *
+ *     nvsspi25xtest
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ti/drivers/NVS.h>
+#include <ti/drivers/nvs/NVSSPI25X.h>
+
+#include "spiflash.h"
+
+#define REGION_SIZE (512 * 1024)
+#define SECTOR_SIZE 4096
+#define PAGE_SIZE   256
+
+#define CHECK(cond, ...)                                       \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            if (failures++ < 20)                               \
+            {                                                  \
+                printf("FAIL %s:%d: ", __FILE__, __LINE__);    \
+                printf(__VA_ARGS__);                           \
+                printf("\n");                                  \
+            }                                                  \
+        }                                                      \
+    } while (0)
+
+static uint8_t verifyBuf[64];
+static uint8_t writeBuf[NVSSPI25X_WRITE_BUF_SIZE];
+
+static NVSSPI25X_Object objects[1];
+static NVSSPI25X_HWAttrs hwAttrs[1] = {
+    {.regionBaseOffset  = 0,
+     .regionSize        = REGION_SIZE,
+     .sectorSize        = SECTOR_SIZE,
+     .verifyBuf         = verifyBuf,
+     .verifyBufSize     = sizeof(verifyBuf),
+     .spiHandle         = NULL,
+     .spiIndex          = 0,
+     .spiBitRate        = 8000000,
+     .spiCsnGpioIndex   = 1,
+     .statusPollDelayUs = 10},
+};
+
+const NVS_Config NVS_config[1] = {
+    {&NVSSPI25X_fxnTable, &objects[0], &hwAttrs[0]},
+};
+const uint_least8_t NVS_count = 1;
+
+static int failures;
+static uint8_t model[REGION_SIZE];
+
+static NVS_Handle openRegion(int useWriteBuf)
+{
+    NVS_Handle handle;
+
+    hwAttrs[0].writeBuf = useWriteBuf ? writeBuf : NULL;
+    handle              = NVSSPI25X_open(0, NULL);
+    if (handle == NULL)
+    {
+        printf("NVSSPI25X_open failed\n");
+        exit(1);
+    }
+
+    return (handle);
+}
+
+/*
+ *  ======== modelWrite ========
+ *  Apply a write to the model, return the status the driver must return.
+ */
+static int modelWrite(size_t offset, const uint8_t *buf, size_t len, uint_fast16_t flags)
+{
+    size_t start, end, i;
+
+    if (flags & NVS_WRITE_ERASE)
+    {
+        /* The driver erases the size rounded up to sectors */
+        start = offset & ~(size_t)(SECTOR_SIZE - 1);
+        end   = start + ((len + SECTOR_SIZE - 1) & ~(size_t)(SECTOR_SIZE - 1));
+        memset(model + start, 0xFF, end - start);
+    }
+
+    if (flags & NVS_WRITE_PRE_VERIFY)
+    {
+        for (i = 0; i < len; i++)
+        {
+            if ((buf[i] & model[offset + i]) != buf[i])
+            {
+                return (NVS_STATUS_INV_WRITE);
+            }
+        }
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        model[offset + i] &= buf[i];
+    }
+
+    if (flags & NVS_WRITE_POST_VERIFY)
+    {
+        for (i = 0; i < len; i++)
+        {
+            if (model[offset + i] != buf[i])
+            {
+                return (NVS_STATUS_INV_WRITE);
+            }
+        }
+    }
+
+    return (NVS_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== modelCheck ========
+ *  Random operations, mostly within the first 16 sectors so that pages
+ *  and sectors collide.
+ */
+static void modelCheck(unsigned int seed, int ops, int useWriteBuf)
+{
+    static uint8_t buf[3000];
+    static uint8_t out[3000];
+    NVSSPI25X_EraseAheadArgs eraseArgs;
+    bool eraseAheadSet = false;
+    NVS_Handle handle;
+    uint_fast16_t flags;
+    size_t offset, len, i;
+    int op, status, expected;
+
+    srand(seed);
+    SpiFlash_reset();
+    memset(model, 0xFF, sizeof(model));
+    handle = openRegion(useWriteBuf);
+
+    while (ops-- > 0)
+    {
+        op     = rand() % 100;
+        offset = rand() % (16 * SECTOR_SIZE);
+        len    = (rand() % 4 == 0) ? (size_t)(rand() % 3000) : (size_t)(rand() % 64);
+
+        if (op < 55)
+        {
+            switch (rand() % 10)
+            {
+                case 7:
+                    flags = NVS_WRITE_ERASE;
+                    break;
+                case 8:
+                    flags = NVS_WRITE_PRE_VERIFY;
+                    break;
+                case 9:
+                    flags = NVS_WRITE_POST_VERIFY;
+                    break;
+                default:
+                    flags = 0;
+                    break;
+            }
+            for (i = 0; i < len; i++)
+            {
+                buf[i] = (rand() % 3) ? (0xFF & ~(1 << (rand() % 8))) : rand();
+            }
+
+            expected = modelWrite(offset, buf, len, flags);
+            status   = NVSSPI25X_write(handle, offset, buf, len, flags);
+            CHECK(status == expected, "write %zu/%zu flags %d: %d, expected %d", offset, len, (int)flags, status,
+                  expected);
+        }
+        else if (op < 80)
+        {
+            memset(out, 0x5A, len);
+            status = NVSSPI25X_read(handle, offset, out, len);
+            CHECK(status == NVS_STATUS_SUCCESS, "read: %d", status);
+            CHECK(memcmp(out, model + offset, len) == 0, "read %zu/%zu differs from the model", offset, len);
+        }
+        else if (op < 86)
+        {
+            offset &= ~(size_t)(SECTOR_SIZE - 1);
+            len = SECTOR_SIZE * (1 + rand() % 3);
+            status = NVSSPI25X_erase(handle, offset, len);
+            CHECK(status == NVS_STATUS_SUCCESS, "erase: %d", status);
+            memset(model + offset, 0xFF, len);
+        }
+        else if (op < 92)
+        {
+            status = NVSSPI25X_control(handle, NVSSPI25X_CMD_FLUSH, 0);
+            CHECK(status == NVS_STATUS_SUCCESS, "flush: %d", status);
+            if (!eraseAheadSet)
+            {
+                CHECK(memcmp(spiFlashMem, model, 16 * SECTOR_SIZE + sizeof(buf)) == 0,
+                      "flash differs from the model after a flush");
+            }
+        }
+        else if (op < 95 && !eraseAheadSet)
+        {
+            eraseArgs.offset = (rand() % 16) * SECTOR_SIZE;
+            eraseArgs.size   = SECTOR_SIZE * (1 + rand() % 20);
+            status           = NVSSPI25X_control(handle, NVSSPI25X_CMD_ERASE_AHEAD, (uintptr_t)&eraseArgs);
+            CHECK(status == NVS_STATUS_SUCCESS, "erase ahead: %d", status);
+            memset(model + eraseArgs.offset, 0xFF, eraseArgs.size);
+            eraseAheadSet = true;
+        }
+        else if (op < 97)
+        {
+            spiFlashStats.nowUs += rand() % 50000;
+            status = NVSSPI25X_control(handle, NVSSPI25X_CMD_ERASE_AHEAD, 0);
+            CHECK(status == NVS_STATUS_SUCCESS, "erase ahead service: %d", status);
+        }
+        else
+        {
+            NVSSPI25X_close(handle);
+            CHECK(memcmp(spiFlashMem, model, REGION_SIZE) == 0, "flash differs from the model after close");
+            handle        = openRegion(useWriteBuf);
+            eraseAheadSet = false;
+        }
+    }
+
+    NVSSPI25X_close(handle);
+    CHECK(memcmp(spiFlashMem, model, REGION_SIZE) == 0, "flash differs from the model at the end");
+    CHECK(spiFlashStats.violations == 0, "%ld flash protocol violations", spiFlashStats.violations);
+}
+
+/*
+ *  ======== orderCheck ========
+ *  Append records to a log, starting some of them on a page boundary. The
+ *  bytes found in flash must always be a prefix of the bytes written.
+ */
+static void orderCheck(unsigned int seed, int records)
+{
+    static uint32_t written[64 * 1024];
+    static uint8_t rec[600];
+    size_t numWritten = 0;
+    size_t offset     = 0;
+    NVS_Handle handle;
+    size_t len, i;
+    bool persisted;
+    int status;
+
+    srand(seed);
+    SpiFlash_reset();
+    handle = openRegion(1);
+
+    while (records-- > 0)
+    {
+        len = 1 + rand() % sizeof(rec);
+        if (rand() % 4 == 0)
+        {
+            /* Page aligned, often whole pages that bypass the buffer */
+            offset = (offset + PAGE_SIZE - 1) & ~(size_t)(PAGE_SIZE - 1);
+            if (rand() % 2)
+            {
+                len = PAGE_SIZE * (1 + rand() % 2);
+            }
+        }
+        if (offset + len > sizeof(written) / sizeof(written[0]))
+        {
+            break;
+        }
+
+        /* Record bytes are never 0xFF, so they can be told from erased ones */
+        for (i = 0; i < len; i++)
+        {
+            rec[i]                 = rand() % 0xFF;
+            written[numWritten++] = offset + i;
+        }
+        status = NVSSPI25X_write(handle, offset, rec, len, 0);
+        CHECK(status == NVS_STATUS_SUCCESS, "log write: %d", status);
+        offset += len;
+
+        persisted = true;
+        for (i = 0; i < numWritten; i++)
+        {
+            if (spiFlashMem[written[i]] == 0xFF)
+            {
+                persisted = false;
+            }
+            else if (!persisted)
+            {
+                CHECK(false, "byte at %u reached the flash before earlier data", (unsigned int)written[i]);
+                break;
+            }
+        }
+    }
+
+    NVSSPI25X_close(handle);
+    for (i = 0; i < numWritten; i++)
+    {
+        CHECK(spiFlashMem[written[i]] != 0xFF, "byte at %u lost on close", (unsigned int)written[i]);
+    }
+}
+
+static double inNvsUs;
+
+#define TIMED(call)                              \
+    do                                           \
+    {                                            \
+        double t0_ = spiFlashStats.nowUs;        \
+        call;                                    \
+        inNvsUs += spiFlashStats.nowUs - t0_;    \
+    } while (0)
+
+/*
+ *  ======== benchImage ========
+ *  Over-the-air image download: chunks arrive with a gap between them.
+ *  Either each sector is erased when the image first reaches it, or all
+ *  sectors are queued with erase ahead and written through the buffer.
+ */
+static void benchImage(size_t imageSize, size_t chunk, double gapUs, int eraseAhead)
+{
+    static uint8_t data[1 << 20];
+    static uint8_t back[1 << 20];
+    NVSSPI25X_EraseAheadArgs eraseArgs;
+    size_t erasedEnd = 0;
+    NVS_Handle handle;
+    size_t offset, len;
+    double t0;
+
+    for (offset = 0; offset < imageSize; offset++)
+    {
+        data[offset] = rand();
+    }
+    SpiFlash_reset();
+    memset(&spiFlashStats, 0, sizeof(spiFlashStats));
+    handle  = openRegion(eraseAhead);
+    inNvsUs = 0;
+    t0      = spiFlashStats.nowUs;
+
+    if (eraseAhead)
+    {
+        eraseArgs.offset = 0;
+        eraseArgs.size   = (imageSize + SECTOR_SIZE - 1) & ~(size_t)(SECTOR_SIZE - 1);
+        TIMED(NVSSPI25X_control(handle, NVSSPI25X_CMD_ERASE_AHEAD, (uintptr_t)&eraseArgs));
+    }
+    for (offset = 0; offset < imageSize; offset += chunk)
+    {
+        len = (imageSize - offset < chunk) ? imageSize - offset : chunk;
+        spiFlashStats.nowUs += gapUs;
+        while (!eraseAhead && erasedEnd < offset + len)
+        {
+            TIMED(NVSSPI25X_erase(handle, erasedEnd, SECTOR_SIZE));
+            erasedEnd += SECTOR_SIZE;
+        }
+        TIMED(NVSSPI25X_write(handle, offset, data + offset, len, 0));
+    }
+    if (eraseAhead)
+    {
+        TIMED(NVSSPI25X_control(handle, NVSSPI25X_CMD_FLUSH, 0));
+    }
+
+    NVSSPI25X_read(handle, 0, back, imageSize);
+    CHECK(memcmp(back, data, imageSize) == 0, "image differs");
+
+    printf("  %-26s chunk %3zu gap %5.1f ms: total %7.1f ms, in NVS %7.1f ms, programs %5ld, erases %ld+%ld(64K)\n",
+           eraseAhead ? "erase ahead + write buffer" : "erase on demand", chunk, gapUs / 1000.0,
+           (spiFlashStats.nowUs - t0) / 1000.0, inNvsUs / 1000.0, spiFlashStats.programs, spiFlashStats.erases4k,
+           spiFlashStats.erases64k);
+    NVSSPI25X_close(handle);
+}
+
+/*
+ *  ======== benchRecords ========
+ *  Small sequential records into erased flash.
+ */
+static void benchRecords(size_t recSize, size_t total, int useWriteBuf)
+{
+    static uint8_t data[256];
+    NVS_Handle handle;
+    size_t offset;
+    double t0;
+
+    SpiFlash_reset();
+    memset(&spiFlashStats, 0, sizeof(spiFlashStats));
+    handle = openRegion(useWriteBuf);
+    t0     = spiFlashStats.nowUs;
+    for (offset = 0; offset < total; offset += recSize)
+    {
+        memset(data, offset / recSize, recSize);
+        NVSSPI25X_write(handle, offset, data, recSize, 0);
+    }
+    NVSSPI25X_control(handle, NVSSPI25X_CMD_FLUSH, 0);
+
+    printf("  %3zu-byte records, %zu KB, %-9s %7.1f ms (%5.1f us/record), programs %5ld\n", recSize, total / 1024,
+           useWriteBuf ? "buffered:" : "direct:", (spiFlashStats.nowUs - t0) / 1000.0,
+           (spiFlashStats.nowUs - t0) / (total / recSize), spiFlashStats.programs);
+    NVSSPI25X_close(handle);
+}
+
+int main(void)
+{
+    unsigned int seed;
+
+    NVSSPI25X_init();
+
+    for (seed = 1; seed <= 40; seed++)
+    {
+        modelCheck(seed, 3000, seed & 1);
+    }
+    printf("model check: %s\n", failures ? "FAILED" : "ok");
+
+    for (seed = 1; seed <= 20; seed++)
+    {
+        orderCheck(seed, 400);
+    }
+    printf("order check: %s\n", failures ? "FAILED" : "ok");
+
+    printf("Image download, 200 KB:\n");
+    benchImage(200 * 1024, 244, 0, 0);
+    benchImage(200 * 1024, 244, 7500, 0);
+    benchImage(200 * 1024, 244, 0, 1);
+    benchImage(200 * 1024, 244, 7500, 1);
+
+    printf("Records:\n");
+    benchRecords(16, 16 * 1024, 0);
+    benchRecords(16, 16 * 1024, 1);
+    benchRecords(244, 16 * 1024, 0);
+    benchRecords(244, 16 * 1024, 1);
+
+    return (failures != 0);
+}
@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== spiflash.c ========
+ *
+ * Host emulation of a 25-series SPI NOR flash.  The flash is driven
+ * through SPI_transfer() while its chip select GPIO is low, and a command
+ * takes effect when the chip select goes high, as on the device.  Page
+ * programs and erases keep the flash busy for a simulated time, and any
+ * command other than a status read sent while busy, or a program or erase
+ * sent without the write enable latch set, is counted as a violation.
+ *
+ * The SemaphoreP, ClockP and HwiP functions used by NVSSPI25X are provided
+ * here too.  ClockP_usleep() advances the simulated time.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include <ti/drivers/dpl/SemaphoreP.h>
+#include <ti/drivers/dpl/ClockP.h>
+#include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/SPI.h>
+#include <ti/drivers/GPIO.h>
+
+#include "spiflash.h"
+
+#define CMD_WRITE_ENABLE  0x06
+#define CMD_PAGE_PROGRAM  0x02
+#define CMD_READ          0x03
+#define CMD_READ_STATUS   0x05
+#define CMD_SECTOR_ERASE  0x20
+#define CMD_BLOCK_ERASE   0xD8
+#define CMD_CHIP_ERASE    0xC7
+
+#define PAGE_SIZE         256
+
+SpiFlash_Stats spiFlashStats;
+SpiFlash_Config spiFlashConfig = {
+    .size               = 1 << 20,
+    .busUsPerByte       = 1.0, /* 8 MHz */
+    .transferOverheadUs = 2.0,
+    .ppBaseUs           = 20.0,
+    .ppPerByteUs        = 1.5,
+    .se4kUs             = 45000.0,
+    .se64kUs            = 150000.0,
+    .ceUs               = 2000000.0,
+};
+uint8_t *spiFlashMem;
+
+static double busyUntil;
+static bool wel;
+static bool selected;
+static uint8_t cmdBuf[4];
+static int cmdLen;
+static int dataLen;
+static uint32_t addr;
+static uint8_t pageData[PAGE_SIZE];
+static bool pageTouched[PAGE_SIZE];
+
+/*
+ *  ======== SpiFlash_reset ========
+ */
+void SpiFlash_reset(void)
+{
+    free(spiFlashMem);
+    spiFlashMem = malloc(spiFlashConfig.size);
+    memset(spiFlashMem, 0xFF, spiFlashConfig.size);
+    busyUntil = 0;
+    wel       = false;
+}
+
+static bool isBusy(void)
+{
+    return (spiFlashStats.nowUs < busyUntil);
+}
+
+static void startBusy(double us)
+{
+    busyUntil = spiFlashStats.nowUs + us;
+    spiFlashStats.busyUs += us;
+    wel = false;
+}
+
+static uint8_t status(void)
+{
+    return ((isBusy() ? 0x01 : 0x00) | (wel ? 0x02 : 0x00));
+}
+
+/*
+ *  ======== endCommand ========
+ *  Chip select deasserted: execute the command.
+ */
+static void endCommand(void)
+{
+    uint8_t op = (cmdLen > 0) ? cmdBuf[0] : 0;
+    uint32_t size;
+    int i;
+
+    if (op != CMD_WRITE_ENABLE && op != CMD_PAGE_PROGRAM && op != CMD_SECTOR_ERASE && op != CMD_BLOCK_ERASE &&
+        op != CMD_CHIP_ERASE)
+    {
+        return;
+    }
+
+    if (isBusy())
+    {
+        spiFlashStats.violations++;
+        return;
+    }
+
+    switch (op)
+    {
+        case CMD_WRITE_ENABLE:
+            wel = true;
+            break;
+
+        case CMD_PAGE_PROGRAM:
+            if (!wel || cmdLen < 4)
+            {
+                spiFlashStats.violations++;
+                break;
+            }
+            for (i = 0; i < PAGE_SIZE; i++)
+            {
+                if (pageTouched[i])
+                {
+                    spiFlashMem[(addr & ~(PAGE_SIZE - 1)) + i] &= pageData[i];
+                }
+            }
+            spiFlashStats.programs++;
+            spiFlashStats.programmedBytes += dataLen;
+            startBusy(spiFlashConfig.ppBaseUs + spiFlashConfig.ppPerByteUs * dataLen);
+            break;
+
+        case CMD_SECTOR_ERASE:
+        case CMD_BLOCK_ERASE:
+            if (!wel || cmdLen < 4)
+            {
+                spiFlashStats.violations++;
+                break;
+            }
+            size = (op == CMD_SECTOR_ERASE) ? 4096 : 65536;
+            memset(spiFlashMem + (addr & ~(size - 1)), 0xFF, size);
+            if (op == CMD_SECTOR_ERASE)
+            {
+                spiFlashStats.erases4k++;
+                startBusy(spiFlashConfig.se4kUs);
+            }
+            else
+            {
+                spiFlashStats.erases64k++;
+                startBusy(spiFlashConfig.se64kUs);
+            }
+            break;
+
+        case CMD_CHIP_ERASE:
+            if (!wel)
+            {
+                spiFlashStats.violations++;
+                break;
+            }
+            memset(spiFlashMem, 0xFF, spiFlashConfig.size);
+            startBusy(spiFlashConfig.ceUs);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*
+ *  ======== exchange ========
+ *  One byte exchanged on the bus while chip select is asserted.
+ */
+static uint8_t exchange(uint8_t tx)
+{
+    uint8_t rx = 0xFF;
+    uint32_t i;
+
+    if (cmdLen >= 1 && cmdBuf[0] == CMD_READ_STATUS)
+    {
+        return (status());
+    }
+
+    if (cmdLen < 4 && (cmdLen == 0 || cmdBuf[0] == CMD_READ || cmdBuf[0] == CMD_PAGE_PROGRAM ||
+                       cmdBuf[0] == CMD_SECTOR_ERASE || cmdBuf[0] == CMD_BLOCK_ERASE))
+    {
+        cmdBuf[cmdLen++] = tx;
+        if (cmdLen == 4)
+        {
+            addr = ((uint32_t)cmdBuf[1] << 16 | (uint32_t)cmdBuf[2] << 8 | cmdBuf[3]) % spiFlashConfig.size;
+            memset(pageTouched, 0, sizeof(pageTouched));
+        }
+        return (rx);
+    }
+
+    switch (cmdBuf[0])
+    {
+        case CMD_READ:
+            if (isBusy())
+            {
+                spiFlashStats.violations++;
+            }
+            rx = spiFlashMem[addr];
+            addr = (addr + 1) % spiFlashConfig.size;
+            break;
+
+        case CMD_PAGE_PROGRAM:
+            /* The address wraps within the page, the first byte sent wins */
+            i = (addr + dataLen) & (PAGE_SIZE - 1);
+            if (!pageTouched[i])
+            {
+                pageData[i]    = tx;
+                pageTouched[i] = true;
+            }
+            dataLen++;
+            break;
+
+        default:
+            break;
+    }
+
+    return (rx);
+}
+
+/* DPL */
+typedef struct
+{
+    int count;
+} Semaphore;
+
+SemaphoreP_Handle SemaphoreP_createBinary(unsigned int count)
+{
+    Semaphore *sem = calloc(1, sizeof(*sem));
+
+    sem->count = count;
+    return (sem);
+}
+
+void SemaphoreP_delete(SemaphoreP_Handle handle)
+{
+    free(handle);
+}
+
+void SemaphoreP_post(SemaphoreP_Handle handle)
+{
+    ((Semaphore *)handle)->count = 1;
+}
+
+SemaphoreP_Status SemaphoreP_pend(SemaphoreP_Handle handle, uint32_t timeout)
+{
+    Semaphore *sem = handle;
+
+    if (sem->count == 0)
+    {
+        fprintf(stderr, "SemaphoreP_pend: deadlock\n");
+        abort();
+    }
+    sem->count = 0;
+
+    return (SemaphoreP_OK);
+}
+
+void ClockP_usleep(uint32_t usec)
+{
+    spiFlashStats.nowUs += usec;
+}
+
+uintptr_t HwiP_disable(void)
+{
+    return (0);
+}
+
+void HwiP_restore(uintptr_t key)
+{
+}
+
+/* SPI and GPIO */
+static int spiInstance;
+
+void SPI_init(void)
+{
+}
+
+void SPI_Params_init(SPI_Params *params)
+{
+    memset(params, 0, sizeof(*params));
+}
+
+SPI_Handle SPI_open(uint_least8_t index, SPI_Params *params)
+{
+    return ((SPI_Handle)&spiInstance);
+}
+
+void SPI_close(SPI_Handle handle)
+{
+}
+
+bool SPI_transfer(SPI_Handle handle, SPI_Transaction *transaction)
+{
+    const uint8_t *tx = transaction->txBuf;
+    uint8_t *rx       = transaction->rxBuf;
+    uint8_t data;
+    size_t i;
+
+    spiFlashStats.nowUs += spiFlashConfig.transferOverheadUs + spiFlashConfig.busUsPerByte * transaction->count;
+    spiFlashStats.transfers++;
+
+    if (!selected)
+    {
+        spiFlashStats.violations++;
+        return (true);
+    }
+
+    for (i = 0; i < transaction->count; i++)
+    {
+        data = exchange((tx != NULL) ? tx[i] : 0xFF);
+        if (rx != NULL)
+        {
+            rx[i] = data;
+        }
+    }
+
+    return (true);
+}
+
+void GPIO_init(void)
+{
+}
+
+int_fast16_t GPIO_setConfig(uint_least8_t index, GPIO_PinConfig pinConfig)
+{
+    return (GPIO_STATUS_SUCCESS);
+}
+
+void GPIO_write(uint_least8_t index, unsigned int value)
+{
+    if (value == 0 && !selected)
+    {
+        selected = true;
+        cmdLen   = 0;
+        dataLen  = 0;
+    }
+    else if (value != 0 && selected)
+    {
+        selected = false;
+        endCommand();
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== spiflash.h ========
+ *
+ * Host emulation of a 25-series SPI NOR flash behind the SPI and GPIO
+ * driver APIs, with simulated time.
+ */
+
+#ifndef spiflash__include
+#define spiflash__include
+
+#include <stdint.h>
+
+typedef struct
+{
+    double nowUs;          /* simulated time */
+    double busyUs;         /* time the flash was busy programming or erasing */
+    long transfers;        /* SPI transfers */
+    long programs;         /* page programs */
+    long programmedBytes;  /* bytes sent with page programs */
+    long erases4k;         /* 4 KB sector erases */
+    long erases64k;        /* 64 KB block erases */
+    long violations;       /* commands sent while busy or without WEL */
+} SpiFlash_Stats;
+
+typedef struct
+{
+    uint32_t size;             /* flash size in bytes */
+    double busUsPerByte;       /* SPI bus time per byte */
+    double transferOverheadUs; /* driver overhead per SPI_transfer() */
+    double ppBaseUs;           /* page program time, fixed part */
+    double ppPerByteUs;        /* page program time per byte */
+    double se4kUs;             /* 4 KB sector erase time */
+    double se64kUs;            /* 64 KB block erase time */
+    double ceUs;               /* chip erase time */
+} SpiFlash_Config;
+
+extern SpiFlash_Stats spiFlashStats;
+extern SpiFlash_Config spiFlashConfig;
+
+/* Flash contents, as they would be found after a reset */
+extern uint8_t *spiFlashMem;
+
+/* Erase the whole flash and make it idle */
+extern void SpiFlash_reset(void);
+
+#endif /* spiflash__include */
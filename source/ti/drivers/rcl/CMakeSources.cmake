@@ -7,6 +7,7 @@ set(SOURCES_COMMON
     RCL_Feature.c
     ${RCL_INSTALL_DIR}/source/ti/drivers/rcl/LRF.c
     ${RCL_INSTALL_DIR}/source/ti/drivers/rcl/RCL_Buffer.c
+    ${RCL_INSTALL_DIR}/source/ti/drivers/rcl/RCL_CommandQueue.c
     ${RCL_INSTALL_DIR}/source/ti/drivers/rcl/RCL_Debug.c
     ${RCL_INSTALL_DIR}/source/ti/drivers/rcl/RCL_Lite.c
     ${RCL_INSTALL_DIR}/source/ti/drivers/rcl/RCL_Profiling.c
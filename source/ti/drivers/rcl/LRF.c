@@ -39,10 +39,49 @@
 #include <ti/drivers/rcl/RCL_Command.h>
 #include <ti/drivers/rcl/RCL_Debug.h>
 #include <ti/drivers/rcl/LRF.h>
+#include <ti/drivers/dpl/HwiP.h>
 #include <ti/log/Log.h>
 
 // #define LRF_DEBUG_TRACE
 
+#ifndef BUFFER_SPLIT_SUPPORT
+/* Kind of memory written by a configuration write */
+typedef enum {
+    LRF_ConfigWriteKind_Hw,    /* LRF register */
+    LRF_ConfigWriteKind_Sw,    /* TOPsm RAM */
+    LRF_ConfigWriteKind_Par,   /* Software parameter in swParamList */
+} LRF_ConfigWriteKind;
+
+/* One write done by a full (IncludeBase) application of a configuration */
+typedef struct {
+    uintptr_t           address;
+    uint32_t            value;
+    uint8_t             size;
+    LRF_ConfigWriteKind kind;
+} LRF_ConfigWrite;
+
+/* Iterator over the writes done by a full application of a configuration */
+typedef struct {
+    const LRF_RegConfigList *list;
+    uint16_t                 phyFeatures;
+    uint32_t                 entryIndex;
+    const uint32_t          *curEntry;
+    uint32_t                 segmentLength;
+    uint32_t                 regionLength;
+    LRF_RegionOperation      operation;
+    uintptr_t                address;
+    bool                     pending;
+    LRF_ConfigWrite          pendingWrite;
+} LRF_ConfigIterator;
+
+static void LRF_ConfigIterator_init(LRF_ConfigIterator *it, const LRF_Config *config, uint16_t phyFeatures);
+static LRF_SetupResult LRF_ConfigIterator_next(LRF_ConfigIterator *it, LRF_ConfigWrite *write);
+static bool LRF_ConfigDelta_overlaps(const LRF_ConfigWrite *a, const LRF_ConfigWrite *b);
+
+/* Registered configuration deltas */
+static LRF_ConfigDelta *lrfConfigDeltaList = NULL;
+#endif
+
 LRF_SetupResult LRF_loadImage(const LRF_TOPsmImage *image, uint32_t destinationAddress)
 {
     LRF_SetupResult result;
@@ -725,6 +764,417 @@ LRF_SetupResult LRF_applySettings(LRF_ConfigWord         *config,
     return SetupResult_Ok;
 }
 
+#ifndef BUFFER_SPLIT_SUPPORT
+static void LRF_ConfigIterator_init(LRF_ConfigIterator *it, const LRF_Config *config, uint16_t phyFeatures)
+{
+    it->list          = config->regConfigList;
+    it->phyFeatures   = phyFeatures;
+    it->entryIndex    = 0;
+    it->curEntry      = NULL;
+    it->segmentLength = 0;
+    it->regionLength  = 0;
+    it->operation     = LRF_RegionOperation_Invalid;
+    it->address       = 0;
+    it->pending       = false;
+}
+
+/* Finds the next write LRF_applySettings() would do with LRF_ApplySettings_IncludeBase.
+ * Returns SetupResult_Ok with write->size set to 0 when all entries are processed.
+ */
+static LRF_SetupResult LRF_ConfigIterator_next(LRF_ConfigIterator *it, LRF_ConfigWrite *write)
+{
+    if (it->pending)
+    {
+        *write = it->pendingWrite;
+        it->pending = false;
+        return SetupResult_Ok;
+    }
+
+    while (it->regionLength == 0)
+    {
+        LRF_ConfigWord curWord;
+
+        if (it->segmentLength == 0)
+        {
+            /* Start next segment */
+            if (it->list == NULL || it->entryIndex >= it->list->numEntries)
+            {
+                write->size = 0;
+                return SetupResult_Ok;
+            }
+            it->curEntry = (const uint32_t *)it->list->entries[it->entryIndex++];
+            if (it->curEntry == NULL)
+            {
+                continue;
+            }
+            curWord.value32 = *it->curEntry++;
+            uint16_t featureMask = curWord.segment.featureMask;
+            if (curWord.segment.compoundSegment != 0)
+            {
+                return SetupResult_ErrorConfigLen;
+            }
+            if ((curWord.segment.invertedFeatureMask == 0 && featureMask != 0 && (featureMask & it->phyFeatures) == 0) ||
+                (curWord.segment.invertedFeatureMask != 0 && (featureMask != (featureMask & ~it->phyFeatures))))
+            {
+                /* Segment not included for these PHY features */
+                continue;
+            }
+            it->segmentLength = curWord.segment.length;
+            if (it->segmentLength == 0 || it->segmentLength >= MAX_REG_CONFIG_LEN)
+            {
+                return SetupResult_ErrorConfigLen;
+            }
+        }
+
+        /* Region header */
+        curWord.value32 = *it->curEntry++;
+        it->segmentLength--;
+        it->regionLength = curWord.region.lengthMinus1 + 1;
+        it->operation    = (LRF_RegionOperation) curWord.region.type;
+        uint32_t regionStart = curWord.region.startAddress;
+
+        if (it->operation >= SW_Region_Clear && it->operation != HW_Write_16bit_masked)
+        {
+            if (it->operation >= Par_Region_Clear)
+            {
+                it->address = ((uintptr_t) &swParamList) + regionStart;
+                uint32_t regionActualLength = (it->operation == Par_Reference_32bit) ? 1 : it->regionLength;
+                if ((regionStart + (regionActualLength * sizeof(uint32_t))) > swParamListSz)
+                {
+                    return SetupResult_ErrorParRange;
+                }
+            }
+            else
+            {
+                it->address = PBE_RAM_BASE_ADDR + regionStart;
+            }
+        }
+        else
+        {
+            it->address = LRF_BASE_ADDR + regionStart;
+        }
+        if (it->operation > HW_Write_16bit_masked)
+        {
+            return SetupResult_ErrorElemType;
+        }
+    }
+
+    LRF_RegionOperation operation = it->operation;
+    uint32_t value = 0;
+
+    write->kind = (operation >= Par_Region_Clear && operation != HW_Write_16bit_masked) ? LRF_ConfigWriteKind_Par :
+                  (operation >= SW_Region_Clear && operation != HW_Write_16bit_masked) ? LRF_ConfigWriteKind_Sw :
+                  LRF_ConfigWriteKind_Hw;
+
+    /* All operations except clears consume at least one word of the segment */
+    if (operation != HW_Region_Clear && operation != SW_Region_Clear && operation != Par_Region_Clear)
+    {
+        if (it->segmentLength == 0)
+        {
+            return SetupResult_ErrorElemLen;
+        }
+        if (operation == Par_Reference_32bit && it->regionLength > it->segmentLength)
+        {
+            return SetupResult_ErrorElemLen;
+        }
+        value = *it->curEntry;
+    }
+
+    switch (operation)
+    {
+        case HW_Region_Clear:
+        case Par_Region_Clear:
+        case SW_Region_Clear:
+            write->address = it->address;
+            write->size    = (operation == SW_Region_Clear) ? 2 : 4;
+            write->value   = 0;
+            it->address   += write->size;
+            it->regionLength--;
+            break;
+
+        case HW_Write_16bit:
+        case SW_Write_16bit:
+            write->address = it->address;
+            write->size    = (operation == SW_Write_16bit) ? 2 : 4;
+            write->value   = value & 0xFFFF;
+            if (it->regionLength >= 2)
+            {
+                /* Second half-word of the entry goes to the next location */
+                it->pendingWrite = *write;
+                it->pendingWrite.address += write->size;
+                it->pendingWrite.value = value >> 16;
+                it->pending = true;
+                it->address += 2 * write->size;
+                it->regionLength -= 2;
+            }
+            else
+            {
+                it->regionLength = 0;
+            }
+            it->curEntry++;
+            it->segmentLength--;
+            break;
+
+        case HW_Write_16bit_masked:
+            /* Full setup writes the value without applying the mask */
+            write->address = it->address;
+            write->size    = 4;
+            write->value   = value & 0xFFFF;
+            it->address   += 4;
+            it->regionLength--;
+            it->curEntry++;
+            it->segmentLength--;
+            break;
+
+        case HW_Write_32bit:
+        case SW_Write_32bit:
+        case Par_Write_32bit:
+            write->address = it->address;
+            write->size    = 4;
+            write->value   = value;
+            it->address   += 4;
+            it->regionLength--;
+            it->curEntry++;
+            it->segmentLength--;
+            break;
+
+        case Par_Reference_32bit:
+            /* Points to the constants embedded in the configuration */
+            write->address = it->address;
+            write->size    = 4;
+            write->value   = (uint32_t)(uintptr_t)it->curEntry;
+            it->curEntry += it->regionLength;
+            it->segmentLength -= it->regionLength;
+            it->regionLength = 0;
+            break;
+
+        case HW_Write_16bit_sparse:
+        case SW_Write_16bit_sparse:
+        {
+            LRF_ConfigWord curWord;
+            curWord.value32 = value;
+            write->address = it->address + curWord.sparse.address;
+            write->value   = curWord.sparse.value16;
+            if ((write->address & 1) != 0)
+            {
+                return SetupResult_ErrorElemAddrAlign;
+            }
+            write->size = (operation == HW_Write_16bit_sparse && (write->address & 3) == 0) ? 4 : 2;
+            it->regionLength--;
+            it->curEntry++;
+            it->segmentLength--;
+            break;
+        }
+
+        default:
+            return SetupResult_ErrorElemType;
+    }
+
+    if ((write->address & (write->size - 1)) != 0)
+    {
+        return SetupResult_ErrorElemAddrAlign;
+    }
+
+    return SetupResult_Ok;
+}
+
+static bool LRF_ConfigDelta_overlaps(const LRF_ConfigWrite *a, const LRF_ConfigWrite *b)
+{
+    return (a->address < b->address + b->size) && (b->address < a->address + a->size);
+}
+
+LRF_SetupResult LRF_ConfigDelta_init(LRF_ConfigDelta      *delta,
+                                     const LRF_Config     *from,
+                                     const LRF_Config     *to,
+                                     uint16_t              phyFeatures,
+                                     LRF_ConfigDeltaWrite *writes,
+                                     uint32_t              maxWrites)
+{
+    LRF_ConfigIterator toIt;
+    LRF_ConfigWrite toWrite;
+    LRF_SetupResult result;
+    uint32_t numWrites = 0;
+    uint32_t toIndex = 0;
+    /* A TOPsm image load may change TOPsm RAM, so those writes can only be
+     * skipped if the images stay the same.
+     */
+    bool sameImages = (from->pbeImage == to->pbeImage) &&
+                      (from->mceImage == to->mceImage) &&
+                      (from->rfeImage == to->rfeImage);
+
+    delta->next        = NULL;
+    delta->from        = from;
+    delta->to          = to;
+    delta->writes      = writes;
+    delta->numWrites   = 0;
+    delta->phyFeatures = phyFeatures;
+
+    LRF_ConfigIterator_init(&toIt, to, phyFeatures);
+    while (((result = LRF_ConfigIterator_next(&toIt, &toWrite)) == SetupResult_Ok) && toWrite.size != 0)
+    {
+        LRF_ConfigIterator it;
+        LRF_ConfigWrite otherWrite;
+        bool needed = true;
+
+        /* Skip the write if the same location is written again later, or
+         * remember if another write partly overlaps it
+         */
+        bool partlyOverlapped = false;
+        it = toIt;
+        while (((result = LRF_ConfigIterator_next(&it, &otherWrite)) == SetupResult_Ok) && otherWrite.size != 0)
+        {
+            if (otherWrite.address == toWrite.address && otherWrite.size == toWrite.size)
+            {
+                needed = false;
+                break;
+            }
+            if (LRF_ConfigDelta_overlaps(&otherWrite, &toWrite))
+            {
+                partlyOverlapped = true;
+            }
+        }
+        if (result != SetupResult_Ok)
+        {
+            return result;
+        }
+
+        /* Skip the write if the previous configuration leaves the same value
+         * at the location. Software parameters are cheap to write and always
+         * applied, as are registers that are modified by trim.
+         */
+        if (needed && !partlyOverlapped &&
+            toWrite.kind != LRF_ConfigWriteKind_Par &&
+            (toWrite.kind != LRF_ConfigWriteKind_Sw || sameImages) &&
+            !LRF_ConfigDelta_isVolatile(toWrite.address, toWrite.size))
+        {
+            /* An earlier write partly overlapping this one is always applied,
+             * so this write must be applied after it as well
+             */
+            LRF_ConfigIterator_init(&it, to, phyFeatures);
+            for (uint32_t i = 0; i < toIndex; i++)
+            {
+                result = LRF_ConfigIterator_next(&it, &otherWrite);
+                if (result != SetupResult_Ok || otherWrite.size == 0)
+                {
+                    break;
+                }
+                if (LRF_ConfigDelta_overlaps(&otherWrite, &toWrite) &&
+                    (otherWrite.address != toWrite.address || otherWrite.size != toWrite.size))
+                {
+                    partlyOverlapped = true;
+                    break;
+                }
+            }
+            if (result != SetupResult_Ok)
+            {
+                return result;
+            }
+
+            bool sameValue = false;
+            LRF_ConfigIterator_init(&it, from, phyFeatures);
+            while (!partlyOverlapped &&
+                   ((result = LRF_ConfigIterator_next(&it, &otherWrite)) == SetupResult_Ok) && otherWrite.size != 0)
+            {
+                if (LRF_ConfigDelta_overlaps(&otherWrite, &toWrite))
+                {
+                    /* The last overlapping write decides the final contents */
+                    sameValue = (otherWrite.address == toWrite.address) &&
+                                (otherWrite.size == toWrite.size) &&
+                                (otherWrite.value == toWrite.value);
+                }
+            }
+            if (result != SetupResult_Ok)
+            {
+                return result;
+            }
+            needed = !sameValue;
+        }
+
+        if (needed)
+        {
+            if (writes != NULL)
+            {
+                if (numWrites >= maxWrites)
+                {
+                    return SetupResult_ErrorConfigLen;
+                }
+                /* Bit 0 of the address marks a 16-bit write */
+                writes[numWrites].address = toWrite.address | ((toWrite.size == 2) ? 1U : 0U);
+                writes[numWrites].value   = toWrite.value;
+            }
+            numWrites++;
+        }
+        toIndex++;
+    }
+
+    delta->numWrites = numWrites;
+
+    return result;
+}
+
+void LRF_ConfigDelta_register(LRF_ConfigDelta *delta)
+{
+    uintptr_t key = HwiP_disable();
+    delta->next = lrfConfigDeltaList;
+    lrfConfigDeltaList = delta;
+    HwiP_restore(key);
+}
+
+void LRF_ConfigDelta_unregister(LRF_ConfigDelta *delta)
+{
+    uintptr_t key = HwiP_disable();
+    LRF_ConfigDelta **link = &lrfConfigDeltaList;
+    while (*link != NULL)
+    {
+        if (*link == delta)
+        {
+            *link = delta->next;
+            break;
+        }
+        link = &(*link)->next;
+    }
+    HwiP_restore(key);
+}
+
+const LRF_ConfigDelta *LRF_ConfigDelta_find(const LRF_Config *from, const LRF_Config *to, uint16_t phyFeatures)
+{
+    for (const LRF_ConfigDelta *delta = lrfConfigDeltaList; delta != NULL; delta = delta->next)
+    {
+        if (delta->from == from && delta->to == to && delta->phyFeatures == phyFeatures && delta->writes != NULL)
+        {
+            return delta;
+        }
+    }
+    return NULL;
+}
+
+void LRF_ConfigDelta_apply(const LRF_ConfigDelta *delta)
+{
+    const LRF_ConfigDeltaWrite *write = delta->writes;
+
+    for (uint32_t i = 0; i < delta->numWrites; i++, write++)
+    {
+        uintptr_t address = write->address;
+        if ((address & 1U) != 0U)
+        {
+#if defined DeviceFamily_CC27XX || defined DeviceFamily_CC1404_CC1407
+            HWREGH_WRITE_LRF(address & ~(uintptr_t)1U) = (uint16_t)write->value;
+#else
+            *(volatile uint16_t *)(address & ~(uintptr_t)1U) = (uint16_t)write->value;
+#endif //DeviceFamily_CC27XX || DeviceFamily_CC1404_CC1407
+        }
+        else
+        {
+#if defined DeviceFamily_CC27XX || defined DeviceFamily_CC1404_CC1407
+            HWREG_WRITE_LRF(address) = write->value;
+#else
+            *(volatile uint32_t *)address = write->value;
+#endif //DeviceFamily_CC27XX || DeviceFamily_CC1404_CC1407
+        }
+    }
+}
+#endif
+
 LRF_TxPowerTable_Entry LRF_TxPowerTable_findValue(const LRF_TxPowerTable *table, LRF_TxPowerTable_Index powerLevel)
 {
     if (powerLevel.rawValue == LRF_TxPower_Use_Raw.rawValue)
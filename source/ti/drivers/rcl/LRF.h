@@ -254,6 +254,72 @@ LRF_SetupResult LRF_applySettings(LRF_ConfigWord         *config,
                                   LRF_ApplySettingsState *state,
                                   int32_t                 bufferAvailWords);
 
+#ifndef BUFFER_SPLIT_SUPPORT
+/**
+ *  @brief One register or RAM write of a configuration delta
+ *
+ *  Bit 0 of @c address is set for a 16-bit write.
+ */
+typedef struct LRF_ConfigDeltaWrite_s {
+    uintptr_t address;
+    uint32_t  value;
+} LRF_ConfigDeltaWrite;
+
+/**
+ *  @brief Writes needed to go from one configured PHY to another
+ *
+ *  A delta holds the writes that differ between the full register configuration
+ *  of @c from and of @c to with the given PHY features. When registered, it is
+ *  used by LRF_setupRadio() instead of applying the full configuration of @c to
+ *  if the radio is already configured with @c from. TOPsm images are still loaded
+ *  if they differ, and trim is applied as for a full setup.
+ *
+ *  Registers that command handlers modify at runtime are only restored if they
+ *  are part of the delta; such registers should be included in the configuration
+ *  of both PHYs with different values, or the delta should not be used.
+ */
+typedef struct LRF_ConfigDelta_s LRF_ConfigDelta;
+struct LRF_ConfigDelta_s {
+    LRF_ConfigDelta      *next;        /*!< Next registered delta; set by LRF_ConfigDelta_register() */
+    const LRF_Config     *from;        /*!< Configuration assumed to be applied */
+    const LRF_Config     *to;          /*!< Configuration to apply */
+    LRF_ConfigDeltaWrite *writes;      /*!< Writes needed, or NULL if only counted */
+    uint16_t              numWrites;   /*!< Number of writes needed */
+    uint16_t              phyFeatures; /*!< PHY features used for both configurations */
+};
+
+/**
+ *  @brief Find the writes needed to change the configuration from one PHY to another
+ *
+ *  @param  delta       Delta to initialize
+ *  @param  from        Configuration assumed to be applied
+ *  @param  to          Configuration to apply
+ *  @param  phyFeatures PHY features used for both configurations
+ *  @param  writes      Buffer for the writes, or NULL to only count them in delta->numWrites
+ *  @param  maxWrites   Number of entries in @c writes
+ *
+ *  @return SetupResult_Ok on success, SetupResult_ErrorConfigLen if @c writes is too small,
+ *          or the error found while parsing either configuration
+ */
+LRF_SetupResult LRF_ConfigDelta_init(LRF_ConfigDelta      *delta,
+                                     const LRF_Config     *from,
+                                     const LRF_Config     *to,
+                                     uint16_t              phyFeatures,
+                                     LRF_ConfigDeltaWrite *writes,
+                                     uint32_t              maxWrites);
+void LRF_ConfigDelta_register(LRF_ConfigDelta *delta);
+void LRF_ConfigDelta_unregister(LRF_ConfigDelta *delta);
+const LRF_ConfigDelta *LRF_ConfigDelta_find(const LRF_Config *from, const LRF_Config *to, uint16_t phyFeatures);
+void LRF_ConfigDelta_apply(const LRF_ConfigDelta *delta);
+/**
+ *  @brief Check if a location may be modified after the configuration is applied
+ *
+ *  Locations modified by trim or temperature compensation are never skipped
+ *  in a configuration delta.
+ */
+bool LRF_ConfigDelta_isVolatile(uintptr_t address, uint32_t size);
+#endif
+
 void LRF_enable(void);
 void LRF_disable(void);
 void LRF_powerDown(void);
@@ -40,6 +40,7 @@
 #include <ti/drivers/rcl/RCL_Scheduler.h>
 #include <ti/drivers/rcl/RCL_Command.h>
 #include <ti/drivers/rcl/RCL_Feature.h>
+#include <ti/drivers/rcl/RCL_Profiling.h>
 #include <ti/log/Log.h>
 #include <ti/drivers/dpl/HwiP.h>
 
@@ -137,6 +138,7 @@ static struct {
     const LRF_TOPsmImage   *pbeLoaded;
     const LRF_TOPsmImage   *mceLoaded;
     const LRF_TOPsmImage   *rfeLoaded;
+    const LRF_Config       *configured;
     uint16_t                phyFeatures;
     int16_t                 lastTrimTemperature;
     LRF_TxPowerTable_Entry  currentTxPower;
@@ -208,9 +210,30 @@ LRF_SetupResult LRF_setupRadio(const LRF_Config *lrfConfig, uint16_t phyFeatures
     if ((result == SetupResult_Ok) && (lrfConfig->regConfigList != NULL))
     {
         LRF_ApplySettingsBase includeBase;
+        const LRF_ConfigDelta *delta = NULL;
 
-        if (lrfState < RadioState_Configured)
+        if (lrfState == RadioState_Configured && lrfPhyState.configured != lrfConfig &&
+            phyFeatures == lrfPhyState.phyFeatures)
         {
+            delta = LRF_ConfigDelta_find(lrfPhyState.configured, lrfConfig, phyFeatures);
+        }
+
+        if (delta != NULL)
+        {
+            /* Only write what differs from the configured PHY */
+            Log_printf(LogModule_RCL, Log_INFO, "LRF_setupRadio: Applying configuration delta of %d writes", delta->numWrites);
+            includeBase = LRF_ApplySettings_NoBase;
+            trimUpdate = trimFullUpdate;
+            RCL_PROFILING_TRACE_START(applyStart, RCL_ProfilingEvent_ApplySettingsStart, RCL_PROFILING_NO_CMD);
+            LRF_ConfigDelta_apply(delta);
+            RCL_PROFILING_TRACE_END(applyStart, RCL_ProfilingEvent_ApplySettingsEnd, RCL_PROFILING_NO_CMD, LRF_ConfigDelta_apply);
+        }
+        else if (lrfState < RadioState_Configured || lrfPhyState.configured != lrfConfig)
+        {
+            /* A different configuration without a usable delta, e.g. with
+             * other PHY features than the configured PHY, needs its base
+             * settings written
+             */
             includeBase = LRF_ApplySettings_IncludeBase;
             Log_printf(LogModule_RCL, Log_INFO, "LRF_setupRadio: Performing full setup");
             trimUpdate = trimFullUpdate;
@@ -224,12 +247,14 @@ LRF_SetupResult LRF_setupRadio(const LRF_Config *lrfConfig, uint16_t phyFeatures
                 trimUpdate = trimPartialUpdate;
             }
         }
-        if (includeBase == LRF_ApplySettings_IncludeBase || phyFeatures != lrfPhyState.phyFeatures)
+        if (delta == NULL &&
+            (includeBase == LRF_ApplySettings_IncludeBase || phyFeatures != lrfPhyState.phyFeatures))
         {
             LRF_ApplySettingsState settingsState;
             /* Initialize setup state */
             lrfPhyState.phyFeatures = phyFeatures;
             LRF_initSettingsState(&settingsState, includeBase, phyFeatures);
+            RCL_PROFILING_TRACE_START(applyStart, RCL_ProfilingEvent_ApplySettingsStart, RCL_PROFILING_NO_CMD);
             for (uint32_t i = 0; i < lrfConfig->regConfigList->numEntries; i++)
             {
                 LRF_ConfigWord *config = lrfConfig->regConfigList->entries[i];
@@ -241,7 +266,9 @@ LRF_SetupResult LRF_setupRadio(const LRF_Config *lrfConfig, uint16_t phyFeatures
                     break;
                 }
             }
+            RCL_PROFILING_TRACE_END(applyStart, RCL_ProfilingEvent_ApplySettingsEnd, RCL_PROFILING_NO_CMD, LRF_applySettings);
         }
+        lrfPhyState.configured = (result == SetupResult_Ok) ? lrfConfig : NULL;
         /* Invalidate RSSI value to cover the case in which no RX has run before. */
         HWREG_WRITE_LRF(LRFDRFE_BASE + LRFDRFE_O_RSSI) = LRF_RSSI_INVALID;
         /* Set PBE to writing FIFO commands to FCMD */
@@ -289,6 +316,53 @@ bool LRF_imagesNeedUpdate(const LRF_Config *lrfConfig)
             (lrfPhyState.rfeLoaded != lrfConfig->rfeImage && lrfConfig->rfeImage != NULL));
 }
 
+bool LRF_ConfigDelta_isVolatile(uintptr_t address, uint32_t size)
+{
+    /* Registers modified by trim, temperature compensation, or read-modify-write at runtime */
+    static const uint16_t rfeRegs[] = {
+#ifndef DeviceFamily_CC27XX
+        LRFDRFE_O_PA0,
+#endif
+        LRFDRFE_O_ATSTREFH, LRFDRFE_O_LNA, LRFDRFE_O_IFAMPRFLDO, LRFDRFE_O_IFADCALDO,
+        LRFDRFE_O_IFADCDLDO, LRFDRFE_O_IFADCQUANT, LRFDRFE_O_IFADC0, LRFDRFE_O_IFADC1,
+        LRFDRFE_O_IFADCLF, LRFDRFE_O_TDCLDO, LRFDRFE_O_DCO, LRFDRFE_O_DCOLDO0,
+        LRFDRFE_O_RSSIOFFSET, LRFDRFE_O_SPARE0, LRFDRFE_O_SPARE1, LRFDRFE_O_SPARE5,
+        LRFDRFE_O_MOD0,
+    };
+    static const uint16_t rfeRamRegs[] = {
+#ifdef DeviceFamily_CC27XX
+        RFE_COMMON_RAM_O_PATRIM01, RFE_COMMON_RAM_O_PATRIM23,
+#endif
+        RFE_COMMON_RAM_O_IFAMPRFLDODEFAULT, RFE_COMMON_RAM_O_DIVLDOF, RFE_COMMON_RAM_O_DIVLDOI,
+        RFE_COMMON_RAM_O_DIVLDOIOFF, RFE_COMMON_RAM_O_PHYRSSIOFFSET, RFE_COMMON_RAM_O_RTRIMMIN,
+        RFE_COMMON_RAM_O_RTRIMOFF, RFE_COMMON_RAM_O_SPARE0SHADOW, RFE_COMMON_RAM_O_SPARE1SHADOW,
+        RFE_COMMON_RAM_O_AGCINFO,
+    };
+
+    if (address < LRFDMDM_BASE + LRFDMDM_O_DEMIQMC0 + sizeof(uint32_t) &&
+        LRFDMDM_BASE + LRFDMDM_O_DEMIQMC0 < address + size)
+    {
+        return true;
+    }
+    for (uint32_t i = 0; i < sizeof(rfeRegs) / sizeof(rfeRegs[0]); i++)
+    {
+        uintptr_t regAddress = LRFDRFE_BASE + rfeRegs[i];
+        if (address < regAddress + sizeof(uint32_t) && regAddress < address + size)
+        {
+            return true;
+        }
+    }
+    for (uint32_t i = 0; i < sizeof(rfeRamRegs) / sizeof(rfeRamRegs[0]); i++)
+    {
+        uintptr_t regAddress = LRFD_RFERAM_BASE + rfeRamRegs[i];
+        if (address < regAddress + sizeof(uint16_t) && regAddress < address + size)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 static void LRF_applyTrim(const LRF_TrimDef *trimDef, const LRF_SwConfig *swConfig)
 {
 
@@ -42,6 +42,7 @@
 #include <ti/drivers/rcl/RCL.h>
 #include <ti/drivers/rcl/LRF.h>
 #include <ti/drivers/rcl/RCL_Scheduler.h>
+#include <ti/drivers/rcl/RCL_CommandQueue.h>
 #include <ti/drivers/rcl/RCL_Profiling.h>
 #include <ti/drivers/rcl/RCL_Gpio.h>
 #include <ti/drivers/rcl/RCL_Debug.h>
@@ -55,6 +56,10 @@
 /* Globals */
 static bool isInitialized = 0;
 static RCL_Command *rclNextCmd = NULL;
+#if RCL_COMMAND_QUEUE_SIZE > 0
+/* Commands waiting behind rclNextCmd */
+static RCL_CommandQueue rclCommandQueue;
+#endif
 RCL rclState;
 
 static void rclCommandHwi(void);
@@ -62,6 +67,11 @@ static void rclDispatchHwi(void);
 static void rclSchedulerHwi(void);
 static void rclPowerNotify(RCL_PowerEvent eventType);
 static RCL_CommandStatus rclStop(RCL_Command_Handle c, RCL_StopType stopType, RCL_SchedulerStopReason stopReason);
+static void rclCancelSchedStop(void);
+#if RCL_COMMAND_QUEUE_SIZE > 0
+static uint32_t rclCommandQueueStartTime(const RCL_Command *cmd, uint32_t now);
+static uint32_t rclCommandQueueReadyTime(uint32_t now);
+#endif
 
 /* Hooks */
 
@@ -120,6 +130,7 @@ static void rclCommandHwi(void)
     {
         return;
     }
+    RCL_PROFILING_TRACE_EVENT(RCL_ProfilingEvent_CommandHwiStart, cmd->cmdId);
 
     RCL_Client *client = cmd->runtime.client;
 
@@ -199,14 +210,27 @@ static void rclCommandHwi(void)
         LRF_RadioState lrfState = rclState.lrfState;
         if (rclState.lrfConfig != client->lrfConfig)
         {
-            /* Different config than last time: Ensure settings are reloaded */
+            /* Different config than last time: Ensure settings are reloaded,
+             * unless a registered delta gives the writes needed. If the delta
+             * can't be used, LRF_setupRadio applies the full configuration.
+             */
+            const LRF_Config *prevConfig = rclState.lrfConfig;
             rclState.lrfConfig = client->lrfConfig;
+#ifndef BUFFER_SPLIT_SUPPORT
+            if (lrfState > RadioState_ImagesLoaded &&
+                (prevConfig == NULL ||
+                 LRF_ConfigDelta_find(prevConfig, rclState.lrfConfig, cmd->phyFeatures) == NULL))
+#else
+            (void) prevConfig;
             if (lrfState > RadioState_ImagesLoaded)
+#endif
             {
                 lrfState = RadioState_ImagesLoaded;
             }
         }
+        RCL_PROFILING_TRACE_START(setupStart, RCL_ProfilingEvent_SetupStart, cmd->cmdId);
         LRF_SetupResult result = LRF_setupRadio(rclState.lrfConfig, cmd->phyFeatures, lrfState);
+        RCL_PROFILING_TRACE_END(setupStart, RCL_ProfilingEvent_SetupEnd, cmd->cmdId, LRF_setupRadio);
         if (result != SetupResult_Ok)
         {
             Log_printf(LogModule_RCL, Log_ERROR, "rclCommandHwi: Setup failed with code %1d", result);
@@ -230,7 +254,9 @@ static void rclCommandHwi(void)
     /*** 3. Invoke handler FSM with new events */
     if (cmd->status >= RCL_CommandStatus_Scheduled && cmd->status < RCL_CommandStatus_Finished)
     {
+        RCL_PROFILING_TRACE_START(handlerStart, RCL_ProfilingEvent_HandlerStart, cmd->cmdId);
         rclEventsOut = cmd->runtime.handler(cmd, lrfEvents, rclEventsIn);
+        RCL_PROFILING_TRACE_END(handlerStart, RCL_ProfilingEvent_HandlerEnd, cmd->cmdId, cmd->runtime.handler);
     }
     Log_printf(LogModule_RCL, Log_VERBOSE, "rclCommandHwi: RCL out: 0x%08X", rclEventsOut.value);
 
@@ -249,7 +275,9 @@ static void rclCommandHwi(void)
         /* Rerun the radio setup */
         LRF_RadioState lrfState = rclState.lrfState;
 
+        RCL_PROFILING_TRACE_START(setupStart, RCL_ProfilingEvent_SetupStart, cmd->cmdId);
         LRF_SetupResult result = LRF_setupRadio(rclState.lrfConfig, rclSchedulerState.requestedPhyFeatures, lrfState);
+        RCL_PROFILING_TRACE_END(setupStart, RCL_ProfilingEvent_SetupEnd, cmd->cmdId, LRF_setupRadio);
         if (result != SetupResult_Ok)
         {
             Log_printf(LogModule_RCL, Log_ERROR, "rclCommandHwi: Setup failed with code %1d", result);
@@ -303,6 +331,7 @@ static void rclCommandHwi(void)
         }
         hal_trigger_dispatch_fsm();
     }
+    RCL_PROFILING_TRACE_EVENT(RCL_ProfilingEvent_CommandHwiEnd, cmd->cmdId);
 }
 
 static void rclDispatchHwi(void)
@@ -315,6 +344,7 @@ static void rclDispatchHwi(void)
            finishes the command during this ISR. If so, the extra IRQ can be ignored. */
         return;
     }
+    RCL_PROFILING_TRACE_EVENT(RCL_ProfilingEvent_DispatchHwiStart, currCmd->cmdId);
     RCL_Client *currClient = currCmd->runtime.client;
     RCL_Debug_assert(currClient != NULL);
 
@@ -390,6 +420,7 @@ static void rclDispatchHwi(void)
     {
         callback(currCmd, lrfEvents, rclEvents);
     }
+    RCL_PROFILING_TRACE_EVENT(RCL_ProfilingEvent_DispatchHwiEnd, currCmd->cmdId);
 }
 
 /*
@@ -397,7 +428,19 @@ static void rclDispatchHwi(void)
  */
 __attribute__((weak)) void RCL_clearNextCommandHook()
 {
+#if RCL_COMMAND_QUEUE_SIZE > 0
+    /* Promote the first queued command, and let the scheduler plan it */
+    uintptr_t key = HwiP_disable();
+    rclNextCmd = RCL_CommandQueue_pop(&rclCommandQueue, rclCommandQueueReadyTime(RCL_Scheduler_getCurrentTime()));
+    if (rclNextCmd != NULL)
+    {
+        rclNextCmd->status = RCL_CommandStatus_Scheduled;
+        hal_trigger_scheduler_fsm();
+    }
+    HwiP_restore(key);
+#else
     rclNextCmd = NULL;
+#endif
 }
 
 /*
@@ -413,11 +456,31 @@ __attribute__((weak)) RCL_Command* RCL_getNextCommandHook()
  */
 __attribute__((weak)) RCL_StopType RCL_policyHook(RCL_Command *currentCmd, RCL_Command *newCmd)
 {
+#if RCL_COMMAND_QUEUE_SIZE > 0
+    if (currentCmd != NULL)
+    {
+        uint8_t newPriority = newCmd->runtime.client->priority;
+        uint8_t currentPriority = currentCmd->runtime.client->priority;
+
+        /* Never interrupt commands of clients with higher priority. Between equal
+         * priorities, the conflict policy applies as without the queue, unless it
+         * asks to only interrupt lower priorities.
+         */
+        if ((newPriority < currentPriority) ||
+            ((newPriority == currentPriority) &&
+             (newCmd->conflictPolicy == RCL_ConflictPolicy_InterruptLowerPriority)))
+        {
+            return RCL_StopType_None;
+        }
+    }
+#else
     (void) currentCmd;
+#endif
 
     switch(newCmd->conflictPolicy)
     {
         case RCL_ConflictPolicy_AlwaysInterrupt:
+        case RCL_ConflictPolicy_InterruptLowerPriority:
             return RCL_StopType_Hard;
         case RCL_ConflictPolicy_Polite:
             return RCL_StopType_Graceful;
@@ -518,12 +581,14 @@ static void rclSchedulerHwi(void)
     /* the next command queue based on the priority table that has been maintained*/
     RCL_Command *nextCmd = RCL_getNextCommandHook();
 
+    RCL_PROFILING_TRACE_EVENT(RCL_ProfilingEvent_SchedulerHwiStart, (nextCmd != NULL) ? nextCmd->cmdId : RCL_PROFILING_NO_CMD);
     Log_printf(LogModule_RCL, Log_VERBOSE, "rclSchedulerHwi: SchedulerHwi nextCmd: 0x%08X", nextCmd);
 
     /* If nothing is pending, pack up */
     if (NULL == nextCmd)
     {
         RCL_Profiling_eventHook(RCL_ProfilingEvent_PostprocStop);
+        RCL_PROFILING_TRACE_EVENT(RCL_ProfilingEvent_SchedulerHwiEnd, RCL_PROFILING_NO_CMD);
         return;
     }
 
@@ -533,6 +598,7 @@ static void rclSchedulerHwi(void)
     /* If the command is cleared in the hook, we are done. Make sure the next command is populated from RCL_getNextCommandHook */
     if (nextCmd != RCL_getNextCommandHook())
     {
+        RCL_PROFILING_TRACE_EVENT(RCL_ProfilingEvent_SchedulerHwiEnd, nextCmd->cmdId);
         return;
     }
 
@@ -547,6 +613,7 @@ static void rclSchedulerHwi(void)
                                 rclSchedulerState.currCmd->status);
         /* A finished command should not be the current command */
         RCL_Debug_assert(rclSchedulerState.currCmd->status < RCL_CommandStatus_Finished);
+        RCL_PROFILING_TRACE_EVENT(RCL_ProfilingEvent_SchedulerHwiEnd, nextCmd->cmdId);
         return;
     }
 
@@ -558,6 +625,7 @@ static void rclSchedulerHwi(void)
     RCL_clearNextCommandHook();
     memset((void *)&rclSchedulerState, 0, sizeof(rclSchedulerState));
     rclSchedulerState.currCmd = nextCmd;
+    RCL_PROFILING_TRACE_EVENT(RCL_ProfilingEvent_SchedulerDecision, nextCmd->cmdId);
     /* Set up callback interrupts */
     hal_init_dispatch_radio_interrupts(nextCmd->runtime.lrfCallbackMask.value);
 
@@ -592,6 +660,7 @@ static void rclSchedulerHwi(void)
         /* SetupFSM triggers command handler due to timer */
         Log_printf(LogModule_RCL, Log_VERBOSE, "rclSchedulerHwi: Wakeup scheduled at 0x%08X (.25µs) with margin subtracted from deltaTime: %d µs", rclSchedulerState.currCmd->timing.absStartTime, deltaTime >> 2);
     }
+    RCL_PROFILING_TRACE_EVENT(RCL_ProfilingEvent_SchedulerHwiEnd, nextCmd->cmdId);
 }
 
 /* Power event routine */
@@ -653,6 +722,9 @@ void RCL_init(void)
             .lrfState = RadioState_Down,
             .lrfConfig = NULL,
         };
+#if RCL_COMMAND_QUEUE_SIZE > 0
+        RCL_CommandQueue_init(&rclCommandQueue);
+#endif
         hal_init_fsm(rclDispatchHwi, rclSchedulerHwi, rclCommandHwi);
         /* Ensure temperature compensation of TX output power and RF Trims */
         hal_temperature_init();
@@ -732,6 +804,17 @@ void RCL_close(RCL_Handle h)
 {
     rclState.numClients -= 1;
 
+#if RCL_COMMAND_QUEUE_SIZE > 0
+    /* Drop commands of the client that never got to start */
+    uintptr_t key = HwiP_disable();
+    RCL_Command *cmd;
+    while ((cmd = RCL_CommandQueue_removeClient(&rclCommandQueue, h)) != NULL)
+    {
+        cmd->status = RCL_CommandStatus_DescheduledApi;
+    }
+    HwiP_restore(key);
+#endif
+
     if (h->lrfConfig == rclState.lrfConfig)
     {
         /* Closing a client using the current LRF config */
@@ -758,6 +841,75 @@ void RCL_close(RCL_Handle h)
  */
 __attribute__((weak)) RCL_CommandStatus RCL_submitHook(RCL_Handle h, RCL_Command *c)
 {
+#if RCL_COMMAND_QUEUE_SIZE > 0
+    uintptr_t key = HwiP_disable();
+    RCL_Command *nextCmd = rclNextCmd;
+
+    if (nextCmd == NULL)
+    {
+        /* Schedule command */
+        rclNextCmd = c;
+        c->status = RCL_CommandStatus_Scheduled;
+    }
+    else
+    {
+        uint32_t now = RCL_Scheduler_getCurrentTime();
+        uint32_t startTime = rclCommandQueueStartTime(c, now);
+        uint32_t nextStartTime = rclCommandQueueStartTime(nextCmd, now);
+        uint8_t nextPriority = nextCmd->runtime.client->priority;
+        uint32_t readyTime = rclCommandQueueReadyTime(now);
+        uint32_t plannedStartTime = ((int32_t)(startTime - readyTime) > 0) ? startTime : readyTime;
+        uint32_t plannedNextStartTime = ((int32_t)(nextStartTime - readyTime) > 0) ? nextStartTime : readyTime;
+
+        /* Admission control: a command that can't be delayed must not overlap
+         * a pending command of the same or higher priority
+         */
+        if (!c->allowDelay &&
+            ((nextPriority >= h->priority &&
+              RCL_CommandQueue_overlaps(startTime, RCL_CommandQueue_getDuration(c),
+                                        nextStartTime, RCL_CommandQueue_getDuration(nextCmd))) ||
+             RCL_CommandQueue_findConflict(&rclCommandQueue, startTime, RCL_CommandQueue_getDuration(c), h->priority) != NULL))
+        {
+            Log_printf(LogModule_RCL, Log_VERBOSE, "RCL_submitHook: Command 0x%08X rejected due to overlap", c);
+            c->status = RCL_CommandStatus_RejectedStart;
+        }
+        else if ((RCL_CommandQueue_isBefore(startTime, h->priority, nextStartTime, nextPriority) &&
+                  !RCL_CommandQueue_mustYield(plannedStartTime, RCL_CommandQueue_getDuration(c), h->priority,
+                                              nextStartTime, nextPriority)) ||
+                 RCL_CommandQueue_mustYield(plannedNextStartTime, RCL_CommandQueue_getDuration(nextCmd), nextPriority,
+                                            startTime, h->priority))
+        {
+            /* New command goes first; put the planned next command back in the queue */
+            if (!RCL_CommandQueue_insert(&rclCommandQueue, nextCmd, nextStartTime, nextPriority))
+            {
+                c->status = RCL_CommandStatus_Error_CommandQueueFull;
+            }
+            else
+            {
+                nextCmd->status = RCL_CommandStatus_Queued;
+                if (rclSchedulerState.nextWantsStop)
+                {
+                    /* Stop of the running command was planned for the old next command */
+                    rclSchedulerState.nextWantsStop = false;
+                    rclCancelSchedStop();
+                }
+                rclNextCmd = c;
+                c->status = RCL_CommandStatus_Scheduled;
+            }
+        }
+        else if (RCL_CommandQueue_insert(&rclCommandQueue, c, startTime, h->priority))
+        {
+            c->status = RCL_CommandStatus_Queued;
+        }
+        else
+        {
+            c->status = RCL_CommandStatus_Error_CommandQueueFull;
+        }
+    }
+    HwiP_restore(key);
+
+    return c->status;
+#else
     (void) h;
     /* Reject if already pending, can't be bothered with list  */
     if (RCL_getNextCommandHook() != NULL)
@@ -771,6 +923,7 @@ __attribute__((weak)) RCL_CommandStatus RCL_submitHook(RCL_Handle h, RCL_Command
     c->status = RCL_CommandStatus_Scheduled;
 
     return RCL_CommandStatus_Scheduled;
+#endif
 }
 
 /*
@@ -858,41 +1011,21 @@ static RCL_CommandStatus rclStop(RCL_Command_Handle c, RCL_StopType stopType, RC
 
     if (cmd->status == RCL_CommandStatus_Queued)
     {
+#if RCL_COMMAND_QUEUE_SIZE > 0
+        /* Command waiting behind the next command; it has not affected the running command */
+        if (RCL_CommandQueue_remove(&rclCommandQueue, cmd))
+        {
+            cmd->status = (stopReason == RCL_SchedulerStopReason_Api) ? RCL_CommandStatus_DescheduledApi :
+                                                                        RCL_CommandStatus_DescheduledScheduling;
+            HwiP_restore(key);
+            Log_printf(LogModule_RCL, Log_VERBOSE, "rclStop: Stop called with type: %d, resulting status: 0x%02X", stopType, cmd->status);
+            return cmd->status;
+        }
+#endif
         RCL_clearNextCommandHook();
         cmd->status = RCL_Scheduler_findStopStatus(RCL_StopType_DescheduleOnly);
         /* Cancel scheduler stop of current command */
-        RCL_StopType stopType;
-        /* In the unlikely case that the cmd stop time was very shortly after the canceled sched stop time,
-        the event could be missed and needs to be handled */
-        stopType = RCL_Scheduler_cancelSchedStopTime(&rclSchedulerState.hardStopInfo);
-        if (stopType == RCL_StopType_Hard && rclSchedulerState.currCmd != NULL)
-        {
-            /* Stop currently running command (not the one being canceled) immediately,
-             * as command stop time must have been passed */
-            if (rclSchedulerState.hardStopInfo.apiStopEnabled == 0)
-            {
-                LRF_sendHardStop();
-                rclSchedulerState.hardStopInfo.apiStopEnabled = 1;
-            }
-            RCL_Scheduler_postEvent(rclSchedulerState.currCmd, RCL_EventHardStop);
-        }
-        else
-        {
-            stopType = RCL_Scheduler_cancelSchedStopTime(&rclSchedulerState.gracefulStopInfo);
-            if (stopType == RCL_StopType_Graceful && rclSchedulerState.currCmd != NULL)
-            {
-                /* Stop currently running command (not the one being canceled) gracefully now,
-                 * as command stop time must have been passed */
-                /* Do not send graceful stop if any stop is already sent */
-                if (rclSchedulerState.gracefulStopInfo.apiStopEnabled == 0 &&
-                    rclSchedulerState.hardStopInfo.apiStopEnabled == 0)
-                {
-                    LRF_sendGracefulStop();
-                    rclSchedulerState.gracefulStopInfo.apiStopEnabled = 1;
-                }
-                RCL_Scheduler_postEvent(rclSchedulerState.currCmd, RCL_EventGracefulStop);
-            }
-        }
+        rclCancelSchedStop();
     }
     else
     {
@@ -937,6 +1070,82 @@ static RCL_CommandStatus rclStop(RCL_Command_Handle c, RCL_StopType stopType, RC
     return cmd->status;
 }
 
+#if RCL_COMMAND_QUEUE_SIZE > 0
+/*
+ *  ======== rclCommandQueueStartTime ========
+ */
+static uint32_t rclCommandQueueStartTime(const RCL_Command *cmd, uint32_t now)
+{
+    return (cmd->scheduling == RCL_Schedule_Now) ? now : cmd->timing.absStartTime;
+}
+
+/*
+ *  ======== rclCommandQueueReadyTime ========
+ */
+static uint32_t rclCommandQueueReadyTime(uint32_t now)
+{
+    /* Assume the command ahead of the queue, if any, occupies its whole window */
+    RCL_Command *aheadCmd = (rclSchedulerState.currCmd != NULL) ? rclSchedulerState.currCmd : rclNextCmd;
+    if (aheadCmd == NULL)
+    {
+        return now;
+    }
+    uint32_t startTime = rclCommandQueueStartTime(aheadCmd, now);
+    if ((int32_t)(startTime - now) < 0)
+    {
+        startTime = now;
+    }
+    return startTime + RCL_CommandQueue_getDuration(aheadCmd);
+}
+#endif
+
+/*
+ *  ======== rclCancelSchedStop ========
+ */
+static void rclCancelSchedStop(void)
+{
+    RCL_StopType stopType;
+    /* In the unlikely case that the cmd stop time was very shortly after the canceled sched stop time,
+    the event could be missed and needs to be handled */
+    stopType = RCL_Scheduler_cancelSchedStopTime(&rclSchedulerState.hardStopInfo);
+    if (stopType == RCL_StopType_Hard && rclSchedulerState.currCmd != NULL)
+    {
+        /* Stop currently running command (not the one being canceled) immediately,
+         * as command stop time must have been passed */
+        if (rclSchedulerState.hardStopInfo.apiStopEnabled == 0)
+        {
+            LRF_sendHardStop();
+            rclSchedulerState.hardStopInfo.apiStopEnabled = 1;
+        }
+        RCL_Scheduler_postEvent(rclSchedulerState.currCmd, RCL_EventHardStop);
+    }
+    else
+    {
+        stopType = RCL_Scheduler_cancelSchedStopTime(&rclSchedulerState.gracefulStopInfo);
+        if (stopType == RCL_StopType_Graceful && rclSchedulerState.currCmd != NULL)
+        {
+            /* Stop currently running command (not the one being canceled) gracefully now,
+             * as command stop time must have been passed */
+            /* Do not send graceful stop if any stop is already sent */
+            if (rclSchedulerState.gracefulStopInfo.apiStopEnabled == 0 &&
+                rclSchedulerState.hardStopInfo.apiStopEnabled == 0)
+            {
+                LRF_sendGracefulStop();
+                rclSchedulerState.gracefulStopInfo.apiStopEnabled = 1;
+            }
+            RCL_Scheduler_postEvent(rclSchedulerState.currCmd, RCL_EventGracefulStop);
+        }
+    }
+}
+
+/*
+ *  ======== RCL_setClientPriority ========
+ */
+void RCL_setClientPriority(RCL_Handle h, uint8_t priority)
+{
+    h->priority = priority;
+}
+
 /*
  *  ======== RCL_readRssi ========
  */
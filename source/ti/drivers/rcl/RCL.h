@@ -143,6 +143,22 @@ RCL_CommandStatus RCL_Command_pend(RCL_Command_Handle c);
  */
 RCL_CommandStatus RCL_Command_stop(RCL_Command_Handle c, RCL_StopType stopType);
 
+/**
+ * @brief Set the priority of the commands of a client
+ *
+ * Only used when RCL is built with a command queue (%RCL_COMMAND_QUEUE_SIZE > 0).
+ * Commands of a client are never interrupted by commands of a client with lower
+ * priority, and take precedence over such commands when submitted with
+ * overlapping start to hard stop windows. Commands of clients with equal priority
+ * interrupt each other according to their conflict policy, as without the queue;
+ * %RCL_ConflictPolicy_InterruptLowerPriority makes a command wait instead.
+ * Clients have priority 0 when opened.
+ *
+ * @param[in] h - Client handle
+ * @param[in] priority - Priority; higher value means higher priority
+ */
+void RCL_setClientPriority(RCL_Handle h, uint8_t priority);
+
 /**
  * @brief Get the last valid RSSI value.
  *
@@ -51,6 +51,8 @@
 
 static bool RxEntry_isAtEnd(RCL_MultiBuffer *multiBuffer, uint16_t curIndex);
 static void List_consumeAndStore(List_List *list, List_List *consumedBuffers);
+static RCL_Buffer_DataEntry *RxEntry_get(List_List *list, List_List *consumedBuffers,
+                                         RCL_MultiBuffer **leasedBuffer);
 
 /*
  *  ======== RCL_TxBuffer_put ========
@@ -101,6 +103,7 @@ uint8_t *RCL_TxBuffer_init(RCL_Buffer_TxBuffer *buffer, uint32_t numPad, uint32_
 void RCL_MultiBuffer_clear(RCL_MultiBuffer *buffer)
 {
     buffer->state = RCL_BufferStatePending;
+    buffer->numLeases = 0;
     buffer->headIndex = 0;
     buffer->tailIndex = 0;
 }
@@ -131,6 +134,66 @@ void RCL_MultiBuffer_put(List_List *list, RCL_MultiBuffer *elem)
  *  ======== RCL_MultiBuffer_RxEntry_get ========
  */
 RCL_Buffer_DataEntry *RCL_MultiBuffer_RxEntry_get(List_List *list, List_List *consumedBuffers)
+{
+    return RxEntry_get(list, consumedBuffers, NULL);
+}
+
+/*
+ *  ======== RCL_MultiBuffer_RxEntry_lease ========
+ */
+RCL_Buffer_DataEntry *RCL_MultiBuffer_RxEntry_lease(List_List *list, List_List *consumedBuffers,
+                                                    RCL_MultiBuffer **leasedBuffer)
+{
+    RCL_Debug_assert(leasedBuffer != NULL);
+    *leasedBuffer = NULL;
+
+    return RxEntry_get(list, consumedBuffers, leasedBuffer);
+}
+
+/*
+ *  ======== RCL_MultiBuffer_retain ========
+ */
+void RCL_MultiBuffer_retain(RCL_MultiBuffer *multiBuffer)
+{
+    RCL_Debug_assert(multiBuffer != NULL);
+    RCL_Debug_assert(multiBuffer->numLeases > 0 && multiBuffer->numLeases < UINT8_MAX);
+
+    multiBuffer->numLeases++;
+}
+
+/*
+ *  ======== RCL_MultiBuffer_release ========
+ */
+bool RCL_MultiBuffer_release(RCL_MultiBuffer *multiBuffer, List_List *consumedBuffers)
+{
+    bool isReleased = false;
+
+    RCL_Debug_assert(multiBuffer != NULL);
+    RCL_Debug_assert(multiBuffer->numLeases > 0);
+
+    multiBuffer->numLeases--;
+
+    /* A consumed buffer was held back only by the leases */
+    if (multiBuffer->numLeases == 0 && multiBuffer->state == RCL_BufferStateLeased)
+    {
+        multiBuffer->state = RCL_BufferStateFinished;
+        if (consumedBuffers != NULL)
+        {
+            List_put(consumedBuffers, (List_Elem *)multiBuffer);
+        }
+        isReleased = true;
+    }
+
+    return isReleased;
+}
+
+/*
+ *  ======== RxEntry_get ========
+ *  Get the first entry in a MultiBuffer list, optionally leasing the
+ *  MultiBuffer holding it
+ */
+static RCL_Buffer_DataEntry *RxEntry_get(List_List *list, List_List *consumedBuffers,
+                                         RCL_MultiBuffer **leasedBuffer)
 {
     RCL_Buffer_DataEntry *rxEntry = NULL;
     RCL_MultiBuffer *multiBuffer = (RCL_MultiBuffer *)list->head;
@@ -147,6 +210,10 @@ RCL_Buffer_DataEntry *RCL_MultiBuffer_RxEntry_get(List_List *list, List_List *co
             {
                 List_consumeAndStore(list, consumedBuffers);
                 multiBuffer = (RCL_MultiBuffer *) List_head(list);
+                if (multiBuffer == NULL)
+                {
+                    return NULL;
+                }
                 headIndex = 0;
                 tailIndex = multiBuffer->tailIndex;
                 RCL_Debug_assert(multiBuffer->headIndex == 0);
@@ -160,6 +227,13 @@ RCL_Buffer_DataEntry *RCL_MultiBuffer_RxEntry_get(List_List *list, List_List *co
             headIndex += RCL_Buffer_DataEntry_paddedLen(rxEntry->length);
             RCL_Debug_assert(headIndex <= tailIndex);
             multiBuffer->headIndex = headIndex;
+            if (leasedBuffer != NULL)
+            {
+                /* Lease before the buffer may be consumed below */
+                RCL_Debug_assert(multiBuffer->numLeases < UINT8_MAX);
+                multiBuffer->numLeases++;
+                *leasedBuffer = multiBuffer;
+            }
             if (headIndex >= tailIndex)
             {
                 if (multiBuffer->state == RCL_BufferStateFinished)
@@ -447,7 +521,12 @@ static void List_consumeAndStore(List_List *list, List_List *consumedBuffers)
 {
     List_Elem *consumedBuffer = List_get(list);
 
-    if (consumedBuffers != NULL)
+    /* A leased buffer is stored when the last lease is released */
+    if (((RCL_MultiBuffer *)consumedBuffer)->numLeases > 0)
+    {
+        ((RCL_MultiBuffer *)consumedBuffer)->state = RCL_BufferStateLeased;
+    }
+    else if (consumedBuffers != NULL)
     {
         List_put(consumedBuffers, consumedBuffer);
     }
@@ -42,7 +42,8 @@
 typedef enum {
     RCL_BufferStatePending  = 0U, /*!< Buffer is not yet accessed by RCL */
     RCL_BufferStateInUse    = 1U, /*!< Buffer has been accessed by RCL, and may be accessed again */
-    RCL_BufferStateFinished = 2U  /*!< RCL is finished with the buffer. It may be reused or freed. */
+    RCL_BufferStateFinished = 2U, /*!< RCL is finished with the buffer. It may be reused or freed. */
+    RCL_BufferStateLeased   = 3U  /*!< Buffer has been consumed, but entries in it are still leased */
 } RCL_BufferState;
 
 typedef struct RCL_Buffer_TxBuffer_s      RCL_Buffer_TxBuffer;
@@ -86,6 +87,7 @@ struct RCL_Buffer_DataEntry_s {
 struct RCL_MultiBuffer_s {
     List_Elem            __elem__;
     RCL_BufferState      state;       /*!< Buffer state */
+    uint8_t              numLeases;   /*!< Number of leases held on entries in the buffer */
     uint16_t             length;      /*!< Number of bytes in the data field */
     uint16_t             headIndex;   /*!< Number of bytes consumed */
     uint16_t             tailIndex;   /*!< Number of bytes written */
@@ -390,6 +392,71 @@ extern RCL_Buffer_DataEntry *RCL_MultiBuffer_RxEntry_next(RCL_MultiBuffer_ListIn
  */
 extern bool RCL_MultiBuffer_RxEntry_isLast(RCL_MultiBuffer_ListInfo *listInfo);
 
+/**
+ *  @brief  Function to get and lease the first entry in a MultiBuffer list
+ *
+ *  This function works like %RCL_MultiBuffer_RxEntry_get, but also takes a
+ *  lease on the %RCL_MultiBuffer holding the entry. The entry may then be
+ *  used in place, and handed on to other layers, until the lease is
+ *  released with %RCL_MultiBuffer_release. This avoids copying the entry out
+ *  of the MultiBuffer.
+ *
+ *  A consumed MultiBuffer with leases held is removed from the list, so that
+ *  RCL does not write to it, but it is not added to the consumedBuffers list
+ *  until the last lease is released.
+ *
+ *  An entry is always stored within a single MultiBuffer, so the returned
+ *  entry is contiguous.
+ *
+ *  @note This function, %RCL_MultiBuffer_retain and %RCL_MultiBuffer_release
+ *        must be called from the same context as other functions reading
+ *        entries from the list.
+ *
+ *  @param  list A pointer to a linked list of MultiBuffers
+ *
+ *  @param consumedBuffers A pointer to a linked list which will hold
+ *                          the buffers that were consumed and can now
+ *                          be re-used. If NULL, consumed buffers are not
+ *                          reported
+ *
+ *  @param leasedBuffer [out] - The MultiBuffer holding the returned entry,
+ *                              to be passed to %RCL_MultiBuffer_release.
+ *                              Set to NULL if no entry is returned
+ *
+ *  @return Pointer the first entry in the linked list or NULL if empty
+ */
+extern RCL_Buffer_DataEntry *RCL_MultiBuffer_RxEntry_lease(List_List *list, List_List *consumedBuffers,
+                                                           RCL_MultiBuffer **leasedBuffer);
+
+/**
+ *  @brief  Function to take an additional lease on a MultiBuffer
+ *
+ *  Used when a leased entry is shared by more than one holder. Each
+ *  lease must be released with %RCL_MultiBuffer_release.
+ *
+ *  @param  multiBuffer MultiBuffer returned by %RCL_MultiBuffer_RxEntry_lease
+ */
+extern void RCL_MultiBuffer_retain(RCL_MultiBuffer *multiBuffer);
+
+/**
+ *  @brief  Function to release a lease on a MultiBuffer
+ *
+ *  When the last lease on a MultiBuffer that has been consumed is released,
+ *  the MultiBuffer is added to the consumedBuffers list, and the entries in
+ *  it must no longer be accessed.
+ *
+ *  @param  multiBuffer MultiBuffer returned by %RCL_MultiBuffer_RxEntry_lease
+ *
+ *  @param consumedBuffers A pointer to a linked list which will hold
+ *                          the buffer if it can now be re-used. If NULL,
+ *                          the buffer is not added to any list
+ *
+ *  @return true if this was the last lease on a consumed MultiBuffer, which
+ *          can now be re-used. The MultiBuffer has then been added to
+ *          consumedBuffers, unless consumedBuffers is NULL.
+ */
+extern bool RCL_MultiBuffer_release(RCL_MultiBuffer *multiBuffer, List_List *consumedBuffers);
+
 /**
  *  @brief  Function to atomically put an elem onto the end of a multi buffer list
  *
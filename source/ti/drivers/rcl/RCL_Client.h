@@ -49,6 +49,7 @@ struct RCL_Client_s {
     SemaphoreP_Struct pendSem;
     RCL_Events        deferredRclEvents; /* Deferred from cmd -> cmd */
     const LRF_Config *lrfConfig;
+    uint8_t           priority;          /* Used with RCL_COMMAND_QUEUE_SIZE > 0 */
 };
 
 #endif
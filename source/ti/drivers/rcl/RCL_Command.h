@@ -106,7 +106,7 @@ typedef enum RCL_CommandStatus_e {
     RCL_CommandStatus_GracefulStopScheduling,       /*!< Command ended due to scheduling where interrupting command had RCL_ConflictPolicy_Polite */
     RCL_CommandStatus_HardStopTimeout = 0x38,       /*!< Command ended because hard stop time was reached */
     RCL_CommandStatus_HardStopApi,                  /*!< Command ended because stop API was called with RCL_StopType_Hard argument */
-    RCL_CommandStatus_HardStopScheduling,           /*!< Command ended due to scheduling where interrupting command had RCL_ConflictPolicy_AlwaysInterrupt */
+    RCL_CommandStatus_HardStopScheduling,           /*!< Command ended due to scheduling where interrupting command had RCL_ConflictPolicy_AlwaysInterrupt or RCL_ConflictPolicy_InterruptLowerPriority */
     RCL_CommandStatus_Connect = 0x40,               /*!< Command has finished and a connection may be established (BLE5 advertiser and initiator) */
     RCL_CommandStatus_MaxNak,                       /*!< Command ended because more subsequent NAKs than supported were received (BLE5) */
     RCL_CommandStatus_MaxAuxWaitTimeExceeded,       /*!< Command ended because the wait time for a new packet following an AuxPtr was exceeded (BLE5 scanner and initiator) */
@@ -168,6 +168,7 @@ typedef enum {
     RCL_ConflictPolicy_AlwaysInterrupt = 0, /*!< Always stop a running command if necessary to run this command */
     RCL_ConflictPolicy_Polite = 1,          /*!< Stop a running command unless it is communicating, i.e. transmitting or is actively receiving */
     RCL_ConflictPolicy_NeverInterrupt = 2,  /*!< Never stop an ongoing command */
+    RCL_ConflictPolicy_InterruptLowerPriority = 3, /*!< Stop a running command only if its client has lower priority (see RCL_setClientPriority()); same as AlwaysInterrupt without a command queue */
 } RCL_ConflictPolicy;
 
 /**
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ *  ======== RCL_CommandQueue.c ========
+ */
+
+#include <ti/drivers/rcl/RCL_CommandQueue.h>
+
+#if RCL_COMMAND_QUEUE_SIZE > 0
+#include <stddef.h>
+
+#include <ti/drivers/rcl/RCL_Client.h>
+
+#if RCL_COMMAND_QUEUE_SIZE > 0xFFFFU
+#error "RCL_COMMAND_QUEUE_SIZE must fit in 16 bits"
+#endif
+
+/* Entries pending in a search of the heap; one more than the depth of a heap of 0xFFFF entries */
+#define RCL_COMMAND_QUEUE_SEARCH_DEPTH 16U
+
+/* Search of the entries starting before a given time, see rclCommandQueueNextBefore() */
+typedef struct {
+    uint32_t endTime;
+    uint32_t numPending;
+    uint16_t pending[RCL_COMMAND_QUEUE_SEARCH_DEPTH];
+} RCL_CommandQueueSearch;
+
+static bool rclCommandQueueEntryIsBefore(const RCL_CommandQueueEntry *a, const RCL_CommandQueueEntry *b);
+static void rclCommandQueueSearchInit(const RCL_CommandQueue *queue, RCL_CommandQueueSearch *search, uint32_t endTime);
+static uint32_t rclCommandQueueNextBefore(const RCL_CommandQueue *queue, RCL_CommandQueueSearch *search);
+static void rclCommandQueueSiftUp(RCL_CommandQueue *queue, uint32_t index);
+static void rclCommandQueueSiftDown(RCL_CommandQueue *queue, uint32_t index);
+static void rclCommandQueueRemoveIndex(RCL_CommandQueue *queue, uint32_t index);
+
+/*
+ *  ======== RCL_CommandQueue_init ========
+ */
+void RCL_CommandQueue_init(RCL_CommandQueue *queue)
+{
+    queue->numEntries = 0;
+    queue->nextSeqNumber = 0;
+}
+
+/*
+ *  ======== RCL_CommandQueue_insert ========
+ */
+bool RCL_CommandQueue_insert(RCL_CommandQueue *queue, RCL_Command *cmd, uint32_t startTime, uint8_t priority)
+{
+    if (queue->numEntries >= RCL_COMMAND_QUEUE_SIZE)
+    {
+        return false;
+    }
+    uint32_t index = queue->numEntries++;
+    queue->entries[index] = (RCL_CommandQueueEntry) {
+        .cmd = cmd,
+        .startTime = startTime,
+        .seqNumber = queue->nextSeqNumber++,
+        .priority = priority,
+    };
+    rclCommandQueueSiftUp(queue, index);
+
+    return true;
+}
+
+/*
+ *  ======== RCL_CommandQueue_pop ========
+ */
+RCL_Command *RCL_CommandQueue_pop(RCL_CommandQueue *queue, uint32_t readyTime)
+{
+    if (queue->numEntries == 0)
+    {
+        return NULL;
+    }
+    const RCL_CommandQueueEntry *first = &queue->entries[0];
+    uint32_t startTime = ((int32_t)(first->startTime - readyTime) > 0) ? first->startTime : readyTime;
+    uint32_t duration = RCL_CommandQueue_getDuration(first->cmd);
+    uint32_t index = 0;
+    RCL_CommandQueueSearch search;
+
+    /* Let the earliest command of a higher priority client that can't wait for the first one go ahead.
+     * Only commands starting before the first one ends qualify, so the rest of the heap is not visited.
+     * The first command itself never has a higher priority than its own. */
+    rclCommandQueueSearchInit(queue, &search, startTime + duration);
+    for (uint32_t i = rclCommandQueueNextBefore(queue, &search); i < queue->numEntries;
+         i = rclCommandQueueNextBefore(queue, &search))
+    {
+        const RCL_CommandQueueEntry *entry = &queue->entries[i];
+        if (RCL_CommandQueue_mustYield(startTime, duration, first->priority, entry->startTime, entry->priority) &&
+            (index == 0 || rclCommandQueueEntryIsBefore(entry, &queue->entries[index])))
+        {
+            index = i;
+        }
+    }
+    RCL_Command *cmd = queue->entries[index].cmd;
+    rclCommandQueueRemoveIndex(queue, index);
+
+    return cmd;
+}
+
+/*
+ *  ======== RCL_CommandQueue_peek ========
+ */
+RCL_Command *RCL_CommandQueue_peek(const RCL_CommandQueue *queue)
+{
+    return (queue->numEntries == 0) ? NULL : queue->entries[0].cmd;
+}
+
+/*
+ *  ======== RCL_CommandQueue_remove ========
+ */
+bool RCL_CommandQueue_remove(RCL_CommandQueue *queue, RCL_Command *cmd)
+{
+    for (uint32_t i = 0; i < queue->numEntries; i++)
+    {
+        if (queue->entries[i].cmd == cmd)
+        {
+            rclCommandQueueRemoveIndex(queue, i);
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ *  ======== RCL_CommandQueue_removeClient ========
+ */
+RCL_Command *RCL_CommandQueue_removeClient(RCL_CommandQueue *queue, RCL_Handle client)
+{
+    for (uint32_t i = 0; i < queue->numEntries; i++)
+    {
+        RCL_Command *cmd = queue->entries[i].cmd;
+        if (cmd->runtime.client == client)
+        {
+            rclCommandQueueRemoveIndex(queue, i);
+            return cmd;
+        }
+    }
+    return NULL;
+}
+
+/*
+ *  ======== RCL_CommandQueue_isBefore ========
+ */
+bool RCL_CommandQueue_isBefore(uint32_t startTime, uint8_t priority, uint32_t cmdStartTime, uint8_t cmdPriority)
+{
+    int32_t delta = (int32_t)(startTime - cmdStartTime);
+
+    /* A newly submitted command goes after queued commands with the same key */
+    return (delta < 0) || (delta == 0 && priority > cmdPriority);
+}
+
+/*
+ *  ======== RCL_CommandQueue_findConflict ========
+ */
+RCL_Command *RCL_CommandQueue_findConflict(const RCL_CommandQueue *queue, uint32_t startTime, uint32_t duration, uint8_t priority)
+{
+    RCL_CommandQueueSearch search;
+
+    /* A command starting after the new window ends cannot overlap it */
+    rclCommandQueueSearchInit(queue, &search, startTime + duration);
+    for (uint32_t i = rclCommandQueueNextBefore(queue, &search); i < queue->numEntries;
+         i = rclCommandQueueNextBefore(queue, &search))
+    {
+        const RCL_CommandQueueEntry *entry = &queue->entries[i];
+        if (entry->priority >= priority &&
+            RCL_CommandQueue_overlaps(startTime, duration, entry->startTime, RCL_CommandQueue_getDuration(entry->cmd)))
+        {
+            return entry->cmd;
+        }
+    }
+    return NULL;
+}
+
+static bool rclCommandQueueEntryIsBefore(const RCL_CommandQueueEntry *a, const RCL_CommandQueueEntry *b)
+{
+    int32_t delta = (int32_t)(a->startTime - b->startTime);
+
+    if (delta != 0)
+    {
+        return delta < 0;
+    }
+    if (a->priority != b->priority)
+    {
+        return a->priority > b->priority;
+    }
+    return (int16_t)(a->seqNumber - b->seqNumber) < 0;
+}
+
+static void rclCommandQueueSearchInit(const RCL_CommandQueue *queue, RCL_CommandQueueSearch *search, uint32_t endTime)
+{
+    search->endTime = endTime;
+    search->numPending = (queue->numEntries > 0) ? 1U : 0U;
+    search->pending[0] = 0;
+}
+
+/*
+ *  Return the next entry starting before the end time of the search, or
+ *  numEntries when there are no more. Children start no earlier than their
+ *  parent, so the subtree of an entry starting at or after the end time is
+ *  skipped. Below the current entry, the pending stack holds its children
+ *  and one sibling per level of its ancestors, at most the depth of the heap
+ *  plus one entries.
+ */
+static uint32_t rclCommandQueueNextBefore(const RCL_CommandQueue *queue, RCL_CommandQueueSearch *search)
+{
+    while (search->numPending > 0)
+    {
+        uint32_t index = search->pending[--search->numPending];
+        uint32_t child = 2 * index + 1;
+        if ((int32_t)(queue->entries[index].startTime - search->endTime) >= 0)
+        {
+            continue;
+        }
+        if (child + 1 < queue->numEntries)
+        {
+            search->pending[search->numPending++] = (uint16_t)(child + 1);
+        }
+        if (child < queue->numEntries)
+        {
+            search->pending[search->numPending++] = (uint16_t)child;
+        }
+        return index;
+    }
+    return queue->numEntries;
+}
+
+static void rclCommandQueueSiftUp(RCL_CommandQueue *queue, uint32_t index)
+{
+    RCL_CommandQueueEntry entry = queue->entries[index];
+
+    while (index > 0)
+    {
+        uint32_t parent = (index - 1) / 2;
+        if (!rclCommandQueueEntryIsBefore(&entry, &queue->entries[parent]))
+        {
+            break;
+        }
+        queue->entries[index] = queue->entries[parent];
+        index = parent;
+    }
+    queue->entries[index] = entry;
+}
+
+static void rclCommandQueueSiftDown(RCL_CommandQueue *queue, uint32_t index)
+{
+    RCL_CommandQueueEntry entry = queue->entries[index];
+    uint32_t numEntries = queue->numEntries;
+
+    for (;;)
+    {
+        uint32_t child = 2 * index + 1;
+        if (child >= numEntries)
+        {
+            break;
+        }
+        if (child + 1 < numEntries &&
+            rclCommandQueueEntryIsBefore(&queue->entries[child + 1], &queue->entries[child]))
+        {
+            child++;
+        }
+        if (!rclCommandQueueEntryIsBefore(&queue->entries[child], &entry))
+        {
+            break;
+        }
+        queue->entries[index] = queue->entries[child];
+        index = child;
+    }
+    queue->entries[index] = entry;
+}
+
+static void rclCommandQueueRemoveIndex(RCL_CommandQueue *queue, uint32_t index)
+{
+    uint32_t last = --queue->numEntries;
+
+    if (index != last)
+    {
+        /* Move the last entry into the hole and restore the heap order around it */
+        queue->entries[index] = queue->entries[last];
+        rclCommandQueueSiftUp(queue, index);
+        rclCommandQueueSiftDown(queue, index);
+    }
+}
+#endif
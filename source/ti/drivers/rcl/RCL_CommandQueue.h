@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2024, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ti_drivers_RCL_CommandQueue_h__include
+#define ti_drivers_RCL_CommandQueue_h__include
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <ti/drivers/rcl/RCL_Command.h>
+
+/**
+ *  @brief Number of commands that can wait behind the next command
+ *
+ *  When set to a non-zero value, RCL keeps submitted commands from any number
+ *  of clients in a queue ordered by start time. Commands starting at the same
+ *  time are ordered by the priority of their clients, then by submission order.
+ *  A submitted command is only rejected if the queue is full, or if it may not
+ *  be delayed and its start to hard stop window overlaps a pending command from
+ *  a client with the same or higher priority (see RCL_setClientPriority()).
+ *  A running command is never interrupted by a command from a client with
+ *  lower priority. Between clients of equal priority, the conflict policy of
+ *  the new command applies as without the queue, so the default
+ *  %RCL_ConflictPolicy_AlwaysInterrupt still stops the running command. Use
+ *  %RCL_ConflictPolicy_InterruptLowerPriority for commands that should wait
+ *  behind running commands of equal priority.
+ *
+ *  When 0, only one command can be pending in addition to the running command,
+ *  and further submits fail with %RCL_CommandStatus_Error_CommandQueueFull.
+ *
+ *  The RCL sources must be rebuilt with this option for it to take effect.
+ */
+#ifndef RCL_COMMAND_QUEUE_SIZE
+#define RCL_COMMAND_QUEUE_SIZE 0U
+#endif
+
+#if RCL_COMMAND_QUEUE_SIZE > 0
+
+/**
+ *  @brief Queued command with its ordering key
+ */
+typedef struct {
+    RCL_Command *cmd;       /*!< Queued command */
+    uint32_t     startTime; /*!< Start time on SYSTIM; submission time for %RCL_Schedule_Now */
+    uint16_t     seqNumber; /*!< Submission order */
+    uint8_t      priority;  /*!< Priority of the client */
+} RCL_CommandQueueEntry;
+
+/**
+ *  @brief Command queue, a binary min-heap of queue entries
+ */
+typedef struct {
+    uint16_t              numEntries;
+    uint16_t              nextSeqNumber;
+    RCL_CommandQueueEntry entries[RCL_COMMAND_QUEUE_SIZE];
+} RCL_CommandQueue;
+
+/**
+ *  @brief Empty the queue
+ */
+void RCL_CommandQueue_init(RCL_CommandQueue *queue);
+
+/**
+ *  @brief Insert a command in O(log n)
+ *
+ *  @return false if the queue is full
+ */
+bool RCL_CommandQueue_insert(RCL_CommandQueue *queue, RCL_Command *cmd, uint32_t startTime, uint8_t priority);
+
+/**
+ *  @brief Remove and return the command to plan next, or NULL if the queue is empty
+ *
+ *  This is normally the first command, removed in O(log n). If a queued command
+ *  of a client with higher priority starts before the first command could end
+ *  when started no earlier than @c readyTime, that command is returned instead,
+ *  so that it is planned in time to interrupt the lower priority work. Only the
+ *  commands starting before the first command could end are looked at, and
+ *  subtrees of the heap starting later are skipped.
+ *
+ *  @param  queue     Queue to take the command from
+ *  @param  readyTime Earliest time the radio is expected to be available
+ */
+RCL_Command *RCL_CommandQueue_pop(RCL_CommandQueue *queue, uint32_t readyTime);
+
+/**
+ *  @brief Return the first command without removing it, or NULL if the queue is empty
+ */
+RCL_Command *RCL_CommandQueue_peek(const RCL_CommandQueue *queue);
+
+/**
+ *  @brief Remove a given command
+ *
+ *  The command is searched linearly, then removed in O(log n).
+ *
+ *  @return false if the command was not queued
+ */
+bool RCL_CommandQueue_remove(RCL_CommandQueue *queue, RCL_Command *cmd);
+
+/**
+ *  @brief Remove and return any queued command of a client, or NULL if there is none
+ */
+RCL_Command *RCL_CommandQueue_removeClient(RCL_CommandQueue *queue, RCL_Handle client);
+
+/**
+ *  @brief Check if a command would be placed before a queued command
+ *
+ *  @return true if a command with the given start time and priority is ordered
+ *          before @c cmd when submitted now
+ */
+bool RCL_CommandQueue_isBefore(uint32_t startTime, uint8_t priority, uint32_t cmdStartTime, uint8_t cmdPriority);
+
+/**
+ *  @brief Find a queued command that a new command may not overlap
+ *
+ *  Only the commands starting before the window of the new command ends are
+ *  looked at, and subtrees of the heap starting later are skipped. Commands
+ *  starting after all queued commands are still checked against each of them.
+ *
+ *  @param  queue     Queue to search
+ *  @param  startTime Start time of the new command
+ *  @param  duration  Length of the window of the new command (0.25 us steps)
+ *  @param  priority  Priority of the client of the new command
+ *
+ *  @return A queued command from a client with the same or higher priority whose
+ *          window overlaps the given window, or NULL if there is none
+ */
+RCL_Command *RCL_CommandQueue_findConflict(const RCL_CommandQueue *queue, uint32_t startTime, uint32_t duration, uint8_t priority);
+
+#endif
+
+/**
+ *  @brief Length of the window a command occupies the radio, used for admission control
+ *
+ *  A command without hard stop time is given the minimum window of one SYSTIM step.
+ */
+static inline uint32_t RCL_CommandQueue_getDuration(const RCL_Command *cmd)
+{
+    return (cmd->timing.relHardStopTime != 0U) ? cmd->timing.relHardStopTime : 1U;
+}
+
+/**
+ *  @brief Check if a command must give way to a command of a client with higher priority
+ *
+ *  @return true if @c cmdPriority is higher than @c priority and the window
+ *          starting at @c cmdStartTime begins before the window of the
+ *          command given by @c startTime and @c duration ends
+ */
+static inline bool RCL_CommandQueue_mustYield(uint32_t startTime, uint32_t duration, uint8_t priority, uint32_t cmdStartTime, uint8_t cmdPriority)
+{
+    return (cmdPriority > priority) && ((int32_t)(cmdStartTime - (startTime + duration)) < 0);
+}
+
+/**
+ *  @brief Check if two windows on SYSTIM overlap
+ */
+static inline bool RCL_CommandQueue_overlaps(uint32_t startA, uint32_t durationA, uint32_t startB, uint32_t durationB)
+{
+    return ((uint32_t)(startB - startA) < durationA) || ((uint32_t)(startA - startB) < durationB);
+}
+
+#endif /* ti_drivers_RCL_CommandQueue_h__include */
@@ -35,11 +35,218 @@
 
 #include <ti/drivers/rcl/RCL_Profiling.h>
 
+#if RCL_PROFILING_TRACE
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <ti/drivers/rcl/RCL_Scheduler.h>
+#include <ti/drivers/dpl/HwiP.h>
+
+#include <ti/log/Log.h>
+
+#if (RCL_PROFILING_TRACE_SIZE & (RCL_PROFILING_TRACE_SIZE - 1U)) != 0U
+#error "RCL_PROFILING_TRACE_SIZE must be a power of two"
+#endif
+
+/* Compiler barrier; all producers run on the same core */
+#define RCL_PROFILING_BARRIER() __asm__ volatile("" ::: "memory")
+
+/* Lap tag of the entry with sequence number seq; never 0 */
+#define RCL_PROFILING_TAG(seq) ((uint8_t)((((seq) / RCL_PROFILING_TRACE_SIZE) & 0x7FU) | 0x80U))
+
+static volatile RCL_ProfilingTraceEntry rclProfilingTrace[RCL_PROFILING_TRACE_SIZE];
+static uint32_t rclProfilingHead;
+static RCL_ProfilingHistogram rclProfilingHistograms[RCL_PROFILING_NUM_HISTOGRAMS];
+
+static uint32_t rclProfilingReserve(void);
+static RCL_ProfilingHistogram *rclProfilingFindHistogram(uintptr_t key);
+#endif
+
 /*
  *  ======== RCL_Profiling_eventHook ========
  */
 void __attribute__((weak)) RCL_Profiling_eventHook(RCL_ProfilingEvent event)
 {
     /* Internal TI use: Sets start and stop events for power profiling */
+#if RCL_PROFILING_TRACE
+    RCL_Command *cmd = rclSchedulerState.currCmd;
+
+    (void)RCL_Profiling_traceEvent(event, (cmd != NULL) ? cmd->cmdId : RCL_PROFILING_NO_CMD);
+#else
     (void) event;
+#endif
+}
+
+#if RCL_PROFILING_TRACE
+/*
+ *  ======== rclProfilingReserve ========
+ */
+static uint32_t rclProfilingReserve(void)
+{
+#if defined(__ARM_FEATURE_LDREX) && (__ARM_FEATURE_LDREX & 4)
+    return __atomic_fetch_add(&rclProfilingHead, 1U, __ATOMIC_RELAXED);
+#else
+    /* No exclusive access instructions (Cortex-M0+); only the increment
+     * itself is protected, the entry is written with interrupts enabled.
+     */
+    uintptr_t key = HwiP_disable();
+    uint32_t seq = rclProfilingHead++;
+    HwiP_restore(key);
+
+    return seq;
+#endif
+}
+
+/*
+ *  ======== RCL_Profiling_traceEvent ========
+ */
+uint32_t RCL_Profiling_traceEvent(RCL_ProfilingEvent event, uint16_t cmdId)
+{
+    uint32_t seq = rclProfilingReserve();
+    uint32_t timestamp = RCL_Scheduler_getCurrentTime();
+    volatile RCL_ProfilingTraceEntry *entry = &rclProfilingTrace[seq & (RCL_PROFILING_TRACE_SIZE - 1U)];
+
+    /* Invalidate the entry while it is written so that a concurrent dump
+     * does not print a mix of old and new contents.
+     */
+    entry->tag = 0;
+    RCL_PROFILING_BARRIER();
+    entry->timestamp = timestamp;
+    entry->cmdId = cmdId;
+    entry->event = (uint8_t)event;
+    RCL_PROFILING_BARRIER();
+    entry->tag = RCL_PROFILING_TAG(seq);
+
+    return timestamp;
+}
+
+/*
+ *  ======== rclProfilingFindHistogram ========
+ */
+static RCL_ProfilingHistogram *rclProfilingFindHistogram(uintptr_t key)
+{
+    for (uint32_t i = 0; i < RCL_PROFILING_NUM_HISTOGRAMS; i++)
+    {
+        RCL_ProfilingHistogram *hist = &rclProfilingHistograms[i];
+
+        if (hist->key == key)
+        {
+            return hist;
+        }
+        if (hist->key == 0U)
+        {
+            /* Histograms are allocated in order; claim the first free one */
+            hist->key = key;
+            hist->min = UINT32_MAX;
+            return hist;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ *  ======== RCL_Profiling_traceDuration ========
+ */
+void RCL_Profiling_traceDuration(RCL_ProfilingEvent event, uint16_t cmdId, uintptr_t key, uint32_t startTime)
+{
+    uint32_t duration = RCL_Profiling_traceEvent(event, cmdId) - startTime;
+    RCL_ProfilingHistogram *hist = rclProfilingFindHistogram(key);
+
+    if (hist != NULL)
+    {
+        uint32_t bin = (duration < 2U) ? 0U : (31U - (uint32_t)__builtin_clz(duration));
+
+        if (bin >= RCL_PROFILING_HISTOGRAM_BINS)
+        {
+            bin = RCL_PROFILING_HISTOGRAM_BINS - 1U;
+        }
+        hist->bins[bin]++;
+        hist->count++;
+        hist->total += duration;
+        if (duration < hist->min)
+        {
+            hist->min = duration;
+        }
+        if (duration > hist->max)
+        {
+            hist->max = duration;
+        }
+    }
+}
+
+/*
+ *  ======== RCL_Profiling_dump ========
+ */
+void RCL_Profiling_dump(void)
+{
+    /* Without Log output for LogModule_RCL there is nothing to print */
+#if defined(ti_log_Log_ENABLE) && (ti_log_Log_ENABLE_LogModule_RCL == 1)
+    uint32_t head = *(volatile uint32_t *)&rclProfilingHead;
+    uint32_t first = (head > RCL_PROFILING_TRACE_SIZE) ? (head - RCL_PROFILING_TRACE_SIZE) : 0U;
+
+    Log_printf(LogModule_RCL, Log_INFO, "RCL_Profiling_dump: start %d %d", head - first, first);
+
+    for (uint32_t seq = first; seq != head; seq++)
+    {
+        volatile RCL_ProfilingTraceEntry *entry = &rclProfilingTrace[seq & (RCL_PROFILING_TRACE_SIZE - 1U)];
+        uint8_t tag = RCL_PROFILING_TAG(seq);
+
+        /* Copy the entry and only print it if it was complete before and
+         * after the copy, i.e. no producer has overwritten it in between.
+         */
+        if (entry->tag != tag)
+        {
+            continue;
+        }
+        RCL_PROFILING_BARRIER();
+        uint32_t timestamp = entry->timestamp;
+        uint16_t cmdId = entry->cmdId;
+        uint8_t event = entry->event;
+        RCL_PROFILING_BARRIER();
+        if (entry->tag != tag)
+        {
+            continue;
+        }
+
+        Log_printf(LogModule_RCL, Log_INFO, "RCL_Profiling_trace: %d %d 0x%04X 0x%08X", seq, event, cmdId, timestamp);
+    }
+
+    for (uint32_t i = 0; i < RCL_PROFILING_NUM_HISTOGRAMS; i++)
+    {
+        RCL_ProfilingHistogram *hist = &rclProfilingHistograms[i];
+
+        if (hist->key == 0U || hist->count == 0U)
+        {
+            continue;
+        }
+        Log_printf(LogModule_RCL, Log_INFO, "RCL_Profiling_hist: 0x%08X %d %d %d 0x%08X",
+                   hist->key, hist->count, hist->min, hist->max, hist->total);
+        for (uint32_t bin = 0; bin < RCL_PROFILING_HISTOGRAM_BINS; bin++)
+        {
+            if (hist->bins[bin] != 0U)
+            {
+                Log_printf(LogModule_RCL, Log_INFO, "RCL_Profiling_bin: 0x%08X %d %d", hist->key, bin, hist->bins[bin]);
+            }
+        }
+    }
+
+    Log_printf(LogModule_RCL, Log_INFO, "RCL_Profiling_dump: end");
+#endif
+}
+
+/*
+ *  ======== RCL_Profiling_reset ========
+ */
+void RCL_Profiling_reset(void)
+{
+    uintptr_t key = HwiP_disable();
+
+    rclProfilingHead = 0;
+    memset((void *)rclProfilingTrace, 0, sizeof(rclProfilingTrace));
+    memset(rclProfilingHistograms, 0, sizeof(rclProfilingHistograms));
+
+    HwiP_restore(key);
 }
+#endif
@@ -33,6 +33,54 @@
 #ifndef ti_drivers_RCL_Profiling_h__include
 #define ti_drivers_RCL_Profiling_h__include
 
+#include <stdint.h>
+
+/**
+ *  @brief Enable the built-in profiling trace backend
+ *
+ *  When set to 1, RCL records every profiling event together with the ID of
+ *  the active command and a SYSTIM timestamp (0.25 us steps) in a trace ring,
+ *  and aggregates the execution time of each command handler and of radio
+ *  setup in log2 histograms. Both can be printed through Log.h with
+ *  RCL_Profiling_dump() and converted to Chrome trace JSON on the host with
+ *  tools/common/rcl_profiling/rcl_profiling_tool.py.
+ *
+ *  The RCL sources must be rebuilt with this option for it to take effect.
+ */
+#ifndef RCL_PROFILING_TRACE
+#define RCL_PROFILING_TRACE 0
+#endif
+
+/**
+ *  @brief Number of entries in the trace ring. Must be a power of two.
+ *
+ *  Each entry uses 8 bytes of RAM. The oldest entries are overwritten when the
+ *  ring is full.
+ */
+#ifndef RCL_PROFILING_TRACE_SIZE
+#define RCL_PROFILING_TRACE_SIZE 256U
+#endif
+
+/**
+ *  @brief Number of duration histograms, one per command handler or setup
+ *  function seen. Durations from further functions are only traced.
+ */
+#ifndef RCL_PROFILING_NUM_HISTOGRAMS
+#define RCL_PROFILING_NUM_HISTOGRAMS 8U
+#endif
+
+/**
+ *  @brief Number of log2 bins per histogram. Bin n counts durations of
+ *  [2^n, 2^(n+1)) SYSTIM ticks, bin 0 also counts zero durations and the
+ *  last bin counts all longer durations.
+ */
+#ifndef RCL_PROFILING_HISTOGRAM_BINS
+#define RCL_PROFILING_HISTOGRAM_BINS 16U
+#endif
+
+/** @brief Command ID recorded for events that are not tied to a command */
+#define RCL_PROFILING_NO_CMD 0xFFFFU
+
 typedef enum RCL_ProfilingEvent_e {
     RCL_ProfilingEvent_PreprocStart = 1,   /*!< Radio operation preprocessing has started */
     RCL_ProfilingEvent_PreprocStop,        /*!< Radio operation preprocessing has finalized */
@@ -44,8 +92,99 @@ typedef enum RCL_ProfilingEvent_e {
     RCL_ProfilingEvent_ProcessAuxPtrEnd,   /*!< AuxPtr has been processed and a new radio operation has been scheduled on a secondary channel*/
     RCL_ProfilingEvent_PhySwitchStart,     /*!< Phy switch has been requested by command handler */
     RCL_ProfilingEvent_PhySwitchEnd,       /*!< Phy switch has succeeded */
+    RCL_ProfilingEvent_CommandHwiStart,    /*!< rclCommandHwi entered */
+    RCL_ProfilingEvent_CommandHwiEnd,      /*!< rclCommandHwi about to return */
+    RCL_ProfilingEvent_DispatchHwiStart,   /*!< rclDispatchHwi entered */
+    RCL_ProfilingEvent_DispatchHwiEnd,     /*!< rclDispatchHwi about to return */
+    RCL_ProfilingEvent_SchedulerHwiStart,  /*!< rclSchedulerHwi entered */
+    RCL_ProfilingEvent_SchedulerHwiEnd,    /*!< rclSchedulerHwi about to return */
+    RCL_ProfilingEvent_SchedulerDecision,  /*!< Scheduler promoted the next command to current command */
+    RCL_ProfilingEvent_StopTimeSet,        /*!< Hard and/or graceful stop time programmed in the timer */
+    RCL_ProfilingEvent_SetupStart,         /*!< Radio setup (image load, settings, trim) has started */
+    RCL_ProfilingEvent_SetupEnd,           /*!< Radio setup has finished */
+    RCL_ProfilingEvent_ApplySettingsStart, /*!< LRF register settings are being applied */
+    RCL_ProfilingEvent_ApplySettingsEnd,   /*!< LRF register settings have been applied */
+    RCL_ProfilingEvent_HandlerStart,       /*!< Command handler invoked */
+    RCL_ProfilingEvent_HandlerEnd,         /*!< Command handler returned */
 } RCL_ProfilingEvent;
 
+/**
+ *  @brief  One entry of the profiling trace ring
+ */
+typedef struct RCL_ProfilingTraceEntry_s {
+    uint32_t timestamp;                    /*!< SYSTIM time (0.25 us steps) of the event */
+    uint16_t cmdId;                        /*!< ID of the active command, or RCL_PROFILING_NO_CMD */
+    uint8_t  event;                        /*!< RCL_ProfilingEvent */
+    uint8_t  tag;                          /*!< Nonzero lap tag of a completely written entry, 0 while written */
+} RCL_ProfilingTraceEntry;
+
+/**
+ *  @brief  Duration histogram of one command handler or setup function
+ */
+typedef struct RCL_ProfilingHistogram_s {
+    uintptr_t key;                         /*!< Address of the function measured, 0 if unused */
+    uint32_t  count;                       /*!< Number of samples */
+    uint32_t  min;                         /*!< Shortest duration (0.25 us steps) */
+    uint32_t  max;                         /*!< Longest duration (0.25 us steps) */
+    uint32_t  total;                       /*!< Sum of all durations (0.25 us steps), wraps */
+    uint32_t  bins[RCL_PROFILING_HISTOGRAM_BINS]; /*!< log2 duration bins */
+} RCL_ProfilingHistogram;
+
 extern void __attribute__((weak)) RCL_Profiling_eventHook(RCL_ProfilingEvent event);
 
+#if RCL_PROFILING_TRACE
+/**
+ *  @brief  Record a profiling event in the trace ring
+ *
+ *  Safe to call from any RCL interrupt context. Entries are reserved with an
+ *  atomic increment of the ring head and written without locks.
+ *
+ *  @param  event   Event to record
+ *  @param  cmdId   ID of the command the event belongs to, or RCL_PROFILING_NO_CMD
+ *
+ *  @return Timestamp recorded for the event
+ */
+extern uint32_t RCL_Profiling_traceEvent(RCL_ProfilingEvent event, uint16_t cmdId);
+
+/**
+ *  @brief  Record the end event of a measured section and add its duration to a histogram
+ *
+ *  Histograms are only updated from rclCommandHwi context, where command
+ *  handlers and radio setup run, and therefore need no locking.
+ *
+ *  @param  event     End event to record
+ *  @param  cmdId     ID of the command the event belongs to, or RCL_PROFILING_NO_CMD
+ *  @param  key       Address identifying the measured function
+ *  @param  startTime Timestamp returned by RCL_Profiling_traceEvent() for the start event
+ */
+extern void RCL_Profiling_traceDuration(RCL_ProfilingEvent event, uint16_t cmdId, uintptr_t key, uint32_t startTime);
+
+/**
+ *  @brief  Print the trace ring and all histograms through Log.h
+ *
+ *  Uses Log_printf() with LogModule_RCL at level Log_INFO. Events recorded
+ *  while dumping are kept for the next dump. Entries overwritten while being
+ *  printed are skipped. Does nothing unless Log is enabled for LogModule_RCL
+ *  (ti_log_Log_ENABLE and ti_log_Log_ENABLE_LogModule_RCL=1).
+ */
+extern void RCL_Profiling_dump(void);
+
+/**
+ *  @brief  Clear the trace ring and all histograms
+ *
+ *  Must only be called while no radio command is running.
+ */
+extern void RCL_Profiling_reset(void);
+
+#define RCL_PROFILING_TRACE_EVENT(event, cmdId) ((void)RCL_Profiling_traceEvent((event), (cmdId)))
+#define RCL_PROFILING_TRACE_START(startVar, event, cmdId) \
+    uint32_t startVar = RCL_Profiling_traceEvent((event), (cmdId))
+#define RCL_PROFILING_TRACE_END(startVar, event, cmdId, key) \
+    RCL_Profiling_traceDuration((event), (cmdId), (uintptr_t)(key), (startVar))
+#else
+#define RCL_PROFILING_TRACE_EVENT(event, cmdId)
+#define RCL_PROFILING_TRACE_START(startVar, event, cmdId)
+#define RCL_PROFILING_TRACE_END(startVar, event, cmdId, key)
+#endif
+
 #endif /* ti_drivers_RCL_Profiling_h__include */
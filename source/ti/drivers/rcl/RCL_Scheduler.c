@@ -44,6 +44,7 @@
 #include <ti/drivers/rcl/hal/hal.h>
 #include <ti/drivers/rcl/RCL_Command.h>
 #include <ti/drivers/rcl/RCL_Scheduler.h>
+#include <ti/drivers/rcl/RCL_Profiling.h>
 #include <ti/drivers/rcl/RCL_Debug.h>
 
 #include <ti/drivers/rcl/LRF.h>
@@ -473,6 +474,8 @@ RCL_StopType RCL_Scheduler_setStopTimes(void)
         rclSchedulerState.stopTimeState = RCL_SchedulerStopTimeState_Programmed;
 
         HwiP_restore(key);
+        RCL_PROFILING_TRACE_EVENT(RCL_ProfilingEvent_StopTimeSet,
+                                  (rclSchedulerState.currCmd != NULL) ? rclSchedulerState.currCmd->cmdId : RCL_PROFILING_NO_CMD);
     }
     return stopType;
 }
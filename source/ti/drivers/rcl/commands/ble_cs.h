@@ -241,7 +241,10 @@ struct RCL_CMD_BLE_CS_STEP_RESULT_INTERNAL_t {
     /* Echoed by PBE */
     uint8_t  antennaPermIdx;                                /*!< Index of entry to be used from the antenna permutation table @ref RCL_CmdBleCs_AntennaConfig */
     uint8_t  antennaPacket;                                 /*!< Index of physical antenna to be used for all packet exchanges @ref RCL_CMD_BLE_CS_PacketAntenna_e */
-    uint16_t reserved1;
+
+    /* Captured by the handler */
+    uint8_t  rfGain;                                        /*!< RX gain in dB when the step was read, as in LRFDRFE.RFGAIN */
+    uint8_t  rplScaler;                                     /*!< Log2 scaler of the PCT values in effect for the step */
 };
 
 /**
@@ -534,6 +537,34 @@ struct RCL_CMD_BLE_CS_PRECAL_TABLE_t {
 /* Default callback implemented in the driver */
 void RCL_Handler_BLE_CS_PrecalDefaultCallback(RCL_CmdBleCs_PrecalTable *table, uint8_t channel, RCL_CmdBleCs_IQSample *pHigh, RCL_CmdBleCs_IQSample *pLow);
 
+/**
+ *  @brief  Convert a batch of step results to the report format
+ *
+ *  Converts internal step results, as collected in %RCL_CmdBleCs.results, to the step data
+ *  format selected by %RCL_CmdBleCs.reportFormat. A command submitted with %RCL_CmdBleCs.results
+ *  and without result buffers skips the conversion in the radio interrupt, so this function can
+ *  be used to do it afterwards from a task or SWI instead.
+ *
+ *  Only the step data is written, as it follows the subevent header in the result buffers. The
+ *  caller must build the %RCL_CmdBleCs_SubeventResults or %RCL_CmdBleCs_SubeventResultsContinue
+ *  header itself, including numStepsReported and subeventDoneStatus. This includes
+ *  referencePowerLevel, which the handler derives from the rfGain and rplScaler of each step as
+ *  it is reported: -45 dBm at high RX gain and -21 dBm otherwise, 6 dB lower when rplScaler is 0.
+ *  frequencyCompensation is read from the radio after the last mode-0 step and can't be derived
+ *  from the step results.
+ *
+ *  The RX gain and PCT scaling in effect for each step are captured in the step result, so the
+ *  steps can be converted in any order and %RCL_CmdBleCs_Stats is not modified.
+ *
+ *  @param  pCmd      Command the results were collected with
+ *  @param  dst       Destination, large enough for the converted steps
+ *  @param  src       First step result to convert
+ *  @param  numSteps  Number of step results to convert
+ *
+ *  @return Number of bytes written to %dst
+ */
+uint32_t RCL_Handler_BLE_CS_convertStepResults(RCL_CmdBleCs *pCmd, uint8_t *dst, const RCL_CmdBleCs_StepResult_Internal *src, uint16_t numSteps);
+
 /* Default configuration of DC precalibration */
 #define RCL_CmdBleCs_PrecalTable_Default()                     \
 {                                                              \
@@ -621,11 +621,14 @@ static void RCL_Handler_BLE_CS_preprocessStep(RCL_CmdBleCs *pCmd, RCL_CmdBleCs_S
 static RCL_CmdBleCs_StepResult_Internal* RCL_Handler_BLE_CS_fetchNextStepResult(RCL_CmdBleCs *pCmd);
 static int16_t RCL_Handler_BLE_CS_convertFreqOffset(int16_t foffMeasured, bool ceil);
 static int16_t RCL_Handler_BLE_CS_convertRtt(RCL_CmdBleCs *pCmd, uint8_t mode, int8_t channel, uint8_t payload, bool secondToneExtensionSlot, int32_t toAD, uint16_t corrBefore, uint16_t corrPeak, uint16_t corrAfter);
-static uint32_t RCL_Handler_BLE_CS_convertPct(int16_t pct_i, int16_t pct_q, uint8_t channelIdx, uint8_t rplScaler);
+static void RCL_Handler_BLE_CS_convertPcts(uint32_t *dst, const RCL_CmdBleCs_IQSample *src, uint8_t numTone, uint16_t channelIdx, uint8_t rplScaler);
 static uint8_t RCL_Handler_BLE_CS_calcQ3(uint16_t qMin, uint16_t qMax, uint16_t qAvg);
 static uint8_t RCL_Handler_BLE_CS_convertPctQuality(uint16_t qMin, uint16_t qMax, uint16_t qAvg, bool toneExtensionSlot, bool toneExpected, bool toneQualityOverride);
 static uint16_t RCL_Handler_BLE_CS_estimateStepResultLength(RCL_CmdBleCs *pCmd,RCL_CmdBleCs_StepResult_Internal* src);
-static uint16_t RCL_Handler_BLE_CS_convertStepResult(RCL_CmdBleCs* pCmd, uint8_t *dst, RCL_CmdBleCs_StepResult_Internal* src);
+static uint16_t RCL_Handler_BLE_CS_convertStepResult(RCL_CmdBleCs* pCmd, uint8_t *dst, const RCL_CmdBleCs_StepResult_Internal* src);
+static uint32_t RCL_Handler_BLE_CS_calcRotation(int16_t theta);
+static void RCL_Handler_BLE_CS_initRotationLut(void);
+static void RCL_Handler_BLE_CS_rotateVectors(RCL_CmdBleCs_IQSample *pct, uint8_t numVectors, uint32_t rotation);
 static RCL_CommandStatus RCL_Handler_BLE_CS_findPbeErrorEndStatus(uint16_t pbeEndStatus);
 static bool RCL_Handler_BLE_CS_filterDC(uint16_t max, uint16_t min, uint16_t thr);
 
@@ -844,6 +847,10 @@ static void RCL_Handler_BLE_CS_retrieveAndStoreNextResult(RCL_CmdBleCs* pCmd, bo
         *(ptr+j) = HWREG_READ_LRF(LRFDRXF_BASE + LRFDRXF_O_RXD);
     }
 
+    /* Capture the RX gain and PCT scaling of the step, so the conversion does not depend on when it is done */
+    result.rfGain    = HWREG_READ_LRF(LRFDRFE_BASE + LRFDRFE_O_RFGAIN);
+    result.rplScaler = pCmd->stats->rplScaler;
+
     if (result.pktResult == RCL_CmdBleCs_PacketResult_Ok)
     {
         pCmd->stats->nRxOk += 1;
@@ -875,9 +882,8 @@ static void RCL_Handler_BLE_CS_retrieveAndStoreNextResult(RCL_CmdBleCs* pCmd, bo
                                             &high,
                                             &low);
 
-                /* Read the RX gain to decide which compensation value to return (high vs low gain) */
-                uint8_t rxGaindB = HWREG_READ_LRF(LRFDRFE_BASE + LRFDRFE_O_RFGAIN);
-                if (rxGaindB == (RCL_BLE_CS_STEP_RX_GAIN_DB * RCL_CmdBleCs_RxGain_High))
+                /* Use the RX gain of the step to decide which compensation value to return (high vs low gain) */
+                if (pResult->rfGain == (RCL_BLE_CS_STEP_RX_GAIN_DB * RCL_CmdBleCs_RxGain_High))
                 {
                     pResult->dc.i = high.i;
                     pResult->dc.q = high.q;
@@ -946,10 +952,10 @@ static void RCL_Handler_BLE_CS_retrieveAndStoreNextResult(RCL_CmdBleCs* pCmd, bo
 
             /* Only available after AGC is locked:
              * RPL = IQ[dBm] - 20*log(IQ/2048) */
-            pSubeventResults->referencePowerLevel   = (HWREG_READ_LRF(LRFDRFE_BASE + LRFDRFE_O_RFGAIN) == BLE_CS_HIGH_GAIN_DB)
+            pSubeventResults->referencePowerLevel   = (result.rfGain == BLE_CS_HIGH_GAIN_DB)
                                                     ? (BLE_CS_RPL_HIGH_GAIN)
                                                     : (BLE_CS_RPL_LOW_GAIN);
-            pSubeventResults->referencePowerLevel  += (pCmd->stats->rplScaler)
+            pSubeventResults->referencePowerLevel  += (result.rplScaler)
                                                     ? (0)
                                                     : (BLE_CS_RPL_DELTA_DB);
             /* Only available after last mode-0 step */
@@ -998,6 +1004,16 @@ static void RCL_Handler_BLE_CS_retrieveAndStoreNextResult(RCL_CmdBleCs* pCmd, bo
             pResultBuffer->state = RCL_BufferStateFinished;
         }
     }
+
+    /* Evaluate successful mode-0 packets, and chose PCT linear scaling of the following steps accordingly */
+    if ((result.mode == RCL_CmdBleCs_StepMode_0) && (result.pktResult == RCL_CmdBleCs_PacketResult_Ok))
+    {
+        if ( ((result.pktRssi > BLE_CS_RPL_HIGH_GAIN_THR) && (result.rfGain == BLE_CS_HIGH_GAIN_DB)) ||
+             ((result.pktRssi > BLE_CS_RPL_LOW_GAIN_THR) && (result.rfGain == BLE_CS_LOW_GAIN_DB)) )
+        {
+            pCmd->stats->rplScaler = 1;
+        }
+    }
 }
 
 /*
@@ -1163,6 +1179,9 @@ static void RCL_Handler_BLE_CS_readStatistics(RCL_CmdBleCs *pCmd)
  */
 static void RCL_Handler_BLE_CS_preprocessCommand(RCL_CmdBleCs *pCmd)
 {
+    /* Rotation of the PCTs only depends on the channel, prepare it once */
+    RCL_Handler_BLE_CS_initRotationLut();
+
     /* Force antenna switching time to zero for single antenna path per spec */
     if (pCmd->antennaConfig.select == 0)
     {
@@ -1663,113 +1682,207 @@ static int16_t RCL_Handler_BLE_CS_convertRtt(RCL_CmdBleCs *pCmd, uint8_t mode, i
     return ((int16_t) t);
 }
 
+/* Calibrate via the t_picosec parameter against a calibrated instrument */
+#ifdef DeviceFamily_CC27XX
+    #define t_picosec   (uint64_t)(1100)
+#else
+    #define t_picosec   (uint64_t)(1500)
+#endif
+
+#define t_const         (uint64_t)((t_picosec << 31) / 1e6)
+#define t_scaler        (15)
+#define CALC_ANGLE(ch)  ((int16_t)((((uint64_t)ch) * t_const) >> t_scaler))
+
+/* CORDIC parameters of the PCT rotation
+ *
+ * The LUT and normalization factor is generated by the following python expression:
+ *
+ * f = 1.0
+ * for i in range(NBITS):
+ *     x = np.arctan(1 / 2**i) / (np.pi/2) * (2**NBITS)
+ *     atanLut += [ (np.floor)(x + 0.5) ]
+ *
+ *     f = (f * (2**(2*i) + 1)) / 2**(2*i)
+ *
+ * f = 1/np.sqrt(f) * (2**NBITS)
+ * K = (np.floor) (f + 0.5)
+ * */
+#define PI_div2 (1 << (16-2))
+#define NBITS  (14)
+#define K14    (9949)
+
+/* Encoding of a rotation: bit i set when CORDIC iteration i turns counter-clockwise */
+#define BLE_CS_ROTATION_SWAP_POS    (1U << 16)  /* Angle above pi/2 */
+#define BLE_CS_ROTATION_SWAP_NEG    (1U << 17)  /* Angle below -pi/2 */
+#define BLE_CS_ROTATION_NONE        (1U << 18)  /* Zero angle, vectors are left untouched */
+
+/* Rotation of the PCTs per channel, filled by RCL_Handler_BLE_CS_initRotationLut() */
+static uint32_t rotationLut[BLE_CS_MAX_CHANNEL + 1];
+static bool rotationLutValid = false;
+
 /*
- *  ======== RCL_Handler_BLE_CS_rotateVector ========
+ *  ======== RCL_Handler_BLE_CS_calcRotation ========
  */
-void RCL_Handler_BLE_CS_rotateVector(int16_t *pct_i, int16_t *pct_q, int16_t theta)
+static uint32_t RCL_Handler_BLE_CS_calcRotation(int16_t theta)
 {
+    const uint16_t atanLut[NBITS] = { 8192, 4836, 2555, 1297, 651, 326, 163, 81, 41, 20, 10, 5, 3, 1 };
+    uint32_t rotation = 0;
+
     /* Quickly return if nothing to do */
-    if (theta != 0)
-    {
-        /* CORDIC implementation of rotating a vector with given angle
-        *
-        * theta = 16bit representation of the angle in [-pi = -32768, +pi = 32767] range to rotate the PCT with
-        * pct_i = I component of PCT
-        * pct_q = Q component of PCT
-        * */
-        #define PI_div2 (1 << (16-2))
-
-        /* The LUT and normalization factor is generated by the following python expression:
-        *
-        * f = 1.0
-        * for i in range(NBITS):
-        *     x = np.arctan(1 / 2**i) / (np.pi/2) * (2**NBITS)
-        *     atanLut += [ (np.floor)(x + 0.5) ]
-        *
-        *     f = (f * (2**(2*i) + 1)) / 2**(2*i)
-        *
-        * f = 1/np.sqrt(f) * (2**NBITS)
-        * K = (np.floor) (f + 0.5)
-        * */
-        #define NBITS  (14)
-        #define K14    (9949)
-        const uint16_t atanLut[NBITS] = { 8192, 4836, 2555, 1297, 651, 326, 163, 81, 41, 20, 10, 5, 3, 1 };
-
-        /* Swap coordinates when angle is between [-pi,-pi/2] or [pi/2,pi] */
-        int32_t x = ((int32_t) *pct_i);
-        int32_t y = ((int32_t) *pct_q);
-        if (theta > PI_div2)
-        {
-            theta -= PI_div2;
-            x = -((int32_t) *pct_q);
-            y = +((int32_t) *pct_i);
+    if (theta == 0)
+    {
+        return (BLE_CS_ROTATION_NONE);
+    }
+
+    /* Swap coordinates when angle is between [-pi,-pi/2] or [pi/2,pi] */
+    if (theta > PI_div2)
+    {
+        theta -= PI_div2;
+        rotation |= BLE_CS_ROTATION_SWAP_POS;
+    }
+    else if (theta < (-PI_div2))
+    {
+        theta += PI_div2;
+        rotation |= BLE_CS_ROTATION_SWAP_NEG;
+    }
+
+    /* The direction of every iteration only depends on the angle, not on the vector.
+     * The direction follows the mathematical positive direction */
+    int32_t phi = (int32_t)(-theta);
+    for (uint8_t i = 0; i < NBITS; i++)
+    {
+        if (phi < 0)
+        {   /* Counter-clockwise */
+            phi += atanLut[i];
+            rotation |= (1U << i);
         }
-        else if (theta < (-PI_div2))
+        else
+        {   /* Clockwise */
+            phi -= atanLut[i];
+        }
+    }
+
+    return (rotation);
+}
+
+/*
+ *  ======== RCL_Handler_BLE_CS_initRotationLut ========
+ */
+static void RCL_Handler_BLE_CS_initRotationLut(void)
+{
+    if (!rotationLutValid)
+    {
+        for (uint8_t ch = 0; ch <= BLE_CS_MAX_CHANNEL; ch++)
         {
-            theta += PI_div2;
-            x = +((int32_t) *pct_q);
-            y = -((int32_t) *pct_i);
+            rotationLut[ch] = RCL_Handler_BLE_CS_calcRotation(CALC_ANGLE(ch));
         }
-        x *= K14;
-        y *= K14;
+        rotationLutValid = true;
+    }
+}
 
-        /* Initialize local variables */
-        int32_t x1  = 0;
-        int32_t y1  = 0;
+/*
+ *  ======== RCL_Handler_BLE_CS_rotateVectors ========
+ */
+static void RCL_Handler_BLE_CS_rotateVectors(RCL_CmdBleCs_IQSample *pct, uint8_t numVectors, uint32_t rotation)
+{
+    int32_t x[RCL_BLE_CS_MAX_NUM_ANT_PATH];
+    int32_t y[RCL_BLE_CS_MAX_NUM_ANT_PATH];
 
-        /* The direction follows the mathematical positive direction */
-        int32_t phi = (int32_t)(-theta);
+    if ((rotation & BLE_CS_ROTATION_NONE) || (numVectors > RCL_BLE_CS_MAX_NUM_ANT_PATH))
+    {
+        return;
+    }
 
-        /* Rotate iteratively */
-        for (uint8_t i = 0; i < NBITS; i++)
+    for (uint8_t j = 0; j < numVectors; j++)
+    {
+        if (rotation & BLE_CS_ROTATION_SWAP_POS)
         {
-            if (phi < 0)
-            {   /* Counter-clockwise */
-                phi += atanLut[i];
-                y1 = y + (x >> i);
-                x1 = x - (y >> i);
-            }
-            else
-            {   /* Clockwise */
-                phi -= atanLut[i];
-                y1 = y - (x >> i);
-                x1 = x + (y >> i);
-            }
+            x[j] = -((int32_t) pct[j].q);
+            y[j] = +((int32_t) pct[j].i);
+        }
+        else if (rotation & BLE_CS_ROTATION_SWAP_NEG)
+        {
+            x[j] = +((int32_t) pct[j].q);
+            y[j] = -((int32_t) pct[j].i);
+        }
+        else
+        {
+            x[j] = ((int32_t) pct[j].i);
+            y[j] = ((int32_t) pct[j].q);
+        }
+        x[j] *= K14;
+        y[j] *= K14;
+    }
+
+    /* Rotate iteratively. All vectors take the same direction in an iteration, so the
+     * inner loop is branch free: clockwise iterations negate the shifted terms */
+    for (uint8_t i = 0; i < NBITS; i++)
+    {
+        int32_t negate = ((rotation >> i) & 1U) ? 0 : -1;
 
-            x = x1;
-            y = y1;
+        for (uint8_t j = 0; j < numVectors; j++)
+        {
+            int32_t dx = ((x[j] >> i) ^ negate) - negate;
+            int32_t dy = ((y[j] >> i) ^ negate) - negate;
+
+            x[j] = x[j] - dy;
+            y[j] = y[j] + dx;
         }
+    }
 
-        /* Scale according to LUT normalization weight */
-        *pct_i = (x >> NBITS);
-        *pct_q = (y >> NBITS);
+    /* Scale according to LUT normalization weight */
+    for (uint8_t j = 0; j < numVectors; j++)
+    {
+        pct[j].i = (x[j] >> NBITS);
+        pct[j].q = (y[j] >> NBITS);
     }
 }
 
 /*
- *  ======== RCL_Handler_BLE_CS_convertPct ========
+ *  ======== RCL_Handler_BLE_CS_rotateVector ========
  */
-static uint32_t RCL_Handler_BLE_CS_convertPct(int16_t pct_i, int16_t pct_q, uint8_t channelIdx, uint8_t rplScaler)
+void RCL_Handler_BLE_CS_rotateVector(int16_t *pct_i, int16_t *pct_q, int16_t theta)
 {
-    /* Calibrate via the t_picosec parameter against a calibrated instrument */
-    #ifdef DeviceFamily_CC27XX
-        #define t_picosec   (uint64_t)(1100)
-    #else
-        #define t_picosec   (uint64_t)(1500)
-    #endif
+    /* CORDIC implementation of rotating a vector with given angle
+    *
+    * theta = 16bit representation of the angle in [-pi = -32768, +pi = 32767] range to rotate the PCT with
+    * pct_i = I component of PCT
+    * pct_q = Q component of PCT
+    * */
+    RCL_CmdBleCs_IQSample pct = { .i = *pct_i, .q = *pct_q };
+
+    RCL_Handler_BLE_CS_rotateVectors(&pct, 1, RCL_Handler_BLE_CS_calcRotation(theta));
+
+    *pct_i = pct.i;
+    *pct_q = pct.q;
+}
+
+/*
+ *  ======== RCL_Handler_BLE_CS_convertPcts ========
+ */
+static void RCL_Handler_BLE_CS_convertPcts(uint32_t *dst, const RCL_CmdBleCs_IQSample *src, uint8_t numTone, uint16_t channelIdx, uint8_t rplScaler)
+{
+    RCL_CmdBleCs_IQSample pct[RCL_BLE_CS_MAX_NUM_ANT_PATH];
 
-    #define t_const         (uint64_t)((t_picosec << 31) / 1e6)
-    #define t_scaler        (15)
-    #define CALC_ANGLE(ch)  ((int16_t)((((uint64_t)ch) * t_const) >> t_scaler))
+    if (numTone > RCL_BLE_CS_MAX_NUM_ANT_PATH)
+    {
+        numTone = RCL_BLE_CS_MAX_NUM_ANT_PATH;
+    }
+    memcpy(pct, src, numTone * sizeof(RCL_CmdBleCs_IQSample));
 
-    /* Adjust the phase to the signal on the antenna (group delay and layout) */
-    RCL_Handler_BLE_CS_rotateVector(&pct_i, &pct_q, CALC_ANGLE(channelIdx));
+    /* Adjust the phase to the signal on the antenna (group delay and layout).
+     * All tones of a step are on the same channel, so they share the rotation */
+    uint32_t rotation = (rotationLutValid && (channelIdx <= BLE_CS_MAX_CHANNEL))
+                      ? rotationLut[channelIdx]
+                      : RCL_Handler_BLE_CS_calcRotation(CALC_ANGLE(channelIdx));
+    RCL_Handler_BLE_CS_rotateVectors(pct, numTone, rotation);
 
     /* Compress PCTs to 24bit */
-    uint32_t pct = (((pct_q >> rplScaler) & 0x0FFF) << 12)
-                 | ( (pct_i >> rplScaler) & 0x0FFF);
-
-    return (pct);
+    for (uint8_t j = 0; j < numTone; j++)
+    {
+        dst[j] = (((pct[j].q >> rplScaler) & 0x0FFF) << 12)
+               | ( (pct[j].i >> rplScaler) & 0x0FFF);
+    }
 }
 
 /*
@@ -1865,20 +1978,17 @@ static uint16_t RCL_Handler_BLE_CS_estimateStepResultLength(RCL_CmdBleCs *pCmd,
 /*
  *  ======== RCL_Handler_BLE_CS_convertStepResult ========
  */
-static uint16_t RCL_Handler_BLE_CS_convertStepResult(RCL_CmdBleCs* pCmd, uint8_t *dst, RCL_CmdBleCs_StepResult_Internal* src)
+static uint16_t RCL_Handler_BLE_CS_convertStepResult(RCL_CmdBleCs* pCmd, uint8_t *dst, const RCL_CmdBleCs_StepResult_Internal* src)
 {
     /* Calculate number of tones to be measured. +1 = tone extension */
     uint8_t numTone = pCmd->stats->numAntennaPath + 1;
 
-    /* Log2 scaler of PCT values */
-    uint8_t rplScaler = pCmd->stats->rplScaler;
+    /* Log2 scaler of PCT values, as captured with the step */
+    uint8_t rplScaler = src->rplScaler;
 
     /* Determine the format of the report */
     uint8_t reportFormat = pCmd->reportFormat;
 
-    /* Need for scale selection */
-    uint8_t rfGain = HWREG_READ_LRF(LRFDRFE_BASE + LRFDRFE_O_RFGAIN);
-
     /* Dataformat varies based on the mode */
     uint8_t mode          = src->mode;
     uint8_t channel       = src->channelIdx;
@@ -1906,16 +2016,6 @@ static uint16_t RCL_Handler_BLE_CS_convertStepResult(RCL_CmdBleCs* pCmd, uint8_t
             *dst++ = INT16_LSB(freqOffset);
             *dst++ = INT16_MSB(freqOffset);
         }
-
-        if (src->pktResult == RCL_CmdBleCs_PacketResult_Ok)
-        {
-            /* Evaluate successful mode-0 packets, and chose PCT linear scaling accordingly */
-            if ( ((src->pktRssi > BLE_CS_RPL_HIGH_GAIN_THR) && (rfGain == BLE_CS_HIGH_GAIN_DB)) ||
-                 ((src->pktRssi > BLE_CS_RPL_LOW_GAIN_THR) && (rfGain == BLE_CS_LOW_GAIN_DB)) )
-            {
-                pCmd->stats->rplScaler = 1;
-            }
-        }
     }
     else if (mode == RCL_CmdBleCs_StepMode_1)
     {
@@ -1940,16 +2040,15 @@ static uint16_t RCL_Handler_BLE_CS_convertStepResult(RCL_CmdBleCs* pCmd, uint8_t
     {
         /* Tone related data */
         *dst++ = src->antennaPermIdx;          /* Antenna_Permutation_Index*/
+        /* Compress PCTs of all tones to 24bits */
+        uint32_t pct[RCL_BLE_CS_MAX_NUM_ANT_PATH];
+        RCL_Handler_BLE_CS_convertPcts(pct, src->pct, numTone, channel, rplScaler);
+
         for (uint8_t j = 0; j < numTone; j++)
         {
-            /* Compress PCT to 24bits */
-            int16_t i = src->pct[j].i;
-            int16_t q = src->pct[j].q;
-
-            uint32_t pct = RCL_Handler_BLE_CS_convertPct(i, q, channel, rplScaler);
-            *dst++       = (uint8_t)((pct) & 0xFF);
-            *dst++       = (uint8_t)((pct >> 8) & 0xFF);
-            *dst++       = (uint8_t)((pct >> 16) & 0xFF);
+            *dst++       = (uint8_t)((pct[j]) & 0xFF);
+            *dst++       = (uint8_t)((pct[j] >> 8) & 0xFF);
+            *dst++       = (uint8_t)((pct[j] >> 16) & 0xFF);
 
             /* Calculate PCT quality */
             bool toneExtensionSlot = (bool)(j == (numTone - 1));
@@ -1994,16 +2093,15 @@ static uint16_t RCL_Handler_BLE_CS_convertStepResult(RCL_CmdBleCs* pCmd, uint8_t
 
         /* Tone related data */
         *dst++ = src->antennaPermIdx;        /* Antenna_Permutation_Index*/
+        /* Compress PCTs of all tones to 24bits */
+        uint32_t pct[RCL_BLE_CS_MAX_NUM_ANT_PATH];
+        RCL_Handler_BLE_CS_convertPcts(pct, src->pct, numTone, channel, rplScaler);
+
         for (uint8_t j = 0; j < numTone; j++)
         {
-            /* Compress PCT to 24bits */
-            int16_t i = src->pct[j].i;
-            int16_t q = src->pct[j].q;
-
-            uint32_t pct = RCL_Handler_BLE_CS_convertPct(i, q, channel, rplScaler);
-            *dst++       = (uint8_t)((pct) & 0xFF);
-            *dst++       = (uint8_t)((pct >> 8) & 0xFF);
-            *dst++       = (uint8_t)((pct >> 16) & 0xFF);
+            *dst++       = (uint8_t)((pct[j]) & 0xFF);
+            *dst++       = (uint8_t)((pct[j] >> 8) & 0xFF);
+            *dst++       = (uint8_t)((pct[j] >> 16) & 0xFF);
 
             /* Calculate PCT quality */
             bool toneExtensionSlot = (bool)(j == (numTone - 1));
@@ -2041,6 +2139,23 @@ static uint16_t RCL_Handler_BLE_CS_convertStepResult(RCL_CmdBleCs* pCmd, uint8_t
     return (*dataLength + 3);
 }
 
+/*
+ *  ======== RCL_Handler_BLE_CS_convertStepResults ========
+ */
+uint32_t RCL_Handler_BLE_CS_convertStepResults(RCL_CmdBleCs *pCmd, uint8_t *dst, const RCL_CmdBleCs_StepResult_Internal *src, uint16_t numSteps)
+{
+    uint32_t nBytes = 0;
+
+    RCL_Handler_BLE_CS_initRotationLut();
+
+    for (uint16_t n = 0; n < numSteps; n++)
+    {
+        nBytes += RCL_Handler_BLE_CS_convertStepResult(pCmd, &dst[nBytes], &src[n]);
+    }
+
+    return (nBytes);
+}
+
 /*
  *  ======== RCL_Handler_BLE_CS_findPbeErrorEndStatus ========
  */
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== blecsstubs.c ========
+ *
+ * Functions referenced by the BLE CS command flow, which blecstest does
+ * not exercise.  They are defined in a separate file since their
+ * prototypes do not matter here.
+ */
+
+#include <stdlib.h>
+
+#define NOT_USED(name) void name(void) { abort(); }
+
+NOT_USED(RCL_MultiBuffer_findFirstWritableBuffer)
+NOT_USED(RCL_MultiBuffer_put)
+NOT_USED(RCL_MultiBuffer_getNextWritableByte)
+NOT_USED(RCL_MultiBuffer_commitBytes)
+NOT_USED(RCL_Scheduler_setStartStopTimeEarliestStart)
+NOT_USED(RCL_Scheduler_findStopStatus)
+NOT_USED(List_get)
+NOT_USED(List_put)
+NOT_USED(List_remove)
+NOT_USED(LRF_enable)
+NOT_USED(LRF_disable)
+NOT_USED(LRF_enableSynthRefsys)
+NOT_USED(LRF_disableSynthRefsys)
+NOT_USED(LRF_programTxPower)
+NOT_USED(LRF_waitForTopsmReady)
+NOT_USED(hal_power_set_swtcxo_update_constraint)
+NOT_USED(hal_power_release_swtcxo_update_constraint)
+NOT_USED(hal_set_rcl_clock_enable)
+NOT_USED(hal_get_temperature)
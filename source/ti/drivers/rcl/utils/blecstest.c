@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== blecstest.c ========
+ *
+ * Check and benchmark of the BLE CS step result conversion.
+ *
+ * handlers/ble_cs.c is compiled with the radio peripherals mapped to host
+ * memory at their device addresses; blecsstubs.c provides the functions
+ * of the command flow, which is not exercised.  The checks are:
+ *
+ * - RCL_Handler_BLE_CS_rotateVector() gives the same result as a plain
+ *   CORDIC rotation, with the angle driving the iterations, for all angles.
+ * - A step converted with the per channel rotation table gives the same
+ *   bytes as a step converted without it.
+ * - RCL_Handler_BLE_CS_convertStepResults() on a batch of steps gives the
+ *   same bytes as converting the steps one at a time in reverse order,
+ *   with the RX gain register and the command statistics changed in
+ *   between.  The conversion only uses the RX gain and PCT scaling stored
+ *   with each step, and does not modify the statistics.
+ *
+ * The benchmark prints the time to convert a mode-2 step with 5 tones.
+ *
+ * Usage:
+ *
+ *     blecstest
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+
+#include <ti/devices/DeviceFamily.h>
+#include DeviceFamily_constructPath(inc/hw_types.h)
+
+/* Plain loads instead of the Cortex-M LRF read sequences */
+#undef HWREG_READ_LRF
+#undef HWREGH_READ_LRF
+#define HWREG_READ_LRF(x)  HWREG(x)
+#define HWREGH_READ_LRF(x) HWREGH(x)
+
+#include "../handlers/ble_cs.c"
+
+#define PERIPHERAL_BASE 0x40000000U
+#define PERIPHERAL_SIZE 0x00100000U
+#define NUM_STEPS       64
+
+#define CHECK(cond, ...)                                       \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            if (failures++ < 20)                               \
+            {                                                  \
+                printf("FAIL %s:%d: ", __FILE__, __LINE__);    \
+                printf(__VA_ARGS__);                           \
+                printf("\n");                                  \
+            }                                                  \
+        }                                                      \
+    } while (0)
+
+static int failures;
+static uint32_t randomState = 1;
+
+static uint32_t random32(void)
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return (randomState);
+}
+
+static int16_t randomPct(void)
+{
+    switch (random32() % 8)
+    {
+    case 0:
+        return (INT16_MAX);
+    case 1:
+        return (INT16_MIN);
+    case 2:
+        return (0);
+    default:
+        return ((int16_t)random32());
+    }
+}
+
+/* CORDIC rotation with the angle driving each iteration, theta in [-pi, pi) */
+static void referenceRotate(int16_t *pct_i, int16_t *pct_q, int16_t theta)
+{
+    static const uint16_t atanLut[14] = {8192, 4836, 2555, 1297, 651, 326, 163, 81, 41, 20, 10, 5, 3, 1};
+    int32_t x = *pct_i;
+    int32_t y = *pct_q;
+    int32_t phi;
+
+    if (theta == 0)
+    {
+        return;
+    }
+    if (theta > (1 << 14))
+    {
+        theta -= (1 << 14);
+        x = -((int32_t)*pct_q);
+        y = +((int32_t)*pct_i);
+    }
+    else if (theta < -(1 << 14))
+    {
+        theta += (1 << 14);
+        x = +((int32_t)*pct_q);
+        y = -((int32_t)*pct_i);
+    }
+    x *= 9949;
+    y *= 9949;
+    phi = -theta;
+    for (int i = 0; i < 14; i++)
+    {
+        int32_t x1;
+        int32_t y1;
+
+        if (phi < 0)
+        {
+            phi += atanLut[i];
+            y1 = y + (x >> i);
+            x1 = x - (y >> i);
+        }
+        else
+        {
+            phi -= atanLut[i];
+            y1 = y - (x >> i);
+            x1 = x + (y >> i);
+        }
+        x = x1;
+        y = y1;
+    }
+    *pct_i = (int16_t)(x >> 14);
+    *pct_q = (int16_t)(y >> 14);
+}
+
+static void randomStep(RCL_CmdBleCs_StepResult_Internal *step)
+{
+    uint8_t *p = (uint8_t *)step;
+
+    for (size_t k = 0; k < sizeof(*step); k++)
+    {
+        p[k] = (uint8_t)random32();
+    }
+    step->mode       = random32() % 4;
+    step->channelIdx = random32() % (BLE_CS_MAX_CHANNEL + 1);
+    step->pktResult  = random32() % 3;
+    step->payloadLen = random32() % 5;
+    step->rplScaler  = random32() % 2;
+    step->rfGain     = (random32() % 2) ? BLE_CS_HIGH_GAIN_DB : BLE_CS_LOW_GAIN_DB;
+    for (int j = 0; j < RCL_BLE_CS_MAX_NUM_ANT_PATH; j++)
+    {
+        step->pct[j].i = randomPct();
+        step->pct[j].q = randomPct();
+    }
+}
+
+static void randomCommand(RCL_CmdBleCs *pCmd)
+{
+    pCmd->stats->numAntennaPath = 1 + random32() % (RCL_BLE_CS_MAX_NUM_ANT_PATH - 1);
+    pCmd->mode.role             = random32() % 2;
+    pCmd->reportFormat          = random32() % 2;
+}
+
+static void checkRotation(void)
+{
+    for (int32_t theta = INT16_MIN; theta <= INT16_MAX; theta++)
+    {
+        for (int k = 0; k < 4; k++)
+        {
+            int16_t i = randomPct();
+            int16_t q = randomPct();
+            int16_t refI = i;
+            int16_t refQ = q;
+
+            RCL_Handler_BLE_CS_rotateVector(&i, &q, (int16_t)theta);
+            referenceRotate(&refI, &refQ, (int16_t)theta);
+            CHECK(i == refI && q == refQ, "rotation by %d: (%d, %d), expected (%d, %d)",
+                  (int)theta, i, q, refI, refQ);
+        }
+    }
+}
+
+static void checkRotationLut(RCL_CmdBleCs *pCmd)
+{
+    static RCL_CmdBleCs_StepResult_Internal step;
+    static uint8_t direct[NUM_STEPS];
+    static uint8_t table[NUM_STEPS];
+
+    for (int n = 0; n < 100000; n++)
+    {
+        uint16_t lenDirect;
+        uint16_t lenTable;
+
+        randomCommand(pCmd);
+        randomStep(&step);
+        rotationLutValid = false;
+        lenDirect = RCL_Handler_BLE_CS_convertStepResult(pCmd, direct, &step);
+        RCL_Handler_BLE_CS_initRotationLut();
+        lenTable = RCL_Handler_BLE_CS_convertStepResult(pCmd, table, &step);
+        CHECK(lenDirect == lenTable && memcmp(direct, table, lenDirect) == 0,
+              "mode %d channel %d: conversion differs with the rotation table", step.mode, step.channelIdx);
+    }
+}
+
+static void checkDeferredConversion(RCL_CmdBleCs *pCmd)
+{
+    static RCL_CmdBleCs_StepResult_Internal steps[NUM_STEPS];
+    static uint8_t batch[NUM_STEPS * 64];
+    static uint8_t single[NUM_STEPS * 64];
+    uint32_t offset[NUM_STEPS];
+    uint32_t length[NUM_STEPS];
+
+    for (int n = 0; n < 2000; n++)
+    {
+        uint32_t lenBatch;
+        uint32_t lenSingle = 0;
+        uint32_t pos = 0;
+
+        randomCommand(pCmd);
+        for (int k = 0; k < NUM_STEPS; k++)
+        {
+            randomStep(&steps[k]);
+        }
+
+        pCmd->stats->rplScaler = 0;
+        HWREG(LRFDRFE_BASE + LRFDRFE_O_RFGAIN) = BLE_CS_HIGH_GAIN_DB;
+        lenBatch = RCL_Handler_BLE_CS_convertStepResults(pCmd, batch, steps, NUM_STEPS);
+        CHECK(pCmd->stats->rplScaler == 0, "statistics modified");
+
+        pCmd->stats->rplScaler = 1;
+        HWREG(LRFDRFE_BASE + LRFDRFE_O_RFGAIN) = BLE_CS_LOW_GAIN_DB;
+        for (int k = NUM_STEPS - 1; k >= 0; k--)
+        {
+            offset[k]  = lenSingle;
+            length[k]  = RCL_Handler_BLE_CS_convertStepResults(pCmd, &single[lenSingle], &steps[k], 1);
+            lenSingle += length[k];
+        }
+        CHECK(pCmd->stats->rplScaler == 1, "statistics modified");
+        CHECK(lenBatch == lenSingle, "batch of %u bytes, %u bytes step by step", lenBatch, lenSingle);
+        for (int k = 0; k < NUM_STEPS && lenBatch == lenSingle; k++)
+        {
+            CHECK(memcmp(&batch[pos], &single[offset[k]], length[k]) == 0,
+                  "step %d converted differently in the batch", k);
+            pos += length[k];
+        }
+    }
+}
+
+static void bench(RCL_CmdBleCs *pCmd)
+{
+    static RCL_CmdBleCs_StepResult_Internal steps[256];
+    static uint8_t buffer[256 * 32];
+    volatile uint32_t sink = 0;
+    struct timespec start;
+    struct timespec end;
+    const int repeats = 2000;
+
+    pCmd->stats->numAntennaPath = RCL_BLE_CS_MAX_NUM_ANT_PATH - 1;
+    memset(steps, 0, sizeof(steps));
+    for (int k = 0; k < 256; k++)
+    {
+        steps[k].mode       = 2;
+        steps[k].channelIdx = 2 + k % 75;
+        steps[k].rfGain     = BLE_CS_HIGH_GAIN_DB;
+        for (int j = 0; j < RCL_BLE_CS_MAX_NUM_ANT_PATH; j++)
+        {
+            steps[k].pct[j].i = 1000 * j - 1234 + k;
+            steps[k].pct[j].q = 777 - 300 * j + k;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int n = 0; n < repeats; n++)
+    {
+        sink += RCL_Handler_BLE_CS_convertStepResults(pCmd, buffer, steps, 256);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    printf("mode-2 step with 5 tones: %.1f ns\n",
+           ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / repeats / 256);
+}
+
+int main(int argc, char *argv[])
+{
+    static RCL_CmdBleCs cmd;
+    static RCL_CmdBleCs_Stats stats;
+
+    if (mmap((void *)PERIPHERAL_BASE, PERIPHERAL_SIZE, PROT_READ | PROT_WRITE,
+             MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) == MAP_FAILED)
+    {
+        printf("cannot map the peripherals at 0x%08x\n", PERIPHERAL_BASE);
+        return (2);
+    }
+    cmd.stats = &stats;
+
+    checkRotation();
+    checkRotationLut(&cmd);
+    checkDeferredConversion(&cmd);
+    if (failures != 0)
+    {
+        printf("%d failures\n", failures);
+        return (1);
+    }
+    printf("checks passed\n");
+    bench(&cmd);
+    return (0);
+}
@@ -0,0 +1,444 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== lrfdeltatest.c ========
+ *
+ * Check and benchmark of the LRF configuration deltas.
+ *
+ * LRF.c is compiled with the LRF registers, the PBE RAM and the software
+ * parameters placed in host memory.  For random register configurations
+ * with shared and PHY specific segments, each delta between two of them
+ * is applied on top of the first configuration and compared with a full
+ * application of the second one.  Registers modified at runtime and
+ * reloaded TOPsm images are scrambled in between, as on the radio.  The
+ * registry is checked with LRF_ConfigDelta_find(), and the average number
+ * of writes of the full configurations and of the deltas is printed.
+ *
+ * Usage:
+ *
+ *     lrfdeltatest [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ti/drivers/rcl/LRF.h>
+
+static uint8_t lrfMem[0x10000] __attribute__((aligned(4)));
+static uint8_t pbeRam[0x10000] __attribute__((aligned(4)));
+
+#undef LRF_BASE_ADDR
+#undef PBE_RAM_BASE_ADDR
+#define LRF_BASE_ADDR     ((uintptr_t)lrfMem)
+#define PBE_RAM_BASE_ADDR ((uintptr_t)pbeRam)
+
+#include "../LRF.c"
+
+#define NUM_CONFIGS 8
+#define MAX_ENTRIES 3
+#define MAX_WORDS   256
+#define CHECKED     0x400
+
+uint32_t swParamList[64];
+const size_t swParamListSz = sizeof(swParamList);
+
+/* Registers and TOPsm RAM words changed at runtime, see LRF_ConfigDelta_isVolatile() */
+static const uint16_t volatileRegs[]  = {0x040, 0x084, 0x100};
+static const uint16_t volatileRamWord = 0x00C;
+
+typedef struct {
+    uint32_t        numEntries;
+    LRF_ConfigWord *entries[MAX_ENTRIES];
+} ConfigList;
+
+static uint32_t segments[NUM_CONFIGS][MAX_ENTRIES][MAX_WORDS];
+static ConfigList lists[NUM_CONFIGS];
+static LRF_Config configs[NUM_CONFIGS];
+static const LRF_TOPsmImage *images[2] = {(const LRF_TOPsmImage *)0x1000, (const LRF_TOPsmImage *)0x2000};
+static LRF_ConfigDeltaWrite writes[1024];
+static const uint32_t values[] = {0, 1, 0x1234, 0xFFFF, 0xABCD0001};
+
+void RCL_Debug_assertProxy(const char *expr, const char *file, int line)
+{
+    printf("assert %s at %s:%d\n", expr, file, line);
+    abort();
+}
+
+uintptr_t HwiP_disable(void)
+{
+    return (0);
+}
+
+void HwiP_restore(uintptr_t key)
+{
+    (void)key;
+}
+
+LRF_TxPowerTable_Entry LRF_getRawTxPower(void)
+{
+    return ((LRF_TxPowerTable_Entry){0});
+}
+
+bool LRF_ConfigDelta_isVolatile(uintptr_t address, uint32_t size)
+{
+    uintptr_t ramAddress = PBE_RAM_BASE_ADDR + volatileRamWord;
+    uint32_t i;
+
+    for (i = 0; i < sizeof(volatileRegs) / sizeof(volatileRegs[0]); i++)
+    {
+        uintptr_t regAddress = LRF_BASE_ADDR + volatileRegs[i];
+
+        if (address < regAddress + sizeof(uint32_t) && regAddress < address + size)
+        {
+            return (true);
+        }
+    }
+    return (address < ramAddress + sizeof(uint16_t) && ramAddress < address + size);
+}
+
+static uint32_t random32(void)
+{
+    static uint64_t state = 88172645463325252ULL;
+
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return ((uint32_t)state);
+}
+
+/* Random segment of up to four regions of all operations; returns the number of words */
+static uint32_t makeSegment(uint32_t *buf)
+{
+    static const uint32_t operations[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 11};
+    uint32_t numRegions = 1 + random32() % 4;
+    uint32_t n = 1;
+    uint32_t featureMask;
+    uint32_t inverted;
+
+    for (uint32_t r = 0; r < numRegions; r++)
+    {
+        uint32_t op  = operations[random32() % 11];
+        uint32_t len = 1 + random32() % 5;
+        uint32_t start;
+        uint32_t numWords;
+
+        if (op <= 3 || op == 11)
+        {
+            start = (random32() % 0x30) * 4 + 0x40 * (random32() % 2);
+        }
+        else if (op <= 7)
+        {
+            start = (random32() % 0x40) * 2;
+        }
+        else
+        {
+            start = (random32() % 16) * 4;
+            if (op != 11 && start + len * 4 > swParamListSz)
+            {
+                len = 1;
+            }
+        }
+        if (op == 3 || op == 6 || op == 7)
+        {
+            start &= ~3U;
+        }
+        buf[n++] = ((len - 1) & 0xFFF) | (op << 12) | (start << 16);
+        if (op == 0 || op == 4 || op == 8)
+        {
+            continue;
+        }
+        numWords = (op == 1 || op == 5) ? (len + 1) / 2 : len;
+        for (uint32_t i = 0; i < numWords; i++)
+        {
+            uint32_t v = values[random32() % 5];
+
+            if (op == 1 || op == 5)
+            {
+                v = (values[random32() % 5] & 0xFFFF) | (values[random32() % 5] << 16);
+            }
+            else if (op == 3)
+            {
+                v = (v & 0xFFFF) | (((random32() % 0x30) * 2) << 16);
+            }
+            else if (op == 7)
+            {
+                v = (v & 0xFFFF) | (((random32() % 0x40) * 2) << 16);
+            }
+            buf[n++] = v;
+        }
+    }
+    featureMask = (random32() % 3 == 0) ? (1U << (random32() % 3)) : 0;
+    inverted    = (featureMask != 0 && random32() % 2) ? 1 : 0;
+    buf[0] = (n - 1) | (inverted << 14) | (featureMask << 16);
+    return (n);
+}
+
+static void makeConfigs(void)
+{
+    for (int c = 0; c < NUM_CONFIGS; c++)
+    {
+        lists[c].numEntries = 1 + random32() % MAX_ENTRIES;
+        for (uint32_t e = 0; e < lists[c].numEntries; e++)
+        {
+            makeSegment(segments[c][e]);
+            lists[c].entries[e] = (LRF_ConfigWord *)segments[c][e];
+        }
+        /* Half of the configurations share the base segment of the first one */
+        if (c > 0 && random32() % 2)
+        {
+            memcpy(segments[c][0], segments[0][0], sizeof(segments[0][0]));
+        }
+        configs[c].pbeImage      = images[random32() % 2];
+        configs[c].mceImage      = images[0];
+        configs[c].rfeImage      = images[0];
+        configs[c].regConfigList = (const LRF_RegConfigList *)&lists[c];
+    }
+}
+
+static void applyFull(const LRF_Config *config, uint16_t phyFeatures)
+{
+    LRF_ApplySettingsState state;
+
+    LRF_initSettingsState(&state, LRF_ApplySettings_IncludeBase, phyFeatures);
+    for (uint32_t i = 0; i < config->regConfigList->numEntries; i++)
+    {
+        if (LRF_applySettings(config->regConfigList->entries[i], &state, LRF_SETTINGS_BUFFER_UNLIMITED) != SetupResult_Ok)
+        {
+            printf("full configuration failed\n");
+            exit(1);
+        }
+    }
+}
+
+/* Changes done by trim and temperature compensation while a PHY is in use */
+static void scrambleVolatile(uint32_t seed)
+{
+    srand(seed);
+    for (uint32_t i = 0; i < sizeof(volatileRegs) / sizeof(volatileRegs[0]); i++)
+    {
+        *(uint32_t *)(lrfMem + volatileRegs[i]) = rand();
+    }
+    *(uint16_t *)(pbeRam + volatileRamWord) = rand();
+}
+
+static void loadImage(uint32_t seed)
+{
+    srand(seed);
+    for (int i = 0; i < 0x100; i++)
+    {
+        pbeRam[i] = rand();
+    }
+}
+
+/* Applies the delta from f to t and compares with a full application of t */
+static int checkDelta(int f, int t, uint16_t phyFeatures, const LRF_ConfigDelta *delta, int iteration)
+{
+    static uint8_t refLrf[CHECKED], refPbe[CHECKED], savedLrf[CHECKED], savedPbe[CHECKED];
+    static uint32_t refPar[64], savedPar[64];
+    bool imageChanged = configs[f].pbeImage != configs[t].pbeImage;
+    uint32_t seed      = random32();
+    uint32_t imageSeed = random32();
+
+    for (int i = 0; i < CHECKED; i++)
+    {
+        lrfMem[i] = pbeRam[i] = (uint8_t)(i * 7 + iteration);
+    }
+    memset(swParamList, 0x5A, sizeof(swParamList));
+    applyFull(&configs[f], phyFeatures);
+    scrambleVolatile(seed);
+    memcpy(savedLrf, lrfMem, CHECKED);
+    memcpy(savedPbe, pbeRam, CHECKED);
+    memcpy(savedPar, swParamList, sizeof(savedPar));
+
+    if (imageChanged)
+    {
+        loadImage(imageSeed);
+    }
+    applyFull(&configs[t], phyFeatures);
+    memcpy(refLrf, lrfMem, CHECKED);
+    memcpy(refPbe, pbeRam, CHECKED);
+    memcpy(refPar, swParamList, sizeof(refPar));
+
+    memcpy(lrfMem, savedLrf, CHECKED);
+    memcpy(pbeRam, savedPbe, CHECKED);
+    memcpy(swParamList, savedPar, sizeof(savedPar));
+    if (imageChanged)
+    {
+        loadImage(imageSeed);
+    }
+    LRF_ConfigDelta_apply(delta);
+
+    if (memcmp(refLrf, lrfMem, CHECKED) != 0 || memcmp(refPbe, pbeRam, CHECKED) != 0 ||
+        memcmp(refPar, swParamList, sizeof(refPar)) != 0)
+    {
+        printf("FAIL iteration %d: delta %d -> %d, features 0x%x, image change %d\n",
+               iteration, f, t, phyFeatures, imageChanged);
+        return (1);
+    }
+    return (0);
+}
+
+static int checkRandom(int iterations)
+{
+    long totalFull  = 0;
+    long totalDelta = 0;
+    long cases      = 0;
+
+    for (int iteration = 0; iteration < iterations; iteration++)
+    {
+        makeConfigs();
+        for (int f = 0; f < NUM_CONFIGS; f++)
+        {
+            for (int t = 0; t < NUM_CONFIGS; t++)
+            {
+                uint16_t phyFeatures = random32() % 8;
+                LRF_ConfigDelta delta;
+                LRF_ConfigDelta counted;
+                LRF_ConfigDelta full;
+                LRF_Config none = {images[0], images[1], images[1], NULL};
+
+                if (f == t)
+                {
+                    continue;
+                }
+                if (LRF_ConfigDelta_init(&counted, &configs[f], &configs[t], phyFeatures, NULL, 0) != SetupResult_Ok ||
+                    LRF_ConfigDelta_init(&delta, &configs[f], &configs[t], phyFeatures, writes, 1024) != SetupResult_Ok)
+                {
+                    printf("FAIL iteration %d: LRF_ConfigDelta_init\n", iteration);
+                    return (1);
+                }
+                if (counted.numWrites != delta.numWrites)
+                {
+                    printf("FAIL iteration %d: counted %d writes, found %d\n", iteration, counted.numWrites, delta.numWrites);
+                    return (1);
+                }
+                if (delta.numWrites > 0 &&
+                    LRF_ConfigDelta_init(&counted, &configs[f], &configs[t], phyFeatures, writes, delta.numWrites - 1) != SetupResult_ErrorConfigLen)
+                {
+                    printf("FAIL iteration %d: short write buffer accepted\n", iteration);
+                    return (1);
+                }
+                LRF_ConfigDelta_init(&delta, &configs[f], &configs[t], phyFeatures, writes, 1024);
+                if (checkDelta(f, t, phyFeatures, &delta, iteration) != 0)
+                {
+                    return (1);
+                }
+                LRF_ConfigDelta_init(&full, &none, &configs[t], phyFeatures, NULL, 0);
+                totalFull  += full.numWrites;
+                totalDelta += delta.numWrites;
+                cases++;
+            }
+        }
+    }
+    printf("random configurations: %ld deltas, %.1f writes for a full configuration, %.1f for a delta\n",
+           cases, (double)totalFull / cases, (double)totalDelta / cases);
+    return (0);
+}
+
+/* Two PHYs sharing 120 register and 40 RAM values, 8 of which differ */
+static void benchSharedBase(void)
+{
+    static uint32_t a[200], b[200];
+    static ConfigList listA, listB;
+    LRF_Config configA, configB;
+    LRF_ConfigDelta delta;
+    uint32_t n = 1;
+
+    a[n++] = 119U | (2U << 12) | (0x200U << 16);
+    for (uint32_t i = 0; i < 120; i++)
+    {
+        a[n++] = i * 0x01010101U;
+    }
+    a[n++] = 39U | (6U << 12) | (0x100U << 16);
+    for (uint32_t i = 0; i < 40; i++)
+    {
+        a[n++] = 0xA5000000U + i;
+    }
+    a[0] = n - 1;
+    memcpy(b, a, sizeof(a));
+    for (int k = 0; k < 8; k++)
+    {
+        b[2 + k * 15] ^= 0x10;
+    }
+    listA.numEntries = 1;
+    listA.entries[0] = (LRF_ConfigWord *)a;
+    listB.numEntries = 1;
+    listB.entries[0] = (LRF_ConfigWord *)b;
+    configA = (LRF_Config){images[0], images[0], images[0], (const LRF_RegConfigList *)&listA};
+    configB = (LRF_Config){images[0], images[0], images[0], (const LRF_RegConfigList *)&listB};
+
+    LRF_ConfigDelta_init(&delta, &configA, &configB, 0, writes, 1024);
+    printf("shared base PHY switch: 160 writes for a full configuration, %d for the delta\n", delta.numWrites);
+    configB.pbeImage = images[1];
+    LRF_ConfigDelta_init(&delta, &configA, &configB, 0, writes, 1024);
+    printf("shared base PHY switch with a new PBE image: %d writes for the delta\n", delta.numWrites);
+}
+
+static int checkRegistry(void)
+{
+    LRF_ConfigDelta a;
+    LRF_ConfigDelta b;
+
+    LRF_ConfigDelta_init(&a, &configs[0], &configs[1], 0, writes, 1024);
+    LRF_ConfigDelta_init(&b, &configs[1], &configs[0], 0, writes, 1024);
+    LRF_ConfigDelta_register(&a);
+    LRF_ConfigDelta_register(&b);
+    if (LRF_ConfigDelta_find(&configs[0], &configs[1], 0) != &a ||
+        LRF_ConfigDelta_find(&configs[1], &configs[0], 0) != &b ||
+        LRF_ConfigDelta_find(&configs[0], &configs[1], 1) != NULL)
+    {
+        printf("FAIL registry: LRF_ConfigDelta_find\n");
+        return (1);
+    }
+    LRF_ConfigDelta_unregister(&a);
+    if (LRF_ConfigDelta_find(&configs[0], &configs[1], 0) != NULL)
+    {
+        printf("FAIL registry: LRF_ConfigDelta_unregister\n");
+        return (1);
+    }
+    LRF_ConfigDelta_unregister(&b);
+    printf("registry OK\n");
+    return (0);
+}
+
+int main(int argc, char *argv[])
+{
+    int iterations = (argc > 1) ? atoi(argv[1]) : 3000;
+
+    if (checkRandom(iterations) != 0 || checkRegistry() != 0)
+    {
+        return (1);
+    }
+    benchSharedBase();
+    return (0);
+}
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== rclcommandqueuetest.c ========
+ *
+ * Check and benchmark of the RCL command queue.
+ *
+ * RCL_CommandQueue.c is compiled with a queue of QUEUE_SIZE commands.
+ * Random inserts, removals and pops, with start times around the SYSTIM
+ * wrap, are checked against a plain scan of the queue:
+ *
+ * - RCL_CommandQueue_pop() returns the first command, or the earliest
+ *   command of a higher priority client starting before the first one
+ *   could end
+ * - RCL_CommandQueue_findConflict() finds a conflict exactly when a
+ *   command of the same or higher priority overlaps the new window, and
+ *   only returns such a command
+ *
+ * The benchmark fills the queue with periodic commands and prints the
+ * time of a pop followed by an insert, and of an admission check near the
+ * head of the queue, next to the time of the plain scans.
+ *
+ * Usage:
+ *
+ *     rclcommandqueuetest [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../RCL_CommandQueue.c"
+
+#define QUEUE_SIZE RCL_COMMAND_QUEUE_SIZE
+
+#define CHECK(cond, ...)                                       \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            if (failures++ < 20)                               \
+            {                                                  \
+                printf("FAIL %s:%d: ", __FILE__, __LINE__);    \
+                printf(__VA_ARGS__);                           \
+                printf("\n");                                  \
+            }                                                  \
+        }                                                      \
+    } while (0)
+
+static int failures;
+static uint32_t randomState = 1;
+static RCL_Command commands[QUEUE_SIZE];
+static RCL_CommandQueue queue;
+
+static uint32_t random32(void)
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return (randomState);
+}
+
+/* Command to plan next, found by scanning the whole queue */
+static RCL_Command *scanPop(const RCL_CommandQueue *q, uint32_t readyTime)
+{
+    const RCL_CommandQueueEntry *first = &q->entries[0];
+    uint32_t startTime = ((int32_t)(first->startTime - readyTime) > 0) ? first->startTime : readyTime;
+    uint32_t duration = RCL_CommandQueue_getDuration(first->cmd);
+    const RCL_CommandQueueEntry *best = first;
+
+    for (uint32_t i = 1; i < q->numEntries; i++)
+    {
+        const RCL_CommandQueueEntry *entry = &q->entries[i];
+        if (RCL_CommandQueue_mustYield(startTime, duration, first->priority, entry->startTime, entry->priority) &&
+            (best == first || rclCommandQueueEntryIsBefore(entry, best)))
+        {
+            best = entry;
+        }
+    }
+    return (best->cmd);
+}
+
+/* Whether a queued command may not be overlapped, found by scanning the whole queue */
+static bool scanConflict(const RCL_CommandQueue *q, uint32_t startTime, uint32_t duration, uint8_t priority,
+                         RCL_Command *cmd)
+{
+    for (uint32_t i = 0; i < q->numEntries; i++)
+    {
+        const RCL_CommandQueueEntry *entry = &q->entries[i];
+        if ((cmd == NULL || entry->cmd == cmd) && entry->priority >= priority &&
+            RCL_CommandQueue_overlaps(startTime, duration, entry->startTime, RCL_CommandQueue_getDuration(entry->cmd)))
+        {
+            return (true);
+        }
+    }
+    return (false);
+}
+
+static RCL_Command *freeCommand(void)
+{
+    for (int i = 0; i < QUEUE_SIZE; i++)
+    {
+        bool queued = false;
+        for (uint32_t k = 0; k < queue.numEntries; k++)
+        {
+            queued = queued || (queue.entries[k].cmd == &commands[i]);
+        }
+        if (!queued)
+        {
+            return (&commands[i]);
+        }
+    }
+    return (NULL);
+}
+
+static void checkRandom(int iterations)
+{
+    /* Close to the SYSTIM wrap */
+    uint32_t now = 0xFFFFFFFFU - 40000U;
+
+    RCL_CommandQueue_init(&queue);
+    for (int n = 0; n < iterations; n++)
+    {
+        uint32_t op = random32() % 8;
+        uint32_t startTime = now + random32() % 20000;
+        uint32_t duration = (random32() % 4 == 0) ? 0 : 1 + random32() % 3000;
+        uint8_t priority = random32() % 4;
+
+        now += random32() % 64;
+        if (op < 4 && queue.numEntries < QUEUE_SIZE)
+        {
+            RCL_Command *cmd = freeCommand();
+            cmd->timing.relHardStopTime = duration;
+            CHECK(RCL_CommandQueue_insert(&queue, cmd, startTime, priority), "insert failed");
+        }
+        else if (op == 4 && queue.numEntries > 0)
+        {
+            RCL_Command *cmd = queue.entries[random32() % queue.numEntries].cmd;
+            CHECK(RCL_CommandQueue_remove(&queue, cmd), "remove failed");
+        }
+        else if (op == 5 && queue.numEntries > 0)
+        {
+            RCL_Command *expected = scanPop(&queue, now);
+            RCL_Command *cmd = RCL_CommandQueue_pop(&queue, now);
+            CHECK(cmd == expected, "pop returned command %d, expected %d", (int)(cmd - commands),
+                  (int)(expected - commands));
+        }
+        else
+        {
+            uint32_t window = (duration == 0) ? 1 : duration;
+            RCL_Command *conflict = RCL_CommandQueue_findConflict(&queue, startTime, window, priority);
+            bool expected = scanConflict(&queue, startTime, window, priority, NULL);
+            CHECK((conflict != NULL) == expected, "conflict %s, expected %s", conflict ? "found" : "not found",
+                  expected ? "one" : "none");
+            CHECK(conflict == NULL || scanConflict(&queue, startTime, window, priority, conflict),
+                  "command %d does not conflict", (int)(conflict - commands));
+        }
+        /* The first command is the earliest one */
+        for (uint32_t i = 1; i < queue.numEntries; i++)
+        {
+            CHECK(!rclCommandQueueEntryIsBefore(&queue.entries[i], &queue.entries[0]), "heap order broken");
+        }
+    }
+}
+
+static double nsSince(const struct timespec *start, uint32_t count)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (((end.tv_sec - start->tv_sec) * 1e9 + (end.tv_nsec - start->tv_nsec)) / count);
+}
+
+/* Commands every 1 ms for 1 ms, alternating between two priorities */
+static void fillPeriodic(void)
+{
+    RCL_CommandQueue_init(&queue);
+    for (int i = 0; i < QUEUE_SIZE; i++)
+    {
+        commands[i].timing.relHardStopTime = 4000;
+        RCL_CommandQueue_insert(&queue, &commands[i], (uint32_t)(QUEUE_SIZE - i) * 4000U, (uint8_t)(i % 2));
+    }
+}
+
+static void bench(void)
+{
+    const uint32_t repeats = 1000000;
+    volatile uintptr_t sink = 0;
+    struct timespec start;
+    double heapPop, scanPopTime, heapConflict, scanConflictTime;
+
+    fillPeriodic();
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t n = 0; n < repeats; n++)
+    {
+        RCL_Command *cmd = RCL_CommandQueue_pop(&queue, (n + 1) * 4000U);
+        RCL_CommandQueue_insert(&queue, cmd, (QUEUE_SIZE + 1 + n) * 4000U, (uint8_t)(n % 2));
+        sink += (uintptr_t)cmd;
+    }
+    heapPop = nsSince(&start, repeats);
+
+    fillPeriodic();
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t n = 0; n < repeats; n++)
+    {
+        sink += (uintptr_t)scanPop(&queue, 4000U);
+    }
+    scanPopTime = nsSince(&start, repeats);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t n = 0; n < repeats; n++)
+    {
+        sink += (uintptr_t)RCL_CommandQueue_findConflict(&queue, 2000 + n % 8, 1000, 2);
+    }
+    heapConflict = nsSince(&start, repeats);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t n = 0; n < repeats; n++)
+    {
+        sink += scanConflict(&queue, 2000 + n % 8, 1000, 2, NULL);
+    }
+    scanConflictTime = nsSince(&start, repeats);
+
+    printf("%d queued commands: pop and insert %.1f ns (scan for the pop alone %.1f ns)\n", QUEUE_SIZE, heapPop,
+           scanPopTime);
+    printf("%d queued commands: admission check near the head %.1f ns (scan %.1f ns)\n", QUEUE_SIZE, heapConflict,
+           scanConflictTime);
+}
+
+int main(int argc, char *argv[])
+{
+    int iterations = (argc > 1) ? atoi(argv[1]) : 1000000;
+
+    checkRandom(iterations);
+    if (failures != 0)
+    {
+        printf("%d failures\n", failures);
+        return (1);
+    }
+    printf("checks passed\n");
+    bench();
+    return (0);
+}
@@ -0,0 +1,461 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== rclprofilingtest.c ========
+ *
+ * Check and benchmark of the RCL profiling trace.
+ *
+ * RCL_Profiling.c is compiled with RCL_PROFILING_TRACE=1 and with Log
+ * enabled for LogModule_RCL.  The Log sink below formats the records of
+ * RCL_Profiling_dump() like the log viewer does, and the checks parse them.
+ *
+ *  - Ring overflow: only the last RCL_PROFILING_TRACE_SIZE events are
+ *    printed, in order and with the values recorded.
+ *  - Events recorded while dumping, as from an interrupt during the Log
+ *    output: entries overwritten before they are printed are skipped,
+ *    nothing printed is a mix of two events, and the new events are kept
+ *    for the next dump.
+ *  - Histograms: log2 binning, count, min, max and total, durations across
+ *    a SYSTIM wrap, and functions beyond RCL_PROFILING_NUM_HISTOGRAMS.
+ *  - Time per traced event and per measured duration.
+ *
+ * Usage:
+ *
+ *     rclprofilingtest [dump-file]
+ *
+ *     The last dump is written to dump-file, as input for
+ *     tools/common/rcl_profiling/rcl_profiling_tool.py.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <ti/drivers/rcl/RCL_Profiling.h>
+#include <ti/drivers/rcl/RCL_Scheduler.h>
+#include <ti/drivers/dpl/HwiP.h>
+#include <ti/log/Log.h>
+
+#define MAX_LINES 4096
+#define TIME_STEP 5
+
+#define CHECK(cond, ...)                                       \
+    do                                                         \
+    {                                                          \
+        if (!(cond))                                           \
+        {                                                      \
+            if (failures++ < 20)                               \
+            {                                                  \
+                printf("FAIL %s:%d: ", __FILE__, __LINE__);    \
+                printf(__VA_ARGS__);                           \
+                printf("\n");                                  \
+            }                                                  \
+        }                                                      \
+    } while (0)
+
+RCL_SchedulerState rclSchedulerState;
+
+static uint32_t now;
+static uint32_t timeBase;
+static uint32_t numEvents;
+static int failures;
+
+/* Printed dump */
+static char lines[MAX_LINES][128];
+static int numLines;
+
+/* Events to record from the Log sink after the given number of trace lines */
+static int interruptAfter = -1;
+static uint32_t interruptEvents;
+
+static void recordEvents(uint32_t count);
+
+uint32_t hal_get_current_time(void)
+{
+    return (now);
+}
+
+uintptr_t HwiP_disable(void)
+{
+    return (0);
+}
+
+void HwiP_restore(uintptr_t key)
+{
+    (void)key;
+}
+
+/*
+ *  ======== logSink ========
+ *  The header is the format string with its meta data; the sixth field
+ *  holds the quoted format.
+ */
+static void logSink(uint32_t header, uint32_t numArgs, va_list ap)
+{
+    const char *field = (const char *)(uintptr_t)header;
+    char format[128];
+    uintptr_t args[8] = {0};
+    size_t len;
+
+    for (int i = 0; i < 5; i++)
+    {
+        field = strchr(field, '\x1e') + 1;
+    }
+    len = strchr(field, '\x1e') - field - 2;
+    memcpy(format, field + 1, len);
+    format[len] = '\0';
+    for (uint32_t i = 0; i < numArgs; i++)
+    {
+        args[i] = va_arg(ap, uintptr_t);
+    }
+    if (numLines < MAX_LINES)
+    {
+        snprintf(lines[numLines++], sizeof(lines[0]), format,
+                 (uint32_t)args[0], (uint32_t)args[1], (uint32_t)args[2], (uint32_t)args[3],
+                 (uint32_t)args[4], (uint32_t)args[5], (uint32_t)args[6], (uint32_t)args[7]);
+    }
+    if (strncmp(format, "RCL_Profiling_trace:", 20) == 0 && interruptAfter >= 0 && interruptAfter-- == 0)
+    {
+        recordEvents(interruptEvents);
+    }
+}
+
+static void logPrintf(const Log_Module *handle, uint32_t header, uint32_t headerPtr, uint32_t numArgs, ...)
+{
+    va_list ap;
+
+    va_start(ap, numArgs);
+    logSink(header, numArgs, ap);
+    va_end(ap);
+}
+
+#define LOG_PRINTF_N(name, n)                                                       \
+    static void name(const Log_Module *handle, uint32_t header, uint32_t headerPtr, ...) \
+    {                                                                               \
+        va_list ap;                                                                 \
+                                                                                    \
+        va_start(ap, headerPtr);                                                    \
+        logSink(header, n, ap);                                                     \
+        va_end(ap);                                                                 \
+    }
+
+LOG_PRINTF_N(logPrintf0, 0)
+LOG_PRINTF_N(logPrintf1, 1)
+LOG_PRINTF_N(logPrintf2, 2)
+LOG_PRINTF_N(logPrintf3, 3)
+
+const Log_Module LogMod_LogModule_RCL = {
+    .printf  = logPrintf,
+    .printf0 = logPrintf0,
+    .printf1 = logPrintf1,
+    .printf2 = logPrintf2,
+    .printf3 = logPrintf3,
+    .levels  = Log_ALL,
+};
+
+/* Event number n has values derived from n, so that mixed entries can be found */
+static RCL_ProfilingEvent eventOf(uint32_t n)
+{
+    return ((RCL_ProfilingEvent)(RCL_ProfilingEvent_PreprocStart + n % 24));
+}
+
+static void recordEvents(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t n = numEvents++;
+
+        now = timeBase + n * TIME_STEP;
+        RCL_Profiling_traceEvent(eventOf(n), (uint16_t)(n * 3));
+    }
+}
+
+static void dump(void)
+{
+    numLines = 0;
+    RCL_Profiling_dump();
+}
+
+/* Checks the trace lines of the last dump; returns the sequence numbers printed */
+static uint32_t checkTrace(uint32_t *first, uint32_t *last)
+{
+    uint32_t printed = 0;
+    uint32_t prev = 0;
+
+    for (int i = 0; i < numLines; i++)
+    {
+        uint32_t seq, event, cmdId, timestamp;
+
+        if (sscanf(lines[i], "RCL_Profiling_trace: %u %u 0x%x 0x%x", &seq, &event, &cmdId, &timestamp) != 4)
+        {
+            continue;
+        }
+        CHECK(event == (uint32_t)eventOf(seq) && cmdId == ((seq * 3) & 0xFFFF) &&
+              timestamp == timeBase + seq * TIME_STEP, "entry %u printed as %s", seq, lines[i]);
+        CHECK(printed == 0 || seq > prev, "entry %u printed after %u", seq, prev);
+        if (printed++ == 0)
+        {
+            *first = seq;
+        }
+        prev = seq;
+    }
+    *last = prev;
+    return (printed);
+}
+
+static void checkRing(void)
+{
+    uint32_t first, last, printed;
+
+    /* Fewer events than entries, then wrapped several times */
+    RCL_Profiling_reset();
+    numEvents = 0;
+    timeBase = 0xFFFFF000U;
+    recordEvents(10);
+    dump();
+    printed = checkTrace(&first, &last);
+    CHECK(printed == 10 && first == 0 && last == 9, "dump of 10 events: %u printed", printed);
+    CHECK(strcmp(lines[0], "RCL_Profiling_dump: start 10 0") == 0, "start line %s", lines[0]);
+    CHECK(strcmp(lines[numLines - 1], "RCL_Profiling_dump: end") == 0, "end line %s", lines[numLines - 1]);
+
+    recordEvents(3 * RCL_PROFILING_TRACE_SIZE + 7);
+    dump();
+    printed = checkTrace(&first, &last);
+    CHECK(printed == RCL_PROFILING_TRACE_SIZE && last == numEvents - 1 && first == numEvents - RCL_PROFILING_TRACE_SIZE,
+          "wrapped dump: %u printed, %u to %u of %u", printed, first, last, numEvents);
+}
+
+static void checkConcurrentRecording(void)
+{
+    for (uint32_t events = 1; events <= 2 * RCL_PROFILING_TRACE_SIZE; events += 7)
+    {
+        for (int after = 0; after < 4; after++)
+        {
+            uint32_t first, last, printed, head;
+
+            RCL_Profiling_reset();
+            numEvents = 0;
+            timeBase = 1000;
+            recordEvents(RCL_PROFILING_TRACE_SIZE + 3);
+            head = numEvents;
+            interruptAfter = after * (RCL_PROFILING_TRACE_SIZE / 4);
+            interruptEvents = events;
+            dump();
+            interruptAfter = -1;
+
+            /* Printed entries are from the dumped range, those before the
+             * interrupt in full, those overwritten by it not at all.
+             */
+            printed = checkTrace(&first, &last);
+            CHECK(first == head - RCL_PROFILING_TRACE_SIZE && last < head, "dump interrupted by %u events: %u to %u",
+                  events, first, last);
+            {
+                uint32_t printedBefore = (uint32_t)after * (RCL_PROFILING_TRACE_SIZE / 4) + 1;
+                uint32_t overwritten = (events > printedBefore) ? events - printedBefore : 0;
+
+                if (overwritten > RCL_PROFILING_TRACE_SIZE - printedBefore)
+                {
+                    overwritten = RCL_PROFILING_TRACE_SIZE - printedBefore;
+                }
+                CHECK(printed == RCL_PROFILING_TRACE_SIZE - overwritten, "dump interrupted by %u events after %d: %u printed",
+                      events, after, printed);
+            }
+
+            /* The events recorded meanwhile are in the next dump */
+            dump();
+            printed = checkTrace(&first, &last);
+            CHECK(last == numEvents - 1 && printed == RCL_PROFILING_TRACE_SIZE, "next dump: %u printed, last %u of %u",
+                  printed, last, numEvents);
+        }
+    }
+}
+
+static void checkHistograms(void)
+{
+    static const uint32_t durations[] = {0, 1, 2, 3, 4, 7, 8, 1000, 0x200, 0xFFFF, 0x12345678};
+    uint32_t expected[RCL_PROFILING_HISTOGRAM_BINS] = {0};
+    uint32_t total = 0;
+    uint32_t numHist = 0;
+    uint32_t count, min, max, sum, key, bin, value;
+
+    RCL_Profiling_reset();
+    for (uint32_t i = 0; i < sizeof(durations) / sizeof(durations[0]); i++)
+    {
+        uint32_t d = durations[i];
+        uint32_t b = (d < 2) ? 0 : 31 - __builtin_clz(d);
+
+        /* Start shortly before a SYSTIM wrap */
+        now = 0xFFFFFF00U;
+        uint32_t start = RCL_Profiling_traceEvent(RCL_ProfilingEvent_HandlerStart, 1);
+        now += d;
+        RCL_Profiling_traceDuration(RCL_ProfilingEvent_HandlerEnd, 1, 0x1000, start);
+        expected[(b < RCL_PROFILING_HISTOGRAM_BINS) ? b : RCL_PROFILING_HISTOGRAM_BINS - 1]++;
+        total += d;
+    }
+    /* One sample for each of more functions than there are histograms */
+    for (uint32_t k = 1; k <= RCL_PROFILING_NUM_HISTOGRAMS + 2; k++)
+    {
+        uint32_t start = RCL_Profiling_traceEvent(RCL_ProfilingEvent_SetupStart, 1);
+
+        now += 40;
+        RCL_Profiling_traceDuration(RCL_ProfilingEvent_SetupEnd, 1, 0x2000 + k, start);
+    }
+    dump();
+
+    for (int i = 0; i < numLines; i++)
+    {
+        if (sscanf(lines[i], "RCL_Profiling_hist: 0x%x %u %u %u 0x%x", &key, &count, &min, &max, &sum) == 5)
+        {
+            numHist++;
+            if (key == 0x1000)
+            {
+                CHECK(count == sizeof(durations) / sizeof(durations[0]) && min == 0 && max == 0x12345678 &&
+                      sum == total, "histogram %s", lines[i]);
+            }
+            else
+            {
+                CHECK(count == 1 && min == 40 && max == 40 && key <= 0x2000 + RCL_PROFILING_NUM_HISTOGRAMS - 1,
+                      "histogram %s", lines[i]);
+            }
+        }
+        else if (sscanf(lines[i], "RCL_Profiling_bin: 0x%x %u %u", &key, &bin, &value) == 3 && key == 0x1000)
+        {
+            CHECK(bin < RCL_PROFILING_HISTOGRAM_BINS && value == expected[bin], "bin %u: %u, expected %u",
+                  bin, value, expected[bin]);
+            expected[bin] = 0;
+        }
+    }
+    CHECK(numHist == RCL_PROFILING_NUM_HISTOGRAMS, "%u histograms printed", numHist);
+    for (uint32_t b = 0; b < RCL_PROFILING_HISTOGRAM_BINS; b++)
+    {
+        CHECK(expected[b] == 0, "bin %u not printed", b);
+    }
+}
+
+static double nsSince(const struct timespec *start, uint32_t count)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (((end.tv_sec - start->tv_sec) * 1e9 + (end.tv_nsec - start->tv_nsec)) / count);
+}
+
+static void bench(void)
+{
+    const uint32_t count = 10000000;
+    struct timespec start;
+    double eventNs, durationNs;
+
+    RCL_Profiling_reset();
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        now = i;
+        RCL_Profiling_traceEvent(RCL_ProfilingEvent_CommandHwiStart, 1);
+    }
+    eventNs = nsSince(&start, count);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        now = i;
+        RCL_Profiling_traceDuration(RCL_ProfilingEvent_HandlerEnd, 1, 0x1000 + (i & 3), i - (i & 0xFF));
+    }
+    durationNs = nsSince(&start, count);
+    printf("host time per traced event %.1f ns, per measured duration %.1f ns\n", eventNs, durationNs);
+}
+
+/* Trace of a few command runs, as written for the converter */
+static void writeDump(const char *fileName)
+{
+    RCL_Command cmd = {.cmdId = 0x2801};
+    FILE *file = fopen(fileName, "w");
+
+    if (file == NULL)
+    {
+        perror(fileName);
+        exit(1);
+    }
+    RCL_Profiling_reset();
+    rclSchedulerState.currCmd = &cmd;
+    now = 0U - 620000U;
+    for (int i = 0; i < 100; i++)
+    {
+        uint32_t start;
+
+        RCL_Profiling_traceEvent(RCL_ProfilingEvent_SchedulerHwiStart, cmd.cmdId);
+        now += 3;
+        RCL_Profiling_traceEvent(RCL_ProfilingEvent_SchedulerDecision, cmd.cmdId);
+        now += 2;
+        RCL_Profiling_traceEvent(RCL_ProfilingEvent_SchedulerHwiEnd, cmd.cmdId);
+        now += 400;
+        RCL_Profiling_traceEvent(RCL_ProfilingEvent_CommandHwiStart, cmd.cmdId);
+        now += 1;
+        start = RCL_Profiling_traceEvent(RCL_ProfilingEvent_SetupStart, cmd.cmdId);
+        now += 800 + i;
+        RCL_Profiling_traceDuration(RCL_ProfilingEvent_SetupEnd, cmd.cmdId, 0x1000, start);
+        start = RCL_Profiling_traceEvent(RCL_ProfilingEvent_HandlerStart, cmd.cmdId);
+        now += 10 + (i % 7) * 30;
+        RCL_Profiling_traceDuration(RCL_ProfilingEvent_HandlerEnd, cmd.cmdId, 0x2000 + (i & 1) * 0x100, start);
+        RCL_Profiling_eventHook(RCL_ProfilingEvent_PreprocStop);
+        RCL_Profiling_traceEvent(RCL_ProfilingEvent_CommandHwiEnd, cmd.cmdId);
+        now += 5000;
+    }
+    rclSchedulerState.currCmd = NULL;
+    dump();
+    for (int i = 0; i < numLines; i++)
+    {
+        fprintf(file, "[RCL] %s\n", lines[i]);
+    }
+    fclose(file);
+}
+
+int main(int argc, char *argv[])
+{
+    checkRing();
+    checkConcurrentRecording();
+    checkHistograms();
+    if (failures != 0)
+    {
+        printf("%d failures\n", failures);
+        return (1);
+    }
+    printf("checks passed\n");
+    bench();
+    if (argc > 1)
+    {
+        writeDump(argv[1]);
+    }
+    return (0);
+}
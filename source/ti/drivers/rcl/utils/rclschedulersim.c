@@ -0,0 +1,599 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== rclschedulersim.c ========
+ *
+ * Host simulation of the RCL scheduler with the command queue.
+ *
+ * RCL.c, RCL_Scheduler.c and RCL_CommandQueue.c are linked against the
+ * HAL and LRF functions below, which run on a virtual SYSTIM starting one
+ * second before it wraps.  A command handler occupies the radio for the
+ * duration of each command.  Three clients submit commands:
+ *
+ * - BLE, priority 2: 3 ms connection events every 30 ms, not delayable
+ * - IEEE, priority 1: 2 ms slots every 10 ms, may be delayed
+ * - generic, priority 0: back-to-back 4 ms RX windows
+ *
+ * Each client keeps up to its number of commands submitted ahead.  The
+ * program prints the radio utilization and, per client, the commands that
+ * finished, were missed, were preempted or could not be submitted.  With a
+ * command queue, every BLE command must finish.
+ *
+ * Usage:
+ *
+ *     rclschedulersim [-e] [-i] [milliseconds]
+ *
+ *     -e  give all clients the same priority
+ *     -i  use RCL_ConflictPolicy_InterruptLowerPriority for all commands
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include <ti/drivers/rcl/RCL.h>
+#include <ti/drivers/rcl/RCL_Scheduler.h>
+#include <ti/drivers/rcl/RCL_CommandQueue.h>
+#include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/dpl/SemaphoreP.h>
+
+#define PERIPHERAL_BASE 0x40000000U
+#define PERIPHERAL_SIZE 0x00100000U
+
+#define NUM_CLIENTS  3
+#define NUM_COMMANDS 16
+
+/* Timers of the HAL */
+enum
+{
+    TIMER_SETUP,
+    TIMER_START,
+    TIMER_HARD_STOP,
+    TIMER_GRACEFUL_STOP,
+    NUM_TIMERS
+};
+
+typedef struct {
+    RCL_Command cmd;      /* Must be first */
+    uint32_t    duration; /* Radio time once started */
+    int         client;
+    bool        inUse;
+} SimCommand;
+
+typedef struct {
+    const char *name;
+    uint32_t    period;     /* 0 for back-to-back commands */
+    uint32_t    duration;
+    uint32_t    offset;
+    uint8_t     priority;
+    bool        allowDelay;
+    int         ahead;      /* Commands submitted ahead with a queue */
+    uint32_t    nextStart;
+    int         outstanding;
+    long        submitted;
+    long        done;
+    long        missed;
+    long        preempted;
+    long        busy;
+} Workload;
+
+static Workload workloads[NUM_CLIENTS] = {
+    {"BLE", RCL_SCHEDULER_SYSTIM_MS(30), RCL_SCHEDULER_SYSTIM_MS(3), RCL_SCHEDULER_SYSTIM_MS(10), 2, false, 3},
+    {"IEEE", RCL_SCHEDULER_SYSTIM_MS(10), RCL_SCHEDULER_SYSTIM_MS(2), RCL_SCHEDULER_SYSTIM_MS(12), 1, true, 3},
+    {"generic", 0, RCL_SCHEDULER_SYSTIM_MS(4), 0, 0, true, 2},
+};
+
+static RCL_Client clients[NUM_CLIENTS];
+static SimCommand commands[NUM_CLIENTS][NUM_COMMANDS];
+static bool equalPriority;
+static bool interruptLowerPriority;
+
+/* Virtual platform */
+static uint32_t now;
+static void (*commandIsr)(void);
+static void (*dispatchIsr)(void);
+static void (*schedulerIsr)(void);
+static bool commandPending;
+static bool dispatchPending;
+static bool schedulerPending;
+static bool timerArmed[NUM_TIMERS];
+static uint32_t timerTime[NUM_TIMERS];
+static int firedTimer = -1;
+static uint32_t lrfIfg;
+static bool opArmed;
+static uint32_t opDoneTime;
+static uint32_t opStartTime;
+static uint64_t busyTime;
+static uintptr_t interruptsDisabled;
+
+uintptr_t HwiP_disable(void)
+{
+    return (interruptsDisabled++);
+}
+
+void HwiP_restore(uintptr_t key)
+{
+    interruptsDisabled = key;
+}
+
+void SemaphoreP_Params_init(SemaphoreP_Params *params)
+{
+    memset(params, 0, sizeof(*params));
+}
+
+SemaphoreP_Handle SemaphoreP_construct(SemaphoreP_Struct *handle, unsigned int count, SemaphoreP_Params *params)
+{
+    return ((SemaphoreP_Handle)handle);
+}
+
+SemaphoreP_Status SemaphoreP_pend(SemaphoreP_Handle handle, uint32_t timeout)
+{
+    return (SemaphoreP_OK);
+}
+
+void SemaphoreP_post(SemaphoreP_Handle handle)
+{
+}
+
+void hal_init_fsm(void (*dispatchFsm)(void), void (*schedulerFsm)(void), void (*commandFsm)(void))
+{
+    dispatchIsr  = dispatchFsm;
+    schedulerIsr = schedulerFsm;
+    commandIsr   = commandFsm;
+}
+
+void hal_trigger_command_fsm(void)
+{
+    commandPending = true;
+}
+
+void hal_trigger_dispatch_fsm(void)
+{
+    dispatchPending = true;
+}
+
+void hal_trigger_scheduler_fsm(void)
+{
+    schedulerPending = true;
+}
+
+uint32_t hal_get_command_ifg_reg(void)
+{
+    uint32_t ifg = lrfIfg;
+
+    lrfIfg = 0;
+    return (ifg);
+}
+
+uint32_t hal_get_dispatch_ifg_reg(void)
+{
+    return (0);
+}
+
+uint32_t hal_get_current_time(void)
+{
+    return (now);
+}
+
+static void armTimer(int timer, uint32_t time)
+{
+    timerArmed[timer] = true;
+    timerTime[timer]  = time;
+}
+
+void hal_setup_setup_time(uint32_t time)
+{
+    armTimer(TIMER_SETUP, time);
+}
+
+void hal_setup_start_time(uint32_t time)
+{
+    armTimer(TIMER_START, time);
+}
+
+void hal_setup_hard_stop_time(uint32_t time)
+{
+    armTimer(TIMER_HARD_STOP, time);
+}
+
+void hal_setup_graceful_stop_time(uint32_t time)
+{
+    armTimer(TIMER_GRACEFUL_STOP, time);
+}
+
+void hal_cancel_start_time(void)
+{
+    timerArmed[TIMER_START] = false;
+}
+
+void hal_cancel_hard_stop_time(void)
+{
+    timerArmed[TIMER_HARD_STOP] = false;
+}
+
+void hal_cancel_graceful_stop_time(void)
+{
+    timerArmed[TIMER_GRACEFUL_STOP] = false;
+}
+
+HalTimerEvent hal_check_clear_timer_compare(void)
+{
+    int timer = firedTimer;
+
+    firedTimer = -1;
+    switch (timer)
+    {
+    case TIMER_SETUP:
+        return (HAL_TIMER_EVT_SETUP);
+    case TIMER_START:
+        return (HAL_TIMER_EVT_START);
+    case TIMER_HARD_STOP:
+        return (HAL_TIMER_EVT_HARD_STOP);
+    case TIMER_GRACEFUL_STOP:
+        return (HAL_TIMER_EVT_GRACEFUL_STOP);
+    default:
+        return (HAL_TIMER_EVT_NONE);
+    }
+}
+
+void hal_enable_setup_time_irq(void) {}
+void hal_init_dispatch_radio_interrupts(uint32_t mask) {}
+void hal_disable_all_command_radio_interrupts(void) {}
+void hal_disable_all_dispatch_radio_interrupts(void) {}
+void hal_enable_clk_buffer(void) {}
+void hal_power_set_standby_constraint(void) {}
+void hal_power_release_standby_constraint(void) {}
+void hal_power_open(void (*powerEventFxn)(RCL_PowerEvent)) {}
+void hal_power_close(void) {}
+void hal_temperature_init(void) {}
+void RCL_GPIO_enable(void) {}
+void RCL_GPIO_disable(void) {}
+void LRF_rclEnableRadioClocks(void) {}
+void LRF_rclDisableRadioClocks(void) {}
+
+int8_t LRF_readRssi(void)
+{
+    return (0);
+}
+
+bool LRF_imagesNeedUpdate(const LRF_Config *config)
+{
+    return (false);
+}
+
+const LRF_ConfigDelta *LRF_ConfigDelta_find(const LRF_Config *from, const LRF_Config *to, uint16_t phyFeatures)
+{
+    return (NULL);
+}
+
+LRF_SetupResult LRF_setupRadio(const LRF_Config *config, uint16_t phyFeatures, LRF_RadioState lrfState)
+{
+    return (SetupResult_Ok);
+}
+
+/* Occupies the radio for the duration of the command once it starts */
+static RCL_Events simHandler(RCL_Command *cmd, LRF_Events lrfEvents, RCL_Events rclEventsIn)
+{
+    SimCommand *simCmd = (SimCommand *)cmd;
+    RCL_Events rclEvents = RCL_EventNone;
+
+    if (rclEventsIn.setup)
+    {
+        RCL_CommandStatus status = RCL_Scheduler_setStartStopTime(cmd);
+        if (status >= RCL_CommandStatus_Finished)
+        {
+            cmd->status = status;
+            rclEvents.lastCmdDone = 1;
+            return (rclEvents);
+        }
+    }
+    if (rclEventsIn.timerStart && cmd->status < RCL_CommandStatus_Active)
+    {
+        cmd->status          = RCL_CommandStatus_Active;
+        rclEvents.cmdStarted = 1;
+        opStartTime          = now;
+        opArmed              = true;
+        opDoneTime           = now + simCmd->duration;
+    }
+    if (cmd->status == RCL_CommandStatus_Active)
+    {
+        if (lrfEvents.opDone)
+        {
+            cmd->status = RCL_CommandStatus_Finished;
+            rclEvents.lastCmdDone = 1;
+        }
+        else if (rclEventsIn.hardStop || rclEventsIn.gracefulStop)
+        {
+            cmd->status = RCL_Scheduler_findStopStatus(rclEventsIn.hardStop ? RCL_StopType_Hard : RCL_StopType_Graceful);
+            rclEvents.lastCmdDone = 1;
+            opArmed = false;
+        }
+        if (rclEvents.lastCmdDone)
+        {
+            busyTime += now - opStartTime;
+        }
+    }
+    return (rclEvents);
+}
+
+static void callback(RCL_Command *cmd, LRF_Events lrfEvents, RCL_Events rclEvents)
+{
+    SimCommand *simCmd = (SimCommand *)cmd;
+    Workload *workload;
+
+    if ((!rclEvents.lastCmdDone && !rclEvents.startRejected) || !simCmd->inUse)
+    {
+        return;
+    }
+    workload = &workloads[simCmd->client];
+    simCmd->inUse = false;
+    workload->outstanding--;
+    if (cmd->status == RCL_CommandStatus_Finished)
+    {
+        workload->done++;
+    }
+    else if (RCL_CommandStatus_isAnySchedulingStop(cmd->status) && !RCL_CommandStatus_isAnyDescheduled(cmd->status))
+    {
+        workload->preempted++;
+    }
+    else
+    {
+        workload->missed++;
+    }
+}
+
+/* Returns false if RCL had no room for the command */
+static bool submitOne(int client)
+{
+    Workload *workload = &workloads[client];
+    SimCommand *simCmd = NULL;
+    RCL_CommandStatus status;
+
+    for (int i = 0; i < NUM_COMMANDS && simCmd == NULL; i++)
+    {
+        if (!commands[client][i].inUse)
+        {
+            simCmd = &commands[client][i];
+        }
+    }
+    if (simCmd == NULL)
+    {
+        return (false);
+    }
+    simCmd->cmd                                  = RCL_Command_DefaultRuntime(0x100 + client, simHandler);
+    simCmd->cmd.runtime.callback                 = callback;
+    simCmd->cmd.runtime.rclCallbackMask.lastCmdDone   = 1;
+    simCmd->cmd.runtime.rclCallbackMask.startRejected = 1;
+    simCmd->cmd.allowDelay                       = workload->allowDelay;
+    simCmd->cmd.timing.relHardStopTime           = workload->duration + RCL_SCHEDULER_SYSTIM_US(500);
+    simCmd->duration                             = workload->duration;
+    simCmd->client                               = client;
+    if (workload->period != 0)
+    {
+        simCmd->cmd.scheduling          = RCL_Schedule_AbsTime;
+        simCmd->cmd.timing.absStartTime = workload->nextStart;
+        simCmd->cmd.conflictPolicy      = RCL_ConflictPolicy_AlwaysInterrupt;
+    }
+    else
+    {
+        simCmd->cmd.scheduling     = RCL_Schedule_Now;
+        simCmd->cmd.conflictPolicy = RCL_ConflictPolicy_Polite;
+    }
+    if (interruptLowerPriority)
+    {
+        simCmd->cmd.conflictPolicy = RCL_ConflictPolicy_InterruptLowerPriority;
+    }
+
+    status = RCL_Command_submit(&clients[client], &simCmd->cmd);
+    if (status == RCL_CommandStatus_Scheduled || status == RCL_CommandStatus_Queued)
+    {
+        simCmd->inUse = true;
+        workload->outstanding++;
+    }
+    else if (status == RCL_CommandStatus_RejectedStart)
+    {
+        /* Rejected by admission control, the slot is lost */
+        workload->missed++;
+    }
+    else
+    {
+        workload->busy++;
+        return (false);
+    }
+    workload->submitted++;
+    workload->nextStart += workload->period;
+    return (true);
+}
+
+static void refill(int client)
+{
+    Workload *workload = &workloads[client];
+    int ahead = (RCL_COMMAND_QUEUE_SIZE > 0) ? workload->ahead : 1;
+
+    /* Periodic slots that passed without a command are missed */
+    while (workload->period != 0 && (int32_t)(workload->nextStart - now) < (int32_t)RCL_SCHEDULER_SYSTIM_MS(1))
+    {
+        workload->missed++;
+        workload->nextStart += workload->period;
+    }
+    for (int n = 0; n < 4 && workload->outstanding < ahead; n++)
+    {
+        if (!submitOne(client))
+        {
+            break;
+        }
+    }
+}
+
+static void runIsrs(void)
+{
+    for (int n = 0; n < 1000; n++)
+    {
+        if (commandPending)
+        {
+            commandPending = false;
+            commandIsr();
+        }
+        else if (dispatchPending)
+        {
+            dispatchPending = false;
+            dispatchIsr();
+        }
+        else if (schedulerPending)
+        {
+            schedulerPending = false;
+            schedulerIsr();
+        }
+        else
+        {
+            return;
+        }
+    }
+    printf("interrupts keep firing\n");
+    exit(1);
+}
+
+/* Advances the virtual time to the next timer, end of operation or client poll */
+static void advanceTime(uint32_t nextPoll)
+{
+    uint32_t next = nextPoll;
+    int event = -1;
+
+    for (int timer = 0; timer < NUM_TIMERS; timer++)
+    {
+        if (timerArmed[timer] && (int32_t)(timerTime[timer] - next) < 0)
+        {
+            next  = timerTime[timer];
+            event = timer;
+        }
+    }
+    if (opArmed && (int32_t)(opDoneTime - next) < 0)
+    {
+        next  = opDoneTime;
+        event = NUM_TIMERS;
+    }
+    if ((int32_t)(next - now) > 0)
+    {
+        now = next;
+    }
+    if (event == NUM_TIMERS)
+    {
+        opArmed = false;
+        lrfIfg |= 1;
+        commandPending = true;
+    }
+    else if (event >= 0)
+    {
+        timerArmed[event] = false;
+        firedTimer        = event;
+        commandPending    = true;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t simTime = RCL_SCHEDULER_SYSTIM_MS(60000);
+    uint32_t startTime;
+    uint32_t nextPoll;
+    int result = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-e") == 0)
+        {
+            equalPriority = true;
+        }
+        else if (strcmp(argv[i], "-i") == 0)
+        {
+            interruptLowerPriority = true;
+        }
+        else
+        {
+            simTime = RCL_SCHEDULER_SYSTIM_MS(atoi(argv[i]));
+        }
+    }
+    /* The LRF registers the scheduler touches */
+    if (mmap((void *)PERIPHERAL_BASE, PERIPHERAL_SIZE, PROT_READ | PROT_WRITE,
+             MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) == MAP_FAILED)
+    {
+        printf("cannot map the peripherals at 0x%08x\n", PERIPHERAL_BASE);
+        return (2);
+    }
+
+    now       = 0xFFFFFFFFU - RCL_SCHEDULER_SYSTIM_MS(1000);
+    startTime = now;
+    nextPoll  = now;
+    RCL_init();
+    for (int client = 0; client < NUM_CLIENTS; client++)
+    {
+        RCL_open(&clients[client], NULL);
+        RCL_setClientPriority(&clients[client], equalPriority ? 0 : workloads[client].priority);
+        workloads[client].nextStart = now + workloads[client].offset;
+    }
+    while ((uint32_t)(now - startTime) < simTime)
+    {
+        /* Clients submit at task level */
+        if ((int32_t)(now - nextPoll) >= 0)
+        {
+            for (int client = 0; client < NUM_CLIENTS; client++)
+            {
+                refill(client);
+            }
+            nextPoll = now + RCL_SCHEDULER_SYSTIM_US(250);
+        }
+        runIsrs();
+        for (int client = 0; client < NUM_CLIENTS; client++)
+        {
+            refill(client);
+        }
+        runIsrs();
+        advanceTime(nextPoll);
+    }
+
+    printf("command queue size %u%s%s: radio utilization %.1f%%\n", (unsigned)RCL_COMMAND_QUEUE_SIZE,
+           equalPriority ? ", equal priorities" : "", interruptLowerPriority ? ", InterruptLowerPriority" : "",
+           100.0 * busyTime / (uint32_t)(now - startTime));
+    for (int client = 0; client < NUM_CLIENTS; client++)
+    {
+        Workload *workload = &workloads[client];
+        printf("  %-8s submitted %6ld done %6ld missed %6ld preempted %6ld not submitted %7ld\n", workload->name,
+               workload->submitted, workload->done, workload->missed, workload->preempted, workload->busy);
+    }
+    if (RCL_COMMAND_QUEUE_SIZE > 0 && !equalPriority &&
+        workloads[0].done + workloads[0].outstanding != workloads[0].submitted)
+    {
+        printf("FAIL: BLE commands did not all finish\n");
+        result = 1;
+    }
+    return (result);
+}
@@ -36,6 +36,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include <ti/drivers/dpl/ClockP.h>
 #include <ti/drivers/dpl/HwiP.h>
@@ -69,6 +70,25 @@
 
 #define DRIVE_NOT_MOUNTED ((uint16_t)~0)
 
+/* Size of a command in bytes */
+#define CMD_SIZE (6)
+
+/* Size of the CRC following a data block */
+#define CRC_SIZE (2)
+
+/* Marks an unused sector cache entry */
+#define CACHE_INVALID ((uint32_t)~0)
+
+/* States of a read or write operation, see processTransfer() */
+#define STATE_IDLE   (0) /* No operation in progress */
+#define STATE_READY  (1) /* Polling for the card to be ready */
+#define STATE_CMD    (2) /* Command sent and response window received */
+#define STATE_TOKEN  (3) /* Polling for a start block token */
+#define STATE_READ   (4) /* Data block and trailing bytes received */
+#define STATE_WRITE  (5) /* Data block sent and data response received */
+#define STATE_STOP   (6) /* Stop transmission token sent */
+#define STATE_FINISH (7) /* Dummy byte sent with CS de-asserted */
+
 void SDSPI_close(SD_Handle handle);
 int_fast16_t SDSPI_control(SD_Handle handle, uint_fast16_t cmd, void *arg);
 uint_fast32_t SDSPI_getNumSectors(SD_Handle handle);
@@ -79,13 +99,56 @@ SD_Handle SDSPI_open(SD_Handle handle, SD_Params *params);
 int_fast16_t SDSPI_read(SD_Handle handle, void *buf, int_fast32_t sector, uint_fast32_t sectorCount);
 int_fast16_t SDSPI_write(SD_Handle handle, const void *buf, int_fast32_t sector, uint_fast32_t sectorCount);
 
+int_fast16_t SDSPI_readAsync(SD_Handle handle,
+                             void *buf,
+                             int_fast32_t sector,
+                             uint_fast32_t sectorCount,
+                             SDSPI_CallbackFxn callbackFxn,
+                             void *userArg);
+int_fast16_t SDSPI_writeAsync(SD_Handle handle,
+                              const void *buf,
+                              int_fast32_t sector,
+                              uint_fast32_t sectorCount,
+                              SDSPI_CallbackFxn callbackFxn,
+                              void *userArg);
+
 static inline void assertCS(SDSPI_HWAttrs const *hwAttrs);
 static inline void deassertCS(SDSPI_HWAttrs const *hwAttrs);
-static bool recvDataBlock(SPI_Handle handle, void *buf, uint32_t count);
-static uint8_t sendCmd(SPI_Handle handle, uint8_t cmd, uint32_t arg);
-static int_fast16_t spiTransfer(SPI_Handle handle, void *rxBuf, void *txBuf, size_t count);
-static bool waitUntilReady(SPI_Handle handle);
-static bool transmitDataBlock(SPI_Handle handle, void *buf, uint32_t count, uint8_t token);
+static uint8_t *blockBuffer(SD_Handle handle, uint32_t index);
+static int_fast16_t cachedRead(SD_Handle handle, void *buf, uint32_t sector);
+static void cacheUpdate(SD_Handle handle);
+static void checkReady(SD_Handle handle, uint8_t lastByte);
+static void completeTransfer(SD_Handle handle);
+static void finishTransfer(SD_Handle handle);
+static void handleToken(SD_Handle handle, int_fast8_t token);
+static void nextStep(SD_Handle handle);
+static void processTransfer(SD_Handle handle);
+static void queueBlockRead(SD_Handle handle);
+static void queueBlockWrite(SD_Handle handle);
+static void queueCmd(SD_Handle handle);
+static void queuePoll(SD_Handle handle, uint8_t state, uint8_t count);
+static void queueStop(SD_Handle handle);
+static void readFailed(SD_Handle handle);
+static bool recvDataBlock(SD_Handle handle, void *buf, uint32_t count);
+static int_fast16_t runTransfer(SD_Handle handle,
+                                bool isWrite,
+                                void *buf,
+                                uint32_t sector,
+                                uint32_t sectorCount,
+                                bool cacheFill);
+static int_fast8_t scanToken(SD_Handle handle, const uint8_t *rxBuf, size_t count);
+static uint8_t sendCmd(SD_Handle handle, uint8_t cmd, uint32_t arg);
+static void spiCallbackFxn(SPI_Handle spiHandle, SPI_Transaction *transaction);
+static int_fast16_t spiTransfer(SD_Handle handle, void *rxBuf, void *txBuf, size_t count);
+static void startTransfer(SD_Handle handle,
+                          bool isWrite,
+                          void *buf,
+                          uint32_t sector,
+                          uint32_t sectorCount,
+                          bool cacheFill);
+static void submitTransfers(SD_Handle handle, uint_fast8_t count);
+static bool timedOut(SDSPI_Object *object);
+static bool waitUntilReady(SD_Handle handle);
 
 /* SDSPI function table for SDSPI implementation */
 const SD_FxnTable SDSPI_fxnTable = {SDSPI_close,
@@ -105,6 +168,16 @@ void SDSPI_close(SD_Handle handle)
 {
     SDSPI_Object *object = handle->object;
 
+    /*
+     * An operation in progress holds the lock until it completes; an
+     * asynchronous one still uses the SPI and the semaphores from the SPI
+     * callback.
+     */
+    if (object->lockSem)
+    {
+        SemaphoreP_pend(object->lockSem, SemaphoreP_WAIT_FOREVER);
+    }
+
     if (object->spiHandle)
     {
         SPI_close(object->spiHandle);
@@ -117,6 +190,12 @@ void SDSPI_close(SD_Handle handle)
         object->lockSem = NULL;
     }
 
+    if (object->transferSem)
+    {
+        SemaphoreP_delete(object->transferSem);
+        object->transferSem = NULL;
+    }
+
     object->cardType = SD_NOCARD;
     object->isOpen   = false;
 }
@@ -146,7 +225,7 @@ uint_fast32_t SDSPI_getNumSectors(SD_Handle handle)
     assertCS(hwAttrs);
 
     /* Get number of sectors on the disk (uint32_t) */
-    if ((sendCmd(object->spiHandle, CMD9, 0) == 0) && recvDataBlock(object->spiHandle, csd, 16))
+    if ((sendCmd(handle, CMD9, 0) == 0) && recvDataBlock(handle, csd, 16))
     {
         /* SDC ver 2.00 */
         if ((csd[0] >> 6) == 1)
@@ -218,7 +297,7 @@ int_fast16_t SDSPI_initialize(SD_Handle handle)
      * toggling the clock line several times. To do this we transmit 0xFF
      * 10 times. Do not assert CS during this time
      */
-    status = spiTransfer(object->spiHandle, NULL, &txDummy, 10);
+    status = spiTransfer(handle, NULL, &txDummy, 10);
     if (status != SD_STATUS_SUCCESS)
     {
         SemaphoreP_post(object->lockSem);
@@ -238,7 +317,7 @@ int_fast16_t SDSPI_initialize(SD_Handle handle)
      */
     for (i = 255, status = 0xFF; i > 0 && status != 0x1; i--)
     {
-        status = sendCmd(object->spiHandle, CMD0, 0);
+        status = sendCmd(handle, CMD0, 0);
     }
 
     /* If the card never transitioned into idle mode */
@@ -255,10 +334,10 @@ int_fast16_t SDSPI_initialize(SD_Handle handle)
      * Depending on which SD Card version, we need to send different SD
      * commands to the SD Card, which will have different response fields.
      */
-    if (sendCmd(object->spiHandle, CMD8, 0x1AA) == 1)
+    if (sendCmd(handle, CMD8, 0x1AA) == 1)
     {
         /* SD Version 2.0 or higher */
-        status = spiTransfer(object->spiHandle, &ocr, &txDummy, 4);
+        status = spiTransfer(handle, &ocr, &txDummy, 4);
         if (status == SD_STATUS_SUCCESS)
         {
             /*
@@ -279,8 +358,8 @@ int_fast16_t SDSPI_initialize(SD_Handle handle)
                 do
                 {
                     /* ACMD41 with HCS bit */
-                    if ((sendCmd(object->spiHandle, CMD55, 0) <= 1) &&
-                        (sendCmd(object->spiHandle, CMD41, 1UL << 30) == 0))
+                    if ((sendCmd(handle, CMD55, 0) <= 1) &&
+                        (sendCmd(handle, CMD41, 1UL << 30) == 0))
                     {
                         status = SD_STATUS_SUCCESS;
                         break;
@@ -292,9 +371,9 @@ int_fast16_t SDSPI_initialize(SD_Handle handle)
                  * Check CCS bit to determine which type of capacity we are
                  * dealing with
                  */
-                if ((status == SD_STATUS_SUCCESS) && sendCmd(object->spiHandle, CMD58, 0) == 0)
+                if ((status == SD_STATUS_SUCCESS) && sendCmd(handle, CMD58, 0) == 0)
                 {
-                    status = spiTransfer(object->spiHandle, &ocr, &txDummy, 4);
+                    status = spiTransfer(handle, &ocr, &txDummy, 4);
                     if (status == SD_STATUS_SUCCESS)
                     {
                         cardType = (ocr[0] & 0x40) ? SD_SDHC : SD_SDSC;
@@ -310,7 +389,7 @@ int_fast16_t SDSPI_initialize(SD_Handle handle)
          * The card version is not SDC V2+ so check if we are dealing with a
          * SDC or MMC card
          */
-        if ((sendCmd(object->spiHandle, CMD55, 0) <= 1) && (sendCmd(object->spiHandle, CMD41, 0) <= 1))
+        if ((sendCmd(handle, CMD55, 0) <= 1) && (sendCmd(handle, CMD41, 0) <= 1))
         {
             cardType = SD_SDSC;
         }
@@ -332,7 +411,7 @@ int_fast16_t SDSPI_initialize(SD_Handle handle)
             if (cardType == SD_SDSC)
             {
                 /* ACMD41 */
-                if ((sendCmd(object->spiHandle, CMD55, 0) <= 1) && (sendCmd(object->spiHandle, CMD41, 0) == 0))
+                if ((sendCmd(handle, CMD55, 0) <= 1) && (sendCmd(handle, CMD41, 0) == 0))
                 {
                     status = SD_STATUS_SUCCESS;
                     break;
@@ -341,7 +420,7 @@ int_fast16_t SDSPI_initialize(SD_Handle handle)
             else
             {
                 /* CMD1 */
-                if (sendCmd(object->spiHandle, CMD1, 0) == 0)
+                if (sendCmd(handle, CMD1, 0) == 0)
                 {
                     status = SD_STATUS_SUCCESS;
                     break;
@@ -351,7 +430,7 @@ int_fast16_t SDSPI_initialize(SD_Handle handle)
         } while ((currentTime - startTime) < timeout);
 
         /* Select R/W block length */
-        if ((status == SD_STATUS_ERROR) || (sendCmd(object->spiHandle, CMD16, SD_SECTOR_SIZE) != 0))
+        if ((status == SD_STATUS_ERROR) || (sendCmd(handle, CMD16, SD_SECTOR_SIZE) != 0))
         {
             cardType = SD_NOCARD;
         }
@@ -372,7 +451,9 @@ int_fast16_t SDSPI_initialize(SD_Handle handle)
         SPI_close(object->spiHandle);
 
         SPI_Params_init(&spiParams);
-        spiParams.bitRate = 2500000;
+        spiParams.bitRate             = 2500000;
+        spiParams.transferMode        = SPI_MODE_CALLBACK;
+        spiParams.transferCallbackFxn = spiCallbackFxn;
         object->spiHandle = SPI_open(hwAttrs->spiIndex, &spiParams);
         status            = (object->spiHandle == NULL) ? SD_STATUS_ERROR : SD_STATUS_SUCCESS;
     }
@@ -387,6 +468,7 @@ int_fast16_t SDSPI_initialize(SD_Handle handle)
  */
 SD_Handle SDSPI_open(SD_Handle handle, SD_Params *params)
 {
+    uint_fast8_t i;
     uintptr_t key;
     int_fast16_t status;
     SPI_Params spiParams;
@@ -422,6 +504,23 @@ SD_Handle SDSPI_open(SD_Handle handle, SD_Params *params)
         return (NULL);
     }
 
+    object->transferSem = SemaphoreP_createBinary(0);
+    if (object->transferSem == NULL)
+    {
+        SDSPI_close(handle);
+
+        return (NULL);
+    }
+
+    object->state = STATE_IDLE;
+    memset(object->txBuf, 0xFF, sizeof(object->txBuf));
+    for (i = 0; i < SDSPI_MAX_CACHE_SECTORS; i++)
+    {
+        object->cacheTag[i]   = CACHE_INVALID;
+        object->cacheStamp[i] = 0;
+    }
+    object->cacheClock = 0;
+
     /*
      * SPI is initially set to 400 kHz to perform SD initialization.  This is
      * is done to ensure compatibility with older SD cards.  Once the card has
@@ -429,7 +528,9 @@ SD_Handle SDSPI_open(SD_Handle handle, SD_Params *params)
      * reopened at 2.5 MHz.
      */
     SPI_Params_init(&spiParams);
-    spiParams.bitRate = 400000;
+    spiParams.bitRate             = 400000;
+    spiParams.transferMode        = SPI_MODE_CALLBACK;
+    spiParams.transferCallbackFxn = spiCallbackFxn;
     object->spiHandle = SPI_open(hwAttrs->spiIndex, &spiParams);
     if (object->spiHandle == NULL)
     {
@@ -449,8 +550,7 @@ SD_Handle SDSPI_open(SD_Handle handle, SD_Params *params)
  */
 int_fast16_t SDSPI_read(SD_Handle handle, void *buf, int_fast32_t sector, uint_fast32_t sectorCount)
 {
-    uint8_t ffByte               = 0xFF;
-    int_fast16_t status          = SD_STATUS_ERROR;
+    int_fast16_t status;
     SDSPI_Object *object         = handle->object;
     SDSPI_HWAttrs const *hwAttrs = handle->hwAttrs;
 
@@ -461,169 +561,664 @@ int_fast16_t SDSPI_read(SD_Handle handle, void *buf, int_fast32_t sector, uint_f
 
     SemaphoreP_pend(object->lockSem, SemaphoreP_WAIT_FOREVER);
 
-    /*
-     * On a SDSC card, the sector address is a byte address on the SD Card
-     * On a SDHC card, the sector addressing is via sector blocks
-     */
-    if (object->cardType != SD_SDHC)
+    /* Single sector reads are mostly file system metadata; use the cache */
+    if ((sectorCount == 1) && (hwAttrs->cacheSectors > 0))
     {
-        /* Convert to byte address */
-        sector *= SD_SECTOR_SIZE;
+        status = cachedRead(handle, buf, sector);
+    }
+    else
+    {
+        status = runTransfer(handle, false, buf, sector, sectorCount, false);
     }
 
-    assertCS(hwAttrs);
+    SemaphoreP_post(object->lockSem);
+
+    return (status);
+}
+
+/*
+ *  ======== SDSPI_readAsync ========
+ */
+int_fast16_t SDSPI_readAsync(SD_Handle handle,
+                             void *buf,
+                             int_fast32_t sector,
+                             uint_fast32_t sectorCount,
+                             SDSPI_CallbackFxn callbackFxn,
+                             void *userArg)
+{
+    SDSPI_Object *object = handle->object;
+
+    if ((sectorCount == 0) || (callbackFxn == NULL))
+    {
+        return (SD_STATUS_ERROR);
+    }
+
+    if (SemaphoreP_pend(object->lockSem, SemaphoreP_NO_WAIT) != SemaphoreP_OK)
+    {
+        return (SDSPI_STATUS_BUSY);
+    }
+
+    object->callbackFxn = callbackFxn;
+    object->userArg     = userArg;
+    startTransfer(handle, false, buf, sector, sectorCount, false);
+
+    return (SD_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== SDSPI_write ========
+ */
+int_fast16_t SDSPI_write(SD_Handle handle, const void *buf, int_fast32_t sector, uint_fast32_t sectorCount)
+{
+    int_fast16_t status;
+    SDSPI_Object *object = handle->object;
+
+    if (sectorCount == 0)
+    {
+        return (SD_STATUS_ERROR);
+    }
+
+    SemaphoreP_pend(object->lockSem, SemaphoreP_WAIT_FOREVER);
+
+    status = runTransfer(handle, true, (void *)buf, sector, sectorCount, false);
+
+    SemaphoreP_post(object->lockSem);
+
+    return (status);
+}
+
+/*
+ *  ======== SDSPI_writeAsync ========
+ */
+int_fast16_t SDSPI_writeAsync(SD_Handle handle,
+                              const void *buf,
+                              int_fast32_t sector,
+                              uint_fast32_t sectorCount,
+                              SDSPI_CallbackFxn callbackFxn,
+                              void *userArg)
+{
+    SDSPI_Object *object = handle->object;
+
+    if ((sectorCount == 0) || (callbackFxn == NULL))
+    {
+        return (SD_STATUS_ERROR);
+    }
+
+    if (SemaphoreP_pend(object->lockSem, SemaphoreP_NO_WAIT) != SemaphoreP_OK)
+    {
+        return (SDSPI_STATUS_BUSY);
+    }
+
+    object->callbackFxn = callbackFxn;
+    object->userArg     = userArg;
+    startTransfer(handle, true, (void *)buf, sector, sectorCount, false);
+
+    return (SD_STATUS_SUCCESS);
+}
+
+/*
+ *  ======== assertCS ========
+ */
+static inline void assertCS(SDSPI_HWAttrs const *hwAttrs)
+{
+    GPIO_write(hwAttrs->spiCsGpioIndex, 0);
+}
+
+/*
+ *  ======== blockBuffer ========
+ *  Returns the buffer of block index of the current operation
+ */
+static uint8_t *blockBuffer(SD_Handle handle, uint32_t index)
+{
+    SDSPI_Object *object         = handle->object;
+    SDSPI_HWAttrs const *hwAttrs = handle->hwAttrs;
 
-    /* Single block read */
-    if (sectorCount == 1)
+    if (object->cacheFill)
     {
-        if ((sendCmd(object->spiHandle, CMD17, sector) == 0) && recvDataBlock(object->spiHandle, buf, SD_SECTOR_SIZE))
+        return (&hwAttrs->cacheBuf[SDSPI_CACHE_SIZE(object->fillSlot[index])]);
+    }
+
+    return (&object->buf[index * SD_SECTOR_SIZE]);
+}
+
+/*
+ *  ======== cachedRead ========
+ *  Reads a single sector through the sector cache. On a miss, the sector
+ *  and the readAheadSectors - 1 sectors following it are read into the
+ *  least recently used cache entries.
+ */
+static int_fast16_t cachedRead(SD_Handle handle, void *buf, uint32_t sector)
+{
+    uint_fast8_t i;
+    uint_fast8_t j;
+    uint_fast8_t slot;
+    uint_fast8_t count;
+    uint32_t chosen;
+    int_fast16_t status;
+    SDSPI_Object *object         = handle->object;
+    SDSPI_HWAttrs const *hwAttrs = handle->hwAttrs;
+
+    for (i = 0; i < hwAttrs->cacheSectors; i++)
+    {
+        if (object->cacheTag[i] == sector)
         {
-            status = SD_STATUS_SUCCESS;
+            object->cacheStamp[i] = ++object->cacheClock;
+            memcpy(buf, &hwAttrs->cacheBuf[SDSPI_CACHE_SIZE(i)], SD_SECTOR_SIZE);
+
+            return (SD_STATUS_SUCCESS);
         }
     }
-    /* Multiple block read */
-    else
+
+    count = hwAttrs->readAheadSectors;
+    if (count > hwAttrs->cacheSectors)
+    {
+        count = hwAttrs->cacheSectors;
+    }
+    else if (count == 0)
+    {
+        count = 1;
+    }
+
+    /* Never cache a sector twice; drop the entries that will be read again */
+    for (i = 0; i < hwAttrs->cacheSectors; i++)
     {
-        if (sendCmd(object->spiHandle, CMD18, sector) == 0)
+        if ((object->cacheTag[i] - sector) < count)
         {
-            do
-            {
-                if (!recvDataBlock(object->spiHandle, buf, SD_SECTOR_SIZE))
-                {
-                    break;
-                }
-                buf = (void *)(((uint32_t)buf) + SD_SECTOR_SIZE);
-            } while (--sectorCount);
+            object->cacheTag[i]   = CACHE_INVALID;
+            object->cacheStamp[i] = 0;
+        }
+    }
 
-            /*
-             * STOP_TRANSMISSION - order is important; always want to send
-             * stop signal
-             */
-            if (sendCmd(object->spiHandle, CMD12, 0) == 0 && sectorCount == 0)
+    /* Pick the least recently used entries; unused entries have stamp 0 */
+    chosen = 0;
+    for (j = 0; j < count; j++)
+    {
+        slot = 0;
+        while (chosen & (1UL << slot))
+        {
+            slot++;
+        }
+
+        for (i = slot + 1; i < hwAttrs->cacheSectors; i++)
+        {
+            if (!(chosen & (1UL << i)) && (object->cacheStamp[i] < object->cacheStamp[slot]))
             {
-                status = SD_STATUS_SUCCESS;
+                slot = i;
             }
         }
+
+        chosen |= 1UL << slot;
+        object->fillSlot[j]      = slot;
+        object->cacheTag[slot]   = CACHE_INVALID;
+        object->cacheStamp[slot] = 0;
     }
 
-    deassertCS(hwAttrs);
+    status = runTransfer(handle, false, NULL, sector, count, true);
+
+    /* The read ahead may run past the end of the card; retry without it */
+    if ((status != SD_STATUS_SUCCESS) && (count > 1))
+    {
+        count  = 1;
+        status = runTransfer(handle, false, NULL, sector, count, true);
+    }
 
-    /* Send a 0xFF with CS high to try to put SD card into low power mode */
-    spiTransfer(object->spiHandle, NULL, &ffByte, 1);
+    if (status == SD_STATUS_SUCCESS)
+    {
+        for (j = 0; j < count; j++)
+        {
+            slot                     = object->fillSlot[j];
+            object->cacheTag[slot]   = sector + j;
+            object->cacheStamp[slot] = ++object->cacheClock;
+        }
 
-    SemaphoreP_post(object->lockSem);
+        memcpy(buf, &hwAttrs->cacheBuf[SDSPI_CACHE_SIZE(object->fillSlot[0])], SD_SECTOR_SIZE);
+    }
 
     return (status);
 }
 
 /*
- *  ======== SDSPI_write ========
+ *  ======== cacheUpdate ========
+ *  Updates the cache entries of the sectors written by the current
+ *  operation, or drops them if the write failed.
  */
-int_fast16_t SDSPI_write(SD_Handle handle, const void *buf, int_fast32_t sector, uint_fast32_t sectorCount)
+static void cacheUpdate(SD_Handle handle)
 {
-    int_fast16_t status          = SD_STATUS_SUCCESS;
+    uint_fast8_t i;
+    uint32_t offset;
     SDSPI_Object *object         = handle->object;
     SDSPI_HWAttrs const *hwAttrs = handle->hwAttrs;
 
-    if (sectorCount == 0)
+    for (i = 0; i < hwAttrs->cacheSectors; i++)
     {
-        return (SD_STATUS_ERROR);
+        offset = object->cacheTag[i] - object->sector;
+
+        if ((object->cacheTag[i] != CACHE_INVALID) && (offset < object->sectorCount))
+        {
+            if (object->status == SD_STATUS_SUCCESS)
+            {
+                memcpy(&hwAttrs->cacheBuf[SDSPI_CACHE_SIZE(i)],
+                       &object->buf[offset * SD_SECTOR_SIZE],
+                       SD_SECTOR_SIZE);
+            }
+            else
+            {
+                object->cacheTag[i]   = CACHE_INVALID;
+                object->cacheStamp[i] = 0;
+            }
+        }
     }
+}
 
-    SemaphoreP_pend(object->lockSem, SemaphoreP_WAIT_FOREVER);
+/*
+ *  ======== checkReady ========
+ *  Continues with the next step if the last byte received shows that the
+ *  card is not busy, or starts polling until it is.
+ */
+static void checkReady(SD_Handle handle, uint8_t lastByte)
+{
+    if (lastByte == 0xFF)
+    {
+        nextStep(handle);
+    }
+    else
+    {
+        queuePoll(handle, STATE_READY, SDSPI_POLL_SIZE);
+    }
+}
 
-    /*
-     * On a SDSC card, the sector address is a byte address on the SD Card
-     * On a SDHC card, the sector addressing is via sector blocks
-     */
-    if (object->cardType != SD_SDHC)
+/*
+ *  ======== completeTransfer ========
+ *  Ends the current operation and notifies the caller
+ */
+static void completeTransfer(SD_Handle handle)
+{
+    SDSPI_Object *object          = handle->object;
+    SDSPI_CallbackFxn callbackFxn = object->callbackFxn;
+    int_fast16_t status           = object->status;
+    void *userArg                 = object->userArg;
+
+    if (object->isWrite)
     {
-        /* Convert to byte address if needed */
-        sector *= SD_SECTOR_SIZE;
+        cacheUpdate(handle);
     }
 
-    assertCS(hwAttrs);
+    object->state = STATE_IDLE;
 
-    /* Single block write */
-    if (sectorCount == 1)
+    if (callbackFxn != NULL)
     {
-        if ((sendCmd(object->spiHandle, CMD24, sector) == 0) &&
-            transmitDataBlock(object->spiHandle, (void *)buf, SD_SECTOR_SIZE, START_BLOCK_TOKEN))
-        {
-            sectorCount = 0;
-        }
+        object->callbackFxn = NULL;
+        SemaphoreP_post(object->lockSem);
+
+        callbackFxn(handle, status, userArg);
     }
-    /* Multiple block write */
     else
     {
-        if ((object->cardType == SD_SDSC) || (object->cardType == SD_SDHC))
-        {
-            if (sendCmd(object->spiHandle, CMD55, 0) != 0)
+        /* Posted to runTransfer() */
+        SemaphoreP_post(object->transferSem);
+    }
+}
+
+/*
+ *  ======== deassertCS ========
+ */
+static inline void deassertCS(SDSPI_HWAttrs const *hwAttrs)
+{
+    GPIO_write(hwAttrs->spiCsGpioIndex, 1);
+}
+
+/*
+ *  ======== finishTransfer ========
+ *  De-asserts CS at the end of the current operation
+ */
+static void finishTransfer(SD_Handle handle)
+{
+    SDSPI_Object *object = handle->object;
+
+    deassertCS(handle->hwAttrs);
+
+    if (object->isWrite)
+    {
+        completeTransfer(handle);
+    }
+    else
+    {
+        /* Send a 0xFF with CS high to try to put SD card into low power mode */
+        object->state                = STATE_FINISH;
+        object->transaction[0].rxBuf = NULL;
+        object->transaction[0].txBuf = NULL;
+        object->transaction[0].count = 1;
+        submitTransfers(handle, 1);
+    }
+}
+
+/*
+ *  ======== handleToken ========
+ *  Continues a read after scanToken()
+ */
+static void handleToken(SD_Handle handle, int_fast8_t token)
+{
+    SDSPI_Object *object = handle->object;
+
+    if (token > 0)
+    {
+        queueBlockRead(handle);
+    }
+    else if ((token == 0) && !((object->state == STATE_TOKEN) && timedOut(object)))
+    {
+        queuePoll(handle, STATE_TOKEN, SDSPI_POLL_SIZE);
+    }
+    else
+    {
+        readFailed(handle);
+    }
+}
+
+/*
+ *  ======== nextStep ========
+ *  Starts the next step of the current operation once the card is ready
+ */
+static void nextStep(SD_Handle handle)
+{
+    SDSPI_Object *object = handle->object;
+
+    if (object->cmdIndex < object->numCmds)
+    {
+        queueCmd(handle);
+    }
+    else if ((object->status == SD_STATUS_SUCCESS) && (object->blockIndex < object->sectorCount))
+    {
+        queueBlockWrite(handle);
+    }
+    else if (object->sendStop)
+    {
+        object->sendStop = false;
+        queueStop(handle);
+    }
+    else
+    {
+        finishTransfer(handle);
+    }
+}
+
+/*
+ *  ======== processTransfer ========
+ *  Advances the current operation when its queued transfers have completed
+ */
+static void processTransfer(SD_Handle handle)
+{
+    uint_fast8_t i;
+    uint8_t cmd;
+    SDSPI_Object *object = handle->object;
+    uint8_t *rxBuf       = object->rxBuf;
+
+    if (object->transferFailed)
+    {
+        object->status = SD_STATUS_ERROR;
+        deassertCS(handle->hwAttrs);
+        completeTransfer(handle);
+
+        return;
+    }
+
+    switch (object->state)
+    {
+        case STATE_READY:
+            if (rxBuf[object->pollCount - 1] == 0xFF)
+            {
+                nextStep(handle);
+            }
+            else if (timedOut(object))
+            {
+                object->status = SD_STATUS_ERROR;
+                finishTransfer(handle);
+            }
+            else
             {
-                status = SD_STATUS_ERROR;
+                queuePoll(handle, STATE_READY, SDSPI_POLL_SIZE);
             }
+            break;
 
-            /* ACMD23 */
-            if ((status == SD_STATUS_SUCCESS) && (sendCmd(object->spiHandle, CMD23, sectorCount) != 0))
+        case STATE_CMD:
+            cmd = object->cmd[object->cmdIndex++];
+
+            /*
+             * Find the response; CMD12 has an additional stuff byte before
+             * its R1b response.
+             */
+            i = CMD_SIZE + ((cmd == CMD12) ? 1 : 0);
+            while ((i < sizeof(object->rxBuf)) && (rxBuf[i] & 0x80))
             {
-                status = SD_STATUS_ERROR;
+                i++;
             }
-        }
 
-        /* WRITE_MULTIPLE_BLOCK command */
-        if ((status == SD_STATUS_SUCCESS) && (sendCmd(object->spiHandle, CMD25, sector) == 0))
-        {
-            do
+            if ((i == sizeof(object->rxBuf)) || (rxBuf[i] != 0))
             {
-                if (!transmitDataBlock(object->spiHandle, (void *)buf, SD_SECTOR_SIZE, START_MULTIBLOCK_TOKEN))
+                object->status   = SD_STATUS_ERROR;
+                object->cmdIndex = object->numCmds;
+
+                if (object->isWrite)
                 {
-                    break;
+                    checkReady(handle, rxBuf[sizeof(object->rxBuf) - 1]);
+                }
+                else
+                {
+                    finishTransfer(handle);
+                }
+            }
+            else if (cmd == CMD12)
+            {
+                finishTransfer(handle);
+            }
+            else if (!object->isWrite)
+            {
+                /* The data token may already follow the response */
+                handleToken(handle, scanToken(handle, &rxBuf[i + 1], sizeof(object->rxBuf) - (i + 1)));
+            }
+            else
+            {
+                if (cmd == CMD25)
+                {
+                    object->sendStop = true;
                 }
-                buf = (void *)(((uint32_t)buf) + SD_SECTOR_SIZE);
-            } while (--sectorCount);
+                checkReady(handle, rxBuf[sizeof(object->rxBuf) - 1]);
+            }
+            break;
+
+        case STATE_TOKEN:
+            handleToken(handle, scanToken(handle, rxBuf, SDSPI_POLL_SIZE));
+            break;
 
-            /* STOP_TRAN token */
-            if (!transmitDataBlock(object->spiHandle, NULL, 0, STOP_MULTIBLOCK_TOKEN))
+        case STATE_READ:
+            object->blockIndex++;
+
+            if (object->blockIndex == object->sectorCount)
             {
-                sectorCount = 1;
+                /* STOP_TRANSMISSION for multiple block reads */
+                if (object->cmdIndex < object->numCmds)
+                {
+                    queueCmd(handle);
+                }
+                else
+                {
+                    finishTransfer(handle);
+                }
             }
-        }
+            else
+            {
+                /* Look for the token of the next block behind the CRC */
+                handleToken(handle, scanToken(handle, &rxBuf[CRC_SIZE], SDSPI_POLL_SIZE));
+            }
+            break;
+
+        case STATE_WRITE:
+            /* Check data response; the write failed if data was rejected */
+            if ((rxBuf[CRC_SIZE] & 0x1F) == 0x05)
+            {
+                object->blockIndex++;
+            }
+            else
+            {
+                object->status = SD_STATUS_ERROR;
+            }
+            checkReady(handle, rxBuf[CRC_SIZE + SDSPI_POLL_SIZE]);
+            break;
+
+        case STATE_STOP:
+            checkReady(handle, rxBuf[SDSPI_POLL_SIZE]);
+            break;
+
+        case STATE_FINISH:
+            completeTransfer(handle);
+            break;
+
+        default:
+            break;
     }
+}
 
-    /*
-     * Wait for SD card to finish storing the data it received. This may help
-     * the card go into low power mode.
-     */
-    waitUntilReady(object->spiHandle);
+/*
+ *  ======== queueBlockRead ========
+ *  Receives the rest of a data block, its CRC and, if another block
+ *  follows, the first bytes of the wait for the next token.
+ */
+static void queueBlockRead(SD_Handle handle)
+{
+    SDSPI_Object *object = handle->object;
 
-    deassertCS(hwAttrs);
+    object->state                = STATE_READ;
+    object->transaction[0].rxBuf = blockBuffer(handle, object->blockIndex) + object->dataCount;
+    object->transaction[0].txBuf = NULL;
+    object->transaction[0].count = SD_SECTOR_SIZE - object->dataCount;
+    object->transaction[1].rxBuf = object->rxBuf;
+    object->transaction[1].txBuf = NULL;
+    object->transaction[1].count = CRC_SIZE;
 
-    SemaphoreP_post(object->lockSem);
+    if ((object->sectorCount - object->blockIndex) > 1)
+    {
+        object->transaction[1].count += SDSPI_POLL_SIZE;
+    }
 
-    return ((sectorCount) ? SD_STATUS_ERROR : SD_STATUS_SUCCESS);
+    submitTransfers(handle, 2);
 }
 
 /*
- *  ======== assertCS ========
+ *  ======== queueBlockWrite ========
+ *  Sends the token, the data and the CRC of a block, and receives the data
+ *  response followed by the first bytes of the card's busy phase.
  */
-static inline void assertCS(SDSPI_HWAttrs const *hwAttrs)
+static void queueBlockWrite(SD_Handle handle)
 {
-    GPIO_write(hwAttrs->spiCsGpioIndex, 0);
+    SDSPI_Object *object = handle->object;
+
+    object->state                = STATE_WRITE;
+    object->txBuf[0]             = (object->sendStop) ? START_MULTIBLOCK_TOKEN : START_BLOCK_TOKEN;
+    object->transaction[0].rxBuf = NULL;
+    object->transaction[0].txBuf = object->txBuf;
+    object->transaction[0].count = 1;
+    object->transaction[1].rxBuf = NULL;
+    object->transaction[1].txBuf = blockBuffer(handle, object->blockIndex);
+    object->transaction[1].count = SD_SECTOR_SIZE;
+    object->transaction[2].rxBuf = object->rxBuf;
+    object->transaction[2].txBuf = NULL;
+    object->transaction[2].count = CRC_SIZE + 1 + SDSPI_POLL_SIZE;
+
+    submitTransfers(handle, 3);
 }
 
 /*
- *  ======== deassertCS ========
+ *  ======== queueCmd ========
+ *  Sends the next command of the current operation and receives the bytes
+ *  following it, which contain the response.
  */
-static inline void deassertCS(SDSPI_HWAttrs const *hwAttrs)
+static void queueCmd(SD_Handle handle)
 {
-    GPIO_write(hwAttrs->spiCsGpioIndex, 1);
+    SDSPI_Object *object = handle->object;
+    uint32_t arg         = object->cmdArg[object->cmdIndex];
+
+    object->state    = STATE_CMD;
+    object->txBuf[0] = object->cmd[object->cmdIndex]; /* Command */
+    object->txBuf[1] = (uint8_t)(arg >> 24);          /* Argument[31..24] */
+    object->txBuf[2] = (uint8_t)(arg >> 16);          /* Argument[23..16] */
+    object->txBuf[3] = (uint8_t)(arg >> 8);           /* Argument[15..8] */
+    object->txBuf[4] = (uint8_t)arg;                  /* Argument[7..0] */
+    object->txBuf[5] = 0x01;                          /* Default CRC should be at least 0x01 */
+
+    object->transaction[0].rxBuf = object->rxBuf;
+    object->transaction[0].txBuf = object->txBuf;
+    object->transaction[0].count = sizeof(object->txBuf);
+
+    submitTransfers(handle, 1);
+}
+
+/*
+ *  ======== queuePoll ========
+ *  Receives count bytes while waiting for the card
+ */
+static void queuePoll(SD_Handle handle, uint8_t state, uint8_t count)
+{
+    SDSPI_Object *object = handle->object;
+
+    /* Start the timeout when a new wait begins */
+    if (object->state != state)
+    {
+        object->startTime = ClockP_getSystemTicks();
+    }
+
+    object->state                = state;
+    object->pollCount            = count;
+    object->transaction[0].rxBuf = object->rxBuf;
+    object->transaction[0].txBuf = NULL;
+    object->transaction[0].count = count;
+
+    submitTransfers(handle, 1);
+}
+
+/*
+ *  ======== queueStop ========
+ *  Sends the STOP_TRAN token of a multiple block write, followed by the
+ *  bytes of the card's busy phase.
+ */
+static void queueStop(SD_Handle handle)
+{
+    SDSPI_Object *object = handle->object;
+
+    object->state    = STATE_STOP;
+    object->txBuf[0] = STOP_MULTIBLOCK_TOKEN;
+    memset(&object->txBuf[1], 0xFF, CMD_SIZE - 1);
+
+    object->transaction[0].rxBuf = object->rxBuf;
+    object->transaction[0].txBuf = object->txBuf;
+    object->transaction[0].count = 1 + SDSPI_POLL_SIZE;
+
+    submitTransfers(handle, 1);
+}
+
+/*
+ *  ======== readFailed ========
+ */
+static void readFailed(SD_Handle handle)
+{
+    SDSPI_Object *object = handle->object;
+
+    object->status = SD_STATUS_ERROR;
+
+    /* Always send STOP_TRANSMISSION after a multiple block read command */
+    if (object->cmdIndex < object->numCmds)
+    {
+        queueCmd(handle);
+    }
+    else
+    {
+        finishTransfer(handle);
+    }
 }
 
 /*
  *  ======== recvDataBlock ========
  *  Function to receive a block of data from the SDCard
  */
-static bool recvDataBlock(SPI_Handle handle, void *buf, uint32_t count)
+static bool recvDataBlock(SD_Handle handle, void *buf, uint32_t count)
 {
     uint8_t rxBuf[2];
     uint8_t txBuf[2] = {0xFF, 0xFF};
@@ -666,12 +1261,69 @@ static bool recvDataBlock(SPI_Handle handle, void *buf, uint32_t count)
     return (true);
 }
 
+/*
+ *  ======== runTransfer ========
+ *  Runs a read or write operation and blocks until it has completed
+ */
+static int_fast16_t runTransfer(SD_Handle handle,
+                                bool isWrite,
+                                void *buf,
+                                uint32_t sector,
+                                uint32_t sectorCount,
+                                bool cacheFill)
+{
+    SDSPI_Object *object = handle->object;
+
+    object->callbackFxn = NULL;
+    startTransfer(handle, isWrite, buf, sector, sectorCount, cacheFill);
+
+    /* Posted by completeTransfer() */
+    SemaphoreP_pend(object->transferSem, SemaphoreP_WAIT_FOREVER);
+
+    return (object->status);
+}
+
+/*
+ *  ======== scanToken ========
+ *  Looks for the start block token in bytes received while waiting for a
+ *  data block. The bytes following the token are stored as the first bytes
+ *  of the block. Returns 1 if the token was found, 0 if all bytes were 0xFF
+ *  and -1 if the card sent an error token.
+ */
+static int_fast8_t scanToken(SD_Handle handle, const uint8_t *rxBuf, size_t count)
+{
+    size_t i;
+    SDSPI_Object *object = handle->object;
+
+    i = 0;
+    while ((i < count) && (rxBuf[i] == 0xFF))
+    {
+        i++;
+    }
+
+    if (i == count)
+    {
+        return (0);
+    }
+
+    if (rxBuf[i] != START_BLOCK_TOKEN)
+    {
+        return (-1);
+    }
+
+    i++;
+    object->dataCount = count - i;
+    memcpy(blockBuffer(handle, object->blockIndex), &rxBuf[i], object->dataCount);
+
+    return (1);
+}
+
 /*
  *  ======== sendCmd ========
  *  Function to send a command to the SD card.  Command responses from
  *  SD card are returned.  (0xFF) is returned on failures.
  */
-static uint8_t sendCmd(SPI_Handle handle, uint8_t cmd, uint32_t arg)
+static uint8_t sendCmd(SD_Handle handle, uint8_t cmd, uint32_t arg)
 {
     uint8_t i;
     uint8_t rxBuf;
@@ -734,81 +1386,180 @@ static uint8_t sendCmd(SPI_Handle handle, uint8_t cmd, uint32_t arg)
     return (rxBuf);
 }
 
+/*
+ *  ======== spiCallbackFxn ========
+ *  SPI transfer callback; completes blocking transfers of spiTransfer() and
+ *  advances the current read or write operation.
+ */
+static void spiCallbackFxn(SPI_Handle spiHandle, SPI_Transaction *transaction)
+{
+    SD_Handle handle     = (SD_Handle)transaction->arg;
+    SDSPI_Object *object = handle->object;
+
+    if (object->state == STATE_IDLE)
+    {
+        SemaphoreP_post(object->transferSem);
+        return;
+    }
+
+    if (transaction->status != SPI_TRANSFER_COMPLETED)
+    {
+        object->transferFailed = true;
+    }
+
+    /* Transfers are queued in order; act once the last one has completed */
+    if (transaction == object->lastTransaction)
+    {
+        processTransfer(handle);
+    }
+}
+
 /*
  *  ======== spiTransfer ========
  *  Returns SD_STATUS_SUCCESS when transfer is completed;
  *  SD_STATUS_ERROR otherwise.
  */
-static int_fast16_t spiTransfer(SPI_Handle handle, void *rxBuf, void *txBuf, size_t count)
+static int_fast16_t spiTransfer(SD_Handle handle, void *rxBuf, void *txBuf, size_t count)
 {
-    int_fast16_t status;
     SPI_Transaction transaction;
+    SDSPI_Object *object = handle->object;
 
     transaction.rxBuf = rxBuf;
     transaction.txBuf = txBuf;
     transaction.count = count;
+    transaction.arg   = handle;
 
-    status = (SPI_transfer(handle, &transaction)) ? SD_STATUS_SUCCESS : SD_STATUS_ERROR;
+    if (!SPI_transfer(object->spiHandle, &transaction))
+    {
+        return (SD_STATUS_ERROR);
+    }
 
-    return (status);
+    /* Posted by spiCallbackFxn() */
+    SemaphoreP_pend(object->transferSem, SemaphoreP_WAIT_FOREVER);
+
+    return ((transaction.status == SPI_TRANSFER_COMPLETED) ? SD_STATUS_SUCCESS : SD_STATUS_ERROR);
 }
 
 /*
- *  ======== transmitDataBlock ========
- *  Function to transmit a block of data to the SD card.  A valid command
- *  token must be sent to the SD card prior to sending the data block.
- *  The available tokens are:
- *      START_BLOCK_TOKEN
- *      START_MULTIBLOCK_TOKEN
- *      STOP_MULTIBLOCK_TOKEN
+ *  ======== startTransfer ========
+ *  Starts a read or write operation. The lock must be held; it is released
+ *  by completeTransfer() for operations with a callback function.
  */
-static bool transmitDataBlock(SPI_Handle handle, void *buf, uint32_t count, uint8_t token)
+static void startTransfer(SD_Handle handle,
+                          bool isWrite,
+                          void *buf,
+                          uint32_t sector,
+                          uint32_t sectorCount,
+                          bool cacheFill)
 {
-    uint8_t rxBuf;
-    uint8_t txBuf[2] = {0xFF, 0xFF};
+    uint32_t address             = sector;
+    SDSPI_Object *object         = handle->object;
+    SDSPI_HWAttrs const *hwAttrs = handle->hwAttrs;
 
-    if (!waitUntilReady(handle))
+    /*
+     * On a SDSC card, the sector address is a byte address on the SD Card
+     * On a SDHC card, the sector addressing is via sector blocks
+     */
+    if (object->cardType != SD_SDHC)
     {
-        return (false);
+        /* Convert to byte address */
+        address *= SD_SECTOR_SIZE;
     }
 
-    /* transmit data token */
-    txBuf[0] = token;
-    if (spiTransfer(handle, NULL, &txBuf, 1) != SD_STATUS_SUCCESS)
+    object->isWrite        = isWrite;
+    object->buf            = buf;
+    object->sector         = sector;
+    object->sectorCount    = sectorCount;
+    object->blockIndex     = 0;
+    object->dataCount      = 0;
+    object->cacheFill      = cacheFill;
+    object->sendStop       = false;
+    object->transferFailed = false;
+    object->status         = SD_STATUS_SUCCESS;
+    object->cmdIndex       = 0;
+    object->numCmds        = 0;
+
+    if (!isWrite)
     {
-        return (false);
-    }
+        object->cmd[object->numCmds]      = (sectorCount == 1) ? CMD17 : CMD18;
+        object->cmdArg[object->numCmds++] = address;
 
-    /* Send data only when token != STOP_MULTIBLOCK_TOKEN */
-    if (token != STOP_MULTIBLOCK_TOKEN)
-    {
-        /* Write data to the SD card */
-        if (spiTransfer(handle, NULL, buf, count) != SD_STATUS_SUCCESS)
+        if (sectorCount > 1)
         {
-            return (false);
+            object->cmd[object->numCmds]      = CMD12;
+            object->cmdArg[object->numCmds++] = 0;
         }
-
-        /* Receive the 16 bit CRC, but discard it */
-        txBuf[0] = (0xFF);
-        if (spiTransfer(handle, NULL, &txBuf, 2) != SD_STATUS_SUCCESS)
+    }
+    else
+    {
+        if ((sectorCount > 1) && ((object->cardType == SD_SDSC) || (object->cardType == SD_SDHC)))
         {
-            return (false);
+            /* ACMD23 */
+            object->cmd[object->numCmds]      = CMD55;
+            object->cmdArg[object->numCmds++] = 0;
+            object->cmd[object->numCmds]      = CMD23;
+            object->cmdArg[object->numCmds++] = sectorCount;
         }
 
-        /* Receive data response token from SD card */
-        if (spiTransfer(handle, &rxBuf, &txBuf, 1) != SD_STATUS_SUCCESS)
-        {
-            return (false);
-        }
+        object->cmd[object->numCmds]      = (sectorCount == 1) ? CMD24 : CMD25;
+        object->cmdArg[object->numCmds++] = address;
+    }
 
-        /* Check data response; return error if data was rejected  */
-        if ((rxBuf & 0x1F) != 0x05)
+    assertCS(hwAttrs);
+
+    /* Wait for the card to be ready before the first command */
+    queuePoll(handle, STATE_READY, 1);
+}
+
+/*
+ *  ======== submitTransfers ========
+ *  Queues the first count transactions of the object with the SPI driver.
+ *  processTransfer() is called when the last one has completed.
+ */
+static void submitTransfers(SD_Handle handle, uint_fast8_t count)
+{
+    uintptr_t key;
+    uint_fast8_t i;
+    SDSPI_Object *object = handle->object;
+
+    /* Keep the callbacks of the queued transfers from running until done */
+    key = HwiP_disable();
+
+    for (i = 0; i < count; i++)
+    {
+        object->transaction[i].arg = handle;
+        if (!SPI_transfer(object->spiHandle, &object->transaction[i]))
         {
-            return (false);
+            object->transferFailed = true;
+            break;
         }
     }
 
-    return (true);
+    if (i > 0)
+    {
+        object->lastTransaction = &object->transaction[i - 1];
+    }
+
+    HwiP_restore(key);
+
+    /* Nothing was queued, so no callback will follow */
+    if (i == 0)
+    {
+        object->status = SD_STATUS_ERROR;
+        deassertCS(handle->hwAttrs);
+        completeTransfer(handle);
+    }
+}
+
+/*
+ *  ======== timedOut ========
+ *  Returns true if the current wait has lasted for 1s
+ */
+static bool timedOut(SDSPI_Object *object)
+{
+    uint32_t timeout = 1000000 / ClockP_getSystemTickPeriod();
+
+    return ((ClockP_getSystemTicks() - object->startTime) >= timeout);
 }
 
 /*
@@ -818,7 +1569,7 @@ static bool transmitDataBlock(SPI_Handle handle, void *buf, uint32_t count, uint
  *  Returns true if SD card is ready; false indicates the SD card is still busy
  *  & a timeout occurred.
  */
-static bool waitUntilReady(SPI_Handle handle)
+static bool waitUntilReady(SD_Handle handle)
 {
     uint8_t rxDummy;
     uint8_t txDummy = 0xFF;
@@ -60,6 +60,31 @@
  *  accessibility requirements).  Refer to @ref SPI.h & the device specific
  *  SPI implementation header files for details.
  *
+ *  ## Transfer pipeline #
+ *
+ *  The driver opens the SPI driver in #SPI_MODE_CALLBACK and runs SD_read()
+ *  and SD_write() as a state machine in the SPI transfer callback. The data
+ *  of a block and the bytes following it (CRC, data response, and a few
+ *  bytes of the card's busy or data token phase) are queued as back to back
+ *  DMA transactions, so the token of block N+1 is usually found in the same
+ *  transfer that received the CRC of block N. While waiting for the card,
+ *  the driver polls #SDSPI_POLL_SIZE bytes per transfer instead of one.
+ *
+ *  SDSPI_readAsync() and SDSPI_writeAsync() start the same operations
+ *  without blocking and call an #SDSPI_CallbackFxn when they complete.
+ *  SD_close() waits for an operation in progress to complete, so it must
+ *  be called from a task, or from the #SDSPI_CallbackFxn of the last
+ *  operation.
+ *
+ *  ## Sector cache #
+ *
+ *  A sector cache for file system metadata can be enabled by pointing
+ *  #SDSPI_HWAttrs.cacheBuf to a buffer of #SDSPI_CACHE_SIZE(n) bytes and
+ *  setting #SDSPI_HWAttrs.cacheSectors to n. Single sector reads are served
+ *  from the cache, and a miss reads #SDSPI_HWAttrs.readAheadSectors
+ *  consecutive sectors into it. The cache is write-through; multi-sector
+ *  reads and asynchronous reads bypass it.
+ *
  *  <hr>
  */
 
@@ -75,9 +100,42 @@
 extern "C" {
 #endif
 
+/*!
+ * @brief Returned by SDSPI_readAsync() and SDSPI_writeAsync() if another
+ *        operation is in progress
+ */
+#define SDSPI_STATUS_BUSY (SD_STATUS_RESERVED - 0)
+
+/*!
+ * @brief Number of bytes received per transfer while polling the SD card
+ */
+#define SDSPI_POLL_SIZE (16)
+
+/*!
+ * @brief Maximum number of sectors in the sector cache
+ */
+#define SDSPI_MAX_CACHE_SECTORS (8)
+
+/*!
+ * @brief Size in bytes of a sector cache buffer holding @a n sectors
+ */
+#define SDSPI_CACHE_SIZE(n) ((n) * 512)
+
 /* SDSPI function table */
 extern const SD_FxnTable SDSPI_fxnTable;
 
+/*!
+ *  @brief  Completion callback of SDSPI_readAsync() and SDSPI_writeAsync()
+ *
+ *  Called from the SPI driver's callback context. The driver is ready for a
+ *  new operation when the callback is called.
+ *
+ *  @param  handle   The SD_Handle of the operation
+ *  @param  status   #SD_STATUS_SUCCESS or #SD_STATUS_ERROR
+ *  @param  userArg  Argument passed to SDSPI_readAsync() or SDSPI_writeAsync()
+ */
+typedef void (*SDSPI_CallbackFxn)(SD_Handle handle, int_fast16_t status, void *userArg);
+
 /*!
  *  @brief  SDSPI Hardware attributes
  *
@@ -105,6 +163,12 @@ typedef struct
 {
     uint_least8_t spiIndex;
     uint16_t spiCsGpioIndex;
+    /*! Sector cache buffer of SDSPI_CACHE_SIZE(cacheSectors) bytes, or NULL */
+    uint8_t *cacheBuf;
+    /*! Number of sectors in cacheBuf, at most #SDSPI_MAX_CACHE_SECTORS */
+    uint_least8_t cacheSectors;
+    /*! Number of sectors read into the cache on a miss, at most cacheSectors */
+    uint_least8_t readAheadSectors;
 } SDSPI_HWAttrs;
 
 /*!
@@ -115,11 +179,93 @@ typedef struct
 typedef struct
 {
     SemaphoreP_Handle lockSem;
+    SemaphoreP_Handle transferSem;
     SPI_Handle spiHandle;
+    SPI_Transaction transaction[3];
+    SPI_Transaction *lastTransaction;
+    SDSPI_CallbackFxn callbackFxn;
+    void *userArg;
+    uint8_t *buf;
+    uint32_t sector;
+    uint32_t sectorCount;
+    uint32_t blockIndex;
+    uint32_t startTime;
+    uint32_t cmdArg[3];
+    uint8_t cmd[3];
+    uint8_t numCmds;
+    uint8_t cmdIndex;
+    uint8_t state;
+    uint8_t pollCount;
+    uint16_t dataCount;
+    int_fast16_t status;
+    bool isWrite;
+    bool sendStop;
+    bool transferFailed;
+    bool cacheFill;
+    uint8_t txBuf[6 + SDSPI_POLL_SIZE];
+    uint8_t rxBuf[6 + SDSPI_POLL_SIZE];
+    uint32_t cacheTag[SDSPI_MAX_CACHE_SECTORS];
+    uint32_t cacheStamp[SDSPI_MAX_CACHE_SECTORS];
+    uint32_t cacheClock;
+    uint8_t fillSlot[SDSPI_MAX_CACHE_SECTORS];
     SD_CardType cardType;
     bool isOpen;
 } SDSPI_Object;
 
+/*!
+ *  @brief  Start reading sectors without blocking
+ *
+ *  The operation is started from the caller's context and continues in the
+ *  SPI driver's callback context. @p buf must stay valid until
+ *  @p callbackFxn is called. Can be called from a task, a SWI or an
+ *  #SDSPI_CallbackFxn.
+ *
+ *  @pre    SD_initialize() has been called successfully.
+ *
+ *  @param  handle       An SD_Handle returned by SD_open()
+ *  @param  buf          Buffer of @p sectorCount sectors
+ *  @param  sector       First sector to read
+ *  @param  sectorCount  Number of sectors to read
+ *  @param  callbackFxn  Function called when the read completes
+ *  @param  userArg      Argument passed to @p callbackFxn
+ *
+ *  @return #SD_STATUS_SUCCESS if the read was started, #SDSPI_STATUS_BUSY if
+ *          another operation is in progress, #SD_STATUS_ERROR otherwise.
+ */
+extern int_fast16_t SDSPI_readAsync(SD_Handle handle,
+                                    void *buf,
+                                    int_fast32_t sector,
+                                    uint_fast32_t sectorCount,
+                                    SDSPI_CallbackFxn callbackFxn,
+                                    void *userArg);
+
+/*!
+ *  @brief  Start writing sectors without blocking
+ *
+ *  The operation is started from the caller's context and continues in the
+ *  SPI driver's callback context. @p buf must stay valid and unchanged until
+ *  @p callbackFxn is called. Can be called from a task, a SWI or an
+ *  #SDSPI_CallbackFxn.
+ *
+ *  @pre    SD_initialize() has been called successfully.
+ *
+ *  @param  handle       An SD_Handle returned by SD_open()
+ *  @param  buf          Buffer of @p sectorCount sectors
+ *  @param  sector       First sector to write
+ *  @param  sectorCount  Number of sectors to write
+ *  @param  callbackFxn  Function called when the write completes
+ *  @param  userArg      Argument passed to @p callbackFxn
+ *
+ *  @return #SD_STATUS_SUCCESS if the write was started, #SDSPI_STATUS_BUSY if
+ *          another operation is in progress, #SD_STATUS_ERROR otherwise.
+ */
+extern int_fast16_t SDSPI_writeAsync(SD_Handle handle,
+                                     const void *buf,
+                                     int_fast32_t sector,
+                                     uint_fast32_t sectorCount,
+                                     SDSPI_CallbackFxn callbackFxn,
+                                     void *userArg);
+
 #ifdef __cplusplus
 }
 #endif
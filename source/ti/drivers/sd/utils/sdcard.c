@@ -0,0 +1,591 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== sdcard.c ========
+ *
+ * Host emulation of an SPI-mode SD card.  The card answers the commands
+ * SDSPI uses (CMD0, 8, 9, 12, 16, 17, 18, 23, 24, 25, 55, 58 and ACMD41)
+ * with a random command response delay, inserts a random access time
+ * before each read data token and holds the bus busy after writes.
+ *
+ * Blocking mode SPI transfers complete in SPI_transfer().  Callback mode
+ * transfers are queued and completed by SdCard_runCallback(), which is
+ * also run by SemaphoreP_pend() while it waits, as the SPI interrupt would
+ * on the device.  Every transfer charges a driver overhead and the bus
+ * time to the simulated clock.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ti/drivers/dpl/SemaphoreP.h>
+#include <ti/drivers/dpl/ClockP.h>
+#include <ti/drivers/dpl/HwiP.h>
+#include <ti/drivers/GPIO.h>
+#include <ti/drivers/SPI.h>
+
+#include "sdcard.h"
+
+#define SECTOR_SIZE 512
+#define OUT_SIZE    2048
+#define QUEUE_SIZE  64
+
+typedef enum
+{
+    CARD_IDLE,
+    CARD_READ,
+    CARD_WRITE_TOKEN,
+    CARD_WRITE_DATA
+} CardState;
+
+SdCard_Stats sdCardStats;
+SdCard_Config sdCardConfig = {
+    .numSectors = 4096,
+    .sdhc       = true,
+    .ncrMax     = 2,
+    .nacUs      = 100,
+    .busyUs     = 300,
+    .stopBusyUs = 200,
+};
+uint8_t *sdCardMem;
+
+static struct
+{
+    CardState state;
+    uint8_t cmd[6];
+    int cmdLen;
+    uint8_t out[OUT_SIZE]; /* bytes queued for output */
+    int outHead;
+    int outTail;
+    double busyUntil;      /* outputs 0x00 while busy */
+    double dataAt;         /* next read data token not before */
+    bool multi;
+    uint32_t block;
+    int blockPos;          /* -1 while the read data token is pending */
+    bool idle;
+    int acmd41Count;
+    bool appCmd;
+    uint8_t writeBuf[SECTOR_SIZE + 2];
+    int writePos;
+    int rejectWrites;
+} card;
+
+static bool selected;
+
+/*
+ *  ======== SdCard_reset ========
+ */
+void SdCard_reset(void)
+{
+    memset(&card, 0, sizeof(card));
+    card.idle = true;
+}
+
+/*
+ *  ======== SdCard_rejectWrites ========
+ */
+void SdCard_rejectWrites(int n)
+{
+    card.rejectWrites = n;
+}
+
+static void outPush(uint8_t b)
+{
+    card.out[card.outTail++ % OUT_SIZE] = b;
+}
+
+static bool outEmpty(void)
+{
+    return (card.outHead == card.outTail);
+}
+
+static uint32_t blockOf(uint32_t arg)
+{
+    return (sdCardConfig.sdhc ? arg : arg / SECTOR_SIZE);
+}
+
+static void respond(uint8_t r1)
+{
+    int ncr = (sdCardConfig.ncrMax > 1) ? (rand() % sdCardConfig.ncrMax) : 0;
+
+    while (ncr-- > 0)
+    {
+        outPush(0xFF);
+    }
+    outPush(r1);
+}
+
+static void startReadBlock(void)
+{
+    card.dataAt   = sdCardStats.nowUs + ((sdCardConfig.nacUs > 0) ? (rand() % (sdCardConfig.nacUs + 1)) : 0);
+    card.blockPos = -1;
+}
+
+/*
+ *  ======== handleCmd ========
+ */
+static void handleCmd(void)
+{
+    uint8_t cmd  = card.cmd[0] & 0x3F;
+    uint32_t arg = ((uint32_t)card.cmd[1] << 24) | ((uint32_t)card.cmd[2] << 16) | ((uint32_t)card.cmd[3] << 8) |
+                   card.cmd[4];
+    bool app     = card.appCmd;
+    uint8_t csd[16];
+    uint32_t csize;
+    int i;
+
+    card.appCmd = false;
+    sdCardStats.cmds++;
+
+    switch (cmd)
+    {
+        case 0:
+            card.idle = true;
+            respond(0x01);
+            break;
+
+        case 8:
+            respond(0x01);
+            outPush(0x00);
+            outPush(0x00);
+            outPush(0x01);
+            outPush(0xAA);
+            break;
+
+        case 55:
+            card.appCmd = true;
+            respond(card.idle ? 0x01 : 0x00);
+            break;
+
+        case 41:
+            /* Leaves the idle state on the third ACMD41 */
+            if (++card.acmd41Count >= 3)
+            {
+                card.idle = false;
+            }
+            respond(card.idle ? 0x01 : 0x00);
+            break;
+
+        case 58:
+            respond(0x00);
+            outPush(sdCardConfig.sdhc ? 0xC0 : 0x80);
+            outPush(0xFF);
+            outPush(0x80);
+            outPush(0x00);
+            break;
+
+        case 16:
+            respond(0x00);
+            break;
+
+        case 9:
+            /* CSD version 2.0, capacity (C_SIZE + 1) * 512 KB */
+            respond(0x00);
+            outPush(0xFF);
+            outPush(0xFE);
+            memset(csd, 0, sizeof(csd));
+            csd[0] = 0x40;
+            csize  = sdCardConfig.numSectors / 1024 - 1;
+            csd[8] = csize >> 8;
+            csd[9] = csize & 0xFF;
+            for (i = 0; i < 16; i++)
+            {
+                outPush(csd[i]);
+            }
+            outPush(0x00);
+            outPush(0x00);
+            break;
+
+        case 17:
+        case 18:
+            if (blockOf(arg) >= sdCardConfig.numSectors)
+            {
+                respond(0x40);
+                break;
+            }
+            respond(0x00);
+            card.state = CARD_READ;
+            card.multi = (cmd == 18);
+            card.block = blockOf(arg);
+            startReadBlock();
+            break;
+
+        case 12:
+            /* Stuff byte, then R1b */
+            card.state   = CARD_IDLE;
+            card.outHead = card.outTail;
+            outPush(0x5A);
+            outPush(0x00);
+            card.busyUntil = sdCardStats.nowUs + 20;
+            break;
+
+        case 23:
+            respond(app ? 0x00 : 0x04);
+            break;
+
+        case 24:
+        case 25:
+            if (blockOf(arg) >= sdCardConfig.numSectors)
+            {
+                respond(0x40);
+                break;
+            }
+            respond(0x00);
+            card.state = CARD_WRITE_TOKEN;
+            card.multi = (cmd == 25);
+            card.block = blockOf(arg);
+            break;
+
+        default:
+            respond(0x04);
+            break;
+    }
+}
+
+/*
+ *  ======== exchange ========
+ *  One byte exchanged on the bus.
+ */
+static uint8_t exchange(uint8_t mosi)
+{
+    bool ok;
+
+    sdCardStats.nowUs += 8.0 / sdCardStats.bitRateMHz;
+    sdCardStats.busBytes++;
+
+    if (!selected)
+    {
+        return (0xFF);
+    }
+
+    /* Command reception, also while streaming read data for CMD12 */
+    if (card.cmdLen > 0 ||
+        ((mosi & 0xC0) == 0x40 && (card.state == CARD_IDLE || card.state == CARD_READ) && outEmpty()))
+    {
+        card.cmd[card.cmdLen++] = mosi;
+        if (card.cmdLen < 6)
+        {
+            if (card.state != CARD_READ)
+            {
+                return (0xFF);
+            }
+        }
+        else
+        {
+            card.cmdLen = 0;
+            if (card.state != CARD_READ || (card.cmd[0] & 0x3F) == 12)
+            {
+                handleCmd();
+            }
+            return (0xFF);
+        }
+    }
+
+    if (!outEmpty())
+    {
+        return (card.out[card.outHead++ % OUT_SIZE]);
+    }
+    if (sdCardStats.nowUs < card.busyUntil)
+    {
+        return (0x00);
+    }
+
+    switch (card.state)
+    {
+        case CARD_READ:
+            if (card.blockPos < 0)
+            {
+                if (sdCardStats.nowUs < card.dataAt)
+                {
+                    return (0xFF);
+                }
+                if (card.block >= sdCardConfig.numSectors)
+                {
+                    /* Out of range error token */
+                    card.state = CARD_IDLE;
+                    return (0x08);
+                }
+                card.blockPos = 0;
+                return (0xFE);
+            }
+            if (card.blockPos < SECTOR_SIZE)
+            {
+                return (sdCardMem[card.block * SECTOR_SIZE + card.blockPos++]);
+            }
+            if (card.blockPos < SECTOR_SIZE + 2)
+            {
+                /* CRC, ignored by the driver */
+                card.blockPos++;
+                return (0x12);
+            }
+            if (card.multi)
+            {
+                card.block++;
+                startReadBlock();
+            }
+            else
+            {
+                card.state = CARD_IDLE;
+            }
+            return (0xFF);
+
+        case CARD_WRITE_TOKEN:
+            if (mosi == 0xFE || mosi == 0xFC)
+            {
+                card.state    = CARD_WRITE_DATA;
+                card.writePos = 0;
+            }
+            else if (mosi == 0xFD && card.multi)
+            {
+                card.state     = CARD_IDLE;
+                card.busyUntil = sdCardStats.nowUs + 8.0 / sdCardStats.bitRateMHz + sdCardConfig.stopBusyUs;
+            }
+            return (0xFF);
+
+        case CARD_WRITE_DATA:
+            card.writeBuf[card.writePos++] = mosi;
+            if (card.writePos == SECTOR_SIZE + 2)
+            {
+                ok = (card.block < sdCardConfig.numSectors) && (card.rejectWrites == 0);
+                if (card.rejectWrites > 0)
+                {
+                    card.rejectWrites--;
+                }
+                if (ok)
+                {
+                    memcpy(&sdCardMem[card.block * SECTOR_SIZE], card.writeBuf, SECTOR_SIZE);
+                    sdCardStats.blocksWritten++;
+                }
+                /* Data accepted or write error */
+                outPush(ok ? 0xE5 : 0xEB);
+                card.busyUntil = sdCardStats.nowUs + 2 * 8.0 / sdCardStats.bitRateMHz + sdCardConfig.busyUs;
+                card.block++;
+                card.state = card.multi ? CARD_WRITE_TOKEN : CARD_IDLE;
+            }
+            return (0xFF);
+
+        default:
+            return (0xFF);
+    }
+}
+
+/* GPIO, the chip select */
+void GPIO_init(void)
+{
+}
+
+int_fast16_t GPIO_setConfig(uint_least8_t index, GPIO_PinConfig pinConfig)
+{
+    return (GPIO_STATUS_SUCCESS);
+}
+
+void GPIO_write(uint_least8_t index, unsigned int value)
+{
+    selected = (value == 0);
+}
+
+/* DPL */
+uint32_t ClockP_getSystemTicks(void)
+{
+    return ((uint32_t)(sdCardStats.nowUs / 10.0));
+}
+
+uint32_t ClockP_getSystemTickPeriod(void)
+{
+    return (10);
+}
+
+uintptr_t HwiP_disable(void)
+{
+    return (0);
+}
+
+void HwiP_restore(uintptr_t key)
+{
+}
+
+typedef struct
+{
+    int count;
+} Semaphore;
+
+SemaphoreP_Handle SemaphoreP_createBinary(unsigned int count)
+{
+    Semaphore *sem = calloc(1, sizeof(*sem));
+
+    sem->count = count;
+    return (sem);
+}
+
+void SemaphoreP_delete(SemaphoreP_Handle handle)
+{
+    free(handle);
+}
+
+void SemaphoreP_post(SemaphoreP_Handle handle)
+{
+    ((Semaphore *)handle)->count = 1;
+}
+
+SemaphoreP_Status SemaphoreP_pend(SemaphoreP_Handle handle, uint32_t timeout)
+{
+    Semaphore *sem = handle;
+
+    while (sem->count == 0)
+    {
+        if (timeout == SemaphoreP_NO_WAIT)
+        {
+            return (SemaphoreP_TIMEOUT);
+        }
+        if (!SdCard_runCallback())
+        {
+            fprintf(stderr, "SemaphoreP_pend: deadlock\n");
+            abort();
+        }
+    }
+    sem->count = 0;
+
+    return (SemaphoreP_OK);
+}
+
+/* SPI */
+static SPI_TransferMode spiMode;
+static SPI_CallbackFxn spiCallbackFxn;
+static SPI_Config spiConfig;
+static bool spiOpen;
+static SPI_Transaction *queue[QUEUE_SIZE];
+static int queueHead;
+static int queueTail;
+
+void SPI_init(void)
+{
+}
+
+void SPI_Params_init(SPI_Params *params)
+{
+    memset(params, 0, sizeof(*params));
+    params->transferMode = SPI_MODE_BLOCKING;
+    params->bitRate      = 1000000;
+    params->dataSize     = 8;
+}
+
+SPI_Handle SPI_open(uint_least8_t index, SPI_Params *params)
+{
+    spiMode                = params->transferMode;
+    spiCallbackFxn         = params->transferCallbackFxn;
+    sdCardStats.bitRateMHz = params->bitRate / 1e6;
+    spiOpen                = true;
+
+    return (&spiConfig);
+}
+
+void SPI_close(SPI_Handle handle)
+{
+    if (queueHead != queueTail)
+    {
+        fprintf(stderr, "SPI_close: %d transfers in progress\n", queueTail - queueHead);
+        abort();
+    }
+    spiOpen = false;
+}
+
+static void doTransfer(SPI_Transaction *transaction)
+{
+    const uint8_t *tx = transaction->txBuf;
+    uint8_t *rx       = transaction->rxBuf;
+    uint8_t data;
+    size_t i;
+
+    for (i = 0; i < transaction->count; i++)
+    {
+        data = exchange((tx != NULL) ? tx[i] : 0xFF);
+        if (rx != NULL)
+        {
+            rx[i] = data;
+        }
+    }
+    transaction->status = SPI_TRANSFER_COMPLETED;
+    sdCardStats.transfers++;
+}
+
+bool SPI_transfer(SPI_Handle handle, SPI_Transaction *transaction)
+{
+    if (!spiOpen)
+    {
+        fprintf(stderr, "SPI_transfer: SPI is closed\n");
+        abort();
+    }
+
+    if (sdCardStats.failNextTransfer > 0)
+    {
+        sdCardStats.failNextTransfer--;
+        return (false);
+    }
+
+    if (spiMode == SPI_MODE_BLOCKING)
+    {
+        sdCardStats.nowUs += sdCardStats.blockingOverheadUs;
+        doTransfer(transaction);
+        return (true);
+    }
+
+    /*
+     * A transfer started on an idle bus pays the setup overhead, one
+     * queued behind another is chained by the SPI driver's DMA handling
+     */
+    sdCardStats.nowUs += (queueHead == queueTail) ? sdCardStats.callbackOverheadUs : sdCardStats.queuedOverheadUs;
+    queue[queueTail++ % QUEUE_SIZE] = transaction;
+
+    return (true);
+}
+
+/*
+ *  ======== SdCard_runCallback ========
+ */
+bool SdCard_runCallback(void)
+{
+    SPI_Transaction *transaction;
+
+    if (queueHead == queueTail)
+    {
+        return (false);
+    }
+
+    transaction = queue[queueHead++ % QUEUE_SIZE];
+    doTransfer(transaction);
+    spiCallbackFxn((SPI_Handle)&spiConfig, transaction);
+
+    return (true);
+}
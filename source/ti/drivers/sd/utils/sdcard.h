@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== sdcard.h ========
+ *
+ * Host emulation of an SPI-mode SD card behind the SPI and GPIO driver
+ * APIs, with simulated time.
+ */
+
+#ifndef sdcard__include
+#define sdcard__include
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct
+{
+    double nowUs;              /* simulated time */
+    double bitRateMHz;         /* SPI bit rate, from SPI_open() */
+    double blockingOverheadUs; /* driver overhead per blocking transfer */
+    double callbackOverheadUs; /* overhead per callback transfer on an idle bus */
+    double queuedOverheadUs;   /* overhead per transfer queued behind another */
+    long transfers;            /* SPI transfers */
+    long busBytes;             /* bytes on the bus */
+    long cmds;                 /* commands received by the card */
+    long blocksWritten;        /* data blocks accepted by the card */
+    int failNextTransfer;      /* number of SPI_transfer() calls to fail */
+} SdCard_Stats;
+
+typedef struct
+{
+    uint32_t numSectors;
+    bool sdhc;      /* block addressed (SDHC) or byte addressed (SDSC) */
+    int ncrMax;     /* command response delay, 1 to ncrMax bytes */
+    int nacUs;      /* read access time, 0 to nacUs */
+    int busyUs;     /* busy time after a data block is written */
+    int stopBusyUs; /* busy time after a multi-block write stop token */
+} SdCard_Config;
+
+extern SdCard_Stats sdCardStats;
+extern SdCard_Config sdCardConfig;
+
+/* Card contents, numSectors * 512 bytes allocated by the caller */
+extern uint8_t *sdCardMem;
+
+/* Power cycle the card */
+extern void SdCard_reset(void);
+
+/* Reject the data of the next n written blocks */
+extern void SdCard_rejectWrites(int n);
+
+/*
+ * Complete the next queued callback mode transfer and call the SPI
+ * callback, as the SPI interrupt would.  Returns false if none is queued.
+ */
+extern bool SdCard_runCallback(void);
+
+#endif /* sdcard__include */
@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2025, Texas Instruments Incorporated
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * ======== sdspitest.c ========
+ *
+ * Check and benchmark of the SDSPI driver on the emulated SD card of
+ * sdcard.c.
+ *
+ *  - Random single and multi-sector reads and writes on SDHC and SDSC
+ *    cards, with command response delays of 1 to 8 bytes and read access
+ *    times of 0 to 3 ms, compared against a copy of the card.
+ *  - Error paths: reads past the end of the card, rejected data blocks
+ *    and failing SPI transfers.
+ *  - The sector cache with read ahead.
+ *  - Asynchronous reads and writes, including a write started from the
+ *    completion callback and SD_close() while a read is in progress.
+ *  - SPI transactions and time per operation, with the driver overheads
+ *    given on the command line.
+ *
+ * Usage:
+ *
+ *     sdspitest [blocking-us [callback-us [chained-us]]]
+ *
+ *     Overhead per blocking, callback and chained SPI transfer, default
+ *     20, 12 and 3 us.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ti/drivers/SD.h>
+#include <ti/drivers/sd/SDSPI.h>
+
+#include "sdcard.h"
+
+#define SECTOR_SIZE 512
+
+#define CHECK(cond)                                                       \
+    do                                                                    \
+    {                                                                     \
+        if (!(cond))                                                      \
+        {                                                                 \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);        \
+            exit(1);                                                      \
+        }                                                                 \
+    } while (0)
+
+static SDSPI_Object object;
+static SDSPI_HWAttrs hwAttrs = {.spiIndex = 0, .spiCsGpioIndex = 1};
+static uint8_t cacheBuf[SDSPI_CACHE_SIZE(8)];
+
+const SD_Config SD_config[1] = {
+    {.fxnTablePtr = &SDSPI_fxnTable, .object = &object, .hwAttrs = &hwAttrs},
+};
+const uint_least8_t SD_count = 1;
+
+static SD_Handle handle;
+static uint8_t *shadow;
+static uint8_t buf[64 * SECTOR_SIZE];
+static uint8_t buf2[64 * SECTOR_SIZE];
+
+static void openCard(void)
+{
+    handle = SD_open(0, NULL);
+    CHECK(handle != NULL);
+    CHECK(SD_initialize(handle) == SD_STATUS_SUCCESS);
+    CHECK(SD_getNumSectors(handle) == sdCardConfig.numSectors);
+}
+
+static void setup(bool sdhc, uint32_t sectors)
+{
+    uint32_t i;
+
+    if (handle != NULL)
+    {
+        SD_close(handle);
+    }
+
+    sdCardConfig.sdhc       = sdhc;
+    sdCardConfig.numSectors = sectors;
+    free(sdCardMem);
+    free(shadow);
+    sdCardMem = malloc(sectors * SECTOR_SIZE);
+    shadow    = malloc(sectors * SECTOR_SIZE);
+    for (i = 0; i < sectors * SECTOR_SIZE; i++)
+    {
+        sdCardMem[i] = shadow[i] = rand();
+    }
+    SdCard_reset();
+    openCard();
+}
+
+static void fillRandom(uint8_t *data, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0; i < count * SECTOR_SIZE; i++)
+    {
+        data[i] = rand();
+    }
+}
+
+static void writeSectors(const uint8_t *data, uint32_t sector, uint32_t count)
+{
+    CHECK(SD_write(handle, data, sector, count) == SD_STATUS_SUCCESS);
+    memcpy(&shadow[sector * SECTOR_SIZE], data, count * SECTOR_SIZE);
+}
+
+static void readSectors(uint32_t sector, uint32_t count)
+{
+    memset(buf, 0xA5, count * SECTOR_SIZE);
+    CHECK(SD_read(handle, buf, sector, count) == SD_STATUS_SUCCESS);
+    CHECK(memcmp(buf, &shadow[sector * SECTOR_SIZE], count * SECTOR_SIZE) == 0);
+}
+
+/*
+ *  ======== randomOps ========
+ *  Random reads and writes; with a hot area, most of them are in the first
+ *  'hot' sectors, like file system metadata.
+ */
+static void randomOps(int n, uint32_t maxCount, uint32_t hot)
+{
+    uint32_t count, sector;
+
+    while (n-- > 0)
+    {
+        count  = 1 + rand() % maxCount;
+        sector = rand() % (sdCardConfig.numSectors - count + 1);
+        if (hot > 0 && (rand() % 2))
+        {
+            sector = rand() % hot;
+        }
+
+        if (rand() % 2)
+        {
+            fillRandom(buf, count);
+            writeSectors(buf, sector, count);
+        }
+        else
+        {
+            readSectors(sector, count);
+        }
+    }
+    CHECK(memcmp(sdCardMem, shadow, sdCardConfig.numSectors * SECTOR_SIZE) == 0);
+}
+
+static void checkIntegrity(void)
+{
+    static const int ncr[] = {1, 2, 8};
+    static const int nac[] = {0, 5, 100, 3000};
+    int i, j, sdhc;
+
+    for (i = 0; i < 3; i++)
+    {
+        for (j = 0; j < 4; j++)
+        {
+            for (sdhc = 0; sdhc < 2; sdhc++)
+            {
+                sdCardConfig.ncrMax = ncr[i];
+                sdCardConfig.nacUs  = nac[j];
+                setup(sdhc, 2048);
+                randomOps(150, 9, 0);
+            }
+        }
+    }
+    printf("random read/write integrity: ok\n");
+}
+
+static void checkErrors(void)
+{
+    sdCardConfig.ncrMax = 2;
+    sdCardConfig.nacUs  = 100;
+    setup(true, 1024);
+
+    /* Runs past the end of the card */
+    CHECK(SD_read(handle, buf, 1020, 8) == SD_STATUS_ERROR);
+    readSectors(1020, 4);
+    CHECK(SD_read(handle, buf, 5000, 1) == SD_STATUS_ERROR);
+
+    SdCard_rejectWrites(1);
+    CHECK(SD_write(handle, buf2, 10, 3) == SD_STATUS_ERROR);
+    writeSectors(buf2, 10, 3);
+    SdCard_rejectWrites(1);
+    CHECK(SD_write(handle, buf2, 20, 1) == SD_STATUS_ERROR);
+    randomOps(50, 9, 0);
+
+    sdCardStats.failNextTransfer = 1;
+    CHECK(SD_read(handle, buf, 5, 2) == SD_STATUS_ERROR);
+    randomOps(50, 9, 0);
+
+    printf("error paths: ok\n");
+}
+
+static void checkCache(void)
+{
+    double t0;
+    long transfers;
+    int sdhc, i;
+
+    hwAttrs.cacheBuf         = cacheBuf;
+    hwAttrs.cacheSectors     = 8;
+    hwAttrs.readAheadSectors = 4;
+
+    for (sdhc = 0; sdhc < 2; sdhc++)
+    {
+        setup(sdhc, 1024);
+        randomOps(3000, 6, 24);
+
+        /* Read ahead past the end of the card falls back to a single read */
+        readSectors(1023, 1);
+    }
+
+    /* Sequential metadata scan */
+    setup(true, 1024);
+    t0        = sdCardStats.nowUs;
+    transfers = sdCardStats.transfers;
+    for (i = 0; i < 64; i++)
+    {
+        readSectors(32 + i, 1);
+    }
+    printf("cache: ok, sequential single-sector scan %.2f transfers/sector, %.1f us/sector\n",
+           (sdCardStats.transfers - transfers) / 64.0, (sdCardStats.nowUs - t0) / 64);
+
+    hwAttrs.cacheBuf         = NULL;
+    hwAttrs.cacheSectors     = 0;
+    hwAttrs.readAheadSectors = 0;
+}
+
+static int doneCount;
+static int lastStatus;
+static int chainLeft;
+
+static void asyncDone(SD_Handle sdHandle, int_fast16_t status, void *userArg)
+{
+    lastStatus = status;
+    doneCount++;
+
+    /* Chain the next write from the callback */
+    if (chainLeft > 0)
+    {
+        chainLeft--;
+        CHECK(SDSPI_writeAsync(sdHandle, buf2, 100 + chainLeft * 4, 4, asyncDone, NULL) == SD_STATUS_SUCCESS);
+        memcpy(&shadow[(100 + chainLeft * 4) * SECTOR_SIZE], buf2, 4 * SECTOR_SIZE);
+    }
+}
+
+static void checkAsync(void)
+{
+    setup(true, 1024);
+    fillRandom(buf2, 8);
+
+    doneCount = 0;
+    CHECK(SDSPI_readAsync(handle, buf, 7, 5, asyncDone, NULL) == SD_STATUS_SUCCESS);
+    CHECK(SDSPI_writeAsync(handle, buf2, 7, 1, asyncDone, NULL) == SDSPI_STATUS_BUSY);
+    while (SdCard_runCallback()) {}
+    CHECK(doneCount == 1 && lastStatus == SD_STATUS_SUCCESS);
+    CHECK(memcmp(buf, &shadow[7 * SECTOR_SIZE], 5 * SECTOR_SIZE) == 0);
+
+    chainLeft = 5;
+    doneCount = 0;
+    CHECK(SDSPI_writeAsync(handle, buf2, 50, 8, asyncDone, NULL) == SD_STATUS_SUCCESS);
+    memcpy(&shadow[50 * SECTOR_SIZE], buf2, 8 * SECTOR_SIZE);
+    while (SdCard_runCallback()) {}
+    CHECK(doneCount == 6 && lastStatus == SD_STATUS_SUCCESS);
+    CHECK(memcmp(sdCardMem, shadow, 1024 * SECTOR_SIZE) == 0);
+
+    CHECK(SDSPI_readAsync(handle, buf, 1020, 8, asyncDone, NULL) == SD_STATUS_SUCCESS);
+    while (SdCard_runCallback()) {}
+    CHECK(lastStatus == SD_STATUS_ERROR);
+    randomOps(50, 9, 0);
+
+    /* Close waits for the read to complete */
+    doneCount = 0;
+    CHECK(SDSPI_readAsync(handle, buf, 30, 6, asyncDone, NULL) == SD_STATUS_SUCCESS);
+    SD_close(handle);
+    CHECK(doneCount == 1 && lastStatus == SD_STATUS_SUCCESS);
+    CHECK(!SdCard_runCallback());
+    CHECK(memcmp(buf, &shadow[30 * SECTOR_SIZE], 6 * SECTOR_SIZE) == 0);
+    openCard();
+    randomOps(20, 9, 0);
+
+    printf("async: ok\n");
+}
+
+static void bench(const char *name, bool write, uint32_t count, int reps)
+{
+    double t0       = sdCardStats.nowUs;
+    long transfers  = sdCardStats.transfers;
+    uint32_t sector;
+    int r;
+
+    for (r = 0; r < reps; r++)
+    {
+        sector = (r * 97) % (sdCardConfig.numSectors - count);
+        if (write)
+        {
+            writeSectors(buf, sector, count);
+        }
+        else
+        {
+            CHECK(SD_read(handle, buf, sector, count) == SD_STATUS_SUCCESS);
+        }
+    }
+
+    printf("  %-18s %6.1f transfers/op %8.1f us/op %7.1f kB/s\n", name,
+           (double)(sdCardStats.transfers - transfers) / reps, (sdCardStats.nowUs - t0) / reps,
+           reps * count * (SECTOR_SIZE / 1024.0) / ((sdCardStats.nowUs - t0) / 1e6));
+}
+
+int main(int argc, char *argv[])
+{
+    srand(1);
+    sdCardStats.blockingOverheadUs = (argc > 1) ? atof(argv[1]) : 20;
+    sdCardStats.callbackOverheadUs = (argc > 2) ? atof(argv[2]) : 12;
+    sdCardStats.queuedOverheadUs   = (argc > 3) ? atof(argv[3]) : 3;
+
+    SD_init();
+
+    checkIntegrity();
+    checkErrors();
+    checkCache();
+    checkAsync();
+
+    sdCardConfig.ncrMax = 2;
+    sdCardConfig.nacUs  = 100;
+    sdCardConfig.busyUs = 300;
+    setup(true, 4096);
+    printf("%.0f/%.0f/%.0f us per blocking/callback/chained transfer, %.1f MHz, Nac %d us, busy %d us:\n",
+           sdCardStats.blockingOverheadUs, sdCardStats.callbackOverheadUs, sdCardStats.queuedOverheadUs,
+           sdCardStats.bitRateMHz, sdCardConfig.nacUs, sdCardConfig.busyUs);
+    bench("read 1 sector", false, 1, 200);
+    bench("read 32 sectors", false, 32, 20);
+    bench("write 1 sector", true, 1, 200);
+    bench("write 32 sectors", true, 32, 20);
+    CHECK(memcmp(sdCardMem, shadow, 4096 * SECTOR_SIZE) == 0);
+
+    SD_close(handle);
+
+    return (0);
+}
@@ -98,6 +98,26 @@ tick of the idle loop / LogSinkUART_flush() call.
 `,
         default     : 1024
     },
+    {
+        name        : "framed",
+        displayName : "Framed Output",
+        description : "Wrap each log packet in a frame with a sequence number"
+            + " and a dropped packet count",
+        longDescription: `
+Each log packet is preceded by an 8-byte frame header with a sync word, the
+packet length, a sequence number and the number of packets dropped since the
+previous frame. The host-side tool can then resynchronize quickly on a
+corrupted stream, and report how many log statements were dropped on the
+device or lost in transport.
+
+A log statement that would overflow the ring buffer is dropped and counted
+instead of being replaced by an overflow message.
+
+The host-side tool must be started with the --framed option of the uart
+transport to decode this output.
+`,
+        default     : false
+    },
     {
         name: "printfDelegate",
         displayName: "Printf Delegate Function",
@@ -47,6 +47,34 @@
 #define LogSinkBuf_FULL     -1
 #define LogSinkBuf_MAX_ARGS (LogSinkBuf_WORDS_PER_RECORD - 1)
 
+/* Lock-free record reservation.
+ *
+ * When LogSinkBuf_LOCK_FREE is set to 1, records are reserved by atomically
+ * incrementing the instance serial with exclusive load/store (LDREX/STREX)
+ * instead of disabling interrupts. The record used for a serial is derived
+ * from the serial itself. A record's serial is cleared while it is written
+ * and set when it is complete, so it doubles as a commit flag. The buffer
+ * layout read by ROV is unchanged.
+ *
+ * Timestamps are taken after reservation, so records logged concurrently from
+ * nested contexts may have timestamps slightly out of serial order.
+ * When the serial wraps (after 2^32 records), the record order of a circular
+ * buffer whose number of entries is not a power of two is broken once.
+ *
+ * The mode requires a target with exclusive load/store instructions, and a
+ * toolchain providing the __atomic builtins.
+ */
+#ifndef LogSinkBuf_LOCK_FREE
+    #define LogSinkBuf_LOCK_FREE 0
+#endif
+
+#if LogSinkBuf_LOCK_FREE
+    #if !(defined(__GNUC__) || defined(__clang__)) || \
+        (defined(__arm__) && !(defined(__ARM_FEATURE_LDREX) && (__ARM_FEATURE_LDREX & 0x4)))
+        #error "LogSinkBuf_LOCK_FREE requires 32-bit exclusive load/store and __atomic builtins"
+    #endif
+#endif
+
 /* Global LogSinkBuf instance reference for use with singleton implementations
  * of printf.
  */
@@ -73,6 +101,144 @@ static void findNextRecord(LogSinkBuf_Handle inst, LogSinkBuf_Rec **rec)
     }
 }
 
+#if LogSinkBuf_LOCK_FREE
+/*
+ *  ======== reserveRecords ========
+ *  Atomically reserve count serials and return the first of them.
+ *
+ *  The serial of a linear buffer saturates instead of wrapping, so that
+ *  records reserved after it is full never map to the kept records again.
+ */
+static inline uint32_t reserveRecords(LogSinkBuf_Handle inst, uint32_t count)
+{
+    uint32_t serial;
+
+    if (inst->bufType == LogSinkBuf_Type_CIRCULAR)
+    {
+        return __atomic_fetch_add(&inst->serial, count, __ATOMIC_RELAXED) + 1;
+    }
+
+    serial = __atomic_load_n(&inst->serial, __ATOMIC_RELAXED);
+    do
+    {
+        if (serial > UINT32_MAX - count)
+        {
+            return UINT32_MAX;
+        }
+    } while (!__atomic_compare_exchange_n(&inst->serial,
+                                          &serial,
+                                          serial + count,
+                                          1,
+                                          __ATOMIC_RELAXED,
+                                          __ATOMIC_RELAXED));
+
+    return serial + 1;
+}
+
+/*
+ *  ======== findSerialRecord ========
+ *  Return the record a serial is written to, or NULL if a linear buffer is
+ *  full.
+ */
+static LogSinkBuf_Rec *findSerialRecord(LogSinkBuf_Handle inst, uint32_t serial)
+{
+    if (inst->bufType == LogSinkBuf_Type_CIRCULAR)
+    {
+        return &inst->buffer[(serial - 1) % inst->numEntries];
+    }
+
+    if (serial > inst->numEntries)
+    {
+        return NULL;
+    }
+
+    if (serial == inst->numEntries)
+    {
+        inst->advance = LogSinkBuf_FULL;
+    }
+
+    return &inst->buffer[serial - 1];
+}
+
+/*
+ *  ======== openRecord ========
+ *  Mark a record as being written. The clear must be visible before any of
+ *  the record contents change.
+ */
+static inline void openRecord(LogSinkBuf_Rec *rec)
+{
+    __atomic_store_n(&rec->serial, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+/*
+ *  ======== commitRecord ========
+ *  Publish a complete record by setting its serial
+ */
+static inline void commitRecord(LogSinkBuf_Rec *rec, uint32_t serial)
+{
+    __atomic_store_n(&rec->serial, serial, __ATOMIC_RELEASE);
+}
+
+/*
+ *  ======== updateCurEntry ========
+ *  Point curEntry at the record following the latest reserved serial.
+ *
+ *  Retried if another context reserved a record in between, so that curEntry
+ *  is exact again once the outermost writer returns.
+ */
+static void updateCurEntry(LogSinkBuf_Handle inst)
+{
+    uint32_t serial;
+
+    do
+    {
+        serial = __atomic_load_n(&inst->serial, __ATOMIC_RELAXED);
+
+        if (inst->bufType == LogSinkBuf_Type_CIRCULAR)
+        {
+            inst->curEntry = &inst->buffer[serial % inst->numEntries];
+        }
+        else
+        {
+            inst->curEntry = (serial < inst->numEntries) ? &inst->buffer[serial] : inst->endEntry;
+        }
+    } while (serial != __atomic_load_n(&inst->serial, __ATOMIC_RELAXED));
+}
+
+/*
+ *  ======== LogSinkBuf_printf ========
+ */
+void LogSinkBuf_printf(LogSinkBuf_Handle inst, uint32_t header, uint32_t index, uint32_t numArgs, va_list argptr)
+{
+    uint32_t serial;
+    LogSinkBuf_Rec *rec;
+    uint32_t i;
+
+    /* increment serial even when full */
+    serial = reserveRecords(inst, 1);
+
+    rec = findSerialRecord(inst, serial);
+    if (rec == NULL)
+    {
+        return;
+    }
+
+    openRecord(rec);
+
+    rec->timestampLow = TimestampP_getNative32();
+    rec->type         = LogSinkBuf_PRINTF;
+    rec->data[0]      = header;
+
+    for (i = 0; i < numArgs; i++)
+    {
+        rec->data[1 + i] = va_arg(argptr, uintptr_t);
+    }
+
+    commitRecord(rec, serial);
+    updateCurEntry(inst);
+}
+#else
 /*
  *  ======== LogSinkBuf_printf ========
  */
@@ -117,6 +283,7 @@ void LogSinkBuf_printf(LogSinkBuf_Handle inst, uint32_t header, uint32_t index,
 
     return;
 }
+#endif
 
 /*
  *  ======== LogSinkBuf_printfDepInjection ========
@@ -284,6 +451,56 @@ void LogSinkBuf_printfSingleton3(const Log_Module *handle, uint32_t header, uint
 /*
  *  ======== LogSinkBuf_buf ========
  */
+#if LogSinkBuf_LOCK_FREE
+void LogSinkBuf_bufDepInjection(const Log_Module *handle, uint32_t header, uint32_t index, uint8_t *data, size_t size)
+{
+    uint32_t serial;
+    LogSinkBuf_Rec *rec;
+    uint32_t numRecords = ((size) / LogSinkBuf_SIZEOF_RECORD) + ((size % LogSinkBuf_SIZEOF_RECORD) != 0);
+    numRecords += 1;
+    uint32_t i;
+
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    LogSinkBuf_Handle inst = (LogSinkBuf_Handle)handle->sinkConfig;
+
+    /* Reserve all records of the buffer at once, so that they are
+     * contiguous without holding off interrupts while they are copied.
+     */
+    serial = reserveRecords(inst, numRecords);
+
+    for (i = 0; i < numRecords; i++)
+    {
+        rec = findSerialRecord(inst, serial + i);
+        if (rec == NULL)
+        {
+            break;
+        }
+
+        openRecord(rec);
+
+        rec->timestampLow = TimestampP_getNative32();
+        if (i == 0)
+        {
+            rec->type    = LogSinkBuf_BUFFER_START;
+            rec->data[0] = header;
+            rec->data[1] = size;
+        }
+        else
+        {
+            rec->type = LogSinkBuf_BUFFER_CONTINUED;
+            memcpy(rec->data, &data[(i - 1) * LogSinkBuf_SIZEOF_RECORD], LogSinkBuf_SIZEOF_RECORD);
+        }
+
+        commitRecord(rec, serial + i);
+    }
+
+    updateCurEntry(inst);
+}
+#else
 void LogSinkBuf_bufDepInjection(const Log_Module *handle, uint32_t header, uint32_t index, uint8_t *data, size_t size)
 {
     uintptr_t key;
@@ -342,3 +559,4 @@ void LogSinkBuf_bufDepInjection(const Log_Module *handle, uint32_t header, uint3
     /* enable interrupts */
     HwiP_restore(key);
 }
+#endif
@@ -281,6 +281,11 @@ function viewInitRecord()
 
         /* Read a record from the buffer */
         var rec = Program.fetchFromAddr(addr, "LogSinkBuf_Rec");
+
+        /* Skip records still being written (LogSinkBuf_LOCK_FREE) */
+        if (Number(rec.serial) == 0) {
+            return;
+        }
         /* deter what type of log statement the record originated from */
         var recType = Number(rec.type);
 
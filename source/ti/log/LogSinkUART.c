@@ -75,6 +75,15 @@
 /* Mask to change a metadata pointer from 0x9... to 0x8... */
 #define LogSinkUART_OVERFLOW_MASK (0xEFFFFFFF)
 
+/* A framed packet is preceded by a header of two fields. The first holds the
+ * sync word and the packet length, the second the sequence number and the
+ * number of packets dropped since the previous frame.
+ */
+#define LogSinkUART_FRAME_HEADER_SIZE (8)
+#define LogSinkUART_FRAME_SYNC        (0xA55A)
+#define LogSinkUART_FRAME_MAX_LENGTH  (0xFFFF)
+#define LogSinkUART_FRAME_MAX_DROPS   (0xFFFF)
+
 extern const uint_least8_t LogSinkUART_count;
 
 /*
@@ -113,6 +122,38 @@ static void LogSinkUART_storePacket(RingBuf_Handle ringObject, unsigned char *pa
     } while ((linearSpace > 0) && (writeCount > 0));
 }
 
+/*
+ *  =========== LogSinkUART_storeFrameHeader ==========
+ *  Helper function to store the frame header of a packet of packetLength bytes
+ *  into the intermediate ring buffer. It must be called from a context where
+ *  HWI is disabled, directly before storing the packet itself.
+ */
+static void LogSinkUART_storeFrameHeader(LogSinkUART_Object *object, size_t packetLength)
+{
+    uint32_t frameHeader[LogSinkUART_FRAME_HEADER_SIZE / LogSinkUART_BYTES_PER_FIELD];
+
+    frameHeader[0] = LogSinkUART_FRAME_SYNC | ((uint32_t)packetLength << 16);
+    frameHeader[1] = object->seqNum | ((uint32_t)object->dropCount << 16);
+
+    object->seqNum++;
+    object->dropCount = 0;
+
+    LogSinkUART_storePacket(&object->ringObj, (unsigned char *)frameHeader, sizeof(frameHeader));
+}
+
+/*
+ *  =========== LogSinkUART_dropPacket ==========
+ *  Count a packet that did not fit in the intermediate ring buffer. The count
+ *  is reported in the header of the next frame stored.
+ */
+static inline void LogSinkUART_dropPacket(LogSinkUART_Object *object)
+{
+    if (object->dropCount < LogSinkUART_FRAME_MAX_DROPS)
+    {
+        object->dropCount++;
+    }
+}
+
 /*
  *  ======== LogSinkUART_flush ========
  */
@@ -167,6 +208,10 @@ void LogSinkUART_init(uint_least8_t index)
     /* Construct ring buffer for intermediate storage */
     RingBuf_construct(&object->ringObj, hwAttrs->bufPtr, hwAttrs->bufSize);
 
+    /* Restart the frame sequence */
+    object->seqNum    = 0;
+    object->dropCount = 0;
+
     /* Setup and open UART2 */
     UART2_Params_init(&uartParams);
 
@@ -194,7 +239,8 @@ void LogSinkUART_printf(LogSinkUART_Config *config, uint32_t headerPtr, uint32_t
     uintptr_t key;
     uint32_t packet[LogSinkUART_PRINTF_MAX_FIELDS];
 
-    LogSinkUART_Object *object = config->object;
+    LogSinkUART_Object *object         = config->object;
+    LogSinkUART_HWAttrs const *hwAttrs = config->hwAttrs;
 
     size_t packetSize = (LogSinkUART_PRINTF_MIN_FIELDS + numArgs) * LogSinkUART_BYTES_PER_FIELD;
 
@@ -205,6 +251,32 @@ void LogSinkUART_printf(LogSinkUART_Config *config, uint32_t headerPtr, uint32_t
 
     packet[1] = TimestampP_getNative32();
 
+    /* Framed packets that do not fit are counted instead of being replaced by
+     * an overflow packet. The count is sent in the next frame header.
+     */
+    if (hwAttrs->framed)
+    {
+        if (RingBuf_space(&object->ringObj) >= packetSize + LogSinkUART_FRAME_HEADER_SIZE)
+        {
+            packet[0] = headerPtr;
+
+            for (uint32_t i = 0; i < numArgs; i++)
+            {
+                packet[LogSinkUART_PRINTF_MIN_FIELDS + i] = va_arg(argptr, uintptr_t);
+            }
+
+            LogSinkUART_storeFrameHeader(object, packetSize);
+            LogSinkUART_storePacket(&object->ringObj, (unsigned char *)packet, packetSize);
+        }
+        else
+        {
+            LogSinkUART_dropPacket(object);
+        }
+
+        HwiP_restore(key);
+        return;
+    }
+
     /* Check if the ring buffer is full */
     if (RingBuf_isFull(&object->ringObj))
     {
@@ -427,7 +499,8 @@ void LogSinkUART_bufDepInjection(const Log_Module *handle,
 
     LogSinkUART_Handle inst    = (LogSinkUART_Handle)handle->sinkConfig;
     LogSinkUART_Config *config = (LogSinkUART_Config *)&LogSinkUART_config[inst->index];
-    LogSinkUART_Object *object = config->object;
+    LogSinkUART_Object *object         = config->object;
+    LogSinkUART_HWAttrs const *hwAttrs = config->hwAttrs;
 
     size_t packetSize = LogSinkUART_BUF_MIN_FIELDS * LogSinkUART_BYTES_PER_FIELD;
 
@@ -438,6 +511,29 @@ void LogSinkUART_bufDepInjection(const Log_Module *handle,
 
     packet[1] = TimestampP_getNative32();
 
+    /* Framed packets that do not fit are counted instead of being replaced by
+     * an overflow packet. The count is sent in the next frame header.
+     */
+    if (hwAttrs->framed)
+    {
+        if ((packetSize + size <= LogSinkUART_FRAME_MAX_LENGTH) &&
+            (RingBuf_space(&object->ringObj) >= packetSize + size + LogSinkUART_FRAME_HEADER_SIZE))
+        {
+            packet[0] = headerPtr;
+            packet[2] = size;
+            LogSinkUART_storeFrameHeader(object, packetSize + size);
+            LogSinkUART_storePacket(&object->ringObj, (unsigned char *)packet, packetSize);
+            LogSinkUART_storePacket(&object->ringObj, data, size);
+        }
+        else
+        {
+            LogSinkUART_dropPacket(object);
+        }
+
+        HwiP_restore(key);
+        return;
+    }
+
     /* Check if the ring buffer is full */
     if (RingBuf_isFull(&object->ringObj))
     {
@@ -200,6 +200,27 @@
  *  current packet and when the metadata-pointer address from the next packet is
  *  expected.
  *
+ *  ## Framed Transmission
+ *  When the sink is configured as framed in SysConfig, each packet is preceded
+ *  by an 8-byte frame header, sent in little-endian byte order:
+ *
+ *  Offset | Size | Field
+ *  ------ | ---- | -------------------------------------------------------
+ *  0      | 2    | Sync word, 0xA55A
+ *  2      | 2    | Length in bytes of the packet following the header
+ *  4      | 2    | Sequence number, incremented for every frame
+ *  6      | 2    | Number of packets dropped since the previous frame
+ *
+ *  The host-side tool resynchronizes on the sync word instead of on metadata
+ *  pointers, and it reports gaps in the sequence number as frames lost in
+ *  transport. A framed packet that would overflow the ring buffer is dropped
+ *  and counted, instead of being replaced by an overflow packet. The count is
+ *  reported in the header of the next frame that is stored. Framing adds 8
+ *  bytes of SRAM to each log statement in the ring buffer.
+ *
+ *  To decode framed output, pass the `--framed` option to the uart transport
+ *  of the host-side tool.
+ *
  *  ## Flushing the data
  *  A hook function installed in the Idle-loop/task is run when no other tasks
  *  or interrupts are running. It flushes as many log packets as possible from
@@ -347,6 +368,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include <ti/log/Log.h>
 #include <ti/drivers/UART2.h>
 #include <ti/drivers/utils/RingBuf.h>
@@ -370,6 +392,8 @@ typedef struct
     uint32_t baudRate;     /*!< UART2 baudRate */
     UART2_Parity parity;   /*!< UART2 parity */
     uint32_t uartIndex;    /*!< UART2 instance index */
+    bool framed;           /*!< Wrap each packet in a frame with a sequence
+                            *   number and a dropped packet count */
 } LogSinkUART_HWAttrs;
 
 /*!
@@ -381,6 +405,8 @@ typedef struct
 {
     UART2_Handle uartHandle; /*!< UART2 handle */
     RingBuf_Object ringObj;  /*!< Intermediate ring buffer */
+    uint16_t seqNum;         /*!< Sequence number of the next frame */
+    uint16_t dropCount;      /*!< Packets dropped since the last frame */
 } LogSinkUART_Object;
 
 /*!
@@ -0,0 +1,284 @@
+"""
+/******************************************************************************
+ @file  rcl_profiling_tool.py
+
+ @brief This tool converts an RCL profiling dump, printed by
+    RCL_Profiling_dump() through Log.h, into Chrome trace JSON and prints the
+    command handler duration histograms.
+
+ Group: WCS, BTS
+ Target Device: cc23xx
+
+ ******************************************************************************
+ 
+ Copyright (c) 2025, Texas Instruments Incorporated
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions
+ are met:
+
+ *  Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+ *  Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+ *  Neither the name of Texas Instruments Incorporated nor the names of
+    its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ ******************************************************************************
+ 
+ 
+ *****************************************************************************/
+"""
+
+import argparse
+import json
+import re
+import sys
+
+__version__ = "0.0.1"
+
+# SYSTIM ticks per microsecond
+TICKS_PER_US = 4
+
+# RCL_ProfilingEvent values (RCL_Profiling.h) mapped to
+# (section name, phase). Phase "B"/"E" begin and end a section, "i" is an
+# instant event.
+EVENTS = {
+    1: ("Preproc", "B"),
+    2: ("Preproc", "E"),
+    3: ("Postproc", "B"),
+    4: ("Postproc", "E"),
+    5: ("CommitPkt", "B"),
+    6: ("CommitPkt", "E"),
+    7: ("ProcessAuxPtr", "B"),
+    8: ("ProcessAuxPtr", "E"),
+    9: ("PhySwitch", "B"),
+    10: ("PhySwitch", "E"),
+    11: ("rclCommandHwi", "B"),
+    12: ("rclCommandHwi", "E"),
+    13: ("rclDispatchHwi", "B"),
+    14: ("rclDispatchHwi", "E"),
+    15: ("rclSchedulerHwi", "B"),
+    16: ("rclSchedulerHwi", "E"),
+    17: ("SchedulerDecision", "i"),
+    18: ("StopTimeSet", "i"),
+    19: ("Setup", "B"),
+    20: ("Setup", "E"),
+    21: ("ApplySettings", "B"),
+    22: ("ApplySettings", "E"),
+    23: ("Handler", "B"),
+    24: ("Handler", "E"),
+}
+
+# Sections that nest inside each other share a Chrome trace thread, sections
+# that may overlap arbitrarily get a thread of their own.
+THREADS = {
+    "rclCommandHwi": (1, "rclCommandHwi"),
+    "Setup": (1, "rclCommandHwi"),
+    "ApplySettings": (1, "rclCommandHwi"),
+    "Handler": (1, "rclCommandHwi"),
+    "rclDispatchHwi": (2, "rclDispatchHwi"),
+    "rclSchedulerHwi": (3, "rclSchedulerHwi"),
+    "SchedulerDecision": (3, "rclSchedulerHwi"),
+    "StopTimeSet": (1, "rclCommandHwi"),
+    "Preproc": (4, "Pre/postprocessing"),
+    "Postproc": (4, "Pre/postprocessing"),
+    "CommitPkt": (5, "Packet processing"),
+    "ProcessAuxPtr": (5, "Packet processing"),
+    "PhySwitch": (6, "PHY switch"),
+}
+
+NO_CMD = 0xFFFF
+
+TRACE_RE = re.compile(r"RCL_Profiling_trace: (-?\d+) (\d+) 0x([0-9A-Fa-f]+) 0x([0-9A-Fa-f]+)")
+HIST_RE = re.compile(r"RCL_Profiling_hist: 0x([0-9A-Fa-f]+) (-?\d+) (-?\d+) (-?\d+) 0x([0-9A-Fa-f]+)")
+BIN_RE = re.compile(r"RCL_Profiling_bin: 0x([0-9A-Fa-f]+) (\d+) (-?\d+)")
+START_RE = re.compile(r"RCL_Profiling_dump: start (\d+) (\d+)")
+
+
+def u32(value: int) -> int:
+    return value & 0xFFFFFFFF
+
+
+def parse_dump(lines):
+    """Parse the text of one or more dumps.
+
+    Returns the list of trace entries as (seq, event, cmdId, timestamp),
+    sorted and with duplicates from overlapping dumps removed, the
+    histograms keyed by function address and the number of entries that
+    were overwritten on the device before they could be dumped.
+    """
+    entries = {}
+    histograms = {}
+    overwritten = 0
+    for line in lines:
+        match = TRACE_RE.search(line)
+        if match:
+            seq = int(match.group(1)) & 0xFFFFFFFF
+            entries[seq] = (seq, int(match.group(2)), int(match.group(3), 16), int(match.group(4), 16))
+            continue
+        match = HIST_RE.search(line)
+        if match:
+            key = int(match.group(1), 16)
+            # A later dump holds the accumulated values, replace earlier ones
+            histograms[key] = {
+                "count": u32(int(match.group(2))),
+                "min": u32(int(match.group(3))),
+                "max": u32(int(match.group(4))),
+                "total": int(match.group(5), 16),
+                "bins": {},
+            }
+            continue
+        match = BIN_RE.search(line)
+        if match:
+            key = int(match.group(1), 16)
+            if key in histograms:
+                histograms[key]["bins"][int(match.group(2))] = u32(int(match.group(3)))
+            continue
+        match = START_RE.search(line)
+        if match:
+            overwritten = max(overwritten, int(match.group(2)))
+
+    return [entries[seq] for seq in sorted(entries)], histograms, overwritten
+
+
+def to_chrome_trace(entries, histograms=None, symbols=None):
+    """Convert trace entries to a Chrome trace (chrome://tracing, Perfetto) object."""
+    trace_events = []
+    open_sections = {}
+    last_ts = None
+    time_base = 0
+    first_ts = None
+
+    for thread_id, thread_name in sorted(set(THREADS.values())):
+        trace_events.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": thread_id,
+                             "args": {"name": thread_name}})
+
+    for seq, event, cmd_id, timestamp in entries:
+        # Unwrap the 32-bit SYSTIM timestamp
+        if last_ts is not None and timestamp < last_ts and (last_ts - timestamp) > 0x80000000:
+            time_base += 1 << 32
+        last_ts = timestamp
+        ticks = time_base + timestamp
+        if first_ts is None:
+            first_ts = ticks
+        ts_us = (ticks - first_ts) / TICKS_PER_US
+
+        name, phase = EVENTS.get(event, (f"Event{event}", "i"))
+        thread_id = THREADS.get(name, (7, "Other"))[0]
+        args = {"seq": seq}
+        if cmd_id != NO_CMD:
+            args["cmdId"] = f"0x{cmd_id:04X}"
+
+        if phase == "B":
+            open_sections[name] = open_sections.get(name, 0) + 1
+        elif phase == "E":
+            # The matching begin event may have been overwritten on the device
+            if open_sections.get(name, 0) == 0:
+                continue
+            open_sections[name] -= 1
+
+        trace_event = {"name": name, "ph": phase, "ts": ts_us, "pid": 1, "tid": thread_id, "args": args}
+        if phase == "i":
+            trace_event["s"] = "t"
+        trace_events.append(trace_event)
+
+    trace = {"traceEvents": trace_events, "displayTimeUnit": "ns"}
+    if histograms:
+        trace["otherData"] = {
+            symbol_name(key, symbols): {
+                "count": hist["count"],
+                "min_us": hist["min"] / TICKS_PER_US,
+                "max_us": hist["max"] / TICKS_PER_US,
+                "bins": {str(bin): count for bin, count in sorted(hist["bins"].items())},
+            }
+            for key, hist in histograms.items()
+        }
+    return trace
+
+
+def symbol_name(key: int, symbols) -> str:
+    if symbols:
+        # Thumb function addresses have bit 0 set
+        name = symbols.get(key & ~1)
+        if name:
+            return name
+    return f"0x{key:08X}"
+
+
+def read_symbols(path: str):
+    """Read function symbols from 'nm' output, lines of '<address> <type> <name>'."""
+    symbols = {}
+    with open(path, "r") as symbol_file:
+        for line in symbol_file:
+            parts = line.split()
+            if len(parts) == 3 and parts[1] in "tTwW":
+                try:
+                    symbols[int(parts[0], 16) & ~1] = parts[2]
+                except ValueError:
+                    pass
+    return symbols
+
+
+def format_histograms(histograms, symbols=None) -> str:
+    lines = []
+    for key, hist in histograms.items():
+        count = hist["count"]
+        mean = (hist["total"] / count / TICKS_PER_US) if count else 0.0
+        lines.append(f"{symbol_name(key, symbols)}: {count} calls, min {hist['min'] / TICKS_PER_US:.2f} us, "
+                     f"mean {mean:.2f} us, max {hist['max'] / TICKS_PER_US:.2f} us")
+        scale = max(hist["bins"].values(), default=0)
+        for bin, bin_count in sorted(hist["bins"].items()):
+            low = 0 if bin == 0 else (1 << bin) / TICKS_PER_US
+            high = (1 << (bin + 1)) / TICKS_PER_US
+            bar = "#" * max(1, (40 * bin_count) // scale)
+            lines.append(f"  [{low:10.2f}, {high:10.2f}) us {bin_count:8d} {bar}")
+    return "\n".join(lines)
+
+
+def main(args):
+    if args.input == "-":
+        lines = sys.stdin.readlines()
+    else:
+        with open(args.input, "r", errors="replace") as dump_file:
+            lines = dump_file.readlines()
+
+    symbols = read_symbols(args.symbols) if args.symbols else None
+    entries, histograms, overwritten = parse_dump(lines)
+    if not entries and not histograms:
+        raise Exception(f"No RCL profiling dump found in '{args.input}'")
+
+    with open(args.output, "w") as output_file:
+        json.dump(to_chrome_trace(entries, histograms, symbols), output_file, indent=1)
+
+    print(f"{len(entries)} trace entries written to '{args.output}'"
+          + (f", {overwritten} older entries were overwritten on the device" if overwritten else ""))
+    if histograms:
+        print(format_histograms(histograms, symbols))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(prog="rcl_profiling_tool",
+                                     description="Convert an RCL_Profiling_dump() log to Chrome trace JSON")
+    parser.add_argument("input", help="Log output containing the dump, '-' for stdin")
+    parser.add_argument("-o", "--output", default="rcl_trace.json", help="Chrome trace JSON file to write")
+    parser.add_argument("-s", "--symbols", help="Output of 'nm' for the application, used to name handlers")
+    parser.add_argument("-v", "--version", action="version", version=f"%(prog)s {__version__}")
+    main(parser.parse_args())
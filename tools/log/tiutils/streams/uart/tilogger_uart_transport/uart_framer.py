@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 """
 
 import logging
+import struct
 from dataclasses import dataclass, field
 from enum import Enum
 
@@ -45,6 +46,11 @@ logger = logging.getLogger("UART Framer")
 
 UART_RESET_TOKEN = bytes([0xBB, 0xBB, 0xBB, 0xBB])
 
+# Framed LogSinkUART output: every packet is preceded by a header of
+# [sync (0xA55A), length, sequence number, dropped packets], all 16-bit LE.
+UART_FRAME_SYNC = bytes([0x5A, 0xA5])
+UART_FRAME_HEADER = struct.Struct("<HHHH")
+
 
 class UARTOpcode(Enum):
     """Opcodes for UART frames that are built in UARTFramer"""
@@ -148,14 +154,22 @@ class UARTFramer:
 
     Args:
         q: Output queue
+        framed: The input is framed LogSinkUART output
 
     """
 
-    def __init__(self, output_queue, trace_db: TraceDB):
+    def __init__(self, output_queue, trace_db: TraceDB, framed: bool = False):
         # Create the PDU stream thread.
         self._output_queue = output_queue
         self.last_ts_counter = 0
         self._trace_db = trace_db
+        self._framed = framed
+        self._next_seq: Optional[int] = None
+
+        # Statistics of framed input
+        self.frames = 0
+        self.lost_frames = 0
+        self.dropped_packets = 0
 
     def parse(self, buf: bytearray):
         """
@@ -180,6 +194,9 @@ class UARTFramer:
         frame.parse(self._trace_db.timestamp_fmt_32)
         self._output_queue.put(frame)
 
+        if self._framed:
+            return self._parse_framed(buf)
+
         # While there is a full packet to parse...
         while True:
             # Nothing meaningful to parse if there are less than 4 bytes
@@ -256,3 +273,101 @@ class UARTFramer:
 
         # Return unparsed data
         return buf
+
+    def _packet_length(self, packet: bytearray) -> Optional[int]:
+        """Expected length of a packet from its metadata pointer, or None if it is not a valid header"""
+        if len(packet) < 8:
+            return None
+
+        elf_string = self._trace_db.traceDB.get(build_value(packet[0:4]))
+        if elf_string is None:
+            return None
+
+        if elf_string.opcode == Opcode.FORMATTED_TEXT:
+            return 8 + elf_string.nargs * 4
+
+        if elf_string.opcode == Opcode.BUFFER and len(packet) >= 12:
+            return 12 + build_value(packet[8:12])
+
+        return None
+
+    def _check_sequence(self, seq_num: int, dropped: int):
+        """Account for frames lost in transport and packets dropped on the device"""
+        self.frames += 1
+
+        # A device reset restarts the sequence, which is not a loss
+        if self._next_seq is not None and seq_num != self._next_seq and seq_num != 0:
+            lost = (seq_num - self._next_seq) & 0xFFFF
+            self.lost_frames += lost
+            logger.warning("%d frame(s) lost in transport before frame %d", lost, seq_num)
+
+        if dropped:
+            self.dropped_packets += dropped
+            logger.warning("%d log packet(s) dropped on the device before frame %d", dropped, seq_num)
+
+        self._next_seq = (seq_num + 1) & 0xFFFF
+
+    def _parse_framed(self, buf: bytearray):
+        """
+        Parse as many frames as possible from framed LogSinkUART output
+
+        Frames are located by their sync word, so a corrupted or partially
+        received frame only costs a single search to resynchronize.
+
+        Args:
+          buf: input buffer to parse
+
+        Returns:
+            Unparsed portion of the input buffer
+
+        """
+        pos = 0
+
+        while True:
+            start = buf.find(UART_FRAME_SYNC, pos)
+
+            if start < 0:
+                # Keep a trailing byte that may be the start of a sync word
+                keep = 1 if buf[-1:] == UART_FRAME_SYNC[:1] else 0
+                del buf[: len(buf) - keep]
+                return buf
+
+            if start != pos:
+                logger.debug("Skipped %d bytes to the next frame", start - pos)
+
+            if len(buf) - start < UART_FRAME_HEADER.size:
+                break
+
+            _, length, seq_num, dropped = UART_FRAME_HEADER.unpack_from(buf, start)
+            end = start + UART_FRAME_HEADER.size + length
+
+            if len(buf) < end:
+                break
+
+            packet = buf[start + UART_FRAME_HEADER.size : end]
+
+            # A sync word inside the payload of a lost frame is not a frame,
+            # neither is a frame that overlaps the next one
+            if (self._packet_length(packet) != length) or (
+                len(buf) > end and buf[end : end + len(UART_FRAME_SYNC)] != UART_FRAME_SYNC[: len(buf) - end]
+            ):
+                pos = start + 1
+                continue
+
+            self._check_sequence(seq_num, dropped)
+
+            # Align buffer packets with the unframed format by trimming the
+            # size field, see parse()
+            if self._trace_db.traceDB[build_value(packet[0:4])].opcode == Opcode.BUFFER:
+                del packet[8:12]
+
+            frame = UARTDataFrame(0)
+            frame.parse(packet, len(packet))
+            logger.debug("Parsed framed data frame %d (size %d)", seq_num, len(packet))
+            self._output_queue.put(frame)
+
+            pos = end
+
+        # Return unparsed data
+        del buf[:start]
+        return buf
@@ -53,15 +53,24 @@ from .uart_to_log import UARTPacketiser
 
 import typer
 
+py_logger = logging.getLogger("UART Transport")
+
+# Number of bytes read from a capture file at a time when replaying
+REPLAY_CHUNK_SIZE = 65536
+
 
 class UART_Transport(TransportABC):
-    def __init__(self, port: str, baudrate: int, trace_db: TraceDB, alias: str):
+    def __init__(
+        self, port: str, baudrate: int, trace_db: TraceDB, alias: str, framed: bool = False, replay: bool = False
+    ):
         super().__init__()
 
         self._com_port = port
         self._baud_rate = baudrate
         self._trace_db = trace_db
         self._alias = alias
+        self._framed = framed
+        self._replay = replay
         self.serial: Optional[SerialRx] = None
         self.stop_event = threading.Event()
 
@@ -72,12 +81,41 @@ class UART_Transport(TransportABC):
     def stop(self):
         self.stop_event.set()
 
-    def start(self, logger: Optional[Logger]) -> NoReturn:
-        self.serial = SerialRx(self._com_port, self._baud_rate, alias=self._alias)
-        atexit.register(self.serial.close)
+    def _output(self, frame, packetiser: Optional[UARTPacketiser], logger: Optional[Logger]):
+        if logger:
+            packet: Optional[LogPacket] = packetiser.parse(frame)
+            if packet:
+                logger.log(packet)
+        else:
+            print(frame)
+
+    def _start_replay(self, framer: UARTFramer, frame_queue: queue.Queue, packetiser, logger):
+        """Decode a raw capture of the UART output, as fast as it can be read"""
+        rx_data: bytearray = bytearray()
+
+        with open(self._com_port, "rb") as capture:
+            while not self.stop_event.is_set():
+                chunk = capture.read(REPLAY_CHUNK_SIZE)
+                if not chunk:
+                    break
 
+                rx_data.extend(chunk)
+                rx_data = framer.parse(rx_data)
+
+                while not frame_queue.empty():
+                    self._output(frame_queue.get_nowait(), packetiser, logger)
+
+        if self._framed:
+            py_logger.info(
+                "Replayed %d frames, %d lost in transport, %d packets dropped on the device",
+                framer.frames,
+                framer.lost_frames,
+                framer.dropped_packets,
+            )
+
+    def start(self, logger: Optional[Logger]) -> NoReturn:
         frame_queue: queue.Queue = queue.Queue()
-        framer = UARTFramer(frame_queue, self._trace_db)
+        framer = UARTFramer(frame_queue, self._trace_db, framed=self._framed)
 
         # Note we use "Logger == None" as our 'UART only mode' flag
         if logger:
@@ -85,6 +123,13 @@ class UART_Transport(TransportABC):
         else:
             packetiser = None
 
+        if self._replay:
+            self._start_replay(framer, frame_queue, packetiser, logger)
+            return
+
+        self.serial = SerialRx(self._com_port, self._baud_rate, alias=self._alias)
+        atexit.register(self.serial.close)
+
         rx_data: bytearray = bytearray()
         while not self.stop_event.is_set():
             rx_data.extend(self.serial.receive())
@@ -95,12 +140,7 @@ class UART_Transport(TransportABC):
             except queue.Empty:
                 continue
 
-            if logger:
-                packet: Optional[LogPacket] = packetiser.parse(result)
-                if packet:
-                    logger.log(packet)
-            else:
-                print(result)
+            self._output(result, packetiser, logger)
 
     def reset(self):
         pass
@@ -117,6 +157,8 @@ def transport_factory_cli(app: typer.Typer):
         baudrate: int = typer.Argument(..., help="UART baudrate"),
         elf: List[Path] = typer.Option([], help="Symbol file path (elf/out file)"),
         alias: Optional[str] = typer.Option(None, help="Alias for this device in the log"),
+        framed: bool = typer.Option(False, help="Decode framed LogSinkUART output"),
+        replay: bool = typer.Option(False, help="Treat PORT as a file with captured UART output and decode it"),
     ):
         """Add UART transport as input to log.
 
@@ -127,6 +169,13 @@ def transport_factory_cli(app: typer.Typer):
         You also need to specify .out/.elf files that contain symbol information
         needed to parse the log, but this may also be provided globally before
         adding transports.
+
+        If the LogSink is configured for framed output, add --framed. Frames
+        carry sequence numbers and dropped packet counts, which are reported
+        as warnings.
+
+        With --replay, PORT is a file with raw UART output captured earlier,
+        which is decoded as fast as possible instead of listening on a port.
         """
 
         state = ctx.ensure_object(LoggerCliCtx)
@@ -139,7 +188,7 @@ def transport_factory_cli(app: typer.Typer):
             sys.exit(1)
 
         db = TraceDB(elves, repickle=False)
-        uart_transport = UART_Transport(port, baudrate, db, alias or port)
+        uart_transport = UART_Transport(port, baudrate, db, alias or port, framed=framed, replay=replay)
         return uart_transport
 
 